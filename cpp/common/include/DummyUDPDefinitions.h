@@ -12,6 +12,8 @@
 #include <stdint.h>
 #include <time.h>
 
+#include "PacketStateBitmap.h"
+
 namespace DummyUDP {
 
   // Max packet size for 9000 byte jumbo frame - (20 IPV4 + 8 UDP + 8 header)
@@ -20,6 +22,10 @@ namespace DummyUDP {
   // Maximum packets sized for 4096*4096*2 bytes frame with 8000 byte packets
   static const std::size_t max_packets = 4195; 
 
+  // Words of packet state bitmap needed to track the maximum packets
+  static const std::size_t packet_state_words =
+    (max_packets + OdinData::PacketStateBitmap::word_bits - 1) / OdinData::PacketStateBitmap::word_bits;
+
   static const uint32_t start_of_frame_mask = 1 << 31;
   static const uint32_t end_of_frame_mask   = 1 << 30;
   static const uint32_t packet_number_mask   = 0x3FFFFFFF;
@@ -41,7 +47,7 @@ namespace DummyUDP {
     uint32_t total_packets_expected;
     uint32_t total_packets_received;
     std::size_t packet_size;
-    uint8_t packet_state[max_packets];
+    OdinData::PacketStateBitmap::Word packet_state[packet_state_words];
   } FrameHeader;
   
   inline const std::size_t max_frame_size(void)
@@ -0,0 +1,111 @@
+/*!
+ * FrameNotification.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef FRAMENOTIFICATION_H_
+#define FRAMENOTIFICATION_H_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "OdinDataException.h"
+
+namespace OdinData
+{
+
+//! FrameNotificationException - custom exception class implementing "what" for error string
+class FrameNotificationException : public OdinDataException {
+public:
+  FrameNotificationException(const std::string what) : OdinDataException(what) { }
+};
+
+//! FrameNotification - compact binary frame ready and release notification
+//!
+//! This class encodes and decodes the fixed-layout binary notifications that can be exchanged
+//! between the frame receiver and processor in place of JSON IpcMessage frame ready and release
+//! notifications. Binary notifications are distinguished from JSON messages on the same channel
+//! by their size and leading magic number, allowing both formats to coexist. All fields are
+//! encoded little-endian with no padding, matching the Python FrameNotification class in
+//! odin_data.shared_buffer_manager. Several notifications can be concatenated into a single
+//! batched message, e.g. to release many buffers at once.
+class FrameNotification
+{
+public:
+
+  //! Notification types
+  enum Type
+  {
+    TypeIllegal = 0,
+    TypeFrameReady = 1,
+    TypeFrameRelease = 2
+  };
+
+  //! State of the frame in the notified buffer
+  enum State
+  {
+    StateUnknown = 0,
+    StateComplete = 1,
+    StateTimedout = 2
+  };
+
+  //! Binary layout of an encoded notification
+  typedef struct
+  {
+    uint32_t magic;           //!< Magic number identifying a binary notification
+    uint16_t version;         //!< Layout version
+    uint16_t type;            //!< Notification type
+    uint64_t frame;           //!< Frame number
+    uint32_t buffer_id;       //!< Shared buffer ID containing the frame
+    uint32_t state;           //!< Frame state when it was made ready
+    uint64_t ready_time_ns;   //!< Time the frame was made ready, in ns since the epoch
+    uint64_t release_time_ns; //!< Time the frame was released, in ns since the epoch, zero if not released
+  } Layout;
+
+  static const uint32_t magic = 0x4E46444F;  //!< Magic number, "ODFN" when encoded
+  static const uint16_t version = 1;         //!< Current layout version
+
+  FrameNotification();
+  FrameNotification(Type type, uint64_t frame, uint32_t buffer_id, State state=StateUnknown);
+  FrameNotification(const std::string& encoded);
+  explicit FrameNotification(const Layout& layout);
+
+  static bool is_binary(const std::string& encoded);
+  static bool is_binary_batch(const std::string& encoded);
+  static void decode_batch(const std::string& encoded, std::vector<FrameNotification>& notifications);
+  static uint64_t now_ns(void);
+
+  std::string encode(void) const;
+  void encode_to_batch(std::string& encoded) const;
+
+  //! Returns the notification fields in encoded layout
+  const Layout& get_layout(void) const { return layout_; }
+
+  //! Returns the notification type
+  Type get_type(void) const { return static_cast<Type>(layout_.type); }
+  //! Returns the frame number
+  uint64_t get_frame(void) const { return layout_.frame; }
+  //! Returns the shared buffer ID
+  uint32_t get_buffer_id(void) const { return layout_.buffer_id; }
+  //! Returns the frame state
+  State get_state(void) const { return static_cast<State>(layout_.state); }
+  //! Returns the time the frame was made ready in ns since the epoch
+  uint64_t get_ready_time_ns(void) const { return layout_.ready_time_ns; }
+  //! Returns the time the frame was released in ns since the epoch
+  uint64_t get_release_time_ns(void) const { return layout_.release_time_ns; }
+
+  //! Sets the time the frame was made ready in ns since the epoch
+  void set_ready_time_ns(uint64_t ready_time_ns) { layout_.ready_time_ns = ready_time_ns; }
+  //! Sets the time the frame was released in ns since the epoch
+  void set_release_time_ns(uint64_t release_time_ns) { layout_.release_time_ns = release_time_ns; }
+
+private:
+
+  Layout layout_;  //!< Notification fields in encoded layout
+};
+
+} // namespace OdinData
+#endif /* FRAMENOTIFICATION_H_ */
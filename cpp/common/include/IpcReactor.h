@@ -126,6 +126,14 @@ public:
   //! Runs the reactor polling loop
   int run(void);
 
+  //! Runs a single iteration of the reactor polling loop
+  int run_once(long timeout_ms=-1);
+
+  //! Returns the time in milliseconds until the next timer is due to fire
+  long get_next_timeout(void);
+  //! Indicates if the reactor has been signalled to stop
+  bool is_stopped(void) const;
+
   //! Signals that the reactor polling loop should stop gracefully
   void stop(void);
 
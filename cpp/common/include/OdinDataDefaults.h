@@ -23,6 +23,10 @@ const std::string  default_frame_ready_endpoint   = "tcp://127.0.0.1:5001";
 const std::string  default_frame_release_endpoint = "tcp://127.0.0.1:5002";
 const std::string  default_json_config_file       = "";
 const std::string  default_shared_buffer_name     = "OdinDataBuffer";
+const unsigned int default_frame_release_batch_size       = 1;
+const unsigned int default_frame_release_batch_timeout_ms = 0;
+const unsigned int default_frame_ready_batch_size         = 1;
+const unsigned int default_frame_ready_batch_timeout_ms   = 0;
 
 } // namespace Defaults
 
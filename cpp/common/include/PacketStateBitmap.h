@@ -0,0 +1,72 @@
+/*!
+ * PacketStateBitmap.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef PACKETSTATEBITMAP_H_
+#define PACKETSTATEBITMAP_H_
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace OdinData
+{
+
+//! PacketStateBitmap - bitmap of the packets received into a frame
+//!
+//! This class tracks which packets of a frame have been received as one bit per packet, in an
+//! array of words owned by the caller, typically within a frame header in a shared buffer, so that
+//! the state is visible to both the frame receiver decoder and frame processor plugins. Compared
+//! to a byte per packet, this shrinks the state eightfold, so that clearing it at the start of
+//! each frame is cheap. Packets received are counted a word at a time with a population count
+//! and runs of missing packets are found a word at a time by counting trailing bits, so that
+//! complete, or nearly complete, frames can be checked without visiting every packet.
+class PacketStateBitmap
+{
+public:
+
+  typedef uint64_t Word;                       //!< Storage word of the bitmap
+  static const unsigned int word_bits = 64;    //!< Number of packets tracked in each word
+
+  PacketStateBitmap(Word* words, std::size_t num_packets);
+
+  //! Return the number of words needed to track the specified number of packets
+  static std::size_t num_words(std::size_t num_packets)
+  {
+    return (num_packets + word_bits - 1) / word_bits;
+  }
+
+  //! Mark a packet received, returning true if it had not already been received
+  bool mark_received(std::size_t packet)
+  {
+    Word mask = static_cast<Word>(1) << (packet % word_bits);
+    Word& word = words_[packet / word_bits];
+    bool newly_received = !(word & mask);
+    word |= mask;
+    return newly_received;
+  }
+
+  //! Return true if a packet has been received
+  bool is_received(std::size_t packet) const
+  {
+    return (words_[packet / word_bits] >> (packet % word_bits)) & 1;
+  }
+
+  void clear(void);
+  std::size_t get_num_packets(void) const;
+  std::size_t num_received(void) const;
+  std::size_t num_missing(void) const;
+  bool next_missing_range(std::size_t& first, std::size_t& last) const;
+
+private:
+
+  Word received_word(std::size_t word_index) const;
+
+  Word*       words_;        //!< Bitmap words, one bit per packet
+  std::size_t num_packets_;  //!< Number of packets tracked
+};
+
+} // namespace OdinData
+#endif /* PACKETSTATEBITMAP_H_ */
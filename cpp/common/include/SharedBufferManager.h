@@ -9,13 +9,19 @@
 #define SHAREDBUFFERMANAGER_H_
 
 #include <string>
+#include <vector>
 #include <stddef.h>
+#include <stdint.h>
 
 #include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/file_mapping.hpp>
 #include <boost/interprocess/mapped_region.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
 
 #include "OdinDataException.h"
+#include "SharedFrameRings.h"
+#include "SharedBufferStates.h"
 
 namespace OdinData
 {
@@ -37,8 +43,35 @@ public:
     size_t buffer_size;
   } Header;
 
+  //! Options for the memory backing a shared buffer created by the manager
+  struct MemoryOptions
+  {
+    MemoryOptions() : huge_page_size(0), prefault(false), lock(false), numa_node(-1) { }
+
+    size_t huge_page_size;  //!< Size of the huge pages backing the buffer, zero for normal pages
+    bool   prefault;        //!< Fault in every page of the buffer when it is created
+    bool   lock;            //!< Lock every page of the buffer into memory when it is created
+    int    numa_node;       //!< NUMA node to bind the buffer memory to, -1 for no binding
+  };
+
+  //! Specification of a pool of equally sized buffers in a shared buffer created by the manager
+  struct PoolSpec
+  {
+    PoolSpec(size_t size=0, size_t mem=0) : buffer_size(size), pool_size(mem) { }
+
+    size_t buffer_size;  //!< Size of each buffer in the pool
+    size_t pool_size;    //!< Memory given to the pool, filled with as many buffers as fit
+  };
+
+  static const unsigned int max_pools = 8;  //!< Maximum number of buffer pools in a shared buffer
+
   SharedBufferManager(const std::string& shared_mem_name, const size_t shared_mem_size,
-                      const size_t buffer_size, bool remove_when_deleted=true);
+                      const size_t buffer_size, bool remove_when_deleted=true,
+                      const unsigned int num_frame_rings=0, bool buffer_states=false,
+                      const MemoryOptions& memory_options=MemoryOptions());
+  SharedBufferManager(const std::string& shared_mem_name, const std::vector<PoolSpec>& pools,
+                      bool remove_when_deleted=true, const unsigned int num_frame_rings=0,
+                      bool buffer_states=false, const MemoryOptions& memory_options=MemoryOptions());
   SharedBufferManager(const std::string& shared_mem_name);
 
   ~SharedBufferManager();
@@ -46,17 +79,73 @@ public:
   const size_t get_manager_id(void) const;
   const size_t get_num_buffers(void) const;
   const size_t get_buffer_size(void) const;
+  const size_t get_buffer_size(const unsigned int buffer) const;
 
   void* get_buffer_address(const unsigned int buffer) const;
 
+  const unsigned int get_num_pools(void) const;
+  const unsigned int get_buffer_pool(const unsigned int buffer) const;
+  const size_t get_pool_first_buffer(const unsigned int pool) const;
+  const size_t get_pool_num_buffers(const unsigned int pool) const;
+  const size_t get_pool_buffer_size(const unsigned int pool) const;
+
+  const unsigned int get_num_frame_rings(void) const;
+  SharedFrameRings* get_frame_rings(void) const;
+  SharedBufferStates* get_buffer_states(void) const;
+
+  const size_t get_page_size(void) const;
+  const bool get_locked(void) const;
+  const int get_numa_node(void) const;
+
 private:
 
+  //! Location of a pool of buffers within the shared buffer
+  typedef struct
+  {
+    uint64_t offset;         //!< Offset of the first buffer from the start of the shared buffer
+    uint64_t buffer_size;    //!< Size of each buffer in the pool
+    uint64_t num_buffers;    //!< Number of buffers in the pool
+    uint64_t first_buffer;   //!< ID of the first buffer in the pool
+  } Pool;
+
+  //! Table of the buffer pools, hosted after the first pool when a shared buffer has several
+  typedef struct
+  {
+    uint32_t magic;          //!< Magic number identifying the table
+    uint32_t num_pools;      //!< Number of pools in the table
+    uint64_t end_offset;     //!< Offset of the end of the last pool from the start of the shared buffer
+    Pool     pools[max_pools]; //!< Pools in the shared buffer, the first being that described by the header
+  } PoolTable;
+
+  static const uint32_t pool_table_magic = 0x4C504253;  //!< Magic number, "SBPL" when encoded
+
+  class HugePageFileGuard;
+
+  void create(const std::vector<PoolSpec>& pools, const unsigned int num_frame_rings,
+              bool buffer_states, const MemoryOptions& memory_options);
+  const Pool& pool_of(const unsigned int buffer) const;
+  size_t extension_offset(void) const;
+  static size_t align_offset(size_t offset);
+  void map_huge_page_file(const std::string& path);
+  void place_memory(const MemoryOptions& memory_options);
+
+  static std::vector<std::string> huge_page_mounts(void);
+  static size_t fs_block_size(const std::string& path);
+
   std::string shared_mem_name_;
   size_t      shared_mem_size_;
   bool        remove_when_deleted_;
+  std::string huge_page_path_;
+  size_t      page_size_;
+  bool        locked_;
+  int         numa_node_;
   boost::interprocess::shared_memory_object shared_mem_;
   boost::interprocess::mapped_region        shared_mem_region_;
   Header*                                   manager_hdr_;
+  std::vector<Pool>                         pools_;
+  size_t                                    num_buffers_;
+  boost::scoped_ptr<SharedFrameRings>       frame_rings_;
+  boost::scoped_ptr<SharedBufferStates>     buffer_states_;
 
   static size_t last_manager_id;
 };
@@ -0,0 +1,121 @@
+/*!
+ * SharedBufferStates.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef SHAREDBUFFERSTATES_H_
+#define SHAREDBUFFERSTATES_H_
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+#include "OdinDataException.h"
+
+namespace OdinData
+{
+
+//! SharedBufferStatesException - custom exception class implementing "what" for error string
+class SharedBufferStatesException : public OdinDataException {
+public:
+  SharedBufferStatesException(const std::string what) : OdinDataException(what) { }
+};
+
+//! SharedBufferStates - table of frame buffer states hosted in shared memory
+//!
+//! This class manages a table in a region of shared memory recording the state of each frame
+//! buffer, so that ownership of the buffers is visible to every process mapping them. A buffer
+//! moves from free to receiving when the frame receiver starts filling it, to ready when it is
+//! notified to the frame processor and to held when the frame processor takes it for processing,
+//! before returning to free when released. Each entry also records the PID of the process that
+//! owns the buffer, the frame it contains, the time it entered its state and the frame receiver
+//! RX thread that manages it. Transitions between processes are made by atomically swapping a
+//! control word combining the state with a sequence number, so that a stale transition, e.g. a
+//! late release of a buffer that has since been reclaimed and reused, is refused. The other fields
+//! of an entry are only written while a busy flag is set in the control word, so that a
+//! consistent snapshot of an entry can always be read. A process waits a bounded time for the busy
+//! flag to clear, so that a process exiting part way through a transition cannot stall the others;
+//! an entry left busy is refused by acquire and release, and is taken over by the frame receiver
+//! when it next sets or reclaims the buffer.
+class SharedBufferStates
+{
+public:
+
+  //! Buffer states
+  enum State
+  {
+    StateFree = 0,   //!< Empty and available to the frame receiver
+    StateReceiving,  //!< Being filled with frame data by the frame receiver
+    StateReady,      //!< Notified ready to the frame processor
+    StateHeld,       //!< Held by the frame processor
+    NumStates
+  };
+
+  //! State of a buffer, one per cache line
+  typedef struct
+  {
+    uint64_t control;        //!< Sequence number in the upper bits and state in the lowest byte
+    uint64_t frame;          //!< Frame number contained in the buffer
+    uint64_t state_time_ns;  //!< Time the buffer entered its state, in nanoseconds since the epoch
+    uint32_t owner_pid;      //!< PID of the process owning the buffer
+    uint32_t rx_thread;      //!< Index of the frame receiver RX thread managing the buffer
+    char     pad[32];        //!< Pad to a cache line
+  } Entry;
+
+  static const uint32_t magic = 0x54534253;   //!< Magic number, "SBST" when encoded
+  static const uint16_t version = 1;          //!< Current layout version
+  static const uint64_t any_frame = ~0ULL;    //!< Matches any frame number in a transition
+  static const uint32_t no_rx_thread = ~0U;   //!< RX thread of buffers not yet managed
+
+  SharedBufferStates(void* region, size_t region_size, unsigned int num_buffers);
+  SharedBufferStates(void* region, size_t region_size);
+
+  static size_t region_size(unsigned int num_buffers);
+  static bool is_present(const void* region, size_t region_size);
+  static const char* state_name(State state);
+  static State get_state(const Entry& entry);
+  static bool is_busy(const Entry& entry);
+
+  unsigned int get_num_buffers(void) const;
+  bool get_entry(unsigned int buffer_id, Entry& entry) const;
+  void get_state_counts(std::vector<unsigned int>& counts) const;
+
+  void set_free(unsigned int buffer_id, unsigned int rx_thread);
+  void set_receiving(unsigned int buffer_id);
+  void set_ready(unsigned int buffer_id, uint64_t frame);
+  bool acquire(unsigned int buffer_id, uint64_t frame);
+  bool release(unsigned int buffer_id, uint64_t frame);
+  bool reclaim(unsigned int buffer_id, const Entry& observed);
+
+private:
+
+  //! Header at the start of the shared region
+  typedef struct
+  {
+    uint32_t magic;          //!< Magic number identifying a formatted table
+    uint16_t version;        //!< Layout version
+    uint16_t reserved;       //!< Reserved for future use
+    uint32_t num_buffers;    //!< Number of buffer entries in the table
+    char     pad[52];        //!< Pad to a cache line
+  } Header;
+
+  static const uint64_t busy = 0x80;        //!< Control flag set while an entry is being updated
+  static const uint64_t state_mask = 0x7F;  //!< Control mask for the state
+  static const unsigned int seq_shift = 8;  //!< Control shift for the sequence number
+  static const uint64_t busy_timeout_ns = 10000000;  //!< Time to wait for the busy flag to clear
+
+  Entry* entry(unsigned int buffer_id) const;
+  uint64_t load_control(const Entry* entry) const;
+  bool transition(Entry* entry, uint64_t expected_control, State state, uint64_t frame,
+      uint32_t rx_thread, bool take_over = false);
+
+  char*        region_;     //!< Start of the shared region
+  Header*      header_;     //!< Header of the shared region
+  Entry*       entries_;    //!< Table of buffer entries following the header
+  uint32_t     pid_;        //!< PID of this process, recorded as the owner on transitions
+};
+
+} // namespace OdinData
+#endif /* SHAREDBUFFERSTATES_H_ */
@@ -0,0 +1,103 @@
+/*!
+ * SharedFrameRings.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef SHAREDFRAMERINGS_H_
+#define SHAREDFRAMERINGS_H_
+
+#include <cstddef>
+#include <stdint.h>
+
+#include <boost/thread/mutex.hpp>
+
+#include "FrameNotification.h"
+#include "OdinDataException.h"
+
+namespace OdinData
+{
+
+//! SharedFrameRingsException - custom exception class implementing "what" for error string
+class SharedFrameRingsException : public OdinDataException {
+public:
+  SharedFrameRingsException(const std::string what) : OdinDataException(what) { }
+};
+
+//! SharedFrameRings - frame notification rings hosted in shared memory
+//!
+//! This class manages a set of lock-free single-producer, single-consumer rings of binary frame
+//! notifications in a region of shared memory, allowing frame ready and release notifications to
+//! be passed between the frame receiver and processor without a message transport. Each ring
+//! index has a ready ring, produced by a frame receiver RX thread and consumed by the frame
+//! processor, and a release ring, produced by the frame processor and consumed by the same RX
+//! thread. The consumer of the ready rings can block on a futex in the shared region (or poll
+//! where futexes are not available) until any ready ring is non-empty. Producers of the release rings within a process are serialised
+//! on a process-local mutex, so that any thread may release a frame.
+class SharedFrameRings
+{
+public:
+
+  typedef FrameNotification::Layout Descriptor;
+
+  static const uint32_t magic = 0x52524653;  //!< Magic number, "SFRR" when encoded
+  static const uint16_t version = 1;         //!< Current layout version
+
+  SharedFrameRings(void* region, size_t region_size, unsigned int num_rings, unsigned int capacity);
+  SharedFrameRings(void* region, size_t region_size);
+
+  static size_t region_size(unsigned int num_rings, unsigned int capacity);
+  static unsigned int capacity_for(size_t num_buffers);
+  static bool is_present(const void* region, size_t region_size);
+
+  unsigned int get_num_rings(void) const;
+  unsigned int get_capacity(void) const;
+
+  bool push_ready(unsigned int ring, const FrameNotification& notification);
+  bool pop_ready(unsigned int ring, FrameNotification& notification);
+  bool push_release(unsigned int ring, const FrameNotification& notification);
+  bool pop_release(unsigned int ring, FrameNotification& notification);
+  bool wait_ready(unsigned int timeout_ms);
+  void interrupt_wait(void);
+
+private:
+
+  //! Header at the start of the shared region
+  typedef struct
+  {
+    uint32_t magic;          //!< Magic number identifying formatted rings
+    uint16_t version;        //!< Layout version
+    uint16_t reserved;       //!< Reserved for future use
+    uint32_t num_rings;      //!< Number of ready and release ring pairs
+    uint32_t capacity;       //!< Number of descriptors in each ring, a power of two
+    uint32_t ready_seq;      //!< Futex word advanced when waking the ready ring consumer
+    uint32_t ready_waiters;  //!< Flag set while the ready ring consumer is waiting
+    char     pad[40];        //!< Pad to a cache line
+  } Header;
+
+  //! Ring indices, each on its own cache line to avoid false sharing
+  typedef struct
+  {
+    uint64_t head;           //!< Index of the next descriptor to consume
+    char     head_pad[56];   //!< Pad to a cache line
+    uint64_t tail;           //!< Index of the next descriptor to produce
+    char     tail_pad[56];   //!< Pad to a cache line
+  } RingIndex;
+
+  static size_t ring_stride(unsigned int capacity);
+  void map_rings(void);
+
+  bool push(unsigned int ring, const FrameNotification& notification);
+  bool pop(unsigned int ring, FrameNotification& notification);
+  bool any_ready(void);
+  void wake_ready(void);
+
+  char*        region_;          //!< Start of the shared region
+  Header*      header_;          //!< Header of the shared region
+  size_t       stride_;          //!< Size of each ring in the region
+  boost::mutex release_mutex_;   //!< Serialises release ring producers in this process
+};
+
+} // namespace OdinData
+#endif /* SHAREDFRAMERINGS_H_ */
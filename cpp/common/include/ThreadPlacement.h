@@ -0,0 +1,95 @@
+/*!
+ * ThreadPlacement.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef THREADPLACEMENT_H_
+#define THREADPLACEMENT_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <sys/types.h>
+
+#include <boost/thread.hpp>
+
+#include "OdinDataException.h"
+#include "IpcMessage.h"
+
+namespace OdinData
+{
+
+//! ThreadPlacementException - custom exception class implementing "what" for error string
+class ThreadPlacementException : public OdinDataException {
+public:
+  ThreadPlacementException(const std::string what) : OdinDataException(what) { }
+};
+
+//! ThreadPlacement - CPU affinity, scheduling and NUMA memory placement of named threads
+//!
+//! This singleton class maintains a table of named placement specifications and a registry of
+//! the threads running in an application. Threads register themselves by name when they start,
+//! at which point any matching specification is applied. Specifications are matched by the
+//! full thread name first, then by successively stripping trailing underscore-separated
+//! segments, so that e.g. a specification for "plugin" applies to thread "plugin_hdf".
+class ThreadPlacement
+{
+public:
+
+  //! Placement specification for a named thread
+  typedef struct
+  {
+    std::vector<int> cpus;         //!< CPUs the thread may run on, empty for no restriction
+    bool             has_priority; //!< Scheduling is set from priority, else left unchanged
+    int              priority;     //!< SCHED_FIFO priority, zero for normal scheduling
+    int              numa_node;    //!< NUMA node for memory allocation, -1 for no policy
+    bool             numa_bind;    //!< Bind memory to the NUMA node rather than preferring it
+  } Spec;
+
+  static ThreadPlacement& Instance(void);
+
+  void configure(const IpcMessage& config);
+  void clear(void);
+
+  std::string register_thread(const std::string& name);
+  void unregister_thread(const std::string& name);
+  void register_zmq_io_threads(void);
+
+  void configuration(const std::string& prefix, IpcMessage& reply);
+  void status(const std::string& prefix, IpcMessage& status);
+
+  static std::vector<int> parse_cpu_list(const std::string& cpu_list);
+  static std::string format_cpu_list(const std::vector<int>& cpus);
+
+private:
+
+  //! Registry entry for a running thread
+  typedef struct
+  {
+    pid_t       tid;          //!< Kernel thread ID
+    bool        external;     //!< Thread is not owned by odin-data, e.g. a ZeroMQ IO thread
+    int         numa_node;    //!< NUMA node applied to the thread memory policy, -1 if none
+    std::string error;        //!< Error encountered when applying placement, empty if none
+  } Entry;
+
+  ThreadPlacement();
+  ThreadPlacement(const ThreadPlacement&);
+  ThreadPlacement& operator=(const ThreadPlacement&);
+
+  Spec parse_spec(const std::string& name, const IpcMessage& spec_config);
+  bool find_spec(const std::string& name, Spec& spec) const;
+  void apply(const std::string& name, Entry& entry, bool calling_thread);
+  void prune(void);
+
+  static pid_t gettid(void);
+  static std::vector<int> numa_node_cpus(int numa_node);
+
+  boost::mutex                  mutex_;    //!< Mutex protecting the specification and thread tables
+  std::map<std::string, Spec>   specs_;    //!< Placement specifications indexed by name
+  std::map<std::string, Entry>  threads_;  //!< Registered threads indexed by unique name
+};
+
+} // namespace OdinData
+#endif /* THREADPLACEMENT_H_ */
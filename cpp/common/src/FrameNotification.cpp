@@ -0,0 +1,179 @@
+/*!
+ * FrameNotification.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <cstring>
+#include <sstream>
+#include <endian.h>
+
+#include "FrameNotification.h"
+#include "gettime.h"
+
+#if __BYTE_ORDER != __LITTLE_ENDIAN
+#error "FrameNotification binary layout requires a little-endian host"
+#endif
+
+using namespace OdinData;
+
+//! Default constructor for the FrameNotification class.
+//!
+//! This constructor creates an empty notification with an illegal type.
+//!
+FrameNotification::FrameNotification()
+{
+  memset(&layout_, 0, sizeof(layout_));
+  layout_.magic = magic;
+  layout_.version = version;
+}
+
+//! Constructor for the FrameNotification class.
+//!
+//! This constructor creates a notification of the specified type for a frame in a buffer. The
+//! ready time is set to the current time for frame ready notifications.
+//!
+//! \param[in] type - notification type
+//! \param[in] frame - frame number
+//! \param[in] buffer_id - shared buffer ID containing the frame
+//! \param[in] state - state of the frame
+//!
+FrameNotification::FrameNotification(Type type, uint64_t frame, uint32_t buffer_id, State state)
+{
+  memset(&layout_, 0, sizeof(layout_));
+  layout_.magic = magic;
+  layout_.version = version;
+  layout_.type = type;
+  layout_.frame = frame;
+  layout_.buffer_id = buffer_id;
+  layout_.state = state;
+  if (type == TypeFrameReady)
+  {
+    layout_.ready_time_ns = now_ns();
+  }
+}
+
+//! Constructor for the FrameNotification class decoding an encoded notification.
+//!
+//! This constructor decodes a binary notification received on a channel. An exception is thrown
+//! if the message is not a binary notification or has an unsupported version.
+//!
+//! \param[in] encoded - encoded notification
+//!
+FrameNotification::FrameNotification(const std::string& encoded)
+{
+  if (!is_binary(encoded))
+  {
+    throw FrameNotificationException("Message is not a binary frame notification");
+  }
+  memcpy(&layout_, encoded.data(), sizeof(layout_));
+  if (layout_.version != version)
+  {
+    std::stringstream ss;
+    ss << "Unsupported binary frame notification version " << layout_.version;
+    throw FrameNotificationException(ss.str());
+  }
+}
+
+//! Constructor for the FrameNotification class from fields in encoded layout.
+//!
+//! This constructor creates a notification from fields already in the encoded layout, e.g.
+//! read from a notification ring in shared memory.
+//!
+//! \param[in] layout - notification fields in encoded layout
+//!
+FrameNotification::FrameNotification(const Layout& layout) :
+    layout_(layout)
+{
+}
+
+//! Determine if a message is a binary notification.
+//!
+//! This static method tests if a message received on a channel is a binary notification, rather
+//! than e.g. a JSON-encoded IpcMessage, from its size and magic number.
+//!
+//! \param[in] encoded - message received
+//! \return true if the message is a binary notification
+//!
+bool FrameNotification::is_binary(const std::string& encoded)
+{
+  uint32_t encoded_magic;
+  if (encoded.size() != sizeof(Layout))
+  {
+    return false;
+  }
+  memcpy(&encoded_magic, encoded.data(), sizeof(encoded_magic));
+  return (encoded_magic == magic);
+}
+
+//! Determine if a message is a batch of binary notifications.
+//!
+//! This static method tests if a message received on a channel is one or more concatenated
+//! binary notifications, from its size and the magic number of the first notification. A single
+//! binary notification is also a valid batch.
+//!
+//! \param[in] encoded - message received
+//! \return true if the message is a batch of binary notifications
+//!
+bool FrameNotification::is_binary_batch(const std::string& encoded)
+{
+  uint32_t encoded_magic;
+  if (encoded.empty() || (encoded.size() % sizeof(Layout)))
+  {
+    return false;
+  }
+  memcpy(&encoded_magic, encoded.data(), sizeof(encoded_magic));
+  return (encoded_magic == magic);
+}
+
+//! Decode a batch of binary notifications.
+//!
+//! This static method decodes each of the concatenated binary notifications in a batched message,
+//! appending them to the vector passed as an argument. An exception is thrown if the message is
+//! not a batch or any notification in it is invalid.
+//!
+//! \param[in] encoded - encoded batch of notifications
+//! \param[out] notifications - vector to append the decoded notifications to
+//!
+void FrameNotification::decode_batch(const std::string& encoded,
+    std::vector<FrameNotification>& notifications)
+{
+  if (!is_binary_batch(encoded))
+  {
+    throw FrameNotificationException("Message is not a batch of binary frame notifications");
+  }
+  for (size_t offset = 0; offset < encoded.size(); offset += sizeof(Layout))
+  {
+    notifications.push_back(FrameNotification(encoded.substr(offset, sizeof(Layout))));
+  }
+}
+
+//! Return the current time in nanoseconds since the epoch.
+//!
+//! \return current time in nanoseconds
+//!
+uint64_t FrameNotification::now_ns(void)
+{
+  struct timespec now;
+  gettime(&now);
+  return (static_cast<uint64_t>(now.tv_sec) * 1000000000) + now.tv_nsec;
+}
+
+//! Encode the notification.
+//!
+//! \return encoded binary notification
+//!
+std::string FrameNotification::encode(void) const
+{
+  return std::string(reinterpret_cast<const char*>(&layout_), sizeof(layout_));
+}
+
+//! Encode the notification onto the end of a batch.
+//!
+//! \param[in,out] encoded - batch of encoded notifications to append to
+//!
+void FrameNotification::encode_to_batch(std::string& encoded) const
+{
+  encoded.append(reinterpret_cast<const char*>(&layout_), sizeof(layout_));
+}
@@ -247,7 +247,6 @@ void IpcReactor::remove_timer(int timer_id)
 int IpcReactor::run(void)
 {
   int rc = 0;
-  boost::unique_lock<boost::mutex> lock(mutex_, boost::defer_lock);
 
   // Loop until the terminate flag is set
   while (!terminate_reactor_)
@@ -266,78 +265,136 @@ int IpcReactor::run(void)
       break;
     }
 
-    try
-    {
+    rc = run_once();
+  }
+
+  return rc;
+}
+
+//! Runs a single iteration of the reactor polling loop
+//!
+//! This method polls the registered channels and sockets once, handling any callbacks
+//! to those ready to read, and then handles any timers that have fired. This allows a
+//! caller to drive the reactor from its own event loop, e.g. interleaving reactor
+//! iterations with non-blocking socket receives. The poll timeout can be specified
+//! explicitly, with zero returning immediately, or defaults to the tickless timeout
+//! based on the currently registered timers.
+//!
+//! \param[in] timeout_ms - poll timeout in milliseconds, negative for tickless timeout
+//! \return integer return code, 0 = OK, -1 = error
+
+int IpcReactor::run_once(long timeout_ms)
+{
+  int rc = 0;
+  boost::unique_lock<boost::mutex> lock(mutex_, boost::defer_lock);
 
-      // Poll the registered channels, using the tickless timeout based
-      // on the next pending timer
-      int pollrc = zmq::poll(pollitems_, pollsize_, calculate_timeout());
+  // If the poll items list needs rebuilding, do it now
+  if (needs_rebuild_)
+  {
+    rebuild_pollitems();
+  }
+
+  try
+  {
+
+    // Poll the registered channels, using the tickless timeout based
+    // on the next pending timer if no timeout is specified
+    if (timeout_ms < 0)
+    {
+      timeout_ms = calculate_timeout();
+    }
+    int pollrc = zmq::poll(pollitems_, pollsize_, timeout_ms);
 
-      if (pollrc > 0)
+    if (pollrc > 0)
+    {
+      // If there were any channels ready to read, execute their callbacks
+      for (size_t item = 0; item < pollsize_; ++item)
       {
-        // If there were any channels ready to read, execute their callbacks
-        for (size_t item = 0; item < pollsize_; ++item)
+        // TODO handle error flag on pollitems
+        if (pollitems_[item].revents & ZMQ_POLLIN)
         {
-          // TODO handle error flag on pollitems
-          if (pollitems_[item].revents & ZMQ_POLLIN)
-          {
-            callbacks_[item]();
-          }
+          callbacks_[item]();
         }
       }
-      else if (pollrc == 0)
+    }
+    else if (pollrc == 0)
+    {
+      // Poll timed out, do nothing as we handle timers firing unconditionally below
+    }
+    else
+    {
+      // An error occurred, terminate the reactor loop
+      rc = -1;
+      terminate_reactor_ = true;
+    }
+
+    // Take lock while accessing timers_
+    lock.lock();
+    // Handle any timers that have now fired, calling their callbacks. Erase any timers
+    // that have now expired
+    TimerMap::iterator it = timers_.begin();
+    while (it != timers_.end())
+    {
+      if ((it->second)->has_fired())
       {
-        // Poll timed out, do nothing as we handle timers firing unconditionally below
+        (it->second)->do_callback();
       }
-      else
+      if ((it->second)->has_expired())
       {
-        // An error occurred, terminate the reactor loop
-        rc = -1;
-        terminate_reactor_ = true;
+        timers_.erase(it++);
       }
-
-      // Take lock while accessing timers_
-      lock.lock();
-      // Handle any timers that have now fired, calling their callbacks. Erase any timers
-      // that have now expired
-      TimerMap::iterator it = timers_.begin();
-      while (it != timers_.end())
+      else
       {
-        if ((it->second)->has_fired())
-        {
-          (it->second)->do_callback();
-        }
-        if ((it->second)->has_expired())
-        {
-          timers_.erase(it++);
-        }
-        else
-        {
-          ++it;
-        }
+        ++it;
       }
-      lock.unlock();
     }
-    catch ( zmq::error_t& e)
-    {
-      // If the exception was thrown with errno EINTR, i.e. interrupted system call, this is
-      // because we have installed a custom signal handler, so terminate the reactor gracefully
-      if (e.num() == EINTR) {
-        rc = -1;
-        terminate_reactor_ = true;
-      }
-        // Otherwise propogate the exception upwards
-      else {
-        std::stringstream ss;
-        ss << "IpcReactor error while polling: " << e.what();
-        throw IpcReactorException(ss.str());
-      }
+    lock.unlock();
+  }
+  catch ( zmq::error_t& e)
+  {
+    // If the exception was thrown with errno EINTR, i.e. interrupted system call, this is
+    // because we have installed a custom signal handler, so terminate the reactor gracefully
+    if (e.num() == EINTR) {
+      rc = -1;
+      terminate_reactor_ = true;
+    }
+      // Otherwise propogate the exception upwards
+    else {
+      std::stringstream ss;
+      ss << "IpcReactor error while polling: " << e.what();
+      throw IpcReactorException(ss.str());
     }
   }
 
   return rc;
 }
 
+//! Returns the time until the next timer is due to fire
+//!
+//! This method returns the time in milliseconds until the next registered timer is due to fire,
+//! allowing an external event loop driving the reactor with run_once() to wait on other event
+//! sources for no longer than the reactor would itself.
+//!
+//! \return time in milliseconds until the next timer fires, zero if a timer is already due
+
+long IpcReactor::get_next_timeout(void)
+{
+  return calculate_timeout();
+}
+
+//! Indicates if the reactor has been signalled to stop
+//!
+//! This method indicates if the reactor has been signalled to stop, either by a call to
+//! stop() or due to an error, allowing an external event loop driving the reactor with
+//! run_once() to terminate.
+//!
+//! \return true if the reactor has been signalled to stop
+
+bool IpcReactor::is_stopped(void) const
+{
+  return terminate_reactor_;
+}
+
 //! Signals that the reactor polling loop should stop gracefully
 //!
 //! This method is used to signal that the reactor polling loop should stop gracefully.
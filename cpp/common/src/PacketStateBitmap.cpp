@@ -0,0 +1,139 @@
+/*!
+ * PacketStateBitmap.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <cstring>
+
+#include "PacketStateBitmap.h"
+
+namespace OdinData
+{
+
+const unsigned int PacketStateBitmap::word_bits;
+
+//! Construct a PacketStateBitmap over an array of words
+//!
+//! The array is not cleared on construction, allowing a bitmap to be constructed over the state
+//! of a frame already being received.
+//!
+//! \param[in] words - array of at least num_words(num_packets) words
+//! \param[in] num_packets - number of packets tracked
+//!
+PacketStateBitmap::PacketStateBitmap(Word* words, std::size_t num_packets) :
+    words_(words),
+    num_packets_(num_packets)
+{
+}
+
+//! Mark every packet as missing
+//!
+//! Only the words tracking the packets of this bitmap are cleared, so that the cost of
+//! initialising a frame scales with the packets it contains, not the size of the array.
+//!
+void PacketStateBitmap::clear(void)
+{
+  memset(words_, 0, num_words(num_packets_) * sizeof(Word));
+}
+
+//! Return the number of packets tracked
+//!
+//! \return number of packets
+//!
+std::size_t PacketStateBitmap::get_num_packets(void) const
+{
+  return num_packets_;
+}
+
+//! Return the number of packets received
+//!
+//! \return number of packets received
+//!
+std::size_t PacketStateBitmap::num_received(void) const
+{
+  // Count with the unused bits of the last word set, to ignore any stale bits there, and then
+  // discount them
+  std::size_t received = 0;
+  std::size_t words = num_words(num_packets_);
+  for (std::size_t word_index = 0; word_index < words; word_index++)
+  {
+    received += __builtin_popcountll(received_word(word_index));
+  }
+  return received - ((words * word_bits) - num_packets_);
+}
+
+//! Return the number of packets missing
+//!
+//! \return number of packets not yet received
+//!
+std::size_t PacketStateBitmap::num_missing(void) const
+{
+  return num_packets_ - num_received();
+}
+
+//! Find the next range of missing packets
+//!
+//! This method searches for the next run of consecutive missing packets at or after the packet
+//! specified by the first argument, skipping a whole word of received packets at a time.
+//! Iterating over the missing ranges of a frame is done by passing the end of one range as the
+//! start of the search for the next.
+//!
+//! \param[in,out] first - packet to start searching from, set to the first missing packet found
+//! \param[out] last - set to one past the last packet of the missing range
+//! \return true if a missing range was found
+//!
+bool PacketStateBitmap::next_missing_range(std::size_t& first, std::size_t& last) const
+{
+  if (first >= num_packets_)
+  {
+    return false;
+  }
+
+  // Find the first missing packet, ignoring packets before the start of the search
+  std::size_t words = num_words(num_packets_);
+  std::size_t word_index = first / word_bits;
+  Word missing = ~received_word(word_index) & (~static_cast<Word>(0) << (first % word_bits));
+  while (!missing)
+  {
+    if (++word_index == words)
+    {
+      return false;
+    }
+    missing = ~received_word(word_index);
+  }
+  first = (word_index * word_bits) + __builtin_ctzll(missing);
+
+  // Find the next received packet following it, treating packets past the end as received
+  Word received = received_word(word_index) & (~static_cast<Word>(0) << (first % word_bits));
+  while (!received)
+  {
+    if (++word_index == words)
+    {
+      last = num_packets_;
+      return true;
+    }
+    received = received_word(word_index);
+  }
+  last = (word_index * word_bits) + __builtin_ctzll(received);
+  return true;
+}
+
+//! Return a bitmap word with the bits past the last packet tracked set as received
+//!
+//! \param[in] word_index - index of the word
+//! \return bitmap word
+//!
+PacketStateBitmap::Word PacketStateBitmap::received_word(std::size_t word_index) const
+{
+  Word word = words_[word_index];
+  std::size_t used_bits = num_packets_ - (word_index * word_bits);
+  if (used_bits < word_bits)
+  {
+    word |= ~static_cast<Word>(0) << used_bits;
+  }
+  return word;
+}
+
+} // namespace OdinData
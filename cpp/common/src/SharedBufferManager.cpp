@@ -6,45 +6,131 @@
  */
 
 #include <sstream>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#ifdef __linux__
+#include <sys/vfs.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
 
 #include "SharedBufferManager.h"
 
 using namespace OdinData;
 using namespace boost::interprocess;
 
+//! HugePageFileGuard - creates a huge page file for a shared buffer, removing it on failure
+//!
+//! The guard creates and sizes the huge page file backing a new shared buffer. If the file was
+//! created by the guard it is unlinked when the guard is destroyed, unless the guard is dismissed
+//! once the shared buffer has been created, so that a failure to size, map or initialise the
+//! shared buffer does not leave the file in the mount.
+class SharedBufferManager::HugePageFileGuard
+{
+public:
+  HugePageFileGuard() : created_(false) {}
+
+  ~HugePageFileGuard()
+  {
+    if (created_)
+    {
+      unlink(path_.c_str());
+    }
+  }
+
+  //! Create a huge page file, or open an existing one, and set its size
+  void create_file(const std::string& path, size_t size)
+  {
+    path_ = path;
+    int fd = open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd >= 0)
+    {
+      created_ = true;
+    }
+    else if (errno == EEXIST)
+    {
+      fd = open(path.c_str(), O_RDWR);
+    }
+    if (fd < 0)
+    {
+      std::stringstream ss;
+      ss << "Failed to create huge page file " << path << ": " << strerror(errno);
+      throw SharedBufferManagerException(ss.str());
+    }
+    int rc = ftruncate(fd, size);
+    int truncate_errno = errno;
+    close(fd);
+    if (rc != 0)
+    {
+      std::stringstream ss;
+      ss << "Failed to size huge page file " << path << " to " << size << " bytes: "
+         << strerror(truncate_errno);
+      throw SharedBufferManagerException(ss.str());
+    }
+  }
+
+  //! Keep the file once the shared buffer has been created
+  void dismiss(void)
+  {
+    created_ = false;
+  }
+
+private:
+  std::string path_;  //!< Path of the huge page file
+  bool created_;      //!< Indicates the file was created by the guard
+};
+
 SharedBufferManager::SharedBufferManager(const std::string& shared_mem_name, const size_t shared_mem_size,
-                                         const size_t buffer_size, bool remove_when_deleted) try :
+                                         const size_t buffer_size, bool remove_when_deleted,
+                                         const unsigned int num_frame_rings, bool buffer_states,
+                                         const MemoryOptions& memory_options) try :
     shared_mem_name_(shared_mem_name),
     shared_mem_size_(shared_mem_size),
     remove_when_deleted_(remove_when_deleted),
-    shared_mem_(open_or_create, shared_mem_name_.c_str(), read_write),
-    manager_hdr_(0)
+    page_size_(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+    locked_(false),
+    numa_node_(-1),
+    manager_hdr_(0),
+    num_buffers_(0)
 {
 
-  // Check that the buffer size specified is non-zero
-  if (buffer_size == 0)
-  {
-    throw SharedBufferManagerException("Zero shared memory buffer size specified");
-  }
+  // Create the shared buffer with a single pool of buffers of the requested size
+  this->create(std::vector<PoolSpec>(1, PoolSpec(buffer_size, shared_mem_size_)), num_frame_rings,
+               buffer_states, memory_options);
 
-  // Set the size of the shared memory object
-  shared_mem_.truncate(sizeof(Header) + shared_mem_size_);
+}
+catch (interprocess_exception& e)
+{
+  // Catch, transform and rethrow any exceptions thrown during the member initializer list
+  std::stringstream ss;
+  ss << "Failed to create shared buffer manager: " << e.what();
+  throw (SharedBufferManagerException(ss.str()));
+}
 
-  // Map the whole shared memory region into this process
-  shared_mem_region_ = mapped_region(shared_mem_, read_write);
+SharedBufferManager::SharedBufferManager(const std::string& shared_mem_name,
+                                         const std::vector<PoolSpec>& pools,
+                                         bool remove_when_deleted, const unsigned int num_frame_rings,
+                                         bool buffer_states, const MemoryOptions& memory_options) try :
+    shared_mem_name_(shared_mem_name),
+    shared_mem_size_(0),
+    remove_when_deleted_(remove_when_deleted),
+    page_size_(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+    locked_(false),
+    numa_node_(-1),
+    manager_hdr_(0),
+    num_buffers_(0)
+{
 
-  // Determine how many buffers of the requested size fit into the shared memory region
-  size_t num_buffers = shared_mem_size_ / buffer_size;
-  if (!num_buffers)
+  for (std::vector<PoolSpec>::const_iterator pool = pools.begin(); pool != pools.end(); ++pool)
   {
-    throw SharedBufferManagerException("Buffer size requested exceeds size of shared memory");
+    shared_mem_size_ += pool->pool_size;
   }
-
-  // Initialise the buffer manager header
-  manager_hdr_ = reinterpret_cast<Header*>(shared_mem_region_.get_address());
-  manager_hdr_->manager_id = last_manager_id++;
-  manager_hdr_->num_buffers = num_buffers;
-  manager_hdr_->buffer_size = buffer_size;
+  this->create(pools, num_frame_rings, buffer_states, memory_options);
 
 }
 catch (interprocess_exception& e)
@@ -58,17 +144,77 @@ catch (interprocess_exception& e)
 SharedBufferManager::SharedBufferManager(const std::string& shared_mem_name) try :
     shared_mem_name_(shared_mem_name),
     remove_when_deleted_(false),
-    shared_mem_(open_only, shared_mem_name_.c_str(), read_write)
+    page_size_(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+    locked_(false),
+    numa_node_(-1),
+    manager_hdr_(0),
+    num_buffers_(0)
 {
 
-  // Map the whole shared memory region into this process
-  shared_mem_region_ = mapped_region(shared_mem_, read_write);
+  // Map the whole shared memory region into this process. A region backed by huge pages is a
+  // file in a hugetlbfs mount rather than a shared memory object, so look for the name in each
+  // mount if no shared memory object exists.
+  try
+  {
+    shared_mem_ = shared_memory_object(open_only, shared_mem_name_.c_str(), read_write);
+    shared_mem_region_ = mapped_region(shared_mem_, read_write);
+  }
+  catch (interprocess_exception& e)
+  {
+    std::vector<std::string> mounts = huge_page_mounts();
+    for (std::vector<std::string>::iterator mount = mounts.begin(); mount != mounts.end(); ++mount)
+    {
+      std::string path = *mount + "/" + shared_mem_name_;
+      if (access(path.c_str(), F_OK) == 0)
+      {
+        huge_page_path_ = path;
+        page_size_ = fs_block_size(*mount);
+        break;
+      }
+    }
+    if (huge_page_path_.empty())
+    {
+      throw;
+    }
+    this->map_huge_page_file(huge_page_path_);
+  }
 
   // Determine how big the region is
   shared_mem_size_ = shared_mem_region_.get_size();
 
-  // Map the buffer manager header
+  // Map the buffer manager header, which describes the first pool of buffers
   manager_hdr_ = reinterpret_cast<Header*>(shared_mem_region_.get_address());
+  Pool first_pool = {sizeof(Header), manager_hdr_->buffer_size, manager_hdr_->num_buffers, 0};
+  pools_.assign(1, first_pool);
+
+  // Attach to any pool table, buffer state table and frame notification rings hosted in the
+  // region after the first pool, in that order
+  size_t extension_offset = this->extension_offset();
+  if (shared_mem_size_ > extension_offset)
+  {
+    char* extension_region = static_cast<char*>(shared_mem_region_.get_address()) + extension_offset;
+    size_t extension_size = shared_mem_size_ - extension_offset;
+    const PoolTable* pool_table = reinterpret_cast<const PoolTable*>(extension_region);
+    if ((extension_size >= sizeof(PoolTable)) && (pool_table->magic == pool_table_magic) &&
+        (pool_table->num_pools <= max_pools) && (pool_table->end_offset <= shared_mem_size_))
+    {
+      pools_.assign(pool_table->pools, pool_table->pools + pool_table->num_pools);
+      extension_region = static_cast<char*>(shared_mem_region_.get_address()) + pool_table->end_offset;
+      extension_size = shared_mem_size_ - pool_table->end_offset;
+    }
+    if (SharedBufferStates::is_present(extension_region, extension_size))
+    {
+      buffer_states_.reset(new SharedBufferStates(extension_region, extension_size));
+      size_t buffer_states_size = SharedBufferStates::region_size(buffer_states_->get_num_buffers());
+      extension_region += buffer_states_size;
+      extension_size -= buffer_states_size;
+    }
+    if (SharedFrameRings::is_present(extension_region, extension_size))
+    {
+      frame_rings_.reset(new SharedFrameRings(extension_region, extension_size));
+    }
+  }
+  num_buffers_ = pools_.back().first_buffer + pools_.back().num_buffers;
 
 }
 catch (interprocess_exception& e)
@@ -83,7 +229,14 @@ SharedBufferManager::~SharedBufferManager()
 {
   if (remove_when_deleted_)
   {
-    shared_memory_object::remove(shared_mem_name_.c_str());
+    if (!huge_page_path_.empty())
+    {
+      unlink(huge_page_path_.c_str());
+    }
+    else
+    {
+      shared_memory_object::remove(shared_mem_name_.c_str());
+    }
   }
 }
 
@@ -93,7 +246,7 @@ const size_t SharedBufferManager::get_manager_id(void) const
 }
 const size_t SharedBufferManager::get_num_buffers(void) const
 {
-  return manager_hdr_->num_buffers;
+  return num_buffers_;
 }
 
 const size_t SharedBufferManager::get_buffer_size(void) const
@@ -101,15 +254,340 @@ const size_t SharedBufferManager::get_buffer_size(void) const
   return manager_hdr_->buffer_size;
 }
 
+const size_t SharedBufferManager::get_buffer_size(const unsigned int buffer) const
+{
+  return this->pool_of(buffer).buffer_size;
+}
+
 void* SharedBufferManager::get_buffer_address(const unsigned int buffer) const
 {
-  if (buffer >= manager_hdr_->num_buffers)
+  const Pool& pool = this->pool_of(buffer);
+  return reinterpret_cast<void *>((char*)shared_mem_region_.get_address() + pool.offset +
+      (buffer - pool.first_buffer) * pool.buffer_size);
+}
+
+const unsigned int SharedBufferManager::get_num_pools(void) const
+{
+  return pools_.size();
+}
+
+const unsigned int SharedBufferManager::get_buffer_pool(const unsigned int buffer) const
+{
+  return &(this->pool_of(buffer)) - &pools_[0];
+}
+
+const size_t SharedBufferManager::get_pool_first_buffer(const unsigned int pool) const
+{
+  if (pool >= pools_.size())
+  {
+    std::stringstream ss;
+    ss << "Illegal buffer pool index specified: " << pool;
+    throw SharedBufferManagerException(ss.str());
+  }
+  return pools_[pool].first_buffer;
+}
+
+const size_t SharedBufferManager::get_pool_num_buffers(const unsigned int pool) const
+{
+  if (pool >= pools_.size())
+  {
+    std::stringstream ss;
+    ss << "Illegal buffer pool index specified: " << pool;
+    throw SharedBufferManagerException(ss.str());
+  }
+  return pools_[pool].num_buffers;
+}
+
+const size_t SharedBufferManager::get_pool_buffer_size(const unsigned int pool) const
+{
+  if (pool >= pools_.size())
+  {
+    std::stringstream ss;
+    ss << "Illegal buffer pool index specified: " << pool;
+    throw SharedBufferManagerException(ss.str());
+  }
+  return pools_[pool].buffer_size;
+}
+
+const unsigned int SharedBufferManager::get_num_frame_rings(void) const
+{
+  return frame_rings_ ? frame_rings_->get_num_rings() : 0;
+}
+
+SharedFrameRings* SharedBufferManager::get_frame_rings(void) const
+{
+  return frame_rings_.get();
+}
+
+SharedBufferStates* SharedBufferManager::get_buffer_states(void) const
+{
+  return buffer_states_.get();
+}
+
+const size_t SharedBufferManager::get_page_size(void) const
+{
+  return page_size_;
+}
+
+const bool SharedBufferManager::get_locked(void) const
+{
+  return locked_;
+}
+
+const int SharedBufferManager::get_numa_node(void) const
+{
+  return numa_node_;
+}
+
+void SharedBufferManager::create(const std::vector<PoolSpec>& pools, const unsigned int num_frame_rings,
+                                 bool buffer_states, const MemoryOptions& memory_options)
+{
+
+  if (pools.empty() || (pools.size() > max_pools))
+  {
+    std::stringstream ss;
+    ss << "Number of buffer pools specified must be between 1 and " << max_pools;
+    throw SharedBufferManagerException(ss.str());
+  }
+
+  // Lay out the pools of buffers. The first pool follows the header, as in a shared buffer with a
+  // single pool, so that clients unaware of pools can still map it. Any further pools follow a
+  // table describing all the pools after the first.
+  size_t offset = sizeof(Header);
+  for (unsigned int pool_idx = 0; pool_idx < pools.size(); pool_idx++)
+  {
+    // Check that the buffer size specified is non-zero
+    if (pools[pool_idx].buffer_size == 0)
+    {
+      throw SharedBufferManagerException("Zero shared memory buffer size specified");
+    }
+
+    // Determine how many buffers of the requested size fit into the memory given to the pool
+    Pool pool;
+    pool.buffer_size = pools[pool_idx].buffer_size;
+    pool.num_buffers = pools[pool_idx].pool_size / pool.buffer_size;
+    if (!pool.num_buffers)
+    {
+      throw SharedBufferManagerException("Buffer size requested exceeds size of shared memory");
+    }
+    if (pool_idx == 1)
+    {
+      offset = align_offset(offset) + sizeof(PoolTable);
+    }
+    pool.offset = pool_idx ? align_offset(offset) : offset;
+    pool.first_buffer = num_buffers_;
+    offset = pool.offset + (pool.num_buffers * pool.buffer_size);
+    num_buffers_ += pool.num_buffers;
+    pools_.push_back(pool);
+  }
+
+  // Set the size of the shared memory object, extending it past the buffers to host a buffer
+  // state table and frame notification rings if requested, each ring able to hold a notification
+  // for every buffer
+  size_t extension_offset = sizeof(Header) + shared_mem_size_;
+  size_t buffer_states_size = 0;
+  size_t frame_rings_size = 0;
+  if (buffer_states || num_frame_rings || (pools_.size() > 1))
+  {
+    extension_offset = align_offset(offset);
+  }
+  if (buffer_states)
+  {
+    buffer_states_size = SharedBufferStates::region_size(num_buffers_);
+  }
+  if (num_frame_rings)
+  {
+    frame_rings_size = SharedFrameRings::region_size(num_frame_rings, num_buffers_);
+  }
+  size_t total_size = extension_offset + buffer_states_size + frame_rings_size;
+
+  // Remove any huge page file created below if the shared buffer cannot be fully created
+  HugePageFileGuard huge_page_file_guard;
+  if (memory_options.huge_page_size)
+  {
+#ifndef __linux__
+    throw SharedBufferManagerException("Huge page shared buffers are only supported on Linux");
+#endif
+    // Huge pages can only be shared between processes through a file in a hugetlbfs mount, so
+    // create the segment in the mount for the requested page size, rounded up to whole pages
+    std::vector<std::string> mounts = huge_page_mounts();
+    for (std::vector<std::string>::iterator mount = mounts.begin(); mount != mounts.end(); ++mount)
+    {
+      if (fs_block_size(*mount) == memory_options.huge_page_size)
+      {
+        huge_page_path_ = *mount + "/" + shared_mem_name_;
+        break;
+      }
+    }
+    if (huge_page_path_.empty())
+    {
+      std::stringstream ss;
+      ss << "No hugetlbfs mount found for huge page size " << memory_options.huge_page_size;
+      throw SharedBufferManagerException(ss.str());
+    }
+    size_t page_mask = memory_options.huge_page_size - 1;
+    huge_page_file_guard.create_file(huge_page_path_, (total_size + page_mask) & ~page_mask);
+    this->map_huge_page_file(huge_page_path_);
+    page_size_ = memory_options.huge_page_size;
+  }
+  else
+  {
+    // Create the shared memory object and map the whole region into this process
+    shared_mem_ = shared_memory_object(open_or_create, shared_mem_name_.c_str(), read_write);
+    shared_mem_.truncate(total_size);
+    shared_mem_region_ = mapped_region(shared_mem_, read_write);
+  }
+
+  // Bind, fault in and lock the memory as requested before any of it is initialised
+  this->place_memory(memory_options);
+
+  // Initialise the buffer manager header, which describes the first pool
+  manager_hdr_ = reinterpret_cast<Header*>(shared_mem_region_.get_address());
+  manager_hdr_->manager_id = last_manager_id++;
+  manager_hdr_->num_buffers = pools_[0].num_buffers;
+  manager_hdr_->buffer_size = pools_[0].buffer_size;
+
+  // Format the pool table if there is more than one pool, followed by the buffer state table and
+  // the frame notification rings
+  char* shared_mem_base = static_cast<char*>(shared_mem_region_.get_address());
+  if (pools_.size() > 1)
+  {
+    PoolTable* pool_table = reinterpret_cast<PoolTable*>(shared_mem_base + this->extension_offset());
+    memset(pool_table, 0, sizeof(PoolTable));
+    std::copy(pools_.begin(), pools_.end(), pool_table->pools);
+    pool_table->num_pools = pools_.size();
+    pool_table->end_offset = extension_offset;
+    pool_table->magic = pool_table_magic;
+  }
+  char* extension_region = shared_mem_base + extension_offset;
+  if (buffer_states)
+  {
+    buffer_states_.reset(new SharedBufferStates(extension_region, buffer_states_size, num_buffers_));
+  }
+  if (num_frame_rings)
+  {
+    frame_rings_.reset(new SharedFrameRings(extension_region + buffer_states_size,
+        frame_rings_size, num_frame_rings, num_buffers_));
+  }
+
+  huge_page_file_guard.dismiss();
+}
+
+const SharedBufferManager::Pool& SharedBufferManager::pool_of(const unsigned int buffer) const
+{
+  if (buffer >= num_buffers_)
   {
     std::stringstream ss;
     ss << "Illegal buffer index specified: " << buffer;
     throw SharedBufferManagerException(ss.str());
   }
-  return reinterpret_cast<void *>(((char*)shared_mem_region_.get_address() + sizeof(Header)) + buffer * manager_hdr_->buffer_size);
+  unsigned int pool = pools_.size() - 1;
+  while (buffer < pools_[pool].first_buffer)
+  {
+    pool--;
+  }
+  return pools_[pool];
+}
+
+size_t SharedBufferManager::extension_offset(void) const
+{
+  return align_offset(sizeof(Header) + (manager_hdr_->num_buffers * manager_hdr_->buffer_size));
+}
+
+size_t SharedBufferManager::align_offset(size_t offset)
+{
+  return ((offset + 63) / 64) * 64;
+}
+
+void SharedBufferManager::map_huge_page_file(const std::string& path)
+{
+  file_mapping huge_page_file(path.c_str(), read_write);
+  shared_mem_region_ = mapped_region(huge_page_file, read_write);
+}
+
+void SharedBufferManager::place_memory(const MemoryOptions& memory_options)
+{
+  char* address = static_cast<char*>(shared_mem_region_.get_address());
+  size_t size = shared_mem_region_.get_size();
+
+  if (memory_options.numa_node >= 0)
+  {
+#ifdef __linux__
+    unsigned long node_mask[16];
+    const unsigned long max_node = sizeof(node_mask) * 8;
+    memset(node_mask, 0, sizeof(node_mask));
+    if (static_cast<unsigned long>(memory_options.numa_node) < max_node)
+    {
+      node_mask[memory_options.numa_node / (sizeof(unsigned long) * 8)] |=
+          1UL << (memory_options.numa_node % (sizeof(unsigned long) * 8));
+    }
+    if (syscall(SYS_mbind, address, size, MPOL_BIND, node_mask, max_node, MPOL_MF_MOVE) != 0)
+    {
+      std::stringstream ss;
+      ss << "Failed to bind shared memory to NUMA node " << memory_options.numa_node << ": "
+         << strerror(errno);
+      throw SharedBufferManagerException(ss.str());
+    }
+    numa_node_ = memory_options.numa_node;
+#else
+    throw SharedBufferManagerException("NUMA binding of shared buffers is only supported on Linux");
+#endif
+  }
+
+  if (memory_options.lock)
+  {
+    // Locking the pages also faults them all in
+    if (mlock(address, size) != 0)
+    {
+      std::stringstream ss;
+      ss << "Failed to lock " << size << " bytes of shared memory: " << strerror(errno)
+         << " (check RLIMIT_MEMLOCK)";
+      throw SharedBufferManagerException(ss.str());
+    }
+    locked_ = true;
+  }
+  else if (memory_options.prefault)
+  {
+    // Write to every page so that it is allocated now rather than on first use
+    for (size_t offset = 0; offset < size; offset += page_size_)
+    {
+      volatile char* page = address + offset;
+      *page = *page;
+    }
+  }
 }
 
+std::vector<std::string> SharedBufferManager::huge_page_mounts(void)
+{
+  std::vector<std::string> mounts;
+#ifdef __linux__
+  std::ifstream mounts_file("/proc/mounts");
+  std::string device, mount_point, fs_type, line;
+  while (mounts_file >> device >> mount_point >> fs_type)
+  {
+    if (fs_type == "hugetlbfs")
+    {
+      mounts.push_back(mount_point);
+    }
+    std::getline(mounts_file, line);
+  }
+#endif
+  return mounts;
+}
+
+size_t SharedBufferManager::fs_block_size(const std::string& path)
+{
+#ifdef __linux__
+  struct statfs fs_stat;
+  if (statfs(path.c_str(), &fs_stat) == 0)
+  {
+    return static_cast<size_t>(fs_stat.f_bsize);
+  }
+#endif
+  return 0;
+}
+
+const unsigned int SharedBufferManager::max_pools;
+const uint32_t SharedBufferManager::pool_table_magic;
+
 size_t SharedBufferManager::last_manager_id = 0;
@@ -0,0 +1,420 @@
+/*!
+ * SharedBufferStates.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <cstring>
+#include <sstream>
+#include <unistd.h>
+
+#include "SharedBufferStates.h"
+#include "FrameNotification.h"
+
+using namespace OdinData;
+
+const uint64_t SharedBufferStates::any_frame;
+const uint32_t SharedBufferStates::no_rx_thread;
+const uint64_t SharedBufferStates::busy_timeout_ns;
+
+//! Constructor for the SharedBufferStates class formatting a new table.
+//!
+//! This constructor formats a region of shared memory as a table with every buffer free and not
+//! yet managed by an RX thread. The region must be cache line aligned and at least the size
+//! given by region_size().
+//!
+//! \param[in] region - start of the shared region
+//! \param[in] region_size - size of the shared region
+//! \param[in] num_buffers - number of buffers in the table
+//!
+SharedBufferStates::SharedBufferStates(void* region, size_t region_size, unsigned int num_buffers) :
+    region_(static_cast<char*>(region)),
+    header_(static_cast<Header*>(region)),
+    entries_(reinterpret_cast<Entry*>(static_cast<char*>(region) + sizeof(Header))),
+    pid_(static_cast<uint32_t>(getpid()))
+{
+  if (region_size < SharedBufferStates::region_size(num_buffers))
+  {
+    std::stringstream ss;
+    ss << "Shared region of " << region_size << " bytes too small for states of "
+       << num_buffers << " buffers";
+    throw SharedBufferStatesException(ss.str());
+  }
+
+  memset(region_, 0, SharedBufferStates::region_size(num_buffers));
+  header_->version = version;
+  header_->num_buffers = num_buffers;
+
+  uint64_t now_ns = FrameNotification::now_ns();
+  for (unsigned int buffer_id = 0; buffer_id < num_buffers; buffer_id++)
+  {
+    entries_[buffer_id].control = StateFree;
+    entries_[buffer_id].state_time_ns = now_ns;
+    entries_[buffer_id].owner_pid = pid_;
+    entries_[buffer_id].rx_thread = no_rx_thread;
+  }
+
+  // Publish the magic number last so that a process attaching concurrently sees a complete table
+  __atomic_store_n(&header_->magic, magic, __ATOMIC_RELEASE);
+}
+
+//! Constructor for the SharedBufferStates class attaching to an existing table.
+//!
+//! This constructor attaches to a table previously formatted in a region of shared memory by
+//! another process. An exception is thrown if no table is present in the region.
+//!
+//! \param[in] region - start of the shared region
+//! \param[in] region_size - size of the shared region
+//!
+SharedBufferStates::SharedBufferStates(void* region, size_t region_size) :
+    region_(static_cast<char*>(region)),
+    header_(static_cast<Header*>(region)),
+    entries_(reinterpret_cast<Entry*>(static_cast<char*>(region) + sizeof(Header))),
+    pid_(static_cast<uint32_t>(getpid()))
+{
+  if (!is_present(region, region_size))
+  {
+    throw SharedBufferStatesException("No buffer state table present in shared region");
+  }
+}
+
+//! Return the size of a shared region hosting a table.
+//!
+//! \param[in] num_buffers - number of buffers in the table
+//! \return size of the region in bytes
+//!
+size_t SharedBufferStates::region_size(unsigned int num_buffers)
+{
+  return sizeof(Header) + (num_buffers * sizeof(Entry));
+}
+
+//! Determine if a table is present in a shared region.
+//!
+//! \param[in] region - start of the shared region
+//! \param[in] region_size - size of the shared region
+//! \return true if a formatted table of a supported version is present
+//!
+bool SharedBufferStates::is_present(const void* region, size_t region_size)
+{
+  const Header* header = static_cast<const Header*>(region);
+  if (region_size < sizeof(Header))
+  {
+    return false;
+  }
+  if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != magic)
+  {
+    return false;
+  }
+  return ((header->version == version) &&
+          (region_size >= SharedBufferStates::region_size(header->num_buffers)));
+}
+
+//! Return the name of a buffer state.
+//!
+//! \param[in] state - buffer state
+//! \return name of the state
+//!
+const char* SharedBufferStates::state_name(State state)
+{
+  switch (state)
+  {
+    case StateFree:
+      return "free";
+    case StateReceiving:
+      return "receiving";
+    case StateReady:
+      return "ready";
+    case StateHeld:
+      return "held";
+    default:
+      return "unknown";
+  }
+}
+
+//! Return the state recorded in an entry.
+//!
+//! \param[in] entry - buffer entry
+//! \return buffer state
+//!
+SharedBufferStates::State SharedBufferStates::get_state(const Entry& entry)
+{
+  return static_cast<State>(entry.control & state_mask);
+}
+
+//! Determine if an entry was left busy by a transition that did not complete.
+//!
+//! \param[in] entry - buffer entry, from get_entry()
+//! \return true if the busy flag was still set after waiting for it to clear
+//!
+bool SharedBufferStates::is_busy(const Entry& entry)
+{
+  return (entry.control & busy) != 0;
+}
+
+//! Return the number of buffers in the table.
+//!
+//! \return number of buffers
+//!
+unsigned int SharedBufferStates::get_num_buffers(void) const
+{
+  return header_->num_buffers;
+}
+
+//! Read a consistent snapshot of the entry of a buffer.
+//!
+//! \param[in] buffer_id - buffer ID
+//! \param[out] entry - snapshot of the buffer entry
+//! \return true if the entry was read, false if the buffer ID is out of range
+//!
+bool SharedBufferStates::get_entry(unsigned int buffer_id, Entry& entry) const
+{
+  Entry* buffer_entry = this->entry(buffer_id);
+  if (!buffer_entry)
+  {
+    return false;
+  }
+  uint64_t control;
+  do
+  {
+    control = this->load_control(buffer_entry);
+    entry.frame = __atomic_load_n(&buffer_entry->frame, __ATOMIC_RELAXED);
+    entry.state_time_ns = __atomic_load_n(&buffer_entry->state_time_ns, __ATOMIC_RELAXED);
+    entry.owner_pid = __atomic_load_n(&buffer_entry->owner_pid, __ATOMIC_RELAXED);
+    entry.rx_thread = __atomic_load_n(&buffer_entry->rx_thread, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  } while (__atomic_load_n(&buffer_entry->control, __ATOMIC_RELAXED) != control);
+  entry.control = control;
+  return true;
+}
+
+//! Count the buffers in each state.
+//!
+//! \param[out] counts - number of buffers in each state, indexed by state
+//!
+void SharedBufferStates::get_state_counts(std::vector<unsigned int>& counts) const
+{
+  counts.assign(NumStates, 0);
+  for (unsigned int buffer_id = 0; buffer_id < header_->num_buffers; buffer_id++)
+  {
+    State state = static_cast<State>(this->load_control(&entries_[buffer_id]) & state_mask);
+    if (state < NumStates)
+    {
+      counts[state]++;
+    }
+  }
+}
+
+//! Mark a buffer as free.
+//!
+//! This method is called by the frame receiver when it adds a buffer to those available to an
+//! RX thread, recording the thread that now manages the buffer.
+//!
+//! \param[in] buffer_id - buffer ID
+//! \param[in] rx_thread - index of the RX thread managing the buffer
+//!
+void SharedBufferStates::set_free(unsigned int buffer_id, unsigned int rx_thread)
+{
+  Entry* buffer_entry = this->entry(buffer_id);
+  while (buffer_entry &&
+         !this->transition(buffer_entry, this->load_control(buffer_entry), StateFree, any_frame,
+                           rx_thread, true));
+}
+
+//! Mark a buffer as receiving frame data.
+//!
+//! \param[in] buffer_id - buffer ID
+//!
+void SharedBufferStates::set_receiving(unsigned int buffer_id)
+{
+  Entry* buffer_entry = this->entry(buffer_id);
+  while (buffer_entry &&
+         !this->transition(buffer_entry, this->load_control(buffer_entry), StateReceiving,
+                           any_frame, no_rx_thread, true));
+}
+
+//! Mark a buffer as ready for processing.
+//!
+//! This method is called by the frame receiver before notifying the frame processor that a frame
+//! is ready, so that the frame processor always finds the buffer ready.
+//!
+//! \param[in] buffer_id - buffer ID
+//! \param[in] frame - frame number contained in the buffer
+//!
+void SharedBufferStates::set_ready(unsigned int buffer_id, uint64_t frame)
+{
+  Entry* buffer_entry = this->entry(buffer_id);
+  while (buffer_entry &&
+         !this->transition(buffer_entry, this->load_control(buffer_entry), StateReady, frame,
+                           no_rx_thread, true));
+}
+
+//! Acquire a ready buffer for processing.
+//!
+//! This method is called by the frame processor when it takes a buffer notified ready, marking
+//! it as held by the calling process. This is refused if the buffer is no longer ready with the
+//! notified frame, e.g. because it has been reclaimed by the frame receiver.
+//!
+//! \param[in] buffer_id - buffer ID
+//! \param[in] frame - frame number notified ready in the buffer
+//! \return true if the buffer was acquired
+//!
+bool SharedBufferStates::acquire(unsigned int buffer_id, uint64_t frame)
+{
+  Entry* buffer_entry = this->entry(buffer_id);
+  if (!buffer_entry)
+  {
+    return false;
+  }
+  uint64_t control = this->load_control(buffer_entry);
+  if (((control & state_mask) != StateReady) ||
+      (__atomic_load_n(&buffer_entry->frame, __ATOMIC_RELAXED) != frame))
+  {
+    return false;
+  }
+  return this->transition(buffer_entry, control, StateHeld, any_frame, no_rx_thread);
+}
+
+//! Release a ready or held buffer.
+//!
+//! This method is called by the frame receiver when a buffer is released by the frame processor,
+//! marking it free for reuse. This is refused if the buffer is not ready or held with the
+//! released frame, e.g. for a late release of a buffer that has already been reclaimed, or if
+//! the entry has been left busy, in which case the buffer is left to be reclaimed.
+//!
+//! \param[in] buffer_id - buffer ID
+//! \param[in] frame - frame number released, or any_frame if not known
+//! \return true if the buffer was released
+//!
+bool SharedBufferStates::release(unsigned int buffer_id, uint64_t frame)
+{
+  Entry* buffer_entry = this->entry(buffer_id);
+  if (!buffer_entry)
+  {
+    return false;
+  }
+  while (true)
+  {
+    uint64_t control = this->load_control(buffer_entry);
+    uint64_t state = control & state_mask;
+    if ((control & busy) || ((state != StateReady) && (state != StateHeld)) ||
+        ((frame != any_frame) && (__atomic_load_n(&buffer_entry->frame, __ATOMIC_RELAXED) != frame)))
+    {
+      return false;
+    }
+    if (this->transition(buffer_entry, control, StateFree, any_frame, no_rx_thread))
+    {
+      return true;
+    }
+  }
+}
+
+//! Reclaim a buffer.
+//!
+//! This method is called by the frame receiver to mark a buffer free that has been ready or held
+//! for too long, is held by a process that no longer exists, or has been left busy by a process
+//! that did not complete a transition. The buffer is only reclaimed if its entry has not changed
+//! since the snapshot on which that decision was made.
+//!
+//! \param[in] buffer_id - buffer ID
+//! \param[in] observed - snapshot of the buffer entry, from get_entry()
+//! \return true if the buffer was reclaimed
+//!
+bool SharedBufferStates::reclaim(unsigned int buffer_id, const Entry& observed)
+{
+  Entry* buffer_entry = this->entry(buffer_id);
+  if (!buffer_entry)
+  {
+    return false;
+  }
+  return this->transition(buffer_entry, observed.control, StateFree, any_frame, no_rx_thread, true);
+}
+
+//! Return the entry of a buffer.
+//!
+//! \param[in] buffer_id - buffer ID
+//! \return pointer to the entry, or NULL if the buffer ID is out of range
+//!
+SharedBufferStates::Entry* SharedBufferStates::entry(unsigned int buffer_id) const
+{
+  return (buffer_id < header_->num_buffers) ? &entries_[buffer_id] : NULL;
+}
+
+//! Load the control word of an entry, waiting for any update in progress to complete.
+//!
+//! The wait is bounded, so that an entry left busy by a process that exited part way through a
+//! transition is returned with the busy flag still set rather than waited on forever.
+//!
+//! \param[in] entry - buffer entry
+//! \return control word
+//!
+uint64_t SharedBufferStates::load_control(const Entry* entry) const
+{
+  uint64_t control;
+  uint64_t deadline_ns = 0;
+  unsigned int spins = 0;
+  while ((control = __atomic_load_n(&entry->control, __ATOMIC_ACQUIRE)) & busy)
+  {
+    // Only check the time every so often, as an update in progress normally completes at once
+    if ((++spins & 0x3FF) == 0)
+    {
+      uint64_t now_ns = FrameNotification::now_ns();
+      if (deadline_ns == 0)
+      {
+        deadline_ns = now_ns + busy_timeout_ns;
+      }
+      else if (now_ns > deadline_ns)
+      {
+        break;
+      }
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+  }
+  return control;
+}
+
+//! Transition an entry to a new state.
+//!
+//! The control word is swapped from the value expected to one with the busy flag set, which
+//! fails if any other transition has been made since the expected value was read. The remaining
+//! fields are then updated, before publishing the new state with an advanced sequence number.
+//! An expected value with the busy flag set, left by a transition that did not complete, is
+//! refused unless the caller takes over the entry.
+//!
+//! \param[in] entry - buffer entry
+//! \param[in] expected_control - control word the entry is expected to have
+//! \param[in] state - new state
+//! \param[in] frame - new frame number, or any_frame to leave unchanged
+//! \param[in] rx_thread - new RX thread index, or no_rx_thread to leave unchanged
+//! \param[in] take_over - make the transition even if the entry was left busy
+//! \return true if the transition was made
+//!
+bool SharedBufferStates::transition(Entry* entry, uint64_t expected_control, State state,
+    uint64_t frame, uint32_t rx_thread, bool take_over)
+{
+  if ((expected_control & busy) && !take_over)
+  {
+    return false;
+  }
+  if (!__atomic_compare_exchange_n(&entry->control, &expected_control, expected_control | busy,
+                                   false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+  {
+    return false;
+  }
+  if (frame != any_frame)
+  {
+    __atomic_store_n(&entry->frame, frame, __ATOMIC_RELAXED);
+  }
+  if (rx_thread != no_rx_thread)
+  {
+    __atomic_store_n(&entry->rx_thread, rx_thread, __ATOMIC_RELAXED);
+  }
+  __atomic_store_n(&entry->owner_pid, pid_, __ATOMIC_RELAXED);
+  __atomic_store_n(&entry->state_time_ns, FrameNotification::now_ns(), __ATOMIC_RELAXED);
+
+  uint64_t sequence = (expected_control >> seq_shift) + 1;
+  __atomic_store_n(&entry->control, (sequence << seq_shift) | state, __ATOMIC_RELEASE);
+  return true;
+}
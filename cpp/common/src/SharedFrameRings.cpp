@@ -0,0 +1,356 @@
+/*!
+ * SharedFrameRings.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <cstring>
+#include <cerrno>
+#include <sstream>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#include "SharedFrameRings.h"
+
+using namespace OdinData;
+
+//! Size of a cache line, to which the header and ring indices are aligned
+static const size_t cache_line_size = 64;
+
+//! Constructor for the SharedFrameRings class formatting a new set of rings.
+//!
+//! This constructor formats a region of shared memory as a set of empty ready and release ring
+//! pairs. The region must be cache line aligned and at least the size given by region_size().
+//!
+//! \param[in] region - start of the shared region
+//! \param[in] region_size - size of the shared region
+//! \param[in] num_rings - number of ready and release ring pairs
+//! \param[in] capacity - number of descriptors in each ring, rounded up to a power of two
+//!
+SharedFrameRings::SharedFrameRings(void* region, size_t region_size, unsigned int num_rings,
+    unsigned int capacity) :
+    region_(static_cast<char*>(region)),
+    header_(static_cast<Header*>(region))
+{
+  capacity = capacity_for(capacity);
+  if (region_size < SharedFrameRings::region_size(num_rings, capacity))
+  {
+    std::stringstream ss;
+    ss << "Shared region of " << region_size << " bytes too small for " << num_rings
+       << " frame rings of " << capacity << " descriptors";
+    throw SharedFrameRingsException(ss.str());
+  }
+
+  memset(region_, 0, SharedFrameRings::region_size(num_rings, capacity));
+  header_->version = version;
+  header_->num_rings = num_rings;
+  header_->capacity = capacity;
+
+  // Publish the magic number last so that a process attaching concurrently sees complete rings
+  __atomic_store_n(&header_->magic, magic, __ATOMIC_RELEASE);
+
+  this->map_rings();
+}
+
+//! Constructor for the SharedFrameRings class attaching to an existing set of rings.
+//!
+//! This constructor attaches to a set of rings previously formatted in a region of shared memory
+//! by another process. An exception is thrown if no rings are present in the region.
+//!
+//! \param[in] region - start of the shared region
+//! \param[in] region_size - size of the shared region
+//!
+SharedFrameRings::SharedFrameRings(void* region, size_t region_size) :
+    region_(static_cast<char*>(region)),
+    header_(static_cast<Header*>(region))
+{
+  if (!is_present(region, region_size))
+  {
+    throw SharedFrameRingsException("No frame rings present in shared region");
+  }
+  this->map_rings();
+}
+
+//! Return the size of a shared region hosting a set of rings.
+//!
+//! \param[in] num_rings - number of ready and release ring pairs
+//! \param[in] capacity - number of descriptors in each ring
+//! \return size of the region in bytes
+//!
+size_t SharedFrameRings::region_size(unsigned int num_rings, unsigned int capacity)
+{
+  return sizeof(Header) + (2 * num_rings * ring_stride(capacity_for(capacity)));
+}
+
+//! Return the ring capacity required to hold a descriptor for each of a number of buffers.
+//!
+//! As each frame buffer can only have one notification in flight at any time, rings holding a
+//! descriptor for every buffer can never overflow.
+//!
+//! \param[in] num_buffers - number of frame buffers
+//! \return ring capacity, the smallest power of two not less than the number of buffers
+//!
+unsigned int SharedFrameRings::capacity_for(size_t num_buffers)
+{
+  unsigned int capacity = 1;
+  while (capacity < num_buffers)
+  {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+//! Determine if a set of rings is present in a shared region.
+//!
+//! \param[in] region - start of the shared region
+//! \param[in] region_size - size of the shared region
+//! \return true if formatted rings of a supported version are present
+//!
+bool SharedFrameRings::is_present(const void* region, size_t region_size)
+{
+  const Header* header = static_cast<const Header*>(region);
+  if (region_size < sizeof(Header))
+  {
+    return false;
+  }
+  if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != magic)
+  {
+    return false;
+  }
+  return ((header->version == version) &&
+          (header->capacity == capacity_for(header->capacity)) &&
+          (region_size >= SharedFrameRings::region_size(header->num_rings, header->capacity)));
+}
+
+//! Return the number of ready and release ring pairs.
+//!
+//! \return number of ring pairs
+//!
+unsigned int SharedFrameRings::get_num_rings(void) const
+{
+  return header_->num_rings;
+}
+
+//! Return the number of descriptors in each ring.
+//!
+//! \return ring capacity
+//!
+unsigned int SharedFrameRings::get_capacity(void) const
+{
+  return header_->capacity;
+}
+
+//! Push a frame ready notification onto a ready ring.
+//!
+//! This method must only be called by the single producer of the ring, i.e. the RX thread with
+//! the ring index. The consumer is woken if it is waiting for notifications.
+//!
+//! \param[in] ring - ring index
+//! \param[in] notification - frame ready notification
+//! \return true if the notification was pushed, false if the ring is full
+//!
+bool SharedFrameRings::push_ready(unsigned int ring, const FrameNotification& notification)
+{
+  if (!this->push(2 * ring, notification))
+  {
+    return false;
+  }
+  this->wake_ready();
+  return true;
+}
+
+//! Pop a frame ready notification from a ready ring.
+//!
+//! \param[in] ring - ring index
+//! \param[out] notification - frame ready notification
+//! \return true if a notification was popped, false if the ring is empty
+//!
+bool SharedFrameRings::pop_ready(unsigned int ring, FrameNotification& notification)
+{
+  return this->pop(2 * ring, notification);
+}
+
+//! Push a frame release notification onto a release ring.
+//!
+//! This method may be called by any thread in the producing process, as producers are serialised
+//! on a process-local mutex.
+//!
+//! \param[in] ring - ring index
+//! \param[in] notification - frame release notification
+//! \return true if the notification was pushed, false if the ring is full
+//!
+bool SharedFrameRings::push_release(unsigned int ring, const FrameNotification& notification)
+{
+  boost::mutex::scoped_lock lock(release_mutex_);
+  return this->push((2 * ring) + 1, notification);
+}
+
+//! Pop a frame release notification from a release ring.
+//!
+//! \param[in] ring - ring index
+//! \param[out] notification - frame release notification
+//! \return true if a notification was popped, false if the ring is empty
+//!
+bool SharedFrameRings::pop_release(unsigned int ring, FrameNotification& notification)
+{
+  return this->pop((2 * ring) + 1, notification);
+}
+
+//! Wait for frame ready notifications.
+//!
+//! This method blocks the consumer of the ready rings until any ready ring is non-empty or the
+//! timeout expires. The consumer flags that it is waiting before checking the rings, so that a
+//! producer pushing concurrently either is seen by the check or sees the flag and wakes it. On
+//! platforms without futexes the rings are instead polled at a fixed interval.
+//!
+//! \param[in] timeout_ms - maximum time to wait in milliseconds
+//! \return true if any ready ring is non-empty
+//!
+bool SharedFrameRings::wait_ready(unsigned int timeout_ms)
+{
+  __atomic_store_n(&header_->ready_waiters, 1, __ATOMIC_SEQ_CST);
+  uint32_t seq = __atomic_load_n(&header_->ready_seq, __ATOMIC_SEQ_CST);
+
+  bool ready = this->any_ready();
+#ifdef __linux__
+  if (!ready)
+  {
+    struct timespec timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000000;
+    syscall(SYS_futex, &header_->ready_seq, FUTEX_WAIT, seq, &timeout, NULL, 0);
+    ready = this->any_ready();
+  }
+#else
+  for (unsigned int waited_ms = 0; !ready && (waited_ms < timeout_ms); waited_ms++)
+  {
+    if (__atomic_load_n(&header_->ready_seq, __ATOMIC_SEQ_CST) == seq)
+    {
+      usleep(1000);
+    }
+    ready = this->any_ready();
+  }
+#endif
+
+  __atomic_store_n(&header_->ready_waiters, 0, __ATOMIC_SEQ_CST);
+  return ready;
+}
+
+//! Interrupt the consumer of the ready rings waiting for notifications.
+//!
+//! This method wakes the consumer if it is blocked in wait_ready(), without pushing a
+//! notification, so that it can act on a request made of it by another thread in its process.
+//! A request made just before the consumer flags that it is waiting may not wake it, in which
+//! case the request is seen when the wait times out.
+//!
+void SharedFrameRings::interrupt_wait(void)
+{
+  this->wake_ready();
+}
+
+//! Return the size of each ring in the shared region.
+//!
+//! \param[in] capacity - number of descriptors in each ring
+//! \return size of a ring rounded up to a whole number of cache lines
+//!
+size_t SharedFrameRings::ring_stride(unsigned int capacity)
+{
+  size_t stride = sizeof(RingIndex) + (capacity * sizeof(Descriptor));
+  return ((stride + cache_line_size - 1) / cache_line_size) * cache_line_size;
+}
+
+//! Map the rings in the shared region.
+//!
+void SharedFrameRings::map_rings(void)
+{
+  stride_ = ring_stride(header_->capacity);
+}
+
+//! Push a descriptor onto a ring.
+//!
+//! The descriptor is written before the tail is advanced with release ordering, so that the
+//! consumer never sees an incomplete descriptor.
+//!
+//! \param[in] ring - index of the ring in the region
+//! \param[in] notification - notification to push
+//! \return true if the notification was pushed, false if the ring is full
+//!
+bool SharedFrameRings::push(unsigned int ring, const FrameNotification& notification)
+{
+  RingIndex* index = reinterpret_cast<RingIndex*>(region_ + sizeof(Header) + (ring * stride_));
+  Descriptor* entries = reinterpret_cast<Descriptor*>(index + 1);
+
+  uint64_t tail = index->tail;
+  uint64_t head = __atomic_load_n(&index->head, __ATOMIC_ACQUIRE);
+  if ((tail - head) >= header_->capacity)
+  {
+    return false;
+  }
+
+  entries[tail & (header_->capacity - 1)] = notification.get_layout();
+  __atomic_store_n(&index->tail, tail + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+//! Pop a descriptor from a ring.
+//!
+//! \param[in] ring - index of the ring in the region
+//! \param[out] notification - notification popped
+//! \return true if a notification was popped, false if the ring is empty
+//!
+bool SharedFrameRings::pop(unsigned int ring, FrameNotification& notification)
+{
+  RingIndex* index = reinterpret_cast<RingIndex*>(region_ + sizeof(Header) + (ring * stride_));
+  Descriptor* entries = reinterpret_cast<Descriptor*>(index + 1);
+
+  uint64_t head = index->head;
+  uint64_t tail = __atomic_load_n(&index->tail, __ATOMIC_ACQUIRE);
+  if (head == tail)
+  {
+    return false;
+  }
+
+  notification = FrameNotification(entries[head & (header_->capacity - 1)]);
+  __atomic_store_n(&index->head, head + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+//! Determine if any ready ring is non-empty.
+//!
+//! \return true if any ready ring is non-empty
+//!
+bool SharedFrameRings::any_ready(void)
+{
+  for (unsigned int ring = 0; ring < header_->num_rings; ring++)
+  {
+    RingIndex* index = reinterpret_cast<RingIndex*>(region_ + sizeof(Header) + (2 * ring * stride_));
+    if (__atomic_load_n(&index->tail, __ATOMIC_ACQUIRE) !=
+        __atomic_load_n(&index->head, __ATOMIC_RELAXED))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//! Wake the consumer of the ready rings if it is waiting.
+//!
+//! The full fence orders the preceding tail update before the check of the waiting flag,
+//! pairing with the consumer setting the flag before checking the rings in wait_ready().
+//!
+void SharedFrameRings::wake_ready(void)
+{
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&header_->ready_waiters, __ATOMIC_SEQ_CST))
+  {
+    __atomic_add_fetch(&header_->ready_seq, 1, __ATOMIC_SEQ_CST);
+#ifdef __linux__
+    syscall(SYS_futex, &header_->ready_seq, FUTEX_WAKE, 1, NULL, NULL, 0);
+#endif
+  }
+}
@@ -0,0 +1,639 @@
+/*!
+ * ThreadPlacement.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <sstream>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <sched.h>
+#include <unistd.h>
+#include <dirent.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#endif
+
+#include "ThreadPlacement.h"
+
+using namespace OdinData;
+
+//! Prefix of the names given to ZeroMQ IO threads by libzmq
+static const std::string zmq_io_thread_comm = "ZMQbg/IO";
+
+//! Number of CPUs that can be given in a CPU list
+#ifdef __linux__
+static const long max_cpus = CPU_SETSIZE;
+#else
+static const long max_cpus = 1024;
+#endif
+
+//! Retrieve the single ThreadPlacement instance.
+//!
+//! This static method retrieves the singleton ThreadPlacement instance used by all threads in
+//! an application.
+//!
+ThreadPlacement& ThreadPlacement::Instance(void)
+{
+  static ThreadPlacement thread_placement;
+
+  return thread_placement;
+}
+
+//! Constructor for the ThreadPlacement class
+//!
+//! This private constructor initialises the ThreadPlacement instance. It should not be called
+//! directly, rather via the Instance() singleton static method.
+//!
+ThreadPlacement::ThreadPlacement()
+{
+}
+
+//! Configure thread placement specifications.
+//!
+//! This method parses thread placement specifications from the configuration message, which
+//! contains one object per thread name, each with optional "cpus", "priority", "numa_node" and
+//! "numa_policy" parameters. All specifications are validated before any are stored, so an
+//! invalid configuration leaves the existing placement unchanged. The new placement is then
+//! re-applied to all registered threads. Thread placement is only supported on Linux, so any
+//! specification is rejected on other platforms.
+//!
+//! \param[in] config - IpcMessage containing placement specifications indexed by thread name
+//!
+void ThreadPlacement::configure(const IpcMessage& config)
+{
+  std::map<std::string, Spec> specs;
+  std::vector<std::string> names = config.get_param_names();
+#ifndef __linux__
+  if (!names.empty())
+  {
+    throw ThreadPlacementException("Thread placement is only supported on Linux");
+  }
+#endif
+  for (std::vector<std::string>::iterator name = names.begin(); name != names.end(); ++name)
+  {
+    try
+    {
+      const rapidjson::Value& spec_value = config.get_param<const rapidjson::Value&>(*name);
+      if (!spec_value.IsObject())
+      {
+        throw ThreadPlacementException("Placement specification for thread " + *name + " must be an object");
+      }
+      IpcMessage spec_config(spec_value);
+      specs[*name] = parse_spec(*name, spec_config);
+    }
+    catch (IpcMessageException& e)
+    {
+      std::stringstream sstr;
+      sstr << "Invalid placement specification for thread " << *name << ": " << e.what();
+      throw ThreadPlacementException(sstr.str());
+    }
+  }
+
+  boost::lock_guard<boost::mutex> lock(mutex_);
+
+  for (std::map<std::string, Spec>::iterator spec = specs.begin(); spec != specs.end(); ++spec)
+  {
+    specs_[spec->first] = spec->second;
+  }
+
+  prune();
+  pid_t calling_tid = gettid();
+  for (std::map<std::string, Entry>::iterator entry = threads_.begin(); entry != threads_.end(); ++entry)
+  {
+    apply(entry->first, entry->second, entry->second.tid == calling_tid);
+  }
+}
+
+//! Clear all thread placement specifications.
+//!
+//! This method clears all placement specifications. Placement already applied to running
+//! threads is not reverted.
+//!
+void ThreadPlacement::clear(void)
+{
+  boost::lock_guard<boost::mutex> lock(mutex_);
+  specs_.clear();
+}
+
+//! Register the calling thread.
+//!
+//! This method registers the calling thread under the specified name and applies any matching
+//! placement specification to it. If a thread is already registered under that name, a numeric
+//! suffix is appended to make the name unique. The returned name should be passed to
+//! unregister_thread() when the thread exits.
+//!
+//! \param[in] name - name of the thread
+//! \return unique name the thread is registered under
+//!
+std::string ThreadPlacement::register_thread(const std::string& name)
+{
+  boost::lock_guard<boost::mutex> lock(mutex_);
+
+  prune();
+
+  std::string unique_name = name;
+  for (unsigned int suffix = 1; threads_.count(unique_name); suffix++)
+  {
+    std::stringstream sstr;
+    sstr << name << "_" << suffix;
+    unique_name = sstr.str();
+  }
+
+  Entry& entry = threads_[unique_name];
+  entry.tid = gettid();
+  entry.external = false;
+  entry.numa_node = -1;
+  apply(unique_name, entry, true);
+
+  return unique_name;
+}
+
+//! Unregister a thread.
+//!
+//! This method removes the named thread from the registry, typically called by the thread
+//! itself as it exits.
+//!
+//! \param[in] name - unique name returned by register_thread()
+//!
+void ThreadPlacement::unregister_thread(const std::string& name)
+{
+  boost::lock_guard<boost::mutex> lock(mutex_);
+  threads_.erase(name);
+}
+
+//! Register the ZeroMQ IO threads of the process.
+//!
+//! This method scans the threads of the process for the IO threads created by the ZeroMQ
+//! context and registers each not already known as "zmq_io_<n>", applying any matching
+//! placement. Since these threads are not under the control of odin-data, only CPU affinity and
+//! scheduling can be applied to them; a memory policy can only be set by the thread itself.
+//!
+void ThreadPlacement::register_zmq_io_threads(void)
+{
+  boost::lock_guard<boost::mutex> lock(mutex_);
+
+  prune();
+
+  DIR* task_dir = opendir("/proc/self/task");
+  if (!task_dir)
+  {
+    return;
+  }
+
+  std::vector<pid_t> io_tids;
+  struct dirent* task;
+  while ((task = readdir(task_dir)) != NULL)
+  {
+    if (task->d_name[0] == '.')
+    {
+      continue;
+    }
+    std::ifstream comm_file((std::string("/proc/self/task/") + task->d_name + "/comm").c_str());
+    std::string comm;
+    std::getline(comm_file, comm);
+    if (comm.compare(0, zmq_io_thread_comm.size(), zmq_io_thread_comm) == 0)
+    {
+      io_tids.push_back(static_cast<pid_t>(atoi(task->d_name)));
+    }
+  }
+  closedir(task_dir);
+  std::sort(io_tids.begin(), io_tids.end());
+
+  for (std::vector<pid_t>::iterator tid = io_tids.begin(); tid != io_tids.end(); ++tid)
+  {
+    bool known = false;
+    for (std::map<std::string, Entry>::iterator entry = threads_.begin(); entry != threads_.end(); ++entry)
+    {
+      known |= (entry->second.tid == *tid);
+    }
+    if (known)
+    {
+      continue;
+    }
+
+    std::string name;
+    for (unsigned int idx = 0; name.empty() || threads_.count(name); idx++)
+    {
+      std::stringstream sstr;
+      sstr << "zmq_io_" << idx;
+      name = sstr.str();
+    }
+
+    Entry& entry = threads_[name];
+    entry.tid = *tid;
+    entry.external = true;
+    entry.numa_node = -1;
+    apply(name, entry, false);
+  }
+}
+
+//! Report the thread placement configuration.
+//!
+//! This method adds the configured placement specifications to a configuration reply message.
+//!
+//! \param[in] prefix - parameter path prefix for the specifications
+//! \param[in,out] reply - reply message to populate
+//!
+void ThreadPlacement::configuration(const std::string& prefix, IpcMessage& reply)
+{
+  boost::lock_guard<boost::mutex> lock(mutex_);
+
+  for (std::map<std::string, Spec>::iterator spec = specs_.begin(); spec != specs_.end(); ++spec)
+  {
+    std::string path = prefix + spec->first + "/";
+    reply.set_param(path + "cpus", format_cpu_list(spec->second.cpus));
+    reply.set_param(path + "priority", spec->second.priority);
+    reply.set_param(path + "numa_node", spec->second.numa_node);
+    reply.set_param(path + "numa_policy", std::string(spec->second.numa_bind ? "bind" : "preferred"));
+  }
+}
+
+//! Report the placement applied to registered threads.
+//!
+//! This method reads back the CPU affinity and scheduling of each registered thread from the
+//! kernel, along with the NUMA node of its memory policy and any error encountered applying its
+//! placement, and adds them to a status message.
+//!
+//! \param[in] prefix - parameter path prefix for the thread status
+//! \param[in,out] status - status message to populate
+//!
+void ThreadPlacement::status(const std::string& prefix, IpcMessage& status)
+{
+  boost::lock_guard<boost::mutex> lock(mutex_);
+
+  prune();
+
+  for (std::map<std::string, Entry>::iterator entry = threads_.begin(); entry != threads_.end(); ++entry)
+  {
+    std::string path = prefix + entry->first + "/";
+    status.set_param(path + "tid", static_cast<int>(entry->second.tid));
+
+#ifdef __linux__
+    std::vector<int> cpus;
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (sched_getaffinity(entry->second.tid, sizeof(cpu_set), &cpu_set) == 0)
+    {
+      for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+      {
+        if (CPU_ISSET(cpu, &cpu_set))
+        {
+          cpus.push_back(cpu);
+        }
+      }
+    }
+    status.set_param(path + "cpus", format_cpu_list(cpus));
+
+    int policy = sched_getscheduler(entry->second.tid);
+    struct sched_param param;
+    param.sched_priority = 0;
+    sched_getparam(entry->second.tid, &param);
+    status.set_param(path + "policy",
+        std::string(policy == SCHED_FIFO ? "fifo" : (policy == SCHED_RR ? "rr" : "other")));
+    status.set_param(path + "priority", param.sched_priority);
+#endif
+    status.set_param(path + "numa_node", entry->second.numa_node);
+    status.set_param(path + "error", entry->second.error);
+  }
+}
+
+//! Parse a CPU list.
+//!
+//! This static method parses a CPU list in the format used by the kernel, e.g. "0-3,8,10-11",
+//! into a sorted list of CPU numbers.
+//!
+//! \param[in] cpu_list - CPU list string
+//! \return vector of CPU numbers
+//!
+std::vector<int> ThreadPlacement::parse_cpu_list(const std::string& cpu_list)
+{
+  std::vector<int> cpus;
+  std::stringstream list_stream(cpu_list);
+  std::string range;
+
+  while (std::getline(list_stream, range, ','))
+  {
+    range.erase(std::remove(range.begin(), range.end(), ' '), range.end());
+    range.erase(std::remove(range.begin(), range.end(), '\n'), range.end());
+    if (range.empty())
+    {
+      continue;
+    }
+
+    char* end;
+    long first = strtol(range.c_str(), &end, 10);
+    long last = first;
+    if (*end == '-')
+    {
+      last = strtol(end + 1, &end, 10);
+    }
+    if (*end != '\0' || end == range.c_str() || first < 0 || last < first || last >= max_cpus)
+    {
+      std::stringstream sstr;
+      sstr << "Invalid CPU range \"" << range << "\" in CPU list \"" << cpu_list << "\"";
+      throw ThreadPlacementException(sstr.str());
+    }
+
+    for (long cpu = first; cpu <= last; cpu++)
+    {
+      cpus.push_back(static_cast<int>(cpu));
+    }
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+  return cpus;
+}
+
+//! Format a CPU list.
+//!
+//! This static method formats a sorted list of CPU numbers in the compact range format used by
+//! the kernel, e.g. "0-3,8".
+//!
+//! \param[in] cpus - sorted vector of CPU numbers
+//! \return CPU list string
+//!
+std::string ThreadPlacement::format_cpu_list(const std::vector<int>& cpus)
+{
+  std::stringstream sstr;
+  size_t idx = 0;
+  while (idx < cpus.size())
+  {
+    size_t last = idx;
+    while ((last + 1 < cpus.size()) && (cpus[last + 1] == cpus[last] + 1))
+    {
+      last++;
+    }
+    if (idx)
+    {
+      sstr << ",";
+    }
+    sstr << cpus[idx];
+    if (last != idx)
+    {
+      sstr << "-" << cpus[last];
+    }
+    idx = last + 1;
+  }
+  return sstr.str();
+}
+
+//! Parse a placement specification.
+//!
+//! This method parses and validates the placement specification for a named thread. CPUs may be
+//! given as a kernel-style list string or an array of CPU numbers. If a NUMA node is given but
+//! no CPUs, the thread is confined to the CPUs of that node.
+//!
+//! \param[in] name - name of the thread the specification applies to
+//! \param[in] spec_config - IpcMessage containing the specification parameters
+//! \return parsed specification
+//!
+ThreadPlacement::Spec ThreadPlacement::parse_spec(const std::string& name, const IpcMessage& spec_config)
+{
+  Spec spec;
+  spec.has_priority = false;
+  spec.priority = 0;
+  spec.numa_node = -1;
+  spec.numa_bind = false;
+
+  if (spec_config.has_param("cpus"))
+  {
+    const rapidjson::Value& cpus = spec_config.get_param<const rapidjson::Value&>("cpus");
+    if (cpus.IsString())
+    {
+      spec.cpus = parse_cpu_list(cpus.GetString());
+    }
+    else if (cpus.IsArray())
+    {
+      std::stringstream sstr;
+      for (rapidjson::SizeType idx = 0; idx < cpus.Size(); idx++)
+      {
+        if (!cpus[idx].IsInt())
+        {
+          throw ThreadPlacementException("CPUs for thread " + name + " must be integers");
+        }
+        sstr << (idx ? "," : "") << cpus[idx].GetInt();
+      }
+      spec.cpus = parse_cpu_list(sstr.str());
+    }
+    else
+    {
+      throw ThreadPlacementException("CPUs for thread " + name + " must be a list string or array");
+    }
+  }
+
+  if (spec_config.has_param("priority"))
+  {
+    spec.has_priority = true;
+    spec.priority = spec_config.get_param<int>("priority");
+    if (spec.priority != 0 && (spec.priority < sched_get_priority_min(SCHED_FIFO) ||
+        spec.priority > sched_get_priority_max(SCHED_FIFO)))
+    {
+      std::stringstream sstr;
+      sstr << "Invalid priority " << spec.priority << " for thread " << name
+           << ", must be 0 or in range " << sched_get_priority_min(SCHED_FIFO)
+           << "-" << sched_get_priority_max(SCHED_FIFO);
+      throw ThreadPlacementException(sstr.str());
+    }
+  }
+
+  if (spec_config.has_param("numa_node"))
+  {
+    spec.numa_node = spec_config.get_param<int>("numa_node");
+    if (spec.numa_node >= 0 && spec.cpus.empty())
+    {
+      spec.cpus = numa_node_cpus(spec.numa_node);
+      if (spec.cpus.empty())
+      {
+        std::stringstream sstr;
+        sstr << "NUMA node " << spec.numa_node << " for thread " << name << " has no CPUs";
+        throw ThreadPlacementException(sstr.str());
+      }
+    }
+  }
+
+  if (spec_config.has_param("numa_policy"))
+  {
+    std::string numa_policy = spec_config.get_param<std::string>("numa_policy");
+    if (numa_policy == "bind")
+    {
+      spec.numa_bind = true;
+    }
+    else if (numa_policy != "preferred")
+    {
+      throw ThreadPlacementException(
+          "Invalid NUMA policy " + numa_policy + " for thread " + name + ", must be preferred or bind");
+    }
+  }
+
+  return spec;
+}
+
+//! Find the placement specification for a named thread.
+//!
+//! This method searches for a specification matching the thread name, then successively
+//! strips trailing underscore-separated segments from the name until a match is found.
+//!
+//! \param[in] name - name of the thread
+//! \param[out] spec - matching specification
+//! \return true if a matching specification was found
+//!
+bool ThreadPlacement::find_spec(const std::string& name, Spec& spec) const
+{
+  std::string match_name = name;
+  while (!match_name.empty())
+  {
+    std::map<std::string, Spec>::const_iterator itr = specs_.find(match_name);
+    if (itr != specs_.end())
+    {
+      spec = itr->second;
+      return true;
+    }
+    size_t sep = match_name.rfind('_');
+    if (sep == std::string::npos)
+    {
+      break;
+    }
+    match_name.erase(sep);
+  }
+  return false;
+}
+
+//! Apply placement to a registered thread.
+//!
+//! This method applies the CPU affinity and scheduling of any matching specification to a
+//! registered thread. The scheduling policy is only changed if the specification gives a
+//! priority, so that a thread keeps any policy it already has otherwise. The NUMA memory policy is only applied if the thread is the calling
+//! thread, since the kernel only allows a thread to set its own policy. Any error is recorded
+//! in the thread entry for reporting in status rather than raised, so that insufficient
+//! privileges, e.g. for real-time scheduling, do not prevent the thread from running.
+//!
+//! \param[in] name - unique name of the thread
+//! \param[in,out] entry - registry entry of the thread
+//! \param[in] calling_thread - true if the thread is the calling thread
+//!
+void ThreadPlacement::apply(const std::string& name, Entry& entry, bool calling_thread)
+{
+#ifdef __linux__
+  Spec spec;
+  if (!find_spec(name, spec))
+  {
+    return;
+  }
+
+  std::stringstream errors;
+
+  if (!spec.cpus.empty())
+  {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (std::vector<int>::iterator cpu = spec.cpus.begin(); cpu != spec.cpus.end(); ++cpu)
+    {
+      CPU_SET(*cpu, &cpu_set);
+    }
+    if (sched_setaffinity(entry.tid, sizeof(cpu_set), &cpu_set) != 0)
+    {
+      errors << "affinity " << format_cpu_list(spec.cpus) << ": " << strerror(errno) << "; ";
+    }
+  }
+
+  if (spec.has_priority)
+  {
+    struct sched_param param;
+    param.sched_priority = spec.priority;
+    if (sched_setscheduler(entry.tid, spec.priority ? SCHED_FIFO : SCHED_OTHER, &param) != 0)
+    {
+      errors << "priority " << spec.priority << ": " << strerror(errno) << "; ";
+    }
+  }
+
+  if (spec.numa_node >= 0 && calling_thread && !entry.external)
+  {
+    unsigned long node_mask[16];
+    const unsigned long max_node = sizeof(node_mask) * 8;
+    memset(node_mask, 0, sizeof(node_mask));
+    if (static_cast<unsigned long>(spec.numa_node) < max_node)
+    {
+      node_mask[spec.numa_node / (sizeof(unsigned long) * 8)] |=
+          1UL << (spec.numa_node % (sizeof(unsigned long) * 8));
+    }
+    int mode = spec.numa_bind ? MPOL_BIND : MPOL_PREFERRED;
+    if (syscall(SYS_set_mempolicy, mode, node_mask, max_node) == 0)
+    {
+      entry.numa_node = spec.numa_node;
+    }
+    else
+    {
+      errors << "numa_node " << spec.numa_node << ": " << strerror(errno) << "; ";
+    }
+  }
+
+  entry.error = errors.str();
+  if (!entry.error.empty())
+  {
+    entry.error.erase(entry.error.size() - 2);
+  }
+#endif
+}
+
+//! Remove registry entries for threads that have exited.
+//!
+//! Threads should unregister themselves on exit, but external threads cannot, so entries for
+//! which no task exists in the process any longer are pruned. The caller must hold the mutex.
+//!
+void ThreadPlacement::prune(void)
+{
+#ifdef __linux__
+  std::map<std::string, Entry>::iterator entry = threads_.begin();
+  while (entry != threads_.end())
+  {
+    std::stringstream task_path;
+    task_path << "/proc/self/task/" << entry->second.tid;
+    if (access(task_path.str().c_str(), F_OK) != 0)
+    {
+      threads_.erase(entry++);
+    }
+    else
+    {
+      ++entry;
+    }
+  }
+#endif
+}
+
+//! Get the kernel thread ID of the calling thread.
+//!
+//! \return kernel thread ID, or zero where not supported
+//!
+pid_t ThreadPlacement::gettid(void)
+{
+#ifdef __linux__
+  return static_cast<pid_t>(syscall(SYS_gettid));
+#else
+  return 0;
+#endif
+}
+
+//! Get the CPUs of a NUMA node.
+//!
+//! This static method reads the list of CPUs belonging to a NUMA node from sysfs.
+//!
+//! \param[in] numa_node - NUMA node number
+//! \return vector of CPU numbers, empty if the node does not exist
+//!
+std::vector<int> ThreadPlacement::numa_node_cpus(int numa_node)
+{
+  std::stringstream cpulist_path;
+  cpulist_path << "/sys/devices/system/node/node" << numa_node << "/cpulist";
+  std::ifstream cpulist_file(cpulist_path.str().c_str());
+  std::string cpu_list;
+  std::getline(cpulist_file, cpu_list);
+  return parse_cpu_list(cpu_list);
+}
@@ -5,6 +5,8 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <vector>
+
 #include <log4cxx/basicconfigurator.h>
 #include <log4cxx/propertyconfigurator.h>
 #include <log4cxx/helpers/exception.h>
@@ -57,9 +59,16 @@ void configure_logging_mdc(const char *app_path) {
   ::pthread_getname_np(::pthread_self(), thread_name, 256);
   MDC::put("thread", thread_name);
 
+  // Use the reentrant lookup, as this is called from many threads starting together
   uid_t uid = ::geteuid();
-  struct passwd *pw = ::getpwuid(uid);
-  if (pw) {
+  long pw_buffer_size = ::sysconf(_SC_GETPW_R_SIZE_MAX);
+  if (pw_buffer_size <= 0) {
+    pw_buffer_size = 16384;
+  }
+  std::vector<char> pw_buffer(pw_buffer_size);
+  struct passwd pw_entry;
+  struct passwd *pw = NULL;
+  if (::getpwuid_r(uid, &pw_entry, &pw_buffer[0], pw_buffer.size(), &pw) == 0 && pw) {
     MDC::put("user", pw->pw_name);
   }
 }
@@ -93,6 +93,8 @@ public:
   std::string acquisition_id_;
   /** Map of dataset definitions for this acquisition */
   std::map<std::string, DatasetDefinition> dataset_defs_;
+  /** Dataset definitions for this acquisition, indexed by the key of their name */
+  std::map<MetaDataKey, DatasetDefinition*> parameter_datasets_;
   /** Number of frames that have been written to file */
   size_t frames_written_;
   /** Number of frames that have been processed */
@@ -41,6 +41,7 @@ public:
   BloscPlugin();
   virtual ~BloscPlugin();
   boost::shared_ptr<Frame> compress_frame(boost::shared_ptr<Frame> frame);
+  bool supports_replicas() const;
 
 private:
   // Baseclass API to implement:
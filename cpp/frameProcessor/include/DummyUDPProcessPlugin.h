@@ -19,6 +19,7 @@ using namespace log4cxx::helpers;
 #include "DummyUDPDefinitions.h"
 #include "ClassLoader.h"
 #include "DataBlockFrame.h"
+#include "MissingPacketFill.h"
 
 namespace FrameProcessor
 {
@@ -73,6 +74,8 @@ private:
   int packets_lost_;
   /** Copy frame mode flag **/
   bool copy_frame_;
+  /** Fill of missing packet payloads **/
+  MissingPacketFill missing_packet_fill_;
 };
 
 } /* namespace FrameProcessor */
@@ -77,8 +77,8 @@ class Frame {
 
  protected:
 
-  /** Pointer to logger */
-  log4cxx::LoggerPtr logger_;
+  /** Pointer to logger, shared by all frames */
+  static log4cxx::LoggerPtr logger_;
 
   /** Frame MetaData */
   FrameMetaData meta_data_;
@@ -4,9 +4,16 @@
 #include <string>
 #include <map>
 #include <vector>
+#include <typeinfo>
+#include <stdexcept>
+#include <cstring>
 #include <stdint.h>
 
 #include <boost/any.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
 #include <log4cxx/logger.h>
 
 #include "FrameProcessorDefinitions.h"
@@ -16,10 +23,20 @@ typedef std::vector<dimsize_t> dimensions_t;
 
 namespace FrameProcessor {
 
+/** Interned identifier of a dataset name or parameter name.
+ *
+ * Interned names are never removed, so they must come from a small set, such as the dataset
+ * and parameter names configured for the plugins, and not from values that change per run.
+ */
+typedef uint32_t MetaDataKey;
+
 class FrameMetaData {
 
 public:
 
+  /** Key of the empty string, used for an unset dataset name */
+  static const MetaDataKey empty_key = 0;
+
   FrameMetaData(const long long& frame_number,
                  const std::string& dataset_name,
                  const DataType& data_type,
@@ -27,39 +44,95 @@ public:
                  const std::vector<unsigned long long>& dimensions,
                  const CompressionType& compression_type = no_compression);
 
+  FrameMetaData(const long long& frame_number,
+                 MetaDataKey dataset_key,
+                 const DataType& data_type,
+                 const std::string& acquisition_ID,
+                 const std::vector<unsigned long long>& dimensions,
+                 const CompressionType& compression_type = no_compression);
+
   FrameMetaData();
 
   FrameMetaData(const FrameMetaData& frame);
 
-  /** Return frame parameters */
-  const std::map <std::string, boost::any> &get_parameters() const;
+  /** Return the key of a name, interning it if it has not been seen before.
+   *
+   * The table of interned names only grows, up to a fixed limit, so names must come from a
+   * small set. Acquisition IDs, which change every run, are not interned.
+   */
+  static MetaDataKey intern(const std::string &name);
+
+  /** Find the key of a name, without interning it */
+  static bool find_key(const std::string &name, MetaDataKey &key);
+
+  /** Return the name of a key */
+  static const std::string &key_name(MetaDataKey key);
+
+  /** Return frame parameters, indexed by name */
+  std::map<std::string, boost::any> get_parameters() const;
+
+  /** Return the number of frame parameters */
+  size_t get_parameter_count() const;
+
+  /** Return the key of a frame parameter by position */
+  MetaDataKey get_parameter_key(size_t index) const;
 
   /** Get frame parameter
    *
    * @tparam T
-   * @param parameter_name
+   * @param parameter_key
    * @return
    */
   template<class T>
-  T get_parameter(const std::string &parameter_name) const {
-    std::map<std::string, boost::any>::const_iterator iter = parameters_.find(parameter_name);
-    if (iter == parameters_.end())
+  T get_parameter(MetaDataKey parameter_key) const {
+    const Parameter *parameter = this->find_parameter(parameter_key);
+    if (parameter == 0)
     {
-      LOG4CXX_ERROR(logger, "Unable to find parameter: " + parameter_name);
+      LOG4CXX_ERROR(logger, "Unable to find parameter: " + key_name(parameter_key));
       throw std::runtime_error("Unable to find parameter");
     }
-    try
+    if (*parameter->type != typeid(T))
     {
-      return boost::any_cast<T>(iter->second);
+      LOG4CXX_ERROR(logger, "Parameter has wrong type: " + key_name(parameter_key));
+      throw std::runtime_error("Parameter has wrong type");
     }
-    catch (boost::bad_any_cast &e)
+    return load_parameter<T>(*parameter, typename IsScalar<T>::type());
+  }
+
+  /** Get frame parameter
+   *
+   * @tparam T
+   * @param parameter_name
+   * @return
+   */
+  template<class T>
+  T get_parameter(const std::string &parameter_name) const {
+    MetaDataKey parameter_key;
+    if (!find_key(parameter_name, parameter_key))
     {
-      LOG4CXX_ERROR(logger, "Parameter has wrong type: " + parameter_name);
-      throw std::runtime_error("Parameter has wrong type");
+      LOG4CXX_ERROR(logger, "Unable to find parameter: " + parameter_name);
+      throw std::runtime_error("Unable to find parameter");
     }
-    catch (std::exception &e) {
-      throw std::runtime_error("Unknown exception fetching parameter");
+    return this->get_parameter<T>(parameter_key);
+  }
+
+  /** Set frame parameter
+   *
+   * @tparam T
+   * @param parameter_key
+   * @param value
+   */
+  template<class T>
+  void set_parameter(MetaDataKey parameter_key, T value) {
+    Parameter *parameter = this->find_parameter(parameter_key);
+    if (parameter == 0) {
+      parameters_.push_back(Parameter());
+      parameter = &parameters_.back();
+      parameter->key = parameter_key;
     }
+    parameter->type = &typeid(T);
+    parameter->to_any = &parameter_to_any<T>;
+    store_parameter(*parameter, value, typename IsScalar<T>::type());
   }
 
   /** Set frame parameter
@@ -70,7 +143,16 @@ public:
    */
   template<class T>
   void set_parameter(const std::string &parameter_name, T value) {
-    parameters_[parameter_name] = value;
+    this->set_parameter<T>(intern(parameter_name), value);
+  }
+
+  /** Check if frame has parameter
+   *
+   * @param parameter_key
+   * @return
+   */
+  bool has_parameter(MetaDataKey parameter_key) const {
+    return (this->find_parameter(parameter_key) != 0);
   }
 
   /** Check if frame has parameter
@@ -79,7 +161,8 @@ public:
    * @return
    */
   bool has_parameter(const std::string& index) const {
-    return (parameters_.count(index) == 1);
+    MetaDataKey parameter_key;
+    return find_key(index, parameter_key) && this->has_parameter(parameter_key);
   }
 
   /** Return frame number */
@@ -94,6 +177,12 @@ public:
   /** Set dataset name */
   void set_dataset_name(const std::string &dataset_name);
 
+  /** Return dataset key */
+  MetaDataKey get_dataset_key() const;
+
+  /** Set dataset key */
+  void set_dataset_key(MetaDataKey dataset_key);
+
   /** Return data type */
   DataType get_data_type() const;
 
@@ -129,20 +218,86 @@ public:
 
 private:
 
+  /** A frame parameter.
+   *
+   * Arithmetic values are held inline, any other type of value in a boost::any.
+   */
+  struct Parameter {
+    /** Key of the parameter name */
+    MetaDataKey key;
+    /** Type of the value */
+    const std::type_info *type;
+    /** Convert the value to a boost::any */
+    boost::any (*to_any)(const Parameter &parameter);
+    /** Arithmetic value */
+    uint64_t scalar;
+    /** Value of any other type */
+    boost::any other;
+  };
+
+  /** Whether a type is held inline in a Parameter */
+  template<class T>
+  struct IsScalar {
+    typedef boost::integral_constant<bool,
+        boost::is_arithmetic<T>::value && (sizeof(T) <= sizeof(uint64_t))> type;
+  };
+
+  template<class T>
+  static void store_parameter(Parameter &parameter, const T &value, boost::true_type) {
+    parameter.scalar = 0;
+    std::memcpy(&parameter.scalar, &value, sizeof(T));
+    parameter.other = boost::any();
+  }
+
+  template<class T>
+  static void store_parameter(Parameter &parameter, const T &value, boost::false_type) {
+    parameter.other = value;
+  }
+
+  template<class T>
+  static T load_parameter(const Parameter &parameter, boost::true_type) {
+    T value;
+    std::memcpy(&value, &parameter.scalar, sizeof(T));
+    return value;
+  }
+
+  template<class T>
+  static T load_parameter(const Parameter &parameter, boost::false_type) {
+    return boost::any_cast<T>(parameter.other);
+  }
+
+  template<class T>
+  static boost::any parameter_to_any(const Parameter &parameter) {
+    return boost::any(load_parameter<T>(parameter, typename IsScalar<T>::type()));
+  }
+
+  const Parameter *find_parameter(MetaDataKey parameter_key) const {
+    for (size_t index = 0; index < parameters_.size(); index++) {
+      if (parameters_[index].key == parameter_key) {
+        return &parameters_[index];
+      }
+    }
+    return 0;
+  }
+
+  Parameter *find_parameter(MetaDataKey parameter_key) {
+    return const_cast<Parameter*>(static_cast<const FrameMetaData*>(this)->find_parameter(parameter_key));
+  }
+
+  /** Pointer to logger, shared by all instances */
+  static log4cxx::LoggerPtr logger;
+
   /** Frame number */
   long long frame_number_;
 
-  /** Pointer to logger */
-  log4cxx::LoggerPtr logger;
-
-  /** Name of this dataset */
-  std::string dataset_name_;
+  /** Key of the name of this dataset */
+  MetaDataKey dataset_key_;
 
   /** Data type of raw data */
   DataType data_type_;
 
-  /** Acquisition ID of the acquisition of this frame **/
-  std::string acquisition_ID_;
+  /** Acquisition ID of the acquisition of this frame, shared between frames, null if unset **/
+  boost::shared_ptr<const std::string> acquisition_ID_;
 
   /** Vector of dimensions */
   dimensions_t dimensions_;
@@ -150,8 +305,8 @@ private:
   /** Compression type of raw data */
   CompressionType compression_type_;
 
-  /** Map of parameters */
-  std::map <std::string, boost::any> parameters_;
+  /** Parameters, held inline up to the usual number set on a frame */
+  boost::container::small_vector<Parameter, 4> parameters_;
 
   /** Frame offset */
   int64_t frame_offset_;
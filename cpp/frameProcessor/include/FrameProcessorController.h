@@ -18,7 +18,10 @@
 #include "SharedBufferManager.h"
 #include "ClassLoader.h"
 #include "FrameProcessorPlugin.h"
+#include "PluginScheduler.h"
+#include "PluginReplicaSet.h"
 #include "OdinDataDefaults.h"
+#include "ThreadPlacement.h"
 
 namespace FrameProcessor
 {
@@ -49,13 +52,16 @@ public:
   void requestCommands(OdinData::IpcMessage& reply);
   void resetStatistics(OdinData::IpcMessage& reply);
   void configurePlugin(OdinData::IpcMessage& config, OdinData::IpcMessage& reply);
-  void loadPlugin(const std::string& index, const std::string& name, const std::string& library);
+  void loadPlugin(const std::string& index, const std::string& name, const std::string& library,
+                  unsigned int replicas=1, const std::string& dispatch="round_robin",
+                  unsigned int reorder_timeout_ms=PluginReplicaSet::default_reorder_timeout_ms);
   void connectPlugin(const std::string& index, const std::string& connectTo);
   void disconnectPlugin(const std::string& index, const std::string& disconnectFrom);
   void disconnectAllPlugins();
   void run();
   void waitForShutdown();
   void shutdown();
+  std::string getWorkerName() const;
 private:
   /** Configuration constant for the meta-data Rx interface **/
   static const std::string META_RX_INTERFACE;
@@ -77,12 +83,25 @@ private:
   static const std::string CONFIG_FR_READY;
   /** Configuration constant for executing setup of shared memory interface **/
   static const std::string CONFIG_FR_SETUP;
+  /** Configuration constant for maximum number of frame releases sent in one message **/
+  static const std::string CONFIG_FR_RELEASE_BATCH_SIZE;
+  /** Configuration constant for maximum time to hold a frame release waiting for a batch **/
+  static const std::string CONFIG_FR_RELEASE_BATCH_TIMEOUT;
+  /** Configuration constant for maximum number of frames notified in a burst passed to plugins together **/
+  static const std::string CONFIG_FR_READY_BATCH_SIZE;
+  /** Configuration constant for maximum time to hold a ready frame waiting for a batch **/
+  static const std::string CONFIG_FR_READY_BATCH_TIMEOUT;
 
   /** Configuration constant for control socket endpoint **/
   static const std::string CONFIG_CTRL_ENDPOINT;
   /** Configuration constant for meta data endpoint **/
   static const std::string CONFIG_META_ENDPOINT;
 
+  /** Configuration constant for thread placement **/
+  static const std::string CONFIG_THREAD_PLACEMENT;
+  /** Configuration constant for the number of plugin scheduler threads **/
+  static const std::string CONFIG_SCHEDULER_THREADS;
+
   /** Configuration constant for plugin related items **/
   static const std::string CONFIG_PLUGIN;
   /** Configuration constant for listing loaded plugins **/
@@ -101,6 +120,16 @@ private:
   static const std::string CONFIG_PLUGIN_LIBRARY;
   /** Configuration constant for setting up a plugin connection **/
   static const std::string CONFIG_PLUGIN_CONNECTION;
+  /** Configuration constant for the maximum depth of the input queue of a connected plugin **/
+  static const std::string CONFIG_PLUGIN_QUEUE_DEPTH;
+  /** Configuration constant for the maximum number of frames a connected plugin processes together **/
+  static const std::string CONFIG_PLUGIN_BATCH_SIZE;
+  /** Configuration constant for the number of replicas of a plugin processing frames in parallel **/
+  static const std::string CONFIG_PLUGIN_REPLICAS;
+  /** Configuration constant for how frames are dispatched to the replicas of a plugin **/
+  static const std::string CONFIG_PLUGIN_DISPATCH;
+  /** Configuration constant for the time after which replicas of a plugin give up on a frame holding up later frames **/
+  static const std::string CONFIG_PLUGIN_REORDER_TIMEOUT;
 
   /** Configuration constant for storing a named configuration object **/
   static const std::string CONFIG_STORE;
@@ -128,6 +157,9 @@ private:
   void closeMetaRxInterface();
   void setupMetaTxInterface(const std::string& metaEndpointString);
   void closeMetaTxInterface();
+  void configureThreadPlacement(OdinData::IpcMessage& config);
+  void configureScheduler(unsigned int num_threads);
+  std::vector<boost::shared_ptr<FrameProcessorPlugin> > getReplicas(const std::string& index);
   void runIpcService(void);
   void tickTimer(void);
   void callback(boost::shared_ptr<Frame> frame);
@@ -138,6 +170,10 @@ private:
   boost::shared_ptr<SharedMemoryController>                       sharedMemController_;
   /** Map of plugins loaded, indexed by plugin index */
   std::map<std::string, boost::shared_ptr<FrameProcessorPlugin> > plugins_;
+  /** Scheduler running the plugins on a shared pool of threads, if configured */
+  boost::shared_ptr<PluginScheduler>                              scheduler_;
+  /** Map of replica sets of plugins loaded as several replicas, indexed by plugin index */
+  std::map<std::string, boost::shared_ptr<PluginReplicaSet> >     replica_sets_;
   /** Map of stored configuration objects */
   std::map<std::string, std::string>                              stored_configs_;
   /** Condition for exiting this file writing process */
@@ -162,6 +198,8 @@ private:
   bool                                                            shutdown_;
   /** Main thread used for control message handling */
   boost::thread                                                   ctrlThread_;
+  /** Name the thread constructing the controller is registered under for placement */
+  std::string                                                     mainThreadName_;
   /** Store for any messages occurring during thread initialisation */
   std::string                                                     threadInitMsg_;
   /** Pointer to the IpcReactor for incoming frame handling */
@@ -182,6 +220,14 @@ private:
   std::string                                                     frReadyEndpoint_;
   /** End point for frameReceiver release channel */
   std::string                                                     frReleaseEndpoint_;
+  /** Maximum number of frame releases sent to the frameReceiver in one message */
+  unsigned int                                                    frReleaseBatchSize_;
+  /** Maximum time in ms to hold a frame release waiting for a batch */
+  unsigned int                                                    frReleaseBatchTimeoutMs_;
+  /** Maximum number of frames notified in a burst passed to the plugins together */
+  unsigned int                                                    frReadyBatchSize_;
+  /** Maximum time in ms to hold a ready frame waiting for a batch */
+  unsigned int                                                    frReadyBatchTimeoutMs_;
 };
 
 } /* namespace FrameProcessor */
@@ -37,10 +37,12 @@ public:
   virtual ~FrameProcessorPlugin();
   void set_name(const std::string& name);
   std::string get_name();
+  std::string getWorkerName() const;
   void set_error(const std::string& msg);
   void set_warning(const std::string& msg);
   void clear_errors();
   virtual bool reset_statistics();
+  virtual bool supports_replicas() const;
   std::vector<std::string> get_errors();
   std::vector<std::string> get_warnings();
   virtual void configure(OdinData::IpcMessage& config, OdinData::IpcMessage& reply);
@@ -59,12 +61,15 @@ public:
 protected:
   void push(boost::shared_ptr<Frame> frame);
   void push(const std::string& plugin_name, boost::shared_ptr<Frame> frame);
+  void push(const std::vector<boost::shared_ptr<Frame> >& frames);
 
 private:
   /** Pointer to logger */
   LoggerPtr logger_;
 
   void callback(boost::shared_ptr<Frame> frame);
+  void callback_batch(const std::vector<boost::shared_ptr<Frame> >& frames);
+  void process_batch(const std::vector<boost::shared_ptr<Frame> >& frames);
 
   /**
    * This is called by the callback method when any new frames have
@@ -73,6 +78,7 @@ private:
    * \param[in] frame - Pointer to the frame.
    */
   virtual void process_frame(boost::shared_ptr<Frame> frame) = 0;
+  virtual void process_frames(const std::vector<boost::shared_ptr<Frame> >& frames);
   virtual void process_end_of_acquisition();
 
   /** Name of this plugin */
@@ -89,6 +95,8 @@ private:
   boost::mutex mutex_;
   /** process_frame performance stats */
   CallDuration process_duration_;
+  /** process_frames performance stats, timing each batch of frames */
+  CallDuration process_batch_duration_;
 };
 
 } /* namespace FrameProcessor */
@@ -0,0 +1,90 @@
+/*
+ * FrameReleaseQueue.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef FRAMEPROCESSOR_FRAMERELEASEQUEUE_H
+#define FRAMEPROCESSOR_FRAMERELEASEQUEUE_H
+
+#include <stdint.h>
+
+#include <boost/lockfree/queue.hpp>
+
+#include "FrameNotification.h"
+
+namespace FrameProcessor {
+
+/** Lock-free queue of shared buffer releases.
+ *
+ * Shared buffer frames are destroyed on whichever plugin thread drops the last reference to
+ * them. Rather than each of those threads sending a release notification on the (non thread
+ * safe) release channel, the release is pushed onto this multi-producer queue, which is drained
+ * by the thread owning the channel. That thread is woken through an event file descriptor when
+ * the first release is queued, so that it can start a batch deadline, and again when a full batch
+ * of releases has been queued.
+ */
+class FrameReleaseQueue {
+
+ public:
+
+  /** A queued shared buffer release */
+  typedef struct {
+    OdinData::FrameNotification::Layout notification; /**< Binary release notification */
+    bool binary;                                       /**< Release with a binary notification */
+    uint64_t dispatch_time_ns;                         /**< Time the frame was dispatched to plugins */
+  } Release;
+
+  /** Construct a FrameReleaseQueue */
+  FrameReleaseQueue(unsigned int batch_size);
+
+  /** Destructor */
+  ~FrameReleaseQueue();
+
+  /** Queue a shared buffer release */
+  void push(const Release &release);
+
+  /** Dequeue a shared buffer release */
+  bool pop(Release &release);
+
+  /** Return the number of releases queued */
+  unsigned int get_pending() const;
+
+  /** Set the number of queued releases that wakes the draining thread */
+  void set_batch_size(unsigned int batch_size);
+
+  /** Return the number of queued releases that wakes the draining thread */
+  unsigned int get_batch_size() const;
+
+  /** Return the event file descriptor signalled to wake the draining thread */
+  int get_wakeup_fd() const;
+
+  /** Signal the event file descriptor to wake the draining thread */
+  void wakeup();
+
+  /** Clear the event file descriptor after waking */
+  void clear_wakeup();
+
+private:
+
+  /** Lock-free queue of releases **/
+  boost::lockfree::queue<Release> queue_;
+
+  /** Number of releases queued **/
+  unsigned int pending_;
+
+  /** Number of queued releases that wakes the draining thread **/
+  unsigned int batch_size_;
+
+  /** Event file descriptor signalled to wake the draining thread **/
+  int wakeup_fd_;
+
+  /** Descriptor written to signal the wakeup descriptor, the same descriptor unless a pipe **/
+  int wakeup_write_fd_;
+
+};
+
+}
+
+#endif
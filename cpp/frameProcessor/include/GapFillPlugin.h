@@ -33,6 +33,7 @@ namespace FrameProcessor
         bool configuration_valid(boost::shared_ptr<Frame> frame);
         boost::shared_ptr<Frame> insert_gaps(boost::shared_ptr<Frame> frame);
         void configure(OdinData::IpcMessage& config, OdinData::IpcMessage& reply);
+        bool supports_replicas() const;
         int get_version_major();
         int get_version_minor();
         int get_version_patch();
@@ -90,6 +90,12 @@ public:
     HDF5CallDurations_t& call_durations
   );
   void write_parameter(const Frame& frame, DatasetDefinition dataset_definition, hsize_t frame_offset);
+  void write_parameter(
+    const Frame& frame,
+    const DatasetDefinition& dataset_definition,
+    MetaDataKey parameter_key,
+    hsize_t frame_offset
+  );
   size_t get_dataset_frames(const std::string& dset_name);
   size_t get_dataset_max_size(const std::string& dset_name);
   void start_swmr();
@@ -9,6 +9,7 @@
 #define TOOLS_FILEWRITER_IFRAMECALLBACK_H_
 
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 #include <boost/thread.hpp>
 
 #include <log4cxx/logger.h>
@@ -20,15 +21,24 @@ using namespace log4cxx::helpers;
 
 #include "Frame.h"
 #include "WorkQueue.h"
+#include "PluginScheduler.h"
 
 namespace FrameProcessor
 {
+
+class PluginReplicaSet;
+
+/** Default maximum number of Frames a worker thread removes from its WorkQueue at once,
+ * one so that frames are passed on singly unless batching is configured **/
+const size_t worker_batch_size = 1;
+
 /** Interface to provide producer/consumer base processing of Frame objects.
  *
  * The IFrameCallback class is a pure virtual class (interface) that must be
  * subclassed and the callback method overridden for use. It provides a WorkQueue
  * for Frame object pointers that allow plugin chains to be created which can
- * each process the Frame object within their own thread.
+ * each process the Frame object within their own thread, or on the shared
+ * threads of a PluginScheduler.
  */
 class IFrameCallback
 {
@@ -36,11 +46,19 @@ public:
   IFrameCallback();
   virtual ~IFrameCallback();
   boost::shared_ptr<WorkQueue<boost::shared_ptr<Frame> > > getWorkQueue();
+  virtual void enqueue(boost::shared_ptr<Frame> frame, bool ignore_max_limit = false);
+  virtual void enqueue_batch(const std::vector<boost::shared_ptr<Frame> >& frames, bool ignore_max_limit = false);
+  void setBatchSize(size_t batch_size);
+  size_t getBatchSize() const;
+  void setScheduler(boost::shared_ptr<PluginScheduler> scheduler);
+  void setReplicaSet(boost::shared_ptr<PluginReplicaSet> replica_set, unsigned int replica_index = 0);
+  void runScheduled();
   void start();
   void stop();
   bool isWorking() const;
   void confirmRegistration(const std::string& name);
   void confirmRemoval(const std::string& name);
+  virtual std::string getWorkerName() const;
 
   /** Callback for when ever a new Frame is available.
    *
@@ -50,6 +68,7 @@ public:
    * \param[in] frame - pointer to Frame object ready for processing by the IFrameCallback subclass.
    */
   virtual void callback(boost::shared_ptr<Frame> frame) = 0;
+  virtual void callback_batch(const std::vector<boost::shared_ptr<Frame> >& frames);
 
 private:
   /** Pointer to logger */
@@ -62,7 +81,29 @@ private:
   bool working_;
   /** Map of confirmed registrations to this worker queue */
   std::map<std::string, std::string> registrations_;
+  /** Scheduler running this IFrameCallback in place of a worker thread, if any */
+  boost::shared_ptr<PluginScheduler> scheduler_;
+  /** Is this IFrameCallback scheduled to run on the scheduler */
+  int scheduled_;
+  /** Frames removed from the WorkQueue for a scheduled run */
+  std::vector<boost::shared_ptr<Frame> > scheduled_batch_;
+  /** Mutex protecting the replica set this IFrameCallback is a replica within */
+  boost::mutex replica_mutex_;
+  /** Replica set this IFrameCallback is a replica within, if any */
+  boost::weak_ptr<PluginReplicaSet> replica_set_;
+  /** Index of this IFrameCallback within its replica set */
+  unsigned int replica_index_;
+  /** Maximum number of Frames removed from the WorkQueue and processed together */
+  size_t batch_size_;
+  /** Mutex protecting the parked producers */
+  boost::mutex parked_mutex_;
+  /** Producers parked until the WorkQueue drains below its maximum depth */
+  std::vector<IFrameCallback*> parked_;
 
+  void schedule();
+  void park(IFrameCallback *producer);
+  void wake_parked();
+  void process(std::vector<boost::shared_ptr<Frame> >& batch);
   void workerTask();
 };
 
@@ -0,0 +1,53 @@
+/*
+ * MissingPacketFill.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef FRAMEPROCESSOR_MISSINGPACKETFILL_H
+#define FRAMEPROCESSOR_MISSINGPACKETFILL_H
+
+#include <cstddef>
+#include <stdint.h>
+
+#include "PacketStateBitmap.h"
+
+namespace FrameProcessor {
+
+/** Fill the payload of packets missing from a frame.
+ *
+ * Frames received from UDP detectors may be notified with packets missing, leaving stale data
+ * from an earlier frame in their place in the buffer. This fills the payload of each run of
+ * missing packets recorded in a packet state bitmap with a single call, rather than packet by
+ * packet, with either a repeated byte value or a repeated pattern, e.g. a 16-bit pixel value.
+ */
+class MissingPacketFill {
+
+ public:
+
+  /** Construct a MissingPacketFill filling with a byte value */
+  MissingPacketFill(uint8_t fill_value = 0);
+
+  /** Construct a MissingPacketFill filling with a repeated pattern */
+  MissingPacketFill(const void *pattern, std::size_t pattern_size);
+
+  /** Fill the payload of each missing packet of a frame */
+  std::size_t fill(const OdinData::PacketStateBitmap &packet_state, void *payload,
+                   std::size_t packet_size) const;
+
+ private:
+
+  /** Fill a region with the pattern */
+  void fill_region(char *region, std::size_t size) const;
+
+  /** Pattern repeated over missing payloads, a single byte when filling with a value **/
+  char pattern_[16];
+
+  /** Size of the pattern in bytes **/
+  std::size_t pattern_size_;
+};
+
+}
+
+#endif //FRAMEPROCESSOR_MISSINGPACKETFILL_H
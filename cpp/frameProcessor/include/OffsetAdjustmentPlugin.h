@@ -34,6 +34,7 @@ public:
   OffsetAdjustmentPlugin();
   virtual ~OffsetAdjustmentPlugin();
   void process_frame(boost::shared_ptr<Frame> frame);
+  void process_frames(const std::vector<boost::shared_ptr<Frame> >& frames);
   void configure(OdinData::IpcMessage& config, OdinData::IpcMessage& reply);
   int get_version_major();
   int get_version_minor();
@@ -43,7 +43,20 @@ public:
   std::string get_version_long();
 
 private:
+  /** Adjustment of a parameter, with the parameter names as frame meta data keys */
+  struct ParameterAdjustment {
+    /** Key of the parameter to set */
+    MetaDataKey parameter;
+    /** Whether the parameter is adjusted from an input parameter rather than the frame number */
+    bool has_input;
+    /** Key of the input parameter */
+    MetaDataKey input;
+    /** Amount to adjust by */
+    int64_t adjustment;
+  };
+
   void requestConfiguration(OdinData::IpcMessage& reply);
+  void update_adjustments();
 
   /** Pointer to logger */
   LoggerPtr logger_;
@@ -51,6 +64,8 @@ private:
   std::map<std::string, int64_t> parameter_adjustments_;
   /** Map of input parameters to use for each parameter **/
   std::map<std::string, std::string> parameter_inputs_;
+  /** Parameter adjustments applied to each frame **/
+  std::vector<ParameterAdjustment> adjustments_;
 };
 
 } /* namespace FrameProcessor */
@@ -0,0 +1,210 @@
+/*
+ * PluginReplicaSet.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef FRAMEPROCESSOR_PLUGINREPLICASET_H
+#define FRAMEPROCESSOR_PLUGINREPLICASET_H
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include "IFrameCallback.h"
+#include "FrameProcessorPlugin.h"
+#include "IpcMessage.h"
+
+namespace FrameProcessor {
+
+class PluginReplicaSet;
+
+/** Output of a PluginReplicaSet, registered as the only callback of each replica.
+ *
+ * Frames pushed by a replica are passed to the replica set to be resequenced.
+ */
+class PluginReplicaOutput : public IFrameCallback {
+
+ public:
+
+  /** Construct a PluginReplicaOutput */
+  PluginReplicaOutput(PluginReplicaSet &replica_set);
+
+  /** Pass a frame pushed by a replica to the replica set */
+  void enqueue(boost::shared_ptr<Frame> frame, bool ignore_max_limit = false);
+
+  /** Pass a batch of frames pushed by a replica to the replica set */
+  void enqueue_batch(const std::vector<boost::shared_ptr<Frame> > &frames, bool ignore_max_limit = false);
+
+  /** Pass a frame pushed by a replica to the replica set */
+  void callback(boost::shared_ptr<Frame> frame);
+
+ private:
+
+  /** Replica set the frames are passed to */
+  PluginReplicaSet &replica_set_;
+};
+
+/** Set of replicas of a plugin processing frames in parallel.
+ *
+ * A plugin that declares it supports replicas, by processing each frame independently of any
+ * other, can be loaded as several instances sharing a name and configuration. The replica set
+ * takes the place of the plugin in the chain: frames pushed to it are dispatched to one replica
+ * each, either in turn or to the replica with the fewest frames queued, and each replica
+ * processes its frames on its own thread or on the plugin scheduler.
+ *
+ * Frames pushed on by the replicas are held in a reorder buffer and passed to the plugins
+ * connected to the replica set in the order the frames were dispatched. This is the order the
+ * frames arrived in, normally frame number order, but frames are not sorted by frame number.
+ * The frames pushed while processing each dispatched frame are released together once that
+ * frame and all those dispatched before it are done, so a replica may push any number of frames
+ * for each, including none. End of acquisition frames are passed to every replica and released
+ * once, when all replicas are done with them.
+ *
+ * Each replica processes its frames in the order they were dispatched to it, so the sequence
+ * number of each frame is queued for its replica alongside the frame. A frame not done within
+ * the reorder timeout of being dispatched, once a later frame is done, is given up on so that
+ * the frames behind it are released, and anything pushed for it afterwards is passed on as soon
+ * as it is pushed.
+ *
+ * A replica set is created by the create method, which attaches it to its replicas.
+ */
+class PluginReplicaSet : public IFrameCallback {
+
+ public:
+
+  /** Ways of choosing the replica to dispatch a frame to */
+  enum DispatchMode {
+    DispatchRoundRobin,  /**< Each replica in turn */
+    DispatchLeastLoaded  /**< The replica with the fewest frames queued */
+  };
+
+  /** Create a PluginReplicaSet and attach it to its replicas */
+  static boost::shared_ptr<PluginReplicaSet> create(
+      const std::string &name,
+      const std::vector<boost::shared_ptr<FrameProcessorPlugin> > &replicas,
+      DispatchMode dispatch_mode,
+      unsigned int reorder_timeout_ms = default_reorder_timeout_ms);
+
+  /** Default time in ms after which a frame holding up later frames is given up on */
+  static const unsigned int default_reorder_timeout_ms = 10000;
+
+  /** Destructor */
+  ~PluginReplicaSet();
+
+  /** Dispatch a frame to one of the replicas */
+  void enqueue(boost::shared_ptr<Frame> frame, bool ignore_max_limit = false);
+
+  /** Dispatch a batch of frames to the replicas */
+  void enqueue_batch(const std::vector<boost::shared_ptr<Frame> > &frames, bool ignore_max_limit = false);
+
+  /** Dispatch a frame to one of the replicas */
+  void callback(boost::shared_ptr<Frame> frame);
+
+  /** Register a plugin to receive the frames released by the reorder buffer */
+  void register_callback(const std::string &name, boost::shared_ptr<IFrameCallback> cb, bool blocking = false);
+
+  /** Remove a plugin receiving the frames released by the reorder buffer */
+  void remove_callback(const std::string &name);
+
+  /** Remove all plugins receiving the frames released by the reorder buffer */
+  void remove_all_callbacks();
+
+  /** Return the replicas */
+  const std::vector<boost::shared_ptr<FrameProcessorPlugin> > &get_replicas() const;
+
+  /** Record the start of processing of a frame by a replica, on the replica thread */
+  void begin_frame(unsigned int replica, boost::shared_ptr<Frame> frame);
+
+  /** Record the end of processing of a frame by a replica, on the replica thread */
+  void end_frame();
+
+  /** Add a frame pushed by a replica to the reorder buffer */
+  void collect(boost::shared_ptr<Frame> frame);
+
+  /** Add the replica set statistics to a status message */
+  void status(OdinData::IpcMessage &status);
+
+  /** Reset the replica set statistics */
+  void reset_statistics();
+
+  /** Return the dispatch mode with the given name */
+  static DispatchMode get_dispatch_mode(const std::string &name);
+
+ private:
+
+  /** A dispatched frame awaiting release from the reorder buffer */
+  struct Pending {
+    /** Number of replicas still to finish processing the frame */
+    unsigned int remaining;
+    /** Time the frame was dispatched */
+    uint64_t dispatch_ns;
+    /** Frames pushed by the replicas while processing the frame */
+    std::vector<boost::shared_ptr<Frame> > outputs;
+  };
+
+  PluginReplicaSet(const std::string &name,
+                   const std::vector<boost::shared_ptr<FrameProcessorPlugin> > &replicas,
+                   DispatchMode dispatch_mode,
+                   unsigned int reorder_timeout_ms);
+  void release_completed(std::vector<boost::shared_ptr<Frame> > &released);
+  void release(const std::vector<boost::shared_ptr<Frame> > &released,
+               boost::unique_lock<boost::mutex> &lock);
+  void emit(boost::shared_ptr<Frame> frame);
+  void update_stall(uint64_t now_ns);
+
+  /** Logger for logging */
+  LoggerPtr logger_;
+  /** Name of the replicated plugin */
+  std::string name_;
+  /** Replicas of the plugin */
+  std::vector<boost::shared_ptr<FrameProcessorPlugin> > replicas_;
+  /** Output registered with each replica */
+  boost::shared_ptr<PluginReplicaOutput> output_;
+  /** How frames are dispatched to replicas */
+  DispatchMode dispatch_mode_;
+  /** Replica the next frame is dispatched to in round robin mode */
+  unsigned int next_replica_;
+  /** Mutex protecting the reorder buffer and callbacks */
+  boost::mutex mutex_;
+  /** Mutex serialising the release of frames to the callbacks, in order */
+  boost::mutex emit_mutex_;
+  /** Mutex serialising the dispatch of frames, so each replica queue matches its sequence numbers */
+  boost::mutex dispatch_mutex_;
+  /** Sequence number of the next frame dispatched */
+  uint64_t next_sequence_;
+  /** Sequence numbers of the frames dispatched to each replica and not yet started, in order */
+  std::vector<std::deque<uint64_t> > dispatched_;
+  /** Time after which a frame holding up later frames is given up on */
+  uint64_t reorder_timeout_ns_;
+  /** Number of frames given up on */
+  uint64_t reorder_timeouts_;
+  /** Dispatched frames not yet released, by sequence number */
+  std::map<uint64_t, Pending> pending_;
+  /** Number of dispatched frames done but held behind an earlier frame */
+  unsigned int held_;
+  /** Maximum number of frames held in the reorder buffer */
+  unsigned int max_held_;
+  /** Whether frames are currently held behind an earlier frame */
+  bool stalled_;
+  /** Time the current stall started */
+  uint64_t stall_start_ns_;
+  /** Total time frames have been held behind an earlier frame */
+  uint64_t stall_ns_;
+  /** Number of frames dispatched */
+  uint64_t frames_dispatched_;
+  /** Map of plugins receiving released frames, indexed by name */
+  std::map<std::string, boost::shared_ptr<IFrameCallback> > callbacks_;
+  /** Map of plugins receiving released frames through blocking calls, indexed by name */
+  std::map<std::string, boost::shared_ptr<IFrameCallback> > blocking_callbacks_;
+};
+
+} /* namespace FrameProcessor */
+
+#endif /* FRAMEPROCESSOR_PLUGINREPLICASET_H */
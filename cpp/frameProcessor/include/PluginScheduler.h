@@ -0,0 +1,101 @@
+/*
+ * PluginScheduler.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef FRAMEPROCESSOR_PLUGINSCHEDULER_H
+#define FRAMEPROCESSOR_PLUGINSCHEDULER_H
+
+#include <deque>
+#include <vector>
+#include <stdint.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include "IpcMessage.h"
+
+namespace FrameProcessor {
+
+class IFrameCallback;
+
+/** Work-stealing pool of threads running plugins.
+ *
+ * By default each plugin processes frames on a thread of its own. Plugins attached to a
+ * scheduler instead share a fixed pool of worker threads. A plugin with frames waiting on its
+ * queue is scheduled as a task, which runs a batch of the frames through the plugin, and the
+ * plugin is only ever scheduled once at a time, so that each plugin still processes its frames
+ * one at a time and in order.
+ *
+ * Each worker has its own deque of tasks. A task scheduled from a worker, as a plugin pushes
+ * frames on to the next plugins in the chain, goes on the deque of that worker, which runs its
+ * most recent task first so that a frame usually stays on one core as it passes through the
+ * chain. Tasks scheduled from other threads are dealt to the workers in turn. A worker with no
+ * tasks of its own steals the oldest task from another worker, and parks once there are none.
+ */
+class PluginScheduler {
+
+ public:
+
+  /** Construct a PluginScheduler */
+  PluginScheduler(unsigned int num_threads);
+
+  /** Destructor */
+  ~PluginScheduler();
+
+  /** Schedule a plugin to process the frames waiting on its queue */
+  void submit(IFrameCallback *callback);
+
+  /** Stop the worker threads, discarding any tasks not yet run */
+  void stop();
+
+  /** Return whether the calling thread is one of the worker threads */
+  bool is_worker_thread() const;
+
+  /** Return the number of worker threads */
+  unsigned int get_num_threads() const;
+
+  /** Add the scheduler statistics to a status message */
+  void status(const std::string &prefix, OdinData::IpcMessage &status) const;
+
+ private:
+
+  /** Deque of tasks owned by a worker thread */
+  struct Worker {
+    /** Mutex protecting the deque */
+    boost::mutex mutex;
+    /** Tasks scheduled on the worker, the most recent at the back */
+    std::deque<IFrameCallback*> tasks;
+  };
+
+  void run(unsigned int index);
+  bool take(unsigned int index, IFrameCallback *&task);
+  bool steal(unsigned int index, IFrameCallback *&task);
+
+  /** Deques of tasks for each worker thread */
+  std::vector<boost::shared_ptr<Worker> > workers_;
+  /** Worker threads */
+  boost::thread_group threads_;
+  /** Whether the worker threads are running */
+  int running_;
+  /** Number of tasks scheduled and not yet taken by a worker */
+  unsigned int pending_;
+  /** Worker the next task scheduled from outside the pool is dealt to */
+  unsigned int next_worker_;
+  /** Number of workers parked waiting for tasks */
+  unsigned int idle_workers_;
+  /** Mutex for parking workers */
+  boost::mutex idle_mutex_;
+  /** Condition signalled to wake a parked worker */
+  boost::condition_variable idle_cond_;
+  /** Number of tasks run */
+  uint64_t tasks_run_;
+  /** Number of tasks stolen from another worker */
+  uint64_t tasks_stolen_;
+};
+
+} /* namespace FrameProcessor */
+
+#endif /* FRAMEPROCESSOR_PLUGINSCHEDULER_H */
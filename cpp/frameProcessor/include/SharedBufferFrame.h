@@ -4,7 +4,11 @@
 #include "Frame.h"
 
 #include <stdint.h>
-#include "IpcChannel.h"
+#include <boost/shared_ptr.hpp>
+#include "FrameNotification.h"
+#include "FrameReleaseQueue.h"
+#include "SharedFrameRings.h"
+#include "SharedBufferManager.h"
 
 namespace FrameProcessor {
 
@@ -17,7 +21,7 @@ class SharedBufferFrame : public Frame {
                     void *data_src,
                     size_t nbytes,
                     uint64_t bufferID,
-                    OdinData::IpcChannel *relCh,
+                    boost::shared_ptr<FrameReleaseQueue> releaseQueue,
                     const int &image_offset = 0);
 
   /** Shallow-copy copy */
@@ -29,6 +33,15 @@ class SharedBufferFrame : public Frame {
   /** Return a void pointer to the raw data */
   virtual void *get_data_ptr() const;
 
+  /** Keep the shared buffer mapped until the frame is destroyed */
+  void set_buffer_manager(boost::shared_ptr<OdinData::SharedBufferManager> buffer_manager);
+
+  /** Release the shared buffer with a binary notification */
+  void set_binary_release(const OdinData::FrameNotification &ready_notification);
+
+  /** Release the shared buffer through a shared frame ring */
+  void set_ring_release(const OdinData::FrameNotification &ready_notification, unsigned int ring);
+
 private:
 
   /** Pointer to shared memory raw block **/
@@ -37,8 +50,26 @@ private:
   /** Shared memory buffer ID **/
   uint64_t shared_id_;
 
-  /** ZMQ release channel for the shared buffer **/
-  OdinData::IpcChannel *shared_channel_;
+  /** Queue the shared buffer is released through **/
+  boost::shared_ptr<FrameReleaseQueue> release_queue_;
+
+  /** Time the frame was dispatched, in ns since the epoch **/
+  uint64_t dispatch_time_ns_;
+
+  /** Send a binary rather than JSON release notification **/
+  bool binary_release_;
+
+  /** Frame ready notification the binary release notification is built from **/
+  OdinData::FrameNotification ready_notification_;
+
+  /** Shared buffer manager mapping the buffer, kept until the frame is released **/
+  boost::shared_ptr<OdinData::SharedBufferManager> buffer_manager_;
+
+  /** Shared frame rings to release the buffer through, NULL to release on the channel **/
+  OdinData::SharedFrameRings *release_rings_;
+
+  /** Index of the shared frame ring to release the buffer through **/
+  unsigned int release_ring_;
 
 };
 
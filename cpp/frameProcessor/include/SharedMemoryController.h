@@ -16,16 +16,22 @@ using namespace log4cxx;
 using namespace log4cxx::helpers;
 
 #include "boost/date_time/posix_time/posix_time.hpp"
+#include <boost/thread.hpp>
 
 #include "IFrameCallback.h"
 #include "IpcReactor.h"
 #include "IpcChannel.h"
 #include "IpcMessage.h"
 #include "SharedBufferManager.h"
+#include "FrameNotification.h"
+#include "FrameReleaseQueue.h"
 
 namespace FrameProcessor
 {
 
+/** Name of the frame parameter recording the buffer pool a frame was received into */
+static const std::string BUFFER_POOL_PARAM_NAME = "buffer_pool";
+
 /**
  * The SharedMemoryController class uses an IpcReactor object which is used
  * to notify this class when new data is available from the
@@ -48,20 +54,84 @@ public:
   void handleRxChannel();
   void status(OdinData::IpcMessage& status);
   void injectEOA();
+  void setReleaseBatching(unsigned int batch_size, unsigned int timeout_ms);
+  void setReadyBatching(unsigned int batch_size, unsigned int timeout_ms);
 
 private:
+  void handleRxMessage(const std::string& rxMsgEncoded, std::vector<boost::shared_ptr<Frame> >& frames);
+  boost::shared_ptr<Frame> createFrame(long long frame_number, int bufferID,
+                                       const OdinData::FrameNotification* ready_notification=NULL,
+                                       int ring=-1);
+  void dispatchFrames(std::vector<boost::shared_ptr<Frame> >& frames);
+  void dispatchEOA();
+  void startRingThread();
+  void stopRingThread();
+  void ringThreadLoop();
+  void handleReleaseQueue();
+  void readyTimeout();
+  void releaseTimeout();
+  void flushReleases();
+  void sendReleases(const std::vector<OdinData::FrameNotification>& releases, bool binary);
+
   /** Pointer to logger */
   LoggerPtr logger_;
   /** Pointer to SharedBufferManager object */
   boost::shared_ptr<OdinData::SharedBufferManager> sbm_;
   /** Map of IFrameCallback pointers, indexed by name */
   std::map<std::string, boost::shared_ptr<IFrameCallback> > callbacks_;
+  /** Mutex protecting the callback map, which the ring thread also uses */
+  boost::mutex callbacksMutex_;
+  /** Thread consuming frame ready notifications from shared frame rings */
+  boost::shared_ptr<boost::thread> ringThread_;
+  /** Flag signalling the ring thread should run */
+  volatile bool ringThreadRunning_;
+  /** Flag requesting the ring thread to pass on an EOA frame after its held frames, accessed atomically */
+  bool ringEOARequested_;
+  /** Number of frames received through shared frame rings, accessed atomically */
+  uint64_t ringFramesReceived_;
+  /** Number of ready notifications ignored as the buffer was no longer ready, accessed atomically */
+  uint64_t staleNotifications_;
   /** IpcReactor pointer, for managing IpcMessage objects */
   boost::shared_ptr<OdinData::IpcReactor> reactor_;
   /** IpcChannel for receiving notifications of new frames */
   OdinData::IpcChannel             rxChannel_;
   /** IpcChannel for sending notifications of frame release */
   OdinData::IpcChannel             txChannel_;
+  /** Maximum number of frames notified in a burst passed to the callbacks together, accessed atomically */
+  unsigned int readyBatchSize_;
+  /** Maximum time in ms to hold frames for further frames to fill a batch, zero to take only those
+   *  waiting, accessed atomically */
+  unsigned int readyBatchTimeoutMs_;
+  /** Frames received and held waiting for a batch to fill */
+  std::vector<boost::shared_ptr<Frame> > readyFrames_;
+  /** Flag set while a timer to pass on the held frames is registered */
+  bool readyTimerArmed_;
+  /** ID of the timer most recently registered to pass on the held frames */
+  int readyTimerId_;
+  /** Number of batches of frames passed to the callbacks, accessed atomically */
+  uint64_t readyBatchesDispatched_;
+  /** Number of frames passed to the callbacks in batches, accessed atomically */
+  uint64_t readyFramesDispatched_;
+  /** Frame meta data key of the dataset name given to received frames */
+  MetaDataKey rawDatasetKey_;
+  /** Frame meta data key of the buffer pool parameter */
+  MetaDataKey bufferPoolKey_;
+  /** Queue of frame releases to be sent on txChannel_ by the reactor thread */
+  boost::shared_ptr<FrameReleaseQueue> releaseQueue_;
+  /** Maximum time in ms a frame release is held to be batched, zero to send without waiting */
+  unsigned int releaseBatchTimeoutMs_;
+  /** Flag set while a timer to send the pending frame releases is registered */
+  bool releaseTimerArmed_;
+  /** ID of the timer most recently registered to send pending frame releases */
+  int releaseTimerId_;
+  /** Number of frame releases sent on txChannel_ */
+  uint64_t releasesSent_;
+  /** Number of messages frame releases were sent in */
+  uint64_t releaseMessagesSent_;
+  /** Total latency between dispatching frames and sending their release, in ns */
+  uint64_t releaseLatencyTotalNs_;
+  /** Maximum latency between dispatching a frame and sending its release, in ns */
+  uint64_t releaseLatencyMaxNs_;
   /** Shared buffer configured status flag */
   bool sharedBufferConfigured_;
   /** Shared buffer config request deferred flag */
@@ -10,13 +10,24 @@
 
 #include <cstddef>
 #include <list>
+#include <vector>
+#include <stdexcept>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
 
 namespace FrameProcessor
 {
 
-/** Maximum queue size - to prevent unlimited use of memory **/
+/** Default maximum queue depth - to prevent unlimited use of memory **/
 const int max_queue_size = 8;
 
+/** Capacity of the ring of each queue, the largest depth that can be configured **/
+const size_t work_queue_capacity = 1024;
+
+/** Number of times a blocked producer or idle consumer polls the queue before parking **/
+const unsigned int work_queue_spin_polls = 1000;
+
 /** Thread safe producer consumer work queue.
  *
  * This is a thread safe producer consumer queue for use across multiple threads
@@ -24,56 +35,146 @@ const int max_queue_size = 8;
  * arrival of new items. This WorkQueue is used for transfer of Frame objects
  * between plugins. Note that the queue is used for transferring pointers to the
  * Frame objects, and not the Frame objects themselves.
+ *
+ * Items are held in a fixed-capacity lock-free ring, so that adding and removing them neither
+ * allocates nor takes a lock. Each slot of the ring carries a sequence number indicating
+ * whether it is free for the producer of a given position or holds an item for the consumer.
+ * Any number of producers may add items, claiming positions with an atomic compare and swap,
+ * which is uncontended when the queue has a single producer, while a single consumer thread
+ * removes them. Producers block once the queue reaches its maximum depth, which can be set per
+ * queue up to the ring capacity, unless they ignore the limit, in which case items that do not
+ * fit in the ring are held in an overflow list until the consumer catches up. Blocked producers
+ * and idle consumers poll the queue briefly before parking on a condition, and are only
+ * signalled while parked. The current and highest depth of the queue, the time producers have
+ * spent blocked and the time the consumer has spent idle are recorded.
  */
 template <typename T> class WorkQueue
 {
-  /** Queue (list) of worker items queued for processing */
-  std::list<T> m_queue;
-  /** Mutex for locking the queue */
+  /** Slot of the ring holding an item */
+  struct Slot
+  {
+    /** Position of the slot when free for a producer, or that plus one when holding an item */
+    uint64_t sequence;
+    /** Item held in the slot */
+    T item;
+  };
+
+  /** Ring of slots */
+  std::vector<Slot> m_slots;
+  /** Mask applied to positions to index the ring */
+  uint64_t m_mask;
+  /** Next position to be claimed by a producer */
+  uint64_t m_tail;
+  /** Next position to be removed by the consumer */
+  uint64_t m_head;
+  /** Maximum depth of the queue before producers block */
+  size_t m_max_depth;
+  /** Items added while the ring was full, in order */
+  std::list<T> m_overflow;
+  /** Number of items in the overflow list */
+  size_t m_overflow_size;
+  /** Mutex protecting the overflow list and parking of threads */
   pthread_mutex_t  m_mutex;
-  /** Condition for waking up blocked threads when a new item is added to the queue */
-  pthread_cond_t   m_condv;
+  /** Condition for waking up the parked consumer when a new item is added to the queue */
+  pthread_cond_t   m_not_empty;
+  /** Condition for waking up parked producers when an item is removed from the queue */
+  pthread_cond_t   m_not_full;
+  /** Indicates the consumer is parked */
+  int m_consumer_parked;
+  /** Number of producers parked */
+  int m_producers_parked;
+  /** Highest depth of the queue */
+  size_t m_high_water;
+  /** Total time producers have spent blocked on a full queue, in nanoseconds */
+  uint64_t m_producer_block_ns;
+  /** Total time the consumer has spent waiting on an empty queue, in nanoseconds */
+  uint64_t m_consumer_idle_ns;
 
 public:
 
   /** Constructor.
    *
-   * The constructor initialises the mutex and condition required for the class.
+   * The constructor allocates the ring and initialises the mutex and conditions required for
+   * the class.
+   *
+   * \param[in] capacity - capacity of the ring, rounded up to a power of two.
    */
-  WorkQueue()
+  WorkQueue(size_t capacity = work_queue_capacity) :
+    m_tail(0),
+    m_head(0),
+    m_max_depth(max_queue_size),
+    m_overflow_size(0),
+    m_consumer_parked(0),
+    m_producers_parked(0),
+    m_high_water(0),
+    m_producer_block_ns(0),
+    m_consumer_idle_ns(0)
   {
+    size_t ring_size = 1;
+    while (ring_size < capacity) {
+      ring_size <<= 1;
+    }
+    m_slots.resize(ring_size);
+    for (size_t slot = 0; slot < ring_size; slot++) {
+      m_slots[slot].sequence = slot;
+    }
+    m_mask = ring_size - 1;
     pthread_mutex_init(&m_mutex, NULL);
-    pthread_cond_init(&m_condv, NULL);
+    pthread_cond_init(&m_not_empty, NULL);
+    pthread_cond_init(&m_not_full, NULL);
   }
 
   /** Destructor.
    *
-   * The destructor frees resources (mutex and condition).
+   * The destructor frees resources (mutex and conditions).
    */
   virtual ~WorkQueue()
   {
     pthread_mutex_destroy(&m_mutex);
-    pthread_cond_destroy(&m_condv);
+    pthread_cond_destroy(&m_not_empty);
+    pthread_cond_destroy(&m_not_full);
   }
 
   /** Add an item to the queue.
    *
-   * The item is added to the list, and then any threads
-   * waiting for notification of a new item are signalled.
+   * If the queue is at its maximum depth the caller blocks until the consumer removes an
+   * item, unless the limit is ignored. The item is then added to the ring, or to the overflow
+   * list if the ring is full or earlier items are still waiting there, and the consumer is
+   * signalled if it is parked waiting for items.
    *
    * \param[in] item - the item to add to the queue.
+   * \param[in] ignore_max_limit - add the item even if the queue is at its maximum depth.
    */
   void add(T item, bool ignore_max_limit = false)
   {
-    pthread_mutex_lock(&m_mutex);
-    if (!ignore_max_limit){
-      while (m_queue.size() >= max_queue_size) {
-        pthread_cond_wait(&m_condv, &m_mutex);
+    if (!ignore_max_limit && (size() >= (int)max_depth())) {
+      wait_for_space();
+    }
+    push(item);
+    update_high_water();
+    wake_consumer();
+  }
+
+  /** Add a batch of items to the queue.
+   *
+   * The items are added in order as for add, but the consumer is only signalled once for
+   * the whole batch, unless the caller has to block for space part way through it.
+   *
+   * \param[in] items - the items to add to the queue.
+   * \param[in] ignore_max_limit - add the items even if the queue is at its maximum depth.
+   */
+  void add_batch(const std::vector<T>& items, bool ignore_max_limit = false)
+  {
+    for (size_t index = 0; index < items.size(); index++) {
+      if (!ignore_max_limit && (size() >= (int)max_depth())) {
+        // Let the consumer drain the items already added before blocking
+        wake_consumer();
+        wait_for_space();
       }
+      push(items[index]);
     }
-    m_queue.push_back(item);
-    pthread_cond_signal(&m_condv);
-    pthread_mutex_unlock(&m_mutex);
+    update_high_water();
+    wake_consumer();
   }
 
   /** Remove an item from the queue.
@@ -86,27 +187,336 @@ public:
    */
   T remove()
   {
-    pthread_mutex_lock(&m_mutex);
-    while (m_queue.size() == 0) {
-      pthread_cond_wait(&m_condv, &m_mutex);
-    }
-    T item = m_queue.front();
-    m_queue.pop_front();
-    pthread_cond_signal(&m_condv);
-    pthread_mutex_unlock(&m_mutex);
+    T item;
+    wait_for_item(item);
+    wake_producers();
     return item;
   }
 
+  /** Remove a batch of items from the queue.
+   *
+   * Calling this method blocks the current thread until at least one item is available, and
+   * then removes up to the maximum number of items requested without blocking further.
+   *
+   * \param[out] items - vector the items removed are appended to.
+   * \param[in] max_items - maximum number of items to remove.
+   * \return the number of items removed.
+   */
+  size_t remove_batch(std::vector<T>& items, size_t max_items)
+  {
+    T item;
+    wait_for_item(item);
+    items.push_back(item);
+    size_t removed = 1;
+    while ((removed < max_items) && try_remove(item)) {
+      items.push_back(item);
+      removed++;
+    }
+    wake_producers();
+    return removed;
+  }
+
+  /** Remove a batch of items from the queue without blocking.
+   *
+   * \param[out] items - vector the items removed are appended to.
+   * \param[in] max_items - maximum number of items to remove.
+   * \return the number of items removed, zero if the queue is empty.
+   */
+  size_t try_remove_batch(std::vector<T>& items, size_t max_items)
+  {
+    T item;
+    size_t removed = 0;
+    while ((removed < max_items) && try_remove(item)) {
+      items.push_back(item);
+      removed++;
+    }
+    if (removed) {
+      wake_producers();
+    }
+    return removed;
+  }
+
   /** Return the size of the queue.
    *
    * \return the size of the queue.
    */
   int size()
   {
+    uint64_t head = __atomic_load_n(&m_head, __ATOMIC_ACQUIRE);
+    uint64_t tail = __atomic_load_n(&m_tail, __ATOMIC_ACQUIRE);
+    size_t ring_size = (tail > head) ? (size_t)(tail - head) : 0;
+    return (int)(ring_size + __atomic_load_n(&m_overflow_size, __ATOMIC_ACQUIRE));
+  }
+
+  /** Set the maximum depth of the queue before producers block.
+   *
+   * \param[in] max_depth - maximum depth, between 1 and the capacity of the ring.
+   */
+  void set_max_depth(size_t max_depth)
+  {
+    if ((max_depth == 0) || (max_depth > capacity())) {
+      throw std::runtime_error("Work queue depth must be between 1 and the queue capacity");
+    }
+    __atomic_store_n(&m_max_depth, max_depth, __ATOMIC_RELAXED);
+    wake_producers();
+  }
+
+  /** Return the maximum depth of the queue before producers block.
+   *
+   * \return the maximum depth.
+   */
+  size_t max_depth() const
+  {
+    return __atomic_load_n(&m_max_depth, __ATOMIC_RELAXED);
+  }
+
+  /** Return the capacity of the ring.
+   *
+   * \return the capacity.
+   */
+  size_t capacity() const
+  {
+    return m_slots.size();
+  }
+
+  /** Return the highest depth of the queue since the statistics were reset.
+   *
+   * \return the high water mark.
+   */
+  size_t high_water() const
+  {
+    return __atomic_load_n(&m_high_water, __ATOMIC_RELAXED);
+  }
+
+  /** Return the total time producers have spent blocked on a full queue.
+   *
+   * \return the blocked time in microseconds.
+   */
+  uint64_t producer_block_us() const
+  {
+    return __atomic_load_n(&m_producer_block_ns, __ATOMIC_RELAXED) / 1000;
+  }
+
+  /** Return the total time the consumer has spent waiting on an empty queue.
+   *
+   * \return the idle time in microseconds.
+   */
+  uint64_t consumer_idle_us() const
+  {
+    return __atomic_load_n(&m_consumer_idle_ns, __ATOMIC_RELAXED) / 1000;
+  }
+
+  /** Reset the queue statistics.
+   *
+   * The high water mark is reset to the current depth and the blocked and idle times to zero.
+   */
+  void reset_stats()
+  {
+    __atomic_store_n(&m_high_water, (size_t)size(), __ATOMIC_RELAXED);
+    __atomic_store_n(&m_producer_block_ns, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&m_consumer_idle_ns, 0, __ATOMIC_RELAXED);
+  }
+
+private:
+
+  /** Add an item to the ring, or to the overflow list if the ring is full or earlier items are
+   * still waiting there.
+   *
+   * \param[in] item - the item to add.
+   */
+  void push(const T& item)
+  {
+    if (__atomic_load_n(&m_overflow_size, __ATOMIC_ACQUIRE) || !push_ring(item)) {
+      pthread_mutex_lock(&m_mutex);
+      m_overflow.push_back(item);
+      __atomic_add_fetch(&m_overflow_size, 1, __ATOMIC_RELEASE);
+      pthread_mutex_unlock(&m_mutex);
+    }
+  }
+
+  /** Add an item to the ring.
+   *
+   * \param[in] item - the item to add.
+   * \return true if the item was added, false if the ring is full.
+   */
+  bool push_ring(const T& item)
+  {
+    uint64_t pos = __atomic_load_n(&m_tail, __ATOMIC_RELAXED);
+    Slot* slot;
+    while (true) {
+      slot = &m_slots[pos & m_mask];
+      int64_t diff = (int64_t)__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) - (int64_t)pos;
+      if (diff == 0) {
+        if (__atomic_compare_exchange_n(&m_tail, &pos, pos + 1, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = __atomic_load_n(&m_tail, __ATOMIC_RELAXED);
+      }
+    }
+    slot->item = item;
+    __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  /** Remove an item from the ring, or from the overflow list once the ring is empty.
+   *
+   * The slot is cleared as the item is removed, so that the queue holds no reference to it.
+   *
+   * \param[out] item - the item removed.
+   * \param[in] locked - the caller already holds the mutex.
+   * \return true if an item was removed.
+   */
+  bool try_remove(T& item, bool locked = false)
+  {
+    uint64_t pos = m_head;
+    Slot* slot = &m_slots[pos & m_mask];
+    if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) == pos + 1) {
+      item = slot->item;
+      slot->item = T();
+      __atomic_store_n(&slot->sequence, pos + m_mask + 1, __ATOMIC_RELEASE);
+      __atomic_store_n(&m_head, pos + 1, __ATOMIC_RELEASE);
+      return true;
+    }
+    // The ring is empty, or its next item is still being written, in which case it was claimed
+    // before anything was added to the overflow list and the consumer must wait for it
+    if ((__atomic_load_n(&m_tail, __ATOMIC_ACQUIRE) == pos) &&
+        __atomic_load_n(&m_overflow_size, __ATOMIC_ACQUIRE)) {
+      if (locked) {
+        return remove_overflow(item);
+      }
+      pthread_mutex_lock(&m_mutex);
+      bool removed = remove_overflow(item);
+      pthread_mutex_unlock(&m_mutex);
+      return removed;
+    }
+    return false;
+  }
+
+  /** Remove the first item of the overflow list, with the mutex held.
+   *
+   * \param[out] item - the item removed.
+   * \return true if an item was removed.
+   */
+  bool remove_overflow(T& item)
+  {
+    if (m_overflow.empty()) {
+      return false;
+    }
+    item = m_overflow.front();
+    m_overflow.pop_front();
+    __atomic_sub_fetch(&m_overflow_size, 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+  /** Wait until an item can be removed, polling before parking, and remove it.
+   *
+   * \param[out] item - the item removed.
+   */
+  void wait_for_item(T& item)
+  {
+    if (try_remove(item)) {
+      return;
+    }
+    uint64_t start_ns = now_ns();
+    for (unsigned int poll = 0; poll < work_queue_spin_polls; poll++) {
+      cpu_relax();
+      if (try_remove(item)) {
+        __atomic_add_fetch(&m_consumer_idle_ns, now_ns() - start_ns, __ATOMIC_RELAXED);
+        return;
+      }
+    }
+    pthread_mutex_lock(&m_mutex);
+    __atomic_store_n(&m_consumer_parked, 1, __ATOMIC_SEQ_CST);
+    while (!try_remove(item, true)) {
+      pthread_cond_wait(&m_not_empty, &m_mutex);
+    }
+    __atomic_store_n(&m_consumer_parked, 0, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&m_mutex);
+    __atomic_add_fetch(&m_consumer_idle_ns, now_ns() - start_ns, __ATOMIC_RELAXED);
+  }
+
+  /** Wait until the queue is below its maximum depth, polling before parking.
+   */
+  void wait_for_space()
+  {
+    uint64_t start_ns = now_ns();
+    for (unsigned int poll = 0; poll < work_queue_spin_polls; poll++) {
+      cpu_relax();
+      if (size() < (int)max_depth()) {
+        __atomic_add_fetch(&m_producer_block_ns, now_ns() - start_ns, __ATOMIC_RELAXED);
+        return;
+      }
+    }
     pthread_mutex_lock(&m_mutex);
-    int size = m_queue.size();
+    __atomic_add_fetch(&m_producers_parked, 1, __ATOMIC_SEQ_CST);
+    while (size() >= (int)max_depth()) {
+      pthread_cond_wait(&m_not_full, &m_mutex);
+    }
+    __atomic_sub_fetch(&m_producers_parked, 1, __ATOMIC_RELAXED);
     pthread_mutex_unlock(&m_mutex);
-    return size;
+    __atomic_add_fetch(&m_producer_block_ns, now_ns() - start_ns, __ATOMIC_RELAXED);
+  }
+
+  /** Wake the consumer if it is parked waiting for items.
+   */
+  void wake_consumer()
+  {
+    // Order the add before checking whether the consumer is parked, which it sets before
+    // checking the queue, so that one of the two always sees the other
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&m_consumer_parked, __ATOMIC_RELAXED)) {
+      pthread_mutex_lock(&m_mutex);
+      pthread_cond_signal(&m_not_empty);
+      pthread_mutex_unlock(&m_mutex);
+    }
+  }
+
+  /** Wake any producers parked waiting for space in the queue.
+   */
+  void wake_producers()
+  {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&m_producers_parked, __ATOMIC_RELAXED)) {
+      pthread_mutex_lock(&m_mutex);
+      pthread_cond_broadcast(&m_not_full);
+      pthread_mutex_unlock(&m_mutex);
+    }
+  }
+
+  /** Record the current depth of the queue if it is the highest seen.
+   */
+  void update_high_water()
+  {
+    size_t depth = (size_t)size();
+    size_t high_water = __atomic_load_n(&m_high_water, __ATOMIC_RELAXED);
+    while ((depth > high_water) &&
+           !__atomic_compare_exchange_n(&m_high_water, &high_water, depth, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+  }
+
+  /** Pause briefly while polling the queue.
+   */
+  static void cpu_relax()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+  }
+
+  /** Return the current monotonic time.
+   *
+   * \return time in nanoseconds.
+   */
+  static uint64_t now_ns()
+  {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000) + now.tv_nsec;
   }
 
 };
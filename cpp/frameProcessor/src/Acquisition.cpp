@@ -125,14 +125,14 @@ ProcessFrameStatus Acquisition::process_frame(boost::shared_ptr<Frame> frame, HD
       file->write_frame(*frame, frame_offset_in_file, outer_chunk_dimension, call_durations);
 
       // Loops over all parameters, checking if there is a matching dataset and write to it if so
-      const std::map<std::string, boost::any> &frame_parameters = frame->get_meta_data().get_parameters();
-      std::map<std::string, boost::any>::const_iterator param_iter;
-      for (param_iter = frame_parameters.begin(); param_iter != frame_parameters.end(); ++param_iter) {
-        std::map<std::string, DatasetDefinition>::iterator dset_iter;
-        dset_iter = dataset_defs_.find(param_iter->first);
-        if (dset_iter != dataset_defs_.end())
+      const FrameMetaData &frame_meta_data = frame->get_meta_data();
+      for (size_t param_index = 0; param_index < frame_meta_data.get_parameter_count(); param_index++) {
+        MetaDataKey param_key = frame_meta_data.get_parameter_key(param_index);
+        std::map<MetaDataKey, DatasetDefinition*>::iterator dset_iter;
+        dset_iter = parameter_datasets_.find(param_key);
+        if (dset_iter != parameter_datasets_.end())
         {
-          file->write_parameter(*frame, dset_iter->second, frame_offset_in_file);
+          file->write_parameter(*frame, *dset_iter->second, param_key, frame_offset_in_file);
         }
       }
 
@@ -369,6 +369,13 @@ bool Acquisition::start_acquisition(
   file_extension_ = file_extension;
   master_frame_ = master_frame;
 
+  // Index the dataset definitions by the key of their name, to match them to frame parameters
+  parameter_datasets_.clear();
+  std::map<std::string, DatasetDefinition>::iterator dset_iter;
+  for (dset_iter = dataset_defs_.begin(); dset_iter != dataset_defs_.end(); ++dset_iter) {
+    parameter_datasets_[FrameMetaData::intern(dset_iter->first)] = &dset_iter->second;
+  }
+
   // Sanitise the file extension, ensuring there is a . at the start if the extension is not empty
   if (!file_extension_.empty())
   {
@@ -115,9 +115,12 @@ boost::shared_ptr<Frame> BloscPlugin::compress_frame(boost::shared_ptr<Frame> sr
   boost::shared_ptr<Frame> dest_frame = boost::shared_ptr<DataBlockFrame>(
           new DataBlockFrame(dest_meta_data, dest_data_size));
 
+  const char * p_compressor_name;
+  blosc_compcode_to_compname(c_settings.blosc_compressor, &p_compressor_name);
+
   std::stringstream ss_blosc_settings;
-  ss_blosc_settings << " compressor=" << blosc_get_compressor()
-                    << " threads=" << blosc_get_nthreads()
+  ss_blosc_settings << " compressor=" << p_compressor_name
+                    << " threads=" << c_settings.threads
                     << " clevel=" << c_settings.compression_level
                     << " doshuffle=" << c_settings.shuffle
                     << " typesize=" << c_settings.type_size
@@ -129,10 +132,13 @@ boost::shared_ptr<Frame> BloscPlugin::compress_frame(boost::shared_ptr<Frame> sr
                           << ss_blosc_settings.str()
                           << " src=" << src_data_ptr
                           << " dest=" << dest_frame->get_image_ptr());
-  compressed_size = blosc_compress(c_settings.compression_level, c_settings.shuffle,
-                                   c_settings.type_size,
-                                   c_settings.uncompressed_size, src_data_ptr,
-                                   dest_frame->get_image_ptr(), dest_data_size);
+  // Compress with a context of our own rather than the global blosc settings, so that replicas
+  // of this plugin can compress frames in parallel
+  compressed_size = blosc_compress_ctx(c_settings.compression_level, c_settings.shuffle,
+                                       c_settings.type_size,
+                                       c_settings.uncompressed_size, src_data_ptr,
+                                       dest_frame->get_image_ptr(), dest_data_size,
+                                       p_compressor_name, 0, c_settings.threads);
   if (compressed_size < 0) {
     std::stringstream ss;
     ss << "blosc_compress failed. error=" << compressed_size << ss_blosc_settings.str();
@@ -154,6 +160,19 @@ boost::shared_ptr<Frame> BloscPlugin::compress_frame(boost::shared_ptr<Frame> sr
   return dest_frame;
 }
 
+/**
+ * Return whether this plugin supports replicas.
+ *
+ * Each frame is compressed independently with its own blosc context, so replicas may
+ * compress frames in parallel.
+ *
+ * @return true
+ */
+bool BloscPlugin::supports_replicas() const
+{
+  return true;
+}
+
 /**
  * Update the compression settings
  */
@@ -167,19 +186,17 @@ void BloscPlugin::update_compression_settings()
   LOG4CXX_DEBUG_LEVEL(1, logger_, "Blosc compression settings: "
                                   << " acquisition=\"" << this->current_acquisition_ << "\""
                                   << " compressor=" << p_compressor_name
-                                  << " threads=" << blosc_get_nthreads()
+                                  << " threads=" << this->compression_settings_.threads
                                   << " clevel=" << this->compression_settings_.compression_level
                                   << " doshuffle=" << this->compression_settings_.shuffle
                                   << " typesize=" << this->compression_settings_.type_size
                                   << " nbytes=" << this->compression_settings_.uncompressed_size);
-  ret = blosc_set_compressor(p_compressor_name);
   if (ret < 0) {
     LOG4CXX_ERROR(logger_, "Blosc failed to set compressor: "
         << " " << this->compression_settings_.blosc_compressor
-        << " " << *p_compressor_name);
+        << " " << p_compressor_name);
     throw std::runtime_error("Blosc failed to set compressor");
   }
-  blosc_set_nthreads(this->compression_settings_.threads);
 }
 
   /** Return data buffer
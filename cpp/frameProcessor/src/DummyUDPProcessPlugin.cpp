@@ -5,6 +5,8 @@
  *      Author: Tim Nicholls, STFC Detector Systems Software Group
  */
 
+#include <algorithm>
+
 #include "DummyUDPProcessPlugin.h"
 #include "version.h"
 
@@ -284,8 +286,7 @@ namespace FrameProcessor
    */
   void DummyUDPProcessPlugin::process_lost_packets(boost::shared_ptr<Frame>& frame)
   {
-    const DummyUDP::FrameHeader* hdr_ptr = 
-      static_cast<const DummyUDP::FrameHeader*>(frame->get_data_ptr());
+    DummyUDP::FrameHeader* hdr_ptr = static_cast<DummyUDP::FrameHeader*>(frame->get_data_ptr());
 
     // Process lost packets if frame header reports any missing
     int hdr_packets_lost = (hdr_ptr->total_packets_expected - hdr_ptr->total_packets_received);
@@ -295,21 +296,14 @@ namespace FrameProcessor
       LOG4CXX_DEBUG(logger_,  "Processing " << hdr_packets_lost 
         << " lost packets for frame " << hdr_ptr->frame_number);
 
-      int packets_lost = 0;
       char* payload_ptr = static_cast<char*>(frame->get_data_ptr()) + sizeof(DummyUDP::FrameHeader);
 
-      // Loop over all packets in frame
-      for (int packet_idx = 0; packet_idx <  hdr_ptr->total_packets_expected; packet_idx++)
-      {
-        // If header reports packet missing, zero out the packet
-        if (hdr_ptr->packet_state[packet_idx] == 0)
-        {
-          LOG4CXX_DEBUG(logger_, "Missing packet number " << packet_idx);
-          char* packet_ptr = payload_ptr + (hdr_ptr->packet_size * packet_idx);
-          memset(packet_ptr, 0, hdr_ptr->packet_size);
-          packets_lost++;
-        }
-      }
+      // Zero out each range of packets the header reports missing
+      OdinData::PacketStateBitmap packet_state(hdr_ptr->packet_state,
+        std::min<std::size_t>(hdr_ptr->total_packets_expected, DummyUDP::max_packets));
+      int packets_lost = static_cast<int>(
+        missing_packet_fill_.fill(packet_state, payload_ptr, hdr_ptr->packet_size));
+
       // Check if there's a mismatch between packets reported lost by the header and found
       // by scanning the packet state information.
       if (packets_lost != hdr_packets_lost)
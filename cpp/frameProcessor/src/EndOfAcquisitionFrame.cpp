@@ -3,9 +3,12 @@
 namespace FrameProcessor {
 
 /** EndOfAcquisitionFrame constructor
+ *
+ * The frame is given default meta data, rather than a copy of its own meta data
+ * before it is constructed.
  */
 EndOfAcquisitionFrame::EndOfAcquisitionFrame() :
-    Frame(meta_data_, 0, 0)
+    Frame(FrameMetaData(), 0, 0)
 {
 }
 
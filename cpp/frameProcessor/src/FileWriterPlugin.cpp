@@ -14,6 +14,7 @@
 
 #include "logging.h"
 #include "DebugLevelLogger.h"
+#include "ThreadPlacement.h"
 #include "version.h"
 
 #ifdef BOOST_HAS_PLACEHOLDERS
@@ -916,6 +917,7 @@ void FileWriterPlugin::start_close_file_timeout()
 void FileWriterPlugin::run_close_file_timeout()
 {
   OdinData::configure_logging_mdc(OdinData::app_path.c_str());
+  std::string placement_name = OdinData::ThreadPlacement::Instance().register_thread("file_close_timeout");
   boost::mutex::scoped_lock startLock(start_timeout_mutex_);
   while (timeout_thread_running_) {
     start_condition_.wait(startLock);
@@ -938,6 +940,7 @@ void FileWriterPlugin::run_close_file_timeout()
       }
     }
   }
+  OdinData::ThreadPlacement::Instance().unregister_thread(placement_name);
 }
 
 /**
@@ -3,6 +3,8 @@
 
 namespace FrameProcessor {
 
+    log4cxx::LoggerPtr Frame::logger_(log4cxx::Logger::getLogger("FP.Frame"));
+
 /** Base Frame constructor
  *
  * @param meta-data - frame FrameMetaData
@@ -13,8 +15,7 @@ namespace FrameProcessor {
             data_size_(data_size),
             image_offset_(image_offset),
             image_size_(data_size-image_offset),
-            outer_chunk_size_(1),
-            logger_(log4cxx::Logger::getLogger("FP.Frame")) {
+            outer_chunk_size_(1) {
     }
 
 /** Copy constructor;
@@ -25,7 +26,6 @@ namespace FrameProcessor {
       meta_data_ = frame.meta_data_;
       image_offset_ = frame.image_offset_;
       outer_chunk_size_ = frame.outer_chunk_size_;
-      logger_ = frame.logger_;
     }
 
 /** Assignment operator;
@@ -37,7 +37,6 @@ namespace FrameProcessor {
       meta_data_ = frame.meta_data_;
       image_offset_ = frame.image_offset_;
       outer_chunk_size_ = frame.outer_chunk_size_;
-      logger_ = frame.logger_;
       return *this;
     }
 
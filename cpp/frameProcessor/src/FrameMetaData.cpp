@@ -1,7 +1,90 @@
 #include "FrameMetaData.h"
 
+#include <boost/thread/mutex.hpp>
+
 namespace FrameProcessor {
 
+    /** Number of keys in each chunk of the key table */
+    static const size_t key_chunk_size = 1024;
+
+    /** Maximum number of chunks in the key table */
+    static const size_t max_key_chunks = 1024;
+
+    /** Table of the names interned as keys.
+     *
+     * Names are never removed, so that the name of a key can be read without locking. Names are
+     * held in fixed size chunks which are never moved, and a chunk is published only once the
+     * name it holds has been written.
+     */
+    struct KeyTable {
+      KeyTable() : num_keys(0) {
+        std::memset(chunks, 0, sizeof(chunks));
+        chunks[0] = new std::string[key_chunk_size];
+        keys[""] = FrameMetaData::empty_key;
+        num_keys = 1;
+      }
+      /** Mutex serialising the interning of names */
+      boost::mutex mutex;
+      /** Map of keys, indexed by name */
+      std::map<std::string, MetaDataKey> keys;
+      /** Chunks of names, indexed by key */
+      std::string *chunks[max_key_chunks];
+      /** Number of keys interned */
+      size_t num_keys;
+    };
+
+    /** Number of recently set acquisition IDs whose strings are shared by new frames */
+    static const size_t acquisition_cache_size = 16;
+
+    /** Cache of the acquisition IDs recently set on frames.
+     *
+     * Frames of the same acquisition share one copy of its ID, so that setting it does not
+     * allocate. The cache is bounded, dropping the least recently added ID when full; IDs still
+     * held by frames stay alive until the last of those frames is destroyed.
+     */
+    struct AcquisitionCache {
+      AcquisitionCache() : next(0), ids(acquisition_cache_size) {}
+      /** Mutex serialising access to the cache */
+      boost::mutex mutex;
+      /** Index of the entry to replace next */
+      size_t next;
+      /** Cached acquisition IDs */
+      std::vector<boost::shared_ptr<const std::string> > ids;
+    };
+
+    /** Return the shared copy of an acquisition ID, adding it to the cache if not present.
+     * @param std::string acquisition_ID - acquisition ID
+     * @return shared copy of the acquisition ID, null for an empty ID
+     */
+    static boost::shared_ptr<const std::string> share_acquisition_ID(const std::string &acquisition_ID) {
+      if (acquisition_ID.empty()) {
+        return boost::shared_ptr<const std::string>();
+      }
+      static AcquisitionCache cache;
+      boost::mutex::scoped_lock lock(cache.mutex);
+      for (size_t index = 0; index < cache.ids.size(); index++) {
+        if (cache.ids[index] && (*cache.ids[index] == acquisition_ID)) {
+          return cache.ids[index];
+        }
+      }
+      boost::shared_ptr<const std::string> shared_ID(new std::string(acquisition_ID));
+      cache.ids[cache.next] = shared_ID;
+      cache.next = (cache.next + 1) % cache.ids.size();
+      return shared_ID;
+    }
+
+    /** Return the table of interned names.
+     * @return KeyTable - table of interned names
+     */
+    static KeyTable &key_table() {
+      static KeyTable table;
+      return table;
+    }
+
+    const MetaDataKey FrameMetaData::empty_key;
+
+    log4cxx::LoggerPtr FrameMetaData::logger(log4cxx::Logger::getLogger("FP.FrameMetaData"));
+
     FrameMetaData::FrameMetaData(const long long& frame_number,
                                    const std::string &dataset_name,
                                    const DataType &data_type,
@@ -9,42 +92,132 @@ namespace FrameProcessor {
                                    const std::vector<unsigned long long> &dimensions,
                                    const CompressionType &compression_type) :
             frame_number_(frame_number),
-            dataset_name_(dataset_name),
+            dataset_key_(intern(dataset_name)),
+            data_type_(data_type),
+            acquisition_ID_(share_acquisition_ID(acquisition_ID)),
+            dimensions_(dimensions),
+            compression_type_(compression_type),
+            frame_offset_(0) {
+    }
+
+    FrameMetaData::FrameMetaData(const long long& frame_number,
+                                   MetaDataKey dataset_key,
+                                   const DataType &data_type,
+                                   const std::string &acquisition_ID,
+                                   const std::vector<unsigned long long> &dimensions,
+                                   const CompressionType &compression_type) :
+            frame_number_(frame_number),
+            dataset_key_(dataset_key),
             data_type_(data_type),
-            acquisition_ID_(acquisition_ID),
+            acquisition_ID_(share_acquisition_ID(acquisition_ID)),
             dimensions_(dimensions),
             compression_type_(compression_type),
-            frame_offset_(0),
-            logger(log4cxx::Logger::getLogger("FP.FrameMetaData")) {
+            frame_offset_(0) {
     }
 
     FrameMetaData::FrameMetaData() :
             frame_number_(-1),
-            dataset_name_(""),
+            dataset_key_(empty_key),
             data_type_(raw_unknown),
             compression_type_(unknown_compression),
-            frame_offset_(0),
-            logger(log4cxx::Logger::getLogger("FP.FrameMetaData")) {
+            frame_offset_(0) {
     }
 
-    FrameMetaData::FrameMetaData(const FrameMetaData &frame) {
-      frame_number_ = frame.frame_number_;
-      dataset_name_ = frame.dataset_name_;
-      data_type_ = frame.data_type_;
-      acquisition_ID_ = frame.acquisition_ID_;
-      dimensions_ = frame.dimensions_;
-      compression_type_ = frame.compression_type_;
-      parameters_ = frame.parameters_;
-      frame_offset_ = frame.frame_offset_;
-      logger = frame.logger;
+    FrameMetaData::FrameMetaData(const FrameMetaData &frame) :
+            frame_number_(frame.frame_number_),
+            dataset_key_(frame.dataset_key_),
+            data_type_(frame.data_type_),
+            acquisition_ID_(frame.acquisition_ID_),
+            dimensions_(frame.dimensions_),
+            compression_type_(frame.compression_type_),
+            parameters_(frame.parameters_),
+            frame_offset_(frame.frame_offset_) {
+    }
+
+    /** Return the key of a name, interning it if it has not been seen before
+     * @param std::string name - dataset name or parameter name
+     * @return MetaDataKey - key of the name
+     */
+    MetaDataKey FrameMetaData::intern(const std::string &name) {
+      KeyTable &table = key_table();
+      boost::mutex::scoped_lock lock(table.mutex);
+      std::map<std::string, MetaDataKey>::const_iterator iter = table.keys.find(name);
+      if (iter != table.keys.end()) {
+        return iter->second;
+      }
+      size_t chunk = table.num_keys / key_chunk_size;
+      if (chunk >= max_key_chunks) {
+        LOG4CXX_ERROR(logger, "Unable to intern frame meta data name: " + name);
+        throw std::runtime_error("Too many frame meta data names");
+      }
+      std::string *names = table.chunks[chunk];
+      if (names == 0) {
+        names = new std::string[key_chunk_size];
+      }
+      MetaDataKey key = static_cast<MetaDataKey>(table.num_keys);
+      names[key % key_chunk_size] = name;
+      __atomic_store_n(&table.chunks[chunk], names, __ATOMIC_RELEASE);
+      table.keys[name] = key;
+      table.num_keys++;
+      return key;
+    }
+
+    /** Find the key of a name, without interning it
+     * @param std::string name - dataset name or parameter name
+     * @param MetaDataKey key - key of the name, if found
+     * @return bool - whether the name has been interned
+     */
+    bool FrameMetaData::find_key(const std::string &name, MetaDataKey &key) {
+      KeyTable &table = key_table();
+      boost::mutex::scoped_lock lock(table.mutex);
+      std::map<std::string, MetaDataKey>::const_iterator iter = table.keys.find(name);
+      if (iter == table.keys.end()) {
+        return false;
+      }
+      key = iter->second;
+      return true;
+    }
+
+    /** Return the name of a key
+     * @param MetaDataKey key - key returned by intern
+     * @return std::string - name of the key
+     */
+    const std::string &FrameMetaData::key_name(MetaDataKey key) {
+      const std::string *names = 0;
+      if (key / key_chunk_size < max_key_chunks) {
+        names = __atomic_load_n(&key_table().chunks[key / key_chunk_size], __ATOMIC_ACQUIRE);
+      }
+      if (names == 0) {
+        throw std::runtime_error("Unknown frame meta data key");
+      }
+      return names[key % key_chunk_size];
     }
 
     /** Get frame parameters
      * @return std::map <std::string, boost::any>  map
      */
-    const std::map <std::string, boost::any> &FrameMetaData::get_parameters() const {
-      return this->parameters_;
-    };
+    std::map <std::string, boost::any> FrameMetaData::get_parameters() const {
+      std::map <std::string, boost::any> parameters;
+      for (size_t index = 0; index < parameters_.size(); index++) {
+        parameters[key_name(parameters_[index].key)] = parameters_[index].to_any(parameters_[index]);
+      }
+      return parameters;
+    }
+
+    /** Return the number of frame parameters
+     * @return size_t - number of parameters
+     */
+    size_t FrameMetaData::get_parameter_count() const {
+      return parameters_.size();
+    }
+
+    /** Return the key of a frame parameter by position
+     * @param size_t index - position of the parameter, less than the number of parameters
+     * @return MetaDataKey - key of the parameter name
+     */
+    MetaDataKey FrameMetaData::get_parameter_key(size_t index) const {
+      return parameters_.at(index).key;
+    }
 
     /** Return frame number
      * @return long long - frame number
@@ -64,14 +237,28 @@ namespace FrameProcessor {
      * @return std::string - dataset name
      */
     const std::string &FrameMetaData::get_dataset_name() const {
-      return this->dataset_name_;
+      return key_name(this->dataset_key_);
     }
 
     /** Set dataset name
      * @param std::string dataset_name - name of dataset
      */
     void FrameMetaData::set_dataset_name(const std::string &dataset_name) {
-      this->dataset_name_ = dataset_name;
+      this->dataset_key_ = intern(dataset_name);
+    }
+
+    /** Return dataset key
+     * @return MetaDataKey - key of the dataset name
+     */
+    MetaDataKey FrameMetaData::get_dataset_key() const {
+      return this->dataset_key_;
+    }
+
+    /** Set dataset key
+     * @param MetaDataKey dataset_key - key of the dataset name
+     */
+    void FrameMetaData::set_dataset_key(MetaDataKey dataset_key) {
+      this->dataset_key_ = dataset_key;
     }
 
     /** Return data type
@@ -92,14 +279,14 @@ namespace FrameProcessor {
      * @return std::string acquisition ID
      */
     const std::string &FrameMetaData::get_acquisition_ID() const {
-      return this->acquisition_ID_;
+      return this->acquisition_ID_ ? *this->acquisition_ID_ : key_name(empty_key);
     }
 
     /** Set acquisition ID
      * @param std::string acquisition_ID
      */
     void FrameMetaData::set_acquisition_ID(const std::string &acquisition_ID) {
-      this->acquisition_ID_ = acquisition_ID;
+      this->acquisition_ID_ = share_acquisition_ID(acquisition_ID);
     }
 
     /** Return dimensions
@@ -23,10 +23,17 @@ const std::string FrameProcessorController::CONFIG_DEBUG                 = "debu
 const std::string FrameProcessorController::CONFIG_FR_RELEASE            = "fr_release_cnxn";
 const std::string FrameProcessorController::CONFIG_FR_READY              = "fr_ready_cnxn";
 const std::string FrameProcessorController::CONFIG_FR_SETUP              = "fr_setup";
+const std::string FrameProcessorController::CONFIG_FR_RELEASE_BATCH_SIZE = "fr_release_batch_size";
+const std::string FrameProcessorController::CONFIG_FR_RELEASE_BATCH_TIMEOUT = "fr_release_batch_timeout_ms";
+const std::string FrameProcessorController::CONFIG_FR_READY_BATCH_SIZE   = "fr_ready_batch_size";
+const std::string FrameProcessorController::CONFIG_FR_READY_BATCH_TIMEOUT = "fr_ready_batch_timeout_ms";
 
 const std::string FrameProcessorController::CONFIG_CTRL_ENDPOINT         = "ctrl_endpoint";
 const std::string FrameProcessorController::CONFIG_META_ENDPOINT         = "meta_endpoint";
 
+const std::string FrameProcessorController::CONFIG_THREAD_PLACEMENT      = "thread_placement";
+const std::string FrameProcessorController::CONFIG_SCHEDULER_THREADS     = "scheduler_threads";
+
 const std::string FrameProcessorController::CONFIG_PLUGIN                = "plugin";
 const std::string FrameProcessorController::CONFIG_PLUGIN_LOAD           = "load";
 const std::string FrameProcessorController::CONFIG_PLUGIN_CONNECT        = "connect";
@@ -36,6 +43,11 @@ const std::string FrameProcessorController::CONFIG_PLUGIN_NAME           = "name
 const std::string FrameProcessorController::CONFIG_PLUGIN_INDEX          = "index";
 const std::string FrameProcessorController::CONFIG_PLUGIN_LIBRARY        = "library";
 const std::string FrameProcessorController::CONFIG_PLUGIN_CONNECTION     = "connection";
+const std::string FrameProcessorController::CONFIG_PLUGIN_QUEUE_DEPTH    = "queue_depth";
+const std::string FrameProcessorController::CONFIG_PLUGIN_BATCH_SIZE     = "batch_size";
+const std::string FrameProcessorController::CONFIG_PLUGIN_REPLICAS       = "replicas";
+const std::string FrameProcessorController::CONFIG_PLUGIN_DISPATCH       = "dispatch";
+const std::string FrameProcessorController::CONFIG_PLUGIN_REORDER_TIMEOUT = "reorder_timeout_ms";
 
 const std::string FrameProcessorController::CONFIG_STORE                 = "store";
 const std::string FrameProcessorController::CONFIG_EXECUTE               = "execute";
@@ -67,13 +79,20 @@ FrameProcessorController::FrameProcessorController(unsigned int num_io_threads)
     metaTxChannelEndpoint_(""),
     metaTxChannel_(ZMQ_PUB),
     frReadyEndpoint_(OdinData::Defaults::default_frame_ready_endpoint),
-    frReleaseEndpoint_(OdinData::Defaults::default_frame_release_endpoint)
+    frReleaseEndpoint_(OdinData::Defaults::default_frame_release_endpoint),
+    frReleaseBatchSize_(OdinData::Defaults::default_frame_release_batch_size),
+    frReleaseBatchTimeoutMs_(OdinData::Defaults::default_frame_release_batch_timeout_ms),
+    frReadyBatchSize_(OdinData::Defaults::default_frame_ready_batch_size),
+    frReadyBatchTimeoutMs_(OdinData::Defaults::default_frame_ready_batch_timeout_ms)
 {
   OdinData::configure_logging_mdc(OdinData::app_path.c_str());
   LOG4CXX_DEBUG_LEVEL(1, logger_, "Constructing FrameProcessorController");
 
   totalFrames = 0;
 
+  // Register the thread constructing the controller for placement
+  mainThreadName_ = OdinData::ThreadPlacement::Instance().register_thread("main");
+
   // Wait for the thread service to initialise and be running properly, so that
   // this constructor only returns once the object is fully initialised (RAII).
   // Monitor the thread error flag and throw an exception if initialisation fails
@@ -97,6 +116,7 @@ FrameProcessorController::~FrameProcessorController()
 {
   // Make sure we shutdown cleanly if an exception was thrown
   shutdown();
+  OdinData::ThreadPlacement::Instance().unregister_thread(mainThreadName_);
 }
 
 /** Handle an incoming configuration message.
@@ -306,12 +326,18 @@ void FrameProcessorController::provideStatus(OdinData::IpcMessage& reply)
     iter->second->status(reply);
     // Add performance statistics
     iter->second->add_performance_stats(reply);
-    // Read error level
-    std::vector<std::string> plugin_errors = iter->second->get_errors();
-    error_messages.insert(error_messages.end(), plugin_errors.begin(), plugin_errors.end());
-    // Read warning level
-    std::vector<std::string> plugin_warnings = iter->second->get_warnings();
-    warning_messages.insert(warning_messages.end(), plugin_warnings.begin(), plugin_warnings.end());
+    // Add replica statistics for a plugin loaded as several replicas
+    if (replica_sets_.count(iter->first) > 0) {
+      replica_sets_[iter->first]->status(reply);
+    }
+    // Read error and warning levels from each replica
+    std::vector<boost::shared_ptr<FrameProcessorPlugin> > replicas = this->getReplicas(iter->first);
+    for (size_t replica = 0; replica < replicas.size(); replica++) {
+      std::vector<std::string> plugin_errors = replicas[replica]->get_errors();
+      error_messages.insert(error_messages.end(), plugin_errors.begin(), plugin_errors.end());
+      std::vector<std::string> plugin_warnings = replicas[replica]->get_warnings();
+      warning_messages.insert(warning_messages.end(), plugin_warnings.begin(), plugin_warnings.end());
+    }
   }
   std::vector<std::string>::iterator error_iter;
   for (error_iter = error_messages.begin(); error_iter != error_messages.end(); ++error_iter) {
@@ -322,6 +348,13 @@ void FrameProcessorController::provideStatus(OdinData::IpcMessage& reply)
     reply.set_param("warning[]", *warning_iter);
   }
 
+  // Report the placement applied to each thread
+  OdinData::ThreadPlacement::Instance().status(FrameProcessorController::CONFIG_THREAD_PLACEMENT + "/", reply);
+
+  // Report the activity of the plugin scheduler
+  if (scheduler_) {
+    scheduler_->status("scheduler/", reply);
+  }
 }
 
 /** Provide version information to requesting clients.
@@ -373,6 +406,17 @@ void FrameProcessorController::configure(OdinData::IpcMessage& config, OdinData:
 {
   LOG4CXX_DEBUG_LEVEL(1, logger_, "Configuration submitted: " << config.encode());
 
+  // Check for thread placement, applied first so that any threads started by this
+  // configuration are placed as they start
+  if (config.has_param(FrameProcessorController::CONFIG_THREAD_PLACEMENT)) {
+    this->configureThreadPlacement(config);
+  }
+
+  // Check for the plugin scheduler, which must be configured before any plugins are loaded
+  if (config.has_param(FrameProcessorController::CONFIG_SCHEDULER_THREADS)) {
+    this->configureScheduler(config.get_param<unsigned int>(FrameProcessorController::CONFIG_SCHEDULER_THREADS));
+  }
+
   // Check if we are being given the master frame specifier
   if (config.has_param("hdf/master")) {
     masterFrame = config.get_param<std::string>("hdf/master");
@@ -383,7 +427,10 @@ void FrameProcessorController::configure(OdinData::IpcMessage& config, OdinData:
   if (config.has_param("clear_errors")) {
     std::map<std::string, boost::shared_ptr<FrameProcessorPlugin> >::iterator iter;
     for (iter = plugins_.begin(); iter != plugins_.end(); ++iter) {
-      iter->second->clear_errors();
+      std::vector<boost::shared_ptr<FrameProcessorPlugin> > replicas = this->getReplicas(iter->first);
+      for (size_t replica = 0; replica < replicas.size(); replica++) {
+        replicas[replica]->clear_errors();
+      }
     }
   }
 
@@ -432,6 +479,30 @@ void FrameProcessorController::configure(OdinData::IpcMessage& config, OdinData:
       std::string subString = frConfig.get_param<std::string>(FrameProcessorController::CONFIG_FR_READY);
       this->setupFrameReceiverInterface(pubString, subString);
     }
+    if (frConfig.has_param(FrameProcessorController::CONFIG_FR_RELEASE_BATCH_SIZE) ||
+        frConfig.has_param(FrameProcessorController::CONFIG_FR_RELEASE_BATCH_TIMEOUT)) {
+      frReleaseBatchSize_ = frConfig.get_param<unsigned int>(
+          FrameProcessorController::CONFIG_FR_RELEASE_BATCH_SIZE, frReleaseBatchSize_);
+      frReleaseBatchTimeoutMs_ = frConfig.get_param<unsigned int>(
+          FrameProcessorController::CONFIG_FR_RELEASE_BATCH_TIMEOUT, frReleaseBatchTimeoutMs_);
+      if (sharedMemController_) {
+        sharedMemController_->setReleaseBatching(frReleaseBatchSize_, frReleaseBatchTimeoutMs_);
+      }
+    }
+    if (frConfig.has_param(FrameProcessorController::CONFIG_FR_READY_BATCH_SIZE) ||
+        frConfig.has_param(FrameProcessorController::CONFIG_FR_READY_BATCH_TIMEOUT)) {
+      unsigned int batch_size = frConfig.get_param<unsigned int>(
+          FrameProcessorController::CONFIG_FR_READY_BATCH_SIZE, frReadyBatchSize_);
+      if (batch_size == 0) {
+        throw std::runtime_error("Frame ready batch size must be greater than zero");
+      }
+      frReadyBatchSize_ = batch_size;
+      frReadyBatchTimeoutMs_ = frConfig.get_param<unsigned int>(
+          FrameProcessorController::CONFIG_FR_READY_BATCH_TIMEOUT, frReadyBatchTimeoutMs_);
+      if (sharedMemController_) {
+        sharedMemController_->setReadyBatching(frReadyBatchSize_, frReadyBatchTimeoutMs_);
+      }
+    }
   }
 
   // Check if we are being asked to store a configuration object
@@ -494,6 +565,12 @@ void FrameProcessorController::configure(OdinData::IpcMessage& config, OdinData:
                                      config.get_msg_type(),
                                      config.get_msg_val());
       iter->second->configure(subConfig, reply);
+      // Give any other replicas the same configuration, replying for the first only
+      std::vector<boost::shared_ptr<FrameProcessorPlugin> > replicas = this->getReplicas(iter->first);
+      for (size_t replica = 1; replica < replicas.size(); replica++) {
+        OdinData::IpcMessage replica_reply;
+        replicas[replica]->configure(subConfig, replica_reply);
+      }
     }
   }
 }
@@ -516,6 +593,13 @@ void FrameProcessorController::requestConfiguration(OdinData::IpcMessage& reply)
   std::string fr_cnxn_str = FrameProcessorController::CONFIG_FR_SETUP + "/";
   reply.set_param(fr_cnxn_str + FrameProcessorController::CONFIG_FR_READY, frReadyEndpoint_);
   reply.set_param(fr_cnxn_str + FrameProcessorController::CONFIG_FR_RELEASE, frReleaseEndpoint_);
+  reply.set_param(fr_cnxn_str + FrameProcessorController::CONFIG_FR_RELEASE_BATCH_SIZE, frReleaseBatchSize_);
+  reply.set_param(fr_cnxn_str + FrameProcessorController::CONFIG_FR_RELEASE_BATCH_TIMEOUT, frReleaseBatchTimeoutMs_);
+  reply.set_param(fr_cnxn_str + FrameProcessorController::CONFIG_FR_READY_BATCH_SIZE, frReadyBatchSize_);
+  reply.set_param(fr_cnxn_str + FrameProcessorController::CONFIG_FR_READY_BATCH_TIMEOUT, frReadyBatchTimeoutMs_);
+  OdinData::ThreadPlacement::Instance().configuration(FrameProcessorController::CONFIG_THREAD_PLACEMENT + "/", reply);
+  reply.set_param(FrameProcessorController::CONFIG_SCHEDULER_THREADS,
+                  scheduler_ ? scheduler_->get_num_threads() : 0);
 
   // Loop over plugins and request current configuration from each
   std::map<std::string, boost::shared_ptr<FrameProcessorPlugin> >::iterator iter;
@@ -556,6 +640,11 @@ void FrameProcessorController::execute(OdinData::IpcMessage& config, OdinData::I
         // Extract the command and execute on the plugin
         std::string commandName = subConfig.get_param<std::string>(FrameProcessorController::COMMAND_KEY);
         iter->second->execute(commandName, reply);
+        std::vector<boost::shared_ptr<FrameProcessorPlugin> > replicas = this->getReplicas(iter->first);
+        for (size_t replica = 1; replica < replicas.size(); replica++) {
+          OdinData::IpcMessage replica_reply;
+          replicas[replica]->execute(commandName, replica_reply);
+        }
       }
     }
   }
@@ -605,8 +694,15 @@ void FrameProcessorController::resetStatistics(OdinData::IpcMessage& reply)
   // Loop over plugins and call reset statistics on each
   std::map<std::string, boost::shared_ptr<FrameProcessorPlugin> >::iterator iter;
   for (iter = plugins_.begin(); iter != plugins_.end(); ++iter) {
-    iter->second->reset_performance_stats();
-    reset_ok = iter->second->reset_statistics();
+    reset_ok = true;
+    std::vector<boost::shared_ptr<FrameProcessorPlugin> > replicas = this->getReplicas(iter->first);
+    for (size_t replica = 0; replica < replicas.size(); replica++) {
+      replicas[replica]->reset_performance_stats();
+      reset_ok = replicas[replica]->reset_statistics() && reset_ok;
+    }
+    if (replica_sets_.count(iter->first) > 0) {
+      replica_sets_[iter->first]->reset_statistics();
+    }
     // Check for failure
     if (!reset_ok){
       reply.set_msg_type(OdinData::IpcMessage::MsgTypeNack);
@@ -625,9 +721,12 @@ void FrameProcessorController::resetStatistics(OdinData::IpcMessage& reply)
  * are searched for:
  * CONFIG_PLUGIN_LIST - Replies with a list of loaded plugins
  * CONFIG_PLUGIN_LOAD - Uses NAME, INDEX and LIBRARY to load a plugin
- * into the controller.
+ * into the controller, and optionally REPLICAS and DISPATCH to load it as
+ * several replicas processing frames in parallel.
  * CONFIG_PLUGIN_CONNECT - Uses CONNECTION and INDEX to connect one
- * plugin input to another plugin output.
+ * plugin input to another plugin output, and optionally QUEUE_DEPTH to
+ * set the maximum depth of the input queue of the plugin and BATCH_SIZE
+ * to set the maximum number of frames it processes together.
  * CONFIG_PLUGIN_DISCONNECT - Uses CONNECTION and INDEX to disconnect
  * one plugin from another.
  *
@@ -645,7 +744,19 @@ void FrameProcessorController::configurePlugin(OdinData::IpcMessage& config, Odi
       std::string index = pluginConfig.get_param<std::string>(FrameProcessorController::CONFIG_PLUGIN_INDEX);
       std::string name = pluginConfig.get_param<std::string>(FrameProcessorController::CONFIG_PLUGIN_NAME);
       std::string library = pluginConfig.get_param<std::string>(FrameProcessorController::CONFIG_PLUGIN_LIBRARY);
-      this->loadPlugin(index, name, library);
+      unsigned int replicas = 1;
+      if (pluginConfig.has_param(FrameProcessorController::CONFIG_PLUGIN_REPLICAS)) {
+        replicas = pluginConfig.get_param<unsigned int>(FrameProcessorController::CONFIG_PLUGIN_REPLICAS);
+      }
+      std::string dispatch = "round_robin";
+      if (pluginConfig.has_param(FrameProcessorController::CONFIG_PLUGIN_DISPATCH)) {
+        dispatch = pluginConfig.get_param<std::string>(FrameProcessorController::CONFIG_PLUGIN_DISPATCH);
+      }
+      unsigned int reorder_timeout_ms = PluginReplicaSet::default_reorder_timeout_ms;
+      if (pluginConfig.has_param(FrameProcessorController::CONFIG_PLUGIN_REORDER_TIMEOUT)) {
+        reorder_timeout_ms = pluginConfig.get_param<unsigned int>(FrameProcessorController::CONFIG_PLUGIN_REORDER_TIMEOUT);
+      }
+      this->loadPlugin(index, name, library, replicas, dispatch, reorder_timeout_ms);
     }
   }
 
@@ -657,6 +768,28 @@ void FrameProcessorController::configurePlugin(OdinData::IpcMessage& config, Odi
       std::string index = pluginConfig.get_param<std::string>(FrameProcessorController::CONFIG_PLUGIN_INDEX);
       std::string cnxn = pluginConfig.get_param<std::string>(FrameProcessorController::CONFIG_PLUGIN_CONNECTION);
       this->connectPlugin(index, cnxn);
+      if (pluginConfig.has_param(FrameProcessorController::CONFIG_PLUGIN_QUEUE_DEPTH)) {
+        int depth = pluginConfig.get_param<int>(FrameProcessorController::CONFIG_PLUGIN_QUEUE_DEPTH);
+        if (depth <= 0) {
+          throw std::runtime_error("Plugin queue depth must be greater than zero");
+        }
+        std::vector<boost::shared_ptr<FrameProcessorPlugin> > replicas = this->getReplicas(index);
+        for (size_t replica = 0; replica < replicas.size(); replica++) {
+          replicas[replica]->getWorkQueue()->set_max_depth(depth);
+        }
+        LOG4CXX_INFO(logger_, "Set queue depth of plugin " << index << " to " << depth);
+      }
+      if (pluginConfig.has_param(FrameProcessorController::CONFIG_PLUGIN_BATCH_SIZE)) {
+        int batch_size = pluginConfig.get_param<int>(FrameProcessorController::CONFIG_PLUGIN_BATCH_SIZE);
+        if (batch_size <= 0) {
+          throw std::runtime_error("Plugin batch size must be greater than zero");
+        }
+        std::vector<boost::shared_ptr<FrameProcessorPlugin> > replicas = this->getReplicas(index);
+        for (size_t replica = 0; replica < replicas.size(); replica++) {
+          replicas[replica]->setBatchSize(batch_size);
+        }
+        LOG4CXX_INFO(logger_, "Set batch size of plugin " << index << " to " << batch_size);
+      }
     }
   }
 
@@ -694,18 +827,38 @@ void FrameProcessorController::configurePlugin(OdinData::IpcMessage& config, Odi
  * has been loaded it's processing thread is started. The same plugin type can
  * be loaded multiple times as long as each index is unique.
  *
+ * A plugin that supports replicas can be loaded as several instances sharing the
+ * index, which process frames in parallel and are given the same configuration.
+ * The instances are gathered into a PluginReplicaSet, which takes the place of the
+ * plugin when connecting plugins and puts the frames pushed on back in order.
+ *
  * \param[in] index - Unique index required for the plugin.
  * \param[in] name - Name of the plugin class.
  * \param[in] library - Full path of shared library file for the plugin.
+ * \param[in] replicas - Number of replicas of the plugin to load.
+ * \param[in] dispatch - How frames are dispatched to the replicas, "round_robin" or "least_loaded".
+ * \param[in] reorder_timeout_ms - Time after which the replicas give up on a frame holding up later frames.
  */
-void FrameProcessorController::loadPlugin(const std::string& index, const std::string& name, const std::string& library)
+void FrameProcessorController::loadPlugin(const std::string& index, const std::string& name, const std::string& library,
+                                          unsigned int replicas, const std::string& dispatch,
+                                          unsigned int reorder_timeout_ms)
 {
   // Verify a plugin of the same name doesn't already exist
   if (plugins_.count(index) == 0) {
+    if (replicas == 0) {
+      throw std::runtime_error("Number of plugin replicas must be greater than zero");
+    }
+    PluginReplicaSet::DispatchMode dispatch_mode = PluginReplicaSet::get_dispatch_mode(dispatch);
     // Dynamically class load the plugin
     // Add the plugin to the map, indexed by the name
     boost::shared_ptr<FrameProcessorPlugin> plugin = OdinData::ClassLoader<FrameProcessorPlugin>::load_class(name, library);
     if (plugin) {
+      if (replicas > 1 && !plugin->supports_replicas()) {
+        std::stringstream is;
+        is << "Cannot load plugin with index [" << index << "] as " << replicas << " replicas, "
+           << name << " does not support replicas";
+        throw std::runtime_error(is.str().c_str());
+      }
       plugin->set_name(index);
       plugin->connect_meta_channel();
       plugins_[index] = plugin;
@@ -716,8 +869,35 @@ void FrameProcessorController::loadPlugin(const std::string& index, const std::s
       }
       LOG4CXX_INFO(logger_, "Class " << name << " loaded as index = " << index);
 
-      // Start the plugin worker thread
+      // Start the plugin worker thread, or run the plugin on the scheduler
+      if (scheduler_) {
+        plugin->setScheduler(scheduler_);
+      }
       plugin->start();
+
+      // Load and start any further replicas, gathering them into a replica set
+      if (replicas > 1) {
+        std::vector<boost::shared_ptr<FrameProcessorPlugin> > instances(1, plugin);
+        for (unsigned int replica = 1; replica < replicas; replica++) {
+          boost::shared_ptr<FrameProcessorPlugin> instance =
+              OdinData::ClassLoader<FrameProcessorPlugin>::load_class(name, library);
+          if (!instance) {
+            std::stringstream is;
+            is << "Cannot load replica " << replica << " of plugin with index [" << index << "]";
+            throw std::runtime_error(is.str().c_str());
+          }
+          instance->set_name(index);
+          instance->connect_meta_channel();
+          if (scheduler_) {
+            instance->setScheduler(scheduler_);
+          }
+          instance->start();
+          instances.push_back(instance);
+        }
+        replica_sets_[index] = PluginReplicaSet::create(index, instances, dispatch_mode, reorder_timeout_ms);
+        LOG4CXX_INFO(logger_, "Plugin with index = " << index << " loaded as " << replicas <<
+                              " replicas, dispatching " << dispatch);
+      }
     } else {
       LOG4CXX_ERROR(logger_, "Could not load plugin with index [" << index <<
                                                                   "], name [" << name << "], check library");
@@ -741,10 +921,15 @@ void FrameProcessorController::connectPlugin(const std::string& index, const std
 {
   // Check that the plugin is loaded
   if (plugins_.count(index) > 0) {
+    // Frames for a plugin loaded as several replicas are passed to its replica set
+    boost::shared_ptr<IFrameCallback> input = plugins_[index];
+    if (replica_sets_.count(index) > 0) {
+      input = replica_sets_[index];
+    }
     // Check for the shared memory connection
     if (connectTo == "frame_receiver") {
       if (sharedMemController_) {
-        sharedMemController_->registerCallback(index, plugins_[index]);
+        sharedMemController_->registerCallback(index, input);
       } else {
         LOG4CXX_ERROR(logger_, "Cannot connect " << index <<
                                                  " to frame_receiver, frame_receiver is not configured");
@@ -753,8 +938,10 @@ void FrameProcessorController::connectPlugin(const std::string& index, const std
         throw std::runtime_error(is.str().c_str());
       }
     } else {
-      if (plugins_.count(connectTo) > 0) {
-        plugins_[connectTo]->register_callback(index, plugins_[index]);
+      if (replica_sets_.count(connectTo) > 0) {
+        replica_sets_[connectTo]->register_callback(index, input);
+      } else if (plugins_.count(connectTo) > 0) {
+        plugins_[connectTo]->register_callback(index, input);
       }
     }
   } else {
@@ -778,7 +965,9 @@ void FrameProcessorController::disconnectPlugin(const std::string& index, const
     if (disconnectFrom == "frame_receiver") {
       sharedMemController_->removeCallback(index);
     } else {
-      if (plugins_.count(disconnectFrom) > 0) {
+      if (replica_sets_.count(disconnectFrom) > 0) {
+        replica_sets_[disconnectFrom]->remove_callback(index);
+      } else if (plugins_.count(disconnectFrom) > 0) {
         plugins_[disconnectFrom]->remove_callback(index);
       }
     }
@@ -799,7 +988,12 @@ void FrameProcessorController::disconnectAllPlugins()
   std::map<std::string, boost::shared_ptr<FrameProcessorPlugin> >::iterator it;
   for (it = plugins_.begin(); it != plugins_.end(); it++) {
     LOG4CXX_DEBUG_LEVEL(1, logger_, "Disconnecting plugin callbacks for " << it->first);
-    it->second->remove_all_callbacks();
+    // The replicas of a plugin stay connected to their replica set
+    if (replica_sets_.count(it->first) > 0) {
+      replica_sets_[it->first]->remove_all_callbacks();
+    } else {
+      it->second->remove_all_callbacks();
+    }
   }
 }
 
@@ -822,7 +1016,10 @@ void FrameProcessorController::shutdown() {
     LOG4CXX_DEBUG_LEVEL(1, logger_, "Stopping plugin worker threads");
     std::map<std::string, boost::shared_ptr<FrameProcessorPlugin> >::iterator it;
     for (it = plugins_.begin(); it != plugins_.end(); it++) {
-      it->second->stop();
+      std::vector<boost::shared_ptr<FrameProcessorPlugin> > replicas = this->getReplicas(it->first);
+      for (size_t replica = 0; replica < replicas.size(); replica++) {
+        replicas[replica]->stop();
+      }
     }
     // Worker thread callback will block caller until pluginShutdownSent_ is set
     pluginShutdownSent_ = true;
@@ -830,8 +1027,16 @@ void FrameProcessorController::shutdown() {
     // Wait until each plugin has stopped and erase it from our map
     for (it = plugins_.begin(); it != plugins_.end(); it++) {
       LOG4CXX_DEBUG_LEVEL(1, logger_, "Removing " << it->first);
-      while(it->second->isWorking());
+      std::vector<boost::shared_ptr<FrameProcessorPlugin> > replicas = this->getReplicas(it->first);
+      for (size_t replica = 0; replica < replicas.size(); replica++) {
+        while(replicas[replica]->isWorking());
+      }
+    }
+    // Stop the scheduler before the plugins it runs are destroyed
+    if (scheduler_) {
+      scheduler_->stop();
     }
+    replica_sets_.clear();
     plugins_.clear();
 
     // Stop worker thread (for IFrameCallback) and reactor
@@ -890,6 +1095,8 @@ void FrameProcessorController::setupFrameReceiverInterface(const std::string& fr
       // Create the new shared memory controller and give it the parser and publisher
       sharedMemController_ = boost::shared_ptr<SharedMemoryController>(
           new SharedMemoryController(reactor_, frSubscriberString, frPublisherString));
+      sharedMemController_->setReleaseBatching(frReleaseBatchSize_, frReleaseBatchTimeoutMs_);
+      sharedMemController_->setReadyBatching(frReadyBatchSize_, frReadyBatchTimeoutMs_);
       frReadyEndpoint_ = frSubscriberString;
       frReleaseEndpoint_ = frPublisherString;
 
@@ -1013,6 +1220,85 @@ void FrameProcessorController::closeMetaTxInterface()
   }
 }
 
+/** Configure thread placement.
+ *
+ * Configures the CPU affinity, scheduling priority and NUMA memory policy of the threads
+ * in the frame processor from the thread placement specifications in the configuration.
+ * Threads are named "main", "ctrl", "controller", "plugin_<name>", "scheduler", "watchdog",
+ * "file_close_timeout" and "zmq_io_<n>". Specifications are matched against these names,
+ * optionally with trailing segments removed, e.g. "plugin" matches all plugin threads.
+ *
+ * \param[in] config - IpcMessage containing the thread placement configuration.
+ */
+void FrameProcessorController::configureThreadPlacement(OdinData::IpcMessage& config)
+{
+  const rapidjson::Value& placement_value =
+      config.get_param<const rapidjson::Value&>(FrameProcessorController::CONFIG_THREAD_PLACEMENT);
+  if (!placement_value.IsObject()) {
+    throw std::runtime_error("Thread placement must be an object indexed by thread name");
+  }
+  try {
+    OdinData::IpcMessage placementConfig(placement_value);
+    OdinData::ThreadPlacement::Instance().configure(placementConfig);
+    OdinData::ThreadPlacement::Instance().register_zmq_io_threads();
+  }
+  catch (OdinData::ThreadPlacementException& e) {
+    std::stringstream ss;
+    ss << "Failed to configure thread placement: " << e.what();
+    throw std::runtime_error(ss.str());
+  }
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "Thread placement configured");
+}
+
+/** Configure the plugin scheduler.
+ *
+ * With a non-zero number of threads, plugins loaded afterwards are run on a shared pool of that
+ * many threads instead of a thread each. Zero restores a thread per plugin. The number can only
+ * be changed before any plugins are loaded.
+ *
+ * \param[in] num_threads - number of scheduler threads, or zero for a thread per plugin.
+ */
+void FrameProcessorController::configureScheduler(unsigned int num_threads)
+{
+  unsigned int current_threads = scheduler_ ? scheduler_->get_num_threads() : 0;
+  if (num_threads == current_threads) {
+    return;
+  }
+  if (!plugins_.empty()) {
+    throw std::runtime_error("Scheduler threads can only be configured before any plugins are loaded");
+  }
+  if (scheduler_) {
+    scheduler_->stop();
+    scheduler_.reset();
+  }
+  if (num_threads > 0) {
+    scheduler_ = boost::shared_ptr<PluginScheduler>(new PluginScheduler(num_threads));
+  }
+  LOG4CXX_INFO(logger_, "Plugin scheduler threads set to " << num_threads);
+}
+
+/** Return the instances of a loaded plugin.
+ *
+ * \param[in] index - index of the plugin.
+ * \return the replicas of a plugin loaded as several replicas, otherwise the plugin alone.
+ */
+std::vector<boost::shared_ptr<FrameProcessorPlugin> > FrameProcessorController::getReplicas(const std::string& index)
+{
+  if (replica_sets_.count(index) > 0) {
+    return replica_sets_[index]->get_replicas();
+  }
+  return std::vector<boost::shared_ptr<FrameProcessorPlugin> >(1, plugins_[index]);
+}
+
+/** Return the name of the controller worker thread.
+ *
+ * \return name of the worker thread.
+ */
+std::string FrameProcessorController::getWorkerName() const
+{
+  return "controller";
+}
+
 /** Start the Ipc service running.
  *
  * Sets up a tick timer and runs the Ipc reactor.
@@ -1025,6 +1311,9 @@ void FrameProcessorController::runIpcService(void)
 
   LOG4CXX_DEBUG_LEVEL(1, logger_, "Running IPC thread service");
 
+  // Register this thread for placement
+  std::string placement_name = OdinData::ThreadPlacement::Instance().register_thread("ctrl");
+
   // Create the reactor
   reactor_ = boost::shared_ptr<OdinData::IpcReactor>(new OdinData::IpcReactor());
 
@@ -1038,6 +1327,7 @@ void FrameProcessorController::runIpcService(void)
   reactor_->run();
 
   // Cleanup - remove channels, sockets and timers from the reactor and close the receive socket
+  OdinData::ThreadPlacement::Instance().unregister_thread(placement_name);
   LOG4CXX_DEBUG_LEVEL(1, logger_, "Terminating IPC thread service");
 }
 
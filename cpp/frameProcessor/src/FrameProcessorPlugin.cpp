@@ -53,6 +53,19 @@ std::string FrameProcessorPlugin::get_name()
   return name_;
 }
 
+/**
+ * Get the name of the worker thread of this plugin
+ *
+ * The worker thread is named after the plugin, e.g. "plugin_hdf", so that thread placement
+ * can be specified for individual plugins or for all plugins.
+ *
+ * \return The worker thread name.
+ */
+std::string FrameProcessorPlugin::getWorkerName() const
+{
+  return "plugin_" + name_;
+}
+
 /** Set the error state.
  *
  * Sets an error for this plugin
@@ -123,6 +136,24 @@ bool FrameProcessorPlugin::reset_statistics()
   return true;
 }
 
+/** Return whether this plugin can be loaded as several replicas processing frames in parallel.
+ *
+ * A plugin supporting replicas must process each frame independently of any other frame, as
+ * consecutive frames may be processed by different replicas at the same time. Each replica is a
+ * separate instance given the same configuration, so state held in members is not shared, and
+ * any state shared between instances must be safe to access from several threads at once. The
+ * frames pushed on by the replicas are put back in order before reaching the next plugins.
+ *
+ * This default implementation returns false, plugins that meet these requirements should
+ * override this method to return true.
+ *
+ * \return true if the plugin supports replicas.
+ */
+bool FrameProcessorPlugin::supports_replicas() const
+{
+  return false;
+}
+
 /** Return the current error message.
  *
  */
@@ -217,7 +248,10 @@ void FrameProcessorPlugin::status(OdinData::IpcMessage& status)
 /**
  * Collate performance statistics for the plugin.
  *
- * The performance metrics are added to the status IpcMessage object.
+ * The performance metrics are added to the status IpcMessage object. These include the state of
+ * the work queue feeding the plugin: its current, maximum and highest depth, and the time in
+ * microseconds that producers have spent blocked on it and that the plugin has spent waiting
+ * on it for frames.
  *
  * \param[out] status - Reference to an IpcMessage value to store the performance stats.
  */
@@ -226,16 +260,29 @@ void FrameProcessorPlugin::add_performance_stats(OdinData::IpcMessage& status)
   status.set_param(get_name() + "/timing/last_process", process_duration_.last_);
   status.set_param(get_name() + "/timing/max_process", process_duration_.max_);
   status.set_param(get_name() + "/timing/mean_process", process_duration_.mean_);
+  status.set_param(get_name() + "/timing/last_process_batch", process_batch_duration_.last_);
+  status.set_param(get_name() + "/timing/max_process_batch", process_batch_duration_.max_);
+  status.set_param(get_name() + "/timing/mean_process_batch", process_batch_duration_.mean_);
+
+  boost::shared_ptr<WorkQueue<boost::shared_ptr<Frame> > > queue = getWorkQueue();
+  status.set_param(get_name() + "/queue/depth", queue->size());
+  status.set_param(get_name() + "/queue/max_depth", (int)queue->max_depth());
+  status.set_param(get_name() + "/queue/high_water", (int)queue->high_water());
+  status.set_param(get_name() + "/queue/producer_block_us", queue->producer_block_us());
+  status.set_param(get_name() + "/queue/consumer_idle_us", queue->consumer_idle_us());
 }
 
 /**
  * Reset performance statistics for the plugin.
  *
- * The performance metrics are reset to zero.
+ * The performance metrics are reset to zero, and the high water mark of the work queue to its
+ * current depth.
  */
 void FrameProcessorPlugin::reset_performance_stats()
 {
   process_duration_.reset();
+  process_batch_duration_.reset();
+  getWorkQueue()->reset_stats();
 }
 
 /**
@@ -375,6 +422,82 @@ void FrameProcessorPlugin::callback(boost::shared_ptr<Frame> frame)
   }
 }
 
+/**
+ * We have been called back with a batch of frames from a plugin that we
+ * registered with. Runs of frames between any end of acquisition frames are
+ * passed to the process_frames virtual method together, which by default
+ * calls process_frame for each in turn.
+ *
+ * \param[in] frames - Pointers to the frames, in order.
+ */
+void FrameProcessorPlugin::callback_batch(const std::vector<boost::shared_ptr<Frame> >& frames)
+{
+  size_t index = 0;
+  while ((index < frames.size()) && !frames[index]->get_end_of_acquisition()) {
+    index++;
+  }
+  if (index == frames.size()) {
+    this->process_batch(frames);
+    return;
+  }
+  // Split the batch at each end of acquisition, so that the frames before it are
+  // processed before the cleanup and those after it after
+  std::vector<boost::shared_ptr<Frame> > run;
+  for (index = 0; index < frames.size(); index++) {
+    if (frames[index]->get_end_of_acquisition()) {
+      if (!run.empty()) {
+        this->process_batch(run);
+        run.clear();
+      }
+      this->callback(frames[index]);
+    } else {
+      run.push_back(frames[index]);
+    }
+  }
+  if (!run.empty()) {
+    this->process_batch(run);
+  }
+}
+
+/**
+ * Process a batch of standard frames, recording the time taken for the whole
+ * batch in the process_frames performance stats.
+ *
+ * \param[in] frames - Pointers to the frames, in order.
+ */
+void FrameProcessorPlugin::process_batch(const std::vector<boost::shared_ptr<Frame> >& frames)
+{
+  struct timespec start_time;
+  struct timespec end_time;
+  gettime(&start_time);
+  this->process_frames(frames);
+  gettime(&end_time);
+  uint64_t ts = elapsed_us(start_time, end_time);
+  process_batch_duration_.update(ts);
+}
+
+/**
+ * This is called with each batch of frames received together. This default
+ * implementation calls process_frame for each frame in turn, recording the time
+ * taken for each in the process_frame performance stats, so plugins need not
+ * override it. Plugins processing frames more efficiently together can override
+ * it, typically pushing the frames on with push(frames), in which case only the
+ * process_frames performance stats are recorded for the batches.
+ *
+ * \param[in] frames - Pointers to the frames, in order.
+ */
+void FrameProcessorPlugin::process_frames(const std::vector<boost::shared_ptr<Frame> >& frames)
+{
+  struct timespec start_time;
+  struct timespec end_time;
+  for (size_t index = 0; index < frames.size(); index++) {
+    gettime(&start_time);
+    this->process_frame(frames[index]);
+    gettime(&end_time);
+    process_duration_.update(elapsed_us(start_time, end_time));
+  }
+}
+
 void FrameProcessorPlugin::notify_end_of_acquisition()
 {
   // Create an EndOfAcquisitionFrame object and push it through the processing chain
@@ -403,7 +526,7 @@ void FrameProcessorPlugin::push(boost::shared_ptr<Frame> frame)
   // Loop over non-blocking callbacks, placing frame onto each queue
   std::map<std::string, boost::shared_ptr<IFrameCallback> >::iterator cbIter;
   for (cbIter = callbacks_.begin(); cbIter != callbacks_.end(); ++cbIter) {
-    cbIter->second->getWorkQueue()->add(frame);
+    cbIter->second->enqueue(frame);
   }
 }
 
@@ -424,7 +547,34 @@ void FrameProcessorPlugin::push(const std::string& plugin_name, boost::shared_pt
     blocking_callbacks_[plugin_name]->callback(frame);
   }
   if (callbacks_.find(plugin_name) != callbacks_.end()){
-    callbacks_[plugin_name]->getWorkQueue()->add(frame);
+    callbacks_[plugin_name]->enqueue(frame);
+  }
+}
+
+/** Push a batch of frames to any registered callbacks.
+ *
+ * This method calls any blocking callbacks directly with the whole batch and
+ * then places the batch on the worker queue of each registered callback, waking
+ * each worker once for the batch rather than for every frame.
+ *
+ * \param[in] frames - Pointers to the frames, in order.
+ */
+void FrameProcessorPlugin::push(const std::vector<boost::shared_ptr<Frame> >& frames)
+{
+  for (size_t index = 0; index < frames.size(); index++) {
+    if (!frames[index]->get_end_of_acquisition() && !frames[index]->is_valid()){
+      throw std::runtime_error("FrameProcessorPlugin::push Invalid frame pushed onto plugin chain");
+    }
+  }
+  // Loop over blocking callbacks, calling each function and waiting for return
+  std::map<std::string, boost::shared_ptr<IFrameCallback> >::iterator bcbIter;
+  for (bcbIter = blocking_callbacks_.begin(); bcbIter != blocking_callbacks_.end(); ++bcbIter) {
+    bcbIter->second->callback_batch(frames);
+  }
+  // Loop over non-blocking callbacks, placing the frames onto each queue
+  std::map<std::string, boost::shared_ptr<IFrameCallback> >::iterator cbIter;
+  for (cbIter = callbacks_.begin(); cbIter != callbacks_.end(); ++cbIter) {
+    cbIter->second->enqueue_batch(frames);
   }
 }
 
@@ -0,0 +1,145 @@
+/*
+ * FrameReleaseQueue.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "FrameReleaseQueue.h"
+
+#include <stdexcept>
+#include <unistd.h>
+#include <fcntl.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+namespace FrameProcessor {
+
+/** Number of queue nodes preallocated, so that pushing does not normally allocate */
+static const size_t release_queue_nodes = 1024;
+
+/** Construct a FrameReleaseQueue.
+ *
+ * The wakeup descriptor is an event file descriptor on Linux, and the read end of a pipe on
+ * other platforms.
+ *
+ * \param[in] batch_size - number of queued releases that wakes the draining thread.
+ */
+FrameReleaseQueue::FrameReleaseQueue(unsigned int batch_size) :
+    queue_(release_queue_nodes),
+    pending_(0),
+    batch_size_(batch_size ? batch_size : 1) {
+#ifdef __linux__
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  wakeup_write_fd_ = wakeup_fd_;
+  if (wakeup_fd_ < 0) {
+    throw std::runtime_error("Unable to create frame release queue wakeup descriptor");
+  }
+#else
+  int pipe_fds[2];
+  if (pipe(pipe_fds) != 0) {
+    throw std::runtime_error("Unable to create frame release queue wakeup descriptor");
+  }
+  for (int idx = 0; idx < 2; idx++) {
+    fcntl(pipe_fds[idx], F_SETFL, fcntl(pipe_fds[idx], F_GETFL) | O_NONBLOCK);
+    fcntl(pipe_fds[idx], F_SETFD, FD_CLOEXEC);
+  }
+  wakeup_fd_ = pipe_fds[0];
+  wakeup_write_fd_ = pipe_fds[1];
+#endif
+}
+
+/** Destructor.
+ */
+FrameReleaseQueue::~FrameReleaseQueue() {
+  if (wakeup_write_fd_ != wakeup_fd_) {
+    close(wakeup_write_fd_);
+  }
+  close(wakeup_fd_);
+}
+
+/** Queue a shared buffer release.
+ *
+ * This may be called from any thread. The draining thread is woken when the queue becomes
+ * non-empty and when a full batch of releases has been queued.
+ *
+ * \param[in] release - release to queue.
+ */
+void FrameReleaseQueue::push(const Release &release) {
+  // Count the release before queuing it, so that the count never drops below the queue length
+  unsigned int pending = __atomic_add_fetch(&pending_, 1, __ATOMIC_ACQ_REL);
+  queue_.push(release);
+  if ((pending == 1) || (pending == __atomic_load_n(&batch_size_, __ATOMIC_RELAXED))) {
+    this->wakeup();
+  }
+}
+
+/** Dequeue a shared buffer release.
+ *
+ * \param[out] release - release dequeued.
+ * \return true if a release was dequeued, false if the queue is empty.
+ */
+bool FrameReleaseQueue::pop(Release &release) {
+  if (!queue_.pop(release)) {
+    return false;
+  }
+  __atomic_sub_fetch(&pending_, 1, __ATOMIC_ACQ_REL);
+  return true;
+}
+
+/** Return the number of releases queued.
+ *
+ * \return number of releases queued.
+ */
+unsigned int FrameReleaseQueue::get_pending() const {
+  return __atomic_load_n(&pending_, __ATOMIC_ACQUIRE);
+}
+
+/** Set the number of queued releases that wakes the draining thread.
+ *
+ * \param[in] batch_size - number of releases, at least one.
+ */
+void FrameReleaseQueue::set_batch_size(unsigned int batch_size) {
+  __atomic_store_n(&batch_size_, batch_size ? batch_size : 1, __ATOMIC_RELAXED);
+}
+
+/** Return the number of queued releases that wakes the draining thread.
+ *
+ * \return number of releases.
+ */
+unsigned int FrameReleaseQueue::get_batch_size() const {
+  return __atomic_load_n(&batch_size_, __ATOMIC_RELAXED);
+}
+
+/** Return the event file descriptor signalled to wake the draining thread.
+ *
+ * \return event file descriptor.
+ */
+int FrameReleaseQueue::get_wakeup_fd() const {
+  return wakeup_fd_;
+}
+
+/** Signal the event file descriptor to wake the draining thread.
+ */
+void FrameReleaseQueue::wakeup() {
+  uint64_t wakeup = 1;
+  ssize_t rc = write(wakeup_write_fd_, &wakeup, sizeof(wakeup));
+  (void)rc;
+}
+
+/** Clear the event file descriptor after waking.
+ */
+void FrameReleaseQueue::clear_wakeup() {
+  uint64_t wakeups;
+#ifdef __linux__
+  ssize_t rc = read(wakeup_fd_, &wakeups, sizeof(wakeups));
+  (void)rc;
+#else
+  // Drain every wakeup written to the pipe
+  while (read(wakeup_fd_, &wakeups, sizeof(wakeups)) > 0) {
+  }
+#endif
+}
+
+}
@@ -196,6 +196,19 @@ namespace FrameProcessor
         return gap_frame;
     }
 
+    /**
+     * Return whether this plugin supports replicas.
+     *
+     * Gaps are inserted into each frame independently of any other, so replicas may process
+     * frames in parallel.
+     *
+     * \return true
+     */
+    bool GapFillPlugin::supports_replicas() const
+    {
+        return true;
+    }
+
     /**
      * Set configuration options for this Plugin.
      *
@@ -289,6 +289,23 @@ void HDF5File::write_frame(
  * \param[in] frame_offset - The offset to write the value to
  */
 void HDF5File::write_parameter(const Frame& frame, DatasetDefinition dataset_definition, hsize_t frame_offset) {
+  this->write_parameter(frame, dataset_definition, FrameMetaData::intern(dataset_definition.name), frame_offset);
+}
+
+/**
+ * Write a parameter to the file, given the key of the parameter name.
+ *
+ * \param[in] frame - Reference to the frame.
+ * \param[in] dataset_definition - The dataset definition for this parameter.
+ * \param[in] parameter_key - The key of the parameter name, that of the dataset name.
+ * \param[in] frame_offset - The offset to write the value to
+ */
+void HDF5File::write_parameter(
+  const Frame& frame,
+  const DatasetDefinition& dataset_definition,
+  MetaDataKey parameter_key,
+  hsize_t frame_offset
+) {
   // Protect this method
   boost::lock_guard<boost::recursive_mutex> lock(mutex_);
 
@@ -303,32 +320,32 @@ void HDF5File::write_parameter(const Frame& frame, DatasetDefinition dataset_def
   // Get the correct value and size from the parameter given its type
   switch( dataset_definition.data_type ) {
   case raw_8bit:
-    u8value = frame.get_meta_data().get_parameter<uint8_t>(dataset_definition.name);
+    u8value = frame.get_meta_data().get_parameter<uint8_t>(parameter_key);
     data_ptr = &u8value;
     size = sizeof(uint8_t);
     break;
   case raw_16bit:
-    u16value = frame.get_meta_data().get_parameter<uint16_t>(dataset_definition.name);
+    u16value = frame.get_meta_data().get_parameter<uint16_t>(parameter_key);
     data_ptr = &u16value;
     size = sizeof(uint16_t);
     break;
   case raw_32bit:
-    u32value = frame.get_meta_data().get_parameter<uint32_t>(dataset_definition.name);
+    u32value = frame.get_meta_data().get_parameter<uint32_t>(parameter_key);
     data_ptr = &u32value;
     size = sizeof(uint32_t);
     break;
   case raw_64bit:
-    u64value = frame.get_meta_data().get_parameter<uint64_t>(dataset_definition.name);
+    u64value = frame.get_meta_data().get_parameter<uint64_t>(parameter_key);
     data_ptr = &u64value;
     size = sizeof(uint64_t);
     break;
   case raw_float:
-    f32value = frame.get_meta_data().get_parameter<float>(dataset_definition.name);
+    f32value = frame.get_meta_data().get_parameter<float>(parameter_key);
     data_ptr = &f32value;
     size = sizeof(float);
     break;
   default:
-    u16value = frame.get_meta_data().get_parameter<uint16_t>(dataset_definition.name);
+    u16value = frame.get_meta_data().get_parameter<uint16_t>(parameter_key);
     data_ptr = &u16value;
     size = sizeof(uint16_t);
     break;
@@ -5,19 +5,30 @@
  *      Author: gnx91527
  */
 
+#include <algorithm>
+
 #include "logging.h"
+#include "ThreadPlacement.h"
 #include <IFrameCallback.h>
+#include "PluginReplicaSet.h"
 
 namespace FrameProcessor
 {
 
+/** Callback whose full WorkQueue a Frame was added to by the run in progress on this thread */
+static __thread IFrameCallback *congested_callback = 0;
+
 /** Construct a new IFrameCallback object.
  *
  * The constructor creates the new WorkQueue object.
  */
 IFrameCallback::IFrameCallback() :
+    logger_(Logger::getLogger("FP.IFrameCallback")),
     thread_(0),
-    working_(false)
+    working_(false),
+    scheduled_(0),
+    replica_index_(0),
+    batch_size_(worker_batch_size)
 {
   // Create the work queue for message offload
   queue_ = boost::shared_ptr<WorkQueue<boost::shared_ptr<Frame> > >(new WorkQueue<boost::shared_ptr<Frame> >);
@@ -39,16 +50,272 @@ boost::shared_ptr<WorkQueue<boost::shared_ptr<Frame> > > IFrameCallback::getWork
   return queue_;
 }
 
+/** Add a Frame to the WorkQueue for processing.
+ *
+ * If this IFrameCallback runs on a PluginScheduler it is then scheduled to
+ * process the Frame. A scheduler worker thread never blocks on a full queue,
+ * as it may be the thread that would otherwise drain it. Instead the plugin
+ * running on that thread is parked once it has processed its current batch,
+ * until this queue drains below its maximum depth.
+ *
+ * \param[in] frame - pointer to the Frame to process.
+ * \param[in] ignore_max_limit - add the Frame even if the queue is at its maximum depth.
+ */
+void IFrameCallback::enqueue(boost::shared_ptr<Frame> frame, bool ignore_max_limit)
+{
+  if (!scheduler_) {
+    queue_->add(frame, ignore_max_limit);
+    return;
+  }
+  if (scheduler_->is_worker_thread()) {
+    if (!ignore_max_limit && (static_cast<size_t>(queue_->size()) >= queue_->max_depth())) {
+      congested_callback = this;
+    }
+    ignore_max_limit = true;
+  }
+  queue_->add(frame, ignore_max_limit);
+  this->schedule();
+}
+
+/** Add a batch of Frames to the WorkQueue for processing.
+ *
+ * The Frames are added in order as for enqueue, but the worker thread is only
+ * woken once for the batch. On a PluginScheduler each Frame is added in turn, so
+ * that this IFrameCallback is scheduled before the caller could block on a full
+ * queue.
+ *
+ * \param[in] frames - pointers to the Frames to process.
+ * \param[in] ignore_max_limit - add the Frames even if the queue is at its maximum depth.
+ */
+void IFrameCallback::enqueue_batch(const std::vector<boost::shared_ptr<Frame> >& frames, bool ignore_max_limit)
+{
+  if (!scheduler_) {
+    queue_->add_batch(frames, ignore_max_limit);
+    return;
+  }
+  for (size_t index = 0; index < frames.size(); index++) {
+    this->enqueue(frames[index], ignore_max_limit);
+  }
+}
+
+/** Set the maximum number of Frames removed from the WorkQueue and processed together.
+ *
+ * \param[in] batch_size - maximum number of Frames in a batch, at least one.
+ */
+void IFrameCallback::setBatchSize(size_t batch_size)
+{
+  if (batch_size == 0) {
+    throw std::runtime_error("Frame batch size must be greater than zero");
+  }
+  __atomic_store_n(&batch_size_, batch_size, __ATOMIC_RELAXED);
+}
+
+/** Return the maximum number of Frames removed from the WorkQueue and processed together.
+ *
+ * \return the maximum number of Frames in a batch.
+ */
+size_t IFrameCallback::getBatchSize() const
+{
+  return __atomic_load_n(&batch_size_, __ATOMIC_RELAXED);
+}
+
+/** Callback for a batch of Frames removed from the WorkQueue together.
+ *
+ * This default implementation calls the callback method for each Frame in turn.
+ * Subclasses can override this to process the Frames of a batch together.
+ *
+ * \param[in] frames - pointers to the Frames ready for processing, in order.
+ */
+void IFrameCallback::callback_batch(const std::vector<boost::shared_ptr<Frame> >& frames)
+{
+  for (size_t index = 0; index < frames.size(); index++) {
+    this->callback(frames[index]);
+  }
+}
+
+/** Run this IFrameCallback on a PluginScheduler instead of a worker thread.
+ *
+ * This must be set before the IFrameCallback is started.
+ *
+ * \param[in] scheduler - scheduler to run on.
+ */
+void IFrameCallback::setScheduler(boost::shared_ptr<PluginScheduler> scheduler)
+{
+  scheduler_ = scheduler;
+}
+
+/** Make this IFrameCallback a replica within a PluginReplicaSet.
+ *
+ * The replica set is told as each Frame is processed, so that the Frames pushed
+ * on while processing it can be released in order. This must be set before any
+ * Frames are added to the WorkQueue. Only a weak reference is held, and the
+ * replica set is kept alive while a batch of Frames is processed.
+ *
+ * \param[in] replica_set - replica set this is a replica within, or null.
+ * \param[in] replica_index - index of this IFrameCallback within the replica set.
+ */
+void IFrameCallback::setReplicaSet(boost::shared_ptr<PluginReplicaSet> replica_set, unsigned int replica_index)
+{
+  boost::mutex::scoped_lock lock(replica_mutex_);
+  replica_set_ = replica_set;
+  replica_index_ = replica_index;
+}
+
+/** Process a batch of Frames from the WorkQueue on a PluginScheduler thread.
+ *
+ * Up to the batch size of Frames are removed from the queue and processed
+ * together. If more Frames are waiting once the batch is done this IFrameCallback
+ * is scheduled again, so that other plugins get to run in between. If processing
+ * the batch pushed Frames to a full queue this IFrameCallback is instead parked
+ * on that queue, and scheduled again once it drains. An exception thrown while
+ * processing is logged and the remaining Frames of the batch dropped, so that the
+ * worker thread and this IFrameCallback carry on.
+ */
+void IFrameCallback::runScheduled()
+{
+  queue_->try_remove_batch(scheduled_batch_, this->getBatchSize());
+  this->wake_parked();
+  congested_callback = 0;
+  try {
+    this->process(scheduled_batch_);
+  } catch (std::exception& e) {
+    LOG4CXX_ERROR(logger_, "Unhandled exception processing frames: " << e.what());
+    scheduled_batch_.clear();
+  } catch (...) {
+    LOG4CXX_ERROR(logger_, "Unhandled unknown exception processing frames");
+    scheduled_batch_.clear();
+  }
+  IFrameCallback *congested = congested_callback;
+  congested_callback = 0;
+  if (congested && (congested != this)) {
+    congested->park(this);
+    return;
+  }
+
+  // Clear the scheduled flag before checking the queue, as frames are added before the flag is
+  // tested, so that a frame added meanwhile is never left unscheduled
+  __atomic_store_n(&scheduled_, 0, __ATOMIC_SEQ_CST);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (queue_->size() > 0) {
+    this->schedule();
+  }
+}
+
+/** Park a producer that pushed Frames to this IFrameCallback while its WorkQueue was full.
+ *
+ * The producer remains flagged as scheduled, so it is not run again, and Frames pushed to it
+ * wait on its own queue, until this queue drains below its maximum depth. If the queue has
+ * already drained the producer is run again straight away.
+ *
+ * \param[in] producer - IFrameCallback to park.
+ */
+void IFrameCallback::park(IFrameCallback *producer)
+{
+  {
+    boost::mutex::scoped_lock lock(parked_mutex_);
+    if (static_cast<size_t>(queue_->size()) >= queue_->max_depth()) {
+      parked_.push_back(producer);
+      return;
+    }
+  }
+  producer->scheduler_->submit(producer);
+}
+
+/** Run again the producers parked on this IFrameCallback, once its WorkQueue has drained below
+ * its maximum depth.
+ */
+void IFrameCallback::wake_parked()
+{
+  std::vector<IFrameCallback*> parked;
+  {
+    boost::mutex::scoped_lock lock(parked_mutex_);
+    if (parked_.empty() || (static_cast<size_t>(queue_->size()) >= queue_->max_depth())) {
+      return;
+    }
+    parked.swap(parked_);
+  }
+  for (size_t index = 0; index < parked.size(); index++) {
+    parked[index]->scheduler_->submit(parked[index]);
+  }
+}
+
+/** Schedule this IFrameCallback on its PluginScheduler unless it is already scheduled.
+ */
+void IFrameCallback::schedule()
+{
+  if (!__atomic_exchange_n(&scheduled_, 1, __ATOMIC_SEQ_CST)) {
+    scheduler_->submit(this);
+  }
+}
+
+/** Pass a batch of Frames removed from the WorkQueue to the callback methods.
+ *
+ * Null Frames, added to stop the worker thread, are dropped and the rest passed to
+ * callback_batch together. Within a PluginReplicaSet each Frame is instead passed to
+ * the callback method in turn, telling the replica set when processing of the Frame
+ * starts and ends. Every Frame of the batch is processed and reported even if the
+ * callback throws for one, and the first error is then rethrown. The batch is cleared
+ * once processed, releasing the Frames.
+ *
+ * \param[in,out] batch - pointers to the Frames to process.
+ */
+void IFrameCallback::process(std::vector<boost::shared_ptr<Frame> >& batch)
+{
+  batch.erase(std::remove(batch.begin(), batch.end(), boost::shared_ptr<Frame>()), batch.end());
+  boost::shared_ptr<PluginReplicaSet> replica_set;
+  unsigned int replica_index;
+  {
+    boost::mutex::scoped_lock lock(replica_mutex_);
+    replica_set = replica_set_.lock();
+    replica_index = replica_index_;
+  }
+  if (!replica_set) {
+    if (!batch.empty()) {
+      this->callback_batch(batch);
+    }
+    batch.clear();
+    return;
+  }
+  bool failed = false;
+  std::string error;
+  for (size_t index = 0; index < batch.size(); index++) {
+    replica_set->begin_frame(replica_index, batch[index]);
+    try {
+      this->callback(batch[index]);
+    } catch (std::exception& e) {
+      if (!failed) {
+        error = e.what();
+      }
+      failed = true;
+    } catch (...) {
+      if (!failed) {
+        error = "Unknown exception";
+      }
+      failed = true;
+    }
+    replica_set->end_frame();
+    batch[index].reset();
+  }
+  batch.clear();
+  if (failed) {
+    throw std::runtime_error(error);
+  }
+}
+
 /** Start the worker thread.
  *
  * Check to ensure this object is not already working. If it isn't then
  * create the new worker thread, binding the workerTask method to the thread execution.
+ * No thread is created when running on a PluginScheduler.
  */
 void IFrameCallback::start()
 {
   if (!working_) {
     // Set the working flag to true
     working_ = true;
+    if (scheduler_) {
+      return;
+    }
     // Now start the worker thread to monitor the queue
     thread_ = new boost::thread(&IFrameCallback::workerTask, this);
   }
@@ -58,13 +325,17 @@ void IFrameCallback::start()
  *
  * Check this object is working. Set the working_ flag to false and then
  * send an empty Frame pointer to the WorkerQueue object that will result
- * in the thread terminating gracefully.
+ * in the thread terminating gracefully. There is no worker thread to stop when
+ * running on a PluginScheduler.
  */
 void IFrameCallback::stop()
 {
   if (working_) {
     // Set the working flag to false
     working_ = false;
+    if (scheduler_) {
+      return;
+    }
     // Now notify the work queue we have finished by adding a null ptr
     boost::shared_ptr<Frame> nullMsg;
     queue_->add(nullMsg);
@@ -103,28 +374,50 @@ void IFrameCallback::confirmRemoval(const std::string& name)
   registrations_.erase(name);
 }
 
+/** Return the name of the worker thread.
+ *
+ * The name is used to identify the worker thread when applying thread placement. This
+ * default implementation returns a generic name, subclasses should override this to
+ * return a name identifying the instance.
+ *
+ * \return name of the worker thread.
+ */
+std::string IFrameCallback::getWorkerName() const
+{
+  return "frame_callback";
+}
+
 /** Main thread of execution for this class.
  *
  * The thread executes in a continuous loop until the working_ flag is set to false.
- * The thread blocks on the remove call of the WorkQueue, waiting until a new Frame
- * is available. As soon as a Frame becomes available the remove call returns and this
- * method calls the callback method (which is pure virtual and must be implemented by
- * a subclass).
+ * The thread blocks on the remove_batch call of the WorkQueue, waiting until a new Frame
+ * is available. As soon as Frames become available up to the batch size of them are
+ * removed together and passed to callback_batch, which by default calls the callback
+ * method (which is pure virtual and must be implemented by a subclass) for each in turn.
  */
 void IFrameCallback::workerTask()
 {
   // Configure logging for this thread
   OdinData::configure_logging_mdc(OdinData::app_path.c_str());
 
+  // Register this thread for placement before processing any frames
+  std::string placement_name = OdinData::ThreadPlacement::Instance().register_thread(this->getWorkerName());
+
   // Main worker task of this callback
   // Check the queue for messages
+  std::vector<boost::shared_ptr<Frame> > batch;
   while (working_) {
-    boost::shared_ptr<Frame> msg = queue_->remove();
-    if (msg) {
-      // Once we have a message, call the callback
-      this->callback(msg);
+    queue_->remove_batch(batch, this->getBatchSize());
+    // Once we have messages, call the callback
+    try {
+      this->process(batch);
+    } catch (std::exception& e) {
+      LOG4CXX_ERROR(logger_, "Unhandled exception processing frames: " << e.what());
+      batch.clear();
     }
   }
+
+  OdinData::ThreadPlacement::Instance().unregister_thread(placement_name);
 }
 
 } /* namespace FrameProcessor */
@@ -0,0 +1,84 @@
+/*
+ * MissingPacketFill.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "MissingPacketFill.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace FrameProcessor {
+
+/** Construct a MissingPacketFill filling with a byte value.
+ *
+ * \param[in] fill_value - byte value written over missing payloads.
+ */
+MissingPacketFill::MissingPacketFill(uint8_t fill_value) :
+    pattern_size_(1) {
+  pattern_[0] = static_cast<char>(fill_value);
+}
+
+/** Construct a MissingPacketFill filling with a repeated pattern.
+ *
+ * \param[in] pattern - pattern repeated over missing payloads.
+ * \param[in] pattern_size - size of the pattern in bytes, between 1 and 16.
+ */
+MissingPacketFill::MissingPacketFill(const void *pattern, std::size_t pattern_size) :
+    pattern_size_(pattern_size) {
+  if (pattern_size == 0 || pattern_size > sizeof(pattern_)) {
+    throw std::runtime_error("Missing packet fill pattern size must be between 1 and 16 bytes");
+  }
+  memcpy(pattern_, pattern, pattern_size);
+}
+
+/** Fill the payload of each missing packet of a frame.
+ *
+ * The payloads of the packets are assumed to be laid out contiguously, each packet_size bytes,
+ * in the order of their packet numbers. Each range of consecutive missing packets is filled
+ * in a single operation.
+ *
+ * \param[in] packet_state - packet state bitmap of the frame.
+ * \param[in] payload - start of the payload of the first packet of the frame.
+ * \param[in] packet_size - size of each packet payload in bytes.
+ * \return number of missing packets filled.
+ */
+std::size_t MissingPacketFill::fill(const OdinData::PacketStateBitmap &packet_state, void *payload,
+                                    std::size_t packet_size) const {
+  std::size_t packets_filled = 0;
+  std::size_t first = 0;
+  std::size_t last = 0;
+  while (packet_state.next_missing_range(first, last)) {
+    fill_region(static_cast<char *>(payload) + (first * packet_size), (last - first) * packet_size);
+    packets_filled += last - first;
+    first = last;
+  }
+  return packets_filled;
+}
+
+/** Fill a region with the pattern.
+ *
+ * A single byte pattern is filled with memset. A longer pattern is written once and then
+ * doubled with successive copies of the region already filled.
+ *
+ * \param[in] region - start of the region.
+ * \param[in] size - size of the region in bytes.
+ */
+void MissingPacketFill::fill_region(char *region, std::size_t size) const {
+  if (pattern_size_ == 1) {
+    memset(region, pattern_[0], size);
+    return;
+  }
+  std::size_t filled = std::min(pattern_size_, size);
+  memcpy(region, pattern_, filled);
+  while (filled < size) {
+    std::size_t copy_size = std::min(filled, size - filled);
+    memcpy(region + filled, region, copy_size);
+    filled += copy_size;
+  }
+}
+
+}
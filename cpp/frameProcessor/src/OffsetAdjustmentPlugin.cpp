@@ -43,6 +43,20 @@ void OffsetAdjustmentPlugin::process_frame(boost::shared_ptr<Frame> frame)
   this->push(frame);
 }
 
+/**
+ * Perform processing on a batch of frames, adjusting the offset of each and
+ * pushing them on together.
+ *
+ * \param[in] frames - Pointers to the Frame objects.
+ */
+void OffsetAdjustmentPlugin::process_frames(const std::vector<boost::shared_ptr<Frame> >& frames)
+{
+  for (size_t index = 0; index < frames.size(); index++) {
+    frames[index]->meta_data().adjust_frame_offset(offset_adjustment_);
+  }
+  this->push(frames);
+}
+
 /**
  * Set configuration options for this Plugin.
  *
@@ -38,29 +38,29 @@ ParameterAdjustmentPlugin::~ParameterAdjustmentPlugin()
 void ParameterAdjustmentPlugin::process_frame(boost::shared_ptr<Frame> frame)
 {
   // Apply any parameter adjustments
-  if (parameter_adjustments_.size() != 0)
+  if (adjustments_.size() != 0)
   {
-    std::map<std::string, int64_t>::iterator iter;
-    for (iter = parameter_adjustments_.begin(); iter != parameter_adjustments_.end(); ++iter) {
+    std::vector<ParameterAdjustment>::const_iterator iter;
+    for (iter = adjustments_.begin(); iter != adjustments_.end(); ++iter) {
       try {
         // If no input parameter specified, add to the frame id, otherwise add to the the input parameter
-        if (parameter_inputs_.find(iter->first) == parameter_inputs_.end() || parameter_inputs_[iter->first] == "")
+        if (!iter->has_input)
         {
-          uint64_t param_value = frame->get_frame_number() + iter->second;
-          frame->meta_data().set_parameter<uint64_t>(iter->first, param_value);
+          uint64_t param_value = frame->get_frame_number() + iter->adjustment;
+          frame->meta_data().set_parameter<uint64_t>(iter->parameter, param_value);
         }
         else
         {
-          std::string input_parameter = parameter_inputs_[iter->first];
-          if (frame->meta_data().has_parameter(input_parameter))
+          if (frame->meta_data().has_parameter(iter->input))
           {
-            uint64_t param_value = frame->meta_data().get_parameter<uint64_t>(input_parameter) + iter->second;
-            frame->meta_data().set_parameter<uint64_t>(iter->first, param_value);
+            uint64_t param_value = frame->meta_data().get_parameter<uint64_t>(iter->input) + iter->adjustment;
+            frame->meta_data().set_parameter<uint64_t>(iter->parameter, param_value);
           }
           else
           {
             std::stringstream ss;
-            ss << "Unable to get parameter " << input_parameter << " to use as input parameter for adjustment";
+            ss << "Unable to get parameter " << FrameMetaData::key_name(iter->input)
+               << " to use as input parameter for adjustment";
             this->set_error(ss.str());
             LOG4CXX_WARN(logger_, ss.str());
           }
@@ -68,7 +68,7 @@ void ParameterAdjustmentPlugin::process_frame(boost::shared_ptr<Frame> frame)
       }
       catch (std::exception &e) {
         std::stringstream ss;
-        ss << "Error setting parameter adjustment for " << iter->first;
+        ss << "Error setting parameter adjustment for " << FrameMetaData::key_name(iter->parameter);
         this->set_error(ss.str());
         LOG4CXX_WARN(logger_, ss.str());
       }
@@ -124,6 +124,7 @@ void ParameterAdjustmentPlugin::configure(OdinData::IpcMessage& config, OdinData
         parameter_adjustments_.clear();
         parameter_inputs_.clear();
       }
+      this->update_adjustments();
     }
   }
   catch (std::runtime_error& e)
@@ -135,6 +136,29 @@ void ParameterAdjustmentPlugin::configure(OdinData::IpcMessage& config, OdinData
   }
 }
 
+/**
+ * Update the parameter adjustments applied to each frame from the configured adjustments.
+ *
+ * The parameter names are interned as frame meta data keys once here, rather than looked up
+ * for every frame.
+ */
+void ParameterAdjustmentPlugin::update_adjustments()
+{
+  std::vector<ParameterAdjustment> adjustments;
+  std::map<std::string, int64_t>::iterator iter;
+  for (iter = parameter_adjustments_.begin(); iter != parameter_adjustments_.end(); ++iter) {
+    ParameterAdjustment adjustment;
+    adjustment.parameter = FrameMetaData::intern(iter->first);
+    adjustment.has_input = (parameter_inputs_.find(iter->first) != parameter_inputs_.end() &&
+                            parameter_inputs_[iter->first] != "");
+    adjustment.input = adjustment.has_input ?
+                       FrameMetaData::intern(parameter_inputs_[iter->first]) : FrameMetaData::empty_key;
+    adjustment.adjustment = iter->second;
+    adjustments.push_back(adjustment);
+  }
+  adjustments_.swap(adjustments);
+}
+
 /**
  * Get the configuration values for this Plugin.
  *
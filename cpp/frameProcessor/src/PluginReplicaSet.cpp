@@ -0,0 +1,530 @@
+/*
+ * PluginReplicaSet.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "PluginReplicaSet.h"
+
+#include <stdexcept>
+
+#include "logging.h"
+#include "DebugLevelLogger.h"
+#include "gettime.h"
+
+namespace FrameProcessor {
+
+/** Replica set whose replica is processing a frame on the calling thread, if any */
+static __thread PluginReplicaSet *current_replica_set = 0;
+
+/** Sequence number of the frame being processed by a replica on the calling thread */
+static __thread uint64_t current_sequence = 0;
+
+/** Return the current monotonic time.
+ *
+ * \return time in nanoseconds.
+ */
+static uint64_t now_ns() {
+  struct timespec now;
+  gettime(&now, true);
+  return ((uint64_t)now.tv_sec * 1000000000) + now.tv_nsec;
+}
+
+/** Construct a PluginReplicaOutput.
+ *
+ * \param[in] replica_set - replica set the frames pushed by each replica are passed to.
+ */
+PluginReplicaOutput::PluginReplicaOutput(PluginReplicaSet &replica_set) :
+    replica_set_(replica_set) {
+}
+
+/** Pass a frame pushed by a replica to the replica set.
+ *
+ * \param[in] frame - frame pushed by the replica.
+ * \param[in] ignore_max_limit - unused, the frame is never queued here.
+ */
+void PluginReplicaOutput::enqueue(boost::shared_ptr<Frame> frame, bool ignore_max_limit) {
+  replica_set_.collect(frame);
+}
+
+/** Pass a batch of frames pushed by a replica to the replica set.
+ *
+ * \param[in] frames - frames pushed by the replica.
+ * \param[in] ignore_max_limit - unused, the frames are never queued here.
+ */
+void PluginReplicaOutput::enqueue_batch(const std::vector<boost::shared_ptr<Frame> > &frames,
+                                        bool ignore_max_limit) {
+  for (size_t index = 0; index < frames.size(); index++) {
+    replica_set_.collect(frames[index]);
+  }
+}
+
+/** Pass a frame pushed by a replica to the replica set.
+ *
+ * \param[in] frame - frame pushed by the replica.
+ */
+void PluginReplicaOutput::callback(boost::shared_ptr<Frame> frame) {
+  replica_set_.collect(frame);
+}
+
+const unsigned int PluginReplicaSet::default_reorder_timeout_ms;
+
+/** Create a PluginReplicaSet and attach it to its replicas.
+ *
+ * The output of the replica set is registered as the only callback of each replica, and each
+ * replica is told to report the frames it processes to the replica set. The replicas only hold
+ * a weak reference to the replica set, which is kept alive while they process frames.
+ *
+ * \param[in] name - name of the replicated plugin.
+ * \param[in] replicas - replicas of the plugin, already started.
+ * \param[in] dispatch_mode - how frames are dispatched to the replicas.
+ * \param[in] reorder_timeout_ms - time after which a frame holding up later frames is given up on.
+ * \return the replica set.
+ */
+boost::shared_ptr<PluginReplicaSet> PluginReplicaSet::create(
+    const std::string &name,
+    const std::vector<boost::shared_ptr<FrameProcessorPlugin> > &replicas,
+    DispatchMode dispatch_mode,
+    unsigned int reorder_timeout_ms) {
+  boost::shared_ptr<PluginReplicaSet> replica_set(
+      new PluginReplicaSet(name, replicas, dispatch_mode, reorder_timeout_ms));
+  for (size_t index = 0; index < replicas.size(); index++) {
+    replicas[index]->register_callback(name + "_reorder", replica_set->output_);
+    replicas[index]->setReplicaSet(replica_set, index);
+  }
+  return replica_set;
+}
+
+/** Construct a PluginReplicaSet.
+ *
+ * \param[in] name - name of the replicated plugin.
+ * \param[in] replicas - replicas of the plugin, already started.
+ * \param[in] dispatch_mode - how frames are dispatched to the replicas.
+ * \param[in] reorder_timeout_ms - time after which a frame holding up later frames is given up on.
+ */
+PluginReplicaSet::PluginReplicaSet(const std::string &name,
+                                   const std::vector<boost::shared_ptr<FrameProcessorPlugin> > &replicas,
+                                   DispatchMode dispatch_mode,
+                                   unsigned int reorder_timeout_ms) :
+    logger_(Logger::getLogger("FP.PluginReplicaSet")),
+    name_(name),
+    replicas_(replicas),
+    dispatch_mode_(dispatch_mode),
+    next_replica_(0),
+    next_sequence_(0),
+    dispatched_(replicas.size()),
+    reorder_timeout_ns_((uint64_t)reorder_timeout_ms * 1000000),
+    reorder_timeouts_(0),
+    held_(0),
+    max_held_(0),
+    stalled_(false),
+    stall_start_ns_(0),
+    stall_ns_(0),
+    frames_dispatched_(0) {
+  if (replicas_.empty()) {
+    throw std::runtime_error("Plugin replica set requires at least one replica");
+  }
+  output_ = boost::shared_ptr<PluginReplicaOutput>(new PluginReplicaOutput(*this));
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "Created " << replicas_.size() << " replicas of plugin " << name_);
+}
+
+/** Destructor, detaching the replicas from the replica set.
+ */
+PluginReplicaSet::~PluginReplicaSet() {
+  for (size_t index = 0; index < replicas_.size(); index++) {
+    replicas_[index]->setReplicaSet(boost::shared_ptr<PluginReplicaSet>());
+    replicas_[index]->remove_callback(name_ + "_reorder");
+  }
+}
+
+/** Dispatch a frame to one of the replicas.
+ *
+ * The frame is given the next sequence number, which sets its place in the output of the
+ * replica set. End of acquisition frames are dispatched to every replica. A frame at the front
+ * of the reorder buffer past the reorder timeout is then given up on, if a later frame is done.
+ *
+ * \param[in] frame - frame to dispatch.
+ * \param[in] ignore_max_limit - add the frame even if the replica queue is at its maximum depth.
+ */
+void PluginReplicaSet::enqueue(boost::shared_ptr<Frame> frame, bool ignore_max_limit) {
+  std::vector<size_t> targets;
+  if (frame->get_end_of_acquisition()) {
+    for (size_t index = 0; index < replicas_.size(); index++) {
+      targets.push_back(index);
+    }
+  } else if (dispatch_mode_ == DispatchLeastLoaded) {
+    size_t replica = 0;
+    int least_depth = replicas_[0]->getWorkQueue()->size();
+    for (size_t index = 1; index < replicas_.size(); index++) {
+      int depth = replicas_[index]->getWorkQueue()->size();
+      if (depth < least_depth) {
+        least_depth = depth;
+        replica = index;
+      }
+    }
+    targets.push_back(replica);
+  } else {
+    targets.push_back(__atomic_fetch_add(&next_replica_, 1, __ATOMIC_RELAXED) % replicas_.size());
+  }
+
+  // Queue the sequence number for each replica in the same order as the frame is added to its
+  // queue, so that each replica takes them in step
+  boost::mutex::scoped_lock dispatch_lock(dispatch_mutex_);
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    uint64_t sequence = next_sequence_++;
+    Pending &pending = pending_[sequence];
+    pending.remaining = targets.size();
+    pending.dispatch_ns = now_ns();
+    for (size_t index = 0; index < targets.size(); index++) {
+      dispatched_[targets[index]].push_back(sequence);
+    }
+    if (!frame->get_end_of_acquisition()) {
+      frames_dispatched_++;
+    }
+  }
+  for (size_t index = 0; index < targets.size(); index++) {
+    replicas_[targets[index]]->enqueue(frame, ignore_max_limit);
+  }
+  dispatch_lock.unlock();
+
+  // Give up on a frame holding up the reorder buffer past the timeout even if no replica
+  // finishes another frame
+  boost::unique_lock<boost::mutex> lock(mutex_);
+  std::map<uint64_t, Pending>::iterator front = pending_.begin();
+  if ((front != pending_.end()) && (front->second.remaining > 0) && (held_ > 0) &&
+      (now_ns() - front->second.dispatch_ns >= reorder_timeout_ns_)) {
+    std::vector<boost::shared_ptr<Frame> > released;
+    this->release_completed(released);
+    this->release(released, lock);
+  }
+}
+
+/** Dispatch a batch of frames to the replicas.
+ *
+ * Each frame is dispatched to a replica of its own, so that the batch is processed in parallel.
+ *
+ * \param[in] frames - frames to dispatch.
+ * \param[in] ignore_max_limit - add the frames even if the replica queues are at their maximum depth.
+ */
+void PluginReplicaSet::enqueue_batch(const std::vector<boost::shared_ptr<Frame> > &frames,
+                                     bool ignore_max_limit) {
+  for (size_t index = 0; index < frames.size(); index++) {
+    this->enqueue(frames[index], ignore_max_limit);
+  }
+}
+
+/** Dispatch a frame to one of the replicas.
+ *
+ * \param[in] frame - frame to dispatch.
+ */
+void PluginReplicaSet::callback(boost::shared_ptr<Frame> frame) {
+  this->enqueue(frame);
+}
+
+/** Register a plugin to receive the frames released by the reorder buffer.
+ *
+ * \param[in] name - index of the plugin.
+ * \param[in] cb - pointer to the plugin.
+ * \param[in] blocking - whether the plugin is called directly rather than through its queue.
+ */
+void PluginReplicaSet::register_callback(const std::string &name, boost::shared_ptr<IFrameCallback> cb,
+                                         bool blocking) {
+  boost::mutex::scoped_lock lock(mutex_);
+  if (callbacks_.count(name) || blocking_callbacks_.count(name)) {
+    return;
+  }
+  if (blocking) {
+    blocking_callbacks_[name] = cb;
+  } else {
+    callbacks_[name] = cb;
+  }
+  cb->confirmRegistration(name_);
+}
+
+/** Remove a plugin receiving the frames released by the reorder buffer.
+ *
+ * \param[in] name - index of the plugin.
+ */
+void PluginReplicaSet::remove_callback(const std::string &name) {
+  boost::mutex::scoped_lock lock(mutex_);
+  if (callbacks_.count(name)) {
+    callbacks_[name]->confirmRemoval(name_);
+    callbacks_.erase(name);
+  } else if (blocking_callbacks_.count(name)) {
+    blocking_callbacks_[name]->confirmRemoval(name_);
+    blocking_callbacks_.erase(name);
+  }
+}
+
+/** Remove all plugins receiving the frames released by the reorder buffer.
+ */
+void PluginReplicaSet::remove_all_callbacks() {
+  boost::mutex::scoped_lock lock(mutex_);
+  std::map<std::string, boost::shared_ptr<IFrameCallback> >::iterator iter;
+  for (iter = callbacks_.begin(); iter != callbacks_.end(); ++iter) {
+    iter->second->confirmRemoval(name_);
+  }
+  for (iter = blocking_callbacks_.begin(); iter != blocking_callbacks_.end(); ++iter) {
+    iter->second->confirmRemoval(name_);
+  }
+  callbacks_.clear();
+  blocking_callbacks_.clear();
+}
+
+/** Return the replicas.
+ *
+ * \return the replicas of the plugin.
+ */
+const std::vector<boost::shared_ptr<FrameProcessorPlugin> > &PluginReplicaSet::get_replicas() const {
+  return replicas_;
+}
+
+/** Record the start of processing of a frame by a replica.
+ *
+ * This is called on the thread processing the frame, so that the frames the replica pushes
+ * while processing it are attributed to it. The frame is matched to the next sequence number
+ * dispatched to the replica. A frame not dispatched by the replica set, or given up on, is not
+ * tracked, and anything pushed while processing it is released straight away.
+ *
+ * \param[in] replica - index of the replica.
+ * \param[in] frame - frame the replica is about to process.
+ */
+void PluginReplicaSet::begin_frame(unsigned int replica, boost::shared_ptr<Frame> frame) {
+  boost::mutex::scoped_lock lock(mutex_);
+  current_replica_set = 0;
+  if ((replica >= dispatched_.size()) || dispatched_[replica].empty()) {
+    return;
+  }
+  uint64_t sequence = dispatched_[replica].front();
+  dispatched_[replica].pop_front();
+  if (pending_.count(sequence) == 0) {
+    return;
+  }
+  current_replica_set = this;
+  current_sequence = sequence;
+}
+
+/** Record the end of processing of a frame by a replica.
+ *
+ * Once every replica given the frame is done with it, the frames pushed for it and for any
+ * frames done after it are released, as long as all frames dispatched before it are done or
+ * have been given up on. Frames are released in order, outside the reorder buffer lock.
+ */
+void PluginReplicaSet::end_frame() {
+  if (current_replica_set != this) {
+    return;
+  }
+  current_replica_set = 0;
+
+  boost::unique_lock<boost::mutex> lock(mutex_);
+  std::map<uint64_t, Pending>::iterator iter = pending_.find(current_sequence);
+  if ((iter == pending_.end()) || (--iter->second.remaining > 0)) {
+    return;
+  }
+  std::vector<boost::shared_ptr<Frame> > released;
+  this->release_completed(released);
+  this->release(released, lock);
+}
+
+/** Add a frame pushed by a replica to the reorder buffer.
+ *
+ * The frame is held with the dispatched frame being processed, to be released in turn. Only
+ * one end of acquisition frame is kept for each one dispatched, as every replica pushes it on.
+ * A frame pushed outside the processing of a dispatched frame, or for a frame given up on, is
+ * released straight away.
+ *
+ * \param[in] frame - frame pushed by a replica.
+ */
+void PluginReplicaSet::collect(boost::shared_ptr<Frame> frame) {
+  if (current_replica_set == this) {
+    boost::mutex::scoped_lock lock(mutex_);
+    std::map<uint64_t, Pending>::iterator iter = pending_.find(current_sequence);
+    if (iter != pending_.end()) {
+      std::vector<boost::shared_ptr<Frame> > &outputs = iter->second.outputs;
+      if (frame->get_end_of_acquisition()) {
+        for (size_t index = 0; index < outputs.size(); index++) {
+          if (outputs[index]->get_end_of_acquisition()) {
+            return;
+          }
+        }
+      }
+      outputs.push_back(frame);
+      return;
+    }
+  }
+  this->emit(frame);
+}
+
+/** Add the replica set statistics to a status message.
+ *
+ * The statistics report the number of replicas and frames dispatched, the depth of the queue of
+ * each replica, the number of frames done but held in the reorder buffer behind an earlier frame,
+ * now and at most, and the total time in microseconds frames have been held.
+ *
+ * \param[out] status - status message to add the statistics to.
+ */
+void PluginReplicaSet::status(OdinData::IpcMessage &status) {
+  boost::mutex::scoped_lock lock(mutex_);
+  std::string prefix = name_ + "/replicas/";
+  uint64_t stall_ns = stall_ns_;
+  if (stalled_) {
+    stall_ns += now_ns() - stall_start_ns_;
+  }
+  status.set_param(prefix + "count", (unsigned int)replicas_.size());
+  status.set_param(prefix + "dispatch",
+                   std::string(dispatch_mode_ == DispatchLeastLoaded ? "least_loaded" : "round_robin"));
+  status.set_param(prefix + "frames_dispatched", frames_dispatched_);
+  for (size_t index = 0; index < replicas_.size(); index++) {
+    status.set_param(prefix + "queue_depth[]", replicas_[index]->getWorkQueue()->size());
+  }
+  status.set_param(prefix + "reorder_pending", (unsigned int)pending_.size());
+  status.set_param(prefix + "reorder_held", held_);
+  status.set_param(prefix + "reorder_max_held", max_held_);
+  status.set_param(prefix + "reorder_stall_us", stall_ns / 1000);
+  status.set_param(prefix + "reorder_timeouts", reorder_timeouts_);
+}
+
+/** Reset the replica set statistics.
+ */
+void PluginReplicaSet::reset_statistics() {
+  boost::mutex::scoped_lock lock(mutex_);
+  max_held_ = held_;
+  stall_ns_ = 0;
+  reorder_timeouts_ = 0;
+  stall_start_ns_ = now_ns();
+  frames_dispatched_ = 0;
+}
+
+/** Return the dispatch mode with the given name.
+ *
+ * \param[in] name - "round_robin" or "least_loaded".
+ * \return the dispatch mode.
+ */
+PluginReplicaSet::DispatchMode PluginReplicaSet::get_dispatch_mode(const std::string &name) {
+  if (name == "round_robin") {
+    return DispatchRoundRobin;
+  } else if (name == "least_loaded") {
+    return DispatchLeastLoaded;
+  }
+  throw std::runtime_error("Unknown plugin replica dispatch mode: " + name);
+}
+
+/** Remove the frames pushed for the completed frames at the front of the reorder buffer.
+ *
+ * A frame at the front not done within the reorder timeout of being dispatched is given up on
+ * if a later frame is done, and the frames pushed for it so far released in its place.
+ *
+ * This is called with the reorder buffer lock held.
+ *
+ * \param[out] released - vector the frames to release are appended to, in order.
+ */
+void PluginReplicaSet::release_completed(std::vector<boost::shared_ptr<Frame> > &released) {
+  uint64_t now = now_ns();
+  while (!pending_.empty()) {
+    std::map<uint64_t, Pending>::iterator front = pending_.begin();
+    if (front->second.remaining > 0) {
+      if (now - front->second.dispatch_ns < reorder_timeout_ns_) {
+        break;
+      }
+      bool later_done = false;
+      std::map<uint64_t, Pending>::iterator iter;
+      for (iter = front; iter != pending_.end(); ++iter) {
+        if (iter->second.remaining == 0) {
+          later_done = true;
+          break;
+        }
+      }
+      if (!later_done) {
+        break;
+      }
+      LOG4CXX_WARN(logger_, "Plugin " << name_ << " replicas did not finish frame sequence " << front->first
+                                      << " in time, releasing the frames behind it");
+      reorder_timeouts_++;
+    }
+    std::vector<boost::shared_ptr<Frame> > &outputs = front->second.outputs;
+    released.insert(released.end(), outputs.begin(), outputs.end());
+    pending_.erase(front);
+  }
+
+  held_ = 0;
+  std::map<uint64_t, Pending>::iterator iter;
+  for (iter = pending_.begin(); iter != pending_.end(); ++iter) {
+    if (iter->second.remaining == 0) {
+      held_++;
+    }
+  }
+  if (held_ > max_held_) {
+    max_held_ = held_;
+  }
+  this->update_stall(now);
+}
+
+/** Pass frames released from the reorder buffer to the callbacks, in order.
+ *
+ * This is called with the reorder buffer lock held, and releases it. The release lock is taken
+ * before dropping the reorder buffer lock, so that frames released by different replicas reach
+ * the callbacks in order.
+ *
+ * \param[in] released - frames to release, in order.
+ * \param[in] lock - reorder buffer lock, released on return.
+ */
+void PluginReplicaSet::release(const std::vector<boost::shared_ptr<Frame> > &released,
+                               boost::unique_lock<boost::mutex> &lock) {
+  if (released.empty()) {
+    lock.unlock();
+    return;
+  }
+  std::map<std::string, boost::shared_ptr<IFrameCallback> > callbacks(callbacks_);
+  std::map<std::string, boost::shared_ptr<IFrameCallback> > blocking_callbacks(blocking_callbacks_);
+  boost::mutex::scoped_lock emit_lock(emit_mutex_);
+  lock.unlock();
+
+  std::map<std::string, boost::shared_ptr<IFrameCallback> >::iterator cb;
+  for (cb = blocking_callbacks.begin(); cb != blocking_callbacks.end(); ++cb) {
+    cb->second->callback_batch(released);
+  }
+  for (cb = callbacks.begin(); cb != callbacks.end(); ++cb) {
+    cb->second->enqueue_batch(released);
+  }
+}
+
+/** Release a frame straight to the callbacks.
+ *
+ * \param[in] frame - frame to release.
+ */
+void PluginReplicaSet::emit(boost::shared_ptr<Frame> frame) {
+  std::map<std::string, boost::shared_ptr<IFrameCallback> > callbacks;
+  std::map<std::string, boost::shared_ptr<IFrameCallback> > blocking_callbacks;
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    callbacks = callbacks_;
+    blocking_callbacks = blocking_callbacks_;
+  }
+  std::map<std::string, boost::shared_ptr<IFrameCallback> >::iterator cb;
+  for (cb = blocking_callbacks.begin(); cb != blocking_callbacks.end(); ++cb) {
+    cb->second->callback(frame);
+  }
+  for (cb = callbacks.begin(); cb != callbacks.end(); ++cb) {
+    cb->second->enqueue(frame);
+  }
+}
+
+/** Update the time frames have been held behind an earlier frame.
+ *
+ * This is called with the reorder buffer lock held.
+ *
+ * \param[in] now_ns - current time in nanoseconds.
+ */
+void PluginReplicaSet::update_stall(uint64_t now_ns) {
+  if ((held_ > 0) && !stalled_) {
+    stalled_ = true;
+    stall_start_ns_ = now_ns;
+  } else if ((held_ == 0) && stalled_) {
+    stalled_ = false;
+    stall_ns_ += now_ns - stall_start_ns_;
+  }
+}
+
+} /* namespace FrameProcessor */
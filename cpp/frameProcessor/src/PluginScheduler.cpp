@@ -0,0 +1,208 @@
+/*
+ * PluginScheduler.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "PluginScheduler.h"
+
+#include <stdexcept>
+
+#include "logging.h"
+#include "ThreadPlacement.h"
+#include "IFrameCallback.h"
+
+namespace FrameProcessor {
+
+/** Time a parked worker waits before checking for tasks again, in milliseconds */
+static const unsigned int idle_wait_ms = 10;
+
+/** Scheduler owning the calling thread, if it is a worker thread */
+static __thread const PluginScheduler *current_scheduler = 0;
+
+/** Index of the calling worker thread within its scheduler */
+static __thread unsigned int current_worker = 0;
+
+/** Construct a PluginScheduler, starting its worker threads.
+ *
+ * \param[in] num_threads - number of worker threads.
+ */
+PluginScheduler::PluginScheduler(unsigned int num_threads) :
+    running_(1),
+    pending_(0),
+    next_worker_(0),
+    idle_workers_(0),
+    tasks_run_(0),
+    tasks_stolen_(0) {
+  if (num_threads == 0) {
+    throw std::runtime_error("Plugin scheduler requires at least one worker thread");
+  }
+  for (unsigned int index = 0; index < num_threads; index++) {
+    workers_.push_back(boost::shared_ptr<Worker>(new Worker));
+  }
+  for (unsigned int index = 0; index < num_threads; index++) {
+    threads_.create_thread(boost::bind(&PluginScheduler::run, this, index));
+  }
+}
+
+/** Destructor, stopping the worker threads.
+ */
+PluginScheduler::~PluginScheduler() {
+  this->stop();
+}
+
+/** Schedule a plugin to process the frames waiting on its queue.
+ *
+ * A task scheduled from a worker thread goes on the deque of that worker, to be run next. A
+ * task scheduled from any other thread is dealt to the next worker in turn. Tasks scheduled
+ * once the scheduler has stopped are ignored.
+ *
+ * \param[in] callback - plugin to schedule.
+ */
+void PluginScheduler::submit(IFrameCallback *callback) {
+  if (!__atomic_load_n(&running_, __ATOMIC_ACQUIRE)) {
+    return;
+  }
+  bool local = (current_scheduler == this);
+  unsigned int index = local ? current_worker :
+      __atomic_fetch_add(&next_worker_, 1, __ATOMIC_RELAXED) % workers_.size();
+  size_t queued;
+  {
+    // Count the task before publishing it, so it is never taken before it is counted
+    boost::mutex::scoped_lock lock(workers_[index]->mutex);
+    __atomic_add_fetch(&pending_, 1, __ATOMIC_SEQ_CST);
+    workers_[index]->tasks.push_back(callback);
+    queued = workers_[index]->tasks.size();
+  }
+
+  // A worker runs the tasks it schedules itself in turn, so another is only woken to steal
+  // from it once a backlog builds. Parked workers count themselves before checking for pending
+  // tasks, so one of the two always sees the other.
+  if ((!local || (queued > 1)) && __atomic_load_n(&idle_workers_, __ATOMIC_SEQ_CST)) {
+    boost::mutex::scoped_lock lock(idle_mutex_);
+    idle_cond_.notify_one();
+  }
+}
+
+/** Stop the worker threads, discarding any tasks not yet run.
+ *
+ * Tasks already running are allowed to finish. This must not be called from a worker thread.
+ */
+void PluginScheduler::stop() {
+  if (!__atomic_exchange_n(&running_, 0, __ATOMIC_ACQ_REL)) {
+    return;
+  }
+  {
+    boost::mutex::scoped_lock lock(idle_mutex_);
+    idle_cond_.notify_all();
+  }
+  threads_.join_all();
+  for (size_t index = 0; index < workers_.size(); index++) {
+    workers_[index]->tasks.clear();
+  }
+  __atomic_store_n(&pending_, 0, __ATOMIC_RELAXED);
+}
+
+/** Return whether the calling thread is one of the worker threads.
+ *
+ * \return true if called from a worker thread of this scheduler.
+ */
+bool PluginScheduler::is_worker_thread() const {
+  return current_scheduler == this;
+}
+
+/** Return the number of worker threads.
+ *
+ * \return number of worker threads.
+ */
+unsigned int PluginScheduler::get_num_threads() const {
+  return workers_.size();
+}
+
+/** Add the scheduler statistics to a status message.
+ *
+ * \param[in] prefix - path prefix for the statistics.
+ * \param[out] status - status message to add the statistics to.
+ */
+void PluginScheduler::status(const std::string &prefix, OdinData::IpcMessage &status) const {
+  status.set_param(prefix + "threads", this->get_num_threads());
+  status.set_param(prefix + "pending", __atomic_load_n(&pending_, __ATOMIC_RELAXED));
+  status.set_param(prefix + "tasks_run", __atomic_load_n(&tasks_run_, __ATOMIC_RELAXED));
+  status.set_param(prefix + "tasks_stolen", __atomic_load_n(&tasks_stolen_, __ATOMIC_RELAXED));
+}
+
+/** Main loop of a worker thread.
+ *
+ * The worker runs the most recent task on its own deque, or else steals the oldest task from
+ * another worker, and parks when there are no tasks to run.
+ *
+ * \param[in] index - index of the worker.
+ */
+void PluginScheduler::run(unsigned int index) {
+  // Configure logging for this thread
+  OdinData::configure_logging_mdc(OdinData::app_path.c_str());
+
+  // Register this thread for placement before running any tasks
+  std::string placement_name = OdinData::ThreadPlacement::Instance().register_thread("scheduler");
+
+  current_scheduler = this;
+  current_worker = index;
+  IFrameCallback *task = 0;
+  while (__atomic_load_n(&running_, __ATOMIC_ACQUIRE)) {
+    if (this->take(index, task) || this->steal(index, task)) {
+      task->runScheduled();
+      __atomic_add_fetch(&tasks_run_, 1, __ATOMIC_RELAXED);
+      continue;
+    }
+    boost::mutex::scoped_lock lock(idle_mutex_);
+    __atomic_add_fetch(&idle_workers_, 1, __ATOMIC_SEQ_CST);
+    if (!__atomic_load_n(&pending_, __ATOMIC_SEQ_CST) && __atomic_load_n(&running_, __ATOMIC_ACQUIRE)) {
+      idle_cond_.timed_wait(lock, boost::posix_time::milliseconds(idle_wait_ms));
+    }
+    __atomic_sub_fetch(&idle_workers_, 1, __ATOMIC_RELAXED);
+  }
+  current_scheduler = 0;
+
+  OdinData::ThreadPlacement::Instance().unregister_thread(placement_name);
+}
+
+/** Take the most recent task from the deque of a worker.
+ *
+ * \param[in] index - index of the worker.
+ * \param[out] task - task taken.
+ * \return true if a task was taken.
+ */
+bool PluginScheduler::take(unsigned int index, IFrameCallback *&task) {
+  boost::mutex::scoped_lock lock(workers_[index]->mutex);
+  if (workers_[index]->tasks.empty()) {
+    return false;
+  }
+  task = workers_[index]->tasks.back();
+  workers_[index]->tasks.pop_back();
+  __atomic_sub_fetch(&pending_, 1, __ATOMIC_RELAXED);
+  return true;
+}
+
+/** Steal the oldest task from the deque of another worker.
+ *
+ * \param[in] index - index of the worker stealing.
+ * \param[out] task - task stolen.
+ * \return true if a task was stolen.
+ */
+bool PluginScheduler::steal(unsigned int index, IFrameCallback *&task) {
+  for (size_t offset = 1; offset < workers_.size(); offset++) {
+    Worker &victim = *workers_[(index + offset) % workers_.size()];
+    boost::mutex::scoped_lock lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = victim.tasks.front();
+      victim.tasks.pop_front();
+      __atomic_sub_fetch(&pending_, 1, __ATOMIC_RELAXED);
+      __atomic_add_fetch(&tasks_stolen_, 1, __ATOMIC_RELAXED);
+      return true;
+    }
+  }
+  return false;
+}
+
+} /* namespace FrameProcessor */
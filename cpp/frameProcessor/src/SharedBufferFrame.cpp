@@ -1,18 +1,20 @@
 #include "SharedBufferFrame.h"
 
-#include "IpcMessage.h"
-
 namespace FrameProcessor {
 
 SharedBufferFrame::SharedBufferFrame(const FrameMetaData &meta_data,
                                      void* data_src,
                                      size_t nbytes,
                                      uint64_t bufferID,
-                                     OdinData::IpcChannel *relCh,
+                                     boost::shared_ptr<FrameReleaseQueue> releaseQueue,
                                      const int& image_offset) : Frame(meta_data, nbytes, image_offset) {
   data_ptr_ = data_src;
   shared_id_ = bufferID;
-  shared_channel_ = relCh;
+  release_queue_ = releaseQueue;
+  dispatch_time_ns_ = OdinData::FrameNotification::now_ns();
+  binary_release_ = false;
+  release_rings_ = NULL;
+  release_ring_ = 0;
 }
 
 /** Copy constructor;
@@ -23,19 +25,85 @@ SharedBufferFrame::SharedBufferFrame(const SharedBufferFrame& frame) : Frame(fra
   data_ptr_ = frame.data_ptr_;
   data_size_ = frame.data_size_;
   shared_id_ = frame.shared_id_;
+  release_queue_ = frame.release_queue_;
+  dispatch_time_ns_ = frame.dispatch_time_ns_;
+  binary_release_ = frame.binary_release_;
+  ready_notification_ = frame.ready_notification_;
+  buffer_manager_ = frame.buffer_manager_;
+  release_rings_ = frame.release_rings_;
+  release_ring_ = frame.release_ring_;
 }
 
 /** Destroy frame
  *
  */
 SharedBufferFrame::~SharedBufferFrame () {
-  OdinData::IpcMessage txMsg(OdinData::IpcMessage::MsgTypeNotify,
-                             OdinData::IpcMessage::MsgValNotifyFrameRelease);
-  txMsg.set_param("frame", static_cast<uint64_t>(meta_data_.get_frame_number()));
-  txMsg.set_param("buffer_id", shared_id_);
-  // Now publish the release message, to notify the frame receiver that we are
-  // finished with that block of shared memory
-  shared_channel_->send(txMsg.encode());
+  // Release the shared buffer to notify the frame receiver that we are finished with that block
+  // of shared memory. If the frame was notified through a shared frame ring, release it through
+  // the paired ring. Otherwise queue the release to be sent, in the same format as the frame
+  // ready notification, by the thread owning the release channel, as this may be called from
+  // any plugin thread.
+  OdinData::FrameNotification release(OdinData::FrameNotification::TypeFrameRelease,
+                                      meta_data_.get_frame_number(), shared_id_);
+  if (binary_release_) {
+    release = OdinData::FrameNotification(OdinData::FrameNotification::TypeFrameRelease,
+                                          ready_notification_.get_frame(),
+                                          ready_notification_.get_buffer_id(),
+                                          ready_notification_.get_state());
+    release.set_ready_time_ns(ready_notification_.get_ready_time_ns());
+  }
+  release.set_release_time_ns(OdinData::FrameNotification::now_ns());
+
+  if (release_rings_ && release_rings_->push_release(release_ring_, release)) {
+    return;
+  }
+
+  FrameReleaseQueue::Release queued_release;
+  queued_release.notification = release.get_layout();
+  queued_release.binary = binary_release_;
+  queued_release.dispatch_time_ns = dispatch_time_ns_;
+  release_queue_->push(queued_release);
+}
+
+/** Keep the shared buffer mapped until the frame is destroyed.
+ *
+ * The frame holds a reference to the shared buffer manager, so that the buffer it points into
+ * and the frame rings it is released through remain mapped even if the shared buffer is
+ * reconfigured while the frame is still being processed.
+ *
+ * \param[in] buffer_manager - shared buffer manager mapping the buffer
+ */
+void SharedBufferFrame::set_buffer_manager(boost::shared_ptr<OdinData::SharedBufferManager> buffer_manager) {
+  buffer_manager_ = buffer_manager;
+}
+
+/** Release the shared buffer with a binary notification.
+ *
+ * When the frame is destroyed, a binary frame release notification will be sent in place of
+ * a JSON message, echoing the frame, buffer, state and ready time of the ready notification.
+ *
+ * \param[in] ready_notification - binary frame ready notification for the frame
+ */
+void SharedBufferFrame::set_binary_release(const OdinData::FrameNotification &ready_notification) {
+  binary_release_ = true;
+  ready_notification_ = ready_notification;
+}
+
+/** Release the shared buffer through a shared frame ring.
+ *
+ * When the frame is destroyed, a binary frame release notification will be pushed onto the
+ * release ring paired with the ready ring the frame was notified through, falling back to the
+ * release channel if the ring is full. The rings are those of the shared buffer manager the
+ * frame holds, which must be set first.
+ *
+ * \param[in] ready_notification - binary frame ready notification for the frame
+ * \param[in] ring - index of the ring the frame was notified through
+ */
+void SharedBufferFrame::set_ring_release(const OdinData::FrameNotification &ready_notification,
+                                         unsigned int ring) {
+  this->set_binary_release(ready_notification);
+  release_rings_ = buffer_manager_ ? buffer_manager_->get_frame_rings() : NULL;
+  release_ring_ = ring;
 }
 
 /** Return a void pointer to the raw data.
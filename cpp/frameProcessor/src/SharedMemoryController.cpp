@@ -5,8 +5,11 @@
  *      Author: gnx91527
  */
 
+#include <algorithm>
+
 #include <SharedMemoryController.h>
 #include "DebugLevelLogger.h"
+#include "OdinDataDefaults.h"
 #include "SharedBufferFrame.h"
 #include "EndOfAcquisitionFrame.h"
 
@@ -31,9 +34,29 @@ const std::string SharedMemoryController::SHARED_MEMORY_CONTROLLER_NAME = "share
 SharedMemoryController::SharedMemoryController(boost::shared_ptr<OdinData::IpcReactor> reactor,
                                                const std::string& rxEndPoint,
                                                const std::string& txEndPoint) :
+    ringThreadRunning_(false),
+    ringEOARequested_(false),
+    ringFramesReceived_(0),
+    staleNotifications_(0),
     reactor_(reactor),
     rxChannel_(ZMQ_SUB),
     txChannel_(ZMQ_PUB),
+    readyBatchSize_(OdinData::Defaults::default_frame_ready_batch_size),
+    readyBatchTimeoutMs_(OdinData::Defaults::default_frame_ready_batch_timeout_ms),
+    readyTimerArmed_(false),
+    readyTimerId_(-1),
+    readyBatchesDispatched_(0),
+    readyFramesDispatched_(0),
+    rawDatasetKey_(FrameMetaData::intern("raw")),
+    bufferPoolKey_(FrameMetaData::intern(BUFFER_POOL_PARAM_NAME)),
+    releaseQueue_(new FrameReleaseQueue(OdinData::Defaults::default_frame_release_batch_size)),
+    releaseBatchTimeoutMs_(OdinData::Defaults::default_frame_release_batch_timeout_ms),
+    releaseTimerArmed_(false),
+    releaseTimerId_(-1),
+    releasesSent_(0),
+    releaseMessagesSent_(0),
+    releaseLatencyTotalNs_(0),
+    releaseLatencyMaxNs_(0),
     sharedBufferConfigured_(false),
     sharedBufferConfigRequestDeferred_(false)
 {
@@ -69,6 +92,11 @@ SharedMemoryController::SharedMemoryController(boost::shared_ptr<OdinData::IpcRe
     throw std::runtime_error(e.what());
   }
 
+  // Frame releases are queued by the plugin threads destroying frames and sent on the release
+  // channel by the reactor thread, which is woken through the release queue descriptor
+  reactor_->register_socket(releaseQueue_->get_wakeup_fd(),
+                            boost::bind(&SharedMemoryController::handleReleaseQueue, this));
+
   // Request the shared buffer configuration from the upstream frame receiver process. This is deferred
   // with a one-shot reactor timer to allow the background channel conneciton to take place.
   this->requestSharedBufferConfig(true);
@@ -80,6 +108,19 @@ SharedMemoryController::SharedMemoryController(boost::shared_ptr<OdinData::IpcRe
 SharedMemoryController::~SharedMemoryController()
 {
   LOG4CXX_TRACE(logger_, "Shutting down SharedMemoryController");
+  // Pass on any frames held waiting for a batch to fill
+  if (readyTimerArmed_) {
+    reactor_->remove_timer(readyTimerId_);
+  }
+  this->dispatchFrames(readyFrames_);
+  // Stop any thread consuming shared frame rings
+  this->stopRingThread();
+  // Send any frame releases still queued and stop handling the release queue
+  this->flushReleases();
+  reactor_->remove_socket(releaseQueue_->get_wakeup_fd());
+  if (releaseTimerArmed_) {
+    reactor_->remove_timer(releaseTimerId_);
+  }
   // Close the IPC Channels
   reactor_->remove_channel(txChannel_);
   reactor_->remove_channel(rxChannel_);
@@ -90,6 +131,9 @@ SharedMemoryController::~SharedMemoryController()
 /** setSharedBufferManager
  * Takes a name of shared buffer manager and initialises a SharedBufferManager object
  *
+ * Frames still being processed from the previous shared buffer each hold a reference to its
+ * manager, so it stays mapped until the last of them is released.
+ *
  * \param[in] shared_buffer_name - name of the shared buffer manager
  */
 void SharedMemoryController::setSharedBufferManager(const std::string& shared_buffer_name)
@@ -98,7 +142,9 @@ void SharedMemoryController::setSharedBufferManager(const std::string& shared_bu
   // Set configured status to false until the new shared buffer manager is initialised
   sharedBufferConfigured_ = false;
 
-  // Reset the shared buffer manager if already existing
+  // Stop any thread consuming the frame rings of the existing shared buffer manager, then
+  // reset the manager
+  this->stopRingThread();
   if (sbm_) {
     sbm_.reset();
   }
@@ -108,10 +154,102 @@ void SharedMemoryController::setSharedBufferManager(const std::string& shared_bu
       new OdinData::SharedBufferManager(shared_buffer_name)
   );
 
+  // If the frame receiver hosts frame notification rings in the shared buffer, consume frame
+  // ready notifications from them directly
+  if (sbm_->get_frame_rings()) {
+    this->startRingThread();
+  }
+
   // Set configured status to true
   sharedBufferConfigured_ = true;
 
-  LOG4CXX_DEBUG_LEVEL(1, logger_, "Initialised shared buffer manager for buffer " << shared_buffer_name);
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "Initialised shared buffer manager for buffer " << shared_buffer_name
+                      << " with " << sbm_->get_num_buffers() << " buffers in " << sbm_->get_num_pools()
+                      << " pools and " << sbm_->get_num_frame_rings() << " frame notification rings");
+}
+
+/** Start the thread consuming frame ready notifications from shared frame rings.
+ */
+void SharedMemoryController::startRingThread()
+{
+  ringThreadRunning_ = true;
+  ringThread_ = boost::shared_ptr<boost::thread>(
+      new boost::thread(boost::bind(&SharedMemoryController::ringThreadLoop, this)));
+}
+
+/** Stop the thread consuming frame ready notifications from shared frame rings.
+ */
+void SharedMemoryController::stopRingThread()
+{
+  if (ringThread_) {
+    ringThreadRunning_ = false;
+    ringThread_->join();
+    ringThread_.reset();
+  }
+}
+
+/** Consume frame ready notifications from shared frame rings.
+ *
+ * This is the loop run by the ring thread. It blocks until any frame ready ring is non-empty,
+ * waking periodically to check if it should stop, then drains each ready ring, passing the
+ * frames to the registered callbacks in batches. A batch is passed on once full, or once the
+ * rings are drained if the batch timeout is zero or the first frame in the batch has waited
+ * for it. Each frame is released through the release ring paired with the ready ring it was
+ * notified through. An EOA frame requested by injectEOA() is passed on after the frames drained
+ * from the rings so far, so that it never overtakes a held batch.
+ */
+void SharedMemoryController::ringThreadLoop()
+{
+  OdinData::SharedFrameRings* rings = sbm_->get_frame_rings();
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "Frame ring thread consuming " << rings->get_num_rings() << " rings");
+
+  std::vector<boost::shared_ptr<Frame> > frames;
+  uint64_t batch_deadline_ns = 0;
+  while (ringThreadRunning_) {
+    unsigned int batch_size = __atomic_load_n(&readyBatchSize_, __ATOMIC_RELAXED);
+    unsigned int batch_timeout_ms = __atomic_load_n(&readyBatchTimeoutMs_, __ATOMIC_RELAXED);
+    unsigned int wait_ms = 100;
+    if (!frames.empty()) {
+      uint64_t now_ns = OdinData::FrameNotification::now_ns();
+      wait_ms = (batch_deadline_ns > now_ns) ? ((batch_deadline_ns - now_ns) + 999999) / 1000000 : 0;
+    }
+    if (rings->wait_ready(wait_ms)) {
+      OdinData::FrameNotification ready_notification;
+      for (unsigned int ring = 0; ring < rings->get_num_rings(); ring++) {
+        while (rings->pop_ready(ring, ready_notification)) {
+          LOG4CXX_DEBUG_LEVEL(3, logger_, "Frame ring " << ring << " notified frame "
+                              << ready_notification.get_frame() << " in buffer "
+                              << ready_notification.get_buffer_id());
+          boost::shared_ptr<Frame> frame = this->createFrame(ready_notification.get_frame(),
+                                                             ready_notification.get_buffer_id(),
+                                                             &ready_notification, ring);
+          __atomic_add_fetch(&ringFramesReceived_, 1, __ATOMIC_RELAXED);
+          if (!frame) {
+            continue;
+          }
+          if (frames.empty()) {
+            batch_deadline_ns = OdinData::FrameNotification::now_ns() + batch_timeout_ms * 1000000ULL;
+          }
+          frames.push_back(frame);
+          if (frames.size() >= batch_size) {
+            this->dispatchFrames(frames);
+          }
+        }
+      }
+    }
+    if (!frames.empty() && ((batch_timeout_ms == 0) ||
+                            (OdinData::FrameNotification::now_ns() >= batch_deadline_ns))) {
+      this->dispatchFrames(frames);
+    }
+    if (__atomic_exchange_n(&ringEOARequested_, false, __ATOMIC_ACQ_REL)) {
+      this->dispatchFrames(frames);
+      this->dispatchEOA();
+    }
+  }
+  this->dispatchFrames(frames);
+  if (__atomic_exchange_n(&ringEOARequested_, false, __ATOMIC_ACQ_REL)) {
+    this->dispatchEOA();
+  }
 }
 
 /** Request the shared buffer configuration information from the upstream frame receiver process
@@ -151,17 +289,76 @@ void SharedMemoryController::requestSharedBufferConfig(const bool deferred)
 
 /** Called whenever a new IpcMessage is received to notify that a frame is ready.
  *
- * Reads the raw message bytes from the rxChannel_ and constructs an IpcMessage object
- * from the bytes. Verifies the IpcMessage type and value, and then uses the frame
- * number and buffer ID information to tell the SharedMemoryParser which frame is ready
- * for extraction from shared memory.
- * Loops over registered callbacks and passes the frame to the relevant WorkQueue objects,
- * before sending notifiation that the frame has been released for re-use.
+ * Reads the message from the rxChannel_, along with any further messages already waiting up
+ * to the ready batch size, so that frames notified in a burst are passed to the registered
+ * callbacks together. With a non-zero batch timeout a partial batch is held, and a single-shot
+ * timer is registered to pass it on by the batch deadline, so that the reactor thread is never
+ * blocked waiting for further frames.
  */
 void SharedMemoryController::handleRxChannel()
 {
-  // Receive a message from the main thread channel
-  std::string rxMsgEncoded = rxChannel_.recv();
+  this->handleRxMessage(rxChannel_.recv(), readyFrames_);
+  while ((readyFrames_.size() < readyBatchSize_) && rxChannel_.poll(0)) {
+    this->handleRxMessage(rxChannel_.recv(), readyFrames_);
+  }
+
+  if ((readyBatchTimeoutMs_ == 0) || (readyFrames_.size() >= readyBatchSize_)) {
+    this->dispatchFrames(readyFrames_);
+  } else if (!readyFrames_.empty() && !readyTimerArmed_) {
+    readyTimerArmed_ = true;
+    readyTimerId_ = reactor_->register_timer(readyBatchTimeoutMs_, 1,
+        boost::bind(&SharedMemoryController::readyTimeout, this));
+  }
+}
+
+/** Handle the frame ready batch deadline expiring.
+ *
+ * Passes on any frames held waiting for a batch to fill.
+ */
+void SharedMemoryController::readyTimeout()
+{
+  readyTimerArmed_ = false;
+  this->dispatchFrames(readyFrames_);
+}
+
+/** Handle a message received on the rxChannel_.
+ *
+ * Binary frame ready notifications are decoded directly; otherwise an IpcMessage object is
+ * constructed from the bytes and its type and value verified. The frame number and buffer ID
+ * information are then used to construct a frame from shared memory, which is added to the
+ * batch of frames to pass to the registered callbacks.
+ *
+ * \param[in] rxMsgEncoded - message received.
+ * \param[in,out] frames - batch of frames the frame notified is added to.
+ */
+void SharedMemoryController::handleRxMessage(const std::string& rxMsgEncoded,
+                                             std::vector<boost::shared_ptr<Frame> >& frames)
+{
+  // Handle binary frame ready notifications without decoding as JSON
+  if (OdinData::FrameNotification::is_binary(rxMsgEncoded)) {
+    try {
+      OdinData::FrameNotification ready_notification(rxMsgEncoded);
+      LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread called with binary notification for frame "
+                          << ready_notification.get_frame() << " in buffer "
+                          << ready_notification.get_buffer_id());
+      if (ready_notification.get_type() == OdinData::FrameNotification::TypeFrameReady) {
+        boost::shared_ptr<Frame> frame = this->createFrame(ready_notification.get_frame(),
+                                                           ready_notification.get_buffer_id(),
+                                                           &ready_notification);
+        if (frame) {
+          frames.push_back(frame);
+        }
+      } else {
+        LOG4CXX_ERROR(logger_, "RX thread got unexpected binary notification type "
+                      << ready_notification.get_type());
+      }
+    }
+    catch (OdinData::FrameNotificationException& e)
+    {
+      LOG4CXX_ERROR(logger_, "Error decoding binary frame notification: " << e.what());
+    }
+    return;
+  }
 
   LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread called with message: " << rxMsgEncoded);
 
@@ -174,35 +371,10 @@ void SharedMemoryController::handleRxChannel()
 
       int bufferID = rxMsg.get_param<int>("buffer_id", -1);
       if (bufferID != -1) {
-
-        if (sbm_) {
-
-          // Create a frame object and copy in the raw frame data
-          int frame_number = rxMsg.get_param<int>("frame", 0);
-
-          FrameProcessor::FrameMetaData frame_meta(frame_number,
-                                                    "raw",
-                                                    FrameProcessor::raw_64bit,
-                                                    "",
-                                                    std::vector<unsigned long long>());
-
-          boost::shared_ptr<SharedBufferFrame> frame;
-          frame = boost::shared_ptr<SharedBufferFrame>(new SharedBufferFrame(frame_meta, sbm_->get_buffer_address(bufferID),
-                                    sbm_->get_buffer_size(),
-                                    bufferID,
-                                    &txChannel_));
-
-          // Loop over registered callbacks, placing the frame onto each queue
-          std::map<std::string, boost::shared_ptr<IFrameCallback> >::iterator cbIter;
-          for (cbIter = callbacks_.begin(); cbIter != callbacks_.end(); ++cbIter) {
-            cbIter->second->getWorkQueue()->add(frame, true);
-          }
-
-        } else {
-          LOG4CXX_WARN(logger_, "RX thread got notification for buffer " << bufferID
-                         << " with no shared buffer config - ignoring");
+        boost::shared_ptr<Frame> frame = this->createFrame(rxMsg.get_param<int>("frame", 0), bufferID);
+        if (frame) {
+          frames.push_back(frame);
         }
-
       } else {
         LOG4CXX_ERROR(logger_, "RX thread received empty frame notification with buffer ID");
       }
@@ -213,6 +385,8 @@ void SharedMemoryController::handleRxChannel()
       {
         std::string shared_buffer_name = rxMsg.get_param<std::string>("shared_buffer_name");
         LOG4CXX_DEBUG_LEVEL(1, logger_, "Shared buffer config notification received for " << shared_buffer_name);
+        // Pass on any frames from the current shared buffer first
+        this->dispatchFrames(frames);
         this->setSharedBufferManager(shared_buffer_name);
       }
       catch (OdinData::IpcMessageException& e)
@@ -237,6 +411,248 @@ void SharedMemoryController::handleRxChannel()
   }
 }
 
+/** Set the batching of frame release notifications.
+ *
+ * Frame releases queued by the plugins are sent in batches of up to batch_size releases per
+ * message. A batch is sent as soon as it is full, or once the first release in it has waited
+ * for timeout_ms, so that releases are not held indefinitely at low frame rates.
+ *
+ * \param[in] batch_size - maximum number of releases sent in one message.
+ * \param[in] timeout_ms - maximum time to hold a release waiting for a batch, zero to send
+ *                         the releases queued each time the reactor thread is woken.
+ */
+void SharedMemoryController::setReleaseBatching(unsigned int batch_size, unsigned int timeout_ms)
+{
+  releaseQueue_->set_batch_size(batch_size);
+  releaseBatchTimeoutMs_ = timeout_ms;
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "Frame releases batched up to " << releaseQueue_->get_batch_size()
+                      << " per message with timeout " << releaseBatchTimeoutMs_ << "ms");
+}
+
+/** Set the batching of frames passed to the callbacks.
+ *
+ * Frames notified in a burst are passed to the callbacks in batches of up to batch_size frames,
+ * so that each plugin queue is woken once per batch. By default only the notifications already
+ * waiting are gathered into a batch, while a non-zero timeout_ms holds a partial batch for up to
+ * that long after its first frame for further frames to fill it.
+ *
+ * The settings are stored atomically, as the ring thread reads them while batching the frames
+ * it consumes, and take effect there from its next pass over the rings.
+ *
+ * \param[in] batch_size - maximum number of frames passed on together, one to pass on each frame.
+ * \param[in] timeout_ms - maximum time to hold a frame waiting for a batch.
+ */
+void SharedMemoryController::setReadyBatching(unsigned int batch_size, unsigned int timeout_ms)
+{
+  if (batch_size == 0) {
+    throw std::runtime_error("Frame ready batch size must be greater than zero");
+  }
+  __atomic_store_n(&readyBatchSize_, batch_size, __ATOMIC_RELAXED);
+  __atomic_store_n(&readyBatchTimeoutMs_, timeout_ms, __ATOMIC_RELAXED);
+  if ((readyBatchTimeoutMs_ == 0) || (readyFrames_.size() >= readyBatchSize_)) {
+    this->dispatchFrames(readyFrames_);
+  }
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "Frames passed to plugins in batches of up to " << readyBatchSize_
+                      << " with timeout " << readyBatchTimeoutMs_ << "ms");
+}
+
+/** Handle the release queue being woken.
+ *
+ * Called by the reactor when the release queue descriptor is signalled, either because the
+ * queue has become non-empty or a full batch of releases is pending. A full batch is sent
+ * immediately, otherwise a single-shot timer is registered to send the releases by the batch
+ * deadline.
+ */
+void SharedMemoryController::handleReleaseQueue()
+{
+  releaseQueue_->clear_wakeup();
+  if ((releaseBatchTimeoutMs_ == 0) ||
+      (releaseQueue_->get_pending() >= releaseQueue_->get_batch_size())) {
+    this->flushReleases();
+  } else if (!releaseTimerArmed_) {
+    releaseTimerArmed_ = true;
+    releaseTimerId_ = reactor_->register_timer(releaseBatchTimeoutMs_, 1,
+        boost::bind(&SharedMemoryController::releaseTimeout, this));
+  }
+}
+
+/** Handle the release batch deadline expiring.
+ */
+void SharedMemoryController::releaseTimeout()
+{
+  releaseTimerArmed_ = false;
+  this->flushReleases();
+}
+
+/** Send the queued frame releases.
+ *
+ * Drains the releases queued when called, sending them on the release channel in batches in
+ * the format each frame was notified with. The latency between dispatching each frame and
+ * sending its release is accumulated for status. Releases queued while draining are left for
+ * the next flush, with the reactor thread woken to ensure they are sent.
+ */
+void SharedMemoryController::flushReleases()
+{
+  unsigned int batch_size = releaseQueue_->get_batch_size();
+  unsigned int num_releases = releaseQueue_->get_pending();
+  std::vector<OdinData::FrameNotification> binary_releases;
+  std::vector<OdinData::FrameNotification> json_releases;
+  uint64_t now_ns = OdinData::FrameNotification::now_ns();
+
+  FrameReleaseQueue::Release release;
+  for (unsigned int count = 0; (count < num_releases) && releaseQueue_->pop(release); count++) {
+    uint64_t latency_ns = (now_ns > release.dispatch_time_ns) ? now_ns - release.dispatch_time_ns : 0;
+    releaseLatencyTotalNs_ += latency_ns;
+    releaseLatencyMaxNs_ = std::max(releaseLatencyMaxNs_, latency_ns);
+
+    std::vector<OdinData::FrameNotification>& releases = release.binary ? binary_releases : json_releases;
+    releases.push_back(OdinData::FrameNotification(release.notification));
+    if (releases.size() >= batch_size) {
+      this->sendReleases(releases, release.binary);
+      releases.clear();
+    }
+  }
+  if (!binary_releases.empty()) {
+    this->sendReleases(binary_releases, true);
+  }
+  if (!json_releases.empty()) {
+    this->sendReleases(json_releases, false);
+  }
+
+  if (releaseQueue_->get_pending()) {
+    releaseQueue_->wakeup();
+  }
+}
+
+/** Send a batch of frame releases on the release channel.
+ *
+ * Binary releases are sent as concatenated binary notifications. A single JSON release is sent
+ * as a plain frame release message, while a batch of JSON releases is sent as one message with
+ * arrays of frame numbers and buffer IDs.
+ *
+ * \param[in] releases - frame releases to send.
+ * \param[in] binary - true to send binary notifications.
+ */
+void SharedMemoryController::sendReleases(const std::vector<OdinData::FrameNotification>& releases,
+                                          bool binary)
+{
+  std::vector<OdinData::FrameNotification>::const_iterator it;
+  if (binary) {
+    std::string encoded;
+    encoded.reserve(releases.size() * sizeof(OdinData::FrameNotification::Layout));
+    for (it = releases.begin(); it != releases.end(); ++it) {
+      it->encode_to_batch(encoded);
+    }
+    txChannel_.send(encoded);
+  } else {
+    OdinData::IpcMessage txMsg(OdinData::IpcMessage::MsgTypeNotify,
+                               OdinData::IpcMessage::MsgValNotifyFrameRelease);
+    if (releases.size() == 1) {
+      txMsg.set_param("frame", releases[0].get_frame());
+      txMsg.set_param("buffer_id", releases[0].get_buffer_id());
+    } else {
+      for (it = releases.begin(); it != releases.end(); ++it) {
+        txMsg.set_param("frames[]", it->get_frame());
+        txMsg.set_param("buffer_ids[]", it->get_buffer_id());
+      }
+    }
+    txChannel_.send(txMsg.encode());
+  }
+  releasesSent_ += releases.size();
+  releaseMessagesSent_++;
+  LOG4CXX_DEBUG_LEVEL(3, logger_, "Sent " << releases.size() << " frame releases in one message");
+}
+
+/** Construct a frame from shared memory.
+ *
+ * Creates a frame object referencing the shared memory buffer that is ready. The shared buffer
+ * is released once the frame is destroyed, with a binary notification if the frame was made
+ * ready with one. If the shared buffer hosts a buffer state table, the buffer is first marked as
+ * held by this process. Should the buffer no longer be ready with the notified frame, because
+ * the frame receiver has reclaimed it after its lease expired, the notification is ignored.
+ *
+ * \param[in] frame_number - frame number contained in the buffer.
+ * \param[in] bufferID - ID of the shared buffer that is ready.
+ * \param[in] ready_notification - binary ready notification, NULL if notified with JSON.
+ * \param[in] ring - index of the shared frame ring notifying the frame, -1 if notified on the channel.
+ * \return the frame, or a null pointer if the notification is ignored.
+ */
+boost::shared_ptr<Frame> SharedMemoryController::createFrame(long long frame_number, int bufferID,
+                                                             const OdinData::FrameNotification* ready_notification,
+                                                             int ring)
+{
+  boost::shared_ptr<SharedBufferFrame> frame;
+
+  if (sbm_) {
+
+    // Take the buffer from the frame receiver, unless it has since been reclaimed
+    OdinData::SharedBufferStates* buffer_states = sbm_->get_buffer_states();
+    if (buffer_states && !buffer_states->acquire(bufferID, static_cast<uint64_t>(frame_number))) {
+      LOG4CXX_WARN(logger_, "Ignoring notification of frame " << frame_number << " in buffer "
+                     << bufferID << " as the buffer is no longer ready");
+      __atomic_add_fetch(&staleNotifications_, 1, __ATOMIC_RELAXED);
+      return frame;
+    }
+
+    // Create a frame object and copy in the raw frame data
+    FrameProcessor::FrameMetaData frame_meta(frame_number,
+                                              rawDatasetKey_,
+                                              FrameProcessor::raw_64bit,
+                                              "",
+                                              std::vector<unsigned long long>());
+
+    // Where the shared buffer holds several pools of buffers, e.g. images and smaller sideband
+    // frames, record the pool the frame was received into so that plugins can tell them apart
+    if (sbm_->get_num_pools() > 1) {
+      frame_meta.set_parameter<unsigned int>(bufferPoolKey_, sbm_->get_buffer_pool(bufferID));
+    }
+
+    frame = boost::shared_ptr<SharedBufferFrame>(new SharedBufferFrame(frame_meta, sbm_->get_buffer_address(bufferID),
+                              sbm_->get_buffer_size(bufferID),
+                              bufferID,
+                              releaseQueue_));
+    frame->set_buffer_manager(sbm_);
+    if (ready_notification && (ring >= 0)) {
+      frame->set_ring_release(*ready_notification, ring);
+    } else if (ready_notification) {
+      frame->set_binary_release(*ready_notification);
+    }
+
+  } else {
+    LOG4CXX_WARN(logger_, "RX thread got notification for buffer " << bufferID
+                   << " with no shared buffer config - ignoring");
+  }
+  return frame;
+}
+
+/** Pass a batch of frames to the registered callbacks.
+ *
+ * Loops over registered callbacks, placing the batch of frames onto each WorkQueue together,
+ * and then clears the batch.
+ *
+ * \param[in,out] frames - frames to pass on, in order.
+ */
+void SharedMemoryController::dispatchFrames(std::vector<boost::shared_ptr<Frame> >& frames)
+{
+  if (frames.empty()) {
+    return;
+  }
+  {
+    boost::mutex::scoped_lock lock(callbacksMutex_);
+    std::map<std::string, boost::shared_ptr<IFrameCallback> >::iterator cbIter;
+    for (cbIter = callbacks_.begin(); cbIter != callbacks_.end(); ++cbIter) {
+      if (frames.size() == 1) {
+        cbIter->second->enqueue(frames[0], true);
+      } else {
+        cbIter->second->enqueue_batch(frames, true);
+      }
+    }
+  }
+  __atomic_add_fetch(&readyBatchesDispatched_, 1, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&readyFramesDispatched_, frames.size(), __ATOMIC_RELAXED);
+  frames.clear();
+}
+
 /** Register a callback for Frame updates with this class.
  *
  * The callback (IFrameCallback subclass) is added to the map of callbacks, indexed
@@ -248,6 +664,7 @@ void SharedMemoryController::handleRxChannel()
  */
 void SharedMemoryController::registerCallback(const std::string& name, boost::shared_ptr<IFrameCallback> cb)
 {
+  boost::mutex::scoped_lock lock(callbacksMutex_);
   // Check if we own the callback already
   if (callbacks_.count(name) == 0) {
     // Record the callback pointer
@@ -266,6 +683,7 @@ void SharedMemoryController::registerCallback(const std::string& name, boost::sh
 void SharedMemoryController::removeCallback(const std::string& name)
 {
   boost::shared_ptr<IFrameCallback> cb;
+  boost::mutex::scoped_lock lock(callbacksMutex_);
   if (callbacks_.count(name) > 0) {
     // Get the pointer
     cb = callbacks_[name];
@@ -287,21 +705,71 @@ void SharedMemoryController::status(OdinData::IpcMessage& status)
   status.set_param(
       SharedMemoryController::SHARED_MEMORY_CONTROLLER_NAME + "/configured",
       sharedBufferConfigured_);
+  status.set_param(
+      SharedMemoryController::SHARED_MEMORY_CONTROLLER_NAME + "/frame_rings",
+      sbm_ ? sbm_->get_num_frame_rings() : 0);
+  status.set_param(
+      SharedMemoryController::SHARED_MEMORY_CONTROLLER_NAME + "/ring_frames_received",
+      __atomic_load_n(&ringFramesReceived_, __ATOMIC_RELAXED));
+  status.set_param(
+      SharedMemoryController::SHARED_MEMORY_CONTROLLER_NAME + "/buffer_states",
+      (sbm_ && sbm_->get_buffer_states()) ? true : false);
+  status.set_param(
+      SharedMemoryController::SHARED_MEMORY_CONTROLLER_NAME + "/stale_notifications",
+      __atomic_load_n(&staleNotifications_, __ATOMIC_RELAXED));
+  status.set_param(
+      SharedMemoryController::SHARED_MEMORY_CONTROLLER_NAME + "/ready_batches",
+      __atomic_load_n(&readyBatchesDispatched_, __ATOMIC_RELAXED));
+  status.set_param(
+      SharedMemoryController::SHARED_MEMORY_CONTROLLER_NAME + "/ready_frames",
+      __atomic_load_n(&readyFramesDispatched_, __ATOMIC_RELAXED));
+  status.set_param(
+      SharedMemoryController::SHARED_MEMORY_CONTROLLER_NAME + "/releases_sent",
+      releasesSent_);
+  status.set_param(
+      SharedMemoryController::SHARED_MEMORY_CONTROLLER_NAME + "/release_messages_sent",
+      releaseMessagesSent_);
+  status.set_param(
+      SharedMemoryController::SHARED_MEMORY_CONTROLLER_NAME + "/release_latency_mean_us",
+      releasesSent_ ? (releaseLatencyTotalNs_ / releasesSent_) / 1000 : 0);
+  status.set_param(
+      SharedMemoryController::SHARED_MEMORY_CONTROLLER_NAME + "/release_latency_max_us",
+      releaseLatencyMaxNs_ / 1000);
 
 }
 
 /**
  * Create an EndOfAcquisitionFrame object and inject it into the plugin chain
+ *
+ * Any frames held waiting for a batch are passed on ahead of the EOA frame. When frames are
+ * consumed from shared frame rings, the EOA frame is handed to the ring thread, which passes it
+ * on once it has passed on the frames it holds.
  */
 void SharedMemoryController::injectEOA()
+{
+  this->dispatchFrames(readyFrames_);
+
+  if (ringThread_) {
+    __atomic_store_n(&ringEOARequested_, true, __ATOMIC_RELEASE);
+    sbm_->get_frame_rings()->interrupt_wait();
+  } else {
+    this->dispatchEOA();
+  }
+}
+
+/**
+ * Pass an EndOfAcquisitionFrame object to the registered callbacks
+ */
+void SharedMemoryController::dispatchEOA()
 {
   // Create the EOA frame object
   boost::shared_ptr<FrameProcessor::EndOfAcquisitionFrame> eoa = boost::shared_ptr<FrameProcessor::EndOfAcquisitionFrame>(new FrameProcessor::EndOfAcquisitionFrame());
 
   // Loop over registered callbacks, placing the frame onto each queue
+  boost::mutex::scoped_lock lock(callbacksMutex_);
   std::map<std::string, boost::shared_ptr<IFrameCallback> >::iterator cbIter;
   for (cbIter = callbacks_.begin(); cbIter != callbacks_.end(); ++cbIter) {
-    cbIter->second->getWorkQueue()->add(eoa, true);
+    cbIter->second->enqueue(eoa, true);
   }
 }
 
@@ -9,6 +9,7 @@
 
 #include "logging.h"
 #include "DebugLevelLogger.h"
+#include "ThreadPlacement.h"
 
 #define WARNING_DURATION_FRACTION 0.1  // Fraction of error duration that will cause a warning to be logged
 
@@ -90,6 +91,7 @@ unsigned int WatchdogTimer::finish_timer() {
  */
 void WatchdogTimer::run() {
   OdinData::configure_logging_mdc(OdinData::app_path.c_str());
+  std::string placement_name = OdinData::ThreadPlacement::Instance().register_thread("watchdog");
 
   // We are ready - Let the constructor return
   worker_thread_running_ = true;
@@ -97,6 +99,8 @@ void WatchdogTimer::run() {
   // Register a repeating timer to keep the reactor alive and check for shutdown every millisecond
   reactor_.register_timer(1, 0, boost::bind(&WatchdogTimer::heartbeat, this));
   reactor_.run();
+
+  OdinData::ThreadPlacement::Instance().unregister_thread(placement_name);
 }
 
 /**
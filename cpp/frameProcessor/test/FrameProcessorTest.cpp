@@ -2,6 +2,8 @@
  * FileWriterTest.cpp
  *
  */
+#include <unistd.h>
+
 #include "DebugLevelLogger.h"
 
 #include <boost/test/unit_test.hpp>
@@ -21,6 +23,13 @@ using namespace log4cxx::xml;
 #include "DataBlock.h"
 #include "DataBlockPool.h"
 #include "DataBlockFrame.h"
+#include "SharedBufferFrame.h"
+#include "FrameReleaseQueue.h"
+#include "MissingPacketFill.h"
+#include "WorkQueue.h"
+#include "PluginScheduler.h"
+#include "PluginReplicaSet.h"
+#include "IFrameCallback.h"
 #include "FileWriterPlugin.h"
 #include "Acquisition.h"
 #include "FrameProcessorDefinitions.h"
@@ -162,6 +171,605 @@ BOOST_AUTO_TEST_CASE( DataBlockFrameTest )
   BOOST_CHECK_EQUAL(img_copy[11], img[11]);
 }
 
+BOOST_AUTO_TEST_CASE( FrameMetaDataParameterTest )
+{
+  // Names are interned to the same key wherever they are set
+  FrameProcessor::MetaDataKey dataset_key = FrameProcessor::FrameMetaData::intern("data");
+  BOOST_CHECK_EQUAL(FrameProcessor::FrameMetaData::intern(""), FrameProcessor::FrameMetaData::empty_key);
+  BOOST_CHECK_EQUAL(FrameProcessor::FrameMetaData::key_name(dataset_key), "data");
+  FrameProcessor::FrameMetaData frame_meta(
+      3, "data", FrameProcessor::raw_16bit, "test", dimensions_t(), FrameProcessor::no_compression
+  );
+  BOOST_CHECK_EQUAL(frame_meta.get_dataset_key(), dataset_key);
+  BOOST_CHECK_EQUAL(frame_meta.get_dataset_name(), "data");
+  BOOST_CHECK_EQUAL(frame_meta.get_acquisition_ID(), "test");
+  frame_meta.set_acquisition_ID("");
+  BOOST_CHECK_EQUAL(frame_meta.get_acquisition_ID(), "");
+
+  // Acquisition IDs change every run so are shared between frames rather than interned
+  frame_meta.set_acquisition_ID("meta_test_acquisition");
+  FrameProcessor::FrameMetaData frame_meta_copy(frame_meta);
+  BOOST_CHECK_EQUAL(frame_meta_copy.get_acquisition_ID(), "meta_test_acquisition");
+  BOOST_CHECK_EQUAL(&frame_meta_copy.get_acquisition_ID(), &frame_meta.get_acquisition_ID());
+  FrameProcessor::MetaDataKey acquisition_key;
+  BOOST_CHECK(!FrameProcessor::FrameMetaData::find_key("meta_test_acquisition", acquisition_key));
+
+  // Parameters are returned with the type they were set with, by name or key
+  FrameProcessor::MetaDataKey sum_key = FrameProcessor::FrameMetaData::intern("meta_test_sum");
+  frame_meta.set_parameter<uint64_t>(sum_key, 78);
+  frame_meta.set_parameter<uint16_t>("meta_test_gain", 3);
+  frame_meta.set_parameter<float>("meta_test_scale", 0.5);
+  frame_meta.set_parameter<std::string>("meta_test_mode", "fast");
+  frame_meta.set_parameter<int8_t>("meta_test_flag", -1);
+  BOOST_CHECK_EQUAL(frame_meta.get_parameter_count(), 5);
+  BOOST_CHECK_EQUAL(frame_meta.get_parameter<uint64_t>("meta_test_sum"), 78);
+  BOOST_CHECK_EQUAL(frame_meta.get_parameter<uint16_t>("meta_test_gain"), 3);
+  BOOST_CHECK_EQUAL(frame_meta.get_parameter<float>("meta_test_scale"), 0.5);
+  BOOST_CHECK_EQUAL(frame_meta.get_parameter<std::string>("meta_test_mode"), "fast");
+  BOOST_CHECK_EQUAL(frame_meta.get_parameter<int8_t>("meta_test_flag"), -1);
+  BOOST_CHECK(frame_meta.has_parameter(sum_key));
+  BOOST_CHECK(!frame_meta.has_parameter("meta_test_missing"));
+  BOOST_CHECK_THROW(frame_meta.get_parameter<uint32_t>(sum_key), std::runtime_error);
+  BOOST_CHECK_THROW(frame_meta.get_parameter<uint64_t>("meta_test_missing"), std::runtime_error);
+
+  // Setting a parameter again replaces its value and type
+  frame_meta.set_parameter<uint32_t>(sum_key, 79);
+  BOOST_CHECK_EQUAL(frame_meta.get_parameter_count(), 5);
+  BOOST_CHECK_EQUAL(frame_meta.get_parameter<uint32_t>(sum_key), 79);
+
+  // Copies hold their own parameters
+  FrameProcessor::FrameMetaData copy(frame_meta);
+  copy.set_parameter<uint32_t>(sum_key, 80);
+  BOOST_CHECK_EQUAL(frame_meta.get_parameter<uint32_t>(sum_key), 79);
+  BOOST_CHECK_EQUAL(copy.get_parameter<uint32_t>(sum_key), 80);
+  BOOST_CHECK_EQUAL(copy.get_parameter<std::string>("meta_test_mode"), "fast");
+
+  std::map<std::string, boost::any> parameters = frame_meta.get_parameters();
+  BOOST_CHECK_EQUAL(parameters.size(), 5);
+  BOOST_CHECK_EQUAL(boost::any_cast<uint32_t>(parameters["meta_test_sum"]), 79);
+  BOOST_CHECK_EQUAL(boost::any_cast<std::string>(parameters["meta_test_mode"]), "fast");
+}
+
+BOOST_AUTO_TEST_CASE( SharedBufferFrameReleaseTest )
+{
+  char buffer[24];
+  boost::shared_ptr<FrameProcessor::FrameReleaseQueue> release_queue(
+      new FrameProcessor::FrameReleaseQueue(2));
+  FrameProcessor::FrameMetaData frame_meta(5, "raw", FrameProcessor::raw_64bit, "", dimensions_t());
+
+  // Destroying a shared buffer frame should queue a JSON release for its buffer
+  {
+    FrameProcessor::SharedBufferFrame frame(frame_meta, static_cast<void*>(buffer), 24, 3, release_queue);
+  }
+  BOOST_CHECK_EQUAL(release_queue->get_pending(), 1);
+
+  // Destroying a frame notified with a binary notification should queue a binary release
+  {
+    FrameProcessor::SharedBufferFrame frame(frame_meta, static_cast<void*>(buffer), 24, 4, release_queue);
+    frame.set_binary_release(OdinData::FrameNotification(OdinData::FrameNotification::TypeFrameReady,
+                                                         5, 4, OdinData::FrameNotification::StateComplete));
+  }
+  BOOST_CHECK_EQUAL(release_queue->get_pending(), 2);
+
+  FrameProcessor::FrameReleaseQueue::Release release;
+  BOOST_REQUIRE(release_queue->pop(release));
+  BOOST_CHECK_EQUAL(release.binary, false);
+  BOOST_CHECK_EQUAL(release.notification.frame, 5);
+  BOOST_CHECK_EQUAL(release.notification.buffer_id, 3);
+  BOOST_CHECK(release.notification.release_time_ns >= release.dispatch_time_ns);
+
+  BOOST_REQUIRE(release_queue->pop(release));
+  BOOST_CHECK_EQUAL(release.binary, true);
+  BOOST_CHECK_EQUAL(release.notification.type, OdinData::FrameNotification::TypeFrameRelease);
+  BOOST_CHECK_EQUAL(release.notification.buffer_id, 4);
+  BOOST_CHECK_EQUAL(release.notification.state, OdinData::FrameNotification::StateComplete);
+  BOOST_CHECK(release.notification.ready_time_ns > 0);
+
+  BOOST_CHECK(!release_queue->pop(release));
+  BOOST_CHECK_EQUAL(release_queue->get_pending(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( FrameReleaseQueueWakeupTest )
+{
+  FrameProcessor::FrameReleaseQueue release_queue(3);
+  FrameProcessor::FrameReleaseQueue::Release release;
+  memset(&release, 0, sizeof(release));
+  uint64_t wakeups = 0;
+
+  // The first release queued should wake the draining thread, as should a full batch
+  BOOST_CHECK_EQUAL(read(release_queue.get_wakeup_fd(), &wakeups, sizeof(wakeups)), -1);
+  release_queue.push(release);
+  BOOST_CHECK_EQUAL(read(release_queue.get_wakeup_fd(), &wakeups, sizeof(wakeups)), sizeof(wakeups));
+  release_queue.push(release);
+  BOOST_CHECK_EQUAL(read(release_queue.get_wakeup_fd(), &wakeups, sizeof(wakeups)), -1);
+  release_queue.push(release);
+  BOOST_CHECK_EQUAL(read(release_queue.get_wakeup_fd(), &wakeups, sizeof(wakeups)), sizeof(wakeups));
+  BOOST_CHECK_EQUAL(release_queue.get_pending(), 3);
+
+  while (release_queue.pop(release));
+  BOOST_CHECK_EQUAL(release_queue.get_pending(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( MissingPacketFillTest )
+{
+  const std::size_t num_packets = 100;
+  const std::size_t packet_size = 6;
+  std::vector<OdinData::PacketStateBitmap::Word> words(OdinData::PacketStateBitmap::num_words(num_packets));
+  OdinData::PacketStateBitmap packet_state(&words[0], num_packets);
+  packet_state.clear();
+  for (std::size_t packet = 0; packet < num_packets; packet++) {
+    if (packet != 10 && (packet < 62 || packet > 66)) {
+      packet_state.mark_received(packet);
+    }
+  }
+
+  // Missing packets are zero filled, leaving received packets untouched
+  std::vector<char> payload(num_packets * packet_size, 0x11);
+  FrameProcessor::MissingPacketFill zero_fill;
+  BOOST_CHECK_EQUAL(zero_fill.fill(packet_state, &payload[0], packet_size), 6);
+  BOOST_CHECK_EQUAL(payload[(10 * packet_size) - 1], 0x11);
+  BOOST_CHECK_EQUAL(payload[10 * packet_size], 0);
+  BOOST_CHECK_EQUAL(payload[(11 * packet_size) - 1], 0);
+  BOOST_CHECK_EQUAL(payload[11 * packet_size], 0x11);
+  BOOST_CHECK_EQUAL(payload[(67 * packet_size) - 1], 0);
+  BOOST_CHECK_EQUAL(payload[67 * packet_size], 0x11);
+
+  // A pattern is repeated over each missing range from its start
+  const uint16_t pattern = 0xABCD;
+  FrameProcessor::MissingPacketFill pattern_fill(&pattern, sizeof(pattern));
+  BOOST_CHECK_EQUAL(pattern_fill.fill(packet_state, &payload[0], packet_size), 6);
+  const uint16_t* pixels = reinterpret_cast<const uint16_t*>(&payload[62 * packet_size]);
+  for (std::size_t pixel = 0; pixel < (5 * packet_size) / sizeof(uint16_t); pixel++) {
+    BOOST_CHECK_EQUAL(pixels[pixel], pattern);
+  }
+  BOOST_CHECK_EQUAL(payload[67 * packet_size], 0x11);
+
+  BOOST_CHECK_THROW(FrameProcessor::MissingPacketFill(&pattern, 0), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( WorkQueueOrderAndOverflowTest )
+{
+  FrameProcessor::WorkQueue<int> queue(4);
+  BOOST_CHECK_EQUAL(queue.capacity(), 4);
+  BOOST_CHECK_EQUAL(queue.max_depth(), FrameProcessor::max_queue_size);
+  BOOST_CHECK_THROW(queue.set_max_depth(0), std::runtime_error);
+  BOOST_CHECK_THROW(queue.set_max_depth(5), std::runtime_error);
+
+  // Items added beyond the ring capacity overflow, and are removed after the ring in order
+  for (int item = 0; item < 7; item++) {
+    queue.add(item, true);
+  }
+  BOOST_CHECK_EQUAL(queue.size(), 7);
+  BOOST_CHECK_EQUAL(queue.high_water(), 7);
+  BOOST_CHECK_EQUAL(queue.remove(), 0);
+  queue.add(7, true);
+  std::vector<int> batch;
+  BOOST_CHECK_EQUAL(queue.remove_batch(batch, 5), 5);
+  BOOST_CHECK_EQUAL(queue.remove_batch(batch, 5), 2);
+  BOOST_REQUIRE_EQUAL(batch.size(), 7);
+  for (int item = 0; item < 7; item++) {
+    BOOST_CHECK_EQUAL(batch[item], item + 1);
+  }
+  BOOST_CHECK_EQUAL(queue.size(), 0);
+
+  queue.reset_stats();
+  BOOST_CHECK_EQUAL(queue.high_water(), 0);
+  BOOST_CHECK_EQUAL(queue.producer_block_us(), 0);
+  BOOST_CHECK_EQUAL(queue.consumer_idle_us(), 0);
+}
+
+void work_queue_consume(FrameProcessor::WorkQueue<int>* queue, std::vector<int>* items, int count)
+{
+  while ((int)items->size() < count) {
+    usleep(100);
+    queue->remove_batch(*items, 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( WorkQueueDepthBlocksProducersTest )
+{
+  FrameProcessor::WorkQueue<int> queue(16);
+  queue.set_max_depth(2);
+  std::vector<int> items;
+  const int count = 200;
+  boost::thread consumer(work_queue_consume, &queue, &items, count);
+  for (int item = 0; item < count; item++) {
+    queue.add(item);
+    BOOST_CHECK_LE(queue.size(), 3);
+  }
+  consumer.join();
+
+  // Producers block at the configured depth, and every item arrives in order
+  BOOST_CHECK_LE(queue.high_water(), 3);
+  BOOST_REQUIRE_EQUAL(items.size(), count);
+  for (int item = 0; item < count; item++) {
+    BOOST_CHECK_EQUAL(items[item], item);
+  }
+  BOOST_CHECK_GT(queue.producer_block_us(), 0);
+}
+
+static void drain_work_queue(FrameProcessor::WorkQueue<int> *queue, std::vector<int> *removed, size_t count)
+{
+  while (removed->size() < count) {
+    queue->remove_batch(*removed, count);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( WorkQueueAddBatchTest )
+{
+  FrameProcessor::WorkQueue<int> queue;
+  std::vector<int> items;
+  const int count = 2000;
+  for (int item = 0; item < count; item++) {
+    items.push_back(item);
+  }
+
+  // A batch larger than the ring overflows in order
+  queue.add_batch(items, true);
+  BOOST_CHECK_EQUAL(queue.size(), count);
+  BOOST_CHECK_EQUAL(queue.high_water(), count);
+  std::vector<int> removed;
+  while (removed.size() < (size_t)count) {
+    queue.remove_batch(removed, 64);
+  }
+  for (int item = 0; item < count; item++) {
+    BOOST_CHECK_EQUAL(removed[item], item);
+  }
+
+  // A producer adding a batch beyond the maximum depth blocks until the parked consumer
+  // drains the items already added
+  removed.clear();
+  items.resize(20);
+  boost::thread consumer(boost::bind(&drain_work_queue, &queue, &removed, items.size()));
+  usleep(10000);
+  queue.add_batch(items);
+  consumer.join();
+  BOOST_CHECK_LE(queue.high_water(), count);
+  BOOST_CHECK_GT(queue.producer_block_us(), 0);
+  for (size_t item = 0; item < items.size(); item++) {
+    BOOST_CHECK_EQUAL(removed[item], (int)item);
+  }
+}
+
+class SerialCountingCallback : public FrameProcessor::IFrameCallback
+{
+public:
+  SerialCountingCallback() : active(0), overlaps(0), next_frame(0), out_of_order(0), frames(0) {}
+  void callback(boost::shared_ptr<FrameProcessor::Frame> frame)
+  {
+    if (__atomic_add_fetch(&active, 1, __ATOMIC_ACQ_REL) > 1) {
+      __atomic_add_fetch(&overlaps, 1, __ATOMIC_RELAXED);
+    }
+    if (frame->get_frame_number() != next_frame) {
+      out_of_order++;
+    }
+    next_frame = frame->get_frame_number() + 1;
+    usleep(10);
+    __atomic_add_fetch(&frames, 1, __ATOMIC_RELEASE);
+    __atomic_sub_fetch(&active, 1, __ATOMIC_ACQ_REL);
+  }
+  int active;
+  int overlaps;
+  long long next_frame;
+  int out_of_order;
+  int frames;
+};
+
+BOOST_AUTO_TEST_CASE( PluginSchedulerSerialisesEachPluginTest )
+{
+  boost::shared_ptr<FrameProcessor::PluginScheduler> scheduler(new FrameProcessor::PluginScheduler(4));
+  BOOST_CHECK_EQUAL(scheduler->get_num_threads(), 4);
+  BOOST_CHECK(!scheduler->is_worker_thread());
+
+  std::vector<boost::shared_ptr<SerialCountingCallback> > callbacks;
+  for (int index = 0; index < 3; index++) {
+    callbacks.push_back(boost::shared_ptr<SerialCountingCallback>(new SerialCountingCallback));
+    callbacks[index]->setScheduler(scheduler);
+    callbacks[index]->start();
+  }
+
+  const int num_frames = 200;
+  unsigned short img[12] = {0};
+  for (int frame_number = 0; frame_number < num_frames; frame_number++) {
+    FrameProcessor::FrameMetaData frame_meta(
+        frame_number, "data", FrameProcessor::raw_16bit, "test", dimensions_t(), FrameProcessor::no_compression
+    );
+    boost::shared_ptr<FrameProcessor::Frame> frame(
+        new FrameProcessor::DataBlockFrame(frame_meta, static_cast<void*>(img), 24));
+    for (int index = 0; index < 3; index++) {
+      callbacks[index]->enqueue(frame);
+    }
+  }
+
+  // Each plugin sees every frame in order, never on two threads at once
+  for (int index = 0; index < 3; index++) {
+    int waits = 0;
+    while ((__atomic_load_n(&callbacks[index]->frames, __ATOMIC_ACQUIRE) < num_frames) && (waits++ < 5000)) {
+      usleep(1000);
+    }
+    BOOST_CHECK_EQUAL(callbacks[index]->frames, num_frames);
+    BOOST_CHECK_EQUAL(callbacks[index]->overlaps, 0);
+    BOOST_CHECK_EQUAL(callbacks[index]->out_of_order, 0);
+    callbacks[index]->stop();
+  }
+  scheduler->stop();
+
+  OdinData::IpcMessage status;
+  scheduler->status("scheduler/", status);
+  BOOST_CHECK_EQUAL(status.get_param<unsigned int>("scheduler/threads"), 4);
+  BOOST_CHECK_GT(status.get_param<uint64_t>("scheduler/tasks_run"), 0);
+}
+
+class ForwardingCallback : public FrameProcessor::IFrameCallback
+{
+public:
+  ForwardingCallback(boost::shared_ptr<FrameProcessor::IFrameCallback> target) : target(target) {}
+  void callback(boost::shared_ptr<FrameProcessor::Frame> frame)
+  {
+    if (frame->get_frame_number() == 3) {
+      throw std::runtime_error("Forwarding failed");
+    }
+    target->enqueue(frame);
+  }
+  boost::shared_ptr<FrameProcessor::IFrameCallback> target;
+};
+
+BOOST_AUTO_TEST_CASE( PluginSchedulerBackpressureTest )
+{
+  boost::shared_ptr<FrameProcessor::PluginScheduler> scheduler(new FrameProcessor::PluginScheduler(2));
+  boost::shared_ptr<SerialCountingCallback> consumer(new SerialCountingCallback);
+  consumer->getWorkQueue()->set_max_depth(4);
+  consumer->setScheduler(scheduler);
+  consumer->start();
+  boost::shared_ptr<ForwardingCallback> producer(new ForwardingCallback(consumer));
+  producer->setBatchSize(1);
+  producer->setScheduler(scheduler);
+  producer->start();
+
+  const int num_frames = 200;
+  unsigned short img[12] = {0};
+  for (int frame_number = 0; frame_number < num_frames; frame_number++) {
+    FrameProcessor::FrameMetaData frame_meta(
+        frame_number, "data", FrameProcessor::raw_16bit, "test", dimensions_t(), FrameProcessor::no_compression
+    );
+    producer->enqueue(boost::shared_ptr<FrameProcessor::Frame>(
+        new FrameProcessor::DataBlockFrame(frame_meta, static_cast<void*>(img), 24)));
+  }
+
+  // The frame the producer fails on is dropped, the rest passed on, with the producer parked
+  // while the consumer queue is full rather than growing it without bound
+  int waits = 0;
+  while ((__atomic_load_n(&consumer->frames, __ATOMIC_ACQUIRE) < num_frames - 1) && (waits++ < 5000)) {
+    usleep(1000);
+  }
+  BOOST_CHECK_EQUAL(__atomic_load_n(&consumer->frames, __ATOMIC_ACQUIRE), num_frames - 1);
+  BOOST_CHECK_LE(consumer->getWorkQueue()->high_water(), 4 + producer->getBatchSize());
+
+  producer->stop();
+  consumer->stop();
+  scheduler->stop();
+}
+
+class JitterPlugin : public FrameProcessor::FrameProcessorPlugin
+{
+public:
+  bool supports_replicas() const { return true; }
+  int get_version_major() { return 0; }
+  int get_version_minor() { return 0; }
+  int get_version_patch() { return 0; }
+  std::string get_version_short() { return "0.0.0"; }
+  std::string get_version_long() { return "0.0.0"; }
+private:
+  void process_frame(boost::shared_ptr<FrameProcessor::Frame> frame)
+  {
+    // Take a different time over each frame so that replicas finish them out of order
+    usleep((frame->get_frame_number() * 7 % 5) * 200);
+    // Fail on some frames to check the frames after them are still released
+    if (frame->get_frame_number() % 10 == 4) {
+      throw std::runtime_error("Jitter failure");
+    }
+    // Drop every tenth frame to check frames released with nothing pushed on
+    if (frame->get_frame_number() % 10 != 9) {
+      this->push(frame);
+    }
+  }
+};
+
+class GatedPlugin : public FrameProcessor::FrameProcessorPlugin
+{
+public:
+  GatedPlugin() : open(false), processed(0) {}
+  bool supports_replicas() const { return true; }
+  int get_version_major() { return 0; }
+  int get_version_minor() { return 0; }
+  int get_version_patch() { return 0; }
+  std::string get_version_short() { return "0.0.0"; }
+  std::string get_version_long() { return "0.0.0"; }
+  void open_gate()
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    open = true;
+    condition.notify_all();
+  }
+  void wait_processed(int count)
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    while (processed < count) {
+      condition.wait(lock);
+    }
+  }
+  boost::mutex mutex;
+  boost::condition_variable condition;
+  bool open;
+  int processed;
+private:
+  void process_frame(boost::shared_ptr<FrameProcessor::Frame> frame)
+  {
+    {
+      boost::mutex::scoped_lock lock(mutex);
+      // Hold up frame zero until the gate is opened
+      while ((frame->get_frame_number() == 0) && !open) {
+        condition.wait(lock);
+      }
+    }
+    this->push(frame);
+    boost::mutex::scoped_lock lock(mutex);
+    processed++;
+    condition.notify_all();
+  }
+};
+
+class OrderRecordingCallback : public FrameProcessor::IFrameCallback
+{
+public:
+  OrderRecordingCallback() : end_of_acquisitions(0) {}
+  void callback(boost::shared_ptr<FrameProcessor::Frame> frame)
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    if (frame->get_end_of_acquisition()) {
+      end_of_acquisitions++;
+      condition.notify_all();
+    } else {
+      frame_numbers.push_back(frame->get_frame_number());
+    }
+  }
+  bool wait_end_of_acquisition()
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    boost::system_time timeout = boost::get_system_time() + boost::posix_time::seconds(30);
+    while (end_of_acquisitions == 0) {
+      if (!condition.timed_wait(lock, timeout)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  boost::mutex mutex;
+  boost::condition_variable condition;
+  std::vector<long long> frame_numbers;
+  int end_of_acquisitions;
+};
+
+static boost::shared_ptr<FrameProcessor::Frame> make_replica_test_frame(long long frame_number)
+{
+  static unsigned short img[12] = {0};
+  FrameProcessor::FrameMetaData frame_meta(
+      frame_number, "data", FrameProcessor::raw_16bit, "test", dimensions_t(), FrameProcessor::no_compression
+  );
+  return boost::shared_ptr<FrameProcessor::Frame>(
+      new FrameProcessor::DataBlockFrame(frame_meta, static_cast<void*>(img), 24));
+}
+
+BOOST_AUTO_TEST_CASE( PluginReplicaSetReordersOutputTest )
+{
+  // Run on a scheduler, so that stopping it joins every thread processing frames
+  boost::shared_ptr<FrameProcessor::PluginScheduler> scheduler(new FrameProcessor::PluginScheduler(4));
+  std::vector<boost::shared_ptr<FrameProcessor::FrameProcessorPlugin> > replicas;
+  for (int index = 0; index < 3; index++) {
+    replicas.push_back(boost::shared_ptr<FrameProcessor::FrameProcessorPlugin>(new JitterPlugin));
+    replicas[index]->set_name("jitter");
+    replicas[index]->setScheduler(scheduler);
+    replicas[index]->start();
+  }
+  boost::shared_ptr<FrameProcessor::PluginReplicaSet> replica_set = FrameProcessor::PluginReplicaSet::create(
+      "jitter", replicas, FrameProcessor::PluginReplicaSet::get_dispatch_mode("least_loaded"));
+  BOOST_CHECK_THROW(FrameProcessor::PluginReplicaSet::get_dispatch_mode("random"), std::runtime_error);
+
+  boost::shared_ptr<OrderRecordingCallback> output(new OrderRecordingCallback);
+  output->setScheduler(scheduler);
+  output->start();
+  replica_set->register_callback("output", output);
+
+  const int num_frames = 100;
+  for (int frame_number = 0; frame_number < num_frames; frame_number++) {
+    replica_set->enqueue(make_replica_test_frame(frame_number));
+  }
+  replica_set->enqueue(boost::shared_ptr<FrameProcessor::Frame>(new FrameProcessor::EndOfAcquisitionFrame()));
+
+  // Frames pushed on by the replicas are released in dispatch order, with one end of acquisition
+  // released after all of them
+  BOOST_REQUIRE(output->wait_end_of_acquisition());
+  {
+    boost::mutex::scoped_lock lock(output->mutex);
+    BOOST_CHECK_EQUAL(output->end_of_acquisitions, 1);
+    BOOST_REQUIRE_EQUAL(output->frame_numbers.size(), num_frames - 2 * (num_frames / 10));
+    for (size_t index = 1; index < output->frame_numbers.size(); index++) {
+      BOOST_CHECK_LT(output->frame_numbers[index - 1], output->frame_numbers[index]);
+    }
+  }
+
+  OdinData::IpcMessage status;
+  replica_set->status(status);
+  BOOST_CHECK_EQUAL(status.get_param<unsigned int>("jitter/replicas/count"), 3);
+  BOOST_CHECK_EQUAL(status.get_param<std::string>("jitter/replicas/dispatch"), "least_loaded");
+  BOOST_CHECK_EQUAL(status.get_param<uint64_t>("jitter/replicas/frames_dispatched"), num_frames);
+  BOOST_CHECK_EQUAL(status.get_param<unsigned int>("jitter/replicas/reorder_pending"), 0);
+  BOOST_CHECK_EQUAL(status.get_param<unsigned int>("jitter/replicas/reorder_held"), 0);
+  BOOST_CHECK_EQUAL(status.get_param<uint64_t>("jitter/replicas/reorder_timeouts"), 0);
+
+  for (int index = 0; index < 3; index++) {
+    replicas[index]->stop();
+  }
+  output->stop();
+  scheduler->stop();
+}
+
+BOOST_AUTO_TEST_CASE( PluginReplicaSetReorderTimeoutTest )
+{
+  // Run on a scheduler with a thread to spare for the held up replica
+  boost::shared_ptr<FrameProcessor::PluginScheduler> scheduler(new FrameProcessor::PluginScheduler(3));
+  std::vector<boost::shared_ptr<FrameProcessor::FrameProcessorPlugin> > replicas;
+  std::vector<boost::shared_ptr<GatedPlugin> > gated;
+  for (int index = 0; index < 2; index++) {
+    gated.push_back(boost::shared_ptr<GatedPlugin>(new GatedPlugin));
+    replicas.push_back(gated[index]);
+    replicas[index]->set_name("gated");
+    replicas[index]->setScheduler(scheduler);
+    replicas[index]->start();
+  }
+  const unsigned int reorder_timeout_ms = 20;
+  boost::shared_ptr<FrameProcessor::PluginReplicaSet> replica_set = FrameProcessor::PluginReplicaSet::create(
+      "gated", replicas, FrameProcessor::PluginReplicaSet::get_dispatch_mode("round_robin"), reorder_timeout_ms);
+
+  boost::shared_ptr<OrderRecordingCallback> output(new OrderRecordingCallback);
+  output->setScheduler(scheduler);
+  output->start();
+  replica_set->register_callback("output", output);
+
+  // Frame zero holds up the even frames queued behind it on the first replica, while the second
+  // replica finishes the odd frames
+  for (int frame_number = 0; frame_number < 10; frame_number++) {
+    replica_set->enqueue(make_replica_test_frame(frame_number));
+  }
+  gated[1]->wait_processed(5);
+  usleep(2 * reorder_timeout_ms * 1000);
+
+  // Once the timeout has passed the held up frames are given up on, so the odd frames are
+  // released, and the even frames are passed on as they are done
+  replica_set->enqueue(make_replica_test_frame(10));
+  gated[0]->open_gate();
+  replica_set->enqueue(boost::shared_ptr<FrameProcessor::Frame>(new FrameProcessor::EndOfAcquisitionFrame()));
+
+  BOOST_REQUIRE(output->wait_end_of_acquisition());
+  {
+    boost::mutex::scoped_lock lock(output->mutex);
+    long long expected[] = {1, 3, 5, 7, 9, 0, 2, 4, 6, 8, 10};
+    BOOST_CHECK_EQUAL_COLLECTIONS(output->frame_numbers.begin(), output->frame_numbers.end(),
+                                  expected, expected + 11);
+  }
+
+  OdinData::IpcMessage status;
+  replica_set->status(status);
+  BOOST_CHECK_EQUAL(status.get_param<uint64_t>("gated/replicas/reorder_timeouts"), 5);
+  BOOST_CHECK_EQUAL(status.get_param<unsigned int>("gated/replicas/reorder_pending"), 0);
+
+  for (int index = 0; index < 2; index++) {
+    replicas[index]->stop();
+  }
+  output->stop();
+  scheduler->stop();
+}
+
 BOOST_AUTO_TEST_SUITE_END(); //FrameUnitTest
 
 
@@ -886,6 +1494,108 @@ BOOST_AUTO_TEST_CASE( AdjustOffset )
   BOOST_CHECK_EQUAL(104, frame->get_meta_data().get_frame_offset());
 }
 
+class BatchRecordingCallback : public FrameProcessor::IFrameCallback
+{
+public:
+  BatchRecordingCallback() : max_batch(0), end_of_acquisitions(0) {}
+  void callback(boost::shared_ptr<FrameProcessor::Frame> frame)
+  {
+    std::vector<boost::shared_ptr<FrameProcessor::Frame> > frames(1, frame);
+    this->callback_batch(frames);
+  }
+  void callback_batch(const std::vector<boost::shared_ptr<FrameProcessor::Frame> > &frames)
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    max_batch = std::max(max_batch, frames.size());
+    for (size_t index = 0; index < frames.size(); index++) {
+      if (frames[index]->get_end_of_acquisition()) {
+        end_of_acquisitions++;
+      } else {
+        frame_numbers.push_back(frames[index]->get_frame_number());
+        offsets.push_back(frames[index]->get_meta_data().get_frame_offset());
+      }
+    }
+  }
+  boost::mutex mutex;
+  size_t max_batch;
+  std::vector<long long> frame_numbers;
+  std::vector<long long> offsets;
+  int end_of_acquisitions;
+};
+
+BOOST_AUTO_TEST_CASE( AdjustOffsetBatch )
+{
+  boost::shared_ptr<FrameProcessor::PluginScheduler> scheduler(new FrameProcessor::PluginScheduler(2));
+  boost::shared_ptr<FrameProcessor::OffsetAdjustmentPlugin> plugin(new FrameProcessor::OffsetAdjustmentPlugin);
+  OdinData::IpcMessage reply;
+  OdinData::IpcMessage cfg;
+  cfg.set_param(FrameProcessor::OFFSET_ADJUSTMENT_CONFIG, 4);
+  plugin->configure(cfg, reply);
+  BOOST_CHECK_THROW(plugin->setBatchSize(0), std::runtime_error);
+  plugin->setBatchSize(8);
+  BOOST_CHECK_EQUAL(plugin->getBatchSize(), 8);
+
+  char dummy_data[2] = {0, 0};
+  std::vector<boost::shared_ptr<FrameProcessor::Frame> > frames;
+  for (int frame_number = 0; frame_number < 20; frame_number++) {
+    FrameProcessor::FrameMetaData frame_meta(
+            frame_number, "raw", FrameProcessor::raw_16bit, "test", dimensions_t(2, 0), FrameProcessor::no_compression
+    );
+    frame_meta.set_frame_offset(frame_number);
+    frames.push_back(boost::shared_ptr<FrameProcessor::Frame>(
+            new FrameProcessor::DataBlockFrame(frame_meta, static_cast<void*>(dummy_data), 2)));
+  }
+
+  // A batch processed directly is adjusted and pushed on as a single batch
+  boost::shared_ptr<BatchRecordingCallback> direct(new BatchRecordingCallback);
+  plugin->register_callback("direct", direct, true);
+  std::vector<boost::shared_ptr<FrameProcessor::Frame> > first(frames.begin(), frames.begin() + 4);
+  plugin->process_frames(first);
+  BOOST_CHECK_EQUAL(direct->max_batch, 4);
+  BOOST_REQUIRE_EQUAL(direct->offsets.size(), 4);
+  for (size_t index = 0; index < direct->offsets.size(); index++) {
+    BOOST_CHECK_EQUAL(direct->offsets[index], index + 4);
+  }
+  plugin->remove_callback("direct");
+
+  // Frames queued to the plugin are processed in batches of up to the batch size, in order,
+  // with the end of acquisition passed on after the frames before it
+  boost::shared_ptr<BatchRecordingCallback> output(new BatchRecordingCallback);
+  output->setScheduler(scheduler);
+  output->start();
+  plugin->setScheduler(scheduler);
+  plugin->start();
+  plugin->register_callback("output", output);
+  std::vector<boost::shared_ptr<FrameProcessor::Frame> > rest(frames.begin() + 4, frames.end());
+  rest.push_back(boost::shared_ptr<FrameProcessor::Frame>(new FrameProcessor::EndOfAcquisitionFrame()));
+  plugin->enqueue_batch(rest);
+
+  int waits = 0;
+  while (waits++ < 5000) {
+    {
+      boost::mutex::scoped_lock lock(output->mutex);
+      if (output->end_of_acquisitions > 0) {
+        break;
+      }
+    }
+    usleep(1000);
+  }
+  {
+    boost::mutex::scoped_lock lock(output->mutex);
+    BOOST_CHECK_EQUAL(output->end_of_acquisitions, 1);
+    BOOST_CHECK_LE(output->max_batch, 8);
+    BOOST_REQUIRE_EQUAL(output->frame_numbers.size(), 16);
+    for (size_t index = 0; index < output->frame_numbers.size(); index++) {
+      BOOST_CHECK_EQUAL(output->frame_numbers[index], index + 4);
+      BOOST_CHECK_EQUAL(output->offsets[index], index + 8);
+    }
+  }
+
+  plugin->stop();
+  output->stop();
+  scheduler->stop();
+}
+
 BOOST_AUTO_TEST_SUITE_END(); //UIDAdjustmentPluginUnitTest
 
 BOOST_FIXTURE_TEST_SUITE(FileWriterPluginTestUnitTest, FileWriterPluginTestFixture);
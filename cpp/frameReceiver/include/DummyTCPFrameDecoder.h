@@ -38,6 +38,8 @@ public:
 
   void *get_next_message_buffer(void);
   const size_t get_next_message_size(void) const;
+  unsigned int get_next_message_regions(struct iovec *regions,
+                                        unsigned int max_regions);
   FrameDecoder::FrameReceiveState process_message(size_t bytes_received);
 
   const size_t get_frame_buffer_size(void) const;
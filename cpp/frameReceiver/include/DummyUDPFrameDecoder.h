@@ -44,6 +44,7 @@ public:
 
   const size_t get_frame_buffer_size(void) const;
   const size_t get_frame_header_size(void) const;
+  void prepare_frame_header(void* header_ptr) const;
 
   inline const bool requires_header_peek(void) const { return true; };
   const size_t get_packet_header_size(void) const;
@@ -60,14 +61,18 @@ public:
   void reset_statistics(void);
 
   void* get_packet_header_buffer(void);
+  bool get_frame_number_field(FrameNumberField& field) const;
 
   uint32_t get_frame_number(void) const;
   uint32_t get_packet_number(void) const;
 
+protected:
+  void* predict_next_payload_buffer(void);
+  void* predict_payload_buffer(unsigned int packets_ahead);
+
 private:
 
   void initialise_frame_header(DummyUDP::FrameHeader* header_ptr);
-    unsigned int elapsed_ms(struct timespec& start, struct timespec& end);
 
 
   unsigned int udp_packets_per_frame_;
@@ -0,0 +1,72 @@
+/*!
+ * FrameBufferScrubber.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef FRAMEBUFFERSCRUBBER_H_
+#define FRAMEBUFFERSCRUBBER_H_
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include "SharedBufferManager.h"
+
+namespace FrameReceiver
+{
+
+//! FrameBufferScrubber - background preparation of empty frame buffers
+//!
+//! This class prepares frame buffers released by the downstream application on a background
+//! thread before a frame decoder reuses them, taking per-frame housekeeping off the receive path.
+//! Each buffer submitted has a prepared frame header, built once by the decoder, copied over its
+//! header and, optionally, its payload filled with a byte value, e.g. a sentinel that makes
+//! missing packets recognisable, using non-temporal stores so that filling does not evict the
+//! data being received from the cache. Buffers are passed to and from the thread on a pair of
+//! lock-free single-producer, single-consumer queues, so that a single RX thread can submit
+//! released buffers and collect prepared ones without blocking. The scrubbing thread sleeps
+//! while there are no buffers to prepare.
+class FrameBufferScrubber
+{
+public:
+  FrameBufferScrubber(OdinData::SharedBufferManagerPtr buffer_manager,
+      const std::vector<char>& header, bool fill_payload, uint8_t fill_value);
+  ~FrameBufferScrubber();
+
+  bool submit(int buffer_id);
+  bool collect(int& buffer_id);
+  size_t get_backlog(void) const;
+  size_t get_num_prepared(void) const;
+  uint64_t get_num_scrubbed(void) const;
+
+  static void fill(void* region, size_t size, uint8_t value);
+
+private:
+  void run(void);
+  void scrub(int buffer_id);
+
+  OdinData::SharedBufferManagerPtr buffer_manager_;     //!< Shared buffer manager of the buffers
+  std::vector<char> header_;                            //!< Prepared frame header
+  bool fill_payload_;                                   //!< Fill the payload of each buffer
+  uint8_t fill_value_;                                  //!< Byte value payloads are filled with
+
+  boost::lockfree::spsc_queue<int> submitted_;          //!< Buffers awaiting preparation
+  boost::lockfree::spsc_queue<int> prepared_;           //!< Buffers prepared for reuse
+  uint64_t num_submitted_;                              //!< Number of buffers submitted
+  uint64_t num_scrubbed_;                               //!< Number of buffers prepared
+
+  boost::mutex mutex_;                                  //!< Mutex protecting the wakeup condition
+  boost::condition_variable wakeup_;                    //!< Condition waking the scrubbing thread
+  bool waiting_;                                        //!< Scrubbing thread is waiting for buffers
+  bool run_thread_;                                     //!< Scrubbing thread should keep running
+  boost::scoped_ptr<boost::thread> thread_;             //!< Scrubbing thread
+};
+
+} // namespace FrameReceiver
+#endif /* FRAMEBUFFERSCRUBBER_H_ */
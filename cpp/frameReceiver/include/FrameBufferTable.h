@@ -0,0 +1,81 @@
+/*!
+ * FrameBufferTable.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef FRAMEBUFFERTABLE_H_
+#define FRAMEBUFFERTABLE_H_
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+namespace FrameReceiver
+{
+
+//! FrameBufferTable - constant time tracking of the frame buffers held by a decoder
+//!
+//! This class tracks the shared memory buffers held by a frame decoder: a fixed-capacity stack of
+//! empty buffers ready for use for each pool of buffers in the shared buffer, and a table of
+//! buffers mapped to frames currently being received.
+//! The table is an open-addressed hash table keyed by frame number, sized to at least twice the
+//! number of buffers so that it never fills, with the state of each mapped frame held in arrays
+//! indexed by buffer ID. Mapped frames are also linked into a list in the order they were mapped,
+//! which, as all frames share the same timeout, is the order in which they time out. Finding the
+//! frames that have timed out therefore only visits those frames, rather than every frame mapped.
+//! All operations take constant time and nothing is allocated once the table has been sized for
+//! the buffers in use.
+class FrameBufferTable
+{
+public:
+  FrameBufferTable();
+
+  void resize(size_t num_buffers, unsigned int num_pools=1);
+
+  void push_empty(int buffer_id, unsigned int pool=0);
+  bool pop_empty(int& buffer_id, unsigned int pool=0);
+  int next_empty(unsigned int pool=0) const;
+  //! Returns the number of empty buffers on the stacks of all pools
+  size_t num_empty(void) const { return num_empty_; }
+  size_t num_empty(unsigned int pool) const;
+  void drop_empty(void);
+
+  bool map(int frame, int buffer_id, uint64_t start_ns);
+  int lookup(int frame) const;
+  bool unmap(int frame);
+  //! Returns the number of buffers mapped to frames
+  size_t num_mapped(void) const { return num_mapped_; }
+  bool pop_expired(uint64_t deadline_ns, int& frame, int& buffer_id);
+  void drop_mapped(void);
+
+private:
+
+  static const int no_buffer = -1;  //!< Marks an empty slot or the end of the timeout list
+
+  void ensure_buffer(int buffer_id);
+  void rehash(size_t num_slots);
+  size_t home_slot(int frame) const;
+  size_t find_slot(int frame) const;
+  void remove_slot(size_t slot);
+
+  std::vector<std::vector<int> > empty_buffers_; //!< Stacks of empty buffer IDs, one per pool
+  size_t num_empty_;                   //!< Number of empty buffers on all stacks
+
+  std::vector<int> slots_;             //!< Hash table slots holding mapped buffer IDs
+  size_t slot_mask_;                   //!< Mask applied to hashes to index the slots
+  unsigned int slot_shift_;            //!< Shift applied to hashes to index the slots
+  size_t num_mapped_;                  //!< Number of buffers mapped to frames
+
+  std::vector<int> frame_;             //!< Frame mapped to each buffer
+  std::vector<uint64_t> start_ns_;     //!< Time each buffer was mapped to its frame
+  std::vector<int> prev_;              //!< Previously mapped buffer in the timeout list
+  std::vector<int> next_;              //!< Next mapped buffer in the timeout list
+  std::vector<bool> is_mapped_;        //!< Indicates if each buffer is mapped to a frame
+  int oldest_;                         //!< Oldest mapped buffer, at the head of the timeout list
+  int newest_;                         //!< Newest mapped buffer, at the tail of the timeout list
+};
+
+} // namespace FrameReceiver
+#endif /* FRAMEBUFFERTABLE_H_ */
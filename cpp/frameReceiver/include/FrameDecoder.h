@@ -16,6 +16,7 @@
 #include <netinet/in.h>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/function.hpp>
 
 #include <log4cxx/logger.h>
@@ -27,12 +28,17 @@ using namespace log4cxx::helpers;
 #include "OdinDataException.h"
 #include "SharedBufferManager.h"
 #include "IVersionedObject.h"
+#include "FrameBufferTable.h"
+#include "FrameBufferScrubber.h"
 
 namespace FrameReceiver
 {
 
   const std::string CONFIG_DECODER_ENABLE_PACKET_LOGGING = "enable_packet_logging";
   const std::string CONFIG_DECODER_FRAME_TIMEOUT_MS = "frame_timeout_ms";
+  const std::string CONFIG_DECODER_BUFFER_SCRUB = "buffer_scrub";
+  const std::string CONFIG_DECODER_BUFFER_SCRUB_FILL = "buffer_scrub_fill";
+  const std::string CONFIG_DECODER_BUFFER_SCRUB_FILL_VALUE = "buffer_scrub_fill_value";
 
 class FrameDecoderException : public OdinData::OdinDataException
 {
@@ -41,9 +47,19 @@ public:
 };
 
 typedef boost::function<void(int, int)> FrameReadyCallback;
+
+//! Deprecated, retained for decoders using FrameDecoder::empty_buffer_queue_ directly
 typedef std::queue<int> EmptyBufferQueue;
+//! Deprecated, retained for decoders using FrameDecoder::frame_buffer_map_ directly
 typedef std::map<int, int> FrameBufferMap;
 
+//! Pool of frame buffers of a single size required by a decoder
+typedef struct
+{
+  std::size_t  buffer_size;  //!< Size of each buffer in the pool in bytes
+  unsigned int mem_share;    //!< Share of the shared buffer memory given to the pool, relative to other pools
+} FrameBufferPool;
+
 class FrameDecoder : public OdinData::IVersionedObject
 {
 public:
@@ -69,12 +85,16 @@ public:
   virtual void execute(const std::string& command, OdinData::IpcMessage& reply);
   virtual const size_t get_frame_buffer_size(void) const = 0;
   virtual const size_t get_frame_header_size(void) const = 0;
+  virtual void get_frame_buffer_pools(std::vector<FrameBufferPool>& pools) const;
+  virtual void prepare_frame_header(void* header_ptr) const;
 
   void register_buffer_manager(OdinData::SharedBufferManagerPtr buffer_manager);
   void register_frame_ready_callback(FrameReadyCallback callback);
   void push_empty_buffer(int buffer_id);
   const size_t get_num_empty_buffers(void) const;
   const size_t get_num_mapped_buffers(void) const;
+  const size_t get_num_scrub_backlog(void) const;
+  const uint64_t get_num_buffers_scrubbed(void) const;
   void drop_all_buffers(void);
   const unsigned int get_frame_timeout_ms(void) const;
   const unsigned int get_num_frames_timedout(void) const;
@@ -85,6 +105,16 @@ public:
   virtual void reset_statistics(void);
 
 protected:
+  bool pop_empty_buffer(int& buffer_id, unsigned int pool=0);
+  int next_empty_buffer(unsigned int pool=0) const;
+  bool empty_buffer_prepared(int buffer_id) const;
+  bool map_frame_buffer(int frame, int buffer_id);
+  int get_frame_buffer(int frame) const;
+  bool unmap_frame_buffer(int frame);
+  bool pop_timedout_frame(uint64_t now_ns, int& frame, int& buffer_id);
+  static uint64_t get_monotonic_time_ns(void);
+  void collect_scrubbed_buffers(void);
+
   LoggerPtr logger_;  //!< Pointer to the logging facility
 
   bool enable_packet_logging_;  //!< Flag to enable packet logging by decoder
@@ -93,12 +123,29 @@ protected:
   OdinData::SharedBufferManagerPtr buffer_manager_; //!< Pointer to the shared buffer manager
   FrameReadyCallback   ready_callback_;             //!< Callback for frames ready to be processed
 
-  EmptyBufferQueue empty_buffer_queue_; //!< Queue of empty buffers ready for use
-  FrameBufferMap   frame_buffer_map_;   //!< Map of buffers currently receiving frame data
+  FrameBufferTable frame_buffers_; //!< Empty buffers and buffers currently receiving frame data
+
+  //! Deprecated queue of empty buffers, used until a decoder first calls the buffer helpers
+  EmptyBufferQueue empty_buffer_queue_;
+  //! Deprecated map of buffers receiving frame data, for decoders not using the buffer helpers
+  FrameBufferMap   frame_buffer_map_;
 
   unsigned int frame_timeout_ms_; //!< Incomplete frame timeout in ms
   unsigned int frames_timedout_;  //!< Number of frames timed out in decoder
   unsigned int frames_dropped_;   //!< Number of frames dropped due to lack of buffers
+
+  bool buffer_scrub_;                //!< Prepare released buffers on a background thread
+  bool buffer_scrub_fill_;           //!< Fill the payload of buffers as they are prepared
+  unsigned int buffer_scrub_fill_value_; //!< Byte value buffer payloads are filled with
+  boost::scoped_ptr<FrameBufferScrubber> scrubber_; //!< Background preparer of released buffers
+
+private:
+  void use_buffer_helpers(void);
+  unsigned int get_empty_buffer_pool(int buffer_id) const;
+  void queue_empty_buffer(int buffer_id, unsigned int pool, bool prepared);
+
+  bool buffer_helpers_used_; //!< Indicates the decoder tracks buffers with the buffer helpers
+  std::vector<bool> buffer_prepared_; //!< Indicates if each empty buffer was prepared by the scrubber
 };
 
 inline FrameDecoder::~FrameDecoder() {};
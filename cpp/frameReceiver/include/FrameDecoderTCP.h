@@ -14,6 +14,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <netinet/in.h>
+#include <sys/uio.h>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/function.hpp>
@@ -41,6 +42,8 @@ public:
   virtual void* get_next_message_buffer(void) = 0;
   virtual const size_t get_next_message_size(void) const = 0;
 
+  virtual unsigned int get_next_message_regions(struct iovec* regions, unsigned int max_regions);
+
   virtual FrameReceiveState process_message(size_t bytes_received) = 0;
 
   void* current_raw_buffer_;
@@ -49,6 +52,26 @@ public:
 
 inline FrameDecoderTCP::~FrameDecoderTCP() {};
 
+//! Get the regions of the frame buffer that the next message should be received into.
+//!
+//! This method fills in a list of IO vectors describing where the RX thread should place the
+//! bytes of the next message, allowing it to scatter e.g. the header and payload of a message into
+//! separate regions of a frame buffer with a single readv call. The total length of the regions
+//! is the size of the message. The default implementation returns a single region given by the
+//! next message buffer and size; decoders can override this to use multiple regions.
+//!
+//! \param[out] regions - array of IO vectors to fill with the message regions
+//! \param[in] max_regions - maximum number of regions that can be filled in
+//! \return number of regions filled in
+//!
+inline unsigned int FrameDecoderTCP::get_next_message_regions(
+    struct iovec* regions, unsigned int max_regions)
+{
+  regions[0].iov_base = get_next_message_buffer();
+  regions[0].iov_len = get_next_message_size();
+  return 1;
+}
+
 typedef boost::shared_ptr<FrameDecoderTCP> FrameDecoderTCPPtr;
 
 } // namespace FrameReceiver
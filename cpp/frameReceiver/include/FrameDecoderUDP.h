@@ -10,6 +10,7 @@
 
 #include <queue>
 #include <map>
+#include <vector>
 
 #include <stddef.h>
 #include <stdint.h>
@@ -27,12 +28,42 @@ using namespace log4cxx::helpers;
 
 namespace FrameReceiver
 {
+
+//! Receive slot descriptor for batched packet reception.
+//!
+//! A slot describes where the header and payload of a single packet should be received when
+//! the RX thread receives a batch of packets in one call. The RX thread fills in the number of
+//! bytes received and the source address before the batch is passed back to the decoder.
+typedef struct
+{
+  void*              header_buffer;  //!< Address to receive packet header into (NULL if no header)
+  size_t             header_size;    //!< Size of packet header to receive
+  void*              payload_buffer; //!< Address to receive packet payload into
+  size_t             payload_size;   //!< Size of packet payload to receive
+  size_t             bytes_received; //!< Total number of bytes received for the packet
+  struct sockaddr_in from_addr;      //!< Source address of the packet
+} PacketReceiveSlot;
+
+//! Location of the frame number field in a packet header.
+//!
+//! This describes where a decoder expects to find the frame number in the header of each
+//! packet, allowing packets to be steered to RX threads by frame number in the kernel, before
+//! they are received.
+typedef struct
+{
+  size_t offset;     //!< Byte offset of the frame number field from the start of the packet
+  size_t width;      //!< Width of the frame number field in bytes (1 to 4)
+  bool   big_endian; //!< Flag indicating the frame number is in big-endian byte order
+} FrameNumberField;
+
 class FrameDecoderUDP : public FrameDecoder
 {
 public:
 
   FrameDecoderUDP() :
-      FrameDecoder()
+      FrameDecoder(),
+      predicted_payload_buffer_(0),
+      packets_relocated_(0)
   {
   };
 
@@ -47,6 +78,32 @@ public:
   virtual void* get_next_payload_buffer(void) const = 0;
   virtual size_t get_next_payload_size(void) const = 0;
   virtual FrameReceiveState process_packet(size_t bytes_received, int port, struct sockaddr_in* from_addr) = 0;
+
+  virtual unsigned int get_next_payload_slots(unsigned int num_slots, PacketReceiveSlot* slots);
+  virtual void process_packets(unsigned int num_packets, PacketReceiveSlot* slots, int port);
+  virtual unsigned int process_packet_run(const uint8_t* buffer, size_t bytes_received,
+      size_t packet_size, int port, struct sockaddr_in* from_addr);
+
+  virtual bool get_frame_number_field(FrameNumberField& field) const;
+
+  void* get_predicted_payload_buffer(void);
+  FrameReceiveState process_predicted_packet(size_t bytes_received, int port, struct sockaddr_in* from_addr);
+  const unsigned int get_num_packets_relocated(void) const;
+  virtual void reset_statistics(void);
+
+protected:
+  virtual void* predict_next_payload_buffer(void);
+  virtual void* predict_payload_buffer(unsigned int packets_ahead);
+
+  void*        predicted_payload_buffer_; //!< Payload buffer predicted for the current receive
+  unsigned int packets_relocated_;        //!< Number of mispredicted packets relocated
+
+private:
+  bool is_spill_buffer(const void* buffer) const;
+
+  std::vector<uint8_t> batch_header_buffer_; //!< Staging area for headers in batched receive
+  std::vector<uint8_t> batch_spill_buffer_;  //!< Payloads in batched receive that could not be predicted
+  std::vector<uint8_t> batch_move_buffer_;   //!< Payloads moved aside from relocated payloads in batched receive
 };
 
 inline FrameDecoderUDP::~FrameDecoderUDP() {};
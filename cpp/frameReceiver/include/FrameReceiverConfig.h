@@ -28,6 +28,12 @@ namespace FrameReceiver
 {
 
   const std::string CONFIG_MAX_BUFFER_MEM = "max_buffer_mem";
+  const std::string CONFIG_BUFFER_LEASE_TIMEOUT_MS = "buffer_lease_timeout_ms";
+  const std::string CONFIG_BUFFER_RECLAIM_EXITED = "buffer_reclaim_exited";
+  const std::string CONFIG_SHARED_BUFFER_HUGE_PAGE_SIZE = "shared_buffer_huge_page_size";
+  const std::string CONFIG_SHARED_BUFFER_PREFAULT = "shared_buffer_prefault";
+  const std::string CONFIG_SHARED_BUFFER_LOCK = "shared_buffer_lock";
+  const std::string CONFIG_SHARED_BUFFER_NUMA_NODE = "shared_buffer_numa_node";
   const std::string CONFIG_DECODER_PATH = "decoder_path";
   const std::string CONFIG_DECODER_TYPE = "decoder_type";
   const std::string CONFIG_DECODER_CONFIG = "decoder_config";
@@ -36,9 +42,27 @@ namespace FrameReceiver
   const std::string CONFIG_RX_ENDPOINT = "rx_endpoint";
   const std::string CONFIG_FRAME_READY_ENDPOINT = "frame_ready_endpoint";
   const std::string CONFIG_FRAME_RELEASE_ENDPOINT = "frame_release_endpoint";
+  const std::string CONFIG_FRAME_NOTIFY_FORMAT = "frame_notify_format";
+  const std::string CONFIG_FRAME_NOTIFY_TRANSPORT = "frame_notify_transport";
+  const std::string CONFIG_FRAME_NOTIFY_DIRECT = "frame_notify_direct";
   const std::string CONFIG_RX_PORTS = "rx_ports";
   const std::string CONFIG_RX_ADDRESS = "rx_address";
   const std::string CONFIG_RX_RECV_BUFFER_SIZE = "rx_recv_buffer_size";
+  const std::string CONFIG_RX_RECV_BATCH_SIZE = "rx_recv_batch_size";
+  const std::string CONFIG_RX_THREADS = "rx_threads";
+  const std::string CONFIG_RX_STEERING = "rx_steering";
+  const std::string CONFIG_RX_SPIN_MODE = "rx_spin_mode";
+  const std::string CONFIG_RX_SPIN_CHECK_INTERVAL = "rx_spin_check_interval";
+  const std::string CONFIG_RX_SPIN_IDLE_TIMEOUT_MS = "rx_spin_idle_timeout_ms";
+  const std::string CONFIG_RX_BUSY_POLL_US = "rx_busy_poll_us";
+  const std::string CONFIG_RX_PREFER_BUSY_POLL = "rx_prefer_busy_poll";
+  const std::string CONFIG_RX_UDP_GRO = "rx_udp_gro";
+  const std::string CONFIG_RX_RING_BLOCK_SIZE = "rx_ring_block_size";
+  const std::string CONFIG_RX_RING_BLOCK_TIMEOUT_MS = "rx_ring_block_timeout_ms";
+  const std::string CONFIG_RX_ENGINE = "rx_engine";
+  const std::string CONFIG_RX_URING_BUFFERS = "rx_uring_buffers";
+  const std::string CONFIG_RX_URING_BUFFER_SIZE = "rx_uring_buffer_size";
+  const std::string CONFIG_RX_TCP_MODE = "rx_tcp_mode";
   const std::string CONFIG_SHARED_BUFFER_NAME = "shared_buffer_name";
   const std::string CONFIG_FRAME_TIMEOUT_MS = "frame_timeout_ms";
   const std::string CONFIG_FRAME_COUNT = "frame_count";
@@ -46,6 +70,7 @@ namespace FrameReceiver
   const std::string CONFIG_FORCE_RECONFIG = "force_reconfig";
   const std::string CONFIG_DEBUG = "debug_level";
   const std::string CONFIG_FRAMES = "frames";
+  const std::string CONFIG_THREAD_PLACEMENT = "thread_placement";
 
 class FrameReceiverConfig
 {
@@ -60,11 +85,35 @@ public:
       rx_type_(Defaults::default_rx_type),
       rx_address_(Defaults::default_rx_address),
       rx_recv_buffer_size_(Defaults::default_rx_recv_buffer_size),
+      rx_recv_batch_size_(Defaults::default_rx_recv_batch_size),
+      rx_threads_(Defaults::default_rx_threads),
+      rx_steering_(Defaults::default_rx_steering),
+      rx_spin_mode_(Defaults::default_rx_spin_mode),
+      rx_spin_check_interval_(Defaults::default_rx_spin_check_interval),
+      rx_spin_idle_timeout_ms_(Defaults::default_rx_spin_idle_timeout_ms),
+      rx_busy_poll_us_(Defaults::default_rx_busy_poll_us),
+      rx_prefer_busy_poll_(Defaults::default_rx_prefer_busy_poll),
+      rx_udp_gro_(Defaults::default_rx_udp_gro),
+      rx_ring_block_size_(Defaults::default_rx_ring_block_size),
+      rx_ring_block_timeout_ms_(Defaults::default_rx_ring_block_timeout_ms),
+      rx_engine_(Defaults::default_rx_engine),
+      rx_uring_buffers_(Defaults::default_rx_uring_buffers),
+      rx_uring_buffer_size_(Defaults::default_rx_uring_buffer_size),
+      rx_tcp_mode_(Defaults::default_rx_tcp_mode),
       rx_channel_endpoint_(""),
       ctrl_channel_endpoint_(""),
       frame_ready_endpoint_(""),
       frame_release_endpoint_(""),
+      frame_notify_format_(Defaults::default_frame_notify_format),
+      frame_notify_transport_(Defaults::default_frame_notify_transport),
+      frame_notify_direct_(Defaults::default_frame_notify_direct),
       shared_buffer_name_(OdinData::Defaults::default_shared_buffer_name),
+      buffer_lease_timeout_ms_(Defaults::default_buffer_lease_timeout_ms),
+      buffer_reclaim_exited_(Defaults::default_buffer_reclaim_exited),
+      shared_buffer_huge_page_size_(Defaults::default_shared_buffer_huge_page_size),
+      shared_buffer_prefault_(Defaults::default_shared_buffer_prefault),
+      shared_buffer_lock_(Defaults::default_shared_buffer_lock),
+      shared_buffer_numa_node_(Defaults::default_shared_buffer_numa_node),
       frame_timeout_ms_(Defaults::default_frame_timeout_ms),
       enable_packet_logging_(Defaults::default_enable_packet_logging),
       force_reconfig_(Defaults::default_force_reconfig)
@@ -106,6 +155,8 @@ public:
       rx_name_map["ZMQ"]  = Defaults::RxTypeZMQ;
       rx_name_map["tcp"]  = Defaults::RxTypeTCP;
       rx_name_map["TCP"]  = Defaults::RxTypeTCP;
+      rx_name_map["packet"] = Defaults::RxTypePacket;
+      rx_name_map["PACKET"] = Defaults::RxTypePacket;
     }
 
     if (rx_name_map.count(rx_name)){
@@ -126,6 +177,7 @@ public:
       rx_type_map[Defaults::RxTypeUDP] = "udp";
       rx_type_map[Defaults::RxTypeZMQ] = "zmq";
       rx_type_map[Defaults::RxTypeTCP] = "tcp";
+      rx_type_map[Defaults::RxTypePacket] = "packet";
       rx_type_map[Defaults::RxTypeIllegal] = "unknown";
     }
 
@@ -142,6 +194,224 @@ public:
 
   }
 
+  static Defaults::RxSteering map_rx_steering_name_to_type(std::string& rx_steering_name)
+  {
+    Defaults::RxSteering rx_steering = Defaults::RxSteeringIllegal;
+
+    static std::map<std::string, Defaults::RxSteering> rx_steering_name_map;
+
+    if (rx_steering_name_map.empty()){
+      rx_steering_name_map["port"] = Defaults::RxSteeringPort;
+      rx_steering_name_map["frame"] = Defaults::RxSteeringFrame;
+    }
+
+    if (rx_steering_name_map.count(rx_steering_name)){
+      rx_steering = rx_steering_name_map[rx_steering_name];
+    }
+
+    return rx_steering;
+  }
+
+  static std::string map_rx_steering_type_to_name(Defaults::RxSteering rx_steering)
+  {
+    std::string rx_steering_name;
+
+    static std::map<Defaults::RxSteering, std::string> rx_steering_type_map;
+
+    if (rx_steering_type_map.empty())
+    {
+      rx_steering_type_map[Defaults::RxSteeringPort] = "port";
+      rx_steering_type_map[Defaults::RxSteeringFrame] = "frame";
+      rx_steering_type_map[Defaults::RxSteeringIllegal] = "unknown";
+    }
+
+    if (rx_steering_type_map.count(rx_steering))
+    {
+      rx_steering_name = rx_steering_type_map[rx_steering];
+    }
+    else
+    {
+      rx_steering_name = rx_steering_type_map[Defaults::RxSteeringIllegal];
+    }
+
+    return rx_steering_name;
+
+  }
+
+  static Defaults::RxEngine map_rx_engine_name_to_type(std::string& rx_engine_name)
+  {
+    Defaults::RxEngine rx_engine = Defaults::RxEngineIllegal;
+
+    static std::map<std::string, Defaults::RxEngine> rx_engine_name_map;
+
+    if (rx_engine_name_map.empty()){
+      rx_engine_name_map["reactor"] = Defaults::RxEngineReactor;
+      rx_engine_name_map["io_uring"] = Defaults::RxEngineIoUring;
+    }
+
+    if (rx_engine_name_map.count(rx_engine_name)){
+      rx_engine = rx_engine_name_map[rx_engine_name];
+    }
+
+    return rx_engine;
+  }
+
+  static std::string map_rx_engine_type_to_name(Defaults::RxEngine rx_engine)
+  {
+    std::string rx_engine_name;
+
+    static std::map<Defaults::RxEngine, std::string> rx_engine_type_map;
+
+    if (rx_engine_type_map.empty())
+    {
+      rx_engine_type_map[Defaults::RxEngineReactor] = "reactor";
+      rx_engine_type_map[Defaults::RxEngineIoUring] = "io_uring";
+      rx_engine_type_map[Defaults::RxEngineIllegal] = "unknown";
+    }
+
+    if (rx_engine_type_map.count(rx_engine))
+    {
+      rx_engine_name = rx_engine_type_map[rx_engine];
+    }
+    else
+    {
+      rx_engine_name = rx_engine_type_map[Defaults::RxEngineIllegal];
+    }
+
+    return rx_engine_name;
+
+  }
+
+  static Defaults::RxTcpMode map_rx_tcp_mode_name_to_type(std::string& rx_tcp_mode_name)
+  {
+    Defaults::RxTcpMode rx_tcp_mode = Defaults::RxTcpModeIllegal;
+
+    static std::map<std::string, Defaults::RxTcpMode> rx_tcp_mode_name_map;
+
+    if (rx_tcp_mode_name_map.empty()){
+      rx_tcp_mode_name_map["client"] = Defaults::RxTcpModeClient;
+      rx_tcp_mode_name_map["server"] = Defaults::RxTcpModeServer;
+    }
+
+    if (rx_tcp_mode_name_map.count(rx_tcp_mode_name)){
+      rx_tcp_mode = rx_tcp_mode_name_map[rx_tcp_mode_name];
+    }
+
+    return rx_tcp_mode;
+  }
+
+  static std::string map_rx_tcp_mode_type_to_name(Defaults::RxTcpMode rx_tcp_mode)
+  {
+    std::string rx_tcp_mode_name;
+
+    static std::map<Defaults::RxTcpMode, std::string> rx_tcp_mode_type_map;
+
+    if (rx_tcp_mode_type_map.empty())
+    {
+      rx_tcp_mode_type_map[Defaults::RxTcpModeClient] = "client";
+      rx_tcp_mode_type_map[Defaults::RxTcpModeServer] = "server";
+      rx_tcp_mode_type_map[Defaults::RxTcpModeIllegal] = "unknown";
+    }
+
+    if (rx_tcp_mode_type_map.count(rx_tcp_mode))
+    {
+      rx_tcp_mode_name = rx_tcp_mode_type_map[rx_tcp_mode];
+    }
+    else
+    {
+      rx_tcp_mode_name = rx_tcp_mode_type_map[Defaults::RxTcpModeIllegal];
+    }
+
+    return rx_tcp_mode_name;
+
+  }
+
+  static Defaults::FrameNotifyFormat map_frame_notify_format_name_to_type(std::string& format_name)
+  {
+    Defaults::FrameNotifyFormat format = Defaults::FrameNotifyFormatIllegal;
+
+    static std::map<std::string, Defaults::FrameNotifyFormat> format_name_map;
+
+    if (format_name_map.empty()){
+      format_name_map["json"] = Defaults::FrameNotifyFormatJson;
+      format_name_map["binary"] = Defaults::FrameNotifyFormatBinary;
+    }
+
+    if (format_name_map.count(format_name)){
+      format = format_name_map[format_name];
+    }
+
+    return format;
+  }
+
+  static std::string map_frame_notify_format_type_to_name(Defaults::FrameNotifyFormat format)
+  {
+    std::string format_name;
+
+    static std::map<Defaults::FrameNotifyFormat, std::string> format_type_map;
+
+    if (format_type_map.empty())
+    {
+      format_type_map[Defaults::FrameNotifyFormatJson] = "json";
+      format_type_map[Defaults::FrameNotifyFormatBinary] = "binary";
+      format_type_map[Defaults::FrameNotifyFormatIllegal] = "unknown";
+    }
+
+    if (format_type_map.count(format))
+    {
+      format_name = format_type_map[format];
+    }
+    else
+    {
+      format_name = format_type_map[Defaults::FrameNotifyFormatIllegal];
+    }
+
+    return format_name;
+  }
+
+  static Defaults::FrameNotifyTransport map_frame_notify_transport_name_to_type(std::string& transport_name)
+  {
+    Defaults::FrameNotifyTransport transport = Defaults::FrameNotifyTransportIllegal;
+
+    static std::map<std::string, Defaults::FrameNotifyTransport> transport_name_map;
+
+    if (transport_name_map.empty()){
+      transport_name_map["zmq"] = Defaults::FrameNotifyTransportZMQ;
+      transport_name_map["shm"] = Defaults::FrameNotifyTransportSharedMemory;
+    }
+
+    if (transport_name_map.count(transport_name)){
+      transport = transport_name_map[transport_name];
+    }
+
+    return transport;
+  }
+
+  static std::string map_frame_notify_transport_type_to_name(Defaults::FrameNotifyTransport transport)
+  {
+    std::string transport_name;
+
+    static std::map<Defaults::FrameNotifyTransport, std::string> transport_type_map;
+
+    if (transport_type_map.empty())
+    {
+      transport_type_map[Defaults::FrameNotifyTransportZMQ] = "zmq";
+      transport_type_map[Defaults::FrameNotifyTransportSharedMemory] = "shm";
+      transport_type_map[Defaults::FrameNotifyTransportIllegal] = "unknown";
+    }
+
+    if (transport_type_map.count(transport))
+    {
+      transport_name = transport_type_map[transport];
+    }
+    else
+    {
+      transport_name = transport_type_map[Defaults::FrameNotifyTransportIllegal];
+    }
+
+    return transport_name;
+  }
+
   std::string rx_port_list(void)
   {
     std::stringstream rx_ports_stream;
@@ -168,11 +438,38 @@ public:
 
     config_msg.set_param<std::string>(CONFIG_RX_ADDRESS, rx_address_);
     config_msg.set_param<int>(CONFIG_RX_RECV_BUFFER_SIZE, rx_recv_buffer_size_);
+    config_msg.set_param<unsigned int>(CONFIG_RX_RECV_BATCH_SIZE, rx_recv_batch_size_);
+    config_msg.set_param<unsigned int>(CONFIG_RX_THREADS, rx_threads_);
+    config_msg.set_param<std::string>(CONFIG_RX_STEERING,
+                                      this->map_rx_steering_type_to_name(rx_steering_));
+    config_msg.set_param<bool>(CONFIG_RX_SPIN_MODE, rx_spin_mode_);
+    config_msg.set_param<unsigned int>(CONFIG_RX_SPIN_CHECK_INTERVAL, rx_spin_check_interval_);
+    config_msg.set_param<unsigned int>(CONFIG_RX_SPIN_IDLE_TIMEOUT_MS, rx_spin_idle_timeout_ms_);
+    config_msg.set_param<unsigned int>(CONFIG_RX_BUSY_POLL_US, rx_busy_poll_us_);
+    config_msg.set_param<bool>(CONFIG_RX_PREFER_BUSY_POLL, rx_prefer_busy_poll_);
+    config_msg.set_param<bool>(CONFIG_RX_UDP_GRO, rx_udp_gro_);
+    config_msg.set_param<unsigned int>(CONFIG_RX_RING_BLOCK_SIZE, rx_ring_block_size_);
+    config_msg.set_param<unsigned int>(CONFIG_RX_RING_BLOCK_TIMEOUT_MS, rx_ring_block_timeout_ms_);
+    config_msg.set_param<std::string>(CONFIG_RX_ENGINE, this->map_rx_engine_type_to_name(rx_engine_));
+    config_msg.set_param<unsigned int>(CONFIG_RX_URING_BUFFERS, rx_uring_buffers_);
+    config_msg.set_param<unsigned int>(CONFIG_RX_URING_BUFFER_SIZE, rx_uring_buffer_size_);
+    config_msg.set_param<std::string>(CONFIG_RX_TCP_MODE, this->map_rx_tcp_mode_type_to_name(rx_tcp_mode_));
     config_msg.set_param<std::string>(CONFIG_RX_ENDPOINT, rx_channel_endpoint_);
     config_msg.set_param<std::string>(CONFIG_CTRL_ENDPOINT, ctrl_channel_endpoint_);
     config_msg.set_param<std::string>(CONFIG_FRAME_READY_ENDPOINT, frame_ready_endpoint_);
     config_msg.set_param<std::string>(CONFIG_FRAME_RELEASE_ENDPOINT, frame_release_endpoint_);
+    config_msg.set_param<std::string>(CONFIG_FRAME_NOTIFY_FORMAT,
+                                      this->map_frame_notify_format_type_to_name(frame_notify_format_));
+    config_msg.set_param<std::string>(CONFIG_FRAME_NOTIFY_TRANSPORT,
+                                      this->map_frame_notify_transport_type_to_name(frame_notify_transport_));
+    config_msg.set_param<bool>(CONFIG_FRAME_NOTIFY_DIRECT, frame_notify_direct_);
     config_msg.set_param<std::string>(CONFIG_SHARED_BUFFER_NAME, shared_buffer_name_);
+    config_msg.set_param<unsigned int>(CONFIG_BUFFER_LEASE_TIMEOUT_MS, buffer_lease_timeout_ms_);
+    config_msg.set_param<bool>(CONFIG_BUFFER_RECLAIM_EXITED, buffer_reclaim_exited_);
+    config_msg.set_param<std::size_t>(CONFIG_SHARED_BUFFER_HUGE_PAGE_SIZE, shared_buffer_huge_page_size_);
+    config_msg.set_param<bool>(CONFIG_SHARED_BUFFER_PREFAULT, shared_buffer_prefault_);
+    config_msg.set_param<bool>(CONFIG_SHARED_BUFFER_LOCK, shared_buffer_lock_);
+    config_msg.set_param<int>(CONFIG_SHARED_BUFFER_NUMA_NODE, shared_buffer_numa_node_);
     config_msg.set_param<int>(CONFIG_FRAME_COUNT, frame_count_);
 
     std::string decoder_config_path("decoder_config/");
@@ -193,12 +490,36 @@ private:
   std::vector<uint16_t> rx_ports_;               //!< Port(s) to receive frame data on
   std::string           rx_address_;             //!< IP address to receive frame data on
   int                   rx_recv_buffer_size_;    //!< Receive socket buffer size
+  unsigned int          rx_recv_batch_size_;     //!< Number of packets to receive per call (1 disables batching)
+  unsigned int          rx_threads_;             //!< Number of RX threads to partition receive ports across
+  Defaults::RxSteering  rx_steering_;            //!< Steering of packets to RX threads (by port or frame)
+  bool                  rx_spin_mode_;           //!< Spin on non-blocking receives instead of blocking
+  unsigned int          rx_spin_check_interval_; //!< Number of spin iterations between reactor checks
+  unsigned int          rx_spin_idle_timeout_ms_; //!< Idle time before spinning falls back to blocking (0 = never)
+  unsigned int          rx_busy_poll_us_;        //!< Receive socket busy poll time in microseconds (0 = disabled)
+  bool                  rx_prefer_busy_poll_;    //!< Prefer busy polling over interrupts on receive sockets
+  bool                  rx_udp_gro_;             //!< Receive UDP packets coalesced by generic receive offload
+  unsigned int          rx_ring_block_size_;     //!< Packet RX ring block size in bytes
+  unsigned int          rx_ring_block_timeout_ms_; //!< Packet RX ring block retire timeout in milliseconds
+  Defaults::RxEngine    rx_engine_;              //!< Receive engine driving the RX threads (reactor or io_uring)
+  unsigned int          rx_uring_buffers_;       //!< Number of io_uring provided buffers per UDP RX thread
+  unsigned int          rx_uring_buffer_size_;   //!< Size of each io_uring provided buffer in bytes
+  Defaults::RxTcpMode   rx_tcp_mode_;            //!< TCP RX connection mode (connect out as client or accept as server)
   unsigned int          io_threads_;             //!< Number of IO threads for IPC channels
   std::string           rx_channel_endpoint_;    //!< IPC channel endpoint for RX thread communication
   std::string           ctrl_channel_endpoint_;  //!< IPC channel endpoint for control communication with other processes
   std::string           frame_ready_endpoint_;   //!< IPC channel endpoint for transmitting frame ready notifications to other processes
   std::string           frame_release_endpoint_; //!< IPC channel endpoint for receiving frame release notifications from other processes
+  Defaults::FrameNotifyFormat frame_notify_format_; //!< Format of frame ready notifications (JSON or binary)
+  Defaults::FrameNotifyTransport frame_notify_transport_; //!< Transport of frame notifications (ZeroMQ or shared memory rings)
+  bool                  frame_notify_direct_;    //!< RX thread owns the frame ready and release channels directly
   std::string           shared_buffer_name_;     //!< Shared memory frame buffer name
+  unsigned int          buffer_lease_timeout_ms_; //!< Time a buffer may be ready or held downstream before being reclaimed (0 = never)
+  bool                  buffer_reclaim_exited_;  //!< Reclaim buffers held by a process no longer running, by PID
+  std::size_t           shared_buffer_huge_page_size_; //!< Size of huge pages backing the shared buffer (0 = normal pages)
+  bool                  shared_buffer_prefault_; //!< Fault in all shared buffer pages at creation
+  bool                  shared_buffer_lock_;     //!< Lock all shared buffer pages into memory at creation
+  int                   shared_buffer_numa_node_; //!< NUMA node to bind shared buffer memory to (-1 = none)
   unsigned int          frame_timeout_ms_;       //!< Incomplete frame timeout in milliseconds
   unsigned int          frame_count_;            //!< Number of frames to receive before terminating
   bool                  enable_packet_logging_;  //!< Enable packet diagnostic logging
@@ -210,6 +531,7 @@ private:
   friend class FrameReceiverUDPRxThread;
   friend class FrameReceiverZMQRxThread;
   friend class FrameReceiverTCPRxThread;
+  friend class FrameReceiverPacketRxThread;
   friend class FrameReceiverConfigTestProxy;
   friend class FrameReceiverRxThreadTestProxy;
 };
@@ -9,6 +9,7 @@
 #define FRAMERECEIVER_INCLUDE_FRAMERECEIVERCONTROLLER_H_
 
 #include <set>
+#include <vector>
 #include <log4cxx/logger.h>
 
 #include "logging.h"
@@ -22,12 +23,15 @@
 #include "IpcChannel.h"
 #include "IpcMessage.h"
 #include "IpcReactor.h"
+#include "ThreadPlacement.h"
+#include "FrameNotification.h"
 #include "FrameReceiverException.h"
 #include "FrameReceiverConfig.h"
 #include "FrameReceiverRxThread.h"
 #include "FrameReceiverUDPRxThread.h"
 #include "FrameReceiverZMQRxThread.h"
 #include "FrameReceiverTCPRxThread.h"
+#include "FrameReceiverPacketRxThread.h"
 #include "FrameDecoder.h"
 #include "OdinDataException.h"
 #include "ClassLoader.h"
@@ -65,23 +69,36 @@ namespace FrameReceiver
     void setup_rx_channel(const std::string& ctrl_endpoint);
     void setup_frame_ready_channel(const std::string& ctrl_endpoint);
     void setup_frame_release_channel(const std::string& ctrl_endpoint);
+    void remove_frame_release_channel(void);
     void unbind_channel(OdinData::IpcChannel* channel, std::string& endpoint,
         const bool deferred=false);
     void cleanup_ipc_channels(void);
 
     void configure_frame_decoder(OdinData::IpcMessage& config_msg);
+    FrameDecoderPtr load_frame_decoder(void);
     bool new_decoder_class(OdinData::IpcMessage& config_msg);
     void configure_buffer_manager(OdinData::IpcMessage& config_msg);
     void configure_rx_thread(OdinData::IpcMessage& config_msg);
     void stop_rx_thread(void);
+    void configure_thread_placement(OdinData::IpcMessage& config_msg);
 
     void handle_ctrl_channel(void);
     void handle_rx_channel(void);
     void handle_frame_release_channel(void);
-
-    void precharge_buffers(void);
+    void release_frame(int buffer_id, int64_t frame, std::string& frame_release_encoded);
+    void release_frame_batch(const std::vector<FrameNotification>& frame_releases,
+        std::string& frame_release_encoded);
+    void release_frame_batch(OdinData::IpcMessage& frame_release, std::string& frame_release_encoded);
+    void check_frame_count(void);
+    void record_notify_latency(uint64_t ready_time_ns);
+    unsigned int get_frames_received(void);
+    unsigned int get_frames_released(void);
+
+    int rx_thread_index(const std::string& identity);
+    unsigned int rx_thread_for_buffer(int buffer_id);
+    void precharge_buffers(unsigned int thread_index);
     void notify_buffer_config(const bool deferred=false);
-    void store_rx_thread_status(OdinData::IpcMessage& rx_status_msg);
+    void store_rx_thread_status(unsigned int thread_index, OdinData::IpcMessage& rx_status_msg);
     void get_status(OdinData::IpcMessage& status_reply);
     void get_version(OdinData::IpcMessage& version_reply);
     void reset_statistics(OdinData::IpcMessage& reset_reply);
@@ -94,8 +111,9 @@ namespace FrameReceiver
 #endif
 
     log4cxx::LoggerPtr                       logger_;          //!< Pointer to the logging facility
-    boost::scoped_ptr<FrameReceiverRxThread> rx_thread_;       //!< Receiver thread object
+    std::vector<boost::shared_ptr<FrameReceiverRxThread> > rx_threads_; //!< Receiver thread objects
     FrameDecoderPtr                          frame_decoder_;   //!< Frame decoder object
+    std::vector<FrameDecoderPtr>             frame_decoders_;  //!< Frame decoder objects for each receiver thread
     SharedBufferManagerPtr                   buffer_manager_;  //!< Buffer manager object
 
     FrameReceiverConfig config_;         //!< Configuration storage object
@@ -111,6 +129,7 @@ namespace FrameReceiver
     bool buffer_manager_configured_;      //!< Indicates that the buffer manager is configured
     bool rx_thread_configured_;           //!< Indicates that the RX thread is configured
     bool configuration_complete_;         //!< Indicates that all components are configured
+    bool frame_release_registered_;       //!< Indicates that the frame release channel is in the reactor
 
     IpcContext& ipc_context_;             //!< ZMQ context for IPC channels
     IpcChannel rx_channel_;               //!< Channel for communication with receiver thread
@@ -123,10 +142,15 @@ namespace FrameReceiver
     unsigned int total_buffers_;          //!< Record the total number of buffers in the system
     unsigned int frames_received_;        //!< Counter for frames received
     unsigned int frames_released_;        //!< Counter for frames released
+    uint64_t frames_notified_;            //!< Counter for frame ready notifications with a known ready time
+    uint64_t notify_latency_total_ns_;    //!< Total latency between frames becoming ready and being notified
+    uint64_t notify_latency_max_ns_;      //!< Maximum latency between a frame becoming ready and being notified
+
+    std::vector<std::string> rx_thread_identities_; //!< Identities of the RX thread dealer channels
 
-    std::string rx_thread_identity_;      //!< Identity of the RX thread dealer channel
+    std::vector<boost::shared_ptr<OdinData::IpcMessage> > rx_thread_status_; //!< Status of the receiver threads
 
-    boost::scoped_ptr<OdinData::IpcMessage> rx_thread_status_; //!< Status of the receiver thread
+    std::string main_thread_name_;        //!< Name the main thread is registered under for placement
 
   };
 
@@ -25,10 +25,52 @@ enum RxType
   RxTypeIllegal = -1,
   RxTypeUDP,
   RxTypeZMQ,
-  RxTypeTCP
+  RxTypeTCP,
+  RxTypePacket
+};
+
+enum RxSteering
+{
+  RxSteeringIllegal = -1,
+  RxSteeringPort,
+  RxSteeringFrame
+};
+
+enum RxEngine
+{
+  RxEngineIllegal = -1,
+  RxEngineReactor,
+  RxEngineIoUring
+};
+
+enum RxTcpMode
+{
+  RxTcpModeIllegal = -1,
+  RxTcpModeClient,
+  RxTcpModeServer
+};
+
+enum FrameNotifyFormat
+{
+  FrameNotifyFormatIllegal = -1,
+  FrameNotifyFormatJson,
+  FrameNotifyFormatBinary
+};
+
+enum FrameNotifyTransport
+{
+  FrameNotifyTransportIllegal = -1,
+  FrameNotifyTransportZMQ,
+  FrameNotifyTransportSharedMemory
 };
 
 const std::size_t  default_max_buffer_mem         = 1048576;
+const unsigned int default_buffer_lease_timeout_ms = 0;
+const bool         default_buffer_reclaim_exited  = false;
+const std::size_t  default_shared_buffer_huge_page_size = 0;
+const bool         default_shared_buffer_prefault = false;
+const bool         default_shared_buffer_lock     = false;
+const int          default_shared_buffer_numa_node = -1;
 const std::string  default_decoder_path           = std::string(BUILD_DIR) + "/lib/";
 const std::string  default_decoder_type           = "unknown";
 const RxType       default_rx_type                = RxTypeUDP;
@@ -39,10 +81,38 @@ const int          default_rx_recv_buffer_size    = 1048576;
 #else
 const int          default_rx_recv_buffer_size    = 30000000;
 #endif
+const unsigned int default_rx_recv_batch_size    = 1;
+const unsigned int max_rx_recv_batch_size        = 1024;
+const unsigned int default_rx_threads            = 1;
+const unsigned int max_rx_threads                = 64;
+const RxSteering   default_rx_steering           = RxSteeringPort;
+const bool         default_rx_spin_mode          = false;
+const unsigned int default_rx_spin_check_interval = 1000;
+const unsigned int default_rx_spin_idle_timeout_ms = 1000;
+const unsigned int default_rx_busy_poll_us       = 0;
+const bool         default_rx_prefer_busy_poll   = false;
+const bool         default_rx_udp_gro            = false;
+const unsigned int default_rx_ring_block_size    = 1048576;
+const unsigned int default_rx_ring_block_timeout_ms = 10;
+const RxEngine     default_rx_engine             = RxEngineReactor;
+const unsigned int default_rx_uring_buffers      = 4096;
+const unsigned int max_rx_uring_buffers          = 32768;
+const unsigned int default_rx_uring_buffer_size  = 9216;
+const unsigned int default_rx_uring_sq_entries   = 64;
+const RxTcpMode    default_rx_tcp_mode           = RxTcpModeClient;
+const unsigned int default_rx_tcp_listen_backlog = 16;
+const unsigned int default_rx_tick_period_ms     = 100;
 const std::string  default_rx_chan_endpoint       = "inproc://rx_channel";
 const std::string  default_ctrl_chan_endpoint     = "tcp://127.0.0.1:5000";
 const unsigned int default_frame_timeout_ms       = 1000;
+const FrameNotifyFormat default_frame_notify_format = FrameNotifyFormatJson;
+const FrameNotifyTransport default_frame_notify_transport = FrameNotifyTransportZMQ;
+const bool         default_frame_notify_direct    = false;
+const unsigned int default_frame_ring_poll_ms     = 1;
 const bool         default_enable_packet_logging  = false;
+const bool         default_buffer_scrub           = false;
+const bool         default_buffer_scrub_fill      = false;
+const unsigned int default_buffer_scrub_fill_value = 0;
 const bool         default_force_reconfig         = false;
 
 }
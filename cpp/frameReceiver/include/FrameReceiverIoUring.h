@@ -0,0 +1,95 @@
+/*!
+ * FrameReceiverIoUring.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef FRAMERECEIVERIOURING_H_
+#define FRAMERECEIVERIOURING_H_
+
+#include <cstddef>
+#include <stdint.h>
+#include <linux/io_uring.h>
+
+#include "OdinDataException.h"
+
+namespace FrameReceiver
+{
+
+//! FrameReceiverIoUringException - custom exception class implementing "what" for error string
+class FrameReceiverIoUringException : public OdinData::OdinDataException
+{
+public:
+  FrameReceiverIoUringException(const std::string what) : OdinData::OdinDataException(what) { };
+};
+
+//! FrameReceiverIoUring - minimal io_uring instance for the RX thread receive engine
+//!
+//! This class sets up an io_uring submission and completion queue pair using the kernel system
+//! call interface directly, and provides the small set of operations needed by the RX threads:
+//! obtaining submission queue entries, submitting and waiting for completions in a single call,
+//! iterating over completions and managing a ring of provided buffers for multishot receives.
+//! An instance must only be used from the thread that created it.
+class FrameReceiverIoUring
+{
+public:
+  FrameReceiverIoUring(unsigned int sq_entries, unsigned int cq_entries);
+  ~FrameReceiverIoUring();
+
+  struct io_uring_sqe* get_sqe(void);
+  int submit_and_wait(unsigned int wait_nr);
+  struct io_uring_cqe* peek_cqe(void);
+  void cqe_seen(void);
+
+  void register_buffer_ring(uint16_t group_id, unsigned int num_buffers, size_t buffer_size);
+  uint8_t* get_buffer(uint16_t buffer_id) const;
+  void recycle_buffer(uint16_t buffer_id);
+  void publish_buffers(void);
+
+  //! Returns the number of io_uring_enter system calls made
+  uint64_t get_enter_calls(void) const { return enter_calls_; }
+  //! Returns the number of completions processed
+  uint64_t get_completions(void) const { return completions_; }
+
+private:
+
+  FrameReceiverIoUring(const FrameReceiverIoUring&);
+  FrameReceiverIoUring& operator=(const FrameReceiverIoUring&);
+
+  void cleanup(void);
+
+  int                      ring_fd_;          //!< io_uring file descriptor
+  void*                    sq_ring_;          //!< Mapped submission queue ring
+  size_t                   sq_ring_size_;     //!< Size of the mapped submission queue ring
+  void*                    cq_ring_;          //!< Mapped completion queue ring (may alias the SQ ring)
+  size_t                   cq_ring_size_;     //!< Size of the mapped completion queue ring
+  struct io_uring_sqe*     sqes_;             //!< Mapped submission queue entry array
+  size_t                   sqes_size_;        //!< Size of the mapped submission queue entry array
+
+  unsigned int*            sq_head_;          //!< Submission queue head, advanced by the kernel
+  unsigned int*            sq_tail_;          //!< Submission queue tail, advanced by this thread
+  unsigned int             sq_mask_;          //!< Submission queue index mask
+  unsigned int             sq_entries_;       //!< Number of submission queue entries
+  unsigned int*            sq_array_;         //!< Submission queue index array
+  unsigned int             sq_pending_;       //!< Number of entries queued but not yet submitted
+
+  unsigned int*            cq_head_;          //!< Completion queue head, advanced by this thread
+  unsigned int*            cq_tail_;          //!< Completion queue tail, advanced by the kernel
+  unsigned int             cq_mask_;          //!< Completion queue index mask
+  struct io_uring_cqe*     cqes_;             //!< Completion queue entry array
+
+  struct io_uring_buf*     buf_ring_;         //!< Provided buffer ring entries, NULL if not registered
+  size_t                   buf_ring_size_;    //!< Size of the mapped provided buffer ring
+  unsigned int             buf_mask_;         //!< Provided buffer ring index mask
+  uint16_t                 buf_tail_;         //!< Local provided buffer ring tail, published in batches
+  uint8_t*                 buffers_;          //!< Memory backing the provided buffers
+  size_t                   buffers_size_;     //!< Size of the memory backing the provided buffers
+  size_t                   buffer_size_;      //!< Size of each provided buffer
+
+  uint64_t                 enter_calls_;      //!< Number of io_uring_enter system calls made
+  uint64_t                 completions_;      //!< Number of completions processed
+};
+
+} // namespace FrameReceiver
+#endif /* FRAMERECEIVERIOURING_H_ */
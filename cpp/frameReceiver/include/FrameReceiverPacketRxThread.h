@@ -0,0 +1,92 @@
+/*!
+ * FrameReceiverPacketRxThread.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef FRAMERECEIVERPACKETRXTHREAD_H_
+#define FRAMERECEIVERPACKETRXTHREAD_H_
+
+#ifdef __linux__
+
+#include <vector>
+#include <time.h>
+#include <sys/socket.h>
+#include <linux/if_packet.h>
+#include <linux/filter.h>
+
+#include <log4cxx/logger.h>
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+#include "DebugLevelLogger.h"
+
+#include "IpcMessage.h"
+#include "SharedBufferManager.h"
+#include "FrameDecoderUDP.h"
+#include "FrameReceiverConfig.h"
+#include "FrameReceiverRxThread.h"
+
+using namespace OdinData;
+
+namespace FrameReceiver
+{
+
+//! FrameReceiverPacketRxThread - receiver thread using a memory-mapped packet socket ring
+//!
+//! This RX thread receives UDP packets through an AF_PACKET socket with a TPACKET_V3 receive ring
+//! mapped into the thread. A socket filter passes only UDP packets destined for the receive ports
+//! serviced by the thread, and the kernel fills blocks of the ring with them. The thread walks
+//! each completed block, copying the packet payloads directly into frame buffers via the
+//! FrameDecoderUDP interface, so that no system call is made per packet.
+class FrameReceiverPacketRxThread : public FrameReceiverRxThread
+{
+public:
+  FrameReceiverPacketRxThread(FrameReceiverConfig& config, SharedBufferManagerPtr buffer_manager,
+      FrameDecoderPtr frame_decoder, unsigned int tick_period_ms=Defaults::default_rx_tick_period_ms,
+      unsigned int thread_index=0);
+  virtual ~FrameReceiverPacketRxThread();
+
+private:
+
+  void run_specific_service(void);
+  void cleanup_specific_service(void);
+  void fill_specific_status_params(IpcMessage& status_msg);
+
+  bool resolve_interface(in_addr_t rx_addr, int& if_index);
+  void build_port_filter(in_addr_t rx_addr);
+  bool build_fanout_filter(void);
+
+  void handle_ring(void);
+  void process_block(struct tpacket_block_desc* block);
+  void process_packet(struct tpacket3_hdr* packet_hdr);
+
+  LoggerPtr              logger_;
+  FrameDecoderUDPPtr     frame_decoder_;
+
+  bool                   steer_by_frame_;      //!< Steer packets to RX threads by frame number
+  std::vector<struct sock_filter> port_filter_;   //!< BPF program selecting packets for the receive ports
+  std::vector<struct sock_filter> fanout_filter_; //!< BPF program selecting fanout socket by frame number
+
+  int                    ring_socket_;         //!< Packet socket file descriptor
+  uint8_t*               ring_;                //!< Address of the memory-mapped receive ring
+  size_t                 ring_size_;           //!< Size of the receive ring in bytes
+  unsigned int           block_size_;          //!< Size of each ring block in bytes
+  unsigned int           num_blocks_;          //!< Number of blocks in the ring
+  unsigned int           current_block_;       //!< Index of the next ring block to be processed
+
+  uint64_t               packets_received_;    //!< Number of packets received
+  uint64_t               packets_truncated_;   //!< Number of packets discarded as truncated or malformed
+  uint64_t               blocks_received_;     //!< Number of ring blocks processed
+  uint64_t               ring_drops_;          //!< Number of packets dropped by the kernel with the ring full
+  uint64_t               ring_freezes_;        //!< Number of times the ring filled and froze the queue
+  uint64_t               rate_packets_;        //!< Packet count at last rate calculation
+  struct timespec        rate_time_;           //!< Time of last rate calculation
+  double                 packet_rate_;         //!< Packet receive rate in packets per second
+
+};
+
+} // namespace FrameReceiver
+
+#endif /* __linux__ */
+#endif /* FRAMERECEIVERPACKETRXTHREAD_H_ */
@@ -10,6 +10,7 @@
 
 #include <boost/thread.hpp>
 #include <boost/asio.hpp>
+#include <boost/scoped_ptr.hpp>
 
 #include <log4cxx/logger.h>
 using namespace log4cxx;
@@ -20,9 +21,14 @@ using namespace log4cxx::helpers;
 #include "IpcChannel.h"
 #include "IpcMessage.h"
 #include "IpcReactor.h"
+#include "ThreadPlacement.h"
+#include "FrameNotification.h"
 #include "SharedBufferManager.h"
 #include "FrameDecoder.h"
 #include "FrameReceiverConfig.h"
+#ifdef HAVE_IO_URING
+#include "FrameReceiverIoUring.h"
+#endif
 #include "OdinDataException.h"
 
 using namespace OdinData;
@@ -32,6 +38,14 @@ namespace FrameReceiver
 
   const std::string RX_THREAD_ID = "RX_THREAD";
 
+#ifdef HAVE_IO_URING
+  //! io_uring completion tags reserved by the RX thread base class, distinct from those used
+  //! by subclasses for their receive operations
+  const uint64_t URING_TAG_RX_CHANNEL = 0xFFFFFFFF00000001ULL;
+  const uint64_t URING_TAG_TIMEOUT    = 0xFFFFFFFF00000002ULL;
+  const uint64_t URING_TAG_RELEASE_CHANNEL = 0xFFFFFFFF00000003ULL;
+#endif
+
 class FrameReceiverRxThreadException : public OdinData::OdinDataException
 {
 public:
@@ -42,7 +56,8 @@ class FrameReceiverRxThread
 {
 public:
   FrameReceiverRxThread(FrameReceiverConfig& config, SharedBufferManagerPtr buffer_manager,
-      FrameDecoderPtr frame_decoder, unsigned int tick_period_ms=100);
+      FrameDecoderPtr frame_decoder, unsigned int tick_period_ms=Defaults::default_rx_tick_period_ms,
+      unsigned int thread_index=0);
   virtual ~FrameReceiverRxThread();
 
   bool start();
@@ -50,16 +65,34 @@ public:
 
   void frame_ready(int buffer_id, int frame_number);
 
+  uint64_t get_direct_frames_ready(void) const;
+  uint64_t get_direct_frames_released(void) const;
+  void reset_direct_frame_counts(void);
+
 protected:
   virtual void run_specific_service(void) = 0;
   virtual void cleanup_specific_service(void) = 0;
+  virtual void fill_specific_status_params(IpcMessage& status_msg);
 
   void set_thread_init_error(const std::string& msg);
 
   void register_socket(int socket_fd, ReactorCallback callback);
-
-  FrameReceiverConfig&   config_;
-  IpcReactor             reactor_;
+  void track_socket(int socket_fd);
+
+  virtual void run_event_loop(void);
+  bool using_uring(void) const;
+#ifdef HAVE_IO_URING
+  virtual void handle_uring_completion(struct io_uring_cqe* cqe);
+  struct io_uring_sqe* get_uring_sqe(void);
+#endif
+
+  FrameReceiverConfig&   config_;         //!< Reference to the receiver configuration
+  IpcReactor             reactor_;        //!< Reactor for the RX thread event loop
+  unsigned int           thread_index_;   //!< Index of this thread amongst the RX threads
+  std::vector<uint16_t>  rx_ports_;       //!< Port(s) serviced by this thread
+#ifdef HAVE_IO_URING
+  boost::scoped_ptr<FrameReceiverIoUring> uring_; //!< io_uring instance when using the io_uring engine
+#endif
 
 private:
 
@@ -68,18 +101,58 @@ private:
   void advertise_identity(void);
   void request_buffer_precharge(void);
   void handle_rx_channel(void);
+  void service_rx_channel(void);
+  bool setup_frame_notify_channels(void);
+  void handle_frame_release_channel(void);
+  void service_frame_release_channel(void);
+  void notify_buffer_config(void);
+#ifdef HAVE_IO_URING
+  void run_uring_event_loop(void);
+  void submit_uring_channel_poll(int channel_fd, uint64_t tag);
+  bool submit_uring_timeout(void);
+#endif
   void tick_timer(void);
   void buffer_monitor_timer(void);
+  void frame_ring_timer(void);
+  void drain_release_ring(void);
+  unsigned int release_buffers(const std::string& release_encoded);
+  unsigned int release_buffers(IpcMessage& release_msg);
+  void release_buffer(int buffer_id, uint64_t frame=SharedBufferStates::any_frame);
+  void reclaim_buffers(void);
+  void record_notify_latency(uint64_t ready_time_ns);
   void fill_status_params(IpcMessage& status_msg);
 
   LoggerPtr              logger_;              //!< Pointer to the logging facility
   SharedBufferManagerPtr buffer_manager_;      //!< Pointer to the shared buffer manager
   FrameDecoderPtr        frame_decoder_;       //!< Pointer to the frame decoder
   unsigned int           tick_period_ms_;      //!< Receiver thread tick timer period
+  bool                   binary_notify_;       //!< Send binary rather than JSON frame ready notifications
+  bool                   monitoring_buffers_;  //!< Flag set while the decoder is monitoring buffers for timeouts
+  SharedFrameRings*      frame_rings_;         //!< Shared frame notification rings, NULL if not used
+  uint64_t               ring_frames_ready_;   //!< Number of frames notified ready through the rings
+  uint64_t               ring_frames_released_; //!< Number of frames released through the rings
+  uint64_t               ring_full_;           //!< Number of ready notifications not pushed as the ring was full
+  SharedBufferStates*    buffer_states_;       //!< Shared buffer state table, NULL if not present
+  uint64_t               buffers_reclaimed_;   //!< Number of buffers reclaimed from dead or stalled consumers
+  uint64_t               releases_refused_;    //!< Number of releases refused for buffers not ready or held
+  std::vector<uint64_t>  buffer_ready_time_ns_; //!< Time each buffer was last notified ready, zero once released
+  uint64_t               buffers_released_;    //!< Number of buffers released with a known ready time
+  uint64_t               release_latency_total_ns_; //!< Total latency between notifying and releasing buffers
+  uint64_t               release_latency_max_ns_;   //!< Maximum latency between notifying and releasing a buffer
+  uint64_t               direct_frames_ready_;    //!< Number of frames notified ready bypassing the main thread, accessed atomically
+  uint64_t               direct_frames_released_; //!< Number of frames released bypassing the main thread, accessed atomically
+  uint64_t               frames_notified_;     //!< Number of frames notified ready by this thread
+  uint64_t               notify_latency_total_ns_; //!< Total latency between frames becoming ready and being notified
+  uint64_t               notify_latency_max_ns_;   //!< Maximum latency between a frame becoming ready and being notified
 
   boost::shared_ptr<boost::thread> rx_thread_; //!< Pointer to RX thread
   IpcChannel             rx_channel_;          //!< Channel for communication with the main thread
+  boost::scoped_ptr<IpcChannel> frame_ready_channel_;   //!< Frame ready channel, if owned directly by this thread
+  boost::scoped_ptr<IpcChannel> frame_release_channel_; //!< Frame release channel, if owned directly by this thread
   std::vector<int>       recv_sockets_;        //!< List of receive socket file descriptors
+#ifdef HAVE_IO_URING
+  struct __kernel_timespec uring_timeout_;     //!< Timeout of the pending io_uring timer operation
+#endif
 
   bool                   run_thread_;          //!< Flag signalling thread should run
   volatile bool          thread_running_;      //!< Flag singalling if thread is running
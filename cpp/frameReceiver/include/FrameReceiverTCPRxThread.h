@@ -6,8 +6,15 @@
 #ifndef FRAMERECEIVERTCPRXTHREAD_H_
 #define FRAMERECEIVERTCPRXTHREAD_H_
 
+#include <vector>
+#include <time.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+
 #include <boost/thread.hpp>
 #include <boost/asio.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <log4cxx/logger.h>
 using namespace log4cxx;
@@ -27,22 +34,97 @@ using namespace OdinData;
 
 namespace FrameReceiver
 {
+
+//! FrameReceiverTCPRxThread - receiver thread for TCP message streams
+//!
+//! This RX thread receives messages from one or more TCP connections, either connecting out to
+//! each receive port as a client or listening on each port and accepting any number of detector
+//! connections as a server. Connections are serviced without blocking, with each message
+//! received directly into the regions of a frame buffer given by the frame decoder, resuming
+//! across partial reads. As the decoder assembles one message at a time, a connection part way
+//! through a message owns the decoder until the message is complete and reception on other
+//! connections is paused until then.
 class FrameReceiverTCPRxThread : public FrameReceiverRxThread
 {
 public:
   FrameReceiverTCPRxThread(FrameReceiverConfig& config, SharedBufferManagerPtr buffer_manager,
-      FrameDecoderPtr frame_decoder, unsigned int tick_period_ms=100);
+      FrameDecoderPtr frame_decoder, unsigned int tick_period_ms=Defaults::default_rx_tick_period_ms,
+      unsigned int thread_index=0);
   virtual ~FrameReceiverTCPRxThread();
 
 private:
+
+  //! Maximum number of frame buffer regions a message can be received into
+  static const unsigned int max_message_regions = 4;
+
+  //! State of a TCP connection receiving messages
+  struct TcpConnection
+  {
+    int             socket_fd;          //!< Connection socket file descriptor, -1 once closed
+    int             recv_port;          //!< Local port number of the connection
+    std::string     peer;               //!< Address and port of the remote end of the connection
+    struct iovec    regions[max_message_regions]; //!< Frame buffer regions remaining for the message
+    unsigned int    num_regions;        //!< Number of regions for the current message
+    unsigned int    region_idx;         //!< Index of the first region not yet completely filled
+    size_t          message_size;       //!< Size of the current message
+    size_t          bytes_received;     //!< Number of bytes of the current message received
+    bool            paused;             //!< Reception paused while another connection owns the decoder
+    struct msghdr   msg_hdr;            //!< Message header for io_uring receives
+    uint64_t        total_bytes;        //!< Total number of bytes received on the connection
+    uint64_t        messages_received;  //!< Number of complete messages received on the connection
+    uint64_t        rate_bytes;         //!< Byte count at last rate calculation
+    struct timespec rate_time;          //!< Time of last rate calculation
+    double          byte_rate;          //!< Receive rate in bytes per second
+  };
+  typedef boost::shared_ptr<TcpConnection> TcpConnectionPtr;
+
+  //! Listening socket accepting connections in server mode
+  typedef struct
+  {
+    int                socket_fd;       //!< Listening socket file descriptor
+    int                recv_port;       //!< Port number the socket is listening on
+    struct sockaddr_in accept_addr;     //!< Peer address of connections accepted through io_uring
+    socklen_t          accept_addr_len; //!< Length of the accepted peer address
+  } TcpListener;
+
   void run_specific_service(void);
   void cleanup_specific_service(void);
+  void fill_specific_status_params(IpcMessage& status_msg);
+
+  bool set_receive_buffer_size(int socket_fd, uint16_t rx_port);
+  bool open_listener(uint16_t rx_port, struct sockaddr_in& recv_addr);
+  bool connect_to_port(uint16_t rx_port, struct sockaddr_in& recv_addr);
+  unsigned int add_connection(int socket_fd, int recv_port, const struct sockaddr_in& peer_addr);
+  void close_connection(unsigned int connection_idx);
+  void close_sockets(void);
+
+  void handle_accept(unsigned int listener_idx);
+  void handle_receive_socket(unsigned int connection_idx);
+
+  void start_message(unsigned int connection_idx);
+  bool advance_message(TcpConnection& connection, size_t bytes_received);
+  void complete_message(unsigned int connection_idx);
+  void resume_paused_connections(void);
+
+#ifdef HAVE_IO_URING
+  void submit_uring_accept(unsigned int listener_idx);
+  void submit_uring_poll(unsigned int connection_idx);
+  void submit_uring_receive(unsigned int connection_idx);
+  void handle_uring_completion(struct io_uring_cqe* cqe);
+#endif
+
+  LoggerPtr                     logger_;
+  FrameDecoderTCPPtr            frame_decoder_;
 
-  void handle_receive_socket(int socket_fd, int recv_port);
+  std::vector<TcpListener>      listeners_;          //!< Listening sockets in server mode
+  std::vector<TcpConnectionPtr> connections_;        //!< Connections, with closed slots reused
+  int                           active_connection_;  //!< Connection owning the decoder, -1 if none
 
-  LoggerPtr          logger_;
-  FrameDecoderTCPPtr frame_decoder_;
-  int recv_socket_;
+  uint64_t               connections_accepted_;      //!< Number of connections accepted
+  uint64_t               connections_closed_;        //!< Number of connections closed
+  uint64_t               messages_received_;         //!< Number of complete messages received
+  uint64_t               messages_discarded_;        //!< Number of partial messages lost on close
+  uint64_t               recv_calls_;                //!< Number of receive system calls made
 };
 
 } // namespace FrameReceiver
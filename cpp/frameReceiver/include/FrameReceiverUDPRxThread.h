@@ -8,6 +8,13 @@
 #ifndef FRAMERECEIVERUDPRXTHREAD_H_
 #define FRAMERECEIVERUDPRXTHREAD_H_
 
+#include <vector>
+#include <time.h>
+#include <sys/socket.h>
+#ifdef __linux__
+#include <linux/filter.h>
+#endif
+
 #include <boost/thread.hpp>
 #include <boost/asio.hpp>
 
@@ -33,19 +40,77 @@ class FrameReceiverUDPRxThread : public FrameReceiverRxThread
 {
 public:
   FrameReceiverUDPRxThread(FrameReceiverConfig& config, SharedBufferManagerPtr buffer_manager,
-      FrameDecoderPtr frame_decoder, unsigned int tick_period_ms=100);
+      FrameDecoderPtr frame_decoder, unsigned int tick_period_ms=Defaults::default_rx_tick_period_ms,
+      unsigned int thread_index=0);
   virtual ~FrameReceiverUDPRxThread();
 
 private:
 
   void run_specific_service(void);
   void cleanup_specific_service(void);
+  void fill_specific_status_params(IpcMessage& status_msg);
+  void run_event_loop(void);
 
   void handle_receive_socket(int socket_fd, int recv_port);
+  unsigned int receive_packets(int socket_fd, int recv_port);
+  unsigned int receive_packet(int socket_fd, int recv_port);
+#ifdef __linux__
+  unsigned int receive_packet_batch(int socket_fd, int recv_port);
+  unsigned int receive_coalesced_packets(int socket_fd, int recv_port);
+#endif
+#ifdef __linux__
+  bool build_steering_filter(void);
+#endif
+
+#ifdef HAVE_IO_URING
+  void submit_uring_receive(unsigned int socket_idx);
+  void handle_uring_completion(struct io_uring_cqe* cqe);
+  void process_uring_packet(unsigned int socket_idx, const uint8_t* buffer, size_t bytes_received);
+#endif
+
+  //! Receive socket state for the io_uring engine
+  typedef struct
+  {
+    int           socket_fd;  //!< Receive socket file descriptor
+    int           recv_port;  //!< Port number of the socket
+    struct msghdr msg_hdr;    //!< Message header describing the layout of received messages
+  } UringSocket;
 
   LoggerPtr              logger_;
   FrameDecoderUDPPtr     frame_decoder_;
 
+  unsigned int                   recv_batch_size_;   //!< Number of packets to receive per call
+  std::vector<PacketReceiveSlot> batch_slots_;       //!< Decoder receive slots for batched mode
+#ifdef __linux__
+  std::vector<struct mmsghdr>    batch_msg_hdrs_;    //!< Message headers for batched receive
+#endif
+  std::vector<struct iovec>      batch_iovecs_;      //!< IO vectors for batched receive
+
+  bool                           steer_by_frame_;    //!< Steer packets to RX threads by frame number
+#ifdef __linux__
+  std::vector<struct sock_filter> steering_filter_;  //!< BPF program selecting socket by frame number
+#endif
+
+  bool                           udp_gro_;           //!< Receive packets coalesced by UDP GRO
+  std::vector<uint8_t>           gro_buffer_;        //!< Buffer receiving coalesced packets
+
+  bool                           spin_mode_;         //!< Spin on non-blocking receives instead of blocking
+  int                            recv_flags_;        //!< Flags for receive calls (non-blocking when spinning)
+  std::vector<std::pair<int, int> > spin_sockets_;   //!< Receive sockets and ports polled when spinning
+  uint64_t                       spin_polls_;        //!< Number of spin iterations polling the receive sockets
+  uint64_t                       spin_polls_with_data_; //!< Number of spin iterations receiving data
+  uint64_t                       spin_idle_fallbacks_;  //!< Number of times spinning fell back to blocking
+
+  std::vector<UringSocket>       uring_sockets_;     //!< Receive sockets serviced by the io_uring engine
+  uint64_t                       uring_buffer_exhaustions_; //!< Number of times io_uring receive buffers ran out
+
+  uint64_t               packets_received_;    //!< Number of packets received on all sockets
+  uint64_t               packets_truncated_;   //!< Number of packets discarded as truncated
+  uint64_t               recv_calls_;          //!< Number of receive system calls made
+  uint64_t               rate_packets_;        //!< Packet count at last rate calculation
+  struct timespec        rate_time_;           //!< Time of last rate calculation
+  double                 packet_rate_;         //!< Packet receive rate in packets per second
+
 };
 
 } // namespace FrameReceiver
@@ -33,7 +33,8 @@ class FrameReceiverZMQRxThread : public FrameReceiverRxThread
 {
 public:
   FrameReceiverZMQRxThread(FrameReceiverConfig& config, SharedBufferManagerPtr buffer_manager,
-      FrameDecoderPtr frame_decoder, unsigned int tick_period_ms=100);
+      FrameDecoderPtr frame_decoder, unsigned int tick_period_ms=Defaults::default_rx_tick_period_ms,
+      unsigned int thread_index=0);
   virtual ~FrameReceiverZMQRxThread();
 
 private:
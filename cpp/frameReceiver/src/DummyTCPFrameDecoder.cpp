@@ -90,6 +90,35 @@ void *DummyTCPFrameDecoder::get_next_message_buffer(void) {
                              read_so_far_);
 }
 
+/**
+ * Gets the regions of the current buffer to store the next message in,
+ * separating the frame header from the payload
+ *
+ * \param[out] regions Array of IO vectors to fill with the message regions
+ * \param[in] max_regions Maximum number of regions that can be filled in
+ * \return Number of regions filled in
+ */
+unsigned int
+DummyTCPFrameDecoder::get_next_message_regions(struct iovec *regions,
+                                               unsigned int max_regions) {
+  char *message_buffer = static_cast<char *>(get_next_message_buffer());
+  size_t message_size = get_next_message_size();
+
+  // Only split the message if part of the header remains to be received
+  if ((max_regions < 2) || (read_so_far_ >= header_size_)) {
+    regions[0].iov_base = message_buffer;
+    regions[0].iov_len = message_size;
+    return 1;
+  }
+
+  size_t header_remaining = header_size_ - read_so_far_;
+  regions[0].iov_base = message_buffer;
+  regions[0].iov_len = header_remaining;
+  regions[1].iov_base = message_buffer + header_remaining;
+  regions[1].iov_len = message_size - header_remaining;
+  return 2;
+}
+
 //! Get the size of the frame buffers required for current operation mode.
 //!
 //! This method returns the frame buffer size required for the current operation
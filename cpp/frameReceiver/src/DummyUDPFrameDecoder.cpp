@@ -200,6 +200,26 @@ void* DummyUDPFrameDecoder::get_packet_header_buffer(void)
   return current_packet_header_.get();
 }
 
+//! Get the location of the frame number field in packet headers.
+//!
+//! This method describes the location of the frame number field in the packet header, allowing
+//! packets to be steered to multiple RX threads by frame number. The dummy packet header is
+//! populated by the sender in host byte order.
+//!
+//! \param[out] field - description of the frame number field
+//! \return true, since frame steering is supported by this decoder
+//!
+bool DummyUDPFrameDecoder::get_frame_number_field(FrameNumberField& field) const
+{
+  const uint16_t byte_order_test = 1;
+
+  field.offset = offsetof(DummyUDP::PacketHeader, frame_number);
+  field.width = sizeof(uint32_t);
+  field.big_endian = (*reinterpret_cast<const uint8_t*>(&byte_order_test) == 0);
+
+  return true;
+}
+
 //! Process an incoming packet header.
 //!
 //! This method is called to process the header of an incoming packet. The content of that header is
@@ -224,9 +244,10 @@ void DummyUDPFrameDecoder::process_packet_header(size_t bytes_received, int port
   {
     current_frame_seen_ = frame_number;
 
-    if (frame_buffer_map_.count(current_frame_seen_) == 0)
+    current_frame_buffer_id_ = get_frame_buffer(current_frame_seen_);
+    if (current_frame_buffer_id_ < 0)
     {
-      if (empty_buffer_queue_.empty())
+      if (!pop_empty_buffer(current_frame_buffer_id_))
       {
         current_frame_buffer_ = dropped_frame_buffer_.get();
 
@@ -240,9 +261,7 @@ void DummyUDPFrameDecoder::process_packet_header(size_t bytes_received, int port
       }
       else
       {
-        current_frame_buffer_id_ = empty_buffer_queue_.front();
-        empty_buffer_queue_.pop();
-        frame_buffer_map_[current_frame_seen_] = current_frame_buffer_id_;
+        map_frame_buffer(current_frame_seen_, current_frame_buffer_id_);
         current_frame_buffer_ = buffer_manager_->get_buffer_address(current_frame_buffer_id_);
 
         if (!dropping_frame_data_)
@@ -266,7 +285,6 @@ void DummyUDPFrameDecoder::process_packet_header(size_t bytes_received, int port
     }
     else
     {
-      current_frame_buffer_id_ = frame_buffer_map_[current_frame_seen_];
       current_frame_buffer_ = buffer_manager_->get_buffer_address(current_frame_buffer_id_);
       current_frame_header_ = reinterpret_cast<DummyUDP::FrameHeader*>(current_frame_buffer_);
     }
@@ -274,7 +292,8 @@ void DummyUDPFrameDecoder::process_packet_header(size_t bytes_received, int port
   }
 
   // Update packet state in frame header
-  current_frame_header_->packet_state[packet_number] = 1;
+  OdinData::PacketStateBitmap(
+      current_frame_header_->packet_state, udp_packets_per_frame_).mark_received(packet_number);
 
   // Increment packet counters
   if (dropping_frame_data_) 
@@ -292,22 +311,44 @@ void DummyUDPFrameDecoder::process_packet_header(size_t bytes_received, int port
 //!
 //! This method initialises the frame header specified by the pointer argument, setting
 //! fields to their default values, clearing packet counters and setting the active FEM
-//! fields as appropriate.
+//! fields as appropriate. If the frame buffer has already been prepared by the buffer
+//! scrubber, only the frame number and start time are set.
 //!
 //! \param[in] header_ptr - pointer to frame header to initialise.
 //!
 void DummyUDPFrameDecoder::initialise_frame_header(DummyUDP::FrameHeader* header_ptr)
 {
+  if ((header_ptr == dropped_frame_buffer_.get()) ||
+      !empty_buffer_prepared(current_frame_buffer_id_))
+  {
+    prepare_frame_header(header_ptr);
+  }
+
   header_ptr->frame_number = current_frame_seen_;
-  header_ptr->frame_state = FrameDecoder::FrameReceiveStateIncomplete;
-  header_ptr->total_packets_expected = udp_packets_per_frame_;
-  header_ptr->total_packets_received = 0;
-  header_ptr->packet_size = udp_packet_size_;
+  gettime(reinterpret_cast<struct timespec*>(&(header_ptr->frame_start_time)));
 
-  memset(header_ptr->packet_state, 0, sizeof(uint8_t) * DummyUDP::max_packets);
+}
 
-  gettime(reinterpret_cast<struct timespec*>(&(header_ptr->frame_start_time)));
+//! Prepare a frame header for an empty buffer
+//!
+//! This method sets the fields of a frame header that do not depend on the frame number,
+//! clearing the packet counters and packet state.
+//!
+//! \param[out] header_ptr - pointer to frame header to prepare.
+//!
+void DummyUDPFrameDecoder::prepare_frame_header(void* header_ptr) const
+{
+  DummyUDP::FrameHeader* frame_header = reinterpret_cast<DummyUDP::FrameHeader*>(header_ptr);
 
+  frame_header->frame_number = DummyUDP::default_frame_number;
+  frame_header->frame_state = FrameDecoder::FrameReceiveStateIncomplete;
+  frame_header->frame_start_time.tv_sec = 0;
+  frame_header->frame_start_time.tv_nsec = 0;
+  frame_header->total_packets_expected = udp_packets_per_frame_;
+  frame_header->total_packets_received = 0;
+  frame_header->packet_size = udp_packet_size_;
+
+  OdinData::PacketStateBitmap(frame_header->packet_state, udp_packets_per_frame_).clear();
 }
 
 //! Get a pointer to the next payload buffer.
@@ -328,6 +369,66 @@ void* DummyUDPFrameDecoder::get_next_payload_buffer(void) const
   return reinterpret_cast<void*>(next_receive_location);
 }
 
+//! Predict the payload buffer for the next packet.
+//!
+//! This method predicts where the payload of the next packet should be received, before its
+//! header has been seen, allowing the RX thread to receive the header and payload in a single
+//! call. The prediction is made by predict_payload_buffer(). Where no prediction can be made, the
+//! payload is received into the scratch area of the dropped frame buffer and relocated once the
+//! header has been processed.
+//!
+//! \return pointer to the predicted payload buffer
+//!
+void* DummyUDPFrameDecoder::predict_next_payload_buffer(void)
+{
+  void* payload_buffer = predict_payload_buffer(0);
+  if (!payload_buffer)
+  {
+    payload_buffer = reinterpret_cast<uint8_t*>(dropped_frame_buffer_.get()) + get_frame_header_size();
+  }
+  return payload_buffer;
+}
+
+//! Predict the payload buffer for a packet in a batch.
+//!
+//! Packets normally arrive in order, so the packets following the last one received are predicted
+//! to land in the following packet locations of the current frame, as long as those packets have
+//! not already been received. If no frame is being received, the packets are predicted to be the
+//! first of the next frame, landing in the buffer at the top of the empty buffer stack. Packets
+//! beyond the end of the frame are not predicted.
+//!
+//! \param[in] packets_ahead - position of the packet in the batch, zero for the next packet
+//! \return pointer to the predicted payload buffer, or NULL if no prediction can be made
+//!
+void* DummyUDPFrameDecoder::predict_payload_buffer(unsigned int packets_ahead)
+{
+  uint8_t* frame_buffer = NULL;
+  uint32_t packet_number = packets_ahead;
+
+  if (current_frame_seen_ != DummyUDP::default_frame_number)
+  {
+    packet_number = get_packet_number() + 1 + packets_ahead;
+    if ((packet_number < udp_packets_per_frame_) &&
+        !OdinData::PacketStateBitmap(current_frame_header_->packet_state,
+            udp_packets_per_frame_).is_received(packet_number))
+    {
+      frame_buffer = reinterpret_cast<uint8_t*>(current_frame_buffer_);
+    }
+  }
+  else if ((packet_number < udp_packets_per_frame_) && (next_empty_buffer() >= 0))
+  {
+    frame_buffer = reinterpret_cast<uint8_t*>(
+        buffer_manager_->get_buffer_address(next_empty_buffer()));
+  }
+
+  if (!frame_buffer)
+  {
+    return NULL;
+  }
+  return reinterpret_cast<void*>(
+      frame_buffer + get_frame_header_size() + (udp_packet_size_ * packet_number));
+}
+
 //! Get the next packet payload size to receive
 //!
 //! This method returns the payload size to receive for the next incoming packet.
@@ -369,8 +470,8 @@ FrameDecoder::FrameReceiveState DummyUDPFrameDecoder::process_packet(
 
     if (!dropping_frame_data_)
     {
-      // Erase frame from buffer map
-      frame_buffer_map_.erase(current_frame_seen_);
+      // Unmap frame from its buffer
+      unmap_frame_buffer(current_frame_seen_);
 
       // Notify main thread that frame is ready
       ready_callback_(current_frame_buffer_id_, current_frame_header_->frame_number);
@@ -393,43 +494,35 @@ FrameDecoder::FrameReceiveState DummyUDPFrameDecoder::process_packet(
 void DummyUDPFrameDecoder::monitor_buffers(void)
 {
   int frames_timedout = 0;
+  int frame_num;
+  int buffer_id;
 
-  struct timespec current_time;
-  gettime(&current_time);
-
-  // Loop over frame buffers currently in map and check their state
-  std::map<int, int>::iterator buffer_map_iter = frame_buffer_map_.begin();
-  while (buffer_map_iter != frame_buffer_map_.end())
+  // Release each frame buffer mapped for longer than the timeout, marking the frame as incomplete
+  uint64_t current_time_ns = get_monotonic_time_ns();
+  while (pop_timedout_frame(current_time_ns, frame_num, buffer_id))
   {
-    int frame_num = buffer_map_iter->first;
-    int buffer_id = buffer_map_iter->second;
-
     void *buffer_addr = buffer_manager_->get_buffer_address(buffer_id);
 
     DummyUDP::FrameHeader* frame_header = reinterpret_cast<DummyUDP::FrameHeader*>(buffer_addr);
 
-    // If the time since the frame starting being filled with packets exceeds a timeout, mark
-    // the frame as incomplete and call the ready callback.
-    if (elapsed_ms(frame_header->frame_start_time, current_time) > frame_timeout_ms_)
-    {
-      // Calculated packets lost on this frame and add to total
-      uint32_t packets_lost = udp_packets_per_frame_ - frame_header->total_packets_received;
-      packets_lost_ += packets_lost;
+    // Calculated packets lost on this frame and add to total
+    uint32_t packets_lost = udp_packets_per_frame_ - frame_header->total_packets_received;
+    packets_lost_ += packets_lost;
 
-      LOG4CXX_DEBUG_LEVEL(1, logger_, "Frame " << frame_num << " in buffer " << buffer_id
-          << " addr 0x" << std::hex
-          << buffer_addr << std::dec << " timed out with " << frame_header->total_packets_received
-          << " packets received, " << packets_lost << " packets lost");
+    LOG4CXX_DEBUG_LEVEL(1, logger_, "Frame " << frame_num << " in buffer " << buffer_id
+        << " addr 0x" << std::hex
+        << buffer_addr << std::dec << " timed out with " << frame_header->total_packets_received
+        << " packets received, " << packets_lost << " packets lost");
 
-      frame_header->frame_state = FrameReceiveStateTimedout;
-      ready_callback_(buffer_id, frame_num);
-      frames_timedout++;
+    frame_header->frame_state = FrameReceiveStateTimedout;
+    ready_callback_(buffer_id, frame_num);
+    frames_timedout++;
 
-      frame_buffer_map_.erase(buffer_map_iter++);
-    }
-    else 
+    // If the timed out frame is the current frame, reset the current frame seen ID so that
+    // packet payloads are not predicted into the released buffer
+    if (frame_num == current_frame_seen_)
     {
-      buffer_map_iter++;
+      current_frame_seen_ = DummyUDP::default_frame_number;
     }
   }
 
@@ -464,11 +557,13 @@ void DummyUDPFrameDecoder::get_status(const std::string param_prefix,
   status_msg.set_param(param_prefix + "packets_received", packets_received_);
   status_msg.set_param(param_prefix + "packets_lost", packets_lost_);
   status_msg.set_param(param_prefix + "packets_dropped", packets_dropped_);
+  status_msg.set_param(param_prefix + "packets_relocated", packets_relocated_);
 }
 
 //! Reset the decoder statistics.
 //!
-//! This method resets the frame decoder statistics, including packets received and lost 
+//! This method resets the frame decoder statistics, including packets received, lost and
+//! relocated.
 //!
 void DummyUDPFrameDecoder::reset_statistics()
 {
@@ -503,21 +598,3 @@ uint32_t DummyUDPFrameDecoder::get_packet_number(void) const
       current_packet_header_.get())->packet_number_flags & DummyUDP::packet_number_mask;
 }
 
-//! Calculate and return an elapsed time in milliseconds.
-//!
-//! This method calculates and returns an elapsed time in milliseconds based on the start and
-//! end timespec structs passed as arguments.
-//!
-//! \param[in] start - start time in timespec struct format
-//! \param[in] end - end time in timespec struct format
-//! \return elapsed time between start and end in milliseconds
-//!
-unsigned int DummyUDPFrameDecoder::elapsed_ms(struct timespec& start, struct timespec& end)
-{
-
-  double start_ns = ((double) start.tv_sec * 1000000000) + start.tv_nsec;
-  double end_ns = ((double) end.tv_sec * 1000000000) + end.tv_nsec;
-
-  return (unsigned int)((end_ns - start_ns) / 1000000);
-}
-
@@ -0,0 +1,214 @@
+/*!
+ * FrameBufferScrubber.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <algorithm>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "FrameBufferScrubber.h"
+
+using namespace FrameReceiver;
+
+//! Interval at which a waiting scrubbing thread checks whether it should stop
+static const unsigned int scrubber_wait_ms = 100;
+
+//! Construct a FrameBufferScrubber and start its thread.
+//!
+//! The queues are sized to hold every buffer in the shared buffer, so that submitting and
+//! collecting buffers can never fail while each buffer is only held once.
+//!
+//! \param[in] buffer_manager - shared buffer manager of the buffers to prepare
+//! \param[in] header - prepared frame header to copy to the start of each buffer
+//! \param[in] fill_payload - fill the remainder of each buffer after the header
+//! \param[in] fill_value - byte value to fill payloads with
+//!
+FrameBufferScrubber::FrameBufferScrubber(OdinData::SharedBufferManagerPtr buffer_manager,
+    const std::vector<char>& header, bool fill_payload, uint8_t fill_value) :
+    buffer_manager_(buffer_manager),
+    header_(header),
+    fill_payload_(fill_payload),
+    fill_value_(fill_value),
+    submitted_(std::max<size_t>(buffer_manager->get_num_buffers(), 1)),
+    prepared_(std::max<size_t>(buffer_manager->get_num_buffers(), 1)),
+    num_submitted_(0),
+    num_scrubbed_(0),
+    waiting_(false),
+    run_thread_(true)
+{
+  thread_.reset(new boost::thread(boost::bind(&FrameBufferScrubber::run, this)));
+}
+
+//! Destroy a FrameBufferScrubber, stopping its thread.
+//!
+//! Buffers still queued, whether prepared or not, are discarded.
+//!
+FrameBufferScrubber::~FrameBufferScrubber()
+{
+  {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    run_thread_ = false;
+  }
+  wakeup_.notify_one();
+  thread_->join();
+}
+
+//! Submit a released buffer for preparation.
+//!
+//! This method is called by the single thread that owns the buffers, waking the scrubbing thread
+//! only if it is waiting for buffers.
+//!
+//! \param[in] buffer_id - SharedBufferManager buffer ID
+//! \return true if the buffer was queued, false if the buffer ID is invalid or the queue is full
+//!
+bool FrameBufferScrubber::submit(int buffer_id)
+{
+  if ((buffer_id < 0) || (static_cast<size_t>(buffer_id) >= buffer_manager_->get_num_buffers()) ||
+      !submitted_.push(buffer_id))
+  {
+    return false;
+  }
+  __atomic_add_fetch(&num_submitted_, 1, __ATOMIC_RELAXED);
+
+  // Order the push before checking whether the scrubbing thread is waiting, which it sets
+  // before checking the queue, so that one of the two always sees the other
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&waiting_, __ATOMIC_RELAXED))
+  {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    wakeup_.notify_one();
+  }
+  return true;
+}
+
+//! Collect a prepared buffer.
+//!
+//! \param[out] buffer_id - SharedBufferManager buffer ID of the buffer prepared
+//! \return true if a prepared buffer was collected
+//!
+bool FrameBufferScrubber::collect(int& buffer_id)
+{
+  return prepared_.pop(buffer_id);
+}
+
+//! Get the number of buffers submitted and not yet prepared.
+//!
+//! \return backlog of buffers awaiting preparation
+//!
+size_t FrameBufferScrubber::get_backlog(void) const
+{
+  return static_cast<size_t>(__atomic_load_n(&num_submitted_, __ATOMIC_RELAXED) -
+      __atomic_load_n(&num_scrubbed_, __ATOMIC_RELAXED));
+}
+
+//! Get the number of prepared buffers waiting to be collected.
+//!
+//! \return number of prepared buffers queued
+//!
+size_t FrameBufferScrubber::get_num_prepared(void) const
+{
+  return prepared_.read_available();
+}
+
+//! Get the number of buffers prepared.
+//!
+//! \return number of buffers prepared since the scrubber was started
+//!
+uint64_t FrameBufferScrubber::get_num_scrubbed(void) const
+{
+  return __atomic_load_n(&num_scrubbed_, __ATOMIC_RELAXED);
+}
+
+//! Fill a region of memory with a byte value.
+//!
+//! Where SSE2 is available, the aligned body of the region is written with non-temporal stores,
+//! bypassing the cache, followed by a store fence so that the fill is visible before the region
+//! is handed on. Otherwise the region is simply filled with memset.
+//!
+//! \param[in] region - start of the region
+//! \param[in] size - size of the region in bytes
+//! \param[in] value - byte value to fill with
+//!
+void FrameBufferScrubber::fill(void* region, size_t size, uint8_t value)
+{
+#ifdef __SSE2__
+  char* start = static_cast<char*>(region);
+  char* end = start + size;
+  char* body = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(start) + 15) & ~static_cast<uintptr_t>(15));
+  if (body + 16 > end)
+  {
+    memset(region, value, size);
+    return;
+  }
+  memset(start, value, body - start);
+  __m128i pattern = _mm_set1_epi8(static_cast<char>(value));
+  for (; body + 16 <= end; body += 16)
+  {
+    _mm_stream_si128(reinterpret_cast<__m128i*>(body), pattern);
+  }
+  memset(body, value, end - body);
+  _mm_sfence();
+#else
+  memset(region, value, size);
+#endif
+}
+
+//! Run the scrubbing thread.
+//!
+//! Buffers are prepared in the order they were submitted. When none are queued, the thread
+//! waits to be woken by a submission, checking periodically whether it should stop.
+//!
+void FrameBufferScrubber::run(void)
+{
+  int buffer_id;
+  while (true)
+  {
+    while (submitted_.pop(buffer_id))
+    {
+      this->scrub(buffer_id);
+    }
+
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    __atomic_store_n(&waiting_, true, __ATOMIC_SEQ_CST);
+    while (run_thread_ && !submitted_.read_available())
+    {
+      wakeup_.timed_wait(lock, boost::posix_time::milliseconds(scrubber_wait_ms));
+    }
+    __atomic_store_n(&waiting_, false, __ATOMIC_RELAXED);
+    if (!run_thread_)
+    {
+      break;
+    }
+  }
+}
+
+//! Prepare a buffer for reuse.
+//!
+//! The prepared header is copied to the start of the buffer and, if configured, the rest of the
+//! buffer filled, before the buffer is queued for collection.
+//!
+//! \param[in] buffer_id - SharedBufferManager buffer ID
+//!
+void FrameBufferScrubber::scrub(int buffer_id)
+{
+  char* buffer = static_cast<char*>(buffer_manager_->get_buffer_address(buffer_id));
+  size_t buffer_size = buffer_manager_->get_buffer_size(buffer_id);
+  size_t header_size = std::min(header_.size(), buffer_size);
+
+  if (header_size)
+  {
+    memcpy(buffer, &header_[0], header_size);
+  }
+  if (fill_payload_)
+  {
+    FrameBufferScrubber::fill(buffer + header_size, buffer_size - header_size, fill_value_);
+  }
+
+  prepared_.push(buffer_id);
+  __atomic_add_fetch(&num_scrubbed_, 1, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,400 @@
+/*!
+ * FrameBufferTable.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <algorithm>
+
+#include "FrameBufferTable.h"
+
+using namespace FrameReceiver;
+
+const int FrameBufferTable::no_buffer;
+
+//! Minimum number of hash table slots, which must be a power of two
+static const size_t min_table_slots = 8;
+
+//! Multiplier for Fibonacci hashing of frame numbers, 2^32 divided by the golden ratio
+static const uint32_t fibonacci_multiplier = 2654435769U;
+
+//! Constructor for the FrameBufferTable class.
+//!
+//! This constructor creates an empty table with the minimum number of slots. The table grows
+//! as buffers are added, but should be sized for the buffers in use with resize() before use
+//! so that no allocation occurs while frames are being received.
+//!
+FrameBufferTable::FrameBufferTable() :
+    empty_buffers_(1),
+    num_empty_(0),
+    slot_mask_(0),
+    slot_shift_(32),
+    num_mapped_(0),
+    oldest_(no_buffer),
+    newest_(no_buffer)
+{
+  rehash(min_table_slots);
+}
+
+//! Size the table for a number of buffers.
+//!
+//! This method allocates the storage needed to track the specified number of buffers, i.e. buffer
+//! IDs up to one less than the number given, divided between the specified number of pools.
+//! Buffers already held are retained.
+//!
+//! \param[in] num_buffers - number of buffers to size the table for
+//! \param[in] num_pools - number of pools the buffers are divided between
+//!
+void FrameBufferTable::resize(size_t num_buffers, unsigned int num_pools)
+{
+  if (num_pools > empty_buffers_.size())
+  {
+    empty_buffers_.resize(num_pools);
+  }
+  if (num_buffers > 0)
+  {
+    ensure_buffer(static_cast<int>(num_buffers - 1));
+    for (size_t pool = 0; pool < empty_buffers_.size(); pool++)
+    {
+      empty_buffers_[pool].reserve(num_buffers);
+    }
+  }
+}
+
+//! Push a buffer onto the empty buffer stack of its pool.
+//!
+//! \param[in] buffer_id - ID of the empty buffer
+//! \param[in] pool - pool the buffer belongs to
+//!
+void FrameBufferTable::push_empty(int buffer_id, unsigned int pool)
+{
+  if (pool >= empty_buffers_.size())
+  {
+    empty_buffers_.resize(pool + 1);
+  }
+  ensure_buffer(buffer_id);
+  empty_buffers_[pool].push_back(buffer_id);
+  num_empty_++;
+}
+
+//! Pop a buffer from the empty buffer stack of a pool.
+//!
+//! The most recently pushed buffer is returned first, as it is the most likely to still be
+//! resident in the processor caches and TLB.
+//!
+//! \param[out] buffer_id - ID of the empty buffer popped
+//! \param[in] pool - pool to pop the buffer from
+//! \return true if a buffer was popped, false if the stack is empty
+//!
+bool FrameBufferTable::pop_empty(int& buffer_id, unsigned int pool)
+{
+  if ((pool >= empty_buffers_.size()) || empty_buffers_[pool].empty())
+  {
+    return false;
+  }
+  buffer_id = empty_buffers_[pool].back();
+  empty_buffers_[pool].pop_back();
+  num_empty_--;
+  return true;
+}
+
+//! Return the buffer that will next be popped from the empty buffer stack of a pool.
+//!
+//! \param[in] pool - pool of the stack
+//! \return ID of the next empty buffer, or -1 if the stack is empty
+//!
+int FrameBufferTable::next_empty(unsigned int pool) const
+{
+  if ((pool >= empty_buffers_.size()) || empty_buffers_[pool].empty())
+  {
+    return no_buffer;
+  }
+  return empty_buffers_[pool].back();
+}
+
+//! Return the number of empty buffers on the stack of a pool.
+//!
+//! \param[in] pool - pool of the stack
+//! \return number of empty buffers
+//!
+size_t FrameBufferTable::num_empty(unsigned int pool) const
+{
+  return (pool < empty_buffers_.size()) ? empty_buffers_[pool].size() : 0;
+}
+
+//! Drop all buffers from the empty buffer stacks.
+//!
+void FrameBufferTable::drop_empty(void)
+{
+  for (size_t pool = 0; pool < empty_buffers_.size(); pool++)
+  {
+    empty_buffers_[pool].clear();
+  }
+  num_empty_ = 0;
+}
+
+//! Map a buffer to a frame.
+//!
+//! This method maps a buffer to a frame being received, recording the time the frame started so
+//! that it can later be timed out. Frames must be mapped in the order of their start times.
+//!
+//! \param[in] frame - frame number
+//! \param[in] buffer_id - ID of the buffer receiving the frame
+//! \param[in] start_ns - time the frame started, in nanoseconds
+//! \return true if the buffer was mapped, false if the frame or buffer is already mapped
+//!
+bool FrameBufferTable::map(int frame, int buffer_id, uint64_t start_ns)
+{
+  if (buffer_id < 0)
+  {
+    return false;
+  }
+  ensure_buffer(buffer_id);
+  if (is_mapped_[buffer_id] || (find_slot(frame) != slots_.size()))
+  {
+    return false;
+  }
+
+  // Keep the table at most half full so that probe sequences remain short
+  if ((num_mapped_ + 1) * 2 > slots_.size())
+  {
+    rehash(slots_.size() * 2);
+  }
+
+  size_t slot = home_slot(frame);
+  while (slots_[slot] != no_buffer)
+  {
+    slot = (slot + 1) & slot_mask_;
+  }
+  slots_[slot] = buffer_id;
+
+  frame_[buffer_id] = frame;
+  start_ns_[buffer_id] = start_ns;
+  is_mapped_[buffer_id] = true;
+
+  // Append the buffer to the tail of the timeout list
+  prev_[buffer_id] = newest_;
+  next_[buffer_id] = no_buffer;
+  if (newest_ != no_buffer)
+  {
+    next_[newest_] = buffer_id;
+  }
+  else
+  {
+    oldest_ = buffer_id;
+  }
+  newest_ = buffer_id;
+  num_mapped_++;
+
+  return true;
+}
+
+//! Look up the buffer mapped to a frame.
+//!
+//! \param[in] frame - frame number
+//! \return ID of the buffer mapped to the frame, or -1 if the frame is not mapped
+//!
+int FrameBufferTable::lookup(int frame) const
+{
+  size_t slot = find_slot(frame);
+  return (slot != slots_.size()) ? slots_[slot] : no_buffer;
+}
+
+//! Unmap the buffer mapped to a frame.
+//!
+//! \param[in] frame - frame number
+//! \return true if the frame was unmapped, false if the frame is not mapped
+//!
+bool FrameBufferTable::unmap(int frame)
+{
+  size_t slot = find_slot(frame);
+  if (slot == slots_.size())
+  {
+    return false;
+  }
+  int buffer_id = slots_[slot];
+  remove_slot(slot);
+
+  // Unlink the buffer from the timeout list
+  if (prev_[buffer_id] != no_buffer)
+  {
+    next_[prev_[buffer_id]] = next_[buffer_id];
+  }
+  else
+  {
+    oldest_ = next_[buffer_id];
+  }
+  if (next_[buffer_id] != no_buffer)
+  {
+    prev_[next_[buffer_id]] = prev_[buffer_id];
+  }
+  else
+  {
+    newest_ = prev_[buffer_id];
+  }
+  is_mapped_[buffer_id] = false;
+  num_mapped_--;
+
+  return true;
+}
+
+//! Unmap the oldest frame if it started before a deadline.
+//!
+//! This method is called repeatedly to find the frames that have timed out, with a deadline of
+//! the current time less the frame timeout, until it returns false. As frames are mapped in the
+//! order they started, only the frames that have timed out and the oldest frame that has not are
+//! visited.
+//!
+//! \param[in] deadline_ns - time before which frames have timed out, in nanoseconds
+//! \param[out] frame - frame number of the frame unmapped
+//! \param[out] buffer_id - ID of the buffer unmapped
+//! \return true if a frame was unmapped, false if no frames started before the deadline
+//!
+bool FrameBufferTable::pop_expired(uint64_t deadline_ns, int& frame, int& buffer_id)
+{
+  if ((oldest_ == no_buffer) || (start_ns_[oldest_] >= deadline_ns))
+  {
+    return false;
+  }
+  frame = frame_[oldest_];
+  buffer_id = oldest_;
+  return unmap(frame);
+}
+
+//! Drop all buffers mapped to frames.
+//!
+void FrameBufferTable::drop_mapped(void)
+{
+  for (int buffer_id = oldest_; buffer_id != no_buffer; buffer_id = next_[buffer_id])
+  {
+    is_mapped_[buffer_id] = false;
+  }
+  std::fill(slots_.begin(), slots_.end(), no_buffer);
+  oldest_ = no_buffer;
+  newest_ = no_buffer;
+  num_mapped_ = 0;
+}
+
+//! Ensure the table can hold a buffer ID.
+//!
+//! This method grows the per-buffer storage, the empty buffer stacks and, if necessary, the hash
+//! table so that the specified buffer ID, and therefore all buffers up to it, can be held.
+//!
+//! \param[in] buffer_id - buffer ID
+//!
+void FrameBufferTable::ensure_buffer(int buffer_id)
+{
+  size_t num_buffers = static_cast<size_t>(buffer_id) + 1;
+  if (num_buffers <= frame_.size())
+  {
+    return;
+  }
+  frame_.resize(num_buffers);
+  start_ns_.resize(num_buffers);
+  prev_.resize(num_buffers, no_buffer);
+  next_.resize(num_buffers, no_buffer);
+  is_mapped_.resize(num_buffers, false);
+  for (size_t pool = 0; pool < empty_buffers_.size(); pool++)
+  {
+    empty_buffers_[pool].reserve(num_buffers);
+  }
+
+  size_t num_slots = slots_.size();
+  while (num_slots < num_buffers * 2)
+  {
+    num_slots *= 2;
+  }
+  if (num_slots != slots_.size())
+  {
+    rehash(num_slots);
+  }
+}
+
+//! Rebuild the hash table with a new number of slots.
+//!
+//! \param[in] num_slots - number of slots, which must be a power of two
+//!
+void FrameBufferTable::rehash(size_t num_slots)
+{
+  slots_.assign(num_slots, no_buffer);
+  slot_mask_ = num_slots - 1;
+  slot_shift_ = 32;
+  while (num_slots > 1)
+  {
+    num_slots >>= 1;
+    slot_shift_--;
+  }
+
+  for (int buffer_id = oldest_; buffer_id != no_buffer; buffer_id = next_[buffer_id])
+  {
+    size_t slot = home_slot(frame_[buffer_id]);
+    while (slots_[slot] != no_buffer)
+    {
+      slot = (slot + 1) & slot_mask_;
+    }
+    slots_[slot] = buffer_id;
+  }
+}
+
+//! Return the slot a frame hashes to.
+//!
+//! Frame numbers are hashed by Fibonacci hashing, which spreads both consecutive and strided
+//! frame numbers, e.g. those received by one of several nodes, evenly across the slots.
+//!
+//! \param[in] frame - frame number
+//! \return home slot of the frame
+//!
+size_t FrameBufferTable::home_slot(int frame) const
+{
+  return static_cast<size_t>((static_cast<uint32_t>(frame) * fibonacci_multiplier) >> slot_shift_);
+}
+
+//! Find the slot holding the buffer mapped to a frame.
+//!
+//! \param[in] frame - frame number
+//! \return slot holding the buffer, or the number of slots if the frame is not mapped
+//!
+size_t FrameBufferTable::find_slot(int frame) const
+{
+  size_t slot = home_slot(frame);
+  while (slots_[slot] != no_buffer)
+  {
+    if (frame_[slots_[slot]] == frame)
+    {
+      return slot;
+    }
+    slot = (slot + 1) & slot_mask_;
+  }
+  return slots_.size();
+}
+
+//! Remove the buffer held in a slot from the hash table.
+//!
+//! Entries later in the same probe sequence are shifted back into the vacated slot, so that
+//! lookups never need to skip over deleted entries.
+//!
+//! \param[in] slot - slot to empty
+//!
+void FrameBufferTable::remove_slot(size_t slot)
+{
+  size_t next_slot = slot;
+  while (true)
+  {
+    next_slot = (next_slot + 1) & slot_mask_;
+    if (slots_[next_slot] == no_buffer)
+    {
+      break;
+    }
+    // Move the entry back unless its home slot lies cyclically after the vacated slot
+    size_t home = home_slot(frame_[slots_[next_slot]]);
+    bool stays = (slot <= next_slot) ? ((slot < home) && (home <= next_slot)) :
+                                       ((slot < home) || (home <= next_slot));
+    if (!stays)
+    {
+      slots_[slot] = slots_[next_slot];
+      slot = next_slot;
+    }
+  }
+  slots_[slot] = no_buffer;
+}
@@ -5,8 +5,11 @@
  *      Author: Tim Nicholls, STFC Application Engineering Group
  */
 
+#include <cstring>
+
 #include "FrameDecoder.h"
 #include "FrameReceiverDefaults.h"
+#include "gettime.h"
 
 using namespace FrameReceiver;
 
@@ -20,7 +23,11 @@ FrameDecoder::FrameDecoder() :
      enable_packet_logging_(FrameReceiver::Defaults::default_enable_packet_logging),
      frame_timeout_ms_(FrameReceiver::Defaults::default_frame_timeout_ms),
      frames_timedout_(0),
-     frames_dropped_(0)
+     frames_dropped_(0),
+     buffer_scrub_(FrameReceiver::Defaults::default_buffer_scrub),
+     buffer_scrub_fill_(FrameReceiver::Defaults::default_buffer_scrub_fill),
+     buffer_scrub_fill_value_(FrameReceiver::Defaults::default_buffer_scrub_fill_value),
+     buffer_helpers_used_(false)
 {
 };
 
@@ -43,6 +50,17 @@ void FrameDecoder::init(OdinData::IpcMessage& config_msg)
        CONFIG_DECODER_ENABLE_PACKET_LOGGING, enable_packet_logging_);
    frame_timeout_ms_ = config_msg.get_param<unsigned int>(
        CONFIG_DECODER_FRAME_TIMEOUT_MS, frame_timeout_ms_);
+   buffer_scrub_ = config_msg.get_param<bool>(CONFIG_DECODER_BUFFER_SCRUB, buffer_scrub_);
+   buffer_scrub_fill_ = config_msg.get_param<bool>(
+       CONFIG_DECODER_BUFFER_SCRUB_FILL, buffer_scrub_fill_);
+   buffer_scrub_fill_value_ = config_msg.get_param<unsigned int>(
+       CONFIG_DECODER_BUFFER_SCRUB_FILL_VALUE, buffer_scrub_fill_value_);
+   if (buffer_scrub_fill_value_ > 0xFF)
+   {
+     std::stringstream ss;
+     ss << "Buffer scrub fill value " << buffer_scrub_fill_value_ << " is not a byte value";
+     throw FrameDecoderException(ss.str());
+   }
 
    // Retrieve the packet logger instance
    packet_logger_ = Logger::getLogger("FR.PacketLogger");
@@ -64,6 +82,10 @@ void FrameDecoder::request_configuration(const std::string param_prefix,
 {
     config_reply.set_param(param_prefix + CONFIG_DECODER_ENABLE_PACKET_LOGGING, enable_packet_logging_);
     config_reply.set_param(param_prefix + CONFIG_DECODER_FRAME_TIMEOUT_MS, frame_timeout_ms_);
+    config_reply.set_param(param_prefix + CONFIG_DECODER_BUFFER_SCRUB, buffer_scrub_);
+    config_reply.set_param(param_prefix + CONFIG_DECODER_BUFFER_SCRUB_FILL, buffer_scrub_fill_);
+    config_reply.set_param(param_prefix + CONFIG_DECODER_BUFFER_SCRUB_FILL_VALUE,
+        buffer_scrub_fill_value_);
 }
 
 /** Request the decoder's supported commands.
@@ -101,13 +123,57 @@ void FrameDecoder::execute(const std::string& command, OdinData::IpcMessage& rep
 //! Register a buffer manager with the decoder.
 //!
 //! This method registers a SharedBufferManager instance with the decoder, to be used when
-//! receiving, decoding and storing incoming data.
+//! receiving, decoding and storing incoming data. The frame buffer table is sized for the
+//! buffers in the manager, so that tracking them does not allocate while receiving frames.
+//!
+//! Any buffer scrubber running on the previous buffer manager is stopped.
 //!
 //! \param[in] buffer_manager - pointer to a SharedBufferManager instance
 //!
 void FrameDecoder::register_buffer_manager(OdinData::SharedBufferManagerPtr buffer_manager)
 {
+    scrubber_.reset();
     buffer_manager_ = buffer_manager;
+    buffer_prepared_.clear();
+    if (buffer_manager_)
+    {
+      frame_buffers_.resize(buffer_manager_->get_num_buffers(), buffer_manager_->get_num_pools());
+      buffer_prepared_.resize(buffer_manager_->get_num_buffers(), false);
+    }
+}
+
+//! Get the pools of frame buffers required for the current operation mode.
+//!
+//! This method returns the sizes of the frame buffers required by the decoder, each with the
+//! share of the shared buffer memory to give to a pool of buffers of that size. The first pool
+//! holds the main frames received, and decoders receiving frames of other sizes, e.g. small
+//! sideband frames alongside images, can override this method to request a pool for each.
+//! Decoders then pop empty buffers from the pool appropriate to each frame. By default a single
+//! pool of buffers of the size returned by get_frame_buffer_size() is required.
+//!
+//! \param[out] pools - vector of the frame buffer pools required
+//!
+void FrameDecoder::get_frame_buffer_pools(std::vector<FrameBufferPool>& pools) const
+{
+  FrameBufferPool pool = {this->get_frame_buffer_size(), 1};
+  pools.assign(1, pool);
+}
+
+//! Prepare a frame header for an empty buffer.
+//!
+//! This method initialises the fields of a frame header that do not depend on the frame received
+//! into the buffer, e.g. packet counters and packet state. When buffer scrubbing is enabled, it
+//! is called once to build a prepared header, which the scrubber copies into each buffer as it is
+//! released, so that the decoder only has to stamp the frame number, and any other per-frame
+//! fields, when it pops a buffer for a new frame. Decoders supporting scrubbing should override
+//! this method and skip the fields it initialises when empty_buffer_prepared() is true for the
+//! buffer popped. By default the header is zeroed.
+//!
+//! \param[out] header_ptr - pointer to a frame header of get_frame_header_size() bytes
+//!
+void FrameDecoder::prepare_frame_header(void* header_ptr) const
+{
+  memset(header_ptr, 0, this->get_frame_header_size());
 }
 
 //! Register a frame ready callback with the decoder.
@@ -123,28 +189,56 @@ void FrameDecoder::register_frame_ready_callback(FrameReadyCallback callback)
       ready_callback_ = callback;
   }
 
-//! Push an buffer onto the empty buffer queue.
+//! Push a buffer onto the empty buffer stack.
 //!
-//! This method is used to add an empty buffer to the tail of the internal empty buffer
-//! queue for subsequent use receiving frame data
+//! This method is used to add an empty buffer to the top of the internal empty buffer
+//! stack of its pool for subsequent use receiving frame data. If buffer scrubbing is enabled,
+//! the buffer is instead submitted to the scrubber and only reaches the stack once prepared.
+//! Until the decoder first uses the buffer helpers, e.g. pop_empty_buffer(), empty buffers are
+//! instead added to the deprecated empty_buffer_queue_, so that decoders still taking buffers
+//! from the queue directly continue to work.
 //!
 //! \param[in] buffer_id - SharedBufferManager buffer ID
 //!
 void FrameDecoder::push_empty_buffer(int buffer_id)
 {
-    empty_buffer_queue_.push(buffer_id);
+    // If buffer scrubbing is enabled, hand the buffer to the scrubber, starting it if necessary,
+    // and queue the buffers it has prepared instead
+    if (buffer_scrub_ && buffer_manager_)
+    {
+      if (!scrubber_)
+      {
+        std::vector<char> header(this->get_frame_header_size());
+        if (!header.empty())
+        {
+          this->prepare_frame_header(&header[0]);
+        }
+        scrubber_.reset(new FrameBufferScrubber(buffer_manager_, header, buffer_scrub_fill_,
+            static_cast<uint8_t>(buffer_scrub_fill_value_)));
+        LOG4CXX_INFO(logger_, "Started buffer scrubber"
+            << (buffer_scrub_fill_ ? " filling payloads" : ""));
+      }
+      if (scrubber_->submit(buffer_id))
+      {
+        this->collect_scrubbed_buffers();
+        return;
+      }
+    }
+
+    this->queue_empty_buffer(buffer_id, this->get_empty_buffer_pool(buffer_id), false);
 }
 
-//! Get the number of empty buffers queued.
+//! Get the number of empty buffers held.
 //!
-//! This method returns the number of buffers currently queued by the decoder in the empty
-//! buffer queue
+//! This method returns the number of buffers currently held by the decoder in the empty
+//! buffer stack
 //!
-//! \return number of empty buffers queued
+//! \return number of empty buffers held
 //!
 const size_t FrameDecoder::get_num_empty_buffers(void) const
 {
-    return empty_buffer_queue_.size();
+    return frame_buffers_.num_empty() + empty_buffer_queue_.size() +
+        (scrubber_ ? scrubber_->get_num_prepared() : 0);
 }
 
 //! Get the number of mapped buffers currently held.
@@ -156,7 +250,25 @@ const size_t FrameDecoder::get_num_empty_buffers(void) const
 //!
 const size_t FrameDecoder::get_num_mapped_buffers(void) const
 {
-    return frame_buffer_map_.size();
+    return frame_buffers_.num_mapped() + frame_buffer_map_.size();
+}
+
+//! Get the number of released buffers awaiting preparation by the scrubber.
+//!
+//! \return - number of buffers submitted to the scrubber and not yet prepared
+//!
+const size_t FrameDecoder::get_num_scrub_backlog(void) const
+{
+    return scrubber_ ? scrubber_->get_backlog() : 0;
+}
+
+//! Get the number of buffers prepared by the scrubber.
+//!
+//! \return - number of buffers prepared since the scrubber was started
+//!
+const uint64_t FrameDecoder::get_num_buffers_scrubbed(void) const
+{
+    return scrubber_ ? scrubber_->get_num_scrubbed() : 0;
 }
 
 //! Get the current frame timeout value.
@@ -198,29 +310,253 @@ const unsigned int FrameDecoder::get_num_frames_dropped(void) const
 //! Drop all buffers currently held by the decoder.
 //!
 //! This method forces the decoder to drop all buffers currently held either in the empty
-//! buffer queue or currently mapped to incoming frames. It is intended to be used at
+//! buffer stack or currently mapped to incoming frames. It is intended to be used at
 //! configuration time where, e.g. the underlying shared buffer manager has been reconfigured
-//! and the current buffer references are thus invalid.
+//! and the current buffer references are thus invalid. Any buffer scrubber is stopped,
+//! discarding the buffers it holds.
 //!
 void FrameDecoder::drop_all_buffers(void)
 {
+  scrubber_.reset();
+
+  if (frame_buffers_.num_empty())
+  {
+    LOG4CXX_INFO(logger_, "Dropping " << frame_buffers_.num_empty()
+        << " buffers from empty buffer stack");
+    frame_buffers_.drop_empty();
+  }
   if (!empty_buffer_queue_.empty())
   {
-    LOG4CXX_INFO(logger_, "Dropping " << empty_buffer_queue_.size() 
+    LOG4CXX_INFO(logger_, "Dropping " << empty_buffer_queue_.size()
         << " buffers from empty buffer queue");
-    EmptyBufferQueue new_queue;
-    std::swap(empty_buffer_queue_, new_queue);
+    EmptyBufferQueue empty_queue;
+    std::swap(empty_buffer_queue_, empty_queue);
   }
 
-  if (!frame_buffer_map_.empty())
+  size_t num_mapped = frame_buffers_.num_mapped() + frame_buffer_map_.size();
+  if (num_mapped)
   {
-    LOG4CXX_WARN(logger_, "Dropping " << frame_buffer_map_.size() <<
+    LOG4CXX_WARN(logger_, "Dropping " << num_mapped <<
                  " unreleased buffers from decoder - possible data loss");
-    FrameBufferMap new_map;
-    std::swap(frame_buffer_map_, new_map);
+    frame_buffers_.drop_mapped();
+    frame_buffer_map_.clear();
   }
 }
 
+//! Pop a buffer from the empty buffer stack of a pool.
+//!
+//! This method is used by derived decoder classes to obtain an empty buffer to receive a new
+//! frame into. The buffer is marked as receiving in the shared buffer state table, if present.
+//!
+//! \param[out] buffer_id - SharedBufferManager buffer ID popped
+//! \param[in] pool - pool of buffers to pop from, matching the size of the frame
+//! \return true if a buffer was popped, false if no empty buffers are available
+//!
+bool FrameDecoder::pop_empty_buffer(int& buffer_id, unsigned int pool)
+{
+    this->use_buffer_helpers();
+    this->collect_scrubbed_buffers();
+    if (!frame_buffers_.pop_empty(buffer_id, pool))
+    {
+      return false;
+    }
+    if (buffer_manager_ && buffer_manager_->get_buffer_states())
+    {
+      buffer_manager_->get_buffer_states()->set_receiving(buffer_id);
+    }
+    return true;
+}
+
+//! Get the empty buffer that will next be popped from the stack.
+//!
+//! This method allows derived decoder classes to predict which buffer the next new frame will
+//! be received into, without removing it from the empty buffer stack.
+//!
+//! \param[in] pool - pool of buffers
+//! \return SharedBufferManager buffer ID, or -1 if no empty buffers are available
+//!
+int FrameDecoder::next_empty_buffer(unsigned int pool) const
+{
+    // Until the buffers are moved onto the stacks, the next buffer popped is the one queued
+    // last on the deprecated queue, if it belongs to the pool
+    if (!buffer_helpers_used_)
+    {
+      if (empty_buffer_queue_.empty() ||
+          (this->get_empty_buffer_pool(empty_buffer_queue_.back()) != pool))
+      {
+        return -1;
+      }
+      return empty_buffer_queue_.back();
+    }
+    return frame_buffers_.next_empty(pool);
+}
+
+//! Check if an empty buffer has been prepared by the buffer scrubber.
+//!
+//! Derived decoder classes use this to skip initialising the parts of a frame header that
+//! prepare_frame_header() has already written when popping an empty buffer. Buffers pushed
+//! while scrubbing is disabled, or that the scrubber could not accept, are not prepared.
+//!
+//! \param[in] buffer_id - SharedBufferManager buffer ID popped
+//! \return true if the buffer was prepared by the scrubber before it was last pushed
+//!
+bool FrameDecoder::empty_buffer_prepared(int buffer_id) const
+{
+    return (buffer_id >= 0) && (static_cast<size_t>(buffer_id) < buffer_prepared_.size()) &&
+        buffer_prepared_[buffer_id];
+}
+
+//! Map a buffer to an incoming frame.
+//!
+//! This method is used by derived decoder classes to record that a buffer is receiving data for
+//! a frame. The current time is recorded so that the frame can be timed out if it is not
+//! completed within the frame timeout.
+//!
+//! \param[in] frame - frame number
+//! \param[in] buffer_id - SharedBufferManager buffer ID
+//! \return true if the buffer was mapped, false if the frame or buffer is already mapped
+//!
+bool FrameDecoder::map_frame_buffer(int frame, int buffer_id)
+{
+    this->use_buffer_helpers();
+    return frame_buffers_.map(frame, buffer_id, get_monotonic_time_ns());
+}
+
+//! Get the buffer mapped to an incoming frame.
+//!
+//! \param[in] frame - frame number
+//! \return SharedBufferManager buffer ID, or -1 if the frame is not mapped
+//!
+int FrameDecoder::get_frame_buffer(int frame) const
+{
+    return frame_buffers_.lookup(frame);
+}
+
+//! Unmap the buffer mapped to an incoming frame.
+//!
+//! This method is used by derived decoder classes once a frame is complete and has been handed
+//! off for processing.
+//!
+//! \param[in] frame - frame number
+//! \return true if the frame was unmapped, false if the frame is not mapped
+//!
+bool FrameDecoder::unmap_frame_buffer(int frame)
+{
+    return frame_buffers_.unmap(frame);
+}
+
+//! Unmap the oldest incoming frame if it has timed out.
+//!
+//! This method is used by derived decoder classes when monitoring buffers, calling it repeatedly
+//! until it returns false to find each frame that has been mapped for longer than the frame
+//! timeout. The frames that have not timed out are not visited.
+//!
+//! \param[in] now_ns - current monotonic time in nanoseconds
+//! \param[out] frame - frame number of the timed out frame
+//! \param[out] buffer_id - SharedBufferManager buffer ID of the timed out frame
+//! \return true if a timed out frame was unmapped, false if no frames have timed out
+//!
+bool FrameDecoder::pop_timedout_frame(uint64_t now_ns, int& frame, int& buffer_id)
+{
+    uint64_t timeout_ns = static_cast<uint64_t>(frame_timeout_ms_) * 1000000;
+    if (now_ns < timeout_ns)
+    {
+      return false;
+    }
+    return frame_buffers_.pop_expired(now_ns - timeout_ns, frame, buffer_id);
+}
+
+//! Get the current monotonic time.
+//!
+//! \return current monotonic time in nanoseconds
+//!
+uint64_t FrameDecoder::get_monotonic_time_ns(void)
+{
+    struct timespec now;
+    gettime(&now, true);
+    return (static_cast<uint64_t>(now.tv_sec) * 1000000000) + now.tv_nsec;
+}
+
+//! Collect buffers prepared by the buffer scrubber.
+//!
+//! This method queues the buffers the scrubber has finished preparing onto the empty buffer
+//! stacks of their pools, ready for use receiving frames.
+//!
+void FrameDecoder::collect_scrubbed_buffers(void)
+{
+    if (!scrubber_)
+    {
+      return;
+    }
+    int buffer_id;
+    while (scrubber_->collect(buffer_id))
+    {
+      this->queue_empty_buffer(buffer_id, buffer_manager_->get_buffer_pool(buffer_id), true);
+    }
+}
+
+//! Switch the decoder to tracking buffers with the buffer helpers.
+//!
+//! This method is called on the first use of the buffer helpers, moving any empty buffers
+//! queued on the deprecated empty_buffer_queue_ onto the empty buffer stacks of their pools.
+//! They are pushed in the order they were queued, so the most recently queued is popped first.
+//!
+void FrameDecoder::use_buffer_helpers(void)
+{
+    if (buffer_helpers_used_)
+    {
+      return;
+    }
+    buffer_helpers_used_ = true;
+    while (!empty_buffer_queue_.empty())
+    {
+      int buffer_id = empty_buffer_queue_.front();
+      empty_buffer_queue_.pop();
+      frame_buffers_.push_empty(buffer_id, this->get_empty_buffer_pool(buffer_id));
+    }
+}
+
+//! Get the pool an empty buffer belongs to.
+//!
+//! \param[in] buffer_id - SharedBufferManager buffer ID
+//! \return pool of the buffer, zero if there is no buffer manager or the ID is out of range
+//!
+unsigned int FrameDecoder::get_empty_buffer_pool(int buffer_id) const
+{
+    if (buffer_manager_ && (buffer_id >= 0) &&
+        (static_cast<size_t>(buffer_id) < buffer_manager_->get_num_buffers()))
+    {
+      return buffer_manager_->get_buffer_pool(buffer_id);
+    }
+    return 0;
+}
+
+//! Queue an empty buffer for use receiving frame data.
+//!
+//! The buffer is pushed onto the empty buffer stack of its pool, or onto the deprecated
+//! empty_buffer_queue_ if the decoder has not used the buffer helpers, recording whether it
+//! has been prepared by the scrubber.
+//!
+//! \param[in] buffer_id - SharedBufferManager buffer ID
+//! \param[in] pool - pool the buffer belongs to
+//! \param[in] prepared - true if the buffer has been prepared by the scrubber
+//!
+void FrameDecoder::queue_empty_buffer(int buffer_id, unsigned int pool, bool prepared)
+{
+    if ((buffer_id >= 0) && (static_cast<size_t>(buffer_id) < buffer_prepared_.size()))
+    {
+      buffer_prepared_[buffer_id] = prepared;
+    }
+    if (buffer_helpers_used_)
+    {
+      frame_buffers_.push_empty(buffer_id, pool);
+    }
+    else
+    {
+      empty_buffer_queue_.push(buffer_id);
+    }
+}
+
 //! Collate version information for the decoder.
 //!
 //! The version information is added to the status IpcMessage object.
@@ -0,0 +1,300 @@
+/*
+ * FrameDecoderUDP.cpp - abstract base class for UDP frameReceiver decoder plugins
+ *
+ *  Created on: April 20, 2017
+ *      Author: Alan Greer
+ */
+
+#include <string.h>
+#include <algorithm>
+
+#include "FrameDecoderUDP.h"
+
+using namespace FrameReceiver;
+
+//! Get the receive slots for the next batch of packets.
+//!
+//! This method is called by the RX thread when receiving packets in batched mode, to obtain
+//! the locations that each of the next packets should be received into. The payload of each
+//! packet is received directly into the frame buffer location returned by
+//! predict_payload_buffer() where the decoder can predict it, and otherwise into a spill area
+//! from which process_packets() copies it once its header has been seen. The payload of the
+//! first packet for decoders not requiring header inspection is always received in place.
+//! Headers are received into a small staging area and copied into the packet header buffer.
+//!
+//! \param[in] num_slots - maximum number of slots requested by the RX thread
+//! \param[out] slots - array of at least num_slots receive slots to populate
+//! \return number of slots populated
+//!
+unsigned int FrameDecoderUDP::get_next_payload_slots(unsigned int num_slots, PacketReceiveSlot* slots)
+{
+  size_t header_size = requires_header_peek() ? get_packet_header_size() : 0;
+  size_t payload_size = get_next_payload_size();
+
+  if (batch_header_buffer_.size() < (num_slots * header_size))
+  {
+    batch_header_buffer_.resize(num_slots * header_size);
+  }
+  if (batch_spill_buffer_.size() < (num_slots * payload_size))
+  {
+    batch_spill_buffer_.resize(num_slots * payload_size);
+    batch_move_buffer_.resize(num_slots * payload_size);
+  }
+
+  for (unsigned int slot = 0; slot < num_slots; slot++)
+  {
+    void* payload_buffer = NULL;
+    if ((slot == 0) && !header_size)
+    {
+      payload_buffer = get_next_payload_buffer();
+    }
+    else
+    {
+      payload_buffer = predict_payload_buffer(slot);
+    }
+    if (!payload_buffer)
+    {
+      payload_buffer = &batch_spill_buffer_[slot * payload_size];
+    }
+    slots[slot].header_buffer = header_size ? &batch_header_buffer_[slot * header_size] : NULL;
+    slots[slot].header_size = header_size;
+    slots[slot].payload_buffer = payload_buffer;
+    slots[slot].payload_size = payload_size;
+    slots[slot].bytes_received = 0;
+  }
+
+  return num_slots;
+}
+
+//! Process a batch of received packets.
+//!
+//! This method is called by the RX thread once a batch of packets has been received into the
+//! slots returned by get_next_payload_slots(). This default implementation processes each packet
+//! in turn through the single-packet decoder interface, copying the header into the packet header
+//! buffer and processing it if the decoder requires header inspection. A payload received
+//! anywhere other than the buffer returned by get_next_payload_buffer() is then relocated there,
+//! first moving aside the payload of any later packet in the batch it would overwrite, before
+//! process_packet() is called. The RX thread may discard slots, e.g. truncated packets, passing
+//! on the remaining slots in order.
+//!
+//! \param[in] num_packets - number of packets received
+//! \param[in] slots - array of receive slots populated by the RX thread
+//! \param[in] port - port the packets were received on
+//!
+void FrameDecoderUDP::process_packets(unsigned int num_packets, PacketReceiveSlot* slots, int port)
+{
+  for (unsigned int pkt = 0; pkt < num_packets; pkt++)
+  {
+    PacketReceiveSlot& slot = slots[pkt];
+    size_t header_bytes = 0;
+
+    if (slot.header_buffer)
+    {
+      header_bytes = std::min(slot.bytes_received, slot.header_size);
+      memcpy(get_packet_header_buffer(), slot.header_buffer, header_bytes);
+      process_packet_header(header_bytes, port, &slot.from_addr);
+    }
+
+    uint8_t* payload_buffer = reinterpret_cast<uint8_t*>(get_next_payload_buffer());
+    if (payload_buffer != slot.payload_buffer)
+    {
+      size_t payload_bytes = std::min(slot.bytes_received - header_bytes, get_next_payload_size());
+      for (unsigned int later = pkt + 1; later < num_packets; later++)
+      {
+        PacketReceiveSlot& later_slot = slots[later];
+        uint8_t* later_payload = reinterpret_cast<uint8_t*>(later_slot.payload_buffer);
+        size_t later_bytes = later_slot.bytes_received -
+            std::min(later_slot.bytes_received, later_slot.header_size);
+        if ((later_payload < payload_buffer + payload_bytes) &&
+            (payload_buffer < later_payload + later_bytes))
+        {
+          uint8_t* moved = &batch_move_buffer_[later * later_slot.payload_size];
+          memcpy(moved, later_payload, later_bytes);
+          later_slot.payload_buffer = moved;
+        }
+      }
+      memmove(payload_buffer, slot.payload_buffer, payload_bytes);
+      if (!is_spill_buffer(slot.payload_buffer))
+      {
+        packets_relocated_++;
+      }
+    }
+
+    process_packet(slot.bytes_received, port, &slot.from_addr);
+  }
+}
+
+//! Process a run of consecutive packets received into a single buffer.
+//!
+//! This method is called by the RX thread when packets have been received outside the frame
+//! buffers, e.g. coalesced by UDP generic receive offload or taken from a kernel receive ring. The
+//! buffer holds one or more packets back to back, each of packet_size bytes apart from the last,
+//! which may be shorter. This default implementation copies each packet in turn through the
+//! single-packet decoder interface, processing the header first if the decoder requires header
+//! inspection. Decoders can override this method to place a run of packets belonging to the same
+//! frame with fewer, larger copies.
+//!
+//! \param[in] buffer - buffer containing the packets
+//! \param[in] bytes_received - total number of bytes in the buffer
+//! \param[in] packet_size - size of each packet in the buffer
+//! \param[in] port - port the packets were received on
+//! \param[in] from_addr - socket address structure indicating source address of packet sender
+//! \return number of packets processed
+//!
+unsigned int FrameDecoderUDP::process_packet_run(const uint8_t* buffer, size_t bytes_received,
+    size_t packet_size, int port, struct sockaddr_in* from_addr)
+{
+  unsigned int num_packets = 0;
+
+  for (size_t offset = 0; offset < bytes_received; offset += packet_size)
+  {
+    const uint8_t* packet = buffer + offset;
+    size_t packet_len = std::min(packet_size, bytes_received - offset);
+    size_t header_bytes = 0;
+
+    if (requires_header_peek())
+    {
+      header_bytes = std::min(packet_len, get_packet_header_size());
+      memcpy(get_packet_header_buffer(), packet, header_bytes);
+      process_packet_header(header_bytes, port, from_addr);
+    }
+
+    size_t payload_bytes = std::min(packet_len - header_bytes, get_next_payload_size());
+    memcpy(get_next_payload_buffer(), packet + header_bytes, payload_bytes);
+
+    process_packet(header_bytes + payload_bytes, port, from_addr);
+    num_packets++;
+  }
+
+  return num_packets;
+}
+
+//! Get the location of the frame number field in packet headers.
+//!
+//! This method is called by the RX thread when packets are steered to multiple RX threads by
+//! frame number, to determine where the frame number is found in each packet. Decoders
+//! supporting frame steering should override this method to describe the field. This default
+//! implementation returns false, indicating that frame steering is not supported.
+//!
+//! \param[out] field - description of the frame number field
+//! \return true if the decoder populated the field description, false otherwise
+//!
+bool FrameDecoderUDP::get_frame_number_field(FrameNumberField& field) const
+{
+  return false;
+}
+
+//! Get the predicted payload buffer for the next packet.
+//!
+//! This method is called by the RX thread, for decoders requiring header inspection, to obtain a
+//! location to receive the next packet payload into without first peeking at the packet header.
+//! This allows the header and payload to be received in a single call. The prediction is made by
+//! the predict_next_payload_buffer() method, which decoders can override, and is stored for use
+//! when the packet is processed by process_predicted_packet().
+//!
+//! \return pointer to the predicted payload buffer, or NULL if the decoder cannot predict
+//!
+void* FrameDecoderUDP::get_predicted_payload_buffer(void)
+{
+  predicted_payload_buffer_ = predict_next_payload_buffer();
+  return predicted_payload_buffer_;
+}
+
+//! Process a packet received into the predicted payload buffer.
+//!
+//! This method processes a packet whose header was received into the packet header buffer and
+//! whose payload was received speculatively into the buffer returned by
+//! get_predicted_payload_buffer(). The header is processed first, which determines where the
+//! payload should actually have been received. If this differs from the prediction, the payload is
+//! relocated to the correct location and the relocation counter incremented, before the packet
+//! is processed as normal.
+//!
+//! \param[in] bytes_received - total number of header and payload bytes received
+//! \param[in] port - port the packet was received on
+//! \param[in] from_addr - socket address structure indicating source address of packet sender
+//! \return current frame receive state
+//!
+FrameDecoder::FrameReceiveState FrameDecoderUDP::process_predicted_packet(
+    size_t bytes_received, int port, struct sockaddr_in* from_addr)
+{
+  size_t header_bytes = std::min(bytes_received, get_packet_header_size());
+  process_packet_header(header_bytes, port, from_addr);
+
+  void* payload_buffer = get_next_payload_buffer();
+  if (payload_buffer != predicted_payload_buffer_)
+  {
+    size_t payload_bytes = std::min(bytes_received - header_bytes, get_next_payload_size());
+    memmove(payload_buffer, predicted_payload_buffer_, payload_bytes);
+    packets_relocated_++;
+  }
+
+  return process_packet(bytes_received, port, from_addr);
+}
+
+//! Get the number of packets relocated.
+//!
+//! This method returns the number of packets received into a predicted payload buffer that then
+//! had to be relocated because the prediction was wrong.
+//!
+//! \return number of packets relocated
+//!
+const unsigned int FrameDecoderUDP::get_num_packets_relocated(void) const
+{
+  return packets_relocated_;
+}
+
+//! Reset UDP frame decoder statistics.
+//!
+//! This method resets the UDP frame decoder statistics, clearing the relocated packet count
+//! in addition to the base class statistics.
+//!
+void FrameDecoderUDP::reset_statistics(void)
+{
+  FrameDecoder::reset_statistics();
+  packets_relocated_ = 0;
+}
+
+//! Predict the payload buffer for a packet in a batch.
+//!
+//! This method is called when receiving a batch of packets to predict where the payload of each
+//! should be received, before any of their headers have been seen. Decoders that can predict the
+//! destination of a run of packets, e.g. the following packets of the current frame, should
+//! override this method, returning a location that is always safe to receive into and distinct
+//! for each packet, or NULL where no prediction can be made. This default implementation
+//! makes no predictions, so that the payloads are received into the spill area.
+//!
+//! \param[in] packets_ahead - position of the packet in the batch, zero for the next packet
+//! \return pointer to the predicted payload buffer, or NULL if no prediction can be made
+//!
+void* FrameDecoderUDP::predict_payload_buffer(unsigned int packets_ahead)
+{
+  return NULL;
+}
+
+//! Check if a buffer is in the spill area for batched receive.
+//!
+//! \param[in] buffer - buffer to check
+//! \return true if the buffer lies in the spill area
+//!
+bool FrameDecoderUDP::is_spill_buffer(const void* buffer) const
+{
+  const uint8_t* address = reinterpret_cast<const uint8_t*>(buffer);
+  return !batch_spill_buffer_.empty() && (address >= &batch_spill_buffer_[0]) &&
+      (address < &batch_spill_buffer_[0] + batch_spill_buffer_.size());
+}
+
+//! Predict the payload buffer for the next packet.
+//!
+//! This method is called to predict where the payload of the next packet should be received,
+//! before its header has been seen. Decoders that can predict the destination of a packet, e.g.
+//! the next packet of the current frame, should override this method, returning a location that
+//! is always safe to receive into, since a mispredicted payload will be relocated after the
+//! fact. This default implementation returns NULL, indicating that no prediction can be made and
+//! the packet header must be peeked before receiving the payload.
+//!
+//! \return pointer to the predicted payload buffer, or NULL if no prediction can be made
+//!
+void* FrameDecoderUDP::predict_next_payload_buffer(void)
+{
+  return NULL;
+}
@@ -5,6 +5,9 @@
  *      Author: Tim Nicholls, STFC Application Engineering Group
  */
 
+#include <unistd.h>
+#include <algorithm>
+
 #include "FrameReceiverController.h"
 #include "version.h"
 
@@ -34,6 +37,7 @@ FrameReceiverController::FrameReceiverController(unsigned int num_io_threads) :
     buffer_manager_configured_(false),
     rx_thread_configured_(false),
     configuration_complete_(false),
+    frame_release_registered_(false),
     ipc_context_(IpcContext::Instance(num_io_threads)),
     rx_channel_(ZMQ_ROUTER),
     ctrl_channel_(ZMQ_ROUTER),
@@ -41,10 +45,16 @@ FrameReceiverController::FrameReceiverController(unsigned int num_io_threads) :
     frame_release_channel_(ZMQ_SUB),
     frames_received_(0),
     frames_released_(0),
-    rx_thread_identity_(RX_THREAD_ID)
+    frames_notified_(0),
+    notify_latency_total_ns_(0),
+    notify_latency_max_ns_(0),
+    rx_thread_identities_(1, RX_THREAD_ID)
 {
   LOG4CXX_TRACE(logger_, "FrameRecevierController constructor");
 
+  // Register the main thread for placement
+  main_thread_name_ = ThreadPlacement::Instance().register_thread("main");
+
 }
 
 //! Destructor for the FrameReceiverController.
@@ -52,9 +62,11 @@ FrameReceiverController::FrameReceiverController(unsigned int num_io_threads) :
 FrameReceiverController::~FrameReceiverController ()
 {
 
-  // Delete the RX thread object by resetting the scoped pointer, allowing the IPC channel
+  // Delete the RX thread objects by clearing the thread list, allowing the IPC channel
   // to be closed cleanly
-  rx_thread_.reset();
+  rx_threads_.clear();
+
+  ThreadPlacement::Instance().unregister_thread(main_thread_name_);
 
 }
 
@@ -89,6 +101,10 @@ void FrameReceiverController::configure(OdinData::IpcMessage& config_msg,
       config_.frame_count_ = frame_count;
     }
 
+    // Configure thread placement before any threads are started, so that they are placed
+    // as they start
+    this->configure_thread_placement(config_msg);
+
     // Configure IPC channels
     this->configure_ipc_channels(config_msg);
 
@@ -101,6 +117,9 @@ void FrameReceiverController::configure(OdinData::IpcMessage& config_msg,
     // Configure the RX thread
     this->configure_rx_thread(config_msg);
 
+    // Register any ZeroMQ IO threads created for the IPC channels for placement
+    ThreadPlacement::Instance().register_zmq_io_threads();
+
     // Update the global configuration status from that of the individual components
     configuration_complete_ = ipc_configured_ & decoder_configured_ &
       buffer_manager_configured_ & rx_thread_configured_;
@@ -231,32 +250,104 @@ void FrameReceiverController::configure_ipc_channels(OdinData::IpcMessage& confi
     }
   }
 
-  // If a new endpoint is specified, bind the frame ready notification channel
+  // The frame ready and release channels can be owned directly by the RX thread, rather than
+  // notifications being relayed through the controller. Only one channel can bind each endpoint,
+  // so this is only supported with a single RX thread. The endpoints are handed over between the
+  // controller and the RX thread when the mode changes.
+  bool frame_notify_direct = config_msg.get_param<bool>(
+      CONFIG_FRAME_NOTIFY_DIRECT, config_.frame_notify_direct_);
+  if (frame_notify_direct &&
+      (config_msg.get_param<unsigned int>(CONFIG_RX_THREADS, config_.rx_threads_) > 1))
+  {
+    throw FrameReceiverException(
+        "Direct frame notification is only supported with a single RX thread");
+  }
+  if (frame_notify_direct != config_.frame_notify_direct_)
+  {
+    if (frame_notify_direct)
+    {
+      this->unbind_channel(&frame_ready_channel_, config_.frame_ready_endpoint_, false);
+      this->unbind_channel(&frame_release_channel_, config_.frame_release_endpoint_, false);
+      this->remove_frame_release_channel();
+    }
+    else
+    {
+      this->stop_rx_thread();
+      if (!config_.frame_ready_endpoint_.empty())
+      {
+        this->setup_frame_ready_channel(config_.frame_ready_endpoint_);
+      }
+      if (!config_.frame_release_endpoint_.empty())
+      {
+        this->setup_frame_release_channel(config_.frame_release_endpoint_);
+      }
+    }
+    config_.frame_notify_direct_ = frame_notify_direct;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  // If a new endpoint is specified, bind the frame ready notification channel, or have the RX
+  // thread bind it if notifying directly
   if (config_msg.has_param(CONFIG_FRAME_READY_ENDPOINT)) {
     std::string frame_ready_endpoint =
       config_msg.get_param<std::string>(CONFIG_FRAME_READY_ENDPOINT);
     if (frame_ready_endpoint != config_.frame_ready_endpoint_)
     {
       this->unbind_channel(&frame_ready_channel_, config_.frame_ready_endpoint_, false);
-      this->setup_frame_ready_channel(frame_ready_endpoint);
+      if (config_.frame_notify_direct_)
+      {
+        need_rx_thread_reconfig_ = true;
+      }
+      else
+      {
+        this->setup_frame_ready_channel(frame_ready_endpoint);
+      }
       config_.frame_ready_endpoint_ = frame_ready_endpoint;
       ready_channel_configured = true;
     }
   }
 
-  // If a new endpoint is specified, bind the frame release notification channel
+  // If a new endpoint is specified, bind the frame release notification channel, or have the RX
+  // thread bind it if notifying directly
   if (config_msg.has_param(CONFIG_FRAME_RELEASE_ENDPOINT)) {
     std::string frame_release_endpoint =
       config_msg.get_param<std::string>(CONFIG_FRAME_RELEASE_ENDPOINT);
     if (frame_release_endpoint != config_.frame_release_endpoint_)
     {
       this->unbind_channel(&frame_release_channel_, config_.frame_release_endpoint_, false);
-      this->setup_frame_release_channel(frame_release_endpoint);
+      if (config_.frame_notify_direct_)
+      {
+        need_rx_thread_reconfig_ = true;
+      }
+      else
+      {
+        this->setup_frame_release_channel(frame_release_endpoint);
+      }
       config_.frame_release_endpoint_ = frame_release_endpoint;
       release_channel_configured = true;
     }
   }
 
+  // Frame ready notifications are sent either as JSON messages or, if the frame processor supports
+  // them, as compact binary notifications. The RX threads generate these, so must be reconfigured
+  // if the format changes
+  std::string frame_notify_format_str = config_msg.get_param<std::string>(
+      CONFIG_FRAME_NOTIFY_FORMAT,
+      FrameReceiverConfig::map_frame_notify_format_type_to_name(config_.frame_notify_format_));
+  Defaults::FrameNotifyFormat frame_notify_format =
+      FrameReceiverConfig::map_frame_notify_format_name_to_type(frame_notify_format_str);
+  if (frame_notify_format == Defaults::FrameNotifyFormatIllegal)
+  {
+    std::stringstream sstr;
+    sstr << "Illegal frame notification format specified: " << frame_notify_format_str;
+    throw FrameReceiverException(sstr.str());
+  }
+  if (frame_notify_format != config_.frame_notify_format_)
+  {
+    config_.frame_notify_format_ = frame_notify_format;
+    need_rx_thread_reconfig_ = true;
+  }
+
   // Flag successful completion of IPC channel configuration if all channels configured
   ipc_configured_ = (
     ctrl_channel_configured && rx_channel_configured &&
@@ -347,7 +438,7 @@ void FrameReceiverController::setup_frame_ready_channel(const std::string& endpo
 //! Set up the frame release notification channel.
 //!
 //! This method sets up the frame release notification, binding to the specified endpoint and adding
-//! the channel to the reactor.
+//! the channel to the reactor if it is not already registered.
 //!
 //! \param[in] control_endpoint - string URI of endpoint
 //!
@@ -370,9 +461,27 @@ void FrameReceiverController::setup_frame_release_channel(const std::string& end
   frame_release_channel_.subscribe("");
 
   // Add channel to the reactor
-  reactor_.register_channel(frame_release_channel_,
-            boost::bind(&FrameReceiverController::handle_frame_release_channel, this));
+  if (!frame_release_registered_)
+  {
+    reactor_.register_channel(frame_release_channel_,
+              boost::bind(&FrameReceiverController::handle_frame_release_channel, this));
+    frame_release_registered_ = true;
+  }
+
+}
 
+//! Remove the frame release notification channel from the reactor.
+//!
+//! This method removes the frame release notification channel from the reactor if it is
+//! registered, e.g. when the RX thread takes over receiving frame release notifications.
+//!
+void FrameReceiverController::remove_frame_release_channel(void)
+{
+  if (frame_release_registered_)
+  {
+    reactor_.remove_channel(frame_release_channel_);
+    frame_release_registered_ = false;
+  }
 }
 
 //! Unbind an IpcChannel from an endpoint.
@@ -418,7 +527,7 @@ void FrameReceiverController::cleanup_ipc_channels(void)
   // Remove IPC channels from the reactor
   reactor_.remove_channel(ctrl_channel_);
   reactor_.remove_channel(rx_channel_);
-  reactor_.remove_channel(frame_release_channel_);
+  this->remove_frame_release_channel();
 
   // Close all channels
   ctrl_channel_.close();
@@ -451,12 +560,6 @@ void FrameReceiverController::configure_frame_decoder(OdinData::IpcMessage& conf
     need_decoder_reconfig_ = true;
   }
 
-  // Check if the last character is '/', if not append it
-  if (*decoder_path.rbegin() != '/')
-  {
-    decoder_path += "/";
-  }
-
   // Resolve the decoder type if specified in the config message
   std::string decoder_type = config_msg.get_param<std::string>(
       CONFIG_DECODER_TYPE, config_.decoder_type_);
@@ -500,46 +603,14 @@ void FrameReceiverController::configure_frame_decoder(OdinData::IpcMessage& conf
 
     if (decoder_type != Defaults::default_decoder_type)
     {
-      std::string lib_name = "lib" + decoder_type + "FrameDecoder" + SHARED_LIBRARY_SUFFIX;
-      std::string cls_name = decoder_type + "FrameDecoder";
-      LOG4CXX_INFO(logger_, "Loading decoder plugin " << cls_name << " from "
-          << decoder_path << lib_name);
-
-      try {
-
-        // The RX thread must be stopped and deleted first so that it releases its reference to the
-        // current frame decoder (and shared buffer manager), allowing the current decoder instance
-        // to be destroyed before reconfiguration.
-        this->stop_rx_thread();
-
-        frame_decoder_.reset();
-        frame_decoder_ = OdinData::ClassLoader<FrameDecoder>::load_class(
-            cls_name, decoder_path + lib_name);
-        if (!frame_decoder_)
-        {
-          throw FrameReceiverException(
-              "Cannot configure frame decoder: plugin type not recognised");
-        }
-        else
-        {
-          LOG4CXX_INFO(logger_, "Created " << cls_name << " frame decoder instance");
-        }
-      }
-      catch (const std::runtime_error& e) {
-        std::stringstream sstr;
-        sstr << "Cannot configure frame decoder: " << e.what();
-        throw FrameReceiverException(sstr.str());
-      }
 
-      // Initialise the decoder object
-      try {
-        frame_decoder_->init(logger_, *(config_.decoder_config_));
-      }
-      catch (const std::exception& e){
-        std::stringstream sstr;
-        sstr << "Error initialising frame decoder: " << e.what();
-        throw FrameReceiverException(sstr.str());
-      }
+      // The RX thread must be stopped and deleted first so that it releases its reference to the
+      // current frame decoder (and shared buffer manager), allowing the current decoder instance
+      // to be destroyed before reconfiguration.
+      this->stop_rx_thread();
+
+      frame_decoder_.reset();
+      frame_decoder_ = this->load_frame_decoder();
 
       // The buffer manager and RX thread will need reconfiguration if the decoder has been loaded
       // and initialised.
@@ -556,6 +627,61 @@ void FrameReceiverController::configure_frame_decoder(OdinData::IpcMessage& conf
   }
 }
 
+//! Load and initialise a frame decoder instance.
+//!
+//! This method resolves and loads the frame decoder class specified by the current decoder path
+//! and type configuration, initialising the new instance with the current decoder configuration.
+//! A new instance is returned on each call, allowing a decoder to be created for each RX thread.
+//!
+//! \return shared pointer to the new frame decoder instance
+//!
+FrameDecoderPtr FrameReceiverController::load_frame_decoder(void)
+{
+  // Check if the last character of the decoder path is '/', if not append it
+  std::string decoder_path = config_.decoder_path_;
+  if (*decoder_path.rbegin() != '/')
+  {
+    decoder_path += "/";
+  }
+
+  std::string lib_name = "lib" + config_.decoder_type_ + "FrameDecoder" + SHARED_LIBRARY_SUFFIX;
+  std::string cls_name = config_.decoder_type_ + "FrameDecoder";
+  LOG4CXX_INFO(logger_, "Loading decoder plugin " << cls_name << " from "
+      << decoder_path << lib_name);
+
+  FrameDecoderPtr frame_decoder;
+  try {
+    frame_decoder = OdinData::ClassLoader<FrameDecoder>::load_class(
+        cls_name, decoder_path + lib_name);
+    if (!frame_decoder)
+    {
+      throw FrameReceiverException(
+          "Cannot configure frame decoder: plugin type not recognised");
+    }
+    else
+    {
+      LOG4CXX_INFO(logger_, "Created " << cls_name << " frame decoder instance");
+    }
+  }
+  catch (const std::runtime_error& e) {
+    std::stringstream sstr;
+    sstr << "Cannot configure frame decoder: " << e.what();
+    throw FrameReceiverException(sstr.str());
+  }
+
+  // Initialise the decoder object
+  try {
+    frame_decoder->init(logger_, *(config_.decoder_config_));
+  }
+  catch (const std::exception& e){
+    std::stringstream sstr;
+    sstr << "Error initialising frame decoder: " << e.what();
+    throw FrameReceiverException(sstr.str());
+  }
+
+  return frame_decoder;
+}
+
 //! Check if configuration message defines a new decoder class.
 //!
 //! \param[in] config_msg - IPC message containing configuration parameters
@@ -610,6 +736,75 @@ void FrameReceiverController::configure_buffer_manager(OdinData::IpcMessage& con
     need_buffer_manager_reconfig_ = true;
   }
 
+  // The memory backing the shared buffer is placed when it is created, so any change to the page
+  // size, prefaulting, locking or NUMA binding requires it to be recreated
+  std::size_t huge_page_size = config_msg.get_param<std::size_t>(
+      CONFIG_SHARED_BUFFER_HUGE_PAGE_SIZE, config_.shared_buffer_huge_page_size_);
+  if (huge_page_size & (huge_page_size - 1))
+  {
+    std::stringstream sstr;
+    sstr << "Illegal shared buffer huge page size specified: " << huge_page_size;
+    throw FrameReceiverException(sstr.str());
+  }
+  bool prefault = config_msg.get_param<bool>(CONFIG_SHARED_BUFFER_PREFAULT, config_.shared_buffer_prefault_);
+  bool lock = config_msg.get_param<bool>(CONFIG_SHARED_BUFFER_LOCK, config_.shared_buffer_lock_);
+  int numa_node = config_msg.get_param<int>(CONFIG_SHARED_BUFFER_NUMA_NODE, config_.shared_buffer_numa_node_);
+#ifndef __linux__
+  if (huge_page_size || (numa_node >= 0))
+  {
+    throw FrameReceiverException("Huge pages and NUMA binding of the shared buffer are only supported on Linux");
+  }
+#endif
+  if ((huge_page_size != config_.shared_buffer_huge_page_size_) ||
+      (prefault != config_.shared_buffer_prefault_) || (lock != config_.shared_buffer_lock_) ||
+      (numa_node != config_.shared_buffer_numa_node_))
+  {
+    config_.shared_buffer_huge_page_size_ = huge_page_size;
+    config_.shared_buffer_prefault_ = prefault;
+    config_.shared_buffer_lock_ = lock;
+    config_.shared_buffer_numa_node_ = numa_node;
+    need_buffer_manager_reconfig_ = true;
+  }
+
+  // The buffer lease timeout and reclaiming of buffers held by exited processes are applied by
+  // the RX threads as they monitor buffers, so take effect without reconfiguring the buffer
+  // manager
+  config_.buffer_lease_timeout_ms_ = config_msg.get_param<unsigned int>(
+      CONFIG_BUFFER_LEASE_TIMEOUT_MS, config_.buffer_lease_timeout_ms_);
+  config_.buffer_reclaim_exited_ = config_msg.get_param<bool>(
+      CONFIG_BUFFER_RECLAIM_EXITED, config_.buffer_reclaim_exited_);
+
+  // Frame notifications can be passed to the frame processor through rings hosted in the shared
+  // buffer, rather than over the ready and release channels. The buffer manager hosts a ring pair
+  // for each RX thread, so must be recreated if the transport or number of RX threads changes.
+  std::string frame_notify_transport_str = config_msg.get_param<std::string>(
+      CONFIG_FRAME_NOTIFY_TRANSPORT,
+      FrameReceiverConfig::map_frame_notify_transport_type_to_name(config_.frame_notify_transport_));
+  Defaults::FrameNotifyTransport frame_notify_transport =
+      FrameReceiverConfig::map_frame_notify_transport_name_to_type(frame_notify_transport_str);
+  if (frame_notify_transport == Defaults::FrameNotifyTransportIllegal)
+  {
+    std::stringstream sstr;
+    sstr << "Illegal frame notification transport specified: " << frame_notify_transport_str;
+    throw FrameReceiverException(sstr.str());
+  }
+  if (frame_notify_transport != config_.frame_notify_transport_)
+  {
+    config_.frame_notify_transport_ = frame_notify_transport;
+    need_buffer_manager_reconfig_ = true;
+  }
+
+  unsigned int num_frame_rings = 0;
+  if (config_.frame_notify_transport_ == Defaults::FrameNotifyTransportSharedMemory)
+  {
+    num_frame_rings = std::min(config_msg.get_param<unsigned int>(CONFIG_RX_THREADS, config_.rx_threads_),
+        Defaults::max_rx_threads);
+  }
+  if (buffer_manager_ && (buffer_manager_->get_num_frame_rings() != num_frame_rings))
+  {
+    need_buffer_manager_reconfig_ = true;
+  }
+
   if (need_buffer_manager_reconfig_)
   {
 
@@ -635,15 +830,42 @@ void FrameReceiverController::configure_buffer_manager(OdinData::IpcMessage& con
       }
 
       // Create a new shared buffer manager
+      SharedBufferManager::MemoryOptions memory_options;
+      memory_options.huge_page_size = config_.shared_buffer_huge_page_size_;
+      memory_options.prefault = config_.shared_buffer_prefault_;
+      memory_options.lock = config_.shared_buffer_lock_;
+      memory_options.numa_node = config_.shared_buffer_numa_node_;
+
+      // Divide the buffer memory between the pools of frame buffers required by the decoder, in
+      // proportion to the share requested for each, so that each pool is sized for the frames
+      // it receives
+      std::vector<FrameBufferPool> decoder_pools;
+      frame_decoder_->get_frame_buffer_pools(decoder_pools);
+      unsigned int total_mem_share = 0;
+      for (unsigned int pool = 0; pool < decoder_pools.size(); pool++)
+      {
+        total_mem_share += decoder_pools[pool].mem_share;
+      }
+      std::vector<SharedBufferManager::PoolSpec> pools;
+      for (unsigned int pool = 0; pool < decoder_pools.size(); pool++)
+      {
+        std::size_t pool_mem = total_mem_share ?
+            (max_buffer_mem / total_mem_share) * decoder_pools[pool].mem_share : 0;
+        pools.push_back(SharedBufferManager::PoolSpec(decoder_pools[pool].buffer_size, pool_mem));
+      }
+
       buffer_manager_.reset(new SharedBufferManager(
-          shared_buffer_name, max_buffer_mem,frame_decoder_->get_frame_buffer_size(), true)
+          shared_buffer_name, pools, true, num_frame_rings, true, memory_options)
       );
 
       // Record the total number of buffers in the system here
       total_buffers_ = buffer_manager_->get_num_buffers();
 
       LOG4CXX_DEBUG_LEVEL(1, logger_, "Configured frame buffer manager of total size " <<
-          max_buffer_mem << " with " << total_buffers_ << " buffers");
+          max_buffer_mem << " with " << total_buffers_ << " buffers in " <<
+          buffer_manager_->get_num_pools() << " pools and " <<
+          num_frame_rings << " frame notification rings in pages of " <<
+          buffer_manager_->get_page_size() << " bytes");
 
       // Register buffer manager with the frame decoder
       frame_decoder_->register_buffer_manager(buffer_manager_);
@@ -681,6 +903,12 @@ void FrameReceiverController::configure_rx_thread(OdinData::IpcMessage& config_m
       CONFIG_RX_TYPE, FrameReceiverConfig::map_rx_type_to_name(config_.rx_type_));
   Defaults::RxType rx_type = FrameReceiverConfig::map_rx_name_to_type(rx_type_str);
 
+#ifndef __linux__
+  if (rx_type == Defaults::RxTypePacket)
+  {
+    throw FrameReceiverException("The packet RX type is only supported on Linux");
+  }
+#endif
   if (rx_type != config_.rx_type_)
   {
     config_.rx_type_ = rx_type;
@@ -703,6 +931,27 @@ void FrameReceiverController::configure_rx_thread(OdinData::IpcMessage& config_m
     need_rx_thread_reconfig_ = true;
   }
 
+  unsigned int rx_recv_batch_size = config_msg.get_param<unsigned int>(
+      CONFIG_RX_RECV_BATCH_SIZE, config_.rx_recv_batch_size_);
+  if ((rx_recv_batch_size == 0) || (rx_recv_batch_size > Defaults::max_rx_recv_batch_size))
+  {
+    std::stringstream sstr;
+    sstr << "Illegal RX receive batch size specified: " << rx_recv_batch_size
+         << " (must be between 1 and " << Defaults::max_rx_recv_batch_size << ")";
+    throw FrameReceiverException(sstr.str());
+  }
+#ifndef __linux__
+  if (rx_recv_batch_size > 1)
+  {
+    throw FrameReceiverException("Batched packet receive is only supported on Linux");
+  }
+#endif
+  if (rx_recv_batch_size != config_.rx_recv_batch_size_)
+  {
+    config_.rx_recv_batch_size_ = rx_recv_batch_size;
+    need_rx_thread_reconfig_ = true;
+  }
+
   std::string current_rx_port_list = config_.rx_port_list();
   std::string rx_port_list = config_msg.get_param<std::string>(
       CONFIG_RX_PORTS, current_rx_port_list);
@@ -712,6 +961,229 @@ void FrameReceiverController::configure_rx_thread(OdinData::IpcMessage& config_m
     need_rx_thread_reconfig_ = true;
   }
 
+  std::string rx_steering_str = config_msg.get_param<std::string>(
+      CONFIG_RX_STEERING, FrameReceiverConfig::map_rx_steering_type_to_name(config_.rx_steering_));
+  Defaults::RxSteering rx_steering = FrameReceiverConfig::map_rx_steering_name_to_type(
+      rx_steering_str);
+  if (rx_steering == Defaults::RxSteeringIllegal)
+  {
+    std::stringstream sstr;
+    sstr << "Illegal RX steering mode specified: " << rx_steering_str;
+    throw FrameReceiverException(sstr.str());
+  }
+  if ((rx_steering == Defaults::RxSteeringFrame) &&
+      (rx_type != Defaults::RxTypeUDP) && (rx_type != Defaults::RxTypePacket))
+  {
+    throw FrameReceiverException("RX steering by frame is only supported for UDP and packet RX types");
+  }
+#ifndef __linux__
+  if (rx_steering == Defaults::RxSteeringFrame)
+  {
+    throw FrameReceiverException("RX steering by frame is only supported on Linux");
+  }
+#endif
+  if (rx_steering != config_.rx_steering_)
+  {
+    config_.rx_steering_ = rx_steering;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  bool rx_spin_mode = config_msg.get_param<bool>(CONFIG_RX_SPIN_MODE, config_.rx_spin_mode_);
+  if (rx_spin_mode != config_.rx_spin_mode_)
+  {
+    config_.rx_spin_mode_ = rx_spin_mode;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  unsigned int rx_spin_check_interval = config_msg.get_param<unsigned int>(
+      CONFIG_RX_SPIN_CHECK_INTERVAL, config_.rx_spin_check_interval_);
+  if (rx_spin_check_interval == 0)
+  {
+    throw FrameReceiverException("Illegal RX spin check interval specified: must be at least 1");
+  }
+  if (rx_spin_check_interval != config_.rx_spin_check_interval_)
+  {
+    config_.rx_spin_check_interval_ = rx_spin_check_interval;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  unsigned int rx_spin_idle_timeout_ms = config_msg.get_param<unsigned int>(
+      CONFIG_RX_SPIN_IDLE_TIMEOUT_MS, config_.rx_spin_idle_timeout_ms_);
+  if (rx_spin_idle_timeout_ms != config_.rx_spin_idle_timeout_ms_)
+  {
+    config_.rx_spin_idle_timeout_ms_ = rx_spin_idle_timeout_ms;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  unsigned int rx_busy_poll_us = config_msg.get_param<unsigned int>(
+      CONFIG_RX_BUSY_POLL_US, config_.rx_busy_poll_us_);
+  if (rx_busy_poll_us != config_.rx_busy_poll_us_)
+  {
+    config_.rx_busy_poll_us_ = rx_busy_poll_us;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  bool rx_prefer_busy_poll = config_msg.get_param<bool>(
+      CONFIG_RX_PREFER_BUSY_POLL, config_.rx_prefer_busy_poll_);
+#ifndef __linux__
+  if ((rx_busy_poll_us > 0) || rx_prefer_busy_poll)
+  {
+    throw FrameReceiverException("RX socket busy polling is only supported on Linux");
+  }
+#endif
+  if (rx_prefer_busy_poll != config_.rx_prefer_busy_poll_)
+  {
+    config_.rx_prefer_busy_poll_ = rx_prefer_busy_poll;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  // The packet RX ring block size must be a non-zero multiple of the page size
+  unsigned int rx_ring_block_size = config_msg.get_param<unsigned int>(
+      CONFIG_RX_RING_BLOCK_SIZE, config_.rx_ring_block_size_);
+  if ((rx_ring_block_size == 0) || (rx_ring_block_size % getpagesize()))
+  {
+    std::stringstream sstr;
+    sstr << "Illegal RX ring block size specified: " << rx_ring_block_size
+         << " (must be a multiple of the page size " << getpagesize() << ")";
+    throw FrameReceiverException(sstr.str());
+  }
+  if (rx_ring_block_size != config_.rx_ring_block_size_)
+  {
+    config_.rx_ring_block_size_ = rx_ring_block_size;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  unsigned int rx_ring_block_timeout_ms = config_msg.get_param<unsigned int>(
+      CONFIG_RX_RING_BLOCK_TIMEOUT_MS, config_.rx_ring_block_timeout_ms_);
+  if (rx_ring_block_timeout_ms != config_.rx_ring_block_timeout_ms_)
+  {
+    config_.rx_ring_block_timeout_ms_ = rx_ring_block_timeout_ms;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  // The io_uring receive engine is available for UDP and TCP RX threads and replaces the spinning
+  // event loop, so cannot be combined with spin mode
+  std::string rx_engine_str = config_msg.get_param<std::string>(
+      CONFIG_RX_ENGINE, FrameReceiverConfig::map_rx_engine_type_to_name(config_.rx_engine_));
+  Defaults::RxEngine rx_engine = FrameReceiverConfig::map_rx_engine_name_to_type(rx_engine_str);
+  if (rx_engine == Defaults::RxEngineIllegal)
+  {
+    std::stringstream sstr;
+    sstr << "Illegal RX engine specified: " << rx_engine_str;
+    throw FrameReceiverException(sstr.str());
+  }
+#ifndef HAVE_IO_URING
+  if (rx_engine == Defaults::RxEngineIoUring)
+  {
+    throw FrameReceiverException("The io_uring RX engine is not supported on this platform");
+  }
+#endif
+  if ((rx_engine == Defaults::RxEngineIoUring) &&
+      (rx_type != Defaults::RxTypeUDP) && (rx_type != Defaults::RxTypeTCP))
+  {
+    throw FrameReceiverException("The io_uring RX engine is only supported for UDP and TCP RX types");
+  }
+  if ((rx_engine == Defaults::RxEngineIoUring) && rx_spin_mode)
+  {
+    throw FrameReceiverException("The io_uring RX engine cannot be used in RX spin mode");
+  }
+  if (rx_engine != config_.rx_engine_)
+  {
+    config_.rx_engine_ = rx_engine;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  // The number of io_uring provided buffers must be a power of two
+  unsigned int rx_uring_buffers = config_msg.get_param<unsigned int>(
+      CONFIG_RX_URING_BUFFERS, config_.rx_uring_buffers_);
+  if ((rx_uring_buffers == 0) || (rx_uring_buffers > Defaults::max_rx_uring_buffers) ||
+      (rx_uring_buffers & (rx_uring_buffers - 1)))
+  {
+    std::stringstream sstr;
+    sstr << "Illegal number of RX io_uring buffers specified: " << rx_uring_buffers
+         << " (must be a power of two no greater than " << Defaults::max_rx_uring_buffers << ")";
+    throw FrameReceiverException(sstr.str());
+  }
+  if (rx_uring_buffers != config_.rx_uring_buffers_)
+  {
+    config_.rx_uring_buffers_ = rx_uring_buffers;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  unsigned int rx_uring_buffer_size = config_msg.get_param<unsigned int>(
+      CONFIG_RX_URING_BUFFER_SIZE, config_.rx_uring_buffer_size_);
+  if (rx_uring_buffer_size == 0)
+  {
+    throw FrameReceiverException("Illegal RX io_uring buffer size specified: must be non-zero");
+  }
+  if (rx_uring_buffer_size != config_.rx_uring_buffer_size_)
+  {
+    config_.rx_uring_buffer_size_ = rx_uring_buffer_size;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  // TCP RX threads either connect out to each receive port or listen and accept connections on it
+  std::string rx_tcp_mode_str = config_msg.get_param<std::string>(
+      CONFIG_RX_TCP_MODE, FrameReceiverConfig::map_rx_tcp_mode_type_to_name(config_.rx_tcp_mode_));
+  Defaults::RxTcpMode rx_tcp_mode = FrameReceiverConfig::map_rx_tcp_mode_name_to_type(rx_tcp_mode_str);
+  if (rx_tcp_mode == Defaults::RxTcpModeIllegal)
+  {
+    std::stringstream sstr;
+    sstr << "Illegal RX TCP mode specified: " << rx_tcp_mode_str;
+    throw FrameReceiverException(sstr.str());
+  }
+  if (rx_tcp_mode != config_.rx_tcp_mode_)
+  {
+    config_.rx_tcp_mode_ = rx_tcp_mode;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  // UDP generic receive offload coalesces packets into single receives, replacing batched receives,
+  // and is only supported by the reactor engine of the UDP RX thread
+  bool rx_udp_gro = config_msg.get_param<bool>(CONFIG_RX_UDP_GRO, config_.rx_udp_gro_);
+  if (rx_udp_gro && (rx_type != Defaults::RxTypeUDP))
+  {
+    throw FrameReceiverException("UDP GRO is only supported for the UDP RX type");
+  }
+  if (rx_udp_gro && (rx_engine == Defaults::RxEngineIoUring))
+  {
+    throw FrameReceiverException("UDP GRO cannot be used with the io_uring RX engine");
+  }
+  if (rx_udp_gro && (rx_recv_batch_size > 1))
+  {
+    throw FrameReceiverException("UDP GRO cannot be combined with batched receives");
+  }
+#ifndef __linux__
+  if (rx_udp_gro)
+  {
+    throw FrameReceiverException("UDP GRO is only supported on Linux");
+  }
+#endif
+  if (rx_udp_gro != config_.rx_udp_gro_)
+  {
+    config_.rx_udp_gro_ = rx_udp_gro;
+    need_rx_thread_reconfig_ = true;
+  }
+
+  // When steering by port, each RX thread must service at least one port
+  unsigned int rx_threads = config_msg.get_param<unsigned int>(
+      CONFIG_RX_THREADS, config_.rx_threads_);
+  if ((rx_threads == 0) || (rx_threads > Defaults::max_rx_threads) ||
+      ((rx_steering == Defaults::RxSteeringPort) && (rx_threads > 1) &&
+          (rx_threads > config_.rx_ports_.size())))
+  {
+    std::stringstream sstr;
+    sstr << "Illegal number of RX threads specified: " << rx_threads
+         << " (must be between 1 and " << Defaults::max_rx_threads
+         << ", and no more than the number of RX ports when steering by port)";
+    throw FrameReceiverException(sstr.str());
+  }
+  if (rx_threads != config_.rx_threads_)
+  {
+    config_.rx_threads_ = rx_threads;
+    need_rx_thread_reconfig_ = true;
+  }
+
   if (need_rx_thread_reconfig_)
   {
 
@@ -723,27 +1195,61 @@ void FrameReceiverController::configure_rx_thread(OdinData::IpcMessage& config_m
 
       this->stop_rx_thread();
 
-      // Create the RX thread object
-      switch(rx_type)
+      // Build the list of frame decoders, one for each RX thread. The first thread uses the
+      // primary decoder instance, additional threads are given their own instances so that the
+      // decoder state is never shared between threads.
+      frame_decoders_.push_back(frame_decoder_);
+      for (unsigned int thread_idx = 1; thread_idx < rx_threads; thread_idx++)
       {
-        case Defaults::RxTypeUDP:
-          rx_thread_.reset(new FrameReceiverUDPRxThread(config_, buffer_manager_, frame_decoder_));
-          break;
+        FrameDecoderPtr frame_decoder = this->load_frame_decoder();
+        frame_decoder->register_buffer_manager(buffer_manager_);
+        frame_decoders_.push_back(frame_decoder);
+      }
 
-        case Defaults::RxTypeZMQ:
-          rx_thread_.reset(new FrameReceiverZMQRxThread(config_, buffer_manager_, frame_decoder_));
-          break;
+      // Reset the identity and status of each RX thread until they are announced
+      rx_thread_identities_.assign(rx_threads, RX_THREAD_ID);
+      rx_thread_status_.assign(rx_threads, boost::shared_ptr<IpcMessage>());
 
-        case Defaults::RxTypeTCP:
-          rx_thread_.reset(new FrameReceiverTCPRxThread(config_, buffer_manager_, frame_decoder_));
-          break;
+      // Create the RX thread objects
+      for (unsigned int thread_idx = 0; thread_idx < rx_threads; thread_idx++)
+      {
+        boost::shared_ptr<FrameReceiverRxThread> rx_thread;
+        switch(rx_type)
+        {
+          case Defaults::RxTypeUDP:
+            rx_thread.reset(new FrameReceiverUDPRxThread(config_, buffer_manager_,
+                frame_decoders_[thread_idx], Defaults::default_rx_tick_period_ms, thread_idx));
+            break;
 
-        default:
-          throw FrameReceiverException("Cannot create RX thread - RX type not recognised");
+          case Defaults::RxTypeZMQ:
+            rx_thread.reset(new FrameReceiverZMQRxThread(config_, buffer_manager_,
+                frame_decoders_[thread_idx], Defaults::default_rx_tick_period_ms, thread_idx));
+            break;
+
+          case Defaults::RxTypeTCP:
+            rx_thread.reset(new FrameReceiverTCPRxThread(config_, buffer_manager_,
+                frame_decoders_[thread_idx], Defaults::default_rx_tick_period_ms, thread_idx));
+            break;
+
+#ifdef __linux__
+          case Defaults::RxTypePacket:
+            rx_thread.reset(new FrameReceiverPacketRxThread(config_, buffer_manager_,
+                frame_decoders_[thread_idx], Defaults::default_rx_tick_period_ms, thread_idx));
+            break;
+#endif
+
+          default:
+            throw FrameReceiverException("Cannot create RX thread - RX type not recognised");
+        }
+        rx_threads_.push_back(rx_thread);
       }
 
-      // Start the RX thread, Flagging successful completion of configuration
-      rx_thread_configured_ = rx_thread_->start();
+      // Start the RX threads, Flagging successful completion of configuration if all started
+      rx_thread_configured_ = true;
+      for (unsigned int thread_idx = 0; thread_idx < rx_threads_.size(); thread_idx++)
+      {
+        rx_thread_configured_ &= rx_threads_[thread_idx]->start();
+      }
 
     }
     else
@@ -754,24 +1260,70 @@ void FrameReceiverController::configure_rx_thread(OdinData::IpcMessage& config_m
   }
 }
 
-//! Stop the receiver thread.
+//! Stop the receiver threads.
 //!
-//! This method stops the receiver thread cleanly and deletes the object instance by resetting
-//! the scoped pointer.
+//! This method stops the receiver threads cleanly and deletes the object instances by clearing
+//! the thread list. The additional frame decoder instances created for all but the first thread
+//! are also released.
 //!
 void FrameReceiverController::stop_rx_thread(void)
 {
-  if (rx_thread_)
+  if (!rx_threads_.empty())
   {
-    // Signal to the RX thread to stop operation
-    rx_thread_->stop();
+    // Signal to the RX threads to stop operation, retaining the counts of frames they notified
+    // and released directly
+    for (unsigned int thread_idx = 0; thread_idx < rx_threads_.size(); thread_idx++)
+    {
+      rx_threads_[thread_idx]->stop();
+      frames_received_ += rx_threads_[thread_idx]->get_direct_frames_ready();
+      frames_released_ += rx_threads_[thread_idx]->get_direct_frames_released();
+    }
 
-    // Reset the scoped pointer to the RX thread
-    rx_thread_.reset();
+    // Clear the list of RX threads
+    rx_threads_.clear();
 
     // Clear the RX thread configured flag
     rx_thread_configured_ = false;
   }
+
+  frame_decoders_.clear();
+}
+
+//! Configure thread placement.
+//!
+//! This method configures the CPU affinity, scheduling priority and NUMA memory policy of the
+//! threads in the frame receiver, based on the thread placement specifications present in the
+//! configuration message. Threads are named "main", "rx_thread_<n>" and "zmq_io_<n>";
+//! specifications are matched against these names, optionally with trailing segments removed,
+//! e.g. "rx_thread" matches all RX threads.
+//!
+//! \param[in] config_msg - IpcMessage containing configuration parameters
+//!
+void FrameReceiverController::configure_thread_placement(OdinData::IpcMessage& config_msg)
+{
+  if (!config_msg.has_param(CONFIG_THREAD_PLACEMENT))
+  {
+    return;
+  }
+
+  try
+  {
+    const rapidjson::Value& placement_value =
+        config_msg.get_param<const rapidjson::Value&>(CONFIG_THREAD_PLACEMENT);
+    if (!placement_value.IsObject())
+    {
+      throw OdinData::ThreadPlacementException("placement must be an object indexed by thread name");
+    }
+    OdinData::IpcMessage placement_config(placement_value);
+    ThreadPlacement::Instance().configure(placement_config);
+  }
+  catch (OdinData::ThreadPlacementException& e)
+  {
+    std::stringstream sstr;
+    sstr << "Failed to configure thread placement: " << e.what();
+    throw FrameReceiverException(sstr.str());
+  }
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "Thread placement configured");
 }
 
 //! Handle control channel messages.
@@ -904,6 +1456,17 @@ void FrameReceiverController::handle_rx_channel(void)
   std::string msg_indentity;
   std::string rx_msg_encoded = rx_channel_.recv(&msg_indentity);
 
+  // Binary frame ready notifications are passed straight on without decoding as JSON. These carry
+  // the time the frame became ready, allowing the latency of relaying them to be measured
+  if (FrameNotification::is_binary(rx_msg_encoded))
+  {
+    LOG4CXX_DEBUG_LEVEL(2, logger_, "Got binary frame ready notification from RX thread");
+    frame_ready_channel_.send(rx_msg_encoded);
+    frames_received_++;
+    this->record_notify_latency(FrameNotification(rx_msg_encoded).get_ready_time_ns());
+    return;
+  }
+
   // Decode the messsage and handle appropriately
   try {
 
@@ -918,7 +1481,13 @@ void FrameReceiverController::handle_rx_channel(void)
         {
           case IpcMessage::MsgValCmdBufferPrechargeRequest:
             LOG4CXX_DEBUG_LEVEL(2, logger_, "Got buffer precharge request from RX thread");
-            this->precharge_buffers();
+            {
+              int thread_idx = this->rx_thread_index(msg_indentity);
+              if (thread_idx >= 0)
+              {
+                this->precharge_buffers(thread_idx);
+              }
+            }
             break;
 
           default:
@@ -942,16 +1511,31 @@ void FrameReceiverController::handle_rx_channel(void)
           case IpcMessage::MsgValNotifyIdentity:
             LOG4CXX_DEBUG_LEVEL(1, logger_,
               "Got identity announcement from RX thread: " << msg_indentity);
-              rx_thread_identity_ = msg_indentity;
               {
+                unsigned int thread_idx = rx_msg.get_param<unsigned int>("thread_index", 0);
+                if (thread_idx < rx_thread_identities_.size())
+                {
+                  rx_thread_identities_[thread_idx] = msg_indentity;
+                }
+                else
+                {
+                  LOG4CXX_ERROR(logger_, "Got identity announcement from RX thread with illegal"
+                    " index " << thread_idx);
+                }
                 IpcMessage rx_reply(IpcMessage::MsgTypeAck, IpcMessage::MsgValNotifyIdentity);
-                rx_channel_.send(rx_reply.encode(), 0, rx_thread_identity_);
+                rx_channel_.send(rx_reply.encode(), 0, msg_indentity);
               }
             break;
 
           case IpcMessage::MsgValNotifyStatus:
             LOG4CXX_DEBUG_LEVEL(4, logger_, "Got status notification from RX thread");
-            this->store_rx_thread_status(rx_msg);
+            {
+              int thread_idx = this->rx_thread_index(msg_indentity);
+              if (thread_idx >= 0)
+              {
+                this->store_rx_thread_status(thread_idx, rx_msg);
+              }
+            }
             break;
 
           default:
@@ -977,35 +1561,45 @@ void FrameReceiverController::handle_rx_channel(void)
 //!
 //! This method is the handler registered with the reactor to handle messages received
 //! on the frame release channel. Released frames are passed on to the RX thread so the
-//! associated buffer can be queued for re-use in subsequent frame reception.
+//! associated buffer can be queued for re-use in subsequent frame reception. Release
+//! notifications may be either JSON messages or binary notifications, and either may carry a
+//! batch of releases.
 //!
 void FrameReceiverController::handle_frame_release_channel(void)
 {
   std::string frame_release_encoded = frame_release_channel_.recv();
+
+  if (FrameNotification::is_binary_batch(frame_release_encoded))
+  {
+    try {
+      std::vector<FrameNotification> frame_releases;
+      FrameNotification::decode_batch(frame_release_encoded, frame_releases);
+      this->release_frame_batch(frame_releases, frame_release_encoded);
+    }
+    catch (FrameNotificationException& e)
+    {
+      LOG4CXX_ERROR(logger_,
+          "Error decoding binary notification on frame release channel: " << e.what());
+    }
+    return;
+  }
+
   try {
     IpcMessage frame_release(frame_release_encoded.c_str());
     LOG4CXX_DEBUG_LEVEL(4, logger_,
         "Got message on frame release channel : " << frame_release_encoded);
 
     if ((frame_release.get_msg_type() == IpcMessage::MsgTypeNotify) &&
+        (frame_release.get_msg_val() == IpcMessage::MsgValNotifyFrameRelease) &&
+        frame_release.has_param("buffer_ids"))
+    {
+      this->release_frame_batch(frame_release, frame_release_encoded);
+    }
+    else if ((frame_release.get_msg_type() == IpcMessage::MsgTypeNotify) &&
         (frame_release.get_msg_val() == IpcMessage::MsgValNotifyFrameRelease))
     {
-      LOG4CXX_DEBUG_LEVEL(2, logger_, "Got frame release notification from processor"
-          " from frame " << frame_release.get_param<int>("frame", -1) <<
-                         " in buffer " << frame_release.get_param<int>("buffer_id", -1));
-      rx_channel_.send(frame_release_encoded, 0, rx_thread_identity_);
-
-      frames_released_++;
-
-      if (config_.frame_count_ && (frames_released_ >= config_.frame_count_))
-      {
-        LOG4CXX_INFO(logger_,
-            "Specified number of frames (" << config_.frame_count_
-            << ") received and released, terminating"
-        );
-        this->stop();
-        reactor_.stop();
-      }
+      this->release_frame(frame_release.get_param<int>("buffer_id", -1),
+          frame_release.get_param<int>("frame", -1), frame_release_encoded);
     }
     else if ((frame_release.get_msg_type() == IpcMessage::MsgTypeCmd) &&
              (frame_release.get_msg_val() == IpcMessage::MsgValCmdBufferConfigRequest))
@@ -1026,23 +1620,286 @@ void FrameReceiverController::handle_frame_release_channel(void)
   }
 }
 
-//! Precharge empty frame buffers for use by the receiver thread.
+//! Release a frame buffer.
+//!
+//! This method passes a frame release notification received from the frame processor on to the
+//! RX thread owning the buffer, so that it can be queued for re-use.
+//!
+//! \param[in] buffer_id - ID of the buffer released
+//! \param[in] frame - frame number contained in the buffer
+//! \param[in] frame_release_encoded - encoded release notification to pass to the RX thread
+//!
+void FrameReceiverController::release_frame(int buffer_id, int64_t frame,
+    std::string& frame_release_encoded)
+{
+  LOG4CXX_DEBUG_LEVEL(2, logger_, "Got frame release notification from processor"
+      " from frame " << frame << " in buffer " << buffer_id);
+  unsigned int thread_idx = this->rx_thread_for_buffer(buffer_id);
+  rx_channel_.send(frame_release_encoded, 0, rx_thread_identities_[thread_idx]);
+
+  frames_released_++;
+
+  this->check_frame_count();
+}
+
+//! Release a batch of frame buffers notified with binary notifications.
+//!
+//! This method passes a batch of binary frame release notifications received from the frame
+//! processor on to the RX threads owning the buffers. With a single RX thread the batch is passed
+//! on as received, otherwise it is split into a batch for each RX thread.
+//!
+//! \param[in] frame_releases - decoded frame release notifications
+//! \param[in] frame_release_encoded - encoded batch of release notifications
+//!
+void FrameReceiverController::release_frame_batch(
+    const std::vector<FrameNotification>& frame_releases, std::string& frame_release_encoded)
+{
+  unsigned int num_threads = rx_thread_identities_.size();
+  std::vector<std::string> thread_batches(num_threads);
+  unsigned int num_released = 0;
+
+  for (std::vector<FrameNotification>::const_iterator it = frame_releases.begin();
+       it != frame_releases.end(); ++it)
+  {
+    if (it->get_type() != FrameNotification::TypeFrameRelease)
+    {
+      LOG4CXX_ERROR(logger_, "Got unexpected binary notification type "
+          << it->get_type() << " on frame release channel");
+      continue;
+    }
+    LOG4CXX_DEBUG_LEVEL(2, logger_, "Got frame release notification from processor"
+        " from frame " << it->get_frame() << " in buffer " << it->get_buffer_id());
+    if (num_threads > 1)
+    {
+      it->encode_to_batch(thread_batches[this->rx_thread_for_buffer(it->get_buffer_id())]);
+    }
+    num_released++;
+  }
+
+  if (num_threads > 1)
+  {
+    for (unsigned int thread_idx = 0; thread_idx < num_threads; thread_idx++)
+    {
+      if (!thread_batches[thread_idx].empty())
+      {
+        rx_channel_.send(thread_batches[thread_idx], 0, rx_thread_identities_[thread_idx]);
+      }
+    }
+  }
+  else if (num_released && num_threads)
+  {
+    rx_channel_.send(frame_release_encoded, 0, rx_thread_identities_[0]);
+  }
+
+  frames_released_ += num_released;
+
+  this->check_frame_count();
+}
+
+//! Release a batch of frame buffers notified with a JSON message.
+//!
+//! This method passes a JSON frame release message carrying arrays of frame numbers and buffer
+//! IDs on to the RX threads owning the buffers. With a single RX thread the message is passed on
+//! as received, otherwise it is split into a message for each RX thread.
+//!
+//! \param[in] frame_release - decoded frame release message
+//! \param[in] frame_release_encoded - encoded frame release message
+//!
+void FrameReceiverController::release_frame_batch(IpcMessage& frame_release,
+    std::string& frame_release_encoded)
+{
+  const rapidjson::Value& buffer_ids = frame_release.get_param<const rapidjson::Value&>("buffer_ids");
+  const rapidjson::Value& frames = frame_release.get_param<const rapidjson::Value&>("frames");
+  if (!buffer_ids.IsArray() || !frames.IsArray() || (buffer_ids.Size() != frames.Size()))
+  {
+    LOG4CXX_ERROR(logger_, "Got malformed batched frame release: " << frame_release_encoded);
+    return;
+  }
+  LOG4CXX_DEBUG_LEVEL(2, logger_, "Got batched release of " << buffer_ids.Size()
+      << " frames from processor");
+
+  unsigned int num_threads = rx_thread_identities_.size();
+  if (num_threads > 1)
+  {
+    std::vector<boost::shared_ptr<IpcMessage> > thread_batches(num_threads);
+    for (rapidjson::SizeType idx = 0; idx < buffer_ids.Size(); idx++)
+    {
+      unsigned int thread_idx = this->rx_thread_for_buffer(buffer_ids[idx].GetInt());
+      if (!thread_batches[thread_idx])
+      {
+        thread_batches[thread_idx].reset(
+            new IpcMessage(IpcMessage::MsgTypeNotify, IpcMessage::MsgValNotifyFrameRelease));
+      }
+      thread_batches[thread_idx]->set_param("frames[]", frames[idx].GetUint64());
+      thread_batches[thread_idx]->set_param("buffer_ids[]", buffer_ids[idx].GetInt());
+    }
+    for (unsigned int thread_idx = 0; thread_idx < num_threads; thread_idx++)
+    {
+      if (thread_batches[thread_idx])
+      {
+        rx_channel_.send(thread_batches[thread_idx]->encode(), 0, rx_thread_identities_[thread_idx]);
+      }
+    }
+  }
+  else if (num_threads)
+  {
+    rx_channel_.send(frame_release_encoded, 0, rx_thread_identities_[0]);
+  }
+
+  frames_released_ += buffer_ids.Size();
+
+  this->check_frame_count();
+}
+
+//! Check if the specified number of frames has been released.
 //!
-//! This method precharges all the buffers available in the shared buffer manager onto the
-//! empty buffer queue in the receiver thread. This allows the receiver thread to obtain a pool
-//! of empty buffers at startup, and is done by sending a buffer precharge notification over the
-//! RX thread channel.
+//! This method stops the controller if a frame count has been specified and that number of
+//! frames has been received and released.
 //!
-void FrameReceiverController::precharge_buffers(void)
+void FrameReceiverController::check_frame_count(void)
+{
+  if (config_.frame_count_ && (this->get_frames_released() >= config_.frame_count_))
+  {
+    LOG4CXX_INFO(logger_,
+        "Specified number of frames (" << config_.frame_count_
+        << ") received and released, terminating"
+    );
+    this->stop();
+    reactor_.stop();
+  }
+}
+
+//! Record the latency of notifying a frame ready.
+//!
+//! This method accumulates the latency between a frame becoming ready in the frame decoder and the
+//! notification of it being sent on the frame ready channel, for reporting in status.
+//!
+//! \param[in] ready_time_ns - time the frame became ready in nanoseconds since the epoch
+//!
+void FrameReceiverController::record_notify_latency(uint64_t ready_time_ns)
+{
+  uint64_t now_ns = FrameNotification::now_ns();
+  uint64_t latency_ns = (now_ns > ready_time_ns) ? now_ns - ready_time_ns : 0;
+  notify_latency_total_ns_ += latency_ns;
+  notify_latency_max_ns_ = std::max(notify_latency_max_ns_, latency_ns);
+  frames_notified_++;
+}
+
+//! Return the number of frames received.
+//!
+//! Frames notified by the RX threads through shared frame rings or directly on the frame ready
+//! channel bypass the controller, so are counted by the RX threads themselves. These counts are
+//! added to the frames relayed by the controller.
+//!
+//! \return number of frames received
+//!
+unsigned int FrameReceiverController::get_frames_received(void)
+{
+  unsigned int frames_received = frames_received_;
+  for (unsigned int thread_idx = 0; thread_idx < rx_threads_.size(); thread_idx++)
+  {
+    frames_received += rx_threads_[thread_idx]->get_direct_frames_ready();
+  }
+  return frames_received;
+}
+
+//! Return the number of frames released.
+//!
+//! As for frames received, releases bypassing the controller are counted by the RX threads and
+//! added to the releases relayed by the controller.
+//!
+//! \return number of frames released
+//!
+unsigned int FrameReceiverController::get_frames_released(void)
+{
+  unsigned int frames_released = frames_released_;
+  for (unsigned int thread_idx = 0; thread_idx < rx_threads_.size(); thread_idx++)
+  {
+    frames_released += rx_threads_[thread_idx]->get_direct_frames_released();
+  }
+  return frames_released;
+}
+
+//! Resolve the index of an RX thread from its channel identity.
+//!
+//! This method returns the index of the RX thread with the specified identity on the RX thread
+//! channel, as previously announced by that thread.
+//!
+//! \param[in] identity - identity of the RX thread channel endpoint
+//! \return index of the RX thread, or -1 if the identity is not recognised
+//!
+int FrameReceiverController::rx_thread_index(const std::string& identity)
+{
+  for (unsigned int thread_idx = 0; thread_idx < rx_thread_identities_.size(); thread_idx++)
+  {
+    if (rx_thread_identities_[thread_idx] == identity)
+    {
+      return thread_idx;
+    }
+  }
+  LOG4CXX_ERROR(logger_, "Got message from unrecognised RX thread identity: " << identity);
+  return -1;
+}
+
+//! Resolve the RX thread owning a frame buffer.
+//!
+//! This method returns the index of the RX thread to which the specified buffer was precharged.
+//! The buffers of each pool are divided into contiguous ranges, one for each RX thread, so that
+//! each buffer is only ever handled by a single thread and frame decoder.
+//!
+//! \param[in] buffer_id - ID of the buffer
+//! \return index of the RX thread owning the buffer
+//!
+unsigned int FrameReceiverController::rx_thread_for_buffer(int buffer_id)
+{
+  unsigned int num_threads = rx_thread_identities_.size();
+  if (buffer_manager_ && (buffer_id >= 0) && (num_threads > 1) &&
+      ((std::size_t)buffer_id < buffer_manager_->get_num_buffers()))
+  {
+    unsigned int pool = buffer_manager_->get_buffer_pool(buffer_id);
+    std::size_t pool_buffer = buffer_id - buffer_manager_->get_pool_first_buffer(pool);
+    std::size_t num_buffers = buffer_manager_->get_pool_num_buffers(pool);
+    for (unsigned int thread_idx = 0; thread_idx < num_threads; thread_idx++)
+    {
+      if (pool_buffer < ((thread_idx + 1) * num_buffers) / num_threads)
+      {
+        return thread_idx;
+      }
+    }
+  }
+  return 0;
+}
+
+//! Precharge empty frame buffers for use by a receiver thread.
+//!
+//! This method precharges the buffers available in the shared buffer manager onto the
+//! empty buffer queue in the specified receiver thread. This allows the receiver thread to obtain
+//! a pool of empty buffers at startup, and is done by sending a buffer precharge notification over
+//! the RX thread channel for each pool of buffers in the shared buffer. When multiple RX threads
+//! are configured, each is precharged with an equal, contiguous range of the buffers in each pool.
+//!
+//! \param[in] thread_index - index of the RX thread to precharge
+//!
+void FrameReceiverController::precharge_buffers(unsigned int thread_index)
 {
 
   // Only pre-charge buffers if a buffer manager and RX thread are configured
-  if (buffer_manager_ && rx_thread_)
+  if (buffer_manager_ && (thread_index < rx_threads_.size()))
   {
-    IpcMessage precharge_msg(IpcMessage::MsgTypeNotify, IpcMessage::MsgValNotifyBufferPrecharge);
-    precharge_msg.set_param<int>("start_buffer_id", 0);
-    precharge_msg.set_param<int>("num_buffers", buffer_manager_->get_num_buffers());
-    rx_channel_.send(precharge_msg.encode(), 0, rx_thread_identity_);
+    std::size_t num_threads = rx_threads_.size();
+    for (unsigned int pool = 0; pool < buffer_manager_->get_num_pools(); pool++)
+    {
+      std::size_t num_buffers = buffer_manager_->get_pool_num_buffers(pool);
+      int first_buffer_id = buffer_manager_->get_pool_first_buffer(pool);
+      int start_buffer_id = first_buffer_id + (thread_index * num_buffers) / num_threads;
+      int end_buffer_id = first_buffer_id + ((thread_index + 1) * num_buffers) / num_threads;
+
+      IpcMessage precharge_msg(IpcMessage::MsgTypeNotify, IpcMessage::MsgValNotifyBufferPrecharge);
+      precharge_msg.set_param<int>("start_buffer_id", start_buffer_id);
+      precharge_msg.set_param<int>("num_buffers", end_buffer_id - start_buffer_id);
+      precharge_msg.set_param<unsigned int>("pool", pool);
+      rx_channel_.send(precharge_msg.encode(), 0, rx_thread_identities_[thread_index]);
+    }
   }
   else
   {
@@ -1072,6 +1929,11 @@ void FrameReceiverController::notify_buffer_config(const bool deferred)
       boost::bind(&FrameReceiverController::notify_buffer_config, this, false)
     );
   }
+  else if (config_.frame_notify_direct_)
+  {
+    LOG4CXX_DEBUG_LEVEL(1, logger_,
+        "Not notifying shared buffer configuration as the RX thread owns the frame ready channel");
+  }
   else
   {
     LOG4CXX_DEBUG_LEVEL(1, logger_,
@@ -1089,12 +1951,24 @@ void FrameReceiverController::notify_buffer_config(const bool deferred)
 //! This method stores all the parameters present in the RX thread status message passed as an
 //! argument, allowing them to be returned in subsequent get_status calls
 //!
+//! \param[in] thread_index - index of the RX thread reporting status
 //! \param[in] rx_status_msg - IpcMessage containing RX thread status parameters
 //!
-void FrameReceiverController::store_rx_thread_status(OdinData::IpcMessage& rx_status_msg)
+void FrameReceiverController::store_rx_thread_status(unsigned int thread_index,
+    OdinData::IpcMessage& rx_status_msg)
 {
-  rx_thread_status_.reset(new IpcMessage(rx_status_msg.encode()));
-  LOG4CXX_DEBUG_LEVEL(4, logger_, "RX thread status: " << rx_thread_status_->encode());
+  if (thread_index >= rx_thread_status_.size())
+  {
+    rx_thread_status_.resize(thread_index + 1);
+  }
+
+  rx_thread_status_[thread_index].reset(new IpcMessage(rx_status_msg.encode()));
+  LOG4CXX_DEBUG_LEVEL(4, logger_, "RX thread " << thread_index << " status: "
+      << rx_thread_status_[thread_index]->encode());
+
+  // Frames released directly to the RX threads bypass the controller, so check the frame count
+  // as each thread reports its status
+  this->check_frame_count();
 }
 
 //! Get the frame receiver status.
@@ -1119,31 +1993,95 @@ void FrameReceiverController::get_status(OdinData::IpcMessage& status_reply)
   unsigned int mapped_buffers = 0;
   unsigned int frames_timedout = 0;
   unsigned int frames_dropped = 0;
+  uint64_t buffers_reclaimed = 0;
+  unsigned int scrub_backlog = 0;
 
-  if (rx_thread_status_)
+  for (unsigned int thread_idx = 0; thread_idx < rx_thread_status_.size(); thread_idx++)
   {
-    empty_buffers = rx_thread_status_->get_param<unsigned int>("rx_thread/empty_buffers");
-    mapped_buffers = rx_thread_status_->get_param<unsigned int>("rx_thread/mapped_buffers");
-    frames_timedout = rx_thread_status_->get_param<unsigned int>("rx_thread/frames_timedout");
-    frames_dropped = rx_thread_status_->get_param<unsigned int>("rx_thread/frames_dropped");
+    boost::shared_ptr<IpcMessage> thread_status = rx_thread_status_[thread_idx];
+    if (!thread_status)
+    {
+      continue;
+    }
+
+    empty_buffers += thread_status->get_param<unsigned int>("rx_thread/empty_buffers");
+    mapped_buffers += thread_status->get_param<unsigned int>("rx_thread/mapped_buffers");
+    frames_timedout += thread_status->get_param<unsigned int>("rx_thread/frames_timedout");
+    frames_dropped += thread_status->get_param<unsigned int>("rx_thread/frames_dropped");
+    buffers_reclaimed += thread_status->get_param<uint64_t>("rx_thread/buffers_reclaimed");
+    scrub_backlog += thread_status->get_param<unsigned int>("rx_thread/scrub_backlog");
+
+    // Copy the status info of the first RX thread, e.g. packet receive rates, and any decoder
+    // status info present into the top level of the reply
+    if (thread_idx == 0)
+    {
+      status_reply.set_param("rx_thread",
+         thread_status->get_param<const rapidjson::Value&>("rx_thread"));
+      if (thread_status->has_param("decoder"))
+      {
+        status_reply.set_param("decoder",
+           thread_status->get_param<const rapidjson::Value&>("decoder"));
+      }
+    }
 
-    // If there is decoder status info present, also copy that into the reply
-    if (rx_thread_status_->has_param("decoder"))
+    // If multiple RX threads are running, copy the status info of each into the reply
+    if (rx_thread_status_.size() > 1)
     {
-      status_reply.set_param("decoder",
-         rx_thread_status_->get_param<const rapidjson::Value&>("decoder"));
+      std::stringstream thread_prefix;
+      thread_prefix << "rx_threads/" << thread_idx << "/";
+      status_reply.set_param(thread_prefix.str() + "rx_thread",
+         thread_status->get_param<const rapidjson::Value&>("rx_thread"));
+      if (thread_status->has_param("decoder"))
+      {
+        status_reply.set_param(thread_prefix.str() + "decoder",
+           thread_status->get_param<const rapidjson::Value&>("decoder"));
+      }
     }
   }
 
   status_reply.set_param("buffers/total", total_buffers_);
   status_reply.set_param("buffers/empty", empty_buffers);
   status_reply.set_param("buffers/mapped", mapped_buffers);
+  status_reply.set_param("buffers/reclaimed", buffers_reclaimed);
+  status_reply.set_param("buffers/scrub_backlog", scrub_backlog);
+  if (buffer_manager_)
+  {
+    for (unsigned int pool = 0; pool < buffer_manager_->get_num_pools(); pool++)
+    {
+      std::stringstream pool_prefix;
+      pool_prefix << "buffers/pools/" << pool << "/";
+      status_reply.set_param<std::size_t>(pool_prefix.str() + "buffer_size",
+          buffer_manager_->get_pool_buffer_size(pool));
+      status_reply.set_param<std::size_t>(pool_prefix.str() + "num_buffers",
+          buffer_manager_->get_pool_num_buffers(pool));
+    }
+    status_reply.set_param<std::size_t>("buffers/page_size", buffer_manager_->get_page_size());
+    status_reply.set_param("buffers/locked", buffer_manager_->get_locked());
+    status_reply.set_param("buffers/numa_node", buffer_manager_->get_numa_node());
+  }
+
+  // Add a histogram of the states of the buffers recorded in the shared buffer state table
+  if (buffer_manager_ && buffer_manager_->get_buffer_states())
+  {
+    std::vector<unsigned int> state_counts;
+    buffer_manager_->get_buffer_states()->get_state_counts(state_counts);
+    for (unsigned int state = 0; state < state_counts.size(); state++)
+    {
+      status_reply.set_param(std::string("buffers/states/") + SharedBufferStates::state_name(
+          static_cast<SharedBufferStates::State>(state)), state_counts[state]);
+    }
+  }
 
   status_reply.set_param("frames/timedout", frames_timedout);
-  status_reply.set_param("frames/received", frames_received_);
-  status_reply.set_param("frames/released", frames_released_);
+  status_reply.set_param("frames/received", this->get_frames_received());
+  status_reply.set_param("frames/released", this->get_frames_released());
+  status_reply.set_param("frames/notify_latency_mean_ns",
+      frames_notified_ ? notify_latency_total_ns_ / frames_notified_ : 0);
+  status_reply.set_param("frames/notify_latency_max_ns", notify_latency_max_ns_);
   status_reply.set_param("frames/dropped", frames_dropped);
 
+  ThreadPlacement::Instance().status(CONFIG_THREAD_PLACEMENT + "/", status_reply);
+
 }
 
 //! Get the frame receiver version information.
@@ -1191,6 +2129,11 @@ void FrameReceiverController::request_configuration(OdinData::IpcMessage& config
   config_reply.set_param(CONFIG_RX_ENDPOINT, config_.rx_channel_endpoint_);
   config_reply.set_param(CONFIG_FRAME_READY_ENDPOINT, config_.frame_ready_endpoint_);
   config_reply.set_param(CONFIG_FRAME_RELEASE_ENDPOINT, config_.frame_release_endpoint_);
+  config_reply.set_param(CONFIG_FRAME_NOTIFY_FORMAT,
+      FrameReceiverConfig::map_frame_notify_format_type_to_name(config_.frame_notify_format_));
+  config_reply.set_param(CONFIG_FRAME_NOTIFY_TRANSPORT,
+      FrameReceiverConfig::map_frame_notify_transport_type_to_name(config_.frame_notify_transport_));
+  config_reply.set_param(CONFIG_FRAME_NOTIFY_DIRECT, config_.frame_notify_direct_);
 
   // Add the decoder path and type to the reply parameters
   config_reply.set_param(CONFIG_DECODER_PATH, config_.decoder_path_);
@@ -1206,16 +2149,43 @@ void FrameReceiverController::request_configuration(OdinData::IpcMessage& config
   // Add the buffer manager configuration to the reply parameters
   config_reply.set_param(CONFIG_SHARED_BUFFER_NAME, config_.shared_buffer_name_);
   config_reply.set_param(CONFIG_MAX_BUFFER_MEM, config_.max_buffer_mem_);
+  config_reply.set_param(CONFIG_BUFFER_LEASE_TIMEOUT_MS, config_.buffer_lease_timeout_ms_);
+  config_reply.set_param(CONFIG_BUFFER_RECLAIM_EXITED, config_.buffer_reclaim_exited_);
+  config_reply.set_param(CONFIG_SHARED_BUFFER_HUGE_PAGE_SIZE, config_.shared_buffer_huge_page_size_);
+  config_reply.set_param(CONFIG_SHARED_BUFFER_PREFAULT, config_.shared_buffer_prefault_);
+  config_reply.set_param(CONFIG_SHARED_BUFFER_LOCK, config_.shared_buffer_lock_);
+  config_reply.set_param(CONFIG_SHARED_BUFFER_NUMA_NODE, config_.shared_buffer_numa_node_);
 
   // Add the RX thread configuration to the reply parameters
   config_reply.set_param(CONFIG_RX_TYPE, FrameReceiverConfig::map_rx_type_to_name(config_.rx_type_));
   config_reply.set_param(CONFIG_RX_ADDRESS, config_.rx_address_);
   config_reply.set_param(CONFIG_RX_PORTS, config_.rx_port_list());
   config_reply.set_param(CONFIG_RX_RECV_BUFFER_SIZE, config_.rx_recv_buffer_size_);
+  config_reply.set_param(CONFIG_RX_RECV_BATCH_SIZE, config_.rx_recv_batch_size_);
+  config_reply.set_param(CONFIG_RX_THREADS, config_.rx_threads_);
+  config_reply.set_param(CONFIG_RX_STEERING,
+      FrameReceiverConfig::map_rx_steering_type_to_name(config_.rx_steering_));
+  config_reply.set_param(CONFIG_RX_SPIN_MODE, config_.rx_spin_mode_);
+  config_reply.set_param(CONFIG_RX_SPIN_CHECK_INTERVAL, config_.rx_spin_check_interval_);
+  config_reply.set_param(CONFIG_RX_SPIN_IDLE_TIMEOUT_MS, config_.rx_spin_idle_timeout_ms_);
+  config_reply.set_param(CONFIG_RX_BUSY_POLL_US, config_.rx_busy_poll_us_);
+  config_reply.set_param(CONFIG_RX_PREFER_BUSY_POLL, config_.rx_prefer_busy_poll_);
+  config_reply.set_param(CONFIG_RX_UDP_GRO, config_.rx_udp_gro_);
+  config_reply.set_param(CONFIG_RX_RING_BLOCK_SIZE, config_.rx_ring_block_size_);
+  config_reply.set_param(CONFIG_RX_RING_BLOCK_TIMEOUT_MS, config_.rx_ring_block_timeout_ms_);
+  config_reply.set_param(CONFIG_RX_ENGINE,
+      FrameReceiverConfig::map_rx_engine_type_to_name(config_.rx_engine_));
+  config_reply.set_param(CONFIG_RX_URING_BUFFERS, config_.rx_uring_buffers_);
+  config_reply.set_param(CONFIG_RX_URING_BUFFER_SIZE, config_.rx_uring_buffer_size_);
+  config_reply.set_param(CONFIG_RX_TCP_MODE,
+      FrameReceiverConfig::map_rx_tcp_mode_type_to_name(config_.rx_tcp_mode_));
 
   // Add frame count to reply parameters
   config_reply.set_param(CONFIG_FRAME_COUNT, config_.frame_count_);
 
+  // Add the thread placement configuration to the reply parameters
+  ThreadPlacement::Instance().configuration(CONFIG_THREAD_PLACEMENT + "/", config_reply);
+
 }
 
 /**
@@ -1243,6 +2213,10 @@ void FrameReceiverController::execute(OdinData::IpcMessage& config, OdinData::Ip
       // Extract the command and execute on the decoder
       std::string command_name = sub_config.get_param<std::string>("command");
       frame_decoder_->execute(command_name, reply);
+      for (unsigned int thread_idx = 1; thread_idx < frame_decoders_.size(); thread_idx++)
+      {
+        frame_decoders_[thread_idx]->execute(command_name, reply);
+      }
     }
   }
   if (!command_present){
@@ -1280,14 +2254,26 @@ void FrameReceiverController::reset_statistics(OdinData::IpcMessage& reset_reply
   // Set the reply type to acknowledge
   reset_reply.set_msg_type(IpcMessage::MsgTypeAck);
 
-  // If a decoder is configured, call its reset method
+  // If a decoder is configured, call its reset method, along with that of the decoder for
+  // each additional RX thread
   if (frame_decoder_) {
     frame_decoder_->reset_statistics();
   }
+  for (unsigned int thread_idx = 1; thread_idx < frame_decoders_.size(); thread_idx++)
+  {
+    frame_decoders_[thread_idx]->reset_statistics();
+  }
 
-  // Reset frames recevied and released counters
+  // Reset frames recevied and released counters, including those of the RX threads
   frames_received_ = 0;
   frames_released_ = 0;
+  for (unsigned int thread_idx = 0; thread_idx < rx_threads_.size(); thread_idx++)
+  {
+    rx_threads_[thread_idx]->reset_direct_frame_counts();
+  }
+  frames_notified_ = 0;
+  notify_latency_total_ns_ = 0;
+  notify_latency_max_ns_ = 0;
 
 }
 
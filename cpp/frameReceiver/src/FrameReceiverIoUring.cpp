@@ -0,0 +1,374 @@
+/*!
+ * FrameReceiverIoUring.cpp - minimal io_uring instance for the RX thread receive engine
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "FrameReceiverIoUring.h"
+
+using namespace FrameReceiver;
+
+//! Set up an io_uring instance, returning the file descriptor or -errno on failure.
+static int io_uring_setup(unsigned int entries, struct io_uring_params* params)
+{
+  int ring_fd = (int)syscall(__NR_io_uring_setup, entries, params);
+  return (ring_fd < 0) ? -errno : ring_fd;
+}
+
+//! Submit and/or wait for io_uring operations, returning the number submitted or -errno.
+static int io_uring_enter(int ring_fd, unsigned int to_submit, unsigned int min_complete,
+    unsigned int flags)
+{
+  int rc = (int)syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, NULL, 0);
+  return (rc < 0) ? -errno : rc;
+}
+
+//! Register resources with an io_uring instance, returning zero or -errno on failure.
+static int io_uring_register(int ring_fd, unsigned int opcode, void* arg, unsigned int nr_args)
+{
+  int rc = (int)syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args);
+  return (rc < 0) ? -errno : rc;
+}
+
+//! Constructor for the FrameReceiverIoUring class.
+//!
+//! This constructor sets up the io_uring instance and maps its submission and completion queues.
+//! The completion queue is sized explicitly, since multishot receives can generate many more
+//! completions than there are submissions. The instance is created for a single issuing thread
+//! with deferred task running where the kernel supports it, so that completion work is only run
+//! when the thread waits for completions, falling back to the default mode on older kernels.
+//!
+//! \param[in] sq_entries - number of submission queue entries
+//! \param[in] cq_entries - number of completion queue entries
+//!
+FrameReceiverIoUring::FrameReceiverIoUring(unsigned int sq_entries, unsigned int cq_entries) :
+    ring_fd_(-1),
+    sq_ring_(MAP_FAILED),
+    sq_ring_size_(0),
+    cq_ring_(MAP_FAILED),
+    cq_ring_size_(0),
+    sqes_(0),
+    sqes_size_(0),
+    sq_pending_(0),
+    buf_ring_(0),
+    buf_ring_size_(0),
+    buf_mask_(0),
+    buf_tail_(0),
+    buffers_(0),
+    buffers_size_(0),
+    buffer_size_(0),
+    enter_calls_(0),
+    completions_(0)
+{
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+  params.cq_entries = cq_entries;
+
+  ring_fd_ = io_uring_setup(sq_entries, &params);
+  if (ring_fd_ == -EINVAL)
+  {
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = cq_entries;
+    ring_fd_ = io_uring_setup(sq_entries, &params);
+  }
+  if (ring_fd_ < 0)
+  {
+    std::stringstream ss;
+    ss << "Failed to set up io_uring: " << strerror(-ring_fd_);
+    ring_fd_ = -1;
+    throw FrameReceiverIoUringException(ss.str());
+  }
+
+  // Map the submission and completion queue rings, which share a single mapping if supported
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP)
+  {
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+  }
+
+  sq_ring_ = mmap(0, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+      ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED)
+  {
+    std::stringstream ss;
+    ss << "Failed to map io_uring submission queue: " << strerror(errno);
+    this->cleanup();
+    throw FrameReceiverIoUringException(ss.str());
+  }
+
+  if (params.features & IORING_FEAT_SINGLE_MMAP)
+  {
+    cq_ring_ = sq_ring_;
+  }
+  else
+  {
+    cq_ring_ = mmap(0, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        ring_fd_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED)
+    {
+      std::stringstream ss;
+      ss << "Failed to map io_uring completion queue: " << strerror(errno);
+      this->cleanup();
+      throw FrameReceiverIoUringException(ss.str());
+    }
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(0, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+      ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED)
+  {
+    std::stringstream ss;
+    ss << "Failed to map io_uring submission queue entries: " << strerror(errno);
+    this->cleanup();
+    throw FrameReceiverIoUringException(ss.str());
+  }
+  sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+  uint8_t* sq_ring = static_cast<uint8_t*>(sq_ring_);
+  sq_head_ = reinterpret_cast<unsigned int*>(sq_ring + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned int*>(sq_ring + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<unsigned int*>(sq_ring + params.sq_off.ring_mask);
+  sq_entries_ = *reinterpret_cast<unsigned int*>(sq_ring + params.sq_off.ring_entries);
+  sq_array_ = reinterpret_cast<unsigned int*>(sq_ring + params.sq_off.array);
+
+  uint8_t* cq_ring = static_cast<uint8_t*>(cq_ring_);
+  cq_head_ = reinterpret_cast<unsigned int*>(cq_ring + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned int*>(cq_ring + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<unsigned int*>(cq_ring + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq_ring + params.cq_off.cqes);
+}
+
+//! Destructor for the FrameReceiverIoUring class.
+//!
+//! Closing the io_uring file descriptor cancels any outstanding operations, after which the
+//! queues and provided buffers are unmapped.
+//!
+FrameReceiverIoUring::~FrameReceiverIoUring()
+{
+  this->cleanup();
+}
+
+//! Get a submission queue entry.
+//!
+//! This method returns the next free submission queue entry, cleared ready to be filled in by the
+//! caller. If the submission queue is full, the queued entries are submitted first.
+//!
+//! \return pointer to submission queue entry, or NULL if the kernel has not consumed enough
+//! queued entries to free one
+//!
+struct io_uring_sqe* FrameReceiverIoUring::get_sqe(void)
+{
+  if ((*sq_tail_ + sq_pending_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE)) >= sq_entries_)
+  {
+    this->submit_and_wait(0);
+    if ((*sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE)) >= sq_entries_)
+    {
+      return 0;
+    }
+  }
+
+  unsigned int tail = *sq_tail_ + sq_pending_;
+  unsigned int index = tail & sq_mask_;
+  struct io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  sq_pending_++;
+
+  return sqe;
+}
+
+//! Submit queued entries and wait for completions.
+//!
+//! This method publishes any queued submission queue entries to the kernel and waits for at least
+//! the specified number of completions, in a single system call.
+//!
+//! \param[in] wait_nr - minimum number of completions to wait for
+//! \return number of entries submitted, or -errno on failure (e.g. -EINTR)
+//!
+int FrameReceiverIoUring::submit_and_wait(unsigned int wait_nr)
+{
+  unsigned int to_submit = sq_pending_;
+  __atomic_store_n(sq_tail_, *sq_tail_ + to_submit, __ATOMIC_RELEASE);
+  sq_pending_ = 0;
+
+  unsigned int flags = (wait_nr > 0) ? IORING_ENTER_GETEVENTS : 0;
+  enter_calls_++;
+  return io_uring_enter(ring_fd_, to_submit, wait_nr, flags);
+}
+
+//! Peek at the next completion queue entry.
+//!
+//! \return pointer to the next completion queue entry, or NULL if there are none
+//!
+struct io_uring_cqe* FrameReceiverIoUring::peek_cqe(void)
+{
+  unsigned int head = *cq_head_;
+  if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE))
+  {
+    return 0;
+  }
+  return &cqes_[head & cq_mask_];
+}
+
+//! Mark the completion queue entry returned by peek_cqe as processed.
+//!
+void FrameReceiverIoUring::cqe_seen(void)
+{
+  __atomic_store_n(cq_head_, *cq_head_ + 1, __ATOMIC_RELEASE);
+  completions_++;
+}
+
+//! Register a ring of provided buffers.
+//!
+//! This method allocates a ring of equal sized buffers and registers it with the kernel as a
+//! buffer group, from which receive operations submitted with buffer selection take a buffer
+//! as each packet arrives. All buffers are initially made available to the kernel.
+//!
+//! \param[in] group_id - buffer group ID to register the buffers as
+//! \param[in] num_buffers - number of buffers, which must be a power of two no greater than 32768
+//! \param[in] buffer_size - size of each buffer in bytes
+//!
+void FrameReceiverIoUring::register_buffer_ring(uint16_t group_id, unsigned int num_buffers,
+    size_t buffer_size)
+{
+  if ((num_buffers == 0) || (num_buffers > 32768) || (num_buffers & (num_buffers - 1)))
+  {
+    std::stringstream ss;
+    ss << "Illegal number of io_uring provided buffers: " << num_buffers;
+    throw FrameReceiverIoUringException(ss.str());
+  }
+
+  buf_ring_size_ = num_buffers * sizeof(struct io_uring_buf);
+  void* buf_ring = mmap(0, buf_ring_size_, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+  if (buf_ring == MAP_FAILED)
+  {
+    std::stringstream ss;
+    ss << "Failed to allocate io_uring provided buffer ring: " << strerror(errno);
+    throw FrameReceiverIoUringException(ss.str());
+  }
+  buf_ring_ = static_cast<struct io_uring_buf*>(buf_ring);
+
+  buffers_size_ = num_buffers * buffer_size;
+  void* buffers = mmap(0, buffers_size_, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+  if (buffers == MAP_FAILED)
+  {
+    std::stringstream ss;
+    ss << "Failed to allocate io_uring provided buffers: " << strerror(errno);
+    throw FrameReceiverIoUringException(ss.str());
+  }
+  buffers_ = static_cast<uint8_t*>(buffers);
+
+  struct io_uring_buf_reg buf_reg;
+  memset(&buf_reg, 0, sizeof(buf_reg));
+  buf_reg.ring_addr = reinterpret_cast<uint64_t>(buf_ring_);
+  buf_reg.ring_entries = num_buffers;
+  buf_reg.bgid = group_id;
+
+  int rc = io_uring_register(ring_fd_, IORING_REGISTER_PBUF_RING, &buf_reg, 1);
+  if (rc < 0)
+  {
+    std::stringstream ss;
+    ss << "Failed to register io_uring provided buffer ring: " << strerror(-rc);
+    throw FrameReceiverIoUringException(ss.str());
+  }
+
+  buf_mask_ = num_buffers - 1;
+  buffer_size_ = buffer_size;
+
+  for (unsigned int buffer_id = 0; buffer_id < num_buffers; buffer_id++)
+  {
+    this->recycle_buffer(buffer_id);
+  }
+  this->publish_buffers();
+}
+
+//! Get the address of a provided buffer.
+//!
+//! \param[in] buffer_id - ID of the buffer, as reported in a completion
+//! \return address of the buffer
+//!
+uint8_t* FrameReceiverIoUring::get_buffer(uint16_t buffer_id) const
+{
+  return buffers_ + (buffer_id * buffer_size_);
+}
+
+//! Return a provided buffer to the ring.
+//!
+//! The buffer is queued locally and only made available to the kernel when the buffers are next
+//! published, so that a batch of buffers can be returned with a single tail update. The ring is
+//! addressed as an array of buffer entries rather than through struct io_uring_buf_ring, whose
+//! flexible array member is offset when compiled as C++. The first entry overlays the ring tail,
+//! so only the buffer fields are written.
+//!
+//! \param[in] buffer_id - ID of the buffer, as reported in a completion
+//!
+void FrameReceiverIoUring::recycle_buffer(uint16_t buffer_id)
+{
+  struct io_uring_buf* buf = &buf_ring_[buf_tail_ & buf_mask_];
+  buf->addr = reinterpret_cast<uint64_t>(this->get_buffer(buffer_id));
+  buf->len = buffer_size_;
+  buf->bid = buffer_id;
+  buf_tail_++;
+}
+
+//! Publish recycled provided buffers to the kernel.
+//!
+void FrameReceiverIoUring::publish_buffers(void)
+{
+  if (buf_ring_)
+  {
+    // The ring tail occupies the reserved field of the first buffer entry
+    __atomic_store_n(&(buf_ring_[0].resv), buf_tail_, __ATOMIC_RELEASE);
+  }
+}
+
+//! Release the resources of the io_uring instance.
+//!
+void FrameReceiverIoUring::cleanup(void)
+{
+  if (ring_fd_ >= 0)
+  {
+    close(ring_fd_);
+    ring_fd_ = -1;
+  }
+  if (sqes_)
+  {
+    munmap(sqes_, sqes_size_);
+    sqes_ = 0;
+  }
+  if ((cq_ring_ != MAP_FAILED) && (cq_ring_ != sq_ring_))
+  {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  cq_ring_ = MAP_FAILED;
+  if (sq_ring_ != MAP_FAILED)
+  {
+    munmap(sq_ring_, sq_ring_size_);
+    sq_ring_ = MAP_FAILED;
+  }
+  if (buf_ring_)
+  {
+    munmap(buf_ring_, buf_ring_size_);
+    buf_ring_ = 0;
+  }
+  if (buffers_)
+  {
+    munmap(buffers_, buffers_size_);
+    buffers_ = 0;
+  }
+}
@@ -0,0 +1,560 @@
+/*!
+ * FrameReceiverPacketRxThread.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifdef __linux__
+
+#include <unistd.h>
+#include <cstddef>
+#include <algorithm>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <linux/if_ether.h>
+#include <netinet/ip.h>
+#include <netinet/udp.h>
+#include <arpa/inet.h>
+#include <sys/mman.h>
+
+#include "FrameReceiverPacketRxThread.h"
+#include "gettime.h"
+
+using namespace FrameReceiver;
+
+//! Size of ring frames. TPACKET_V3 packs packets into blocks irrespective of the frame size, but
+//! the kernel requires the ring geometry to be specified in frames nonetheless.
+static const unsigned int ring_frame_size = 2048;
+
+//! Jump targets used while building socket filter programs, resolved once the program is complete
+enum FilterTarget
+{
+  FilterNext = -1,
+  FilterDrop = -2,
+  FilterAccept = -3
+};
+
+//! Construct a classic BPF statement for a socket filter program.
+static struct sock_filter bpf_stmt(uint16_t code, uint32_t k)
+{
+  struct sock_filter insn = BPF_STMT(code, k);
+  return insn;
+}
+
+//! Construct a classic BPF jump for a socket filter program, recording the jump targets for
+//! resolution once the program is complete.
+static struct sock_filter bpf_jump(uint16_t code, uint32_t k, int jt, int jf,
+    std::vector<std::pair<int, int> >& targets)
+{
+  struct sock_filter insn = BPF_JUMP(code, k, 0, 0);
+  targets.push_back(std::make_pair(jt, jf));
+  return insn;
+}
+
+FrameReceiverPacketRxThread::FrameReceiverPacketRxThread(FrameReceiverConfig& config,
+                                                         SharedBufferManagerPtr buffer_manager,
+                                                         FrameDecoderPtr frame_decoder,
+                                                         unsigned int tick_period_ms,
+                                                         unsigned int thread_index) :
+    FrameReceiverRxThread(config, buffer_manager, frame_decoder, tick_period_ms, thread_index),
+    logger_(log4cxx::Logger::getLogger("FR.PacketRxThread")),
+    steer_by_frame_((config.rx_steering_ == Defaults::RxSteeringFrame) && (config.rx_threads_ > 1)),
+    ring_socket_(-1),
+    ring_(NULL),
+    ring_size_(0),
+    block_size_(config.rx_ring_block_size_),
+    num_blocks_(0),
+    current_block_(0),
+    packets_received_(0),
+    packets_truncated_(0),
+    blocks_received_(0),
+    ring_drops_(0),
+    ring_freezes_(0),
+    rate_packets_(0),
+    packet_rate_(0.0)
+{
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "FrameReceiverPacketRxThread constructor entered....");
+
+  // Store the frame decoder as a UDP type frame decoder
+  frame_decoder_ = boost::dynamic_pointer_cast<FrameDecoderUDP>(frame_decoder);
+
+  // Size the ring from the configured receive buffer size, with at least two blocks so that
+  // the kernel can fill one block while the thread processes another
+  num_blocks_ = config.rx_recv_buffer_size_ / block_size_;
+  if (num_blocks_ < 2)
+  {
+    num_blocks_ = 2;
+  }
+
+  gettime(&rate_time_, true);
+}
+
+FrameReceiverPacketRxThread::~FrameReceiverPacketRxThread()
+{
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "Destroying FrameReceiverPacketRxThread....");
+  cleanup_specific_service();
+}
+
+void FrameReceiverPacketRxThread::run_specific_service(void)
+{
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "Running packet RX thread service");
+
+  if (!frame_decoder_)
+  {
+    this->set_thread_init_error("Packet RX thread requires a UDP frame decoder");
+    return;
+  }
+
+  struct in_addr rx_addr;
+  if (!inet_aton(config_.rx_address_.c_str(), &rx_addr))
+  {
+    std::stringstream ss;
+    ss << "Illegal receive address specified: " << config_.rx_address_;
+    this->set_thread_init_error(ss.str());
+    return;
+  }
+
+  int if_index = 0;
+  if (!this->resolve_interface(rx_addr.s_addr, if_index))
+  {
+    std::stringstream ss;
+    ss << "Packet RX thread cannot find an interface with receive address " << config_.rx_address_;
+    this->set_thread_init_error(ss.str());
+    return;
+  }
+
+  // Create the packet socket, which receives packets with the link layer header removed. No
+  // protocol is given, so that nothing is received until the socket is bound once set up. The
+  // socket is registered immediately so that it is closed on exit, even if setup fails.
+  ring_socket_ = socket(AF_PACKET, SOCK_DGRAM, 0);
+  if (ring_socket_ < 0)
+  {
+    std::stringstream ss;
+    ss << "RX channel failed to create packet socket : " << strerror(errno);
+    this->set_thread_init_error(ss.str());
+    return;
+  }
+  this->register_socket(ring_socket_, boost::bind(&FrameReceiverPacketRxThread::handle_ring, this));
+
+  // Attach the filter passing only UDP packets for the receive ports
+  this->build_port_filter(rx_addr.s_addr);
+  struct sock_fprog port_prog;
+  port_prog.len = port_filter_.size();
+  port_prog.filter = &port_filter_[0];
+  if (setsockopt(ring_socket_, SOL_SOCKET, SO_ATTACH_FILTER, &port_prog, sizeof(port_prog)) < 0)
+  {
+    std::stringstream ss;
+    ss << "RX channel failed to attach packet socket filter : " << strerror(errno);
+    this->set_thread_init_error(ss.str());
+    return;
+  }
+
+  // Set up and map the TPACKET_V3 receive ring
+  int version = TPACKET_V3;
+  if (setsockopt(ring_socket_, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+  {
+    std::stringstream ss;
+    ss << "RX channel failed to set packet socket version : " << strerror(errno);
+    this->set_thread_init_error(ss.str());
+    return;
+  }
+
+  struct tpacket_req3 ring_req;
+  memset(&ring_req, 0, sizeof(ring_req));
+  ring_req.tp_block_size = block_size_;
+  ring_req.tp_block_nr = num_blocks_;
+  ring_req.tp_frame_size = ring_frame_size;
+  ring_req.tp_frame_nr = (block_size_ / ring_frame_size) * num_blocks_;
+  ring_req.tp_retire_blk_tov = config_.rx_ring_block_timeout_ms_;
+  if (setsockopt(ring_socket_, SOL_PACKET, PACKET_RX_RING, &ring_req, sizeof(ring_req)) < 0)
+  {
+    std::stringstream ss;
+    ss << "RX channel failed to create receive ring of " << num_blocks_ << " blocks of "
+       << block_size_ << " bytes : " << strerror(errno);
+    this->set_thread_init_error(ss.str());
+    return;
+  }
+
+  ring_size_ = (size_t)block_size_ * num_blocks_;
+  void* ring = mmap(NULL, ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+      ring_socket_, 0);
+  if (ring == MAP_FAILED)
+  {
+    ring_size_ = 0;
+    std::stringstream ss;
+    ss << "RX channel failed to map receive ring : " << strerror(errno);
+    this->set_thread_init_error(ss.str());
+    return;
+  }
+  ring_ = reinterpret_cast<uint8_t*>(ring);
+  current_block_ = 0;
+
+  // Bind the socket to receive IP packets on the interface, or on all interfaces if receiving
+  // on any address
+  struct sockaddr_ll bind_addr;
+  memset(&bind_addr, 0, sizeof(bind_addr));
+  bind_addr.sll_family = AF_PACKET;
+  bind_addr.sll_protocol = htons(ETH_P_IP);
+  bind_addr.sll_ifindex = if_index;
+  if (bind(ring_socket_, (struct sockaddr*)&bind_addr, sizeof(bind_addr)) < 0)
+  {
+    std::stringstream ss;
+    ss << "RX channel failed to bind packet socket for address " << config_.rx_address_
+       << " : " << strerror(errno);
+    this->set_thread_init_error(ss.str());
+    return;
+  }
+
+  // If steering packets to RX threads by frame number, join the fanout group shared by the RX
+  // threads and attach the program selecting the socket in the group from the frame number.
+  // Sockets are indexed in the group in the order they join, which follows the order the RX
+  // threads are started in, so each packet is received by the thread whose index matches.
+  if (steer_by_frame_)
+  {
+    if (!this->build_fanout_filter())
+    {
+      this->set_thread_init_error(
+          "RX channel cannot steer packets by frame: decoder does not specify frame number field");
+      return;
+    }
+
+    int fanout_arg = (getpid() & 0xffff) | (PACKET_FANOUT_CBPF << 16);
+    if (setsockopt(ring_socket_, SOL_PACKET, PACKET_FANOUT, &fanout_arg, sizeof(fanout_arg)) < 0)
+    {
+      std::stringstream ss;
+      ss << "RX channel failed to join packet fanout group : " << strerror(errno);
+      this->set_thread_init_error(ss.str());
+      return;
+    }
+
+    struct sock_fprog fanout_prog;
+    fanout_prog.len = fanout_filter_.size();
+    fanout_prog.filter = &fanout_filter_[0];
+    if (setsockopt(ring_socket_, SOL_PACKET, PACKET_FANOUT_DATA, &fanout_prog, sizeof(fanout_prog)) < 0)
+    {
+      std::stringstream ss;
+      ss << "RX channel failed to attach packet fanout steering program : " << strerror(errno);
+      this->set_thread_init_error(ss.str());
+      return;
+    }
+    LOG4CXX_DEBUG_LEVEL(1, logger_, "Packet RX thread " << thread_index_
+      << " steering packets by frame number across " << config_.rx_threads_ << " RX threads");
+  }
+
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "Packet RX thread receiving on " << rx_ports_.size()
+    << " ports into ring of " << num_blocks_ << " blocks of " << block_size_ << " bytes");
+}
+
+void FrameReceiverPacketRxThread::cleanup_specific_service(void)
+{
+  if (ring_)
+  {
+    munmap(ring_, ring_size_);
+    ring_ = NULL;
+    ring_size_ = 0;
+  }
+}
+
+//! Resolve the index of the interface to receive on.
+//!
+//! This method finds the interface to which the receive address is assigned, since packet
+//! sockets are bound to interfaces rather than addresses. Receiving on any address binds the
+//! socket to all interfaces, indicated by an index of zero.
+//!
+//! \param[in] rx_addr - receive address in network byte order
+//! \param[out] if_index - index of the interface
+//! \return true if the interface was found
+//!
+bool FrameReceiverPacketRxThread::resolve_interface(in_addr_t rx_addr, int& if_index)
+{
+  if_index = 0;
+  if (rx_addr == htonl(INADDR_ANY))
+  {
+    return true;
+  }
+
+  struct ifaddrs* if_addrs;
+  if (getifaddrs(&if_addrs) < 0)
+  {
+    return false;
+  }
+  for (struct ifaddrs* ifa = if_addrs; ifa != NULL; ifa = ifa->ifa_next)
+  {
+    if (ifa->ifa_addr && (ifa->ifa_addr->sa_family == AF_INET) &&
+        (((struct sockaddr_in*)ifa->ifa_addr)->sin_addr.s_addr == rx_addr))
+    {
+      if_index = if_nametoindex(ifa->ifa_name);
+      break;
+    }
+  }
+  freeifaddrs(if_addrs);
+
+  return (if_index > 0);
+}
+
+//! Build the packet socket filter.
+//!
+//! This method builds a classic BPF program passing only unfragmented UDP packets destined for
+//! the receive address, unless receiving on any address, and one of the receive ports serviced by
+//! this thread. The kernel runs the program with the IP header at offset zero, since the socket
+//! receives packets with the link layer header removed.
+//!
+//! \param[in] rx_addr - receive address in network byte order
+//!
+void FrameReceiverPacketRxThread::build_port_filter(in_addr_t rx_addr)
+{
+  std::vector<std::pair<int, int> > targets;
+  port_filter_.clear();
+
+  // Check the IP protocol is UDP and the packet is not a fragment
+  port_filter_.push_back(bpf_stmt(BPF_LD | BPF_B | BPF_ABS, offsetof(struct iphdr, protocol)));
+  targets.push_back(std::make_pair(FilterNext, FilterNext));
+  port_filter_.push_back(bpf_jump(BPF_JMP | BPF_JEQ | BPF_K, IPPROTO_UDP, FilterNext, FilterDrop, targets));
+  port_filter_.push_back(bpf_stmt(BPF_LD | BPF_H | BPF_ABS, offsetof(struct iphdr, frag_off)));
+  targets.push_back(std::make_pair(FilterNext, FilterNext));
+  port_filter_.push_back(bpf_jump(BPF_JMP | BPF_JSET | BPF_K, IP_MF | IP_OFFMASK, FilterDrop, FilterNext, targets));
+
+  // Check the destination address if receiving on a specific address
+  if (rx_addr != htonl(INADDR_ANY))
+  {
+    port_filter_.push_back(bpf_stmt(BPF_LD | BPF_W | BPF_ABS, offsetof(struct iphdr, daddr)));
+    targets.push_back(std::make_pair(FilterNext, FilterNext));
+    port_filter_.push_back(bpf_jump(BPF_JMP | BPF_JEQ | BPF_K, ntohl(rx_addr), FilterNext, FilterDrop, targets));
+  }
+
+  // Load the IP header length and check the UDP destination port against each receive port
+  port_filter_.push_back(bpf_stmt(BPF_LDX | BPF_B | BPF_MSH, 0));
+  targets.push_back(std::make_pair(FilterNext, FilterNext));
+  port_filter_.push_back(bpf_stmt(BPF_LD | BPF_H | BPF_IND, offsetof(struct udphdr, dest)));
+  targets.push_back(std::make_pair(FilterNext, FilterNext));
+  for (std::vector<uint16_t>::iterator rx_port_itr = rx_ports_.begin();
+      rx_port_itr != rx_ports_.end(); ++rx_port_itr)
+  {
+    port_filter_.push_back(bpf_jump(BPF_JMP | BPF_JEQ | BPF_K, *rx_port_itr, FilterAccept, FilterNext, targets));
+  }
+
+  // Drop or accept the whole packet
+  int drop_idx = port_filter_.size();
+  port_filter_.push_back(bpf_stmt(BPF_RET | BPF_K, 0));
+  targets.push_back(std::make_pair(FilterNext, FilterNext));
+  int accept_idx = port_filter_.size();
+  port_filter_.push_back(bpf_stmt(BPF_RET | BPF_K, 0xffffffff));
+  targets.push_back(std::make_pair(FilterNext, FilterNext));
+
+  // Resolve the jump targets into offsets relative to the following instruction
+  for (int idx = 0; idx < (int)port_filter_.size(); idx++)
+  {
+    if (BPF_CLASS(port_filter_[idx].code) != BPF_JMP)
+    {
+      continue;
+    }
+    int jt = targets[idx].first == FilterDrop ? drop_idx :
+        (targets[idx].first == FilterAccept ? accept_idx : idx + 1);
+    int jf = targets[idx].second == FilterDrop ? drop_idx :
+        (targets[idx].second == FilterAccept ? accept_idx : idx + 1);
+    port_filter_[idx].jt = jt - idx - 1;
+    port_filter_[idx].jf = jf - idx - 1;
+  }
+}
+
+//! Build the packet fanout steering program.
+//!
+//! This method builds a classic BPF program that selects the socket in the fanout group for each
+//! packet from its frame number, so that all packets of a frame are received by the same RX
+//! thread and decoder. The kernel runs the program with the IP header at offset zero, so the
+//! frame number field is located relative to the start of the UDP payload using the IP header
+//! length. The field is assembled a byte at a time in scratch memory, which allows for either
+//! byte order, and the program returns the frame number modulo the number of RX threads.
+//!
+//! \return true if the program was built, false if the decoder does not describe the field
+//!
+bool FrameReceiverPacketRxThread::build_fanout_filter(void)
+{
+  FrameNumberField field;
+  if (!frame_decoder_->get_frame_number_field(field) || (field.width < 1) || (field.width > 4))
+  {
+    return false;
+  }
+
+  fanout_filter_.clear();
+  fanout_filter_.push_back(bpf_stmt(BPF_LDX | BPF_B | BPF_MSH, 0));
+  for (size_t byte_idx = 0; byte_idx < field.width; byte_idx++)
+  {
+    // Load the bytes of the field from most to least significant, shifting the accumulated
+    // value up before OR-ing in each subsequent byte. The index register holding the IP
+    // header length is restored after each OR.
+    size_t byte_offset = sizeof(struct udphdr) + field.offset +
+        (field.big_endian ? byte_idx : (field.width - 1 - byte_idx));
+    if (byte_idx > 0)
+    {
+      fanout_filter_.push_back(bpf_stmt(BPF_ST, 0));
+    }
+    fanout_filter_.push_back(bpf_stmt(BPF_LD | BPF_B | BPF_IND, byte_offset));
+    if (byte_idx > 0)
+    {
+      fanout_filter_.push_back(bpf_stmt(BPF_ST, 1));
+      fanout_filter_.push_back(bpf_stmt(BPF_LD | BPF_MEM, 0));
+      fanout_filter_.push_back(bpf_stmt(BPF_ALU | BPF_LSH | BPF_K, 8));
+      fanout_filter_.push_back(bpf_stmt(BPF_LDX | BPF_MEM, 1));
+      fanout_filter_.push_back(bpf_stmt(BPF_ALU | BPF_OR | BPF_X, 0));
+      fanout_filter_.push_back(bpf_stmt(BPF_LDX | BPF_B | BPF_MSH, 0));
+    }
+  }
+  fanout_filter_.push_back(bpf_stmt(BPF_ALU | BPF_MOD | BPF_K, config_.rx_threads_));
+  fanout_filter_.push_back(bpf_stmt(BPF_RET | BPF_A, 0));
+
+  return true;
+}
+
+//! Handle a receive event on the packet socket.
+//!
+//! This method is the handler registered with the reactor for the packet socket and is called
+//! when the socket becomes readable, i.e. when the kernel has retired one or more blocks of the
+//! ring to user space. Each retired block is processed in turn and handed back to the kernel.
+//!
+void FrameReceiverPacketRxThread::handle_ring(void)
+{
+  if (!ring_)
+  {
+    return;
+  }
+
+  while (true)
+  {
+    struct tpacket_block_desc* block =
+        reinterpret_cast<struct tpacket_block_desc*>(ring_ + ((size_t)current_block_ * block_size_));
+    if (!(block->hdr.bh1.block_status & TP_STATUS_USER))
+    {
+      break;
+    }
+
+    this->process_block(block);
+
+    // Ensure the block contents have been consumed before handing the block back to the kernel
+    __sync_synchronize();
+    block->hdr.bh1.block_status = TP_STATUS_KERNEL;
+
+    current_block_ = (current_block_ + 1) % num_blocks_;
+    blocks_received_++;
+  }
+}
+
+//! Process a block of the receive ring.
+//!
+//! \param[in] block - pointer to the block descriptor
+//!
+void FrameReceiverPacketRxThread::process_block(struct tpacket_block_desc* block)
+{
+  uint32_t num_packets = block->hdr.bh1.num_pkts;
+  struct tpacket3_hdr* packet_hdr = reinterpret_cast<struct tpacket3_hdr*>(
+      reinterpret_cast<uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt);
+
+  LOG4CXX_DEBUG_LEVEL(3, logger_, "Packet RX thread processing block " << current_block_
+    << " containing " << num_packets << " packets");
+
+  for (uint32_t pkt = 0; pkt < num_packets; pkt++)
+  {
+    this->process_packet(packet_hdr);
+    packet_hdr = reinterpret_cast<struct tpacket3_hdr*>(
+        reinterpret_cast<uint8_t*>(packet_hdr) + packet_hdr->tp_next_offset);
+  }
+}
+
+//! Process a packet in the receive ring.
+//!
+//! This method locates the UDP header and payload of a packet in the ring and passes the payload to
+//! the frame decoder as a single-packet run, which copies the packet header into the decoder
+//! header buffer if required, then copies the payload directly into the payload buffer given by
+//! the decoder.
+//!
+//! \param[in] packet_hdr - pointer to the ring packet header
+//!
+void FrameReceiverPacketRxThread::process_packet(struct tpacket3_hdr* packet_hdr)
+{
+  // Ignore packets sent from this host, which packet sockets can also see
+  struct sockaddr_ll* link_addr = reinterpret_cast<struct sockaddr_ll*>(
+      reinterpret_cast<uint8_t*>(packet_hdr) + TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+  if (link_addr->sll_pkttype == PACKET_OUTGOING)
+  {
+    return;
+  }
+
+  const uint8_t* ip_packet = reinterpret_cast<uint8_t*>(packet_hdr) + packet_hdr->tp_net;
+  size_t packet_len = packet_hdr->tp_snaplen;
+  const struct iphdr* ip_hdr = reinterpret_cast<const struct iphdr*>(ip_packet);
+  size_t ip_hdr_len = (packet_len >= sizeof(struct iphdr)) ? (ip_hdr->ihl * 4) : packet_len;
+  if ((ip_hdr_len < sizeof(struct iphdr)) || (packet_len < ip_hdr_len + sizeof(struct udphdr)))
+  {
+    packets_truncated_++;
+    return;
+  }
+
+  const struct udphdr* udp_hdr = reinterpret_cast<const struct udphdr*>(ip_packet + ip_hdr_len);
+  size_t udp_len = ntohs(udp_hdr->len);
+  if ((udp_len < sizeof(struct udphdr)) || (ip_hdr_len + udp_len > packet_len))
+  {
+    packets_truncated_++;
+    return;
+  }
+
+  const uint8_t* payload = ip_packet + ip_hdr_len + sizeof(struct udphdr);
+  size_t payload_len = udp_len - sizeof(struct udphdr);
+  int recv_port = ntohs(udp_hdr->dest);
+
+  struct sockaddr_in from_addr;
+  memset(&from_addr, 0, sizeof(from_addr));
+  from_addr.sin_family = AF_INET;
+  from_addr.sin_port = udp_hdr->source;
+  from_addr.sin_addr.s_addr = ip_hdr->saddr;
+
+  packets_received_ += frame_decoder_->process_packet_run(
+      payload, payload_len, payload_len, recv_port, &from_addr);
+}
+
+//! Fill packet receiver specific status parameters into a message.
+//!
+//! This method adds packet receiver status parameters to the status message, including the
+//! number of packets and ring blocks received, the current packet receive rate, which is
+//! calculated over the interval since the previous status update, and the number of packets
+//! dropped by the kernel because the ring was full.
+//!
+//! \param[in,out] status_msg - IpcMessage to fill with status parameters
+//!
+void FrameReceiverPacketRxThread::fill_specific_status_params(IpcMessage& status_msg)
+{
+  struct timespec now;
+  gettime(&now, true);
+
+  unsigned int elapsed = elapsed_us(rate_time_, now);
+  if (elapsed > 0)
+  {
+    packet_rate_ = (double)(packets_received_ - rate_packets_) * 1000000.0 / elapsed;
+    rate_packets_ = packets_received_;
+    rate_time_ = now;
+  }
+
+  // Reading the socket statistics resets them, so accumulate them
+  if (ring_socket_ >= 0)
+  {
+    struct tpacket_stats_v3 ring_stats;
+    socklen_t stats_len = sizeof(ring_stats);
+    if (getsockopt(ring_socket_, SOL_PACKET, PACKET_STATISTICS, &ring_stats, &stats_len) == 0)
+    {
+      ring_drops_ += ring_stats.tp_drops;
+      ring_freezes_ += ring_stats.tp_freeze_q_cnt;
+    }
+  }
+
+  double packets_per_block = blocks_received_ ? ((double)packets_received_ / blocks_received_) : 0.0;
+
+  status_msg.set_param("rx_thread/packets_received", packets_received_);
+  status_msg.set_param("rx_thread/packets_truncated", packets_truncated_);
+  status_msg.set_param("rx_thread/blocks_received", blocks_received_);
+  status_msg.set_param("rx_thread/packets_per_block", packets_per_block);
+  status_msg.set_param("rx_thread/packet_rate", packet_rate_);
+  status_msg.set_param("rx_thread/ring_drops", ring_drops_);
+  status_msg.set_param("rx_thread/ring_freezes", ring_freezes_);
+}
+
+#endif /* __linux__ */
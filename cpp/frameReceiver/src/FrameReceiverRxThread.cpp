@@ -5,6 +5,11 @@
  *      Author: Tim Nicholls, STFC Application Engineering Group
  */
 
+#include <algorithm>
+#include <cerrno>
+#include <poll.h>
+#include <signal.h>
+
 #include "FrameReceiverRxThread.h"
 
 #ifdef BOOST_HAS_PLACEHOLDERS
@@ -16,22 +21,58 @@ using namespace FrameReceiver;
 //! Constructor for the FrameReceiverRxThread class.
 //!
 //! This constructor initialises the member variables of the class. Startup of the thread
-//! itself is deferred to the start() method.
+//! itself is deferred to the start() method. When multiple RX threads are configured, the
+//! thread index determines which of the configured receive ports this thread services, unless
+//! packets are steered to threads by frame number, in which case all threads service all ports.
 //!
 FrameReceiverRxThread::FrameReceiverRxThread(FrameReceiverConfig& config,
                                              SharedBufferManagerPtr buffer_manager,
                                              FrameDecoderPtr frame_decoder,
-                                             unsigned int tick_period_ms) :
+                                             unsigned int tick_period_ms,
+                                             unsigned int thread_index) :
     config_(config),
+    thread_index_(thread_index),
     logger_(log4cxx::Logger::getLogger("FR.RxThread")),
     buffer_manager_(buffer_manager),
     frame_decoder_(frame_decoder),
     tick_period_ms_(tick_period_ms),
+    binary_notify_(config.frame_notify_format_ == Defaults::FrameNotifyFormatBinary),
+    monitoring_buffers_(false),
+    frame_rings_(NULL),
+    ring_frames_ready_(0),
+    ring_frames_released_(0),
+    ring_full_(0),
+    buffer_states_(NULL),
+    buffers_reclaimed_(0),
+    releases_refused_(0),
+    buffers_released_(0),
+    release_latency_total_ns_(0),
+    release_latency_max_ns_(0),
+    direct_frames_ready_(0),
+    direct_frames_released_(0),
+    frames_notified_(0),
+    notify_latency_total_ns_(0),
+    notify_latency_max_ns_(0),
     rx_channel_(ZMQ_DEALER),
     run_thread_(true),
     thread_running_(false),
     thread_init_error_(false)
 {
+  // Select the subset of configured receive ports serviced by this thread. Ports are
+  // distributed across the configured number of RX threads in round-robin order.
+  if (config_.rx_steering_ == Defaults::RxSteeringFrame)
+  {
+    rx_ports_ = config_.rx_ports_;
+  }
+  else
+  {
+    unsigned int num_threads = config_.rx_threads_ ? config_.rx_threads_ : 1;
+    for (std::size_t port_idx = thread_index_; port_idx < config_.rx_ports_.size();
+        port_idx += num_threads)
+    {
+      rx_ports_.push_back(config_.rx_ports_[port_idx]);
+    }
+  }
 }
 
 //! Destructor for the FrameReceiverRxThread.
@@ -115,6 +156,12 @@ void FrameReceiverRxThread::run_service(void)
   // Configure thread-specific logging parameters
   OdinData::configure_logging_mdc(OdinData::app_path.c_str());
 
+  // Register the thread for placement before any receive resources are allocated, so that memory
+  // is allocated according to the NUMA policy of the thread
+  std::stringstream thread_name;
+  thread_name << "rx_thread_" << thread_index_;
+  std::string placement_name = OdinData::ThreadPlacement::Instance().register_thread(thread_name.str());
+
   // Connect the message channel to the main thread
   try
   {
@@ -128,6 +175,7 @@ void FrameReceiverRxThread::run_service(void)
     ss << "RX channel connect to endpoint " << config_.rx_channel_endpoint_ 
       << " failed: " << e.what();
     this->set_thread_init_error(ss.str());
+    OdinData::ThreadPlacement::Instance().unregister_thread(placement_name);
     return;
   }
 
@@ -135,6 +183,40 @@ void FrameReceiverRxThread::run_service(void)
   reactor_.register_channel(rx_channel_, 
     boost::bind(&FrameReceiverRxThread::handle_rx_channel, this));
 
+  // Create the io_uring instance if the io_uring engine is selected, before the specific service
+  // setup submits its receive operations. The completion queue is sized to hold a completion for
+  // every provided receive buffer.
+  if (config_.rx_engine_ == Defaults::RxEngineIoUring)
+  {
+#ifdef HAVE_IO_URING
+    try
+    {
+      uring_.reset(new FrameReceiverIoUring(Defaults::default_rx_uring_sq_entries,
+          config_.rx_uring_buffers_ * 2));
+    }
+    catch (FrameReceiverIoUringException& e)
+    {
+      this->set_thread_init_error(e.what());
+      reactor_.remove_channel(rx_channel_);
+      rx_channel_.close();
+      OdinData::ThreadPlacement::Instance().unregister_thread(placement_name);
+      return;
+    }
+#else
+    this->set_thread_init_error("The io_uring RX engine is not supported on this platform");
+    reactor_.remove_channel(rx_channel_);
+    rx_channel_.close();
+    OdinData::ThreadPlacement::Instance().unregister_thread(placement_name);
+    return;
+#endif
+  }
+
+  // Size the table of buffer ready times used to measure release latency
+  buffer_ready_time_ns_.assign(buffer_manager_->get_num_buffers(), 0);
+
+  // Record buffer state transitions in the shared buffer state table, if present
+  buffer_states_ = buffer_manager_->get_buffer_states();
+
   // Run the specific service setup implemented in subclass
   run_specific_service();
 
@@ -150,9 +232,30 @@ void FrameReceiverRxThread::run_service(void)
   frame_decoder_->register_frame_ready_callback(
     boost::bind(&FrameReceiverRxThread::frame_ready, this, _1, _2));
 
+  // If frame notifications are passed through rings in the shared buffer, use the ring pair for
+  // this thread and add a timer to drain its release ring. Releases are also drained as frames
+  // become ready, so the timer only matters while no frames are being received.
+  int frame_ring_timer_id = -1;
+  if ((config_.frame_notify_transport_ == Defaults::FrameNotifyTransportSharedMemory) &&
+      buffer_manager_->get_frame_rings() &&
+      (thread_index_ < buffer_manager_->get_frame_rings()->get_num_rings()))
+  {
+    frame_rings_ = buffer_manager_->get_frame_rings();
+    frame_ring_timer_id = reactor_.register_timer(Defaults::default_frame_ring_poll_ms, 0,
+      boost::bind(&FrameReceiverRxThread::frame_ring_timer, this));
+  }
+
+  // If the frame ready and release channels are owned directly by the RX thread, rather than
+  // notifications being relayed by the main thread, bind them to the external endpoints
+  if (config_.frame_notify_direct_ && (thread_index_ == 0) && !thread_init_error_)
+  {
+    this->setup_frame_notify_channels();
+  }
+
   // If there was any prior error setting the thread up, return
   if (thread_init_error_)
   {
+    OdinData::ThreadPlacement::Instance().unregister_thread(placement_name);
     return;
   }
 
@@ -167,13 +270,39 @@ void FrameReceiverRxThread::run_service(void)
     this->request_buffer_precharge();
   }
 
-  // Run the reactor event loop
-  reactor_.run();
+  // Notify downstream processes of the shared buffer configuration if owning the ready channel
+  if (frame_ready_channel_)
+  {
+    this->notify_buffer_config();
+  }
+
+  // Run the event loop
+  this->run_event_loop();
 
-  // Cleanup - remove channels, sockets and timers from the reactor and close the receive socket
+  // Cleanup - tear down any io_uring instance, cancelling outstanding operations, remove channels,
+  // sockets and timers from the reactor and close the receive socket
+#ifdef HAVE_IO_URING
+  uring_.reset();
+#endif
   reactor_.remove_channel(rx_channel_);
   reactor_.remove_timer(tick_timer_id);
   reactor_.remove_timer(buffer_monitor_timer_id);
+  if (frame_ring_timer_id != -1)
+  {
+    reactor_.remove_timer(frame_ring_timer_id);
+  }
+  frame_rings_ = NULL;
+  if (frame_release_channel_)
+  {
+    reactor_.remove_channel(*frame_release_channel_);
+    frame_release_channel_->close();
+    frame_release_channel_.reset();
+  }
+  if (frame_ready_channel_)
+  {
+    frame_ready_channel_->close();
+    frame_ready_channel_.reset();
+  }
 
   for (std::vector<int>::iterator recv_sock_it = recv_sockets_.begin(); 
         recv_sock_it != recv_sockets_.end(); recv_sock_it++)
@@ -184,6 +313,8 @@ void FrameReceiverRxThread::run_service(void)
   recv_sockets_.clear();
   rx_channel_.close();
 
+  OdinData::ThreadPlacement::Instance().unregister_thread(placement_name);
+
   LOG4CXX_DEBUG_LEVEL(1, logger_, "Terminating RX thread service");
 
 }
@@ -192,12 +323,14 @@ void FrameReceiverRxThread::run_service(void)
 //!
 //! This method advertises the identity of the RX thread endpoint on the channel 
 //! communicating with the main thread. This allows the main thread to correctly route
-//! messages to the RX thread over the ROUTER-DEALER channel.
+//! messages to the RX thread over the ROUTER-DEALER channel. The thread index is included
+//! so that the main thread can distinguish between multiple RX threads.
 //!
 void FrameReceiverRxThread::advertise_identity(void)
 {
   LOG4CXX_DEBUG_LEVEL(3, logger_, "Advertising RX thread identity");
   IpcMessage identity_msg(IpcMessage::MsgTypeNotify, IpcMessage::MsgValNotifyIdentity);
+  identity_msg.set_param("thread_index", thread_index_);
 
   rx_channel_.send(identity_msg.encode());
 }
@@ -226,6 +359,13 @@ void FrameReceiverRxThread::handle_rx_channel(void)
   // Receive a message from the main thread channel
   std::string rx_msg_encoded = rx_channel_.recv();
 
+  // Handle single or batched binary frame release notifications without decoding as JSON
+  if (FrameNotification::is_binary_batch(rx_msg_encoded))
+  {
+    this->release_buffers(rx_msg_encoded);
+    return;
+  }
+
   // Decode the message and handle appropriately
   try {
 
@@ -285,6 +425,7 @@ void FrameReceiverRxThread::handle_rx_channel(void)
           {
             int start_buffer_id = rx_msg.get_param<int>("start_buffer_id", -1);
             int num_buffers = rx_msg.get_param<int>("num_buffers", -1);
+            unsigned int pool = rx_msg.get_param<unsigned int>("pool", 0);
 
             if ((start_buffer_id == -1) || (num_buffers == -1))
             {
@@ -294,29 +435,20 @@ void FrameReceiverRxThread::handle_rx_channel(void)
             {
               for (int buffer_id = start_buffer_id; buffer_id < start_buffer_id + num_buffers; buffer_id++)
               {
+                if (buffer_states_)
+                {
+                  buffer_states_->set_free(buffer_id, thread_index_);
+                }
                 frame_decoder_->push_empty_buffer(buffer_id);
               }
-              LOG4CXX_DEBUG_LEVEL(1, logger_, "Precharged " << num_buffers << " empty buffers onto queue, "
-                << "length is now " << frame_decoder_->get_num_empty_buffers());
+              LOG4CXX_DEBUG_LEVEL(1, logger_, "Precharged " << num_buffers << " empty buffers from pool "
+                << pool << " onto queue, length is now " << frame_decoder_->get_num_empty_buffers());
             }
           }
           break;
 
         case IpcMessage::MsgValNotifyFrameRelease:
-          {
-            
-            int buffer_id = rx_msg.get_param<int>("buffer_id", -1);      
-            if (buffer_id != -1)
-            {
-              frame_decoder_->push_empty_buffer(buffer_id);
-              LOG4CXX_DEBUG_LEVEL(3, logger_, "Added empty buffer ID " << buffer_id 
-                << " to queue, length is now " << frame_decoder_->get_num_empty_buffers());
-            }
-            else
-            {
-              LOG4CXX_ERROR(logger_, "RX thread received empty frame notification with buffer ID");
-            }
-          }
+          this->release_buffers(rx_msg);
           break;
 
         default:
@@ -343,6 +475,142 @@ void FrameReceiverRxThread::handle_rx_channel(void)
   }
 }
 
+//! Service all pending messages on the RX channel.
+//!
+//! This method handles all messages pending on the RX channel from the main thread. It is used
+//! by the io_uring event loop, where the channel notification descriptor is edge-triggered and
+//! can also be reset by sending on the channel, so the channel event state must be checked
+//! directly and drained rather than relying on the descriptor becoming readable.
+//!
+void FrameReceiverRxThread::service_rx_channel(void)
+{
+  int events = 0;
+  size_t events_size = sizeof(events);
+  rx_channel_.getsockopt(ZMQ_EVENTS, &events, &events_size);
+  while (events & ZMQ_POLLIN)
+  {
+    this->handle_rx_channel();
+    rx_channel_.getsockopt(ZMQ_EVENTS, &events, &events_size);
+  }
+}
+
+//! Set up the frame ready and release channels owned directly by the RX thread.
+//!
+//! This method binds the frame ready and release channels to the external endpoints, allowing
+//! the RX thread to notify frames ready to, and receive releases from, downstream processes
+//! directly rather than through the main thread. The release channel is added to the reactor.
+//! Any failure is signalled as a thread initialisation error.
+//!
+//! \return true if the channels were set up
+//!
+bool FrameReceiverRxThread::setup_frame_notify_channels(void)
+{
+  try
+  {
+    LOG4CXX_DEBUG_LEVEL(1, logger_, "Binding RX thread frame ready channel to endpoint "
+      << config_.frame_ready_endpoint_);
+    frame_ready_channel_.reset(new IpcChannel(ZMQ_PUB));
+    frame_ready_channel_->bind(config_.frame_ready_endpoint_);
+
+    LOG4CXX_DEBUG_LEVEL(1, logger_, "Binding RX thread frame release channel to endpoint "
+      << config_.frame_release_endpoint_);
+    frame_release_channel_.reset(new IpcChannel(ZMQ_SUB));
+    frame_release_channel_->bind(config_.frame_release_endpoint_);
+    frame_release_channel_->subscribe("");
+  }
+  catch (zmq::error_t& e)
+  {
+    std::stringstream ss;
+    ss << "RX thread frame notification channel bind failed: " << e.what();
+    this->set_thread_init_error(ss.str());
+    frame_ready_channel_.reset();
+    frame_release_channel_.reset();
+    return false;
+  }
+
+  reactor_.register_channel(*frame_release_channel_,
+    boost::bind(&FrameReceiverRxThread::handle_frame_release_channel, this));
+
+  return true;
+}
+
+//! Handle messages on the frame release channel.
+//!
+//! This method is the handler registered with the thread reactor to handle messages received
+//! on the frame release channel when it is owned directly by the RX thread. Released buffers are
+//! queued for re-use and requests for the shared buffer configuration are answered.
+//!
+void FrameReceiverRxThread::handle_frame_release_channel(void)
+{
+  std::string release_encoded = frame_release_channel_->recv();
+
+  if (FrameNotification::is_binary_batch(release_encoded))
+  {
+    __atomic_add_fetch(&direct_frames_released_, this->release_buffers(release_encoded),
+      __ATOMIC_RELAXED);
+    return;
+  }
+
+  try {
+    IpcMessage release_msg(release_encoded.c_str());
+
+    if ((release_msg.get_msg_type() == IpcMessage::MsgTypeNotify) &&
+        (release_msg.get_msg_val() == IpcMessage::MsgValNotifyFrameRelease))
+    {
+      __atomic_add_fetch(&direct_frames_released_, this->release_buffers(release_msg),
+        __ATOMIC_RELAXED);
+    }
+    else if ((release_msg.get_msg_type() == IpcMessage::MsgTypeCmd) &&
+             (release_msg.get_msg_val() == IpcMessage::MsgValCmdBufferConfigRequest))
+    {
+      LOG4CXX_DEBUG_LEVEL(2, logger_, "Got shared buffer config request from processor");
+      this->notify_buffer_config();
+    }
+    else
+    {
+      LOG4CXX_ERROR(logger_,
+        "Got unexpected message on frame release channel: " << release_encoded);
+    }
+  }
+  catch (IpcMessageException& e)
+  {
+    LOG4CXX_ERROR(logger_, "Error decoding message on frame release channel: " << e.what());
+  }
+}
+
+//! Service all pending messages on the frame release channel.
+//!
+//! As for the RX channel, this method is used by the io_uring event loop to drain the frame
+//! release channel when it is owned directly by the RX thread.
+//!
+void FrameReceiverRxThread::service_frame_release_channel(void)
+{
+  int events = 0;
+  size_t events_size = sizeof(events);
+  frame_release_channel_->getsockopt(ZMQ_EVENTS, &events, &events_size);
+  while (events & ZMQ_POLLIN)
+  {
+    this->handle_frame_release_channel();
+    frame_release_channel_->getsockopt(ZMQ_EVENTS, &events, &events_size);
+  }
+}
+
+//! Notify downstream processes of the shared buffer configuration.
+//!
+//! This method sends the current shared buffer configuration on the frame ready channel when it
+//! is owned directly by the RX thread, at startup and on request from downstream processes.
+//!
+void FrameReceiverRxThread::notify_buffer_config(void)
+{
+  LOG4CXX_DEBUG_LEVEL(1, logger_,
+      "Notifying downstream processes of shared buffer configuration");
+
+  IpcMessage config_msg(IpcMessage::MsgTypeNotify, IpcMessage::MsgValNotifyBufferConfig);
+  config_msg.set_param("shared_buffer_name", config_.shared_buffer_name_);
+
+  frame_ready_channel_->send(config_msg.encode());
+}
+
 //! Tick timer handler for the RX thread.
 //!
 //! This method is the tick timer handler for the RX thread and is called periodically
@@ -363,13 +631,19 @@ void FrameReceiverRxThread::tick_timer(void)
 //!
 //! This method is the buffer monitor timer handler for the RX thread and is called periodically
 //! by the thread reactor event loop. It calls the frame decoder buffer montoring function to
-//! allow, e.g. timed out frames to be released. It also sends a status notification to the main
+//! allow, e.g. timed out frames to be released, and reclaims any buffers whose lease has expired.
+//! It also sends a status notification to the main
 //! thread to allow status information to be updated ready for client requests.
 //!
 void FrameReceiverRxThread::buffer_monitor_timer(void)
 {
   LOG4CXX_DEBUG_LEVEL(4, logger_, "RX thread buffer monitor thread fired");
+  monitoring_buffers_ = true;
   frame_decoder_->monitor_buffers();
+  monitoring_buffers_ = false;
+
+  // Reclaim any buffers held by dead or stalled consumers
+  this->reclaim_buffers();
 
   // Send status notification to main thread
   IpcMessage status_msg(IpcMessage::MsgTypeNotify, IpcMessage::MsgValNotifyStatus);
@@ -378,6 +652,211 @@ void FrameReceiverRxThread::buffer_monitor_timer(void)
   rx_channel_.send(status_msg.encode());
 }
 
+//! Frame ring timer handler for the RX thread.
+//!
+//! This method is the frame ring timer handler for the RX thread, called periodically by the
+//! thread reactor when shared frame rings are in use, to collect released buffers while no frames
+//! are being received.
+//!
+void FrameReceiverRxThread::frame_ring_timer(void)
+{
+  this->drain_release_ring();
+}
+
+//! Drain the release ring of this thread.
+//!
+//! This method pops all frame release notifications from the release ring of this thread,
+//! queuing each released buffer for re-use by the frame decoder.
+//!
+void FrameReceiverRxThread::drain_release_ring(void)
+{
+  FrameNotification frame_release;
+  uint64_t frames_released = 0;
+  while (frame_rings_->pop_release(thread_index_, frame_release))
+  {
+    this->release_buffer(frame_release.get_buffer_id(), frame_release.get_frame());
+    frames_released++;
+  }
+  if (frames_released)
+  {
+    ring_frames_released_ += frames_released;
+    __atomic_add_fetch(&direct_frames_released_, frames_released, __ATOMIC_RELAXED);
+  }
+}
+
+//! Release the frame buffers in a binary release notification.
+//!
+//! This method queues the buffers released in a single or batched binary frame release
+//! notification for re-use.
+//!
+//! \param[in] release_encoded - encoded binary release notification(s)
+//! \return number of buffers released
+//!
+unsigned int FrameReceiverRxThread::release_buffers(const std::string& release_encoded)
+{
+  unsigned int num_released = 0;
+  try {
+    std::vector<FrameNotification> frame_releases;
+    FrameNotification::decode_batch(release_encoded, frame_releases);
+    for (std::vector<FrameNotification>::iterator it = frame_releases.begin();
+         it != frame_releases.end(); ++it)
+    {
+      if (it->get_type() == FrameNotification::TypeFrameRelease)
+      {
+        this->release_buffer(it->get_buffer_id(), it->get_frame());
+        num_released++;
+      }
+      else
+      {
+        LOG4CXX_ERROR(logger_, "RX thread received unexpected binary notification type "
+          << it->get_type());
+      }
+    }
+  }
+  catch (FrameNotificationException& e)
+  {
+    LOG4CXX_ERROR(logger_, "Error decoding binary notification: " << e.what());
+  }
+  return num_released;
+}
+
+//! Release the frame buffers in a JSON release notification.
+//!
+//! This method queues the buffers released in a JSON frame release notification, which carries
+//! either a single buffer ID or a batch of them, for re-use.
+//!
+//! \param[in] release_msg - frame release notification message
+//! \return number of buffers released
+//!
+unsigned int FrameReceiverRxThread::release_buffers(IpcMessage& release_msg)
+{
+  unsigned int num_released = 0;
+  int buffer_id = release_msg.get_param<int>("buffer_id", -1);
+  if (release_msg.has_param("buffer_ids"))
+  {
+    // Batched release of several buffers, with the frame numbers released if present
+    const rapidjson::Value& buffer_ids =
+      release_msg.get_param<const rapidjson::Value&>("buffer_ids");
+    const rapidjson::Value* frames = release_msg.has_param("frames") ?
+      &release_msg.get_param<const rapidjson::Value&>("frames") : NULL;
+    for (rapidjson::SizeType idx = 0; buffer_ids.IsArray() && (idx < buffer_ids.Size()); idx++)
+    {
+      uint64_t frame = SharedBufferStates::any_frame;
+      if (frames && frames->IsArray() && (idx < frames->Size()) && (*frames)[idx].IsInt64())
+      {
+        frame = static_cast<uint64_t>((*frames)[idx].GetInt64());
+      }
+      this->release_buffer(buffer_ids[idx].GetInt(), frame);
+      num_released++;
+    }
+  }
+  else if (buffer_id != -1)
+  {
+    this->release_buffer(buffer_id,
+      static_cast<uint64_t>(release_msg.get_param<int64_t>("frame", -1)));
+    num_released++;
+  }
+  else
+  {
+    LOG4CXX_ERROR(logger_, "RX thread received empty frame notification with buffer ID");
+  }
+  return num_released;
+}
+
+//! Release a frame buffer for re-use.
+//!
+//! This method queues a buffer released by the downstream application for re-use by the frame
+//! decoder, however the release was notified. The latency between notifying the buffer ready
+//! and its release is accumulated for status. If the shared buffer state table is present, the
+//! release is refused unless the buffer is ready or held with the frame released, e.g. when a
+//! stalled consumer releases a buffer that has already been reclaimed.
+//!
+//! \param[in] buffer_id - ID of the buffer released
+//! \param[in] frame - frame number released, or SharedBufferStates::any_frame if not known
+//!
+void FrameReceiverRxThread::release_buffer(int buffer_id, uint64_t frame)
+{
+  if (buffer_states_ && !buffer_states_->release(buffer_id, frame))
+  {
+    LOG4CXX_WARN(logger_, "Refusing release of buffer " << buffer_id
+      << " as it is not ready or held with the frame released");
+    releases_refused_++;
+    return;
+  }
+
+  if ((buffer_id >= 0) && ((std::size_t)buffer_id < buffer_ready_time_ns_.size()) &&
+      buffer_ready_time_ns_[buffer_id])
+  {
+    uint64_t now_ns = FrameNotification::now_ns();
+    uint64_t latency_ns = (now_ns > buffer_ready_time_ns_[buffer_id]) ?
+      now_ns - buffer_ready_time_ns_[buffer_id] : 0;
+    release_latency_total_ns_ += latency_ns;
+    release_latency_max_ns_ = std::max(release_latency_max_ns_, latency_ns);
+    buffers_released_++;
+    buffer_ready_time_ns_[buffer_id] = 0;
+  }
+
+  frame_decoder_->push_empty_buffer(buffer_id);
+  LOG4CXX_DEBUG_LEVEL(3, logger_, "Added empty buffer ID " << buffer_id
+    << " to queue, length is now " << frame_decoder_->get_num_empty_buffers());
+}
+
+//! Reclaim buffers held by dead or stalled consumers.
+//!
+//! This method scans the shared buffer state table, if present, for buffers managed by this
+//! thread that are ready or held by a downstream application and reclaims them for re-use by the
+//! frame decoder if they have been ready or held for longer than the configured buffer lease
+//! timeout, or if their entry was left busy by a process that did not complete a transition. A
+//! consumer that is merely stalled could still be reading a reclaimed buffer, so the lease timeout
+//! should be well beyond the longest time a buffer is expected to be held, and is disabled by
+//! default. Buffers held by a process that no longer exists are also reclaimed if enabled in the
+//! configuration. This is checked by PID, so is only reliable if the frame receiver and processor
+//! share a PID namespace and is disabled by default, as a PID from another namespace may not be
+//! found, or may have been reused by an unrelated process.
+//!
+void FrameReceiverRxThread::reclaim_buffers(void)
+{
+  if (!buffer_states_)
+  {
+    return;
+  }
+
+  uint64_t now_ns = FrameNotification::now_ns();
+  uint64_t lease_ns = static_cast<uint64_t>(config_.buffer_lease_timeout_ms_) * 1000000;
+  SharedBufferStates::Entry entry;
+
+  for (unsigned int buffer_id = 0; buffer_id < buffer_states_->get_num_buffers(); buffer_id++)
+  {
+    if (!buffer_states_->get_entry(buffer_id, entry) || (entry.rx_thread != thread_index_))
+    {
+      continue;
+    }
+    SharedBufferStates::State state = SharedBufferStates::get_state(entry);
+    if ((state != SharedBufferStates::StateReady) && (state != SharedBufferStates::StateHeld))
+    {
+      continue;
+    }
+
+    bool left_busy = SharedBufferStates::is_busy(entry);
+    bool owner_dead = config_.buffer_reclaim_exited_ && (state == SharedBufferStates::StateHeld) &&
+      (kill(static_cast<pid_t>(entry.owner_pid), 0) < 0) && (errno == ESRCH);
+    bool lease_expired = lease_ns && (now_ns > entry.state_time_ns) &&
+      ((now_ns - entry.state_time_ns) > lease_ns);
+
+    if ((left_busy || owner_dead || lease_expired) && buffer_states_->reclaim(buffer_id, entry))
+    {
+      LOG4CXX_WARN(logger_, "Reclaimed buffer " << buffer_id << " containing frame "
+        << entry.frame << " " << SharedBufferStates::state_name(state)
+        << (left_busy ? " left busy by process " :
+            (owner_dead ? " by exited process " : " beyond lease timeout by process "))
+        << entry.owner_pid);
+      buffer_ready_time_ns_[buffer_id] = 0;
+      buffers_reclaimed_++;
+      frame_decoder_->push_empty_buffer(buffer_id);
+    }
+  }
+}
+
 //! Fill status parameters into a message.
 //! 
 //! This method populates the parameter block of the IpcMessage passed as an argument
@@ -388,10 +867,53 @@ void FrameReceiverRxThread::buffer_monitor_timer(void)
 //!
 void FrameReceiverRxThread::fill_status_params(IpcMessage& status_msg)
 {
+  std::stringstream rx_ports_stream;
+  std::copy(rx_ports_.begin(), rx_ports_.end(),
+      std::ostream_iterator<uint16_t>(rx_ports_stream, ","));
+  std::string rx_port_list = rx_ports_stream.str();
+  if (!rx_port_list.empty())
+  {
+    rx_port_list.erase(rx_port_list.length()-1);
+  }
+
+  status_msg.set_param("rx_thread/thread_index", thread_index_);
+  status_msg.set_param("rx_thread/rx_ports", rx_port_list);
   status_msg.set_param("rx_thread/empty_buffers", frame_decoder_->get_num_empty_buffers());
   status_msg.set_param("rx_thread/mapped_buffers", frame_decoder_->get_num_mapped_buffers());
   status_msg.set_param("rx_thread/frames_timedout", frame_decoder_->get_num_frames_timedout());
   status_msg.set_param("rx_thread/frames_dropped", frame_decoder_->get_num_frames_dropped());
+  status_msg.set_param("rx_thread/scrub_backlog", frame_decoder_->get_num_scrub_backlog());
+  status_msg.set_param("rx_thread/buffers_scrubbed", frame_decoder_->get_num_buffers_scrubbed());
+  status_msg.set_param("rx_thread/rx_engine",
+      FrameReceiverConfig::map_rx_engine_type_to_name(config_.rx_engine_));
+  status_msg.set_param("rx_thread/release_latency_mean_us",
+      buffers_released_ ? (release_latency_total_ns_ / buffers_released_) / 1000 : 0);
+  status_msg.set_param("rx_thread/release_latency_max_us", release_latency_max_ns_ / 1000);
+  status_msg.set_param("rx_thread/notify_direct", frame_ready_channel_ ? true : false);
+  status_msg.set_param("rx_thread/notify_latency_mean_ns",
+      frames_notified_ ? notify_latency_total_ns_ / frames_notified_ : 0);
+  status_msg.set_param("rx_thread/notify_latency_max_ns", notify_latency_max_ns_);
+  if (buffer_states_)
+  {
+    status_msg.set_param("rx_thread/buffers_reclaimed", buffers_reclaimed_);
+    status_msg.set_param("rx_thread/releases_refused", releases_refused_);
+  }
+  if (frame_rings_)
+  {
+    status_msg.set_param("rx_thread/ring_frames_ready", ring_frames_ready_);
+    status_msg.set_param("rx_thread/ring_frames_released", ring_frames_released_);
+    status_msg.set_param("rx_thread/ring_full", ring_full_);
+  }
+#ifdef HAVE_IO_URING
+  if (uring_)
+  {
+    status_msg.set_param("rx_thread/uring_enter_calls", uring_->get_enter_calls());
+    status_msg.set_param("rx_thread/uring_completions", uring_->get_completions());
+  }
+#endif
+
+  // Allow the specific RX thread type to add its own status parameters
+  this->fill_specific_status_params(status_msg);
 
   // Get the specific frame decoder instance to fill its own status into message
   frame_decoder_->get_status(std::string("decoder/"), status_msg);
@@ -401,8 +923,13 @@ void FrameReceiverRxThread::fill_status_params(IpcMessage& status_msg)
 //! Signal that a frame is ready for processing.
 //!
 //! This method is called to signal to the main thread that a frame is ready (either complete or
-//! timed out) for processing by the downstream application. An IpcMessage is created with
-//! the appropriate parameters and passed to the amin thread via the RX channel.
+//! timed out) for processing by the downstream application. An IpcMessage, or a binary
+//! notification if so configured, is created with the appropriate parameters and passed to the
+//! main thread via the RX channel. Frames made ready while the decoder is monitoring buffers
+//! have timed out, which is indicated in the state of binary notifications. If shared frame
+//! rings are in use, a binary notification is instead pushed directly onto the ready ring of
+//! this thread, falling back to the RX channel if the ring is full. If the RX thread owns the
+//! frame ready channel, notifications are sent on it directly rather than via the main thread.
 //!
 //! \param[in] buffer_id - buffer manager ID that is ready
 //! \param[in] frame_number - frame number contained in that buffer
@@ -411,14 +938,107 @@ void FrameReceiverRxThread::frame_ready(int buffer_id, int frame_number)
 {
   LOG4CXX_DEBUG_LEVEL(2, logger_, "Releasing frame " << frame_number << " in buffer " << buffer_id);
 
-  IpcMessage ready_msg(IpcMessage::MsgTypeNotify, IpcMessage::MsgValNotifyFrameReady);
-  ready_msg.set_param("frame", frame_number);
-  ready_msg.set_param("buffer_id", buffer_id);
+  // Record when the buffer was notified ready to measure the latency of its release
+  uint64_t ready_time_ns = FrameNotification::now_ns();
+  if ((buffer_id >= 0) && ((std::size_t)buffer_id < buffer_ready_time_ns_.size()))
+  {
+    buffer_ready_time_ns_[buffer_id] = ready_time_ns;
+  }
+
+  // Mark the buffer ready in the shared buffer state table before notifying it
+  if (buffer_states_)
+  {
+    buffer_states_->set_ready(buffer_id, frame_number);
+  }
+
+  // Send notifications on the frame ready channel if owned by this thread, otherwise to the main
+  // thread to be relayed
+  IpcChannel& ready_channel = frame_ready_channel_ ? *frame_ready_channel_ : rx_channel_;
+
+  if (frame_rings_ || binary_notify_)
+  {
+    FrameNotification ready_notification(FrameNotification::TypeFrameReady, frame_number, buffer_id,
+      monitoring_buffers_ ? FrameNotification::StateTimedout : FrameNotification::StateComplete);
+    if (frame_rings_)
+    {
+      // Collect any buffers released in the meantime before notifying the frame
+      this->drain_release_ring();
+      if (frame_rings_->push_ready(thread_index_, ready_notification))
+      {
+        ring_frames_ready_++;
+        __atomic_add_fetch(&direct_frames_ready_, 1, __ATOMIC_RELAXED);
+        this->record_notify_latency(ready_time_ns);
+        return;
+      }
+      ring_full_++;
+    }
+    std::string ready_encoded = ready_notification.encode();
+    ready_channel.send(ready_encoded);
+  }
+  else
+  {
+    IpcMessage ready_msg(IpcMessage::MsgTypeNotify, IpcMessage::MsgValNotifyFrameReady);
+    ready_msg.set_param("frame", frame_number);
+    ready_msg.set_param("buffer_id", buffer_id);
+
+    ready_channel.send(ready_msg.encode());
+  }
 
-  rx_channel_.send(ready_msg.encode());
+  if (frame_ready_channel_)
+  {
+    __atomic_add_fetch(&direct_frames_ready_, 1, __ATOMIC_RELAXED);
+    this->record_notify_latency(ready_time_ns);
+  }
 
 }
 
+//! Record the latency of notifying a frame ready.
+//!
+//! This method accumulates the latency between a frame becoming ready in the frame decoder and
+//! the notification of it being sent by this thread, for reporting in status. Notifications
+//! relayed through the main thread are measured there instead.
+//!
+//! \param[in] ready_time_ns - time the frame became ready in nanoseconds since the epoch
+//!
+void FrameReceiverRxThread::record_notify_latency(uint64_t ready_time_ns)
+{
+  uint64_t now_ns = FrameNotification::now_ns();
+  uint64_t latency_ns = (now_ns > ready_time_ns) ? now_ns - ready_time_ns : 0;
+  notify_latency_total_ns_ += latency_ns;
+  notify_latency_max_ns_ = std::max(notify_latency_max_ns_, latency_ns);
+  frames_notified_++;
+}
+
+//! Return the number of frames notified ready bypassing the main thread.
+//!
+//! This method returns the number of frames this thread has notified ready through shared frame
+//! rings or directly on the frame ready channel. As these are not seen by the main thread, it
+//! reads this count, which is updated atomically, to account for them.
+//!
+//! \return number of frames notified ready
+//!
+uint64_t FrameReceiverRxThread::get_direct_frames_ready(void) const
+{
+  return __atomic_load_n(&direct_frames_ready_, __ATOMIC_RELAXED);
+}
+
+//! Return the number of frames released bypassing the main thread.
+//!
+//! \return number of frames released through shared frame rings or the frame release channel
+//!
+uint64_t FrameReceiverRxThread::get_direct_frames_released(void) const
+{
+  return __atomic_load_n(&direct_frames_released_, __ATOMIC_RELAXED);
+}
+
+//! Reset the counts of frames notified ready and released bypassing the main thread.
+//!
+void FrameReceiverRxThread::reset_direct_frame_counts(void)
+{
+  __atomic_store_n(&direct_frames_ready_, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&direct_frames_released_, 0, __ATOMIC_RELAXED);
+}
+
 //! Set thread initialisation error condition.
 //!
 //! This method is called by the RX thread initialisation to indicate that an error has
@@ -433,6 +1053,210 @@ void FrameReceiverRxThread::set_thread_init_error(const std::string& msg)
   thread_init_error_ = true;
 }
 
+//! Run the RX thread event loop.
+//!
+//! This method runs the event loop of the RX thread, which by default simply runs the reactor,
+//! blocking until channels, sockets or timers are ready to be handled. If the io_uring engine is
+//! selected, the io_uring event loop is run instead. Subclasses can override this method to drive
+//! the reactor from their own loop, e.g. to spin on receive sockets.
+//!
+void FrameReceiverRxThread::run_event_loop(void)
+{
+#ifdef HAVE_IO_URING
+  if (uring_)
+  {
+    this->run_uring_event_loop();
+    return;
+  }
+#endif
+  reactor_.run();
+}
+
+//! Indicate if the RX thread is using the io_uring engine.
+//!
+//! \return true if the receive operations of the thread are completed through io_uring
+//!
+bool FrameReceiverRxThread::using_uring(void) const
+{
+#ifdef HAVE_IO_URING
+  return uring_.get() != 0;
+#else
+  return false;
+#endif
+}
+
+#ifdef HAVE_IO_URING
+
+//! Run the io_uring RX thread event loop.
+//!
+//! This method runs the event loop of the RX thread when using the io_uring engine. The receive
+//! operations submitted by the subclass, a multishot poll on the notification descriptor of the
+//! RX channel (and the frame release channel if owned by this thread) and a timeout for the next
+//! reactor timer are all completed through the io_uring instance, so that the thread has a single
+//! wait point, submitting new operations and waiting for completions in one system call. Receive
+//! completions are passed to the subclass handler. The channels are serviced after each batch of
+//! completions, and the reactor is run without blocking when the timeout completes, to fire the
+//! timers that are due.
+//!
+void FrameReceiverRxThread::run_uring_event_loop(void)
+{
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread running io_uring event loop");
+
+  int channel_fd = -1;
+  size_t channel_fd_size = sizeof(channel_fd);
+  rx_channel_.getsockopt(ZMQ_FD, &channel_fd, &channel_fd_size);
+  this->submit_uring_channel_poll(channel_fd, URING_TAG_RX_CHANNEL);
+
+  // Poll the frame release channel in the same way if owned by this thread
+  int release_channel_fd = -1;
+  if (frame_release_channel_)
+  {
+    frame_release_channel_->getsockopt(ZMQ_FD, &release_channel_fd, &channel_fd_size);
+    this->submit_uring_channel_poll(release_channel_fd, URING_TAG_RELEASE_CHANNEL);
+  }
+
+  bool timeout_pending = false;
+
+  while (!reactor_.is_stopped())
+  {
+    if (!timeout_pending)
+    {
+      timeout_pending = this->submit_uring_timeout();
+    }
+
+    int rc = uring_->submit_and_wait(1);
+    if ((rc < 0) && (rc != -EINTR) && (rc != -EAGAIN) && (rc != -EBUSY))
+    {
+      LOG4CXX_ERROR(logger_, "RX thread io_uring wait failed: " << strerror(-rc));
+      reactor_.stop();
+      break;
+    }
+
+    bool timers_due = false;
+    struct io_uring_cqe* cqe;
+    while ((cqe = uring_->peek_cqe()) != 0)
+    {
+      if (cqe->user_data == URING_TAG_RX_CHANNEL)
+      {
+        if (!(cqe->flags & IORING_CQE_F_MORE))
+        {
+          this->submit_uring_channel_poll(channel_fd, URING_TAG_RX_CHANNEL);
+        }
+      }
+      else if (cqe->user_data == URING_TAG_RELEASE_CHANNEL)
+      {
+        if (!(cqe->flags & IORING_CQE_F_MORE))
+        {
+          this->submit_uring_channel_poll(release_channel_fd, URING_TAG_RELEASE_CHANNEL);
+        }
+      }
+      else if (cqe->user_data == URING_TAG_TIMEOUT)
+      {
+        timeout_pending = false;
+        timers_due = true;
+      }
+      else
+      {
+        this->handle_uring_completion(cqe);
+      }
+      uring_->cqe_seen();
+    }
+
+    this->service_rx_channel();
+    if (frame_release_channel_)
+    {
+      this->service_frame_release_channel();
+    }
+
+    if (timers_due)
+    {
+      reactor_.run_once(0);
+    }
+  }
+}
+
+//! Submit a multishot poll of a channel notification descriptor to the io_uring instance.
+//!
+//! \param[in] channel_fd - notification file descriptor of the channel
+//! \param[in] tag - completion tag identifying the channel
+//!
+void FrameReceiverRxThread::submit_uring_channel_poll(int channel_fd, uint64_t tag)
+{
+  struct io_uring_sqe* sqe = this->get_uring_sqe();
+  if (!sqe)
+  {
+    return;
+  }
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = channel_fd;
+  sqe->poll32_events = POLLIN;
+  sqe->len = IORING_POLL_ADD_MULTI;
+  sqe->user_data = tag;
+}
+
+//! Submit a timeout for the next reactor timer to the io_uring instance.
+//!
+//! No timeout is submitted if the reactor has no timers registered, or if no submission queue
+//! entry is available, in which case the event loop tries again after the next completion.
+//!
+//! \return true if a timeout was submitted
+//!
+bool FrameReceiverRxThread::submit_uring_timeout(void)
+{
+  long timeout_ms = reactor_.get_next_timeout();
+  if (timeout_ms < 0)
+  {
+    return false;
+  }
+
+  struct io_uring_sqe* sqe = uring_->get_sqe();
+  if (!sqe)
+  {
+    return false;
+  }
+
+  uring_timeout_.tv_sec = timeout_ms / 1000;
+  uring_timeout_.tv_nsec = (timeout_ms % 1000) * 1000000;
+  sqe->opcode = IORING_OP_TIMEOUT;
+  sqe->fd = -1;
+  sqe->addr = reinterpret_cast<uint64_t>(&uring_timeout_);
+  sqe->len = 1;
+  sqe->user_data = URING_TAG_TIMEOUT;
+  return true;
+}
+
+//! Get a submission queue entry from the io_uring instance.
+//!
+//! This method is used to submit operations that the event loop cannot run without, e.g. channel
+//! polls and socket receives. If no submission queue entry is available, an error is logged and
+//! the reactor is stopped, terminating the event loop, and NULL is returned.
+//!
+//! \return pointer to submission queue entry, or NULL if none is available
+//!
+struct io_uring_sqe* FrameReceiverRxThread::get_uring_sqe(void)
+{
+  struct io_uring_sqe* sqe = uring_->get_sqe();
+  if (!sqe)
+  {
+    LOG4CXX_ERROR(logger_, "RX thread io_uring submission queue full, stopping");
+    reactor_.stop();
+  }
+  return sqe;
+}
+
+//! Handle an io_uring completion.
+//!
+//! This method is called by the io_uring event loop for each completion of an operation submitted
+//! by a subclass, e.g. a receive on a socket, and allows the subclass to process the result. This
+//! default implementation ignores the completion.
+//!
+//! \param[in] cqe - completion queue entry, valid only for the duration of the call
+//!
+void FrameReceiverRxThread::handle_uring_completion(struct io_uring_cqe* cqe)
+{
+}
+#endif
+
 //! Register a socket with the RX thread reactor
 //!
 //! This method registers a socket and associated callback with the RX thread reactor
@@ -448,3 +1272,28 @@ void FrameReceiverRxThread::register_socket(int socket_fd, ReactorCallback callb
 
   recv_sockets_.push_back(socket_fd);
 }
+
+//! Track a receive socket without registering it with the reactor
+//!
+//! This method records a receive socket so that it is closed when the RX thread terminates, without
+//! registering it with the RX thread reactor. This is used when receive operations on the socket
+//! are submitted to the io_uring engine directly.
+//!
+//! \param[in] socket_fd - file descriptor of socket to track
+//!
+void FrameReceiverRxThread::track_socket(int socket_fd)
+{
+  recv_sockets_.push_back(socket_fd);
+}
+
+//! Fill specific status parameters into a message.
+//!
+//! This method is called when building status messages and allows subclasses to add status
+//! parameters specific to the type of receiver thread. This default implementation adds
+//! no parameters.
+//!
+//! \param[in,out] status_msg - IpcMessage to fill with status parameters
+//!
+void FrameReceiverRxThread::fill_specific_status_params(IpcMessage& status_msg)
+{
+}
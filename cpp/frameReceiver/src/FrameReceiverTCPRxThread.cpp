@@ -4,17 +4,34 @@
  */
 
 #include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <arpa/inet.h>
 
 #include "FrameReceiverTCPRxThread.h"
+#include "gettime.h"
 
 using namespace FrameReceiver;
 
+#ifdef HAVE_IO_URING
+//! Flag marking io_uring completion tags of socket readiness polls
+const uint64_t URING_TAG_TCP_POLL = 0x80000000ULL;
+//! Flag marking io_uring completion tags of connection accepts
+const uint64_t URING_TAG_TCP_ACCEPT = 0x40000000ULL;
+//! Mask of the connection or listener index in io_uring completion tags
+const uint64_t URING_TAG_TCP_INDEX_MASK = 0x3FFFFFFFULL;
+#endif
+
 FrameReceiverTCPRxThread::FrameReceiverTCPRxThread(
     FrameReceiverConfig &config, SharedBufferManagerPtr buffer_manager,
-    FrameDecoderPtr frame_decoder, unsigned int tick_period_ms)
+    FrameDecoderPtr frame_decoder, unsigned int tick_period_ms,
+    unsigned int thread_index)
     : FrameReceiverRxThread(config, buffer_manager, frame_decoder,
-                            tick_period_ms),
-      logger_(log4cxx::Logger::getLogger("FR.TCPRxThread")), recv_socket_(-1) {
+                            tick_period_ms, thread_index),
+      logger_(log4cxx::Logger::getLogger("FR.TCPRxThread")),
+      active_connection_(-1), connections_accepted_(0),
+      connections_closed_(0), messages_received_(0), messages_discarded_(0),
+      recv_calls_(0) {
   LOG4CXX_DEBUG_LEVEL(1, logger_,
                       "FrameReceiverTCPRxThread constructor entered....");
 
@@ -24,46 +41,21 @@ FrameReceiverTCPRxThread::FrameReceiverTCPRxThread(
 
 FrameReceiverTCPRxThread::~FrameReceiverTCPRxThread() {
   LOG4CXX_DEBUG_LEVEL(1, logger_, "Destroying FrameReceiverTCPRxThread....");
+  this->close_sockets();
 }
 
 void FrameReceiverTCPRxThread::run_specific_service(void) {
-  LOG4CXX_DEBUG_LEVEL(1, logger_, "Running TCP RX thread service");
+  LOG4CXX_DEBUG_LEVEL(1, logger_,
+                      "Running TCP RX thread service in "
+                          << FrameReceiverConfig::map_rx_tcp_mode_type_to_name(
+                                 config_.rx_tcp_mode_)
+                          << " mode");
 
-  for (std::vector<uint16_t>::iterator rx_port_itr = config_.rx_ports_.begin();
-       rx_port_itr != config_.rx_ports_.end(); rx_port_itr++) {
+  for (std::vector<uint16_t>::iterator rx_port_itr = rx_ports_.begin();
+       rx_port_itr != rx_ports_.end(); rx_port_itr++) {
 
     uint16_t rx_port = *rx_port_itr;
 
-    // Create the receive socket
-    int recv_socket_ = socket(AF_INET, SOCK_STREAM, 0);
-    if (recv_socket_ < 0) {
-      std::stringstream ss;
-      ss << "RX channel failed to create receive socket for port " << rx_port
-         << " : " << strerror(errno);
-      this->set_thread_init_error(ss.str());
-      return;
-    }
-
-    // Set the socket receive buffer size
-    if (setsockopt(recv_socket_, SOL_SOCKET, SO_REUSEADDR,
-                   &config_.rx_recv_buffer_size_,
-                   sizeof(config_.rx_recv_buffer_size_)) < 0) {
-      std::stringstream ss;
-      ss << "RX channel failed to set receive socket buffer size for port "
-         << rx_port << " : " << strerror(errno);
-      this->set_thread_init_error(ss.str());
-      return;
-    }
-
-    // Read it back and display
-    int buffer_size;
-    socklen_t len = sizeof(buffer_size);
-    getsockopt(recv_socket_, SOL_SOCKET, SO_REUSEADDR, &buffer_size, &len);
-    LOG4CXX_DEBUG_LEVEL(1, logger_,
-                        "RX thread receive buffer size for port "
-                            << rx_port << " is " << buffer_size);
-
-    // Connect the socket to the specified endpoint
     struct sockaddr_in recv_addr;
     memset(&recv_addr, 0, sizeof(recv_addr));
     recv_addr.sin_family = AF_INET;
@@ -77,45 +69,679 @@ void FrameReceiverTCPRxThread::run_specific_service(void) {
       return;
     }
 
-    if (connect(recv_socket_, (struct sockaddr *)&recv_addr,
-                sizeof(recv_addr)) == -1) {
-      std::stringstream ss;
-      ss << "RX channel failed to connect receive socket to address "
-         << config_.rx_address_ << " port " << rx_port << " : "
-         << strerror(errno);
-      this->set_thread_init_error(ss.str());
+    // Either listen for connections on the port or connect out to it
+    bool socket_ok;
+    if (config_.rx_tcp_mode_ == Defaults::RxTcpModeServer) {
+      socket_ok = this->open_listener(rx_port, recv_addr);
+    } else {
+      socket_ok = this->connect_to_port(rx_port, recv_addr);
+    }
+    if (!socket_ok) {
       return;
     }
+  }
 
-    // Register this socket
-    this->register_socket(
-        recv_socket_,
-        boost::bind(&FrameReceiverTCPRxThread::handle_receive_socket, this,
-                    recv_socket_, (int)rx_port));
+  // Submit an accept on each listening socket once the listener list is
+  // complete, as the accepts refer to the peer address storage of each
+#ifdef HAVE_IO_URING
+  for (unsigned int listener_idx = 0; uring_ && listener_idx < listeners_.size();
+       listener_idx++) {
+    this->submit_uring_accept(listener_idx);
   }
+#endif
 }
 
 void FrameReceiverTCPRxThread::cleanup_specific_service(void) {
   LOG4CXX_DEBUG_LEVEL(1, logger_, "Cleaning up TCP RX thread service");
+  this->close_sockets();
+}
+
+void FrameReceiverTCPRxThread::fill_specific_status_params(
+    IpcMessage &status_msg) {
+  struct timespec now;
+  gettime(&now, true);
+
+  unsigned int open_connections = 0;
+  double byte_rate = 0.0;
+
+  for (unsigned int connection_idx = 0; connection_idx < connections_.size();
+       connection_idx++) {
+    TcpConnection &connection = *connections_[connection_idx];
+    if (connection.socket_fd < 0) {
+      continue;
+    }
+
+    unsigned int elapsed = elapsed_us(connection.rate_time, now);
+    if (elapsed > 0) {
+      connection.byte_rate =
+          (double)(connection.total_bytes - connection.rate_bytes) *
+          1000000.0 / elapsed;
+      connection.rate_bytes = connection.total_bytes;
+      connection.rate_time = now;
+    }
+    open_connections++;
+    byte_rate += connection.byte_rate;
+
+    std::stringstream prefix;
+    prefix << "rx_thread/connections/" << connection_idx << "/";
+    status_msg.set_param(prefix.str() + "peer", connection.peer);
+    status_msg.set_param(prefix.str() + "port", connection.recv_port);
+    status_msg.set_param(prefix.str() + "bytes_received",
+                         connection.total_bytes);
+    status_msg.set_param(prefix.str() + "messages_received",
+                         connection.messages_received);
+    status_msg.set_param(prefix.str() + "byte_rate", connection.byte_rate);
+  }
 
-  // Remove the IPC socket from the reactor
-  reactor_.remove_socket(recv_socket_);
-  close(recv_socket_);
+  status_msg.set_param("rx_thread/tcp_mode",
+                       FrameReceiverConfig::map_rx_tcp_mode_type_to_name(
+                           config_.rx_tcp_mode_));
+  status_msg.set_param("rx_thread/open_connections", open_connections);
+  status_msg.set_param("rx_thread/connections_accepted",
+                       connections_accepted_);
+  status_msg.set_param("rx_thread/connections_closed", connections_closed_);
+  status_msg.set_param("rx_thread/messages_received", messages_received_);
+  status_msg.set_param("rx_thread/messages_discarded", messages_discarded_);
+  status_msg.set_param("rx_thread/recv_calls", recv_calls_);
+  status_msg.set_param("rx_thread/byte_rate", byte_rate);
 }
 
-void FrameReceiverTCPRxThread::handle_receive_socket(int recv_socket_,
-                                                     int recv_port) {
-  // Receive a message from the main thread channel and place it directly into
-  // the provided memory buffer
-  void *frame_buffer = frame_decoder_->get_next_message_buffer();
-  size_t message_size = frame_decoder_->get_next_message_size();
-  size_t bytes_received = 0;
+//! Set the receive buffer size of a socket.
+//!
+//! This method sets the kernel receive buffer size of a socket to the
+//! configured value. This must be done before a connection is established for
+//! the TCP window to be scaled to suit the buffer size. The size granted by the
+//! kernel is read back and a warning logged if it was limited by the system
+//! maximum.
+//!
+//! \param[in] socket_fd - socket file descriptor
+//! \param[in] rx_port - port number the socket is used for
+//! \return true if the buffer size was set, false otherwise
+//!
+bool FrameReceiverTCPRxThread::set_receive_buffer_size(int socket_fd,
+                                                       uint16_t rx_port) {
+  if (setsockopt(socket_fd, SOL_SOCKET, SO_RCVBUF,
+                 &config_.rx_recv_buffer_size_,
+                 sizeof(config_.rx_recv_buffer_size_)) < 0) {
+    std::stringstream ss;
+    ss << "RX channel failed to set receive socket buffer size for port "
+       << rx_port << " : " << strerror(errno);
+    this->set_thread_init_error(ss.str());
+    return false;
+  }
+
+  // Read it back and display, allowing for the kernel doubling the value to
+  // account for bookkeeping overhead
+  int buffer_size;
+  socklen_t len = sizeof(buffer_size);
+  getsockopt(socket_fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, &len);
+  LOG4CXX_DEBUG_LEVEL(1, logger_,
+                      "RX thread receive buffer size for port "
+                          << rx_port << " is " << buffer_size / 2);
+  if ((unsigned int)(buffer_size / 2) < config_.rx_recv_buffer_size_) {
+    LOG4CXX_WARN(logger_, "RX thread receive buffer size for port "
+                              << rx_port << " limited to " << buffer_size / 2
+                              << " bytes, less than the requested "
+                              << config_.rx_recv_buffer_size_
+                              << ", check net.core.rmem_max");
+  }
+  return true;
+}
+
+//! Open a socket listening for connections on a receive port.
+//!
+//! \param[in] rx_port - port number to listen on
+//! \param[in] recv_addr - local address to listen on
+//! \return true if the socket was opened, false otherwise
+//!
+bool FrameReceiverTCPRxThread::open_listener(uint16_t rx_port,
+                                             struct sockaddr_in &recv_addr) {
+  int listen_socket = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_socket < 0) {
+    std::stringstream ss;
+    ss << "RX channel failed to create listening socket for port " << rx_port
+       << " : " << strerror(errno);
+    this->set_thread_init_error(ss.str());
+    return false;
+  }
+
+  // Listening sockets serviced by the reactor are non-blocking, so that all
+  // pending connections can be accepted until none remain
+  if (!this->using_uring()) {
+    fcntl(listen_socket, F_SETFL, fcntl(listen_socket, F_GETFL) | O_NONBLOCK);
+  }
+
+  int reuse_addr = 1;
+  if (setsockopt(listen_socket, SOL_SOCKET, SO_REUSEADDR, &reuse_addr,
+                 sizeof(reuse_addr)) < 0) {
+    std::stringstream ss;
+    ss << "RX channel failed to set address reuse on listening socket for port "
+       << rx_port << " : " << strerror(errno);
+    this->set_thread_init_error(ss.str());
+    close(listen_socket);
+    return false;
+  }
+
+  // Accepted connections inherit the receive buffer size of the listener
+  if (!this->set_receive_buffer_size(listen_socket, rx_port)) {
+    close(listen_socket);
+    return false;
+  }
+
+  if ((bind(listen_socket, (struct sockaddr *)&recv_addr, sizeof(recv_addr)) <
+       0) ||
+      (listen(listen_socket, Defaults::default_rx_tcp_listen_backlog) < 0)) {
+    std::stringstream ss;
+    ss << "RX channel failed to listen on address " << config_.rx_address_
+       << " port " << rx_port << " : " << strerror(errno);
+    this->set_thread_init_error(ss.str());
+    close(listen_socket);
+    return false;
+  }
+
+  TcpListener listener;
+  memset(&listener, 0, sizeof(listener));
+  listener.socket_fd = listen_socket;
+  listener.recv_port = rx_port;
+  listeners_.push_back(listener);
+
+  if (!this->using_uring()) {
+    reactor_.register_socket(
+        listen_socket, boost::bind(&FrameReceiverTCPRxThread::handle_accept,
+                                   this, (unsigned int)(listeners_.size() - 1)));
+  }
+
+  LOG4CXX_INFO(logger_, "RX thread listening for connections on address "
+                            << config_.rx_address_ << " port " << rx_port);
+  return true;
+}
+
+//! Connect to a receive port as a client.
+//!
+//! \param[in] rx_port - port number to connect to
+//! \param[in] recv_addr - address to connect to
+//! \return true if the connection was made, false otherwise
+//!
+bool FrameReceiverTCPRxThread::connect_to_port(uint16_t rx_port,
+                                               struct sockaddr_in &recv_addr) {
+  int recv_socket = socket(AF_INET, SOCK_STREAM, 0);
+  if (recv_socket < 0) {
+    std::stringstream ss;
+    ss << "RX channel failed to create receive socket for port " << rx_port
+       << " : " << strerror(errno);
+    this->set_thread_init_error(ss.str());
+    return false;
+  }
+
+  if (!this->set_receive_buffer_size(recv_socket, rx_port)) {
+    close(recv_socket);
+    return false;
+  }
+
+  if (connect(recv_socket, (struct sockaddr *)&recv_addr, sizeof(recv_addr)) ==
+      -1) {
+    std::stringstream ss;
+    ss << "RX channel failed to connect receive socket to address "
+       << config_.rx_address_ << " port " << rx_port << " : "
+       << strerror(errno);
+    this->set_thread_init_error(ss.str());
+    close(recv_socket);
+    return false;
+  }
+
+  // Sockets serviced by the reactor are read without blocking
+  if (!this->using_uring()) {
+    fcntl(recv_socket, F_SETFL, fcntl(recv_socket, F_GETFL) | O_NONBLOCK);
+  }
+
+  this->add_connection(recv_socket, rx_port, recv_addr);
+  return true;
+}
+
+//! Add a connection to those serviced by the thread.
+//!
+//! This method adds a connected socket to the connection list, reusing the
+//! slot of a closed connection if one is available, and starts waiting for
+//! messages on it, either with the reactor or through the io_uring instance.
+//!
+//! \param[in] socket_fd - connected socket file descriptor
+//! \param[in] recv_port - local port number of the connection
+//! \param[in] peer_addr - address of the remote end of the connection
+//! \return index of the connection in the connection list
+//!
+unsigned int
+FrameReceiverTCPRxThread::add_connection(int socket_fd, int recv_port,
+                                         const struct sockaddr_in &peer_addr) {
+  unsigned int connection_idx = 0;
+  while ((connection_idx < connections_.size()) &&
+         (connections_[connection_idx]->socket_fd >= 0)) {
+    connection_idx++;
+  }
+  if (connection_idx == connections_.size()) {
+    connections_.push_back(TcpConnectionPtr());
+  }
+  connections_[connection_idx].reset(new TcpConnection());
+
+  TcpConnection &connection = *connections_[connection_idx];
+  std::stringstream peer;
+  peer << inet_ntoa(peer_addr.sin_addr) << ":" << ntohs(peer_addr.sin_port);
+  connection.socket_fd = socket_fd;
+  connection.recv_port = recv_port;
+  connection.peer = peer.str();
+  gettime(&connection.rate_time, true);
+
+#ifdef HAVE_IO_URING
+  if (uring_) {
+    this->submit_uring_poll(connection_idx);
+  } else
+#endif
+  {
+    reactor_.register_socket(
+        socket_fd, boost::bind(&FrameReceiverTCPRxThread::handle_receive_socket,
+                               this, connection_idx));
+  }
+
+  LOG4CXX_INFO(logger_, "RX thread opened connection on port "
+                            << recv_port << " with " << connection.peer);
+  return connection_idx;
+}
+
+//! Close a connection.
+//!
+//! If the connection owned the decoder part way through a message, the partial
+//! message is discarded and reception resumes on any paused connections.
+//!
+//! \param[in] connection_idx - index of the connection in the connection list
+//!
+void FrameReceiverTCPRxThread::close_connection(unsigned int connection_idx) {
+  TcpConnection &connection = *connections_[connection_idx];
+  if (connection.socket_fd < 0) {
+    return;
+  }
+
+  if (!this->using_uring()) {
+    reactor_.remove_socket(connection.socket_fd);
+  }
+  close(connection.socket_fd);
+  connection.socket_fd = -1;
+  connection.paused = false;
+  connections_closed_++;
 
-  while (bytes_received < message_size) {
-    int msg_len =
-        read(recv_socket_, frame_buffer, message_size - bytes_received);
-    bytes_received += msg_len;
-    frame_buffer += msg_len;
+  if (active_connection_ == (int)connection_idx) {
+    active_connection_ = -1;
+    if (connection.bytes_received > 0) {
+      LOG4CXX_WARN(logger_, "RX thread discarded partial message of "
+                                << connection.bytes_received << " bytes from "
+                                << connection.peer);
+      messages_discarded_++;
+    }
+    this->resume_paused_connections();
+  }
+}
+
+//! Close all listening and connection sockets.
+void FrameReceiverTCPRxThread::close_sockets(void) {
+  for (std::vector<TcpListener>::iterator listener_itr = listeners_.begin();
+       listener_itr != listeners_.end(); listener_itr++) {
+    reactor_.remove_socket(listener_itr->socket_fd);
+    close(listener_itr->socket_fd);
+  }
+  listeners_.clear();
+
+  for (std::vector<TcpConnectionPtr>::iterator connection_itr =
+           connections_.begin();
+       connection_itr != connections_.end(); connection_itr++) {
+    if ((*connection_itr)->socket_fd >= 0) {
+      reactor_.remove_socket((*connection_itr)->socket_fd);
+      close((*connection_itr)->socket_fd);
+    }
+  }
+  connections_.clear();
+  active_connection_ = -1;
+}
+
+//! Handle incoming connections on a listening socket.
+//!
+//! This method is called by the reactor when a listening socket is readable
+//! and accepts all pending connections as non-blocking sockets.
+//!
+//! \param[in] listener_idx - index of the listening socket
+//!
+void FrameReceiverTCPRxThread::handle_accept(unsigned int listener_idx) {
+  TcpListener &listener = listeners_[listener_idx];
+  while (true) {
+    struct sockaddr_in peer_addr;
+    socklen_t peer_addr_len = sizeof(peer_addr);
+#ifdef __linux__
+    int socket_fd = accept4(listener.socket_fd, (struct sockaddr *)&peer_addr,
+                            &peer_addr_len, SOCK_NONBLOCK);
+#else
+    int socket_fd = accept(listener.socket_fd, (struct sockaddr *)&peer_addr,
+                           &peer_addr_len);
+    if (socket_fd >= 0) {
+      fcntl(socket_fd, F_SETFL, fcntl(socket_fd, F_GETFL) | O_NONBLOCK);
+    }
+#endif
+    if (socket_fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+        LOG4CXX_ERROR(logger_, "RX thread failed to accept connection on port "
+                                   << listener.recv_port << ": "
+                                   << strerror(errno));
+      }
+      break;
+    }
+    connections_accepted_++;
+    this->add_connection(socket_fd, listener.recv_port, peer_addr);
+  }
+}
+
+//! Handle data available on a connection.
+//!
+//! This method is called by the reactor when a connection is readable. If
+//! another connection owns the decoder part way through a message, the
+//! connection is paused until that message is complete. Otherwise the next
+//! message is received with non-blocking readv calls directly into the frame
+//! buffer regions given by the decoder until either it is complete or no more
+//! data is available, in which case reception resumes when the connection is
+//! next readable.
+//!
+//! \param[in] connection_idx - index of the connection in the connection list
+//!
+void FrameReceiverTCPRxThread::handle_receive_socket(
+    unsigned int connection_idx) {
+  TcpConnection &connection = *connections_[connection_idx];
+  if (connection.socket_fd < 0) {
+    return;
+  }
+
+  if (active_connection_ < 0) {
+    this->start_message(connection_idx);
+  } else if (active_connection_ != (int)connection_idx) {
+    reactor_.remove_socket(connection.socket_fd);
+    connection.paused = true;
+    return;
+  }
+
+  while (true) {
+    ssize_t bytes_received =
+        readv(connection.socket_fd, &connection.regions[connection.region_idx],
+              connection.num_regions - connection.region_idx);
+    recv_calls_++;
+
+    if (bytes_received > 0) {
+      if (this->advance_message(connection, bytes_received)) {
+        this->complete_message(connection_idx);
+        return;
+      }
+    } else if (bytes_received == 0) {
+      LOG4CXX_INFO(logger_, "RX thread connection on port "
+                                << connection.recv_port << " with "
+                                << connection.peer << " closed");
+      this->close_connection(connection_idx);
+      return;
+    } else if (errno == EINTR) {
+      continue;
+    } else if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+      return;
+    } else {
+      LOG4CXX_ERROR(logger_, "RX thread receive on connection with "
+                                 << connection.peer
+                                 << " failed: " << strerror(errno));
+      this->close_connection(connection_idx);
+      return;
+    }
+  }
+}
+
+//! Start receiving a message on a connection.
+//!
+//! This method obtains the frame buffer regions for the next message from the
+//! decoder and gives the connection ownership of the decoder until the message
+//! is complete.
+//!
+//! \param[in] connection_idx - index of the connection in the connection list
+//!
+void FrameReceiverTCPRxThread::start_message(unsigned int connection_idx) {
+  TcpConnection &connection = *connections_[connection_idx];
+  connection.num_regions = frame_decoder_->get_next_message_regions(
+      connection.regions, max_message_regions);
+  connection.region_idx = 0;
+  connection.message_size = 0;
+  for (unsigned int region = 0; region < connection.num_regions; region++) {
+    connection.message_size += connection.regions[region].iov_len;
+  }
+  connection.bytes_received = 0;
+  active_connection_ = connection_idx;
+}
+
+//! Advance the message regions of a connection past received bytes.
+//!
+//! \param[in,out] connection - connection the bytes were received on
+//! \param[in] bytes_received - number of bytes received
+//! \return true if the message is now complete
+//!
+bool FrameReceiverTCPRxThread::advance_message(TcpConnection &connection,
+                                               size_t bytes_received) {
+  connection.bytes_received += bytes_received;
+  connection.total_bytes += bytes_received;
+
+  while ((bytes_received > 0) &&
+         (connection.region_idx < connection.num_regions)) {
+    struct iovec &region = connection.regions[connection.region_idx];
+    if (bytes_received >= region.iov_len) {
+      bytes_received -= region.iov_len;
+      connection.region_idx++;
+    } else {
+      region.iov_base = static_cast<uint8_t *>(region.iov_base) + bytes_received;
+      region.iov_len -= bytes_received;
+      bytes_received = 0;
+    }
+  }
+
+  return (connection.bytes_received >= connection.message_size);
+}
+
+//! Complete a message received on a connection.
+//!
+//! This method passes the complete message to the decoder, releases the
+//! decoder ownership of the connection and resumes reception on any paused
+//! connections.
+//!
+//! \param[in] connection_idx - index of the connection in the connection list
+//!
+void FrameReceiverTCPRxThread::complete_message(unsigned int connection_idx) {
+  TcpConnection &connection = *connections_[connection_idx];
+  frame_decoder_->process_message(connection.bytes_received);
+  connection.messages_received++;
+  connection.bytes_received = 0;
+  messages_received_++;
+  active_connection_ = -1;
+  this->resume_paused_connections();
+}
+
+//! Resume reception on connections paused while another owned the decoder.
+//!
+//! With the reactor, all paused connections are registered again and the first
+//! to be serviced takes ownership of the decoder. With io_uring, the first
+//! paused connection, which is known to have data waiting, takes ownership and
+//! a receive is submitted for it.
+//!
+void FrameReceiverTCPRxThread::resume_paused_connections(void) {
+  for (unsigned int connection_idx = 0; connection_idx < connections_.size();
+       connection_idx++) {
+    TcpConnection &connection = *connections_[connection_idx];
+    if (!connection.paused || (connection.socket_fd < 0)) {
+      continue;
+    }
+    connection.paused = false;
+#ifdef HAVE_IO_URING
+    if (uring_) {
+      this->start_message(connection_idx);
+      this->submit_uring_receive(connection_idx);
+      break;
+    }
+#endif
+    reactor_.register_socket(
+        connection.socket_fd,
+        boost::bind(&FrameReceiverTCPRxThread::handle_receive_socket, this,
+                    connection_idx));
+  }
+}
+
+#ifdef HAVE_IO_URING
+//! Submit an accept on a listening socket to the io_uring instance.
+//!
+//! \param[in] listener_idx - index of the listening socket
+//!
+void FrameReceiverTCPRxThread::submit_uring_accept(unsigned int listener_idx) {
+  TcpListener &listener = listeners_[listener_idx];
+  listener.accept_addr_len = sizeof(listener.accept_addr);
+
+  struct io_uring_sqe *sqe = this->get_uring_sqe();
+  if (!sqe) {
+    return;
+  }
+  sqe->opcode = IORING_OP_ACCEPT;
+  sqe->fd = listener.socket_fd;
+  sqe->addr = reinterpret_cast<uint64_t>(&listener.accept_addr);
+  sqe->addr2 = reinterpret_cast<uint64_t>(&listener.accept_addr_len);
+  sqe->user_data = listener_idx | URING_TAG_TCP_ACCEPT;
+}
+
+//! Submit a poll for the start of the next message on a connection to the
+//! io_uring instance.
+//!
+//! The message buffer is only obtained from the frame decoder once data is
+//! available, as with the reactor, so the start of each message is signalled
+//! by polling the socket for readability.
+//!
+//! \param[in] connection_idx - index of the connection in the connection list
+//!
+void FrameReceiverTCPRxThread::submit_uring_poll(unsigned int connection_idx) {
+  struct io_uring_sqe *sqe = this->get_uring_sqe();
+  if (!sqe) {
+    return;
+  }
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = connections_[connection_idx]->socket_fd;
+  sqe->poll32_events = POLLIN;
+  sqe->user_data = connection_idx | URING_TAG_TCP_POLL;
+}
+
+//! Submit a receive of the current message on a connection to the io_uring
+//! instance.
+//!
+//! The receive scatters the remainder of the message directly into the frame
+//! buffer regions given by the decoder. The receive waits for all the
+//! requested bytes, so that a whole message normally completes as a single
+//! operation.
+//!
+//! \param[in] connection_idx - index of the connection in the connection list
+//!
+void FrameReceiverTCPRxThread::submit_uring_receive(
+    unsigned int connection_idx) {
+  TcpConnection &connection = *connections_[connection_idx];
+  memset(&connection.msg_hdr, 0, sizeof(connection.msg_hdr));
+  connection.msg_hdr.msg_iov = &connection.regions[connection.region_idx];
+  connection.msg_hdr.msg_iovlen =
+      connection.num_regions - connection.region_idx;
+
+  struct io_uring_sqe *sqe = this->get_uring_sqe();
+  if (!sqe) {
+    return;
+  }
+  sqe->opcode = IORING_OP_RECVMSG;
+  sqe->fd = connection.socket_fd;
+  sqe->addr = reinterpret_cast<uint64_t>(&connection.msg_hdr);
+  sqe->len = 1;
+  sqe->msg_flags = MSG_WAITALL;
+  sqe->user_data = connection_idx;
+}
+
+//! Handle an io_uring completion.
+//!
+//! This method is called by the io_uring event loop for each completed accept,
+//! poll or receive. Accepted connections are added to the connection list and
+//! the accept resubmitted. When a connection becomes readable, it either takes
+//! ownership of the decoder and a receive of the next message is submitted, or
+//! is paused if another connection owns the decoder. Once a whole message has
+//! been received it is passed to the frame decoder and the connection is polled
+//! for the next message, otherwise a receive of the remainder of the message
+//! is submitted. Connections are closed when the peer closes them or an error
+//! occurs.
+//!
+//! \param[in] cqe - completion queue entry
+//!
+void FrameReceiverTCPRxThread::handle_uring_completion(
+    struct io_uring_cqe *cqe) {
+  unsigned int idx = cqe->user_data & URING_TAG_TCP_INDEX_MASK;
+
+  if (cqe->user_data & URING_TAG_TCP_ACCEPT) {
+    if ((idx >= listeners_.size()) || (cqe->res == -ECANCELED)) {
+      return;
+    }
+    TcpListener &listener = listeners_[idx];
+    if (cqe->res >= 0) {
+      connections_accepted_++;
+      this->add_connection(cqe->res, listener.recv_port, listener.accept_addr);
+    } else if ((cqe->res != -EINTR) && (cqe->res != -EAGAIN) &&
+               (cqe->res != -ECONNABORTED)) {
+      LOG4CXX_ERROR(logger_, "RX thread failed to accept connection on port "
+                                 << listener.recv_port << ": "
+                                 << strerror(-cqe->res));
+    }
+    this->submit_uring_accept(idx);
+    return;
+  }
+
+  if ((idx >= connections_.size()) || (cqe->res == -ECANCELED)) {
+    return;
+  }
+  TcpConnection &connection = *connections_[idx];
+  if (connection.socket_fd < 0) {
+    return;
+  }
+
+  if (cqe->user_data & URING_TAG_TCP_POLL) {
+    if ((cqe->res == -EINTR) || (cqe->res == -EAGAIN)) {
+      this->submit_uring_poll(idx);
+    } else if (cqe->res < 0) {
+      LOG4CXX_ERROR(logger_, "RX thread poll on connection with "
+                                 << connection.peer
+                                 << " failed: " << strerror(-cqe->res));
+      this->close_connection(idx);
+    } else if ((active_connection_ >= 0) && (active_connection_ != (int)idx)) {
+      connection.paused = true;
+    } else {
+      this->start_message(idx);
+      this->submit_uring_receive(idx);
+    }
+    return;
+  }
+
+  recv_calls_++;
+  if (cqe->res > 0) {
+    if (this->advance_message(connection, cqe->res)) {
+      this->complete_message(idx);
+      this->submit_uring_poll(idx);
+    } else {
+      this->submit_uring_receive(idx);
+    }
+  } else if (cqe->res == 0) {
+    LOG4CXX_INFO(logger_, "RX thread connection on port "
+                              << connection.recv_port << " with "
+                              << connection.peer << " closed");
+    this->close_connection(idx);
+  } else if ((cqe->res == -EINTR) || (cqe->res == -EAGAIN)) {
+    this->submit_uring_receive(idx);
+  } else {
+    LOG4CXX_ERROR(logger_, "RX thread receive on connection with "
+                               << connection.peer
+                               << " failed: " << strerror(-cqe->res));
+    this->close_connection(idx);
   }
-  frame_decoder_->process_message(bytes_received);
 }
+#endif
@@ -6,22 +6,90 @@
  */
 
 #include <unistd.h>
+#include <algorithm>
 
 #include "FrameReceiverUDPRxThread.h"
+#include "gettime.h"
+
+#if defined(__linux__) && !defined(SO_ATTACH_REUSEPORT_CBPF)
+#define SO_ATTACH_REUSEPORT_CBPF 51
+#endif
+
+#if defined(__linux__) && !defined(SO_BUSY_POLL)
+#define SO_BUSY_POLL 46
+#endif
+
+#if defined(__linux__) && !defined(SO_PREFER_BUSY_POLL)
+#define SO_PREFER_BUSY_POLL 69
+#endif
+
+#if defined(__linux__) && !defined(SOL_UDP)
+#define SOL_UDP 17
+#endif
+
+#if defined(__linux__) && !defined(UDP_GRO)
+#define UDP_GRO 104
+#endif
+
+//! Size of the buffer receiving packets coalesced by UDP GRO, which is the largest UDP datagram
+static const size_t gro_buffer_size = 65536;
 
 using namespace FrameReceiver;
 
+#ifdef __linux__
+//! Construct a classic BPF statement for the packet steering filter.
+static struct sock_filter bpf_stmt(uint16_t code, uint32_t k)
+{
+  struct sock_filter insn = BPF_STMT(code, k);
+  return insn;
+}
+#endif
+
 FrameReceiverUDPRxThread::FrameReceiverUDPRxThread(FrameReceiverConfig& config,
                                                    SharedBufferManagerPtr buffer_manager,
                                                    FrameDecoderPtr frame_decoder,
-                                                   unsigned int tick_period_ms) :
-    FrameReceiverRxThread(config, buffer_manager, frame_decoder, tick_period_ms),
-    logger_(log4cxx::Logger::getLogger("FR.UDPRxThread"))
+                                                   unsigned int tick_period_ms,
+                                                   unsigned int thread_index) :
+    FrameReceiverRxThread(config, buffer_manager, frame_decoder, tick_period_ms, thread_index),
+    logger_(log4cxx::Logger::getLogger("FR.UDPRxThread")),
+    recv_batch_size_(config.rx_recv_batch_size_),
+    steer_by_frame_((config.rx_steering_ == Defaults::RxSteeringFrame) && (config.rx_threads_ > 1)),
+    udp_gro_(config.rx_udp_gro_),
+    spin_mode_(config.rx_spin_mode_),
+    recv_flags_(config.rx_spin_mode_ ? MSG_DONTWAIT : 0),
+    spin_polls_(0),
+    spin_polls_with_data_(0),
+    spin_idle_fallbacks_(0),
+    uring_buffer_exhaustions_(0),
+    packets_received_(0),
+    packets_truncated_(0),
+    recv_calls_(0),
+    rate_packets_(0),
+    packet_rate_(0.0)
 {
   LOG4CXX_DEBUG_LEVEL(1, logger_, "FrameReceiverUDPRxThread constructor entered....");
 
   // Store the frame decoder as a UDP type frame decoder
   frame_decoder_ = boost::dynamic_pointer_cast<FrameDecoderUDP>(frame_decoder);
+
+  // Set up the receive slots, message headers and IO vectors used in batched receive mode. Each
+  // message has two IO vectors, for the packet header and payload respectively.
+  if (recv_batch_size_ > 1)
+  {
+    batch_slots_.resize(recv_batch_size_);
+#ifdef __linux__
+    batch_msg_hdrs_.resize(recv_batch_size_);
+#endif
+    batch_iovecs_.resize(recv_batch_size_ * 2);
+  }
+
+  // Set up the buffer that packets coalesced by UDP GRO are received into
+  if (udp_gro_)
+  {
+    gro_buffer_.resize(gro_buffer_size);
+  }
+
+  gettime(&rate_time_, true);
 }
 
 FrameReceiverUDPRxThread::~FrameReceiverUDPRxThread()
@@ -33,7 +101,56 @@ void FrameReceiverUDPRxThread::run_specific_service(void)
 {
   LOG4CXX_DEBUG_LEVEL(1, logger_, "Running UDP RX thread service");
 
-  for (std::vector<uint16_t>::iterator rx_port_itr = config_.rx_ports_.begin(); rx_port_itr != config_.rx_ports_.end(); rx_port_itr++)
+  if (recv_batch_size_ > 1)
+  {
+#ifdef __linux__
+    LOG4CXX_DEBUG_LEVEL(1, logger_, "UDP RX thread receiving up to " << recv_batch_size_
+      << " packets per receive call");
+#else
+    this->set_thread_init_error("Batched packet receive is only supported on Linux");
+    return;
+#endif
+  }
+
+  // If steering packets to RX threads by frame number, build the steering filter program from
+  // the frame number field location specified by the decoder
+  if (steer_by_frame_)
+  {
+#ifdef __linux__
+    if (!this->build_steering_filter())
+    {
+      this->set_thread_init_error(
+          "RX channel cannot steer packets by frame: decoder does not specify frame number field");
+      return;
+    }
+#else
+    this->set_thread_init_error("RX steering by frame is only supported on Linux");
+    return;
+#endif
+    LOG4CXX_DEBUG_LEVEL(1, logger_, "UDP RX thread " << thread_index_
+      << " steering packets by frame number across " << config_.rx_threads_ << " RX threads");
+  }
+
+#ifdef HAVE_IO_URING
+  // If using the io_uring engine, register the ring of buffers that multishot receives on all
+  // sockets take packets into
+  if (uring_)
+  {
+    try
+    {
+      uring_->register_buffer_ring(0, config_.rx_uring_buffers_, config_.rx_uring_buffer_size_);
+    }
+    catch (FrameReceiverIoUringException& e)
+    {
+      this->set_thread_init_error(e.what());
+      return;
+    }
+    LOG4CXX_DEBUG_LEVEL(1, logger_, "UDP RX thread receiving with io_uring into "
+      << config_.rx_uring_buffers_ << " buffers of " << config_.rx_uring_buffer_size_ << " bytes");
+  }
+#endif
+
+  for (std::vector<uint16_t>::iterator rx_port_itr = rx_ports_.begin(); rx_port_itr != rx_ports_.end(); rx_port_itr++)
   {
 
     uint16_t rx_port = *rx_port_itr;
@@ -63,6 +180,72 @@ void FrameReceiverUDPRxThread::run_specific_service(void)
     getsockopt(recv_socket, SOL_SOCKET, SO_RCVBUF, &buffer_size, &len);
     LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread receive buffer size for port " << rx_port << " is " << buffer_size / 2);
 
+    // Enable busy polling of the device queue on receive if requested, optionally preferring
+    // busy polling over interrupt-driven processing
+#ifdef __linux__
+    if (config_.rx_busy_poll_us_ > 0)
+    {
+      int busy_poll_us = config_.rx_busy_poll_us_;
+      if (setsockopt(recv_socket, SOL_SOCKET, SO_BUSY_POLL, &busy_poll_us, sizeof(busy_poll_us)) < 0)
+      {
+        std::stringstream ss;
+        ss << "RX channel failed to set busy poll time for port " << rx_port << " : " << strerror(errno);
+        this->set_thread_init_error(ss.str());
+        return;
+      }
+    }
+    if (config_.rx_prefer_busy_poll_)
+    {
+      int prefer_busy_poll = 1;
+      if (setsockopt(recv_socket, SOL_SOCKET, SO_PREFER_BUSY_POLL,
+          &prefer_busy_poll, sizeof(prefer_busy_poll)) < 0)
+      {
+        std::stringstream ss;
+        ss << "RX channel failed to set prefer busy poll for port " << rx_port << " : " << strerror(errno);
+        this->set_thread_init_error(ss.str());
+        return;
+      }
+    }
+#else
+    if ((config_.rx_busy_poll_us_ > 0) || config_.rx_prefer_busy_poll_)
+    {
+      this->set_thread_init_error("RX socket busy polling is only supported on Linux");
+      return;
+    }
+#endif
+
+    // Enable generic receive offload if requested, so that consecutive packets of a flow are
+    // coalesced by the kernel and received in a single call
+    if (udp_gro_)
+    {
+#ifdef __linux__
+      int udp_gro = 1;
+      if (setsockopt(recv_socket, SOL_UDP, UDP_GRO, &udp_gro, sizeof(udp_gro)) < 0)
+      {
+        std::stringstream ss;
+        ss << "RX channel failed to enable UDP GRO for port " << rx_port << " : " << strerror(errno);
+        this->set_thread_init_error(ss.str());
+        return;
+      }
+#else
+      this->set_thread_init_error("UDP GRO is only supported on Linux");
+      return;
+#endif
+    }
+
+    // Allow the RX threads to share the port if steering packets by frame number
+    if (steer_by_frame_)
+    {
+      int reuse_port = 1;
+      if (setsockopt(recv_socket, SOL_SOCKET, SO_REUSEPORT, &reuse_port, sizeof(reuse_port)) < 0)
+      {
+        std::stringstream ss;
+        ss << "RX channel failed to enable port reuse for port " << rx_port << " : " << strerror(errno);
+        this->set_thread_init_error(ss.str());
+        return;
+      }
+    }
+
     // Bind the socket to the specified port
     struct sockaddr_in recv_addr;
     memset(&recv_addr, 0, sizeof(recv_addr));
@@ -87,8 +270,124 @@ void FrameReceiverUDPRxThread::run_specific_service(void)
       return;
     }
 
-    // Register this socket
-    this->register_socket(recv_socket, boost::bind(&FrameReceiverUDPRxThread::handle_receive_socket, this, recv_socket, (int)rx_port));
+    // Attach the steering filter to the group of sockets sharing the port. The filter returns the
+    // index of the socket in the group, which follows the order in which the sockets were bound.
+    // Since the RX threads are started, and therefore bind, in order of their thread index,
+    // each packet is received by the thread whose index matches that returned by the filter.
+#ifdef __linux__
+    if (steer_by_frame_)
+    {
+      struct sock_fprog steering_prog;
+      steering_prog.len = steering_filter_.size();
+      steering_prog.filter = &steering_filter_[0];
+      if (setsockopt(recv_socket, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+          &steering_prog, sizeof(steering_prog)) < 0)
+      {
+        std::stringstream ss;
+        ss << "RX channel failed to attach steering filter for port " << rx_port << " : " << strerror(errno);
+        this->set_thread_init_error(ss.str());
+        return;
+      }
+    }
+#endif
+
+    // Register this socket, either with the reactor or for receiving through io_uring
+    if (this->using_uring())
+    {
+      this->track_socket(recv_socket);
+      UringSocket uring_socket;
+      memset(&uring_socket, 0, sizeof(uring_socket));
+      uring_socket.socket_fd = recv_socket;
+      uring_socket.recv_port = rx_port;
+      uring_socket.msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+      uring_sockets_.push_back(uring_socket);
+    }
+    else
+    {
+      this->register_socket(recv_socket, boost::bind(&FrameReceiverUDPRxThread::handle_receive_socket, this, recv_socket, (int)rx_port));
+      spin_sockets_.push_back(std::make_pair(recv_socket, (int)rx_port));
+    }
+  }
+
+#ifdef HAVE_IO_URING
+  // Submit a multishot receive on each socket once the list of sockets is complete
+  for (unsigned int socket_idx = 0; socket_idx < uring_sockets_.size(); socket_idx++)
+  {
+    this->submit_uring_receive(socket_idx);
+  }
+#endif
+}
+
+//! Run the UDP RX thread event loop.
+//!
+//! This method runs the event loop of the UDP RX thread. By default the reactor is run, blocking
+//! until the receive sockets are readable. In spin mode, the receive sockets are instead polled
+//! continuously with non-blocking receives, trading CPU for reduced latency and jitter. The reactor
+//! is run without blocking every configured number of iterations to service the RX channel and
+//! timers. If no packets are received for the configured idle timeout, the loop falls back to
+//! blocking in the reactor until packets arrive, before resuming spinning.
+//!
+void FrameReceiverUDPRxThread::run_event_loop(void)
+{
+  if (!spin_mode_)
+  {
+    FrameReceiverRxThread::run_event_loop();
+    return;
+  }
+
+  LOG4CXX_DEBUG_LEVEL(1, logger_, "UDP RX thread spinning on receive sockets, checking reactor every "
+    << config_.rx_spin_check_interval_ << " iterations");
+
+  unsigned int spin_count = 0;
+  uint64_t packets_at_check = packets_received_;
+  TimeMs last_data_ms = IpcReactorTimer::clock_mono_ms();
+
+  while (!reactor_.is_stopped())
+  {
+    // Poll each receive socket without blocking
+    unsigned int packets = 0;
+    for (std::vector<std::pair<int, int> >::iterator sock_itr = spin_sockets_.begin();
+        sock_itr != spin_sockets_.end(); ++sock_itr)
+    {
+      packets += this->receive_packets(sock_itr->first, sock_itr->second);
+    }
+    spin_polls_++;
+    if (packets)
+    {
+      spin_polls_with_data_++;
+    }
+
+    if (++spin_count < config_.rx_spin_check_interval_)
+    {
+      continue;
+    }
+    spin_count = 0;
+
+    // Check the time since data was last received and fall back to blocking if idle for longer
+    // than the timeout, otherwise service the reactor without blocking
+    TimeMs now_ms = IpcReactorTimer::clock_mono_ms();
+    if (packets_received_ != packets_at_check)
+    {
+      last_data_ms = now_ms;
+    }
+
+    if ((config_.rx_spin_idle_timeout_ms_ > 0) &&
+        ((now_ms - last_data_ms) >= (TimeMs)config_.rx_spin_idle_timeout_ms_))
+    {
+      LOG4CXX_DEBUG_LEVEL(2, logger_, "UDP RX thread idle, blocking until packets received");
+      spin_idle_fallbacks_++;
+      uint64_t packets_at_block = packets_received_;
+      while (!reactor_.is_stopped() && (packets_received_ == packets_at_block))
+      {
+        reactor_.run_once();
+      }
+      last_data_ms = IpcReactorTimer::clock_mono_ms();
+    }
+    else
+    {
+      reactor_.run_once(0);
+    }
+    packets_at_check = packets_received_;
   }
 }
 
@@ -96,7 +395,100 @@ void FrameReceiverUDPRxThread::cleanup_specific_service(void)
 {
 }
 
+#ifdef __linux__
+//! Build the packet steering filter.
+//!
+//! This method builds a classic BPF program that selects the receiving socket for each packet
+//! from its frame number, so that all packets of a frame are received by the same RX thread and
+//! decoder. The kernel runs the program with the UDP payload at offset zero. The frame number is
+//! assembled a byte at a time from the field described by the decoder, which allows for either
+//! byte order, and the program returns the frame number modulo the number of RX threads.
+//!
+//! \return true if the filter was built, false if the decoder does not describe the field
+//!
+bool FrameReceiverUDPRxThread::build_steering_filter(void)
+{
+  FrameNumberField field;
+  if (!frame_decoder_->get_frame_number_field(field) || (field.width < 1) || (field.width > 4))
+  {
+    return false;
+  }
+
+  steering_filter_.clear();
+  for (size_t byte_idx = 0; byte_idx < field.width; byte_idx++)
+  {
+    // Load the bytes of the field from most to least significant, shifting the accumulated
+    // value up before OR-ing in each subsequent byte
+    size_t byte_offset = field.offset + (field.big_endian ? byte_idx : (field.width - 1 - byte_idx));
+    if (byte_idx > 0)
+    {
+      steering_filter_.push_back(bpf_stmt(BPF_ALU | BPF_LSH | BPF_K, 8));
+      steering_filter_.push_back(bpf_stmt(BPF_MISC | BPF_TAX, 0));
+    }
+    steering_filter_.push_back(bpf_stmt(BPF_LD | BPF_B | BPF_ABS, byte_offset));
+    if (byte_idx > 0)
+    {
+      steering_filter_.push_back(bpf_stmt(BPF_ALU | BPF_OR | BPF_X, 0));
+    }
+  }
+  steering_filter_.push_back(bpf_stmt(BPF_ALU | BPF_MOD | BPF_K, config_.rx_threads_));
+  steering_filter_.push_back(bpf_stmt(BPF_RET | BPF_A, 0));
+
+  return true;
+}
+#endif
+
+//! Handle a packet receive event on a socket.
+//!
+//! This method is the handler registered with the reactor for each receive socket and is
+//! called when a socket becomes readable. Packets are received either individually or,
+//! if a receive batch size greater than one is configured, in batches.
+//!
+//! \param[in] recv_socket - file descriptor of the socket to receive on
+//! \param[in] recv_port - port number of the socket
+//!
 void FrameReceiverUDPRxThread::handle_receive_socket(int recv_socket, int recv_port)
+{
+  this->receive_packets(recv_socket, recv_port);
+}
+
+//! Receive packets from a socket.
+//!
+//! This method receives packets from a socket, either individually, coalesced by UDP GRO if
+//! enabled or, if a receive batch size greater than one is configured, in batches.
+//!
+//! \param[in] recv_socket - file descriptor of the socket to receive on
+//! \param[in] recv_port - port number of the socket
+//! \return number of packets received
+//!
+unsigned int FrameReceiverUDPRxThread::receive_packets(int recv_socket, int recv_port)
+{
+#ifdef __linux__
+  if (udp_gro_)
+  {
+    return this->receive_coalesced_packets(recv_socket, recv_port);
+  }
+  else if (recv_batch_size_ > 1)
+  {
+    return this->receive_packet_batch(recv_socket, recv_port);
+  }
+#endif
+  return this->receive_packet(recv_socket, recv_port);
+}
+
+//! Receive a single packet from a socket.
+//!
+//! This method receives a single packet into the buffers specified by the frame decoder. If
+//! the decoder requires the packet header to determine where the payload should be received,
+//! the header and payload are received in one call into a payload buffer predicted by the
+//! decoder where possible, otherwise the header is peeked at first. In spin mode the socket is
+//! read without blocking, in which case no packet may be available.
+//!
+//! \param[in] recv_socket - file descriptor of the socket to receive on
+//! \param[in] recv_port - port number of the socket
+//! \return number of packets received
+//!
+unsigned int FrameReceiverUDPRxThread::receive_packet(int recv_socket, int recv_port)
 {
 
   struct iovec io_vec[2];
@@ -104,12 +496,40 @@ void FrameReceiverUDPRxThread::handle_receive_socket(int recv_socket, int recv_p
 
   struct sockaddr_in from_addr;
 
+  // If the decoder needs to inspect the packet header and can predict where the payload will
+  // land, receive the header and payload in a single call and let the decoder relocate the
+  // payload if the prediction was wrong
+  void* predicted_payload_buffer = 0;
   if (frame_decoder_->requires_header_peek())
+  {
+    predicted_payload_buffer = frame_decoder_->get_predicted_payload_buffer();
+  }
+
+  if (predicted_payload_buffer)
+  {
+    io_vec[iovec_entry].iov_base = frame_decoder_->get_packet_header_buffer();
+    io_vec[iovec_entry].iov_len  = frame_decoder_->get_packet_header_size();
+    iovec_entry++;
+    io_vec[iovec_entry].iov_base = predicted_payload_buffer;
+    io_vec[iovec_entry].iov_len  = frame_decoder_->get_next_payload_size();
+    iovec_entry++;
+  }
+  else if (frame_decoder_->requires_header_peek())
   {
     size_t header_size = frame_decoder_->get_packet_header_size();
     void*  header_buffer = frame_decoder_->get_packet_header_buffer();
     socklen_t from_len = sizeof(from_addr);
-    size_t bytes_received = recvfrom(recv_socket, header_buffer, header_size, MSG_PEEK, (struct sockaddr*)&from_addr, &from_len);
+    ssize_t bytes_received = recvfrom(recv_socket, header_buffer, header_size, MSG_PEEK | recv_flags_, (struct sockaddr*)&from_addr, &from_len);
+    recv_calls_++;
+    if (bytes_received < 0)
+    {
+      if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+      {
+        LOG4CXX_ERROR(logger_, "RX thread header receive on port " << recv_port << " failed: "
+          << strerror(errno));
+      }
+      return 0;
+    }
     LOG4CXX_DEBUG_LEVEL(3, logger_, "RX thread received " << bytes_received << " header bytes on recv socket");
     frame_decoder_->process_packet_header(bytes_received, recv_port, &from_addr);
 
@@ -118,9 +538,12 @@ void FrameReceiverUDPRxThread::handle_receive_socket(int recv_socket, int recv_p
     iovec_entry++;
   }
 
-  io_vec[iovec_entry].iov_base = frame_decoder_->get_next_payload_buffer();
-  io_vec[iovec_entry].iov_len  = frame_decoder_->get_next_payload_size();
-  iovec_entry++;
+  if (!predicted_payload_buffer)
+  {
+    io_vec[iovec_entry].iov_base = frame_decoder_->get_next_payload_buffer();
+    io_vec[iovec_entry].iov_len  = frame_decoder_->get_next_payload_size();
+    iovec_entry++;
+  }
 
   struct msghdr msg_hdr;
   memset((void*)&msg_hdr,  0, sizeof(struct msghdr));
@@ -129,9 +552,347 @@ void FrameReceiverUDPRxThread::handle_receive_socket(int recv_socket, int recv_p
   msg_hdr.msg_iov = io_vec;
   msg_hdr.msg_iovlen = iovec_entry;
 
-  size_t bytes_received = recvmsg(recv_socket, &msg_hdr, 0);
+  ssize_t bytes_received = recvmsg(recv_socket, &msg_hdr, recv_flags_);
+  recv_calls_++;
+  if (bytes_received < 0)
+  {
+    if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+    {
+      LOG4CXX_ERROR(logger_, "RX thread receive on port " << recv_port << " failed: "
+        << strerror(errno));
+    }
+    return 0;
+  }
+  if (msg_hdr.msg_flags & MSG_TRUNC)
+  {
+    packets_truncated_++;
+    return 0;
+  }
   LOG4CXX_DEBUG_LEVEL(3, logger_, "RX thread received " << bytes_received << " header/payload bytes on recv socket, "
-      "payload buffer address " << frame_decoder_->get_next_payload_buffer());
+      "payload buffer address " << io_vec[iovec_entry - 1].iov_base);
+
+  packets_received_++;
+
+  FrameDecoder::FrameReceiveState frame_receive_state;
+  if (predicted_payload_buffer)
+  {
+    frame_receive_state = frame_decoder_->process_predicted_packet(bytes_received, recv_port, &from_addr);
+  }
+  else
+  {
+    frame_receive_state = frame_decoder_->process_packet(bytes_received, recv_port, &from_addr);
+  }
+
+  return 1;
+}
+
+#ifdef __linux__
+//! Receive a batch of packets from a socket.
+//!
+//! This method receives up to the configured batch size of packets in a single recvmmsg call,
+//! into the receive slots supplied by the frame decoder. The socket is read without blocking,
+//! so that only packets already queued are received. Packets truncated by their slot or too
+//! short to hold a packet header are discarded, and the remaining packets are passed back to
+//! the decoder for processing as a batch.
+//!
+//! \param[in] recv_socket - file descriptor of the socket to receive on
+//! \param[in] recv_port - port number of the socket
+//! \return number of packets received
+//!
+unsigned int FrameReceiverUDPRxThread::receive_packet_batch(int recv_socket, int recv_port)
+{
+  unsigned int num_slots = frame_decoder_->get_next_payload_slots(recv_batch_size_, &batch_slots_[0]);
+
+  for (unsigned int slot = 0; slot < num_slots; slot++)
+  {
+    struct iovec* io_vec = &batch_iovecs_[slot * 2];
+    unsigned int iovec_entry = 0;
+
+    if (batch_slots_[slot].header_buffer)
+    {
+      io_vec[iovec_entry].iov_base = batch_slots_[slot].header_buffer;
+      io_vec[iovec_entry].iov_len  = batch_slots_[slot].header_size;
+      iovec_entry++;
+    }
+    io_vec[iovec_entry].iov_base = batch_slots_[slot].payload_buffer;
+    io_vec[iovec_entry].iov_len  = batch_slots_[slot].payload_size;
+    iovec_entry++;
+
+    struct msghdr& msg_hdr = batch_msg_hdrs_[slot].msg_hdr;
+    memset((void*)&msg_hdr,  0, sizeof(struct msghdr));
+    msg_hdr.msg_name = (void*)&(batch_slots_[slot].from_addr);
+    msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    msg_hdr.msg_iov = io_vec;
+    msg_hdr.msg_iovlen = iovec_entry;
+  }
+
+  int packets_received = recvmmsg(recv_socket, &batch_msg_hdrs_[0], num_slots, MSG_DONTWAIT, NULL);
+  recv_calls_++;
+
+  if (packets_received < 0)
+  {
+    if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+    {
+      LOG4CXX_ERROR(logger_, "RX thread batch receive on port " << recv_port << " failed: "
+        << strerror(errno));
+    }
+    return 0;
+  }
+
+  LOG4CXX_DEBUG_LEVEL(3, logger_, "RX thread received " << packets_received
+    << " packets in batch on recv socket");
+
+  unsigned int packets_complete = 0;
+  for (int pkt = 0; pkt < packets_received; pkt++)
+  {
+    if ((batch_msg_hdrs_[pkt].msg_hdr.msg_flags & MSG_TRUNC) ||
+        (batch_msg_hdrs_[pkt].msg_len < batch_slots_[pkt].header_size))
+    {
+      packets_truncated_++;
+      continue;
+    }
+    if (packets_complete != static_cast<unsigned int>(pkt))
+    {
+      batch_slots_[packets_complete] = batch_slots_[pkt];
+    }
+    batch_slots_[packets_complete].bytes_received = batch_msg_hdrs_[pkt].msg_len;
+    packets_complete++;
+  }
+  packets_received_ += packets_complete;
+
+  frame_decoder_->process_packets(packets_complete, &batch_slots_[0], recv_port);
+
+  return packets_complete;
+}
+#endif
+
+#ifdef __linux__
+//! Receive packets coalesced by UDP GRO from a socket.
+//!
+//! This method receives a run of consecutive packets from the same flow, coalesced by the kernel
+//! into a single buffer, in one call. The size of each packet in the buffer is given by the
+//! segment size reported in a control message; if none is present a single packet was received.
+//! The run is then passed to the decoder, which splits it into packets and places each into the
+//! frame buffers.
+//!
+//! \param[in] recv_socket - file descriptor of the socket to receive on
+//! \param[in] recv_port - port number of the socket
+//! \return number of packets received
+//!
+unsigned int FrameReceiverUDPRxThread::receive_coalesced_packets(int recv_socket, int recv_port)
+{
+  struct sockaddr_in from_addr;
+  struct iovec io_vec;
+  io_vec.iov_base = &gro_buffer_[0];
+  io_vec.iov_len = gro_buffer_.size();
+
+  char control[CMSG_SPACE(sizeof(int))];
+
+  struct msghdr msg_hdr;
+  memset((void*)&msg_hdr, 0, sizeof(struct msghdr));
+  msg_hdr.msg_name = (void*)&from_addr;
+  msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+  msg_hdr.msg_iov = &io_vec;
+  msg_hdr.msg_iovlen = 1;
+  msg_hdr.msg_control = control;
+  msg_hdr.msg_controllen = sizeof(control);
+
+  ssize_t bytes_received = recvmsg(recv_socket, &msg_hdr, recv_flags_);
+  recv_calls_++;
+  if (bytes_received <= 0)
+  {
+    if ((bytes_received < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK))
+    {
+      LOG4CXX_ERROR(logger_, "RX thread coalesced receive on port " << recv_port << " failed: "
+        << strerror(errno));
+    }
+    return 0;
+  }
+  if (msg_hdr.msg_flags & MSG_TRUNC)
+  {
+    packets_truncated_++;
+    return 0;
+  }
+
+  size_t packet_size = bytes_received;
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg_hdr); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg_hdr, cmsg))
+  {
+    if ((cmsg->cmsg_level == SOL_UDP) && (cmsg->cmsg_type == UDP_GRO))
+    {
+      int segment_size;
+      memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+      if (segment_size > 0)
+      {
+        packet_size = segment_size;
+      }
+    }
+  }
+
+  LOG4CXX_DEBUG_LEVEL(3, logger_, "RX thread received " << bytes_received
+    << " coalesced bytes in packets of " << packet_size << " bytes on recv socket");
+
+  unsigned int packets_received = frame_decoder_->process_packet_run(
+      &gro_buffer_[0], bytes_received, packet_size, recv_port, &from_addr);
+  packets_received_ += packets_received;
+
+  return packets_received;
+}
+#endif
+
+#ifdef HAVE_IO_URING
+//! Submit a multishot receive on a socket to the io_uring instance.
+//!
+//! The receive remains active, completing once for each packet received into a buffer taken from
+//! the provided buffer ring, until it is terminated by the kernel, e.g. when the buffers are
+//! exhausted, at which point it is resubmitted by the completion handler.
+//!
+//! \param[in] socket_idx - index of the socket in the io_uring socket list
+//!
+void FrameReceiverUDPRxThread::submit_uring_receive(unsigned int socket_idx)
+{
+  struct io_uring_sqe* sqe = this->get_uring_sqe();
+  if (!sqe)
+  {
+    return;
+  }
+  sqe->opcode = IORING_OP_RECVMSG;
+  sqe->fd = uring_sockets_[socket_idx].socket_fd;
+  sqe->addr = reinterpret_cast<uint64_t>(&(uring_sockets_[socket_idx].msg_hdr));
+  sqe->len = 1;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = 0;
+  sqe->user_data = socket_idx;
+}
+
+//! Handle an io_uring receive completion.
+//!
+//! This method is called by the io_uring event loop for each completion of a multishot receive.
+//! A received packet is processed and its buffer returned to the provided buffer ring. If the
+//! receive has terminated because the buffers were exhausted, it is resubmitted; any other error
+//! stops reception on the socket.
+//!
+//! \param[in] cqe - completion queue entry
+//!
+void FrameReceiverUDPRxThread::handle_uring_completion(struct io_uring_cqe* cqe)
+{
+  unsigned int socket_idx = cqe->user_data;
+  if (socket_idx >= uring_sockets_.size())
+  {
+    return;
+  }
+
+  if (cqe->flags & IORING_CQE_F_BUFFER)
+  {
+    uint16_t buffer_id = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+    if (cqe->res > 0)
+    {
+      this->process_uring_packet(socket_idx, uring_->get_buffer(buffer_id), cqe->res);
+    }
+    uring_->recycle_buffer(buffer_id);
+    uring_->publish_buffers();
+  }
+
+  if (!(cqe->flags & IORING_CQE_F_MORE))
+  {
+    if ((cqe->res >= 0) || (cqe->res == -ENOBUFS))
+    {
+      if (cqe->res == -ENOBUFS)
+      {
+        uring_buffer_exhaustions_++;
+      }
+      this->submit_uring_receive(socket_idx);
+    }
+    else if (cqe->res != -ECANCELED)
+    {
+      LOG4CXX_ERROR(logger_, "RX thread io_uring receive on port "
+        << uring_sockets_[socket_idx].recv_port << " failed: " << strerror(-cqe->res));
+    }
+  }
+}
+
+//! Process a packet received through io_uring.
+//!
+//! This method passes a packet received into a provided buffer to the frame decoder as a
+//! single-packet run, to be copied into the frame buffer. The buffer starts with the receive message descriptor and source
+//! address, followed by the packet itself. Packets truncated by the buffer size are discarded.
+//!
+//! \param[in] socket_idx - index of the socket in the io_uring socket list
+//! \param[in] buffer - provided buffer containing the received message
+//! \param[in] bytes_received - number of bytes received into the buffer
+//!
+void FrameReceiverUDPRxThread::process_uring_packet(unsigned int socket_idx, const uint8_t* buffer,
+    size_t bytes_received)
+{
+  const struct msghdr& msg_hdr = uring_sockets_[socket_idx].msg_hdr;
+  const struct io_uring_recvmsg_out* recv_out =
+      reinterpret_cast<const struct io_uring_recvmsg_out*>(buffer);
+  size_t payload_offset = sizeof(struct io_uring_recvmsg_out) + msg_hdr.msg_namelen + msg_hdr.msg_controllen;
+  if ((bytes_received < payload_offset) || (recv_out->flags & MSG_TRUNC))
+  {
+    packets_truncated_++;
+    return;
+  }
+
+  struct sockaddr_in from_addr;
+  memcpy(&from_addr, buffer + sizeof(struct io_uring_recvmsg_out), sizeof(from_addr));
+  int recv_port = uring_sockets_[socket_idx].recv_port;
+
+  const uint8_t* payload = buffer + payload_offset;
+  size_t payload_len = bytes_received - payload_offset;
+
+  packets_received_ += frame_decoder_->process_packet_run(
+      payload, payload_len, payload_len, recv_port, &from_addr);
+}
+#endif
+
+//! Fill UDP receiver specific status parameters into a message.
+//!
+//! This method adds UDP receiver status parameters to the status message, including the
+//! receive batch size, the number of packets and receive calls and the current packet
+//! receive rate, which is calculated over the interval since the previous status update.
+//! In spin mode, the spin efficiency, i.e. the fraction of socket polls returning data, is
+//! also reported.
+//!
+//! \param[in,out] status_msg - IpcMessage to fill with status parameters
+//!
+void FrameReceiverUDPRxThread::fill_specific_status_params(IpcMessage& status_msg)
+{
+  struct timespec now;
+  gettime(&now, true);
+
+  unsigned int elapsed = elapsed_us(rate_time_, now);
+  if (elapsed > 0)
+  {
+    packet_rate_ = (double)(packets_received_ - rate_packets_) * 1000000.0 / elapsed;
+    rate_packets_ = packets_received_;
+    rate_time_ = now;
+  }
+
+  // With the io_uring engine, the receive system calls are the calls to wait for completions
+  uint64_t recv_calls = recv_calls_;
+#ifdef HAVE_IO_URING
+  if (uring_)
+  {
+    recv_calls = uring_->get_enter_calls();
+  }
+#endif
+  double packets_per_recv = recv_calls ? ((double)packets_received_ / recv_calls) : 0.0;
+
+  status_msg.set_param("rx_thread/recv_batch_size", recv_batch_size_);
+  status_msg.set_param("rx_thread/udp_gro", udp_gro_);
+  status_msg.set_param("rx_thread/packets_received", packets_received_);
+  status_msg.set_param("rx_thread/packets_truncated", packets_truncated_);
+  status_msg.set_param("rx_thread/recv_calls", recv_calls);
+  status_msg.set_param("rx_thread/packets_per_recv", packets_per_recv);
+  status_msg.set_param("rx_thread/packet_rate", packet_rate_);
+
+  double spin_efficiency = spin_polls_ ? ((double)spin_polls_with_data_ / spin_polls_) : 0.0;
+
+  status_msg.set_param("rx_thread/spin_mode", spin_mode_);
+  status_msg.set_param("rx_thread/spin_polls", spin_polls_);
+  status_msg.set_param("rx_thread/spin_efficiency", spin_efficiency);
+  status_msg.set_param("rx_thread/spin_idle_fallbacks", spin_idle_fallbacks_);
 
-  FrameDecoder::FrameReceiveState frame_receive_state = frame_decoder_->process_packet(bytes_received, recv_port, &from_addr);
+  status_msg.set_param("rx_thread/uring_buffer_exhaustions", uring_buffer_exhaustions_);
 }
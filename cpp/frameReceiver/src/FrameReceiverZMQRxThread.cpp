@@ -12,8 +12,9 @@ using namespace FrameReceiver;
 FrameReceiverZMQRxThread::FrameReceiverZMQRxThread(FrameReceiverConfig& config,
                                                    SharedBufferManagerPtr buffer_manager,
                                                    FrameDecoderPtr frame_decoder,
-                                                   unsigned int tick_period_ms) :
-    FrameReceiverRxThread(config, buffer_manager, frame_decoder, tick_period_ms),
+                                                   unsigned int tick_period_ms,
+                                                   unsigned int thread_index) :
+    FrameReceiverRxThread(config, buffer_manager, frame_decoder, tick_period_ms, thread_index),
     logger_(log4cxx::Logger::getLogger("FR.ZMQRxThread")),
     skt_channel_(ZMQ_PULL)
 {
@@ -32,7 +33,7 @@ void FrameReceiverZMQRxThread::run_specific_service(void)
 {
   LOG4CXX_DEBUG_LEVEL(1, logger_, "Running ZMQ RX thread service");
 
-  for (std::vector<uint16_t>::iterator rx_port_itr = config_.rx_ports_.begin(); rx_port_itr != config_.rx_ports_.end(); rx_port_itr++)
+  for (std::vector<uint16_t>::iterator rx_port_itr = rx_ports_.begin(); rx_port_itr != rx_ports_.end(); rx_port_itr++)
   {
     uint16_t rx_port = *rx_port_itr;
 
@@ -0,0 +1,401 @@
+/*
+ * DummyUDPFrameDecoderUnitTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <vector>
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/bind/bind.hpp>
+
+#include "DummyUDPFrameDecoder.h"
+#include "SharedBufferManager.h"
+#include "IpcMessage.h"
+#include "PacketStateBitmap.h"
+
+#ifdef BOOST_HAS_PLACEHOLDERS
+using namespace boost::placeholders;
+#endif
+
+const unsigned int test_packets_per_frame = 4;
+const unsigned int test_packet_size       = 1000;
+const unsigned int test_num_buffers       = 4;
+
+// Decoder taking buffers from the deprecated containers directly, as decoders written before the
+// buffer helpers were added do
+class LegacyBufferDecoder : public FrameReceiver::DummyUDPFrameDecoder
+{
+public:
+  int start_frame(int frame)
+  {
+    int buffer_id = empty_buffer_queue_.front();
+    empty_buffer_queue_.pop();
+    frame_buffer_map_[frame] = buffer_id;
+    return buffer_id;
+  }
+
+  void complete_frame(int frame)
+  {
+    int buffer_id = frame_buffer_map_[frame];
+    frame_buffer_map_.erase(frame);
+    ready_callback_(buffer_id, frame);
+  }
+};
+
+class DummyUDPFrameDecoderTestFixture
+{
+public:
+  DummyUDPFrameDecoderTestFixture() :
+      logger(log4cxx::Logger::getLogger("DummyUDPFrameDecoderUnitTest")),
+      frame_decoder(new FrameReceiver::DummyUDPFrameDecoder())
+  {
+    BOOST_TEST_MESSAGE("Setting up DummyUDPFrameDecoderTestFixture");
+
+    OdinData::IpcMessage decoder_config;
+    decoder_config.set_param(FrameReceiver::CONFIG_DECODER_UDP_PACKETS_PER_FRAME, test_packets_per_frame);
+    decoder_config.set_param(FrameReceiver::CONFIG_DECODER_UDP_PACKET_SIZE, test_packet_size);
+    frame_decoder->init(logger, decoder_config);
+
+    size_t buffer_size = frame_decoder->get_frame_buffer_size();
+    buffer_manager.reset(new OdinData::SharedBufferManager(
+        "TestDecoderSharedBuffer", buffer_size * test_num_buffers, buffer_size));
+
+    frame_decoder->register_buffer_manager(buffer_manager);
+    frame_decoder->register_frame_ready_callback(
+        boost::bind(&DummyUDPFrameDecoderTestFixture::frame_ready, this, _1, _2));
+
+    for (int buffer_id = 0; buffer_id < test_num_buffers; buffer_id++)
+    {
+      frame_decoder->push_empty_buffer(buffer_id);
+    }
+  }
+
+  ~DummyUDPFrameDecoderTestFixture()
+  {
+    BOOST_TEST_MESSAGE("Tearing down DummyUDPFrameDecoderTestFixture");
+  }
+
+  void frame_ready(int buffer_id, int frame_number)
+  {
+    ready_buffers.push_back(buffer_id);
+    ready_frames.push_back(frame_number);
+  }
+
+  // Populate a receive slot with a dummy packet, as the RX thread would on receiving it
+  void fill_slot(FrameReceiver::PacketReceiveSlot& slot, uint32_t frame, uint32_t packet)
+  {
+    DummyUDP::PacketHeader* header = reinterpret_cast<DummyUDP::PacketHeader*>(slot.header_buffer);
+    header->frame_number = frame;
+    header->packet_number_flags = packet;
+    memset(slot.payload_buffer, (int)(packet + 1), slot.payload_size);
+    slot.bytes_received = slot.header_size + slot.payload_size;
+  }
+
+  // Receive a dummy packet into the predicted payload buffer and process it, as the RX thread
+  // would when receiving header and payload in a single call
+  void receive_predicted(uint32_t frame, uint32_t packet)
+  {
+    void* payload_buffer = frame_decoder->get_predicted_payload_buffer();
+    BOOST_REQUIRE(payload_buffer != NULL);
+
+    DummyUDP::PacketHeader* header = reinterpret_cast<DummyUDP::PacketHeader*>(
+        frame_decoder->get_packet_header_buffer());
+    header->frame_number = frame;
+    header->packet_number_flags = packet;
+    memset(payload_buffer, (int)(packet + 1), test_packet_size);
+
+    frame_decoder->process_predicted_packet(
+        frame_decoder->get_packet_header_size() + test_packet_size, 0, NULL);
+  }
+
+  log4cxx::LoggerPtr logger;
+  boost::shared_ptr<FrameReceiver::DummyUDPFrameDecoder> frame_decoder;
+  OdinData::SharedBufferManagerPtr buffer_manager;
+  std::vector<int> ready_buffers;
+  std::vector<int> ready_frames;
+};
+
+BOOST_FIXTURE_TEST_SUITE(DummyUDPFrameDecoderUnitTest, DummyUDPFrameDecoderTestFixture);
+
+BOOST_AUTO_TEST_CASE( BatchedReceiveCompletesFrame )
+{
+  std::vector<FrameReceiver::PacketReceiveSlot> slots(test_packets_per_frame);
+  unsigned int num_slots = frame_decoder->get_next_payload_slots(test_packets_per_frame, &slots[0]);
+  BOOST_REQUIRE_EQUAL(num_slots, test_packets_per_frame);
+
+  for (unsigned int packet = 0; packet < num_slots; packet++)
+  {
+    BOOST_REQUIRE(slots[packet].header_buffer != NULL);
+    BOOST_CHECK_EQUAL(slots[packet].header_size, frame_decoder->get_packet_header_size());
+    BOOST_CHECK_EQUAL(slots[packet].payload_size, test_packet_size);
+    fill_slot(slots[packet], 0, packet);
+  }
+
+  // Payloads are predicted straight into the next empty buffer
+  uint8_t* predicted_buffer = reinterpret_cast<uint8_t*>(
+      buffer_manager->get_buffer_address(test_num_buffers - 1));
+  for (unsigned int packet = 0; packet < num_slots; packet++)
+  {
+    BOOST_CHECK(slots[packet].payload_buffer == predicted_buffer +
+        frame_decoder->get_frame_header_size() + (packet * test_packet_size));
+  }
+
+  frame_decoder->process_packets(num_slots, &slots[0], 0);
+  BOOST_CHECK_EQUAL(frame_decoder->get_num_packets_relocated(), 0);
+
+  // Empty buffers are used most recently pushed first
+  BOOST_REQUIRE_EQUAL(ready_buffers.size(), 1);
+  BOOST_CHECK_EQUAL(ready_buffers[0], test_num_buffers - 1);
+  BOOST_CHECK_EQUAL(ready_frames[0], 0);
+
+  // Check each packet payload landed at the correct location in the frame buffer
+  uint8_t* frame_buffer = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(ready_buffers[0]));
+  DummyUDP::FrameHeader* frame_header = reinterpret_cast<DummyUDP::FrameHeader*>(frame_buffer);
+  BOOST_CHECK_EQUAL(frame_header->total_packets_received, test_packets_per_frame);
+  for (unsigned int packet = 0; packet < test_packets_per_frame; packet++)
+  {
+    uint8_t* payload = frame_buffer + frame_decoder->get_frame_header_size() + (packet * test_packet_size);
+    BOOST_CHECK_EQUAL(payload[0], packet + 1);
+    BOOST_CHECK_EQUAL(payload[test_packet_size - 1], packet + 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( BatchedReceiveSpansFrames )
+{
+  // Receive two complete frames, with packets out of order, in a single batch
+  const unsigned int num_packets = test_packets_per_frame * 2;
+  const uint32_t packet_order[num_packets] = {0, 2, 1, 3, 1, 0, 3, 2};
+
+  std::vector<FrameReceiver::PacketReceiveSlot> slots(num_packets);
+  unsigned int num_slots = frame_decoder->get_next_payload_slots(num_packets, &slots[0]);
+  BOOST_REQUIRE_EQUAL(num_slots, num_packets);
+
+  for (unsigned int pkt = 0; pkt < num_packets; pkt++)
+  {
+    fill_slot(slots[pkt], pkt / test_packets_per_frame, packet_order[pkt]);
+  }
+
+  frame_decoder->process_packets(num_slots, &slots[0], 0);
+
+  BOOST_REQUIRE_EQUAL(ready_buffers.size(), 2);
+  BOOST_CHECK_EQUAL(ready_frames[0], 0);
+  BOOST_CHECK_EQUAL(ready_frames[1], 1);
+  BOOST_CHECK_EQUAL(frame_decoder->get_num_mapped_buffers(), 0);
+  BOOST_CHECK_EQUAL(frame_decoder->get_num_empty_buffers(), test_num_buffers - 2);
+
+  uint8_t* frame_buffer = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(ready_buffers[1]));
+  for (unsigned int packet = 0; packet < test_packets_per_frame; packet++)
+  {
+    uint8_t* payload = frame_buffer + frame_decoder->get_frame_header_size() + (packet * test_packet_size);
+    BOOST_CHECK_EQUAL(payload[0], packet + 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( PredictedReceiveInOrder )
+{
+  // Packets received in order should all land in the predicted location without relocation
+  for (uint32_t frame = 0; frame < 2; frame++)
+  {
+    for (uint32_t packet = 0; packet < test_packets_per_frame; packet++)
+    {
+      receive_predicted(frame, packet);
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(ready_buffers.size(), 2);
+  BOOST_CHECK_EQUAL(frame_decoder->get_num_packets_relocated(), 0);
+
+  uint8_t* frame_buffer = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(ready_buffers[1]));
+  for (unsigned int packet = 0; packet < test_packets_per_frame; packet++)
+  {
+    uint8_t* payload = frame_buffer + frame_decoder->get_frame_header_size() + (packet * test_packet_size);
+    BOOST_CHECK_EQUAL(payload[0], packet + 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( PredictedReceiveRelocatesOutOfOrder )
+{
+  // Swapping two packets mispredicts both of them and the following packet, since its predicted
+  // location has already been filled. These must be relocated to the correct location
+  const uint32_t packet_order[test_packets_per_frame] = {0, 2, 1, 3};
+  for (unsigned int pkt = 0; pkt < test_packets_per_frame; pkt++)
+  {
+    receive_predicted(0, packet_order[pkt]);
+  }
+
+  BOOST_REQUIRE_EQUAL(ready_buffers.size(), 1);
+  BOOST_CHECK_EQUAL(frame_decoder->get_num_packets_relocated(), 3);
+
+  uint8_t* frame_buffer = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(ready_buffers[0]));
+  for (unsigned int packet = 0; packet < test_packets_per_frame; packet++)
+  {
+    uint8_t* payload = frame_buffer + frame_decoder->get_frame_header_size() + (packet * test_packet_size);
+    BOOST_CHECK_EQUAL(payload[0], packet + 1);
+    BOOST_CHECK_EQUAL(payload[test_packet_size - 1], packet + 1);
+  }
+
+  frame_decoder->reset_statistics();
+  BOOST_CHECK_EQUAL(frame_decoder->get_num_packets_relocated(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( IncompleteFramesTimeOut )
+{
+  OdinData::IpcMessage decoder_config;
+  decoder_config.set_param(FrameReceiver::CONFIG_DECODER_FRAME_TIMEOUT_MS, 1);
+  frame_decoder->init(logger, decoder_config);
+
+  // Start two frames without completing them, then complete a third
+  receive_predicted(0, 0);
+  receive_predicted(1, 0);
+  for (unsigned int packet = 0; packet < test_packets_per_frame; packet++)
+  {
+    receive_predicted(2, packet);
+  }
+  BOOST_REQUIRE_EQUAL(ready_frames.size(), 1);
+  BOOST_CHECK_EQUAL(frame_decoder->get_num_mapped_buffers(), 2);
+  BOOST_CHECK_EQUAL(frame_decoder->get_num_empty_buffers(), test_num_buffers - 3);
+
+  usleep(5000);
+  frame_decoder->monitor_buffers();
+
+  // The incomplete frames are released in the order they started
+  BOOST_REQUIRE_EQUAL(ready_frames.size(), 3);
+  BOOST_CHECK_EQUAL(ready_frames[1], 0);
+  BOOST_CHECK_EQUAL(ready_frames[2], 1);
+  BOOST_CHECK_EQUAL(frame_decoder->get_num_frames_timedout(), 2);
+  BOOST_CHECK_EQUAL(frame_decoder->get_num_mapped_buffers(), 0);
+
+  DummyUDP::FrameHeader* frame_header = reinterpret_cast<DummyUDP::FrameHeader*>(
+      buffer_manager->get_buffer_address(ready_buffers[1]));
+  BOOST_CHECK_EQUAL(frame_header->frame_state, FrameReceiver::FrameDecoder::FrameReceiveStateTimedout);
+  BOOST_CHECK_EQUAL(frame_header->total_packets_received, 1);
+
+  // Packets for a new frame are received into a buffer after the timed out frames
+  receive_predicted(3, 0);
+  BOOST_CHECK_EQUAL(frame_decoder->get_num_mapped_buffers(), 1);
+}
+
+BOOST_AUTO_TEST_CASE( ScrubbedBuffersArePrepared )
+{
+  // Create a decoder with buffer scrubbing enabled, filling payloads with a sentinel value
+  const unsigned int fill_value = 0xA5;
+  boost::shared_ptr<FrameReceiver::DummyUDPFrameDecoder> scrub_decoder(
+      new FrameReceiver::DummyUDPFrameDecoder());
+  OdinData::IpcMessage decoder_config;
+  decoder_config.set_param(FrameReceiver::CONFIG_DECODER_UDP_PACKETS_PER_FRAME, test_packets_per_frame);
+  decoder_config.set_param(FrameReceiver::CONFIG_DECODER_UDP_PACKET_SIZE, test_packet_size);
+  decoder_config.set_param(FrameReceiver::CONFIG_DECODER_BUFFER_SCRUB, true);
+  decoder_config.set_param(FrameReceiver::CONFIG_DECODER_BUFFER_SCRUB_FILL, true);
+  decoder_config.set_param(FrameReceiver::CONFIG_DECODER_BUFFER_SCRUB_FILL_VALUE, fill_value);
+  scrub_decoder->init(logger, decoder_config);
+  scrub_decoder->register_buffer_manager(buffer_manager);
+  scrub_decoder->register_frame_ready_callback(
+      boost::bind(&DummyUDPFrameDecoderTestFixture::frame_ready, this, _1, _2));
+
+  // Release a buffer left dirty by a previous frame and wait for it to be prepared
+  const int buffer_id = 1;
+  uint8_t* frame_buffer = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(buffer_id));
+  memset(frame_buffer, 0x11, buffer_manager->get_buffer_size());
+  scrub_decoder->push_empty_buffer(buffer_id);
+  for (int wait = 0; (wait < 1000) && scrub_decoder->get_num_scrub_backlog(); wait++)
+  {
+    usleep(1000);
+  }
+  BOOST_CHECK_EQUAL(scrub_decoder->get_num_scrub_backlog(), 0);
+  BOOST_CHECK_EQUAL(scrub_decoder->get_num_buffers_scrubbed(), 1);
+  BOOST_CHECK_EQUAL(scrub_decoder->get_num_empty_buffers(), 1);
+
+  DummyUDP::FrameHeader* frame_header = reinterpret_cast<DummyUDP::FrameHeader*>(frame_buffer);
+  BOOST_CHECK_EQUAL(frame_header->total_packets_expected, test_packets_per_frame);
+  BOOST_CHECK_EQUAL(frame_header->total_packets_received, 0);
+  BOOST_CHECK_EQUAL(frame_header->packet_state[0], 0);
+  uint8_t* payload = frame_buffer + scrub_decoder->get_frame_header_size();
+  BOOST_CHECK_EQUAL(payload[0], fill_value);
+  BOOST_CHECK_EQUAL(payload[(test_packets_per_frame * test_packet_size) - 1], fill_value);
+
+  // Receive part of a frame into the prepared buffer, leaving the sentinel in the packets missing
+  std::vector<FrameReceiver::PacketReceiveSlot> slots(2);
+  unsigned int num_slots = scrub_decoder->get_next_payload_slots(2, &slots[0]);
+  BOOST_REQUIRE_EQUAL(num_slots, 2);
+  fill_slot(slots[0], 7, 0);
+  fill_slot(slots[1], 7, 1);
+  scrub_decoder->process_packets(num_slots, &slots[0], 0);
+
+  BOOST_CHECK_EQUAL(frame_header->frame_number, 7);
+  BOOST_CHECK_EQUAL(frame_header->total_packets_received, 2);
+  BOOST_CHECK_EQUAL(frame_header->frame_state, FrameReceiver::FrameDecoder::FrameReceiveStateIncomplete);
+  BOOST_CHECK_EQUAL(payload[0], 1);
+  BOOST_CHECK_EQUAL(payload[2 * test_packet_size], fill_value);
+
+  // Filling an unaligned region leaves the bytes around it untouched
+  std::vector<uint8_t> region(128, 0);
+  FrameReceiver::FrameBufferScrubber::fill(&region[3], 100, 0xFF);
+  BOOST_CHECK_EQUAL(region[2], 0);
+  BOOST_CHECK_EQUAL(region[3], 0xFF);
+  BOOST_CHECK_EQUAL(region[102], 0xFF);
+  BOOST_CHECK_EQUAL(region[103], 0);
+}
+
+BOOST_AUTO_TEST_CASE( UnscrubbedBuffersAreInitialised )
+{
+  // Buffers pushed before scrubbing is enabled have not been prepared, so their headers must
+  // still be initialised when a frame is received into them
+  for (int buffer_id = 0; buffer_id < test_num_buffers; buffer_id++)
+  {
+    memset(buffer_manager->get_buffer_address(buffer_id), 0x11, buffer_manager->get_buffer_size());
+  }
+  OdinData::IpcMessage decoder_config;
+  decoder_config.set_param(FrameReceiver::CONFIG_DECODER_BUFFER_SCRUB, true);
+  frame_decoder->init(logger, decoder_config);
+
+  receive_predicted(5, 0);
+  BOOST_REQUIRE_EQUAL(frame_decoder->get_num_mapped_buffers(), 1);
+
+  DummyUDP::FrameHeader* frame_header = reinterpret_cast<DummyUDP::FrameHeader*>(
+      buffer_manager->get_buffer_address(test_num_buffers - 1));
+  BOOST_CHECK_EQUAL(frame_header->frame_number, 5);
+  BOOST_CHECK_EQUAL(frame_header->total_packets_expected, test_packets_per_frame);
+  BOOST_CHECK_EQUAL(frame_header->total_packets_received, 1);
+  BOOST_CHECK(OdinData::PacketStateBitmap(frame_header->packet_state,
+      test_packets_per_frame).is_received(0));
+  BOOST_CHECK(!OdinData::PacketStateBitmap(frame_header->packet_state,
+      test_packets_per_frame).is_received(1));
+}
+
+BOOST_AUTO_TEST_CASE( LegacyBufferContainersStillUsable )
+{
+  boost::shared_ptr<LegacyBufferDecoder> legacy_decoder(new LegacyBufferDecoder());
+  OdinData::IpcMessage decoder_config;
+  decoder_config.set_param(FrameReceiver::CONFIG_DECODER_UDP_PACKETS_PER_FRAME, test_packets_per_frame);
+  decoder_config.set_param(FrameReceiver::CONFIG_DECODER_UDP_PACKET_SIZE, test_packet_size);
+  legacy_decoder->init(logger, decoder_config);
+  legacy_decoder->register_buffer_manager(buffer_manager);
+  legacy_decoder->register_frame_ready_callback(
+      boost::bind(&DummyUDPFrameDecoderTestFixture::frame_ready, this, _1, _2));
+  for (int buffer_id = 0; buffer_id < test_num_buffers; buffer_id++)
+  {
+    legacy_decoder->push_empty_buffer(buffer_id);
+  }
+
+  // Buffers are taken from the queue in the order they were pushed and counted while mapped
+  BOOST_CHECK_EQUAL(legacy_decoder->start_frame(1), 0);
+  BOOST_CHECK_EQUAL(legacy_decoder->start_frame(2), 1);
+  BOOST_CHECK_EQUAL(legacy_decoder->get_num_empty_buffers(), test_num_buffers - 2);
+  BOOST_CHECK_EQUAL(legacy_decoder->get_num_mapped_buffers(), 2);
+
+  legacy_decoder->complete_frame(1);
+  legacy_decoder->push_empty_buffer(0);
+  BOOST_REQUIRE_EQUAL(ready_buffers.size(), 1);
+  BOOST_CHECK_EQUAL(ready_buffers[0], 0);
+  BOOST_CHECK_EQUAL(legacy_decoder->get_num_empty_buffers(), test_num_buffers - 1);
+  BOOST_CHECK_EQUAL(legacy_decoder->get_num_mapped_buffers(), 1);
+
+  legacy_decoder->drop_all_buffers();
+  BOOST_CHECK_EQUAL(legacy_decoder->get_num_empty_buffers(), 0);
+  BOOST_CHECK_EQUAL(legacy_decoder->get_num_mapped_buffers(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END(); // DummyUDPFrameDecoderUnitTest
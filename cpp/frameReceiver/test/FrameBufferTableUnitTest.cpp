@@ -0,0 +1,195 @@
+/*
+ * FrameBufferTableUnitTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <map>
+#include <vector>
+#include <cstdlib>
+
+#include <boost/test/unit_test.hpp>
+
+#include "FrameBufferTable.h"
+
+const size_t test_table_buffers = 16;
+
+class FrameBufferTableTestFixture
+{
+public:
+  FrameBufferTableTestFixture()
+  {
+    table.resize(test_table_buffers);
+  }
+
+  FrameReceiver::FrameBufferTable table;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FrameBufferTableUnitTest, FrameBufferTableTestFixture);
+
+BOOST_AUTO_TEST_CASE( EmptyBuffersArePoppedMostRecentFirst )
+{
+  int buffer_id;
+  BOOST_CHECK(!table.pop_empty(buffer_id));
+  BOOST_CHECK_EQUAL(table.next_empty(), -1);
+
+  for (int buffer = 0; buffer < 3; buffer++)
+  {
+    table.push_empty(buffer);
+  }
+  BOOST_CHECK_EQUAL(table.num_empty(), 3);
+  BOOST_CHECK_EQUAL(table.next_empty(), 2);
+
+  BOOST_REQUIRE(table.pop_empty(buffer_id));
+  BOOST_CHECK_EQUAL(buffer_id, 2);
+  table.push_empty(7);
+  BOOST_REQUIRE(table.pop_empty(buffer_id));
+  BOOST_CHECK_EQUAL(buffer_id, 7);
+  BOOST_CHECK_EQUAL(table.num_empty(), 2);
+
+  table.drop_empty();
+  BOOST_CHECK_EQUAL(table.num_empty(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( EmptyBuffersArePoppedFromTheirPool )
+{
+  table.resize(test_table_buffers, 2);
+  table.push_empty(0, 0);
+  table.push_empty(1, 0);
+  table.push_empty(8, 1);
+  BOOST_CHECK_EQUAL(table.num_empty(), 3);
+  BOOST_CHECK_EQUAL(table.num_empty(0), 2);
+  BOOST_CHECK_EQUAL(table.num_empty(1), 1);
+  BOOST_CHECK_EQUAL(table.num_empty(2), 0);
+  BOOST_CHECK_EQUAL(table.next_empty(1), 8);
+
+  int buffer_id;
+  BOOST_REQUIRE(table.pop_empty(buffer_id, 1));
+  BOOST_CHECK_EQUAL(buffer_id, 8);
+  BOOST_CHECK(!table.pop_empty(buffer_id, 1));
+  BOOST_CHECK(!table.pop_empty(buffer_id, 2));
+  BOOST_REQUIRE(table.pop_empty(buffer_id));
+  BOOST_CHECK_EQUAL(buffer_id, 1);
+
+  table.drop_empty();
+  BOOST_CHECK_EQUAL(table.num_empty(), 0);
+  BOOST_CHECK_EQUAL(table.num_empty(0), 0);
+}
+
+BOOST_AUTO_TEST_CASE( MapLookupAndUnmapFrames )
+{
+  BOOST_CHECK_EQUAL(table.lookup(0), -1);
+
+  BOOST_CHECK(table.map(10, 3, 100));
+  BOOST_CHECK(table.map(11, 5, 200));
+  BOOST_CHECK_EQUAL(table.num_mapped(), 2);
+  BOOST_CHECK_EQUAL(table.lookup(10), 3);
+  BOOST_CHECK_EQUAL(table.lookup(11), 5);
+  BOOST_CHECK_EQUAL(table.lookup(12), -1);
+
+  // Neither a frame nor a buffer can be mapped twice
+  BOOST_CHECK(!table.map(10, 6, 300));
+  BOOST_CHECK(!table.map(12, 5, 300));
+  BOOST_CHECK_EQUAL(table.num_mapped(), 2);
+
+  BOOST_CHECK(table.unmap(10));
+  BOOST_CHECK(!table.unmap(10));
+  BOOST_CHECK_EQUAL(table.lookup(10), -1);
+  BOOST_CHECK_EQUAL(table.lookup(11), 5);
+  BOOST_CHECK_EQUAL(table.num_mapped(), 1);
+
+  // The unmapped buffer can be mapped to a new frame
+  BOOST_CHECK(table.map(12, 3, 300));
+  BOOST_CHECK_EQUAL(table.lookup(12), 3);
+
+  table.drop_mapped();
+  BOOST_CHECK_EQUAL(table.num_mapped(), 0);
+  BOOST_CHECK_EQUAL(table.lookup(11), -1);
+  BOOST_CHECK(table.map(11, 5, 400));
+}
+
+BOOST_AUTO_TEST_CASE( RandomMappingMatchesReferenceMap )
+{
+  // Map and unmap strided frame numbers in a random order, checking every lookup against a
+  // reference map, so that collisions and removal from within probe sequences are exercised
+  std::map<int, int> reference;
+  std::vector<int> free_buffers;
+  for (int buffer = 0; buffer < static_cast<int>(test_table_buffers); buffer++)
+  {
+    free_buffers.push_back(buffer);
+  }
+
+  srand(1234);
+  uint64_t now = 0;
+  for (int iteration = 0; iteration < 20000; iteration++)
+  {
+    int frame = (rand() % 64) * 4 + 1;
+    if (reference.count(frame))
+    {
+      BOOST_REQUIRE(table.unmap(frame));
+      free_buffers.push_back(reference[frame]);
+      reference.erase(frame);
+    }
+    else if (!free_buffers.empty())
+    {
+      int buffer_id = free_buffers.back();
+      free_buffers.pop_back();
+      BOOST_REQUIRE(table.map(frame, buffer_id, ++now));
+      reference[frame] = buffer_id;
+    }
+    BOOST_REQUIRE_EQUAL(table.num_mapped(), reference.size());
+
+    for (int check = 1; check < 64 * 4; check += 4)
+    {
+      std::map<int, int>::iterator iter = reference.find(check);
+      BOOST_REQUIRE_EQUAL(table.lookup(check), (iter == reference.end()) ? -1 : iter->second);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( FramesExpireInOrderMapped )
+{
+  for (int frame = 0; frame < 4; frame++)
+  {
+    BOOST_REQUIRE(table.map(frame, frame, 1000 * (frame + 1)));
+  }
+
+  // Unmapping a frame removes it from the timeout order
+  BOOST_REQUIRE(table.unmap(1));
+
+  int frame;
+  int buffer_id;
+  BOOST_CHECK(!table.pop_expired(1000, frame, buffer_id));
+
+  BOOST_REQUIRE(table.pop_expired(3500, frame, buffer_id));
+  BOOST_CHECK_EQUAL(frame, 0);
+  BOOST_CHECK_EQUAL(buffer_id, 0);
+  BOOST_REQUIRE(table.pop_expired(3500, frame, buffer_id));
+  BOOST_CHECK_EQUAL(frame, 2);
+  BOOST_CHECK_EQUAL(buffer_id, 2);
+  BOOST_CHECK(!table.pop_expired(3500, frame, buffer_id));
+
+  BOOST_CHECK_EQUAL(table.num_mapped(), 1);
+  BOOST_CHECK_EQUAL(table.lookup(3), 3);
+  BOOST_CHECK(table.pop_expired(5000, frame, buffer_id));
+  BOOST_CHECK_EQUAL(frame, 3);
+  BOOST_CHECK_EQUAL(table.num_mapped(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( TableGrowsForLargerBufferIds )
+{
+  table.push_empty(100);
+  BOOST_CHECK(table.map(5, 3, 100));
+  BOOST_CHECK(table.map(6, 200, 200));
+  BOOST_CHECK_EQUAL(table.lookup(5), 3);
+  BOOST_CHECK_EQUAL(table.lookup(6), 200);
+  BOOST_CHECK_EQUAL(table.next_empty(), 100);
+
+  int frame;
+  int buffer_id;
+  BOOST_REQUIRE(table.pop_expired(150, frame, buffer_id));
+  BOOST_CHECK_EQUAL(frame, 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END(); // FrameBufferTableUnitTest
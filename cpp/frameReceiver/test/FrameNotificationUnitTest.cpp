@@ -0,0 +1,89 @@
+/*
+ * FrameNotificationUnitTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "FrameNotification.h"
+#include "IpcMessage.h"
+
+BOOST_AUTO_TEST_SUITE(FrameNotificationUnitTest);
+
+BOOST_AUTO_TEST_CASE( EncodeAndDecodeNotification )
+{
+  OdinData::FrameNotification ready(OdinData::FrameNotification::TypeFrameReady,
+      0x123456789ULL, 7, OdinData::FrameNotification::StateTimedout);
+  BOOST_CHECK(ready.get_ready_time_ns() > 0);
+  BOOST_CHECK_EQUAL(ready.get_release_time_ns(), 0);
+
+  std::string encoded = ready.encode();
+  BOOST_CHECK_EQUAL(encoded.size(), sizeof(OdinData::FrameNotification::Layout));
+  BOOST_CHECK_EQUAL(encoded.substr(0, 4), "ODFN");
+  BOOST_CHECK(OdinData::FrameNotification::is_binary(encoded));
+
+  OdinData::FrameNotification decoded(encoded);
+  BOOST_CHECK_EQUAL(decoded.get_type(), OdinData::FrameNotification::TypeFrameReady);
+  BOOST_CHECK_EQUAL(decoded.get_frame(), 0x123456789ULL);
+  BOOST_CHECK_EQUAL(decoded.get_buffer_id(), 7);
+  BOOST_CHECK_EQUAL(decoded.get_state(), OdinData::FrameNotification::StateTimedout);
+  BOOST_CHECK_EQUAL(decoded.get_ready_time_ns(), ready.get_ready_time_ns());
+}
+
+BOOST_AUTO_TEST_CASE( JsonMessageIsNotBinary )
+{
+  OdinData::IpcMessage ready_msg(OdinData::IpcMessage::MsgTypeNotify,
+      OdinData::IpcMessage::MsgValNotifyFrameReady);
+  ready_msg.set_param("frame", 1);
+  ready_msg.set_param("buffer_id", 2);
+  std::string encoded = ready_msg.encode();
+
+  BOOST_CHECK(!OdinData::FrameNotification::is_binary(encoded));
+  BOOST_CHECK_THROW(OdinData::FrameNotification decoded(encoded),
+      OdinData::FrameNotificationException);
+}
+
+BOOST_AUTO_TEST_CASE( UnsupportedVersionRejected )
+{
+  OdinData::FrameNotification release(OdinData::FrameNotification::TypeFrameRelease, 1, 2);
+  std::string encoded = release.encode();
+  encoded[4] = static_cast<char>(OdinData::FrameNotification::version + 1);
+
+  BOOST_CHECK(OdinData::FrameNotification::is_binary(encoded));
+  BOOST_CHECK_THROW(OdinData::FrameNotification decoded(encoded),
+      OdinData::FrameNotificationException);
+}
+
+BOOST_AUTO_TEST_CASE( EncodeAndDecodeBatch )
+{
+  std::string encoded;
+  for (uint32_t buffer_id = 0; buffer_id < 3; buffer_id++)
+  {
+    OdinData::FrameNotification release(OdinData::FrameNotification::TypeFrameRelease,
+        100 + buffer_id, buffer_id);
+    release.encode_to_batch(encoded);
+  }
+  BOOST_CHECK_EQUAL(encoded.size(), 3 * sizeof(OdinData::FrameNotification::Layout));
+  BOOST_CHECK(!OdinData::FrameNotification::is_binary(encoded));
+  BOOST_CHECK(OdinData::FrameNotification::is_binary_batch(encoded));
+
+  std::vector<OdinData::FrameNotification> releases;
+  OdinData::FrameNotification::decode_batch(encoded, releases);
+  BOOST_REQUIRE_EQUAL(releases.size(), 3);
+  for (uint32_t buffer_id = 0; buffer_id < 3; buffer_id++)
+  {
+    BOOST_CHECK_EQUAL(releases[buffer_id].get_type(), OdinData::FrameNotification::TypeFrameRelease);
+    BOOST_CHECK_EQUAL(releases[buffer_id].get_frame(), 100 + buffer_id);
+    BOOST_CHECK_EQUAL(releases[buffer_id].get_buffer_id(), buffer_id);
+  }
+
+  // A single notification is a valid batch, a truncated batch is not
+  BOOST_CHECK(OdinData::FrameNotification::is_binary_batch(releases[0].encode()));
+  BOOST_CHECK(!OdinData::FrameNotification::is_binary_batch(encoded.substr(0, encoded.size() - 1)));
+  BOOST_CHECK_THROW(OdinData::FrameNotification::decode_batch(std::string("{}"), releases),
+      OdinData::FrameNotificationException);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
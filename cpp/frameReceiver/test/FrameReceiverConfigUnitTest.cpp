@@ -22,6 +22,12 @@ public:
   void test_config(void)
   {
     BOOST_CHECK_EQUAL(mConfig.max_buffer_mem_, FrameReceiver::Defaults::default_max_buffer_mem);
+    BOOST_CHECK_EQUAL(mConfig.buffer_lease_timeout_ms_, FrameReceiver::Defaults::default_buffer_lease_timeout_ms);
+    BOOST_CHECK_EQUAL(mConfig.buffer_reclaim_exited_, FrameReceiver::Defaults::default_buffer_reclaim_exited);
+    BOOST_CHECK_EQUAL(mConfig.shared_buffer_huge_page_size_, FrameReceiver::Defaults::default_shared_buffer_huge_page_size);
+    BOOST_CHECK_EQUAL(mConfig.shared_buffer_prefault_, FrameReceiver::Defaults::default_shared_buffer_prefault);
+    BOOST_CHECK_EQUAL(mConfig.shared_buffer_lock_, FrameReceiver::Defaults::default_shared_buffer_lock);
+    BOOST_CHECK_EQUAL(mConfig.shared_buffer_numa_node_, FrameReceiver::Defaults::default_shared_buffer_numa_node);
 // TODO:            BOOST_CHECK_EQUAL(mConfig.sensor_type_, FrameReceiver::Defaults::SensorTypeIllegal);
     std::vector<uint16_t> port_list;
     mConfig.tokenize_port_list(port_list, FrameReceiver::Defaults::default_rx_port_list);
@@ -31,6 +37,16 @@ public:
       BOOST_CHECK_EQUAL(mConfig.rx_ports_[i], port_list[i]);
     }
     BOOST_CHECK_EQUAL(mConfig.rx_address_, FrameReceiver::Defaults::default_rx_address);
+    BOOST_CHECK_EQUAL(mConfig.rx_recv_batch_size_, FrameReceiver::Defaults::default_rx_recv_batch_size);
+    BOOST_CHECK_EQUAL(mConfig.rx_threads_, FrameReceiver::Defaults::default_rx_threads);
+    BOOST_CHECK_EQUAL(mConfig.rx_steering_, FrameReceiver::Defaults::default_rx_steering);
+    BOOST_CHECK_EQUAL(mConfig.rx_spin_mode_, FrameReceiver::Defaults::default_rx_spin_mode);
+    BOOST_CHECK_EQUAL(mConfig.rx_engine_, FrameReceiver::Defaults::default_rx_engine);
+    BOOST_CHECK_EQUAL(mConfig.rx_tcp_mode_, FrameReceiver::Defaults::default_rx_tcp_mode);
+    BOOST_CHECK_EQUAL(mConfig.frame_notify_format_, FrameReceiver::Defaults::default_frame_notify_format);
+    BOOST_CHECK_EQUAL(mConfig.frame_notify_transport_, FrameReceiver::Defaults::default_frame_notify_transport);
+    BOOST_CHECK_EQUAL(mConfig.frame_notify_direct_, FrameReceiver::Defaults::default_frame_notify_direct);
+    BOOST_CHECK_EQUAL(mConfig.rx_udp_gro_, FrameReceiver::Defaults::default_rx_udp_gro);
   }
 private:
   FrameReceiver::FrameReceiverConfig& mConfig;
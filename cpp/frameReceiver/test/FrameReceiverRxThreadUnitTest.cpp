@@ -9,7 +9,9 @@
 
 #include "FrameReceiverUDPRxThread.h"
 #include "FrameReceiverTCPRxThread.h"
+#include "FrameReceiverPacketRxThread.h"
 #include "IpcMessage.h"
+#include "FrameNotification.h"
 #include "SharedBufferManager.h"
 #include <log4cxx/logger.h>
 #include <log4cxx/consoleappender.h>
@@ -42,6 +44,66 @@ public:
   {
     return config_.rx_channel_endpoint_;
   }
+
+  void set_rx_recv_batch_size(unsigned int batch_size)
+  {
+    config_.rx_recv_batch_size_ = batch_size;
+  }
+
+  void set_rx_udp_gro(bool udp_gro)
+  {
+    config_.rx_udp_gro_ = udp_gro;
+  }
+
+  void set_rx_threads(const std::string& rx_ports, unsigned int rx_threads)
+  {
+    config_.tokenize_port_list(config_.rx_ports_, rx_ports);
+    config_.rx_threads_ = rx_threads;
+  }
+
+  void set_rx_steering(Defaults::RxSteering rx_steering)
+  {
+    config_.rx_steering_ = rx_steering;
+  }
+
+  void set_rx_spin_mode(bool spin_mode, unsigned int check_interval)
+  {
+    config_.rx_spin_mode_ = spin_mode;
+    config_.rx_spin_check_interval_ = check_interval;
+  }
+
+  void set_rx_engine(Defaults::RxEngine rx_engine)
+  {
+    config_.rx_engine_ = rx_engine;
+  }
+
+  void set_rx_tcp_mode(Defaults::RxTcpMode rx_tcp_mode)
+  {
+    config_.rx_tcp_mode_ = rx_tcp_mode;
+  }
+
+  void set_frame_notify_format(Defaults::FrameNotifyFormat frame_notify_format)
+  {
+    config_.frame_notify_format_ = frame_notify_format;
+  }
+
+  void set_frame_notify_transport(Defaults::FrameNotifyTransport frame_notify_transport)
+  {
+    config_.frame_notify_transport_ = frame_notify_transport;
+  }
+
+  Defaults::FrameNotifyTransport get_frame_notify_transport(void)
+  {
+    return config_.frame_notify_transport_;
+  }
+
+  void set_frame_notify_direct(const std::string& frame_ready_endpoint,
+      const std::string& frame_release_endpoint)
+  {
+    config_.frame_notify_direct_ = true;
+    config_.frame_ready_endpoint_ = frame_ready_endpoint;
+    config_.frame_release_endpoint_ = frame_release_endpoint;
+  }
 private:
   FrameReceiver::FrameReceiverConfig& config_;
 };
@@ -77,6 +139,150 @@ public:
   ~FrameReceiverUDPRxThreadTestFixture()
   {
     BOOST_TEST_MESSAGE("Tearing down FrameReceiverUDPRxThreadTestFixture");
+
+    // Unbind the RX channel endpoint explicitly, so that it is immediately available to the next test
+    rx_channel.unbind(proxy.get_rx_channel_endpoint());
+  }
+
+  // Start RX threads steering packets by frame number, send a single-packet frame for each frame
+  // number and check that each frame is received by the thread selected by frame number
+  template<class RxThreadType> void test_frame_steering(const std::string& shared_buffer_name)
+  {
+    const unsigned int num_threads = 2;
+    const unsigned int num_frames = 8;
+    const unsigned int packet_size = 1000;
+    const uint16_t rx_port = 6342;
+
+    proxy.set_rx_threads("6342", num_threads);
+    proxy.set_rx_steering(FrameReceiver::Defaults::RxSteeringFrame);
+
+    // Create a decoder for each thread, precharging each with its own range of buffers
+    IpcMessage decoder_config;
+    decoder_config.set_param(FrameReceiver::CONFIG_DECODER_UDP_PACKETS_PER_FRAME, 1);
+    decoder_config.set_param(FrameReceiver::CONFIG_DECODER_UDP_PACKET_SIZE, packet_size);
+
+    std::vector<FrameReceiver::FrameDecoderPtr> decoders;
+    for (unsigned int thread_idx = 0; thread_idx < num_threads; thread_idx++)
+    {
+      decoders.push_back(FrameReceiver::FrameDecoderPtr(new FrameReceiver::DummyUDPFrameDecoder()));
+      decoders[thread_idx]->init(logger, decoder_config);
+    }
+    size_t buffer_size = decoders[0]->get_frame_buffer_size();
+    bool ring_transport =
+        (proxy.get_frame_notify_transport() == FrameReceiver::Defaults::FrameNotifyTransportSharedMemory);
+    OdinData::SharedBufferManagerPtr steering_buffer_manager(new OdinData::SharedBufferManager(
+        shared_buffer_name, buffer_size * num_frames, buffer_size, true, ring_transport ? num_threads : 0));
+    for (unsigned int thread_idx = 0; thread_idx < num_threads; thread_idx++)
+    {
+      decoders[thread_idx]->register_buffer_manager(steering_buffer_manager);
+      for (unsigned int buffer = 0; buffer < num_frames / num_threads; buffer++)
+      {
+        decoders[thread_idx]->push_empty_buffer((thread_idx * num_frames / num_threads) + buffer);
+      }
+    }
+
+    // Start the threads in order, which determines their position in the socket steering group
+    std::vector<boost::shared_ptr<RxThreadType> > rx_threads;
+    for (unsigned int thread_idx = 0; thread_idx < num_threads; thread_idx++)
+    {
+      rx_threads.push_back(boost::shared_ptr<RxThreadType>(
+          new RxThreadType(
+              config, steering_buffer_manager, decoders[thread_idx], 1, thread_idx)));
+      BOOST_REQUIRE_EQUAL(rx_threads[thread_idx]->start(), true);
+    }
+
+    // Map the identity of each thread to its index from the identity notifications
+    std::map<std::string, unsigned int> thread_identities;
+    for (unsigned int thread_idx = 0; thread_idx < num_threads; thread_idx++)
+    {
+      std::string identity;
+      BOOST_REQUIRE(rx_channel.poll(1000));
+      IpcMessage identity_msg(rx_channel.recv(&identity).c_str());
+      BOOST_CHECK_EQUAL(identity_msg.get_msg_val(), OdinData::IpcMessage::MsgValNotifyIdentity);
+      thread_identities[identity] = identity_msg.get_param<unsigned int>("thread_index");
+    }
+
+    // Send a single-packet frame for each frame number to the shared port
+    int send_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    struct sockaddr_in dest_addr;
+    memset(&dest_addr, 0, sizeof(dest_addr));
+    dest_addr.sin_family = AF_INET;
+    dest_addr.sin_port = htons(rx_port);
+    dest_addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    std::vector<uint8_t> packet(sizeof(DummyUDP::PacketHeader) + packet_size, 0);
+    DummyUDP::PacketHeader* header = reinterpret_cast<DummyUDP::PacketHeader*>(&packet[0]);
+    for (uint32_t frame = 0; frame < num_frames; frame++)
+    {
+      header->frame_number = frame;
+      header->packet_number_flags = 0;
+      sendto(send_socket, &packet[0], packet.size(), 0, (struct sockaddr*)&dest_addr, sizeof(dest_addr));
+    }
+    close(send_socket);
+
+    // Each frame ready notification should come from the thread selected by frame number
+    unsigned int frames_ready = 0;
+    unsigned int timeout_count = 0;
+    while ((frames_ready < num_frames) && (timeout_count < 10))
+    {
+      OdinData::SharedFrameRings* rings = steering_buffer_manager->get_frame_rings();
+      if (rings)
+      {
+        // With the shared memory transport each thread notifies frames on its own ring
+        OdinData::FrameNotification ready;
+        if (rings->wait_ready(100))
+        {
+          for (unsigned int ring = 0; ring < rings->get_num_rings(); ring++)
+          {
+            while (rings->pop_ready(ring, ready))
+            {
+              BOOST_CHECK_EQUAL(ready.get_type(), OdinData::FrameNotification::TypeFrameReady);
+              BOOST_CHECK_EQUAL(ready.get_frame() % num_threads, ring);
+              frames_ready++;
+            }
+          }
+          timeout_count = 0;
+        }
+        else
+        {
+          timeout_count++;
+        }
+        continue;
+      }
+      if (rx_channel.poll(100))
+      {
+        std::string identity;
+        std::string encoded_msg = rx_channel.recv(&identity);
+        if (OdinData::FrameNotification::is_binary(encoded_msg))
+        {
+          OdinData::FrameNotification ready(encoded_msg);
+          BOOST_CHECK_EQUAL(ready.get_type(), OdinData::FrameNotification::TypeFrameReady);
+          BOOST_CHECK_EQUAL(ready.get_state(), OdinData::FrameNotification::StateComplete);
+          BOOST_CHECK_EQUAL(ready.get_frame() % num_threads, thread_identities[identity]);
+          frames_ready++;
+          timeout_count = 0;
+          continue;
+        }
+        IpcMessage ready_msg(encoded_msg.c_str());
+        if (ready_msg.get_msg_val() == OdinData::IpcMessage::MsgValNotifyFrameReady)
+        {
+          BOOST_CHECK_EQUAL(ready_msg.get_param<unsigned int>("frame") % num_threads,
+              thread_identities[identity]);
+          frames_ready++;
+        }
+        timeout_count = 0;
+      }
+      else
+      {
+        timeout_count++;
+      }
+    }
+    BOOST_CHECK_EQUAL(frames_ready, num_frames);
+
+    for (unsigned int thread_idx = 0; thread_idx < num_threads; thread_idx++)
+    {
+      rx_threads[thread_idx]->stop();
+    }
   }
 
   OdinData::IpcChannel rx_channel;
@@ -128,9 +334,92 @@ public:
   ~FrameReceiverTCPRxThreadTestFixture()
   {
     BOOST_TEST_MESSAGE("Tearing down FrameReceiverTCPRxThreadTestFixture");
+
+    // Unbind the RX channel endpoint explicitly, so that it is immediately available to the next test
+    rx_channel.unbind(proxy.get_rx_channel_endpoint());
     close(server_socket);
   }
 
+  // Start an RX thread in server mode, open two connections to it and send messages interleaved
+  // across them in parts, checking from the status notifications that every message is received
+  void test_server_connections(void)
+  {
+    const uint16_t rx_port = 6350;
+    const size_t message_size = FrameReceiver::DummyTcpFrameDecoderDefaults::max_size;
+
+    proxy.set_rx_threads("6350", 1);
+    proxy.set_rx_tcp_mode(FrameReceiver::Defaults::RxTcpModeServer);
+    frame_decoder->register_buffer_manager(buffer_manager);
+
+    FrameReceiver::FrameReceiverTCPRxThread rxThread(config, buffer_manager, frame_decoder, 1);
+    BOOST_REQUIRE_EQUAL(rxThread.start(), true);
+
+    struct sockaddr_in dest_addr;
+    memset(&dest_addr, 0, sizeof(dest_addr));
+    dest_addr.sin_family = AF_INET;
+    dest_addr.sin_port = htons(rx_port);
+    dest_addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    int client_sockets[2];
+    for (int client = 0; client < 2; client++)
+    {
+      client_sockets[client] = socket(AF_INET, SOCK_STREAM, 0);
+      BOOST_REQUIRE_EQUAL(
+          connect(client_sockets[client], (struct sockaddr*)&dest_addr, sizeof(dest_addr)), 0);
+    }
+
+    // Start a message on the first connection, send a whole message on the second while it is
+    // incomplete, then complete the first message and send another
+    std::vector<uint8_t> message(message_size, 0x5a);
+    BOOST_CHECK_EQUAL(send(client_sockets[0], &message[0], 300, 0), 300);
+    usleep(10000);
+    BOOST_CHECK_EQUAL(send(client_sockets[1], &message[0], message_size, 0), message_size);
+    usleep(10000);
+    BOOST_CHECK_EQUAL(send(client_sockets[0], &message[300], message_size - 300, 0),
+        message_size - 300);
+    BOOST_CHECK_EQUAL(send(client_sockets[0], &message[0], message_size, 0), message_size);
+
+    // Wait for a status notification reporting all the messages received
+    std::string encoded_status;
+    unsigned int timeout_count = 0;
+    bool all_received = false;
+    while (!all_received && (timeout_count < 10))
+    {
+      if (rx_channel.poll(100))
+      {
+        std::string identity;
+        std::string encoded_msg = rx_channel.recv(&identity);
+        IpcMessage notify_msg(encoded_msg.c_str());
+        if ((notify_msg.get_msg_val() == OdinData::IpcMessage::MsgValNotifyStatus) &&
+            (notify_msg.get_param<uint64_t>("rx_thread/messages_received") == 3))
+        {
+          encoded_status = encoded_msg;
+          all_received = true;
+        }
+        timeout_count = 0;
+      }
+      else
+      {
+        timeout_count++;
+      }
+    }
+    BOOST_REQUIRE(all_received);
+    IpcMessage status_msg(encoded_status.c_str());
+    BOOST_CHECK_EQUAL(status_msg.get_param<unsigned int>("rx_thread/open_connections"), 2);
+    BOOST_CHECK_EQUAL(status_msg.get_param<uint64_t>("rx_thread/connections_accepted"), 2);
+    BOOST_CHECK_EQUAL(status_msg.get_param<uint64_t>("rx_thread/messages_discarded"), 0);
+    BOOST_CHECK_EQUAL(
+        status_msg.get_param<uint64_t>("rx_thread/connections/0/bytes_received") +
+        status_msg.get_param<uint64_t>("rx_thread/connections/1/bytes_received"),
+        3 * message_size);
+
+    for (int client = 0; client < 2; client++)
+    {
+      close(client_sockets[client]);
+    }
+    rxThread.stop();
+  }
+
   int server_socket;
   OdinData::IpcChannel rx_channel;
   FrameReceiver::FrameReceiverConfig config;
@@ -229,6 +518,344 @@ BOOST_AUTO_TEST_CASE( CreateAndPingUDPRxThread )
 
 }
 
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE( CreateAndPingBatchedUDPRxThread )
+{
+
+  bool initOK = true;
+  proxy.set_rx_recv_batch_size(32);
+
+  try {
+    FrameReceiver::FrameReceiverUDPRxThread rxThread(config, buffer_manager, frame_decoder, 1);
+    rxThread.start();
+    testRxChannel(rx_channel);
+    rxThread.stop();
+  }
+  catch (OdinData::OdinDataException& e)
+  {
+    initOK = false;
+    BOOST_TEST_MESSAGE("Creation of batched FrameReceiverUDPRxThread failed: " << e.what());
+  }
+  BOOST_REQUIRE_EQUAL(initOK, true);
+
+}
+#endif
+
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE( CreateAndPingGroUDPRxThread )
+{
+
+  bool initOK = true;
+  proxy.set_rx_udp_gro(true);
+
+  try {
+    FrameReceiver::FrameReceiverUDPRxThread rxThread(config, buffer_manager, frame_decoder, 1);
+    rxThread.start();
+    testRxChannel(rx_channel);
+    rxThread.stop();
+  }
+  catch (OdinData::OdinDataException& e)
+  {
+    initOK = false;
+    BOOST_TEST_MESSAGE("Creation of GRO FrameReceiverUDPRxThread failed: " << e.what());
+  }
+  BOOST_REQUIRE_EQUAL(initOK, true);
+
+}
+#endif
+
+BOOST_AUTO_TEST_CASE( CreateAndPingPartitionedUDPRxThread )
+{
+
+  bool initOK = true;
+  proxy.set_rx_threads("6342,6343", 2);
+
+  try {
+    FrameReceiver::FrameReceiverUDPRxThread rxThread(config, buffer_manager, frame_decoder, 1, 1);
+    rxThread.start();
+    testRxChannel(rx_channel);
+    rxThread.stop();
+  }
+  catch (OdinData::OdinDataException& e)
+  {
+    initOK = false;
+    BOOST_TEST_MESSAGE("Creation of partitioned FrameReceiverUDPRxThread failed: " << e.what());
+  }
+  BOOST_REQUIRE_EQUAL(initOK, true);
+
+}
+
+BOOST_AUTO_TEST_CASE( CreateAndPingSpinningUDPRxThread )
+{
+
+  bool initOK = true;
+  proxy.set_rx_spin_mode(true, 100);
+
+  try {
+    FrameReceiver::FrameReceiverUDPRxThread rxThread(config, buffer_manager, frame_decoder, 1);
+    rxThread.start();
+    testRxChannel(rx_channel);
+    rxThread.stop();
+  }
+  catch (OdinData::OdinDataException& e)
+  {
+    initOK = false;
+    BOOST_TEST_MESSAGE("Creation of spinning FrameReceiverUDPRxThread failed: " << e.what());
+  }
+  BOOST_REQUIRE_EQUAL(initOK, true);
+
+}
+
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE( SteerUDPPacketsByFrame )
+{
+  test_frame_steering<FrameReceiver::FrameReceiverUDPRxThread>("TestSteeringSharedBuffer");
+}
+
+BOOST_AUTO_TEST_CASE( SteerUDPPacketsByFrameWithBinaryNotify )
+{
+  proxy.set_frame_notify_format(FrameReceiver::Defaults::FrameNotifyFormatBinary);
+  test_frame_steering<FrameReceiver::FrameReceiverUDPRxThread>("TestSteeringSharedBuffer");
+}
+
+BOOST_AUTO_TEST_CASE( SteerUDPPacketsByFrameWithSharedMemoryNotify )
+{
+  proxy.set_frame_notify_transport(FrameReceiver::Defaults::FrameNotifyTransportSharedMemory);
+  test_frame_steering<FrameReceiver::FrameReceiverUDPRxThread>("TestSteeringSharedBuffer");
+}
+#endif
+
+BOOST_AUTO_TEST_CASE( ReleaseBatchedBuffersToUDPRxThread )
+{
+  FrameReceiver::FrameReceiverUDPRxThread rxThread(config, buffer_manager, frame_decoder, 1);
+  BOOST_REQUIRE_EQUAL(rxThread.start(), true);
+
+  // Receive the identity notification and precharge request sent by the thread on startup
+  std::string rx_thread_identity;
+  BOOST_REQUIRE(rx_channel.poll(1000));
+  rx_channel.recv(&rx_thread_identity);
+  BOOST_REQUIRE(rx_channel.poll(1000));
+  rx_channel.recv();
+
+  // Release a batch of buffers with a JSON message and another with binary notifications
+  OdinData::IpcMessage json_release(OdinData::IpcMessage::MsgTypeNotify,
+      OdinData::IpcMessage::MsgValNotifyFrameRelease);
+  std::string binary_release;
+  for (int buffer_id = 0; buffer_id < 5; buffer_id++)
+  {
+    if (buffer_id < 3)
+    {
+      json_release.set_param("frames[]", buffer_id);
+      json_release.set_param("buffer_ids[]", buffer_id);
+    }
+    else
+    {
+      OdinData::FrameNotification(OdinData::FrameNotification::TypeFrameRelease, buffer_id,
+          buffer_id).encode_to_batch(binary_release);
+    }
+  }
+  rx_channel.send(json_release.encode(), 0, rx_thread_identity);
+  rx_channel.send(binary_release, 0, rx_thread_identity);
+
+  // All the released buffers should now be queued as empty
+  OdinData::IpcMessage status_request(OdinData::IpcMessage::MsgTypeCmd,
+      OdinData::IpcMessage::MsgValCmdStatus);
+  rx_channel.send(status_request.encode(), 0, rx_thread_identity);
+  bool status_received = false;
+  while (!status_received && rx_channel.poll(1000))
+  {
+    OdinData::IpcMessage response(rx_channel.recv().c_str());
+    if (response.get_msg_type() == OdinData::IpcMessage::MsgTypeAck)
+    {
+      BOOST_CHECK_EQUAL(response.get_param<unsigned int>("rx_thread/empty_buffers"), 5);
+      BOOST_CHECK(response.has_param("rx_thread/release_latency_mean_us"));
+      status_received = true;
+    }
+  }
+  BOOST_CHECK(status_received);
+
+  rxThread.stop();
+}
+
+BOOST_AUTO_TEST_CASE( NotifyFramesDirectFromUDPRxThread )
+{
+  const unsigned int num_frames = 2;
+  const unsigned int packet_size = 1000;
+  const uint16_t rx_port = 6342;
+
+  proxy.set_frame_notify_direct("inproc://direct_frame_ready", "inproc://direct_frame_release");
+
+  IpcMessage decoder_config;
+  decoder_config.set_param(FrameReceiver::CONFIG_DECODER_UDP_PACKETS_PER_FRAME, 1);
+  decoder_config.set_param(FrameReceiver::CONFIG_DECODER_UDP_PACKET_SIZE, packet_size);
+  FrameReceiver::FrameDecoderPtr direct_decoder(new FrameReceiver::DummyUDPFrameDecoder());
+  direct_decoder->init(logger, decoder_config);
+  size_t buffer_size = direct_decoder->get_frame_buffer_size();
+  OdinData::SharedBufferManagerPtr direct_buffer_manager(new OdinData::SharedBufferManager(
+      "TestDirectNotifySharedBuffer", buffer_size * num_frames, buffer_size));
+  direct_decoder->register_buffer_manager(direct_buffer_manager);
+  for (unsigned int buffer = 0; buffer < num_frames; buffer++)
+  {
+    direct_decoder->push_empty_buffer(buffer);
+  }
+
+  FrameReceiver::FrameReceiverUDPRxThread rxThread(
+      config, direct_buffer_manager, direct_decoder, 1);
+  BOOST_REQUIRE_EQUAL(rxThread.start(), true);
+
+  // Receive the identity notification sent by the thread to the main thread on startup
+  std::string rx_thread_identity;
+  BOOST_REQUIRE(rx_channel.poll(1000));
+  rx_channel.recv(&rx_thread_identity);
+
+  // Connect to the frame ready and release channels owned by the thread, requesting the buffer
+  // configuration until the subscriptions are established and the thread responds. The first
+  // configuration received may be that notified by the thread on startup, so wait for a second
+  // to be sure that a request has reached the thread
+  OdinData::IpcChannel ready_channel(ZMQ_SUB);
+  ready_channel.connect("inproc://direct_frame_ready");
+  ready_channel.subscribe("");
+  OdinData::IpcChannel release_channel(ZMQ_PUB);
+  release_channel.connect("inproc://direct_frame_release");
+
+  OdinData::IpcMessage config_request(OdinData::IpcMessage::MsgTypeCmd,
+      OdinData::IpcMessage::MsgValCmdBufferConfigRequest);
+  unsigned int configs_received = 0;
+  for (unsigned int retry = 0; (configs_received < 2) && (retry < 20); retry++)
+  {
+    release_channel.send(config_request.encode());
+    while (ready_channel.poll(100))
+    {
+      OdinData::IpcMessage config_msg(ready_channel.recv().c_str());
+      BOOST_CHECK_EQUAL(config_msg.get_msg_val(), OdinData::IpcMessage::MsgValNotifyBufferConfig);
+      BOOST_CHECK_EQUAL(config_msg.get_param<std::string>("shared_buffer_name"),
+          OdinData::Defaults::default_shared_buffer_name);
+      configs_received++;
+    }
+  }
+  BOOST_REQUIRE_GE(configs_received, 2);
+
+  // Send a single-packet frame for each buffer and check each is notified on the ready channel
+  int send_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  struct sockaddr_in dest_addr;
+  memset(&dest_addr, 0, sizeof(dest_addr));
+  dest_addr.sin_family = AF_INET;
+  dest_addr.sin_port = htons(rx_port);
+  dest_addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+  std::vector<uint8_t> packet(sizeof(DummyUDP::PacketHeader) + packet_size, 0);
+  DummyUDP::PacketHeader* header = reinterpret_cast<DummyUDP::PacketHeader*>(&packet[0]);
+  for (uint32_t frame = 0; frame < num_frames; frame++)
+  {
+    header->frame_number = frame;
+    header->packet_number_flags = 0;
+    sendto(send_socket, &packet[0], packet.size(), 0, (struct sockaddr*)&dest_addr, sizeof(dest_addr));
+  }
+  close(send_socket);
+
+  OdinData::IpcMessage release_msg(OdinData::IpcMessage::MsgTypeNotify,
+      OdinData::IpcMessage::MsgValNotifyFrameRelease);
+  unsigned int frames_ready = 0;
+  while ((frames_ready < num_frames) && ready_channel.poll(1000))
+  {
+    OdinData::IpcMessage ready_msg(ready_channel.recv().c_str());
+    if (ready_msg.get_msg_val() == OdinData::IpcMessage::MsgValNotifyFrameReady)
+    {
+      release_msg.set_param("frames[]", ready_msg.get_param<int>("frame"));
+      release_msg.set_param("buffer_ids[]", ready_msg.get_param<int>("buffer_id"));
+      frames_ready++;
+    }
+  }
+  BOOST_REQUIRE_EQUAL(frames_ready, num_frames);
+
+  // Release the buffers directly to the thread and check that the frames notified and released
+  // are counted
+  release_channel.send(release_msg.encode());
+  for (unsigned int retry = 0; (rxThread.get_direct_frames_released() < num_frames) && (retry < 100);
+      retry++)
+  {
+    usleep(10000);
+  }
+  BOOST_CHECK_EQUAL(rxThread.get_direct_frames_ready(), num_frames);
+  BOOST_CHECK_EQUAL(rxThread.get_direct_frames_released(), num_frames);
+
+  // The thread status should report the latency of the notifications it sent directly
+  OdinData::IpcMessage status_request(OdinData::IpcMessage::MsgTypeCmd,
+      OdinData::IpcMessage::MsgValCmdStatus);
+  rx_channel.send(status_request.encode(), 0, rx_thread_identity);
+  bool status_received = false;
+  while (!status_received && rx_channel.poll(1000))
+  {
+    OdinData::IpcMessage response(rx_channel.recv().c_str());
+    if (response.get_msg_type() == OdinData::IpcMessage::MsgTypeAck)
+    {
+      BOOST_CHECK_EQUAL(response.get_param<bool>("rx_thread/notify_direct"), true);
+      BOOST_CHECK_EQUAL(response.get_param<unsigned int>("rx_thread/empty_buffers"), num_frames);
+      BOOST_CHECK(response.has_param("rx_thread/notify_latency_mean_ns"));
+      status_received = true;
+    }
+  }
+  BOOST_CHECK(status_received);
+
+  rxThread.stop();
+}
+
+#ifdef HAVE_IO_URING
+BOOST_AUTO_TEST_CASE( CreateAndPingIoUringUDPRxThread )
+{
+
+  bool initOK = true;
+  proxy.set_rx_engine(FrameReceiver::Defaults::RxEngineIoUring);
+
+  try {
+    FrameReceiver::FrameReceiverUDPRxThread rxThread(config, buffer_manager, frame_decoder, 1);
+    BOOST_REQUIRE_EQUAL(rxThread.start(), true);
+    testRxChannel(rx_channel);
+    rxThread.stop();
+  }
+  catch (OdinData::OdinDataException& e)
+  {
+    initOK = false;
+    BOOST_TEST_MESSAGE("Creation of io_uring FrameReceiverUDPRxThread failed: " << e.what());
+  }
+  BOOST_REQUIRE_EQUAL(initOK, true);
+
+}
+
+BOOST_AUTO_TEST_CASE( SteerUDPPacketsByFrameWithIoUring )
+{
+  proxy.set_rx_engine(FrameReceiver::Defaults::RxEngineIoUring);
+  test_frame_steering<FrameReceiver::FrameReceiverUDPRxThread>("TestIoUringSteeringSharedBuffer");
+}
+#endif
+
+#ifdef __linux__
+BOOST_AUTO_TEST_CASE( CreateAndPingPacketRxThread )
+{
+
+  bool initOK = true;
+
+  try {
+    FrameReceiver::FrameReceiverPacketRxThread rxThread(config, buffer_manager, frame_decoder, 1);
+    BOOST_REQUIRE_EQUAL(rxThread.start(), true);
+    testRxChannel(rx_channel);
+    rxThread.stop();
+  }
+  catch (OdinData::OdinDataException& e)
+  {
+    initOK = false;
+    BOOST_TEST_MESSAGE("Creation of FrameReceiverPacketRxThread failed: " << e.what());
+  }
+  BOOST_REQUIRE_EQUAL(initOK, true);
+
+}
+
+BOOST_AUTO_TEST_CASE( SteerPacketRingPacketsByFrame )
+{
+  test_frame_steering<FrameReceiver::FrameReceiverPacketRxThread>("TestPacketSteeringSharedBuffer");
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END(); // FrameReceiverUDPRxThreadUnitTest
 
 BOOST_FIXTURE_TEST_SUITE(FrameReceiverTCPRxThreadUnitTest, FrameReceiverTCPRxThreadTestFixture);
@@ -252,4 +879,38 @@ BOOST_AUTO_TEST_CASE( CreateAndPingTCPRxThread )
   BOOST_REQUIRE_EQUAL(initOK, true);
 }
 
+#ifdef HAVE_IO_URING
+BOOST_AUTO_TEST_CASE( CreateAndPingIoUringTCPRxThread )
+{
+  bool initOK = true;
+  proxy.set_rx_engine(FrameReceiver::Defaults::RxEngineIoUring);
+
+  try {
+    FrameReceiver::FrameReceiverTCPRxThread rxThread(config, buffer_manager, frame_decoder, 1);
+    BOOST_REQUIRE_EQUAL(rxThread.start(), true);
+    testRxChannel(rx_channel);
+    rxThread.stop();
+  }
+  catch (OdinData::OdinDataException& e)
+  {
+    initOK = false;
+    BOOST_TEST_MESSAGE("Creation of io_uring FrameReceiverTCPRxThread failed: " << e.what());
+  }
+  BOOST_REQUIRE_EQUAL(initOK, true);
+}
+#endif
+
+BOOST_AUTO_TEST_CASE( ReceiveFromServerConnections )
+{
+  test_server_connections();
+}
+
+#ifdef HAVE_IO_URING
+BOOST_AUTO_TEST_CASE( ReceiveFromServerConnectionsWithIoUring )
+{
+  proxy.set_rx_engine(FrameReceiver::Defaults::RxEngineIoUring);
+  test_server_connections();
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END(); // FrameReceiverTCPRxThreadUnitTest
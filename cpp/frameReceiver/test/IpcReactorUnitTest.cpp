@@ -97,4 +97,21 @@ BOOST_AUTO_TEST_CASE( ReactorSendFromTimerTest )
   BOOST_CHECK_EQUAL(test_message, received_message);
 
 }
+
+BOOST_AUTO_TEST_CASE( ReactorRunOnceTest )
+{
+  reactor.register_channel(recv_channel, boost::bind(&ReactorTestFixture::recv_handler, this));
+
+  // A non-blocking iteration with nothing to receive should return immediately
+  BOOST_CHECK_EQUAL(reactor.run_once(0), 0);
+  BOOST_CHECK_EQUAL(received_message.empty(), true);
+  BOOST_CHECK_EQUAL(reactor.is_stopped(), false);
+
+  // A blocking iteration should handle the message, whose handler stops the reactor
+  send_channel.send(test_message);
+  BOOST_CHECK_EQUAL(reactor.run_once(1000), 0);
+  BOOST_CHECK_EQUAL(test_message, received_message);
+  BOOST_CHECK_EQUAL(reactor.is_stopped(), true);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
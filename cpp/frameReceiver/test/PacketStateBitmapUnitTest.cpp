@@ -0,0 +1,122 @@
+/*
+ * PacketStateBitmapUnitTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "PacketStateBitmap.h"
+#include "DummyUDPDefinitions.h"
+
+using namespace OdinData;
+
+// Not a multiple of the word size, so that the last word is partly used
+const std::size_t test_bitmap_packets = 150;
+
+class PacketStateBitmapTestFixture
+{
+public:
+  PacketStateBitmapTestFixture() :
+    words(PacketStateBitmap::num_words(test_bitmap_packets), ~static_cast<PacketStateBitmap::Word>(0)),
+    bitmap(&words[0], test_bitmap_packets)
+  {
+    bitmap.clear();
+  }
+
+  std::vector<PacketStateBitmap::Word> words;
+  PacketStateBitmap bitmap;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PacketStateBitmapUnitTest, PacketStateBitmapTestFixture);
+
+BOOST_AUTO_TEST_CASE( MarkAndCountPackets )
+{
+  BOOST_CHECK_EQUAL(words.size(), 3);
+  BOOST_CHECK_EQUAL(bitmap.get_num_packets(), test_bitmap_packets);
+  BOOST_CHECK_EQUAL(bitmap.num_received(), 0);
+  BOOST_CHECK_EQUAL(bitmap.num_missing(), test_bitmap_packets);
+
+  BOOST_CHECK(bitmap.mark_received(0));
+  BOOST_CHECK(bitmap.mark_received(64));
+  BOOST_CHECK(bitmap.mark_received(test_bitmap_packets - 1));
+  BOOST_CHECK(!bitmap.mark_received(64));
+  BOOST_CHECK(bitmap.is_received(64));
+  BOOST_CHECK(!bitmap.is_received(63));
+  BOOST_CHECK_EQUAL(bitmap.num_received(), 3);
+  BOOST_CHECK_EQUAL(bitmap.num_missing(), test_bitmap_packets - 3);
+
+  for (std::size_t packet = 0; packet < test_bitmap_packets; packet++)
+  {
+    bitmap.mark_received(packet);
+  }
+  BOOST_CHECK_EQUAL(bitmap.num_missing(), 0);
+
+  // A bitmap constructed over existing words sees the same state
+  PacketStateBitmap attached(&words[0], test_bitmap_packets);
+  BOOST_CHECK_EQUAL(attached.num_received(), test_bitmap_packets);
+}
+
+BOOST_AUTO_TEST_CASE( IterateMissingRanges )
+{
+  // Receive every packet except 3-4, 60-69 (spanning a word boundary) and the last two
+  for (std::size_t packet = 0; packet < test_bitmap_packets - 2; packet++)
+  {
+    if ((packet < 3 || packet > 4) && (packet < 60 || packet > 69))
+    {
+      bitmap.mark_received(packet);
+    }
+  }
+
+  std::size_t first = 0;
+  std::size_t last = 0;
+  BOOST_REQUIRE(bitmap.next_missing_range(first, last));
+  BOOST_CHECK_EQUAL(first, 3);
+  BOOST_CHECK_EQUAL(last, 5);
+  first = last;
+  BOOST_REQUIRE(bitmap.next_missing_range(first, last));
+  BOOST_CHECK_EQUAL(first, 60);
+  BOOST_CHECK_EQUAL(last, 70);
+  first = last;
+  BOOST_REQUIRE(bitmap.next_missing_range(first, last));
+  BOOST_CHECK_EQUAL(first, test_bitmap_packets - 2);
+  BOOST_CHECK_EQUAL(last, test_bitmap_packets);
+  first = last;
+  BOOST_CHECK(!bitmap.next_missing_range(first, last));
+
+  // A search starting inside a missing range finds the rest of it
+  first = 65;
+  BOOST_REQUIRE(bitmap.next_missing_range(first, last));
+  BOOST_CHECK_EQUAL(first, 65);
+  BOOST_CHECK_EQUAL(last, 70);
+}
+
+BOOST_AUTO_TEST_CASE( MissingRangesOfEmptyAndCompleteFrames )
+{
+  std::size_t first = 0;
+  std::size_t last = 0;
+  BOOST_REQUIRE(bitmap.next_missing_range(first, last));
+  BOOST_CHECK_EQUAL(first, 0);
+  BOOST_CHECK_EQUAL(last, test_bitmap_packets);
+
+  // Bits past the last packet tracked are never reported missing
+  PacketStateBitmap word_bitmap(&words[0], 64);
+  for (std::size_t packet = 0; packet < 64; packet++)
+  {
+    word_bitmap.mark_received(packet);
+  }
+  first = 0;
+  BOOST_CHECK(!word_bitmap.next_missing_range(first, last));
+  BOOST_CHECK_EQUAL(word_bitmap.num_missing(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( DummyUDPPacketStateSize )
+{
+  BOOST_CHECK_EQUAL(DummyUDP::packet_state_words, PacketStateBitmap::num_words(DummyUDP::max_packets));
+  BOOST_CHECK(sizeof(DummyUDP::FrameHeader) < 1024);
+}
+
+BOOST_AUTO_TEST_SUITE_END(); // PacketStateBitmapUnitTest
@@ -7,6 +7,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include <sys/wait.h>
+#include <unistd.h>
 
 #include "SharedBufferManager.h"
 
@@ -144,6 +145,129 @@ BOOST_AUTO_TEST_CASE( SharedWithChildProcessTest )
 
 }
 
+BOOST_AUTO_TEST_CASE( SharedBufferFrameRingsTest )
+{
+  // Create a shared buffer manager hosting frame rings after the buffers
+  OdinData::SharedBufferManager rings_manager("TestFrameRings", 10000, 1000, true, 2);
+  BOOST_CHECK_EQUAL(rings_manager.get_num_buffers(), 10);
+  BOOST_CHECK_EQUAL(rings_manager.get_num_frame_rings(), 2);
+  BOOST_REQUIRE(rings_manager.get_frame_rings() != NULL);
+  BOOST_CHECK(rings_manager.get_frame_rings()->get_capacity() >= rings_manager.get_num_buffers());
+
+  // Map the same buffer and check the rings are attached and shared
+  OdinData::SharedBufferManager attached_manager("TestFrameRings");
+  BOOST_CHECK_EQUAL(attached_manager.get_num_frame_rings(), 2);
+  BOOST_REQUIRE(attached_manager.get_frame_rings() != NULL);
+
+  OdinData::FrameNotification ready(OdinData::FrameNotification::TypeFrameReady, 3, 4);
+  BOOST_CHECK(rings_manager.get_frame_rings()->push_ready(1, ready));
+  OdinData::FrameNotification notification;
+  BOOST_CHECK(attached_manager.get_frame_rings()->pop_ready(1, notification));
+  BOOST_CHECK_EQUAL(notification.get_frame(), 3);
+  BOOST_CHECK_EQUAL(notification.get_buffer_id(), 4);
+
+  // A shared buffer without rings should not report any
+  BOOST_CHECK_EQUAL(shared_buffer_manager.get_num_frame_rings(), 0);
+  BOOST_CHECK(shared_buffer_manager.get_frame_rings() == NULL);
+}
+
+BOOST_AUTO_TEST_CASE( SharedBufferStatesTest )
+{
+  // Create a shared buffer manager hosting both a buffer state table and frame rings
+  OdinData::SharedBufferManager states_manager("TestBufferStates", 10000, 1000, true, 2, true);
+  BOOST_REQUIRE(states_manager.get_buffer_states() != NULL);
+  BOOST_CHECK_EQUAL(states_manager.get_buffer_states()->get_num_buffers(), 10);
+  BOOST_REQUIRE(states_manager.get_frame_rings() != NULL);
+
+  // Map the same buffer and check both the state table and rings are attached and shared
+  OdinData::SharedBufferManager attached_manager("TestBufferStates");
+  BOOST_REQUIRE(attached_manager.get_buffer_states() != NULL);
+  BOOST_CHECK_EQUAL(attached_manager.get_num_frame_rings(), 2);
+
+  states_manager.get_buffer_states()->set_ready(3, 42);
+  BOOST_CHECK(attached_manager.get_buffer_states()->acquire(3, 42));
+  OdinData::SharedBufferStates::Entry entry;
+  BOOST_REQUIRE(states_manager.get_buffer_states()->get_entry(3, entry));
+  BOOST_CHECK_EQUAL(OdinData::SharedBufferStates::get_state(entry),
+      OdinData::SharedBufferStates::StateHeld);
+
+  // A shared buffer without a state table should not report one
+  BOOST_CHECK(shared_buffer_manager.get_buffer_states() == NULL);
+}
+
+BOOST_AUTO_TEST_CASE( SharedBufferPoolsTest )
+{
+  // Create a shared buffer manager with a pool of large buffers and a pool of small buffers,
+  // alongside a buffer state table and frame rings
+  std::vector<OdinData::SharedBufferManager::PoolSpec> pools;
+  pools.push_back(OdinData::SharedBufferManager::PoolSpec(1000, 4000));
+  pools.push_back(OdinData::SharedBufferManager::PoolSpec(100, 1050));
+  OdinData::SharedBufferManager pools_manager("TestBufferPools", pools, true, 1, true);
+  BOOST_CHECK_EQUAL(pools_manager.get_num_pools(), 2);
+  BOOST_CHECK_EQUAL(pools_manager.get_num_buffers(), 14);
+  BOOST_CHECK_EQUAL(pools_manager.get_pool_num_buffers(0), 4);
+  BOOST_CHECK_EQUAL(pools_manager.get_pool_num_buffers(1), 10);
+  BOOST_CHECK_EQUAL(pools_manager.get_pool_first_buffer(1), 4);
+  BOOST_CHECK_EQUAL(pools_manager.get_buffer_pool(3), 0);
+  BOOST_CHECK_EQUAL(pools_manager.get_buffer_pool(4), 1);
+  BOOST_CHECK_EQUAL(pools_manager.get_buffer_size(), 1000);
+  BOOST_CHECK_EQUAL(pools_manager.get_buffer_size(13), 100);
+  BOOST_CHECK_THROW(pools_manager.get_buffer_address(14), OdinData::SharedBufferManagerException);
+  BOOST_CHECK_THROW(pools_manager.get_pool_num_buffers(2), OdinData::SharedBufferManagerException);
+  BOOST_REQUIRE(pools_manager.get_buffer_states() != NULL);
+  BOOST_CHECK_EQUAL(pools_manager.get_buffer_states()->get_num_buffers(), 14);
+
+  // The first pool is laid out as in a shared buffer with a single pool, with the buffers of the
+  // second pool following without overlapping it
+  char* first_buffer = static_cast<char*>(pools_manager.get_buffer_address(0));
+  BOOST_CHECK_EQUAL(static_cast<char*>(pools_manager.get_buffer_address(3)), first_buffer + 3000);
+  char* small_buffer = static_cast<char*>(pools_manager.get_buffer_address(4));
+  BOOST_CHECK(small_buffer >= first_buffer + 4000);
+  BOOST_CHECK_EQUAL(static_cast<char*>(pools_manager.get_buffer_address(13)), small_buffer + 900);
+  memset(small_buffer, 0x5a, 100);
+
+  // Map the same buffer and check the pools, state table and rings are all attached
+  OdinData::SharedBufferManager attached_manager("TestBufferPools");
+  BOOST_CHECK_EQUAL(attached_manager.get_num_pools(), 2);
+  BOOST_CHECK_EQUAL(attached_manager.get_num_buffers(), 14);
+  BOOST_CHECK_EQUAL(attached_manager.get_buffer_size(4), 100);
+  BOOST_CHECK_EQUAL(static_cast<char*>(attached_manager.get_buffer_address(4))[99], 0x5a);
+  BOOST_REQUIRE(attached_manager.get_buffer_states() != NULL);
+  BOOST_CHECK_EQUAL(attached_manager.get_buffer_states()->get_num_buffers(), 14);
+  BOOST_CHECK_EQUAL(attached_manager.get_num_frame_rings(), 1);
+
+  // A shared buffer created with a single buffer size has a single pool
+  BOOST_CHECK_EQUAL(shared_buffer_manager.get_num_pools(), 1);
+  BOOST_CHECK_EQUAL(shared_buffer_manager.get_buffer_pool(num_buffers - 1), 0);
+}
+
+BOOST_AUTO_TEST_CASE( SharedBufferLockedTest )
+{
+  // Create a shared buffer manager with its pages faulted in and locked into memory
+  OdinData::SharedBufferManager::MemoryOptions memory_options;
+  memory_options.prefault = true;
+  memory_options.lock = true;
+  OdinData::SharedBufferManager locked_manager("TestLockedBuffer", 10000, 1000, true, 0, false,
+      memory_options);
+  BOOST_CHECK(locked_manager.get_locked());
+  BOOST_CHECK_EQUAL(locked_manager.get_page_size(), static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+  BOOST_CHECK_EQUAL(locked_manager.get_numa_node(), -1);
+
+  // A buffer created without memory options is neither locked nor backed by huge pages
+  BOOST_CHECK(!shared_buffer_manager.get_locked());
+  BOOST_CHECK_EQUAL(shared_buffer_manager.get_page_size(), locked_manager.get_page_size());
+}
+
+BOOST_AUTO_TEST_CASE( MissingHugePageMountTest )
+{
+  // Request huge pages of a size no hugetlbfs mount can provide - should throw a
+  // SharedBufferManagerException
+  OdinData::SharedBufferManager::MemoryOptions memory_options;
+  memory_options.huge_page_size = static_cast<size_t>(1) << 40;
+  BOOST_CHECK_THROW(OdinData::SharedBufferManager illegal_manager("NoHugePages", 10000, 1000,
+                    true, 0, false, memory_options), OdinData::SharedBufferManagerException);
+}
+
 BOOST_AUTO_TEST_CASE( MapMissingSharedBufferTest )
 {
   // Try to create a shared buffer manager pointing at name that doesn't exist - should throw
@@ -0,0 +1,170 @@
+/*
+ * SharedBufferStatesUnitTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <vector>
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "SharedBufferStates.h"
+
+using namespace OdinData;
+
+const unsigned int test_state_buffers = 8;
+
+class SharedBufferStatesTestFixture
+{
+public:
+  SharedBufferStatesTestFixture() :
+    region(SharedBufferStates::region_size(test_state_buffers)),
+    states(&region[0], region.size(), test_state_buffers)
+  {
+  }
+
+  SharedBufferStates::State state_of(unsigned int buffer_id)
+  {
+    SharedBufferStates::Entry entry;
+    BOOST_REQUIRE(states.get_entry(buffer_id, entry));
+    return SharedBufferStates::get_state(entry);
+  }
+
+  std::vector<char> region;
+  SharedBufferStates states;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SharedBufferStatesUnitTest, SharedBufferStatesTestFixture);
+
+BOOST_AUTO_TEST_CASE( FormatAndAttachTable )
+{
+  BOOST_CHECK(SharedBufferStates::is_present(&region[0], region.size()));
+  BOOST_CHECK(!SharedBufferStates::is_present(&region[0], region.size() - 1));
+  BOOST_CHECK_EQUAL(states.get_num_buffers(), test_state_buffers);
+
+  // A table formatted in one mapping is visible through another attached to it
+  SharedBufferStates attached(&region[0], region.size());
+  BOOST_CHECK_EQUAL(attached.get_num_buffers(), test_state_buffers);
+  states.set_ready(2, 17);
+  BOOST_CHECK(attached.acquire(2, 17));
+
+  std::vector<char> empty_region(region.size(), 0);
+  BOOST_CHECK(!SharedBufferStates::is_present(&empty_region[0], empty_region.size()));
+  BOOST_CHECK_THROW(SharedBufferStates(&empty_region[0], empty_region.size()),
+      SharedBufferStatesException);
+  BOOST_CHECK_THROW(SharedBufferStates(&empty_region[0], 64, test_state_buffers),
+      SharedBufferStatesException);
+}
+
+BOOST_AUTO_TEST_CASE( BufferLifecycle )
+{
+  SharedBufferStates::Entry entry;
+  BOOST_REQUIRE(states.get_entry(0, entry));
+  BOOST_CHECK_EQUAL(SharedBufferStates::get_state(entry), SharedBufferStates::StateFree);
+  BOOST_CHECK_EQUAL(entry.rx_thread, SharedBufferStates::no_rx_thread);
+  BOOST_CHECK(!states.get_entry(test_state_buffers, entry));
+
+  states.set_free(0, 1);
+  states.set_receiving(0);
+  BOOST_CHECK_EQUAL(state_of(0), SharedBufferStates::StateReceiving);
+  states.set_ready(0, 1234);
+  BOOST_REQUIRE(states.get_entry(0, entry));
+  BOOST_CHECK_EQUAL(SharedBufferStates::get_state(entry), SharedBufferStates::StateReady);
+  BOOST_CHECK_EQUAL(entry.frame, 1234);
+  BOOST_CHECK_EQUAL(entry.rx_thread, 1);
+  BOOST_CHECK_EQUAL(entry.owner_pid, static_cast<uint32_t>(getpid()));
+
+  BOOST_CHECK(states.acquire(0, 1234));
+  BOOST_CHECK_EQUAL(state_of(0), SharedBufferStates::StateHeld);
+  BOOST_CHECK(states.release(0, 1234));
+  BOOST_CHECK_EQUAL(state_of(0), SharedBufferStates::StateFree);
+
+  // Buffers notified ready may also be released without being acquired, for any frame
+  states.set_ready(0, 1235);
+  BOOST_CHECK(states.release(0, SharedBufferStates::any_frame));
+  BOOST_CHECK_EQUAL(state_of(0), SharedBufferStates::StateFree);
+}
+
+BOOST_AUTO_TEST_CASE( StaleTransitionsRefused )
+{
+  states.set_ready(1, 10);
+  BOOST_CHECK(!states.acquire(1, 11));
+  BOOST_CHECK(!states.release(1, 11));
+  BOOST_CHECK_EQUAL(state_of(1), SharedBufferStates::StateReady);
+
+  BOOST_CHECK(states.acquire(1, 10));
+  BOOST_CHECK(!states.acquire(1, 10));
+  BOOST_CHECK(states.release(1, 10));
+
+  // A late release of a buffer already released is refused
+  BOOST_CHECK(!states.release(1, 10));
+  BOOST_CHECK(!states.release(1, SharedBufferStates::any_frame));
+  BOOST_CHECK(!states.acquire(test_state_buffers, 10));
+  BOOST_CHECK(!states.release(test_state_buffers, 10));
+}
+
+BOOST_AUTO_TEST_CASE( ReclaimOnlyFromObservedState )
+{
+  states.set_ready(4, 50);
+  SharedBufferStates::Entry observed;
+  BOOST_REQUIRE(states.get_entry(4, observed));
+
+  // The buffer is released and reused after being observed, so the reclaim must be refused even
+  // though the buffer is back in the same state
+  BOOST_CHECK(states.release(4, 50));
+  states.set_receiving(4);
+  states.set_ready(4, 50);
+  BOOST_CHECK(!states.reclaim(4, observed));
+  BOOST_CHECK_EQUAL(state_of(4), SharedBufferStates::StateReady);
+
+  BOOST_REQUIRE(states.get_entry(4, observed));
+  BOOST_CHECK(states.reclaim(4, observed));
+  BOOST_CHECK_EQUAL(state_of(4), SharedBufferStates::StateFree);
+  BOOST_CHECK(!states.release(4, 50));
+}
+
+BOOST_AUTO_TEST_CASE( EntryLeftBusyIsReclaimed )
+{
+  states.set_ready(5, 60);
+  BOOST_CHECK(states.acquire(5, 60));
+
+  // Mark the entry busy as if the process holding it exited part way through a transition
+  SharedBufferStates::Entry* entries = reinterpret_cast<SharedBufferStates::Entry*>(
+      &region[0] + SharedBufferStates::region_size(0));
+  entries[5].control |= 0x80;
+
+  // Reading the entry returns once the wait for the busy flag times out, and the entry is
+  // refused by a release but taken over by a reclaim
+  SharedBufferStates::Entry observed;
+  BOOST_REQUIRE(states.get_entry(5, observed));
+  BOOST_CHECK(SharedBufferStates::is_busy(observed));
+  BOOST_CHECK_EQUAL(SharedBufferStates::get_state(observed), SharedBufferStates::StateHeld);
+  BOOST_CHECK(!states.release(5, 60));
+  BOOST_CHECK(states.reclaim(5, observed));
+  BOOST_REQUIRE(states.get_entry(5, observed));
+  BOOST_CHECK(!SharedBufferStates::is_busy(observed));
+  BOOST_CHECK_EQUAL(SharedBufferStates::get_state(observed), SharedBufferStates::StateFree);
+}
+
+BOOST_AUTO_TEST_CASE( StateCountsAndNames )
+{
+  states.set_receiving(0);
+  states.set_ready(1, 1);
+  states.set_ready(2, 2);
+  BOOST_CHECK(states.acquire(2, 2));
+
+  std::vector<unsigned int> counts;
+  states.get_state_counts(counts);
+  BOOST_REQUIRE_EQUAL(counts.size(), SharedBufferStates::NumStates);
+  BOOST_CHECK_EQUAL(counts[SharedBufferStates::StateFree], test_state_buffers - 3);
+  BOOST_CHECK_EQUAL(counts[SharedBufferStates::StateReceiving], 1);
+  BOOST_CHECK_EQUAL(counts[SharedBufferStates::StateReady], 1);
+  BOOST_CHECK_EQUAL(counts[SharedBufferStates::StateHeld], 1);
+
+  BOOST_CHECK_EQUAL(std::string(SharedBufferStates::state_name(SharedBufferStates::StateHeld)),
+      "held");
+}
+
+BOOST_AUTO_TEST_SUITE_END(); // SharedBufferStatesUnitTest
@@ -0,0 +1,147 @@
+/*
+ * SharedFrameRingsUnitTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+
+#include "SharedFrameRings.h"
+
+class SharedFrameRingsTestFixture
+{
+public:
+  SharedFrameRingsTestFixture() :
+      num_rings(2),
+      capacity(4),
+      region(OdinData::SharedFrameRings::region_size(num_rings, capacity) + 64)
+  {
+  }
+
+  // Return a cache line aligned pointer into the test region
+  void* aligned_region(void)
+  {
+    size_t address = reinterpret_cast<size_t>(&region[0]);
+    return reinterpret_cast<void*>(((address + 63) / 64) * 64);
+  }
+
+  size_t aligned_size(void)
+  {
+    return OdinData::SharedFrameRings::region_size(num_rings, capacity);
+  }
+
+  unsigned int num_rings;
+  unsigned int capacity;
+  std::vector<char> region;
+};
+
+BOOST_FIXTURE_TEST_SUITE(SharedFrameRingsUnitTest, SharedFrameRingsTestFixture);
+
+BOOST_AUTO_TEST_CASE( FormatAndAttachRings )
+{
+  BOOST_CHECK(!OdinData::SharedFrameRings::is_present(aligned_region(), aligned_size()));
+  BOOST_CHECK_THROW(OdinData::SharedFrameRings missing(aligned_region(), aligned_size()),
+      OdinData::SharedFrameRingsException);
+
+  OdinData::SharedFrameRings producer(aligned_region(), aligned_size(), num_rings, 3);
+  BOOST_CHECK_EQUAL(producer.get_num_rings(), num_rings);
+  BOOST_CHECK_EQUAL(producer.get_capacity(), 4);
+  BOOST_CHECK(OdinData::SharedFrameRings::is_present(aligned_region(), aligned_size()));
+
+  OdinData::SharedFrameRings consumer(aligned_region(), aligned_size());
+  BOOST_CHECK_EQUAL(consumer.get_num_rings(), num_rings);
+  BOOST_CHECK_EQUAL(consumer.get_capacity(), 4);
+}
+
+BOOST_AUTO_TEST_CASE( RegionTooSmallRejected )
+{
+  BOOST_CHECK_THROW(OdinData::SharedFrameRings rings(aligned_region(), aligned_size() - 1,
+      num_rings, capacity), OdinData::SharedFrameRingsException);
+}
+
+BOOST_AUTO_TEST_CASE( PushAndPopNotifications )
+{
+  OdinData::SharedFrameRings producer(aligned_region(), aligned_size(), num_rings, capacity);
+  OdinData::SharedFrameRings consumer(aligned_region(), aligned_size());
+  OdinData::FrameNotification notification;
+
+  // Fill and drain the ready ring several times to exercise wrap-around
+  for (unsigned int pass = 0; pass < 3; pass++)
+  {
+    for (unsigned int frame = 0; frame < capacity; frame++)
+    {
+      OdinData::FrameNotification ready(OdinData::FrameNotification::TypeFrameReady,
+          (pass * capacity) + frame, frame, OdinData::FrameNotification::StateComplete);
+      BOOST_CHECK(producer.push_ready(1, ready));
+    }
+    BOOST_CHECK(!producer.push_ready(1, notification));
+    BOOST_CHECK(!consumer.pop_ready(0, notification));
+
+    for (unsigned int frame = 0; frame < capacity; frame++)
+    {
+      BOOST_REQUIRE(consumer.pop_ready(1, notification));
+      BOOST_CHECK_EQUAL(notification.get_type(), OdinData::FrameNotification::TypeFrameReady);
+      BOOST_CHECK_EQUAL(notification.get_frame(), (pass * capacity) + frame);
+      BOOST_CHECK_EQUAL(notification.get_buffer_id(), frame);
+    }
+    BOOST_CHECK(!consumer.pop_ready(1, notification));
+  }
+
+  // Release rings are independent of the ready rings
+  OdinData::FrameNotification release(OdinData::FrameNotification::TypeFrameRelease, 5, 2);
+  BOOST_CHECK(consumer.push_release(1, release));
+  BOOST_CHECK(!producer.pop_ready(1, notification));
+  BOOST_CHECK(!producer.pop_release(0, notification));
+  BOOST_REQUIRE(producer.pop_release(1, notification));
+  BOOST_CHECK_EQUAL(notification.get_type(), OdinData::FrameNotification::TypeFrameRelease);
+  BOOST_CHECK_EQUAL(notification.get_frame(), 5);
+  BOOST_CHECK_EQUAL(notification.get_buffer_id(), 2);
+}
+
+BOOST_AUTO_TEST_CASE( WaitForReadyNotifications )
+{
+  OdinData::SharedFrameRings producer(aligned_region(), aligned_size(), num_rings, capacity);
+  OdinData::SharedFrameRings consumer(aligned_region(), aligned_size());
+
+  // Waiting on empty rings should time out
+  BOOST_CHECK(!consumer.wait_ready(10));
+
+  // Waiting on non-empty rings should return immediately
+  OdinData::FrameNotification ready(OdinData::FrameNotification::TypeFrameReady, 1, 1);
+  BOOST_CHECK(producer.push_ready(0, ready));
+  BOOST_CHECK(consumer.wait_ready(10));
+  OdinData::FrameNotification notification;
+  BOOST_CHECK(consumer.pop_ready(0, notification));
+
+  // A waiting consumer should be woken by a push from another thread
+  boost::thread pusher(boost::bind(&OdinData::SharedFrameRings::push_ready, &producer, 1, ready));
+  BOOST_CHECK(consumer.wait_ready(5000));
+  pusher.join();
+  BOOST_CHECK(consumer.pop_ready(1, notification));
+}
+
+// Interrupt the consumer of the rings after a short delay
+static void interrupt_after_delay(OdinData::SharedFrameRings* rings)
+{
+  boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+  rings->interrupt_wait();
+}
+
+BOOST_AUTO_TEST_CASE( InterruptWaitForReadyNotifications )
+{
+  OdinData::SharedFrameRings producer(aligned_region(), aligned_size(), num_rings, capacity);
+  OdinData::SharedFrameRings consumer(aligned_region(), aligned_size());
+
+  // A waiting consumer should be woken by an interrupt, finding no notifications
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  boost::thread interrupter(boost::bind(interrupt_after_delay, &producer));
+  BOOST_CHECK(!consumer.wait_ready(5000));
+  interrupter.join();
+  BOOST_CHECK((boost::posix_time::microsec_clock::universal_time() - start).total_milliseconds() < 5000);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,159 @@
+/*
+ * ThreadPlacementUnitTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include <sched.h>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind/bind.hpp>
+
+#include "ThreadPlacement.h"
+
+// Thread placement is only supported on Linux
+#ifdef __linux__
+
+class ThreadPlacementTestFixture
+{
+public:
+  ThreadPlacementTestFixture() :
+      placement(OdinData::ThreadPlacement::Instance()),
+      placed_cpu(-1),
+      placed_policy(-1)
+  {
+    BOOST_TEST_MESSAGE("Setup test fixture");
+
+    // Find a CPU this process is allowed to run on to place test threads on
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    sched_getaffinity(0, sizeof(cpu_set), &cpu_set);
+    for (int cpu = 0; cpu < CPU_SETSIZE && placed_cpu < 0; cpu++)
+    {
+      if (CPU_ISSET(cpu, &cpu_set))
+      {
+        placed_cpu = cpu;
+      }
+    }
+  }
+
+  ~ThreadPlacementTestFixture()
+  {
+    BOOST_TEST_MESSAGE("Tear down test fixture");
+    placement.clear();
+  }
+
+  // Register a placed thread, capture the placement status and unregister again
+  void run_placed_thread(const std::string& name)
+  {
+    registered_name = placement.register_thread(name);
+    placement.status("threads/", status);
+    placement.unregister_thread(registered_name);
+  }
+
+  // Run a placed thread that has already set its own scheduling policy
+  void run_batch_thread(const std::string& name)
+  {
+    struct sched_param param;
+    param.sched_priority = 0;
+    sched_setscheduler(0, SCHED_BATCH, &param);
+    run_placed_thread(name);
+    placed_policy = sched_getscheduler(0);
+  }
+
+  OdinData::ThreadPlacement& placement;
+  int placed_cpu;
+  int placed_policy;
+  std::string registered_name;
+  OdinData::IpcMessage status;
+};
+
+BOOST_FIXTURE_TEST_SUITE( ThreadPlacementUnitTest, ThreadPlacementTestFixture );
+
+BOOST_AUTO_TEST_CASE( CpuListParseAndFormat )
+{
+  std::vector<int> cpus = OdinData::ThreadPlacement::parse_cpu_list("8, 0-3,10-11,2");
+  BOOST_REQUIRE_EQUAL(cpus.size(), 7);
+  BOOST_CHECK_EQUAL(cpus[0], 0);
+  BOOST_CHECK_EQUAL(cpus[4], 8);
+  BOOST_CHECK_EQUAL(OdinData::ThreadPlacement::format_cpu_list(cpus), "0-3,8,10-11");
+
+  BOOST_CHECK(OdinData::ThreadPlacement::parse_cpu_list("").empty());
+  BOOST_CHECK_THROW(OdinData::ThreadPlacement::parse_cpu_list("3-1"), OdinData::ThreadPlacementException);
+  BOOST_CHECK_THROW(OdinData::ThreadPlacement::parse_cpu_list("a"), OdinData::ThreadPlacementException);
+}
+
+BOOST_AUTO_TEST_CASE( InvalidPlacementRejected )
+{
+  OdinData::IpcMessage config;
+  config.set_param("rx_thread/cpus", std::string("0-x"));
+  BOOST_CHECK_THROW(placement.configure(config), OdinData::ThreadPlacementException);
+
+  OdinData::IpcMessage priority_config;
+  priority_config.set_param("rx_thread/priority", 1000);
+  BOOST_CHECK_THROW(placement.configure(priority_config), OdinData::ThreadPlacementException);
+
+  OdinData::IpcMessage policy_config;
+  policy_config.set_param("rx_thread/numa_node", 0);
+  policy_config.set_param("rx_thread/numa_policy", std::string("interleave"));
+  BOOST_CHECK_THROW(placement.configure(policy_config), OdinData::ThreadPlacementException);
+}
+
+BOOST_AUTO_TEST_CASE( PlacementAppliedToMatchingThread )
+{
+  BOOST_REQUIRE(placed_cpu >= 0);
+
+  // A specification for "worker" should apply to thread "worker_test" by prefix matching
+  OdinData::IpcMessage config;
+  config.set_param("worker/cpus", OdinData::ThreadPlacement::format_cpu_list(std::vector<int>(1, placed_cpu)));
+  placement.configure(config);
+
+  boost::thread placed_thread(
+      boost::bind(&ThreadPlacementTestFixture::run_placed_thread, this, "worker_test"));
+  placed_thread.join();
+
+  BOOST_CHECK_EQUAL(registered_name, "worker_test");
+  BOOST_CHECK_EQUAL(status.get_param<std::string>("threads/worker_test/cpus"),
+      OdinData::ThreadPlacement::format_cpu_list(std::vector<int>(1, placed_cpu)));
+  BOOST_CHECK_EQUAL(status.get_param<std::string>("threads/worker_test/policy"), "other");
+  BOOST_CHECK_EQUAL(status.get_param<std::string>("threads/worker_test/error"), "");
+
+  OdinData::IpcMessage reply;
+  placement.configuration("thread_placement/", reply);
+  BOOST_CHECK_EQUAL(reply.get_param<int>("thread_placement/worker/priority"), 0);
+}
+
+BOOST_AUTO_TEST_CASE( PlacementWithoutPriorityKeepsPolicy )
+{
+  BOOST_REQUIRE(placed_cpu >= 0);
+
+  // A specification without a priority should not reset the scheduling policy of the thread
+  OdinData::IpcMessage config;
+  config.set_param("worker/cpus", OdinData::ThreadPlacement::format_cpu_list(std::vector<int>(1, placed_cpu)));
+  placement.configure(config);
+
+  boost::thread placed_thread(
+      boost::bind(&ThreadPlacementTestFixture::run_batch_thread, this, "worker_batch"));
+  placed_thread.join();
+
+  BOOST_CHECK_EQUAL(placed_policy, SCHED_BATCH);
+  BOOST_CHECK_EQUAL(status.get_param<std::string>("threads/worker_batch/error"), "");
+}
+
+BOOST_AUTO_TEST_CASE( DuplicateThreadNamesMadeUnique )
+{
+  std::string first_name = placement.register_thread("duplicate");
+  std::string second_name = placement.register_thread("duplicate");
+
+  BOOST_CHECK_EQUAL(first_name, "duplicate");
+  BOOST_CHECK_EQUAL(second_name, "duplicate_1");
+
+  placement.unregister_thread(second_name);
+  placement.unregister_thread(first_name);
+}
+
+BOOST_AUTO_TEST_SUITE_END(); // ThreadPlacementUnitTest
+
+#endif
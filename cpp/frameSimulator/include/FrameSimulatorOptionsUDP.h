@@ -14,6 +14,7 @@ namespace FrameSimulator {
     static const FrameSimulatorOption<int> opt_packetgap("packet-gap", "Pause between N packets");
     static const FrameSimulatorOption<float> opt_dropfrac("drop-fraction", "Fraction of packets to drop");
     static const FrameSimulatorOption<std::string> opt_droppackets("drop-packets", "Packet number(s) to drop");
+    static const FrameSimulatorOption<int> opt_gsosegments("gso-segments", "Number of packets per send with UDP GSO");
 
 }
 
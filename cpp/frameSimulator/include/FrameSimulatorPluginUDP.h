@@ -50,6 +50,8 @@ namespace FrameSimulator {
 
         static void pkt_callback(u_char *user, const pcap_pkthdr *hdr, const u_char *buffer);
         int send_packet(const boost::shared_ptr<Packet>& packet, const int& frame) const;
+        int queue_packet(const boost::shared_ptr<Packet>& packet, const int& frame);
+        int flush_packets();
 
         /** Extract frames from pcap read data **/
         virtual void extract_frames(const u_char* data, const int& size) = 0;
@@ -69,6 +71,8 @@ namespace FrameSimulator {
         boost::optional<float> drop_frac_;
         //List of packets to drop, these are simple ints held as strings. 0=first packet etc.
         boost::optional<std::vector<std::string> > drop_packets_;
+        //Number of packets coalesced into each send with UDP generic segmentation offload (GSO)
+        boost::optional<int> gso_segments_;
 
         /** Frames **/
         UDPFrames frames_;
@@ -81,9 +85,18 @@ namespace FrameSimulator {
 
     private:
 
+        const struct sockaddr_in& select_addr(const int& frame) const;
+
         std::vector<struct sockaddr_in> m_addrs;
         int m_socket;
 
+        //Packets queued for a single segmented send
+        std::vector<u_char> gso_buffer_;
+        int gso_segment_size_;
+        int gso_queued_segments_;
+        int gso_queued_bytes_;
+        int gso_frame_;
+
         //Used by send_packet to send each frame to the correct port
         mutable int curr_port_index;
         mutable int curr_frame;
@@ -10,6 +10,18 @@
 
 #include "FrameSimulatorOptionsUDP.h"
 
+#if defined(__linux__) && !defined(SOL_UDP)
+#define SOL_UDP 17
+#endif
+
+#if defined(__linux__) && !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
+
+// Limits on segmented sends imposed by the kernel and the maximum UDP payload size
+static const int max_gso_segments = 64;
+static const int max_gso_send_size = 65507;
+
 namespace FrameSimulator {
 
     /** Construct a FrameSimulatorPluginUDP
@@ -25,6 +37,11 @@ namespace FrameSimulator {
         curr_frame = 0;
         curr_port_index = 0;
 
+        gso_segment_size_ = 0;
+        gso_queued_segments_ = 0;
+        gso_queued_bytes_ = 0;
+        gso_frame_ = 0;
+
     }
 
     /** Setup frame simulator plugin class from store of command line options
@@ -65,6 +82,22 @@ namespace FrameSimulator {
             set_optionallist_option(opt_droppackets.get_val(vm), drop_packets_);
         }
 
+        opt_gsosegments.get_val(vm, gso_segments_);
+        if (gso_segments_ && (gso_segments_.get() < 1 || gso_segments_.get() > max_gso_segments)) {
+            LOG4CXX_ERROR(logger_, "GSO segments must be between 1 and " << max_gso_segments);
+            return false;
+        }
+#ifndef __linux__
+        if (gso_segments_ && gso_segments_.get() > 1) {
+            LOG4CXX_ERROR(logger_, "Sending with UDP GSO is only supported on Linux");
+            return false;
+        }
+#endif
+        if (gso_segments_ && gso_segments_.get() > 1) {
+            gso_buffer_.resize(max_gso_send_size);
+            LOG4CXX_DEBUG(logger_, "Sending up to " << gso_segments_.get() << " packets per send with UDP GSO");
+        }
+
         std::string dest_ip = opt_destip.get_val(vm);
 
         std::vector <std::string> dest_ports;
@@ -185,11 +218,17 @@ namespace FrameSimulator {
                     }
                 }
 
-                frame_bytes_sent += send_packet(frames_[n].packets[p], n);
+                if (gso_segments_ && gso_segments_.get() > 1) {
+                    frame_bytes_sent += queue_packet(frames_[n].packets[p], n);
+                }
+                else {
+                    frame_bytes_sent += send_packet(frames_[n].packets[p], n);
+                }
                 frame_packets_sent += 1;
 
                 // Add brief pause between 'packet_gap' frames if packet gap specified
                 if (packet_gap_ && (frame_packets_sent % packet_gap_.get() == 0)) {
+                    frame_bytes_sent += flush_packets();
                     LOG4CXX_DEBUG(logger_,
                                   "Pause - just sent packet - " + boost::lexical_cast<std::string>(frame_packets_sent));
 
@@ -198,6 +237,8 @@ namespace FrameSimulator {
 
             }
 
+            // Send any packets of the frame still queued for a segmented send
+            frame_bytes_sent += flush_packets();
 
             time(&end_time);
 
@@ -241,13 +282,105 @@ namespace FrameSimulator {
      * this ensures each frame is sent to the appropriate destination port
      */
     int FrameSimulatorPluginUDP::send_packet(const boost::shared_ptr<Packet> &packet, const int &frame) const {
+        const struct sockaddr_in& addr = select_addr(frame);
+        bind(m_socket, (struct sockaddr *) (&addr), sizeof(addr));
+        return sendto(m_socket, packet->data, packet->size, 0, (struct sockaddr *) (&addr), sizeof(addr));
+    }
+
+    /** Select the destination address for a frame
+     * /param[in] frame to which a packet belongs
+     * /return destination address, advancing to the next port each time the frame changes
+     */
+    const struct sockaddr_in& FrameSimulatorPluginUDP::select_addr(const int &frame) const {
         if (frame != curr_frame) {
             curr_port_index = (curr_port_index + 1 < m_addrs.size()) ? curr_port_index + 1 : 0;
             curr_frame = frame;
         }
-        bind(m_socket, (struct sockaddr *) (&m_addrs[curr_port_index]), sizeof(m_addrs[curr_port_index]));
-        return sendto(m_socket, packet->data, packet->size, 0, (struct sockaddr *) (&m_addrs[curr_port_index]),
-                      sizeof(m_addrs[curr_port_index]));
+        return m_addrs[curr_port_index];
+    }
+
+    /** Queue a packet to be sent with others of the same frame in a single segmented send
+     * /param[in] packet to send
+     * /param[in] frame to which packet belongs
+     * /return number of bytes sent if queued packets had to be sent first, otherwise 0
+     *
+     * Every packet in a segmented send must be the same size as the first, other than the last,
+     * which may be shorter, so queued packets are sent when that would no longer hold, when the
+     * frame changes or when the configured number of segments or maximum send size is reached
+     */
+    int FrameSimulatorPluginUDP::queue_packet(const boost::shared_ptr<Packet> &packet, const int &frame) {
+        int bytes_sent = 0;
+
+        if (gso_queued_segments_ > 0 &&
+            (frame != gso_frame_ || packet->size > gso_segment_size_ ||
+             gso_queued_bytes_ + packet->size > max_gso_send_size)) {
+            bytes_sent += flush_packets();
+        }
+
+        if (gso_queued_segments_ == 0) {
+            gso_segment_size_ = packet->size;
+            gso_frame_ = frame;
+        }
+        memcpy(&gso_buffer_[gso_queued_bytes_], packet->data, packet->size);
+        gso_queued_bytes_ += packet->size;
+        gso_queued_segments_++;
+
+        // A packet shorter than the segment size must be the last segment of a send
+        if (packet->size < gso_segment_size_ || gso_queued_segments_ >= gso_segments_.get()) {
+            bytes_sent += flush_packets();
+        }
+
+        return bytes_sent;
+    }
+
+    /** Send all queued packets in a single segmented send
+     * /return number of bytes sent
+     *
+     * The kernel splits the send into packets of the segment size, so that many packets are sent
+     * for a single system call
+     */
+    int FrameSimulatorPluginUDP::flush_packets() {
+        if (gso_queued_segments_ == 0) {
+            return 0;
+        }
+
+        const struct sockaddr_in& addr = select_addr(gso_frame_);
+
+        struct iovec iov;
+        iov.iov_base = &gso_buffer_[0];
+        iov.iov_len = gso_queued_bytes_;
+
+        char control[CMSG_SPACE(sizeof(uint16_t))];
+        memset(control, 0, sizeof(control));
+
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_name = (void *) &addr;
+        msg.msg_namelen = sizeof(addr);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+
+        // Only segment sends of more than one packet
+#ifdef __linux__
+        if (gso_queued_segments_ > 1) {
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            *((uint16_t *) CMSG_DATA(cmsg)) = gso_segment_size_;
+        }
+#endif
+
+        int bytes_sent = sendmsg(m_socket, &msg, 0);
+        if (bytes_sent < 0) {
+            LOG4CXX_ERROR(logger_, "Segmented send of " << gso_queued_segments_ << " packets failed: " << strerror(errno));
+        }
+
+        gso_queued_segments_ = 0;
+        gso_queued_bytes_ = 0;
+        return bytes_sent;
     }
 
     /** Populate boost program options with appropriate command line options for plugin
@@ -263,6 +396,7 @@ namespace FrameSimulator {
         opt_packetgap.add_option_to(config);
         opt_dropfrac.add_option_to(config);
         opt_droppackets.add_option_to(config);
+        opt_gsosegments.add_option_to(config);
 
     }
 
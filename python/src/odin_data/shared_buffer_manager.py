@@ -14,6 +14,89 @@ class SharedBufferManagerException(Exception):
     def __str__(self):
         return str(self.msg)
 
+class FrameNotificationException(Exception):
+
+    def __init__(self, msg):
+        self.msg = msg
+
+    def __str__(self):
+        return str(self.msg)
+
+class FrameNotification(object):
+    """Binary frame ready and release notification.
+
+    This class encodes and decodes the compact fixed-layout binary notifications that the frame
+    receiver and processor can exchange in place of JSON frame ready and release messages, when
+    the frame receiver frame_notify_format is set to binary. The layout matches the C++
+    OdinData::FrameNotification class. Several notifications may be concatenated into a single
+    batched message.
+    """
+
+    Layout = Struct('<IHHQIIQQ')
+    MAGIC = 0x4E46444F
+    VERSION = 1
+
+    TYPE_ILLEGAL = 0
+    TYPE_FRAME_READY = 1
+    TYPE_FRAME_RELEASE = 2
+
+    STATE_UNKNOWN = 0
+    STATE_COMPLETE = 1
+    STATE_TIMEDOUT = 2
+
+    def __init__(self, notify_type=TYPE_ILLEGAL, frame=0, buffer_id=0, state=STATE_UNKNOWN,
+                 ready_time_ns=0, release_time_ns=0):
+
+        self.notify_type = notify_type
+        self.frame = frame
+        self.buffer_id = buffer_id
+        self.state = state
+        self.ready_time_ns = ready_time_ns
+        self.release_time_ns = release_time_ns
+
+    @classmethod
+    def is_binary(cls, msg):
+
+        return (len(msg) == cls.Layout.size and
+                cls.Layout.unpack_from(msg)[0] == cls.MAGIC)
+
+    @classmethod
+    def decode(cls, msg):
+
+        if not cls.is_binary(msg):
+            raise FrameNotificationException("Message is not a binary frame notification")
+
+        (_, version, notify_type, frame, buffer_id, state,
+         ready_time_ns, release_time_ns) = cls.Layout.unpack(msg)
+
+        if version != cls.VERSION:
+            raise FrameNotificationException(
+                "Unsupported binary frame notification version " + str(version))
+
+        return cls(notify_type, frame, buffer_id, state, ready_time_ns, release_time_ns)
+
+    @classmethod
+    def is_binary_batch(cls, msg):
+
+        return (len(msg) > 0 and len(msg) % cls.Layout.size == 0 and
+                cls.Layout.unpack_from(msg)[0] == cls.MAGIC)
+
+    @classmethod
+    def decode_batch(cls, msg):
+
+        if not cls.is_binary_batch(msg):
+            raise FrameNotificationException(
+                "Message is not a batch of binary frame notifications")
+
+        size = cls.Layout.size
+        return [cls.decode(msg[offset:offset + size]) for offset in range(0, len(msg), size)]
+
+    def encode(self):
+
+        return self.Layout.pack(
+            self.MAGIC, self.VERSION, self.notify_type, self.frame, self.buffer_id,
+            self.state, self.ready_time_ns, self.release_time_ns)
+
 class SharedBufferManager(object):
 
     Header = Struct('QQQ')
@@ -72,7 +155,16 @@ class SharedBufferManager(object):
                 mmap_size = self.shared_mem.size
                 mmap_fd = self.shared_mem.fd
             except posix_ipc.ExistentialError as e:
-                raise SharedBufferManagerException(str(e))
+                # A buffer backed by huge pages is a file in a hugetlbfs mount rather than a
+                # shared memory object, so look for it there when attaching
+                huge_page_path = None
+                if not shared_mem_size:
+                    huge_page_path = self._find_huge_page_file(shared_mem_name)
+                if not huge_page_path:
+                    raise SharedBufferManagerException(str(e))
+                self.mmap_file = open(huge_page_path, mmap_file_mode)
+                mmap_size = 0
+                mmap_fd = self.mmap_file.fileno()
             except posix_ipc.Error  as e:
                 raise SharedBufferManagerException(str(e))
             except ValueError as e:
@@ -93,6 +185,22 @@ class SharedBufferManager(object):
 
         self.mapfile.seek(0)
 
+    @staticmethod
+    def _find_huge_page_file(shared_mem_name):
+
+        try:
+            with open('/proc/mounts') as mounts:
+                for mount in mounts:
+                    fields = mount.split()
+                    if len(fields) > 2 and fields[2] == 'hugetlbfs':
+                        path = os.path.join(fields[1], shared_mem_name)
+                        if os.path.exists(path):
+                            return path
+        except IOError:
+            pass
+
+        return None
+
     def get_manager_id(self):
 
         return self.manager_id.value
@@ -1,6 +1,11 @@
 from struct import Struct
 import pytest
-from odin_data.shared_buffer_manager import SharedBufferManager, SharedBufferManagerException
+from odin_data.shared_buffer_manager import (
+    SharedBufferManager,
+    SharedBufferManagerException,
+    FrameNotification,
+    FrameNotificationException,
+)
 
 
 shared_mem_name = "TestSharedBuffer"
@@ -75,3 +80,48 @@ class TestSharedBufferManager:
         read_values = data_block.unpack(read_raw)
 
         assert values == read_values
+
+
+class TestFrameNotification:
+    def test_encode_and_decode(self):
+        notification = FrameNotification(
+            FrameNotification.TYPE_FRAME_RELEASE, 0x123456789, 7,
+            FrameNotification.STATE_TIMEDOUT, 1000, 2000
+        )
+        encoded = notification.encode()
+
+        assert FrameNotification.is_binary(encoded)
+        decoded = FrameNotification.decode(encoded)
+        assert decoded.notify_type == FrameNotification.TYPE_FRAME_RELEASE
+        assert decoded.frame == 0x123456789
+        assert decoded.buffer_id == 7
+        assert decoded.state == FrameNotification.STATE_TIMEDOUT
+        assert decoded.ready_time_ns == 1000
+        assert decoded.release_time_ns == 2000
+
+    def test_encoded_layout(self):
+        encoded = FrameNotification(FrameNotification.TYPE_FRAME_READY, 1, 2).encode()
+        assert len(encoded) == 40
+        assert encoded[0:4] == b"ODFN"
+
+    def test_decode_json_message(self):
+        json_msg = b'{"msg_type": "notify", "msg_val": "frame_ready"}'
+        assert not FrameNotification.is_binary(json_msg)
+        with pytest.raises(FrameNotificationException) as excinfo:
+            FrameNotification.decode(json_msg)
+        assert "not a binary frame notification" in str(excinfo.value)
+
+    def test_encode_and_decode_batch(self):
+        encoded = b"".join(
+            FrameNotification(FrameNotification.TYPE_FRAME_RELEASE, 100 + buffer_id, buffer_id).encode()
+            for buffer_id in range(3)
+        )
+        assert not FrameNotification.is_binary(encoded)
+        assert FrameNotification.is_binary_batch(encoded)
+
+        decoded = FrameNotification.decode_batch(encoded)
+        assert [notification.buffer_id for notification in decoded] == [0, 1, 2]
+        assert [notification.frame for notification in decoded] == [100, 101, 102]
+
+        with pytest.raises(FrameNotificationException):
+            FrameNotification.decode_batch(encoded[:-1])